@@ -29,6 +29,7 @@
 #include <iterator>
 #include <fstream>
 #include <sstream>
+#include <cstdio>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
@@ -42,6 +43,7 @@
 #include "CDPL/ConfGen/MoleculeFunctions.hpp"
 #include "CDPL/ConfGen/MolecularGraphFunctions.hpp"
 #include "CDPL/ConfGen/FragmentLibraryGenerator.hpp"
+#include "CDPL/ConfGen/FragmentLibraryMerger.hpp"
 #include "CDPL/ConfGen/ReturnCode.hpp"
 #include "CDPL/ConfGen/ForceFieldType.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
@@ -298,7 +300,8 @@ private:
 
 GenFragLibImpl::GenFragLibImpl(): 
 	numThreads(0), mode(CREATE), settings(ConformerGeneratorSettings::THOROUGH), preset("THOROUGH"),
-	maxLibSize(0), inputHandler(), fragmentLibPtr(new CDPL::ConfGen::FragmentLibrary())
+	maxLibSize(0), indexedOutput(false), numShards(1), shardIndex(0), shardStartIdx(0), shardEndIdx(0), inputHandler(),
+	fragmentLibPtr(new CDPL::ConfGen::FragmentLibrary())
 {
 	addOption("input,i", "Input file(s).", 
 			  value<StringList>(&inputFiles)->multitoken()->required());
@@ -322,6 +325,12 @@ GenFragLibImpl::GenFragLibImpl():
 			  value<std::size_t>()->notifier(boost::bind(&GenFragLibImpl::setTimeout, this, _1)));
 	addOption("max-lib-size,n", "Maximum number of output fragments (default: 0, must be >= 0, 0 disables limit, only valid in CREATE mode).",
 			  value<std::size_t>(&maxLibSize));
+	addOption("indexed-output,x", "Save the output library in the memory-mappable indexed format instead of CDF format (default: false).",
+			  value<bool>(&indexedOutput)->implicit_value(true));
+	addOption("num-shards,N", "Number of shards the input molecules get partitioned into (default: 1, must be > 0, only valid in CREATE and UPDATE mode).",
+			  value<std::size_t>()->notifier(boost::bind(&GenFragLibImpl::setNumShards, this, _1)));
+	addOption("shard-index,k", "Zero-based index of the input shard that gets processed (default: 0, must be < num-shards).",
+			  value<std::size_t>(&shardIndex));
 	addOption("e-window,e", "Output energy window for small ring system conformers (default: " + 
 			  boost::lexical_cast<std::string>(settings.getSmallRingSystemSettings().getEnergyWindow()) + ", must be >= 0).",
 			  value<double>()->notifier(boost::bind(&GenFragLibImpl::setEnergyWindow, this, _1)));
@@ -373,7 +382,14 @@ void GenFragLibImpl::addOptionLongDescriptions()
 	addOptionLongDescription("input", 
 							 "When operating in CREATE or UPDATE mode, specifies one or more input file(s) with molecules whose fragments shall be stored in the created fragment library.\n\n" +
 							 formats_str +
-							 "In MERGE mode, specifies multiple existing fragment libraries in CDF format.");
+							 "In MERGE mode, specifies multiple existing fragment libraries in CDF or indexed format. Fragments contained in more than one "
+							 "library are resolved by keeping the entry with the most conformers (ties are resolved in favor of the library specified first).");
+
+	addOptionLongDescription("num-shards", 
+							 "Partitions the input molecules into the specified number of equally sized contiguous blocks (shards). Only the shard "
+							 "selected by the option 'shard-index' gets processed. This allows to distribute the generation of a fragment library for a "
+							 "large input collection over several independent processes whose partial output libraries are combined afterwards by a run "
+							 "in MERGE mode.");
 
 	addOptionLongDescription("input-format", 
 							 "Allows to explicitly specify the format of the input file(s) by providing one of the supported "
@@ -454,6 +470,14 @@ void GenFragLibImpl::setDistExponent(double exp)
 	settings.setDistanceExponent(exp);
 }
 
+void GenFragLibImpl::setNumShards(std::size_t num_shards)
+{
+	if (num_shards == 0)
+		throwValidationError("num-shards");
+
+	numShards = num_shards;
+}
+
 void GenFragLibImpl::setMode(const std::string& mode_str)
 {
 	using namespace CDPL::Pharm;
@@ -491,13 +515,16 @@ int GenFragLibImpl::process()
 	printMessage(INFO, getProgTitleString());
 	printMessage(INFO, "");
 
+	if (shardIndex >= numShards)
+		throwValidationError("shard-index");
+
 	checkInputFiles();
 	printOptionSummary();
 
-	if (mode == MERGE) {
-		mergeFragmentLibraries();
+	if (mode == MERGE)
+		return mergeFragmentLibraries();
 
-	} else {
+	else {
 		initInputReader();
 
 		if (termSignalCaught())
@@ -532,28 +559,50 @@ int GenFragLibImpl::process()
 	return saveFragmentLibrary();
 }
 
-void GenFragLibImpl::mergeFragmentLibraries()
+int GenFragLibImpl::mergeFragmentLibraries()
 {
-	FragmentLibrary input_lib;
+	using namespace CDPL;
 
-	for (StringList::const_iterator it = inputFiles.begin(), end = inputFiles.end(); it != end; ++it) {
-		if (GenFragLibImpl::termSignalCaught())
-			return;
+	CDPL::ConfGen::FragmentLibraryMerger merger;
 
-		loadFragmentLibrary(*it, input_lib);
+	for (StringList::const_iterator it = inputFiles.begin(), end = inputFiles.end(); it != end; ++it)
+		merger.addInputLibrary(*it);
 
-		if (GenFragLibImpl::termSignalCaught())
-			return;
+	merger.setNumThreads(std::max(numThreads, std::size_t(1)));
+	merger.setIndexedOutput(indexedOutput);
+	merger.setAbortCallback(&GenFragLibImpl::termSignalCaught);
+
+	// the output file may also be one of the (memory-mapped) input libraries
 
-		std::size_t old_num_frags = fragmentLibPtr->getNumEntries();
+	std::string tmp_file = outputFile + ".tmp";
+	std::ofstream os(tmp_file, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
-		printMessage(INFO, "Adding Fragments to Output Library...");
+	if (!os)
+		throw Base::IOError("opening output fragment library '" + tmp_file + "' failed");
 
-		fragmentLibPtr->addEntries(input_lib);
+	printMessage(INFO, "Merging Fragment Libraries into '" + outputFile + "'...");
 
-		printMessage(INFO, " - Added " + boost::lexical_cast<std::string>(fragmentLibPtr->getNumEntries() - old_num_frags) + " fragment(s)");
-		printMessage(INFO, "");
+	if (!merger.merge(os)) {
+		os.close();
+		std::remove(tmp_file.c_str());
+
+		return EXIT_FAILURE;
 	}
+
+	os.close();
+
+	if (!os)
+		throw Base::IOError("saving fragments to library '" + tmp_file + "' failed");
+
+	if (std::rename(tmp_file.c_str(), outputFile.c_str()) != 0)
+		throw Base::IOError("renaming '" + tmp_file + "' to '" + outputFile + "' failed");
+
+	printMessage(INFO, " - Read " + boost::lexical_cast<std::string>(merger.getNumInputEntries()) + " fragments from " +
+				 boost::lexical_cast<std::string>(inputFiles.size()) + " libraries");
+	printMessage(INFO, " - Resolved " + boost::lexical_cast<std::string>(merger.getNumConflicts()) + " conflicting fragments");
+	printMessage(INFO, " - Saved " + boost::lexical_cast<std::string>(merger.getNumOutputEntries()) + " fragments", false);
+
+	return EXIT_SUCCESS;
 }
 
 void GenFragLibImpl::processSingleThreaded()
@@ -656,13 +705,19 @@ void GenFragLibImpl::loadFragmentLibrary(const std::string& fname, FragmentLibra
 	printMessage(INFO, "Loading Fragments from Library '" + fname + "'...");
 
 	lib.clear();
-	lib.load(is);
 
-	if (GenFragLibImpl::termSignalCaught())
-		return;
+	if (FragmentLibrary::isIndexedFile(fname)) 
+		lib.loadIndexed(fname);
 
-	if (!is)
-		throw Base::IOError("loading fragments from library '" + fname + "' failed");
+	else {
+		lib.load(is);
+
+		if (GenFragLibImpl::termSignalCaught())
+			return;
+
+		if (!is)
+			throw Base::IOError("loading fragments from library '" + fname + "' failed");
+	}
 
 	printMessage(INFO, " - Loaded " + boost::lexical_cast<std::string>(lib.getNumEntries()) + " fragments");
 	printMessage(INFO, "");
@@ -687,10 +742,13 @@ int GenFragLibImpl::saveFragmentLibrary()
 {
 	using namespace CDPL;
 
-	std::ofstream os(outputFile, std::ios_base::out | std::ios_base::trunc);
+	// in UPDATE mode, the output file may still be mapped into memory by an indexed library
+
+	std::string tmp_file = (fragmentLibPtr->isIndexed() ? outputFile + ".tmp" : outputFile);
+	std::ofstream os(tmp_file, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
 	if (!os)
-		throw Base::IOError("opening output fragment library '" + outputFile + "' failed");
+		throw Base::IOError("opening output fragment library '" + tmp_file + "' failed");
 
 	printMessage(INFO, "Saving Fragments to Library '" + outputFile + "'...");
 
@@ -710,10 +768,18 @@ int GenFragLibImpl::saveFragmentLibrary()
 			fragmentLibPtr->removeEntry(it->first);
 	}
 
-	fragmentLibPtr->save(os);
+	if (indexedOutput)
+		fragmentLibPtr->saveIndexed(os);
+	else
+		fragmentLibPtr->save(os);
+
+	os.close();
 
 	if (!os)
-		throw Base::IOError("saving fragments to library '" + outputFile + "' failed");
+		throw Base::IOError("saving fragments to library '" + tmp_file + "' failed");
+
+	if (tmp_file != outputFile && std::rename(tmp_file.c_str(), outputFile.c_str()) != 0)
+		throw Base::IOError("renaming '" + tmp_file + "' to '" + outputFile + "' failed");
 
 	printMessage(INFO, " - Saved " + boost::lexical_cast<std::string>(fragmentLibPtr->getNumEntries()) + " fragments", false);
 
@@ -778,7 +844,7 @@ std::size_t GenFragLibImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
 {
 	while (true) {
 		try {
-			if (inputReader.getRecordIndex() >= inputReader.getNumRecords()) 
+			if (inputReader.getRecordIndex() >= shardEndIdx) 
 				return 0;
 
 			if (!inputReader.read(mol)) {
@@ -788,7 +854,7 @@ std::size_t GenFragLibImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
 				continue;
 			}
 
-			printProgress("Processing Molecules...        ", double(inputReader.getRecordIndex()) / inputReader.getNumRecords());
+			printProgress("Processing Molecules...        ", double(inputReader.getRecordIndex() - shardStartIdx) / (shardEndIdx - shardStartIdx));
 
 			return inputReader.getRecordIndex();
 
@@ -840,15 +906,17 @@ void GenFragLibImpl::printOptionSummary()
 		printMessage(VERBOSE, std::string(38, ' ') + *it);
 
 	printMessage(VERBOSE,     " Output File:                         " + outputFile);
+	printMessage(VERBOSE,     " Indexed Output Format:               " + std::string(indexedOutput ? "Yes" : "No"));
  	printMessage(VERBOSE,     " Mode:                                " + getModeString());
  	printMessage(VERBOSE,     " Preset:                              " + preset);
+	printMessage(VERBOSE,     " Multithreading:                      " + std::string(numThreads > 0 ? "Yes" : "No"));
 
-	if (mode != MERGE) {
-		printMessage(VERBOSE, " Multithreading:                      " + std::string(numThreads > 0 ? "Yes" : "No"));
-
-		if (numThreads > 0)
-			printMessage(VERBOSE, " Number of Threads:                   " + boost::lexical_cast<std::string>(numThreads));
+	if (numThreads > 0)
+		printMessage(VERBOSE, " Number of Threads:                   " + boost::lexical_cast<std::string>(numThreads));
 
+	if (mode != MERGE) {
+		printMessage(VERBOSE, " Number of Input Shards:              " + boost::lexical_cast<std::string>(numShards));
+		printMessage(VERBOSE, " Processed Shard Index:               " + boost::lexical_cast<std::string>(shardIndex));
 		printMessage(VERBOSE, " Input File Format:                   " + (inputHandler ? inputHandler->getDataFormat().getName() : std::string("Auto-detect")));
 		printMessage(VERBOSE, " Max. Output Library Size:            " + boost::lexical_cast<std::string>(maxLibSize));
 		printMessage(VERBOSE, " Timeout:                             " + boost::lexical_cast<std::string>(settings.getMacrocycleSettings().getTimeout() / 1000) + "s");
@@ -911,6 +979,16 @@ void GenFragLibImpl::initInputReader()
 		return;
 
 	printMessage(INFO, " - Found " + boost::lexical_cast<std::string>(inputReader.getNumRecords()) + " input molecule(s)");
+
+	shardStartIdx = inputReader.getNumRecords() * shardIndex / numShards;
+	shardEndIdx = inputReader.getNumRecords() * (shardIndex + 1) / numShards;
+
+	inputReader.setRecordIndex(shardStartIdx);
+
+	if (numShards > 1)
+		printMessage(INFO, " - Processing shard " + boost::lexical_cast<std::string>(shardIndex + 1) + '/' + boost::lexical_cast<std::string>(numShards) + 
+					 " (molecules " + boost::lexical_cast<std::string>(shardStartIdx + 1) + '-' + boost::lexical_cast<std::string>(shardEndIdx) + ')');
+
 	printMessage(INFO, "");
 }
 
@@ -92,11 +92,12 @@ namespace GenFragLib
 		void setSmallRingSystemSamplingFactor(std::size_t factor);
 		void setForceFieldType(const std::string& type_str);
 		void setMode(const std::string& mode_str);
+		void setNumShards(std::size_t num_shards);
 		void setInputFormat(const std::string& file_ext);
 
 		int process();
 
-		void mergeFragmentLibraries();
+		int mergeFragmentLibraries();
 		void processSingleThreaded();
 		void processMultiThreaded();
 
@@ -146,6 +147,11 @@ namespace GenFragLib
 		ConformerGeneratorSettings     settings;
 		std::string                    preset;
 		std::size_t                    maxLibSize;
+		bool                           indexedOutput;
+		std::size_t                    numShards;
+		std::size_t                    shardIndex;
+		std::size_t                    shardStartIdx;
+		std::size_t                    shardEndIdx;
 		InputHandlerPtr                inputHandler;
 		CompMoleculeReader             inputReader;
 		FragmentLibrary::SharedPointer fragmentLibPtr;
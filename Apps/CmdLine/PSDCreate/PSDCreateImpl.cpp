@@ -36,9 +36,7 @@
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
 #include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
-#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
-#include "CDPL/Util/FileRemover.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
@@ -72,25 +70,6 @@ private:
 	double         scale;
 };
 
-struct PSDCreateImpl::MergeDBsProgressCallback
-{
-
-	MergeDBsProgressCallback(PSDCreateImpl* parent, double offset, double scale): 
-		parent(parent), offset(offset), scale(scale) {}
-
-	bool operator()(double progress) const {
-		if (PSDCreateImpl::termSignalCaught())
-			return false;
-
-		parent->printProgress("Merging Temporary Databases... ", offset + scale * progress);
-		return true;
-	}
-
-	PSDCreateImpl* parent;
-	double         offset;
-	double         scale;
-};
-
 class PSDCreateImpl::DBCreationWorker
 {
 
@@ -282,9 +261,9 @@ int PSDCreateImpl::process()
 
 	if (progressEnabled()) {
 		initProgress();
-		printMessage(INFO, "Creating Database(s)...", true, true);
+		printMessage(INFO, "Creating Database...", true, true);
 	} else
-		printMessage(INFO, "Creating Database(s)...");
+		printMessage(INFO, "Creating Database...");
 
 	if (numThreads > 0)
 		processMultiThreaded();
@@ -328,31 +307,22 @@ void PSDCreateImpl::processMultiThreaded()
 {
 	using namespace CDPL;
 
-	typedef Pharm::ScreeningDBCreator::SharedPointer DBCreatorPtr;
-	typedef std::vector<Util::FileRemover> DBFileList;
-	typedef std::vector<DBCreatorPtr> DBCreatorList;
+	// all worker threads feed the same database creator - pharmacophore generation and record serialization
+	// is performed by the workers and the database gets written by the creator's single writer thread
+
+	Pharm::PSDScreeningDBCreator::SharedPointer db_creator(
+		new Pharm::PSDScreeningDBCreator(outputDatabase, creationMode, !dropDuplicates));
+
+	db_creator->setUseWriterThread(true);
 
 	boost::thread_group thread_grp;
-	DBCreatorList tmp_db_creators;
-	DBFileList tmp_db_files(numThreads - 1, Util::FileRemover(""));
 
-	DBCreatorPtr main_db_creator(new Pharm::PSDScreeningDBCreator(outputDatabase, creationMode, !dropDuplicates));
-	
 	try {
-		thread_grp.create_thread(DBCreationWorker(this, main_db_creator));
-
-		for (std::size_t i = 0; i < numThreads - 1; i++) {
+		for (std::size_t i = 0; i < numThreads; i++) {
 			if (termSignalCaught())
 				break;
 
-			std::string tmp_db_name = Util::genCheckedTempFilePath();
-
-			tmp_db_files[i].reset(tmp_db_name);
-
-			DBCreatorPtr tmp_db_creator(new Pharm::PSDScreeningDBCreator(tmp_db_name, creationMode, !dropDuplicates));
-
-			thread_grp.create_thread(DBCreationWorker(this, tmp_db_creator));
-			tmp_db_creators.push_back(tmp_db_creator);
+			thread_grp.create_thread(DBCreationWorker(this, db_creator));
 		}
 
 	} catch (const std::exception& e) {
@@ -372,48 +342,23 @@ void PSDCreateImpl::processMultiThreaded()
 		setErrorMessage("unspecified error while waiting for worker-threads to finish");
 	}
 	
-	printMessage(INFO, "");
-
-	if (haveErrorMessage())
-		return;
-
-	if (termSignalCaught())
-		return;
-	
-	std::size_t num_proc = main_db_creator->getNumProcessed();
-	std::size_t num_rej = 0;
-
-	if (progressEnabled()) {
-		initProgress();
-		printMessage(INFO, "Merging Temporary Databases...", true, true);
-	} else
-		printMessage(INFO, "Merging Temporary Databases...");
-
-	for (std::size_t i = 0; i < numThreads - 1; i++) {
-		if (termSignalCaught())
-			return;
-
-		num_proc += tmp_db_creators[i]->getNumProcessed();
-		num_rej  += tmp_db_creators[i]->getNumRejected();
-
-		tmp_db_creators[i]->close();
-
-		Pharm::PSDScreeningDBAccessor db_acc(tmp_db_files[i].getPath());
+	try {
+		db_creator->flush();
 
-		main_db_creator->merge(db_acc, MergeDBsProgressCallback(this, i * 1.0 / (numThreads - 1), 1.0 / (numThreads - 1)));
+	} catch (const std::exception& e) {
+		setErrorMessage(std::string("error while writing database: ") + e.what());
 	}
 
 	printMessage(INFO, "");
 
-	if (termSignalCaught())
+	if (haveErrorMessage())
 		return;
 
-	std::size_t num_del = main_db_creator->getNumDeleted();
-	std::size_t num_ins = main_db_creator->getNumInserted();
-
-	num_rej += main_db_creator->getNumRejected();
+	if (termSignalCaught())
+		return;
 
-	printStatistics(num_proc, num_rej, num_del, num_ins,
+	printStatistics(db_creator->getNumProcessed(), db_creator->getNumRejected(),
+					db_creator->getNumDeleted(), db_creator->getNumInserted(),
 					boost::chrono::duration_cast<boost::chrono::duration<std::size_t> >(Clock::now() - startTime).count());
 }
 
@@ -494,14 +439,7 @@ std::size_t PSDCreateImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
 				}
 			}
 
-			std::string msg;
-
-			if (numThreads == 0)
-				msg = "Creating Database...           ";
-			else
-				msg = "Creating Temporary Databases...";
-
-			printProgress(msg, double(inputReader.getRecordIndex()) / inputReader.getNumRecords());
+			printProgress("Creating Database...", double(inputReader.getRecordIndex()) / inputReader.getNumRecords());
 
 			return inputReader.getRecordIndex();
 
@@ -102,7 +102,6 @@ namespace PSDCreate
 		void addOptionLongDescriptions();
 
 		struct InputScanProgressCallback;
-		struct MergeDBsProgressCallback;
 		struct DBCreationWorker;
 
 		typedef std::vector<std::string> StringList;
@@ -30,13 +30,16 @@
 #include <functional>
 #include <sstream>
 #include <iomanip>
+#include <fstream>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
 
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
@@ -56,6 +59,9 @@ PSDInfoImpl::PSDInfoImpl(): printConfStats(false), printPharmStats(false), print
 			  value<bool>(&printPharmStats)->implicit_value(true));
 	addOption("feature-stats,F", "Print feature type statistics (default: false).", 
 			  value<bool>(&printFeatureStats)->implicit_value(true));
+	addOption("manifest,m", "Write a shard manifest file that lists the input databases (in the specified order) as the shards "
+			  "of a single logical screening database.", 
+			  value<std::string>(&manifestFile));
 }
 
 const char* PSDInfoImpl::getProgName() const
@@ -86,20 +92,25 @@ int PSDInfoImpl::process()
 
 int PSDInfoImpl::printStatistics()
 {
+	std::vector<std::size_t> num_mols;
+
 	for (StringList::const_iterator it = inputDatabases.begin(), end = inputDatabases.end(); it != end; ++it) {
 		if (termSignalCaught())
 			return EXIT_FAILURE;
 
-		printStatistics(*it);
+		num_mols.push_back(printStatistics(*it));
 	}
 
 	if (termSignalCaught())
 		return EXIT_FAILURE;
 
+	if (!manifestFile.empty())
+		writeShardManifest(num_mols);
+
 	return EXIT_SUCCESS;
 }
 
-void PSDInfoImpl::printStatistics(const std::string& db_name)
+std::size_t PSDInfoImpl::printStatistics(const std::string& db_name)
 {
 	using namespace CDPL;
 
@@ -214,6 +225,31 @@ void PSDInfoImpl::printStatistics(const std::string& db_name)
 
 		printMessage(INFO, oss.str(), false);
 	}
+
+	return num_mols;
+}
+
+void PSDInfoImpl::writeShardManifest(const std::vector<std::size_t>& num_mols)
+{
+	using namespace CDPL;
+
+	Pharm::ScreeningDBShardManifest manifest;
+
+	// absolute paths keep the manifest valid independent of its location
+
+	for (std::size_t i = 0; i < inputDatabases.size(); i++)
+		manifest.addShard(boost::filesystem::absolute(inputDatabases[i]).string(), num_mols[i]);
+
+	std::ofstream os(manifestFile.c_str());
+
+	if (!os)
+		throw Base::IOError("opening shard manifest file '" + manifestFile + "' failed");
+
+	manifest.write(os);
+
+	printMessage(INFO, "Wrote shard manifest for " + boost::lexical_cast<std::string>(manifest.getNumShards()) + " database" + 
+				 (manifest.getNumShards() != 1 ? "s" : "") + " (" + boost::lexical_cast<std::string>(manifest.getNumMolecules()) + 
+				 " molecules) to '" + manifestFile + "'");
 }
 
 void PSDInfoImpl::printTableRow(std::ostream& os, const std::string& stat_type, std::size_t min, double avg, std::size_t max) const
@@ -246,5 +282,6 @@ void PSDInfoImpl::printOptionSummary()
 	printMessage(VERBOSE, std::string(" Conf. Count Statistics:   ") + (printConfStats ? "Yes" : "No"));
 	printMessage(VERBOSE, std::string(" Feature Count Statistics: ") + (printPharmStats ? "Yes" : "No"));
 	printMessage(VERBOSE, std::string(" Feature Type Statistics:  ") + (printFeatureStats ? "Yes" : "No"));
+	printMessage(VERBOSE, " Shard Manifest File:      " + (manifestFile.empty() ? std::string("None") : manifestFile));
 	printMessage(VERBOSE, "");
 }
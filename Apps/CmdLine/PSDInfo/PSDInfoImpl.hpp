@@ -51,7 +51,9 @@ namespace PSDInfo
 		int process();
 
 		int printStatistics();
-		void printStatistics(const std::string& db_name);
+		std::size_t printStatistics(const std::string& db_name);
+
+		void writeShardManifest(const std::vector<std::size_t>& num_mols);
 	
 		void checkInputFiles() const;
 		void printOptionSummary();
@@ -62,6 +64,7 @@ namespace PSDInfo
 		typedef std::vector<std::string> StringList;
 
 		StringList  inputDatabases;
+		std::string manifestFile;
 		bool        printConfStats;
 		bool        printPharmStats;
 		bool        printFeatureStats;
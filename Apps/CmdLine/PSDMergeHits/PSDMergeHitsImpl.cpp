@@ -0,0 +1,451 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PSDMergeHitsImpl.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Base/DataIOManager.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "CmdLine/Lib/HelperFunctions.hpp"
+
+#include "PSDMergeHitsImpl.hpp"
+
+
+using namespace PSDMergeHits;
+
+
+namespace
+{
+
+	const std::string HIT_RANK_PROPERTY_NAME = "<Hit Rank>";
+
+	bool matchesPropertyName(const std::string& header, const std::string& name)
+	{
+		std::string trimmed_header = boost::trim_copy(header);
+
+		if (trimmed_header == name)
+			return true;
+
+		return (trimmed_header.size() == name.size() + 2 && trimmed_header[0] == '<' && trimmed_header[name.size() + 1] == '>' && 
+				trimmed_header.compare(1, name.size(), name) == 0);
+	}
+}
+
+
+bool PSDMergeHitsImpl::HitRecord::operator<(const HitRecord& rec) const
+{
+	if (score > rec.score)
+		return true;
+
+	if (score < rec.score)
+		return false;
+
+	if (molIndex < rec.molIndex)
+		return true;
+
+	if (molIndex > rec.molIndex)
+		return false;
+
+	return (recordIndex < rec.recordIndex);
+}
+
+
+PSDMergeHitsImpl::PSDMergeHitsImpl(): 
+	maxNumHits(0), scoreProperty("Score"), molIndexProperty("Molecule Index"), outputRank(false), 
+	numInputHits(0), numSkippedHits(0)
+{
+	addOption("input,i", "Input hit file(s).", 
+			  value<StringList>(&inputFiles)->multitoken()->required());
+	addOption("output,o", "Ranked hit output file.", 
+			  value<std::string>(&outputFile)->required());
+	addOption("max-num-hits,n", "Maximum number of top-ranked hits to output (default: no limit).", 
+			  value<std::size_t>(&maxNumHits)->default_value(0));
+	addOption("score-property,s", "Name of the hit molecule property storing the score (default: Score).", 
+			  value<std::string>(&scoreProperty));
+	addOption("mol-index-property,m", "Name of the hit molecule property storing the database molecule index that is used "
+			  "for breaking score ties (default: Molecule Index).", 
+			  value<std::string>(&molIndexProperty));
+	addOption("output-rank,R", "Output hit rank property for ranked hit molecules (default: false).", 
+			  value<bool>(&outputRank)->implicit_value(true));
+	addOption("input-format,I", "Input file format (default: auto-detect from file extension).", 
+			  value<std::string>()->notifier(boost::bind(&PSDMergeHitsImpl::setInputFormat, this, _1)));
+	addOption("output-format,O", "Output file format (default: auto-detect from file extension).", 
+			  value<std::string>()->notifier(boost::bind(&PSDMergeHitsImpl::setOutputFormat, this, _1)));
+
+	addOptionLongDescriptions();
+}
+
+const char* PSDMergeHitsImpl::getProgName() const
+{
+    return "PSDMergeHits";
+}
+
+const char* PSDMergeHitsImpl::getProgCopyright() const
+{
+    return "Thomas A. Seidel";
+}
+
+const char* PSDMergeHitsImpl::getProgAboutText() const
+{
+	return "Merges the hit lists of multiple PSDScreen runs (e.g. for different shards of a database) into a single list "
+		"of hits ranked by score.";
+}
+
+void PSDMergeHitsImpl::addOptionLongDescriptions()
+{
+	StringList formats;
+	std::string formats_str = "Supported Input Formats:";
+
+	CmdLineLib::getSupportedInputFormats<CDPL::Chem::Molecule>(std::back_inserter(formats));
+
+	for (StringList::const_iterator it = formats.begin(), end = formats.end(); it != end; ++it)
+		formats_str.append("\n - ").append(*it);
+
+	addOptionLongDescription("input", 
+							 "Specifies the hit molecule files written by PSDScreen that shall be merged. The hits must provide a score "
+							 "property (PSDScreen option -S).\n\n" + formats_str);
+
+	addOptionLongDescription("input-format", 
+							 "Allows to explicitly specify the format of the input file(s) by providing one of the supported "
+							 "file-extensions (without leading dot!) as argument.\n\n" +
+							 formats_str +
+							 "\n\nThis option is useful when the format cannot be auto-detected from the actual extension of the file(s) "
+							 "(because missing, misleading or not supported).");
+
+	formats.clear();
+	formats_str = "Supported Output Formats:";
+
+	CmdLineLib::getSupportedOutputFormats<CDPL::Chem::MolecularGraph>(std::back_inserter(formats));
+
+	for (StringList::const_iterator it = formats.begin(), end = formats.end(); it != end; ++it)
+		formats_str.append("\n - ").append(*it);
+
+	addOptionLongDescription("output", 
+							 "Specifies the output file where the hit molecules will be stored in the order of decreasing score. Hits "
+							 "with equal scores are ordered by increasing database molecule index (PSDScreen option -I) and then by "
+							 "their position in the input files.\n\n" + formats_str);
+
+	addOptionLongDescription("output-format", 
+							 "Allows to explicitly specify the output format by providing one of the supported "
+							 "file-extensions (without leading dot!) as argument.\n\n" +
+							 formats_str +
+							 "\n\nThis option is useful when the format cannot be auto-detected from the actual extension of the file "
+							 "(because missing, misleading or not supported).");
+}
+
+void PSDMergeHitsImpl::setInputFormat(const std::string& file_ext)
+{
+	using namespace CDPL;
+
+	inputHandler = Base::DataIOManager<Chem::Molecule>::getInputHandlerByFileExtension(file_ext);
+
+	if (!inputHandler)
+		throwValidationError("input-format");
+}
+
+void PSDMergeHitsImpl::setOutputFormat(const std::string& file_ext)
+{
+	using namespace CDPL;
+
+	outputHandler = Base::DataIOManager<Chem::MolecularGraph>::getOutputHandlerByFileExtension(file_ext);
+
+	if (!outputHandler)
+		throwValidationError("output-format");
+}
+
+int PSDMergeHitsImpl::process()
+{
+	startTime = Clock::now();
+
+	printMessage(INFO, getProgTitleString());
+	printMessage(INFO, "");
+
+	checkInputFiles();
+	printOptionSummary();
+	initInputReader();
+
+	if (termSignalCaught())
+		return EXIT_FAILURE;
+
+	if (!collectHitRecords())
+		return EXIT_FAILURE;
+
+	selectHitRecords();
+
+	if (!writeRankedHits())
+		return EXIT_FAILURE;
+
+	printStatistics(boost::chrono::duration_cast<boost::chrono::duration<std::size_t> >(Clock::now() - startTime).count());
+
+	return EXIT_SUCCESS;
+}
+
+void PSDMergeHitsImpl::initInputReader()
+{
+	using namespace CDPL;
+
+	printMessage(INFO, "Scanning Input File(s)...");
+
+	setMultiConfImportParameter(inputReader, false);
+
+	for (StringList::const_iterator it = inputFiles.begin(), end = inputFiles.end(); it != end; ++it) {
+		if (termSignalCaught())
+			return;
+
+		InputHandlerPtr input_handler = getInputHandler(*it);
+
+		if (!input_handler)
+			throw Base::IOError("no input handler found for file '" + *it + '\'');
+
+		MoleculeReader::SharedPointer reader_ptr = input_handler->createReader(*it);
+
+		setMultiConfImportParameter(*reader_ptr, false);
+
+		inputReader.addReader(reader_ptr);
+	}
+
+	numInputHits = inputReader.getNumRecords();
+
+	printMessage(INFO, " - Found " + boost::lexical_cast<std::string>(numInputHits) + " hit molecule(s)");
+	printMessage(INFO, "");
+}
+
+bool PSDMergeHitsImpl::collectHitRecords()
+{
+	using namespace CDPL;
+
+	if (progressEnabled()) {
+		initProgress();
+		printMessage(INFO, "Collecting Hit Scores...", true, true);
+	} else
+		printMessage(INFO, "Collecting Hit Scores...");
+
+	Chem::BasicMolecule mol;
+	HitRecord rec;
+
+	hitRecords.clear();
+
+	for (std::size_t i = 0; i < numInputHits; i++) {
+		if (termSignalCaught())
+			return false;
+
+		inputReader.read(i, mol);
+
+		if (!getHitRecord(mol, rec)) {
+			printMessage(VERBOSE, "Hit molecule " + boost::lexical_cast<std::string>(i) + " ('" + getName(mol) + 
+						 "') has no valid score property - skipped");
+			numSkippedHits++;
+			continue;
+		}
+
+		rec.recordIndex = i;
+
+		hitRecords.push_back(rec);
+
+		// only the maxNumHits best records have to be kept
+
+		if (maxNumHits > 0 && hitRecords.size() >= 2 * maxNumHits) {
+			std::nth_element(hitRecords.begin(), hitRecords.begin() + maxNumHits, hitRecords.end());
+			hitRecords.resize(maxNumHits);
+		}
+
+		if (progressEnabled())
+			printProgress("Collecting Hit Scores... ", double(i + 1) / numInputHits);
+	}
+
+	printMessage(INFO, "");
+
+	return true;
+}
+
+void PSDMergeHitsImpl::selectHitRecords()
+{
+	std::sort(hitRecords.begin(), hitRecords.end());
+
+	if (maxNumHits > 0 && hitRecords.size() > maxNumHits)
+		hitRecords.resize(maxNumHits);
+}
+
+bool PSDMergeHitsImpl::writeRankedHits()
+{
+	using namespace CDPL;
+
+	OutputHandlerPtr output_handler = getOutputHandler(outputFile);
+
+	if (!output_handler)
+		throw Base::IOError("no output handler found for file '" + outputFile + '\'');
+
+	Base::DataWriter<Chem::MolecularGraph>::SharedPointer writer_ptr = output_handler->createWriter(outputFile);
+
+	setMultiConfExportParameter(*writer_ptr, false);
+
+	if (progressEnabled()) {
+		initProgress();
+		printMessage(INFO, "Writing Ranked Hits...", true, true);
+	} else
+		printMessage(INFO, "Writing Ranked Hits...");
+
+	Chem::BasicMolecule mol;
+
+	for (std::size_t i = 0; i < hitRecords.size(); i++) {
+		if (termSignalCaught())
+			return false;
+
+		inputReader.read(hitRecords[i].recordIndex, mol);
+
+		if (outputRank) {
+			Chem::StringDataBlock::SharedPointer struc_data;
+
+			if (hasStructureData(mol)) 
+				struc_data.reset(new Chem::StringDataBlock(*getStructureData(mol)));
+			else
+				struc_data.reset(new Chem::StringDataBlock());
+
+			struc_data->addEntry(HIT_RANK_PROPERTY_NAME, boost::lexical_cast<std::string>(i + 1));
+
+			setStructureData(mol, struc_data);
+		}
+
+		if (!writer_ptr->write(mol))
+			throw Base::IOError("writing hit molecule failed");
+
+		if (progressEnabled())
+			printProgress("Writing Ranked Hits...   ", double(i + 1) / hitRecords.size());
+	}
+
+	writer_ptr->close();
+
+	printMessage(INFO, "");
+
+	return true;
+}
+
+bool PSDMergeHitsImpl::getHitRecord(const CDPL::Chem::Molecule& mol, HitRecord& rec) const
+{
+	using namespace CDPL;
+
+	if (!hasStructureData(mol))
+		return false;
+
+	const Chem::StringDataBlock& struc_data = *getStructureData(mol);
+	bool have_score = false;
+
+	rec.molIndex = std::numeric_limits<std::size_t>::max();
+
+	// properties written by PSDScreen get appended to the existing ones - the last matching entry thus takes precedence
+
+	for (Chem::StringDataBlock::ConstElementIterator it = struc_data.getElementsBegin(), end = struc_data.getElementsEnd(); it != end; ++it) {
+		if (matchesPropertyName(it->getHeader(), scoreProperty)) {
+			try {
+				rec.score = boost::lexical_cast<double>(boost::trim_copy(it->getData()));
+				have_score = true;
+
+			} catch (const boost::bad_lexical_cast&) {
+				have_score = false;
+			}
+
+		} else if (matchesPropertyName(it->getHeader(), molIndexProperty)) {
+			try {
+				rec.molIndex = boost::lexical_cast<std::size_t>(boost::trim_copy(it->getData()));
+
+			} catch (const boost::bad_lexical_cast&) {
+				rec.molIndex = std::numeric_limits<std::size_t>::max();
+			}
+		}
+	}
+
+	return have_score;
+}
+
+void PSDMergeHitsImpl::checkInputFiles() const
+{
+	using namespace CDPL;
+
+	StringList::const_iterator it = std::find_if(inputFiles.begin(), inputFiles.end(),
+												 boost::bind(std::logical_not<bool>(), 
+															 boost::bind(Util::fileExists, _1)));
+	if (it != inputFiles.end())
+		throw Base::IOError("file '" + *it + "' does not exist");
+
+	if (std::find_if(inputFiles.begin(), inputFiles.end(),
+					 boost::bind(Util::checkIfSameFile, boost::ref(outputFile),
+								 _1)) != inputFiles.end())
+		throw Base::ValueError("output file must not occur in list of input files");
+}
+
+void PSDMergeHitsImpl::printOptionSummary()
+{
+	printMessage(VERBOSE, "Option Summary:");
+	printMessage(VERBOSE, " Input File(s):            " + inputFiles[0]);
+	
+	for (StringList::const_iterator it = ++inputFiles.begin(), end = inputFiles.end(); it != end; ++it)
+		printMessage(VERBOSE, std::string(27, ' ') + *it);
+
+	printMessage(VERBOSE, " Output File:              " + outputFile);
+ 	printMessage(VERBOSE, " Max. Num. Output Hits:    " + (maxNumHits != 0 ? boost::lexical_cast<std::string>(maxNumHits) : std::string("No Limit")));
+ 	printMessage(VERBOSE, " Score Property:           " + scoreProperty);
+ 	printMessage(VERBOSE, " Mol. Index Property:      " + molIndexProperty);
+ 	printMessage(VERBOSE, " Output Rank Property:     " + std::string(outputRank ? "Yes" : "No"));
+	printMessage(VERBOSE, " Input File Format:        " + (inputHandler ? inputHandler->getDataFormat().getName() : std::string("Auto-detect")));
+	printMessage(VERBOSE, " Output File Format:       " + (outputHandler ? outputHandler->getDataFormat().getName() : std::string("Auto-detect")));
+	printMessage(VERBOSE, "");
+}
+
+void PSDMergeHitsImpl::printStatistics(std::size_t proc_time)
+{
+	printMessage(INFO, "Statistics:");
+	printMessage(INFO, " Input Hits:      " + boost::lexical_cast<std::string>(numInputHits));
+	printMessage(INFO, " Skipped Hits:    " + boost::lexical_cast<std::string>(numSkippedHits));
+	printMessage(INFO, " Output Hits:     " + boost::lexical_cast<std::string>(hitRecords.size()));
+	printMessage(INFO, " Processing Time: " + CmdLineLib::formatTimeDuration(proc_time));
+}
+
+PSDMergeHitsImpl::InputHandlerPtr PSDMergeHitsImpl::getInputHandler(const std::string& file_path) const
+{
+	if (inputHandler)
+		return inputHandler;
+
+	return CmdLineLib::getInputHandler<CDPL::Chem::Molecule>(file_path);
+}
+
+PSDMergeHitsImpl::OutputHandlerPtr PSDMergeHitsImpl::getOutputHandler(const std::string& file_path) const
+{
+	if (outputHandler)
+		return outputHandler;
+
+	return CmdLineLib::getOutputHandler<CDPL::Chem::MolecularGraph>(file_path);
+}
@@ -0,0 +1,126 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PSDMergeHitsImpl.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef PSDMERGEHITS_PSDMERGEHITSIMPL_HPP
+#define PSDMERGEHITS_PSDMERGEHITSIMPL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <string>
+
+#include <boost/chrono/chrono.hpp>
+
+#include "CDPL/Util/CompoundDataReader.hpp"
+#include "CDPL/Base/DataInputHandler.hpp"
+#include "CDPL/Base/DataOutputHandler.hpp"
+
+#include "CmdLine/Lib/CmdLineBase.hpp"
+
+
+namespace CDPL
+{
+
+	namespace Chem
+	{
+
+		class Molecule;
+		class MolecularGraph;
+	}
+}
+
+
+namespace PSDMergeHits
+{
+
+    class PSDMergeHitsImpl : public CmdLineLib::CmdLineBase
+    {
+
+    public:
+		PSDMergeHitsImpl();
+
+    private:
+		struct HitRecord
+		{
+
+			double      score;
+			std::size_t molIndex;
+			std::size_t recordIndex;
+
+			bool operator<(const HitRecord& rec) const;
+		};
+
+		typedef CDPL::Base::DataInputHandler<CDPL::Chem::Molecule> InputHandler;
+		typedef InputHandler::SharedPointer InputHandlerPtr;
+		typedef CDPL::Base::DataOutputHandler<CDPL::Chem::MolecularGraph> OutputHandler;
+		typedef OutputHandler::SharedPointer OutputHandlerPtr;
+		typedef CDPL::Base::DataReader<CDPL::Chem::Molecule> MoleculeReader;
+		typedef CDPL::Util::CompoundDataReader<CDPL::Chem::Molecule> CompMoleculeReader;
+		typedef std::vector<HitRecord> HitRecordList;
+		typedef std::vector<std::string> StringList;
+		typedef boost::chrono::system_clock Clock;
+
+		const char* getProgName() const;
+		const char* getProgCopyright() const;
+		const char* getProgAboutText() const;
+
+		void setInputFormat(const std::string& file_ext);
+		void setOutputFormat(const std::string& file_ext);
+
+		int process();
+
+		void initInputReader();
+		bool collectHitRecords();
+		void selectHitRecords();
+		bool writeRankedHits();
+
+		bool getHitRecord(const CDPL::Chem::Molecule& mol, HitRecord& rec) const;
+
+		void checkInputFiles() const;
+		void printOptionSummary();
+		void printStatistics(std::size_t proc_time);
+
+		InputHandlerPtr getInputHandler(const std::string& file_path) const;
+		OutputHandlerPtr getOutputHandler(const std::string& file_path) const;
+
+		void addOptionLongDescriptions();
+
+		StringList          inputFiles;
+		std::string         outputFile;
+		std::size_t         maxNumHits;
+		std::string         scoreProperty;
+		std::string         molIndexProperty;
+		bool                outputRank;
+		InputHandlerPtr     inputHandler;
+		OutputHandlerPtr    outputHandler;
+		CompMoleculeReader  inputReader;
+		HitRecordList       hitRecords;
+		std::size_t         numInputHits;
+		std::size_t         numSkippedHits;
+		Clock::time_point   startTime;
+    };
+}
+
+#endif // PSDMERGEHITS_PSDMERGEHITSIMPL_HPP
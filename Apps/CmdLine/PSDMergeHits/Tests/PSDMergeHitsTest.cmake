@@ -0,0 +1,102 @@
+# -*- mode: CMake -*-
+
+##
+# PSDMergeHitsTest.cmake  
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program; see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+##
+
+# Merges two hit files written in the format of PSDScreen shard runs and checks the ranking of the output hits.
+# Expects PSDMERGEHITS (path of the psdmergehits executable) and TEST_DIR (directory for the generated files).
+
+CMAKE_POLICY(SET CMP0007 NEW)
+
+FUNCTION(WRITE_HIT_RECORD FILE_NAME NAME SCORE MOL_INDEX)
+  FILE(APPEND "${FILE_NAME}" "${NAME}\n  PSDScreen\n\n  1  0  0  0  0  0  0  0  0  0999 V2000\n")
+  FILE(APPEND "${FILE_NAME}" "    0.0000    0.0000    0.0000 C   0  0  0  0  0  0  0  0  0  0  0  0\nM  END\n")
+
+  IF(NOT "${SCORE}" STREQUAL "")
+    FILE(APPEND "${FILE_NAME}" "> <Score>\n${SCORE}\n\n")
+  ENDIF(NOT "${SCORE}" STREQUAL "")
+
+  IF(NOT "${MOL_INDEX}" STREQUAL "")
+    FILE(APPEND "${FILE_NAME}" "> <Molecule Index>\n${MOL_INDEX}\n\n")
+  ENDIF(NOT "${MOL_INDEX}" STREQUAL "")
+
+  FILE(APPEND "${FILE_NAME}" "$$$$\n")
+ENDFUNCTION(WRITE_HIT_RECORD)
+
+FUNCTION(CHECK_MERGED_HITS MAX_NUM_HITS EXPECTED_NAMES)
+  SET(OUTPUT_FILE "${TEST_DIR}/PSDMergeHitsTest_merged.sdf")
+
+  FILE(REMOVE "${OUTPUT_FILE}")
+
+  EXECUTE_PROCESS(COMMAND "${PSDMERGEHITS}" -i "${TEST_DIR}/PSDMergeHitsTest_shard0.sdf" "${TEST_DIR}/PSDMergeHitsTest_shard1.sdf" 
+                  -o "${OUTPUT_FILE}" -n ${MAX_NUM_HITS} -R
+                  RESULT_VARIABLE RESULT OUTPUT_QUIET ERROR_VARIABLE ERROR_OUTPUT)
+
+  IF(NOT RESULT EQUAL 0)
+    MESSAGE(FATAL_ERROR "psdmergehits failed with exit code ${RESULT}:\n${ERROR_OUTPUT}")
+  ENDIF(NOT RESULT EQUAL 0)
+
+  FILE(STRINGS "${OUTPUT_FILE}" NAMES REGEX "^hit_")
+
+  IF(NOT "${NAMES}" STREQUAL "${EXPECTED_NAMES}")
+    MESSAGE(FATAL_ERROR "unexpected hit ranking (max. ${MAX_NUM_HITS} hits): '${NAMES}' instead of '${EXPECTED_NAMES}'")
+  ENDIF(NOT "${NAMES}" STREQUAL "${EXPECTED_NAMES}")
+
+  FILE(STRINGS "${OUTPUT_FILE}" LINES)
+  LIST(FIND LINES "> <Hit Rank>" RANK_IDX)
+
+  IF(RANK_IDX LESS 0)
+    MESSAGE(FATAL_ERROR "missing hit rank property")
+  ENDIF(RANK_IDX LESS 0)
+
+  MATH(EXPR RANK_IDX "${RANK_IDX} + 1")
+  LIST(GET LINES ${RANK_IDX} FIRST_RANK)
+
+  IF(NOT FIRST_RANK STREQUAL "1")
+    MESSAGE(FATAL_ERROR "unexpected rank '${FIRST_RANK}' of the first hit")
+  ENDIF(NOT FIRST_RANK STREQUAL "1")
+ENDFUNCTION(CHECK_MERGED_HITS)
+
+SET(SHARD0_FILE "${TEST_DIR}/PSDMergeHitsTest_shard0.sdf")
+SET(SHARD1_FILE "${TEST_DIR}/PSDMergeHitsTest_shard1.sdf")
+
+FILE(REMOVE "${SHARD0_FILE}" "${SHARD1_FILE}")
+
+WRITE_HIT_RECORD("${SHARD0_FILE}" hit_a 0.9 5)
+WRITE_HIT_RECORD("${SHARD0_FILE}" hit_b 0.7 2)
+WRITE_HIT_RECORD("${SHARD0_FILE}" hit_c "" 3)
+WRITE_HIT_RECORD("${SHARD0_FILE}" hit_d 0.5 0)
+
+WRITE_HIT_RECORD("${SHARD1_FILE}" hit_e 0.7 1)
+WRITE_HIT_RECORD("${SHARD1_FILE}" hit_f 0.95 7)
+WRITE_HIT_RECORD("${SHARD1_FILE}" hit_g 0.7 1)
+WRITE_HIT_RECORD("${SHARD1_FILE}" hit_h 0.7 "")
+
+# hits are ranked by decreasing score, then by increasing molecule index and then by input position;
+# hits without score are skipped and hits without molecule index rank last among equal scores
+
+CHECK_MERGED_HITS(0 "hit_f;hit_a;hit_e;hit_g;hit_b;hit_h;hit_d")
+CHECK_MERGED_HITS(3 "hit_f;hit_a;hit_e")
+CHECK_MERGED_HITS(1 "hit_f")
+
+FILE(REMOVE "${SHARD0_FILE}" "${SHARD1_FILE}" "${TEST_DIR}/PSDMergeHitsTest_merged.sdf")
@@ -30,12 +30,14 @@
 #include <numeric>
 #include <sstream>
 #include <iomanip>
+#include <fstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/ShardedScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/FileScreeningHitCollector.hpp"
 #include "CDPL/Pharm/BasicPharmacophore.hpp"
 #include "CDPL/Pharm/FeatureContainerFunctions.hpp"
@@ -58,9 +60,50 @@ namespace
 {
 
 	typedef std::vector<std::string> StringList;
+	typedef std::vector<CDPL::Pharm::BasicPharmacophore::SharedPointer> QueryPharmacophoreList;
 
 	const std::string PHARM_IDX_PROPERTY_NAME  = "<Query Pharm. Index>";
 	const std::string PHARM_NAME_PROPERTY_NAME = "<Query Pharm. Name>";
+
+	std::string escapeJSONString(const std::string& str)
+	{
+		std::ostringstream oss;
+
+		for (std::string::const_iterator it = str.begin(), end = str.end(); it != end; ++it) {
+			char c = *it;
+
+			switch (c) {
+
+				case '"':
+					oss << "\\\"";
+					break;
+
+				case '\\':
+					oss << "\\\\";
+					break;
+
+				case '\n':
+					oss << "\\n";
+					break;
+
+				case '\t':
+					oss << "\\t";
+					break;
+
+				case '\r':
+					oss << "\\r";
+					break;
+
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+						oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+					else
+						oss << c;
+			}
+		}
+
+		return oss.str();
+	}
 }
 
 
@@ -76,26 +119,22 @@ struct PSDScreenImpl::ScreeningWorker
 		using namespace Pharm;
 
 		try {
-			PSDScreeningDBAccessor db_acc(parent->screeningDB);
-			ScreeningProcessor scr_proc(db_acc);
-			BasicPharmacophore query_pharm;
+			ScreeningDBAccessor::SharedPointer db_acc = parent->createDBAccessor();
+			ScreeningProcessor scr_proc(*db_acc);
 		
 			scr_proc.setHitReportMode(parent->matchingMode);
 			scr_proc.setMaxNumOmittedFeatures(parent->maxOmittedFtrs);
 			scr_proc.checkXVolumeClashes(parent->checkXVols);
 			scr_proc.seekBestAlignments(parent->bestAlignments);
+			scr_proc.pruneAlignmentSearch(parent->pruneAlignments);
 			scr_proc.setHitCallback(boost::bind(&ScreeningWorker::reportHit, this, _1, _2));
 			scr_proc.setProgressCallback(boost::bind(&ScreeningWorker::reportProgress, this, _1, _2));
+			scr_proc.enableStatistics(parent->screeningStatisticsRequired());
 
-			for (queryIndex = 0; queryIndex < parent->numQueryPharms; queryIndex++) {
-				if (PSDScreenImpl::termSignalCaught() || parent->haveErrorMessage())
-					return;
+			screen(scr_proc);
 
-				if (!parent->getQueryPharmacophore(queryIndex, query_pharm))
-					return;
-				
-				scr_proc.searchDB(query_pharm, startMolIndex, endMolIndex);
-			}
+			if (scr_proc.statisticsEnabled())
+				parent->addScreeningStatistics(scr_proc.getStatistics());
 
 		} catch (const std::exception& e) {
 			parent->setErrorMessage("unexpected exception while screening database '" + parent->screeningDB + "':" + e.what());
@@ -105,10 +144,51 @@ struct PSDScreenImpl::ScreeningWorker
 		}
 	}
 
+	void screen(CDPL::Pharm::ScreeningProcessor& scr_proc) {
+		using namespace CDPL;
+		using namespace Pharm;
+
+		BasicPharmacophore query_pharm;
+
+		if (parent->singlePass) {
+			ScreeningProcessor::FeatureContainerList query_list;
+
+			queryIndex = 0;
+
+			for (std::size_t i = 0; i < parent->numQueryPharms; i++) {
+				BasicPharmacophore::SharedPointer pharm(new BasicPharmacophore());
+
+				if (!parent->getQueryPharmacophore(i, *pharm))
+					return;
+
+				queryPharms.push_back(pharm);
+				query_list.push_back(pharm.get());
+			}
+
+			if (PSDScreenImpl::termSignalCaught() || parent->haveErrorMessage())
+				return;
+
+			scr_proc.searchDB(query_list, startMolIndex, endMolIndex);
+			return;
+		}
+
+		for (queryIndex = 0; queryIndex < parent->numQueryPharms; queryIndex++) {
+			if (PSDScreenImpl::termSignalCaught() || parent->haveErrorMessage())
+				return;
+
+			if (!parent->getQueryPharmacophore(queryIndex, query_pharm))
+				return;
+			
+			scr_proc.searchDB(query_pharm, startMolIndex, endMolIndex);
+		}
+	}
+
 	bool reportHit(const CDPL::Pharm::ScreeningProcessor::SearchHit& hit, double score) {
 		using namespace CDPL;
 
 		if (parent->outputPharmIndex || parent->outputPharmName) {
+			std::size_t query_idx = (parent->singlePass ? hit.getQueryPharmacophoreIndex() : queryIndex);
+
 			hitMol.copy(hit.getHitMolecule());
 
 			Chem::StringDataBlock::SharedPointer struc_data;
@@ -120,7 +200,7 @@ struct PSDScreenImpl::ScreeningWorker
 
 			if (parent->outputPharmIndex)
 				struc_data->addEntry(PHARM_IDX_PROPERTY_NAME, 
-									 boost::lexical_cast<std::string>(queryIndex));
+									 boost::lexical_cast<std::string>(query_idx));
 			if (parent->outputPharmName)
 				struc_data->addEntry(PHARM_NAME_PROPERTY_NAME, 
 									 getName(hit.getHitPharmacophore()));
@@ -134,7 +214,8 @@ struct PSDScreenImpl::ScreeningWorker
 																		   hit.getHitAlignmentTransform(),
 																		   hit.getHitPharmacophoreIndex(),
 																		   hit.getHitMoleculeIndex(),
-																		   hit.getHitConformationIndex()),
+																		   hit.getHitConformationIndex(),
+																		   hit.getQueryPharmacophoreIndex()),
 									  score);
 		}
 
@@ -144,6 +225,9 @@ struct PSDScreenImpl::ScreeningWorker
 	bool reportProgress(std::size_t i, std::size_t max_val) {
 		double progress = double(i) / max_val;
 
+		if (parent->singlePass)
+			return parent->printProgress(workerIndex, progress);
+
 		return parent->printProgress(workerIndex, (queryIndex + progress) / parent->numQueryPharms);
 	}
 
@@ -153,12 +237,13 @@ struct PSDScreenImpl::ScreeningWorker
 	std::size_t               endMolIndex;
 	std::size_t               queryIndex;
 	CDPL::Chem::BasicMolecule hitMol;
+	QueryPharmacophoreList    queryPharms;
 };
 
 PSDScreenImpl::PSDScreenImpl(): 
-	checkXVols(true), alignConfs(true), bestAlignments(false), outputScore(true), outputMolIndex(false), 
-	outputConfIndex(false), outputDBName(false), outputPharmName(false), outputPharmIndex(false),  
-	numThreads(0), startMolIndex(0), endMolIndex(0), maxOmittedFtrs(0),
+	checkXVols(true), alignConfs(true), bestAlignments(false), pruneAlignments(false), singlePass(false), outputScore(true), outputMolIndex(false), 
+	outputConfIndex(false), outputDBName(false), outputPharmName(false), outputPharmIndex(false), printScreeningStats(false),
+	numThreads(0), startMolIndex(0), endMolIndex(0), maxOmittedFtrs(0), firstShard(0), numShards(0),
 	matchingMode(CDPL::Pharm::ScreeningProcessor::FIRST_MATCHING_CONF), hitOutputHandler(), 
 	queryInputHandler(), numQueryPharms(0), numDBMolecules(0), numDBPharms(0), numHits(0), maxNumHits(0),
 	lastProgValue(-1)
@@ -176,6 +261,9 @@ PSDScreenImpl::PSDScreenImpl():
 	addOption("end-index,e", "Screening range end molecule index (zero-based and not included"
 			  " in screening!, default: one after last molecule).", 
 			  value<std::size_t>(&endMolIndex)->default_value(0));
+	addOption("shards,R", "Range of database shards to screen (format: FIRST[-LAST], zero-based and inclusive, only for "
+			  "sharded databases, default: all shards).", 
+			  value<std::string>()->notifier(boost::bind(&PSDScreenImpl::setShardRange, this, _1)));
 	addOption("max-num-hits,n", "Maxmimum number of hits to report (default: no limit).", 
 			  value<std::size_t>(&maxNumHits)->default_value(0));
 	addOption("max-omitted,M", "Maximum number of allowed unmatched features.", 
@@ -186,6 +274,13 @@ PSDScreenImpl::PSDScreenImpl():
 			  value<bool>(&alignConfs)->implicit_value(true));
 	addOption("best-alignments,b", "Seek best alignments with highest score (default: false).", 
 			  value<bool>(&bestAlignments)->implicit_value(true));
+	addOption("prune-alignments", "Process alignment cliques in the order of decreasing size and stop the best alignment search as soon as "
+			  "an alignment has been found that perfectly matches all query features whose type occurs in the database pharmacophore "
+			  "(default: false).", 
+			  value<bool>(&pruneAlignments)->implicit_value(true));
+	addOption("single-pass", "Screen all query pharmacophores in a single pass over the database which loads each database "
+			  "pharmacophore only once (default: false).", 
+			  value<bool>(&singlePass)->implicit_value(true));
 	addOption("output-score,S", "Output score property for hit molecule (default: true).", 
 			  value<bool>(&outputScore)->implicit_value(true));
 	addOption("output-mol-index,I", "Output database molecule index property for hit molecule (default: false).", 
@@ -206,6 +301,11 @@ PSDScreenImpl::PSDScreenImpl():
 			  value<std::string>()->notifier(boost::bind(&PSDScreenImpl::setHitOutputFormat, this, _1)));
 	addOption("query-format,Q", "Query pharmacophore input file format (default: auto-detect from file extension).", 
 			  value<std::string>()->notifier(boost::bind(&PSDScreenImpl::setQueryInputFormat, this, _1)));
+	addOption("screening-stats", "Print the number of candidates passed and rejected by each screening stage together with the "
+			  "time spent in the stage (default: false).", 
+			  value<bool>(&printScreeningStats)->implicit_value(true));
+	addOption("stats-file", "Write the screening stage statistics in JSON format to the specified file.", 
+			  value<std::string>(&statsFile));
 
 	addOptionLongDescriptions();
 }
@@ -235,6 +335,32 @@ void PSDScreenImpl::addOptionLongDescriptions()
 	for (StringList::const_iterator it = pharm_formats.begin(), end = pharm_formats.end(); it != end; ++it)
 		pharm_formats_str.append("\n - ").append(*it);
 
+	addOptionLongDescription("database", 
+							 "Specifies the screening database file. A file with the extension '.psdm' is interpreted as a shard manifest "
+							 "(see option --manifest of PSDInfo) that lists the database files storing the shards of a single logical "
+							 "database.");
+
+	addOptionLongDescription("shards", 
+							 "Restricts the screening of a sharded database to a contiguous range of shards. Reported molecule indices "
+							 "always refer to the global molecule index space of the sharded database. The hit lists of runs for different "
+							 "shard ranges can thus be merged and ranked by means of PSDMergeHits. For this purpose, the hit molecules should "
+							 "be written with score and molecule index properties (options -S and -I) and the number of reported hits "
+							 "should not be limited.");
+
+	addOptionLongDescription("screening-stats", 
+							 "Prints a table listing for each stage of the screening process (loading of database pharmacophores, "
+							 "molecules and atom coordinates, feature count check, two-point pharmacophore check, alignment, geometry "
+							 "check, exclusion volume clash check, scoring and hit reporting) the number of candidates that passed or "
+							 "were rejected by the stage and the wall clock and CPU time spent in the stage. Stage times are exclusive "
+							 "and get summed over all worker threads. Comparing the time of the loading stages with the time of the "
+							 "alignment stages reveals whether a run is I/O- or alignment-bound, the reject counts show which query "
+							 "constraints are most selective.");
+
+	addOptionLongDescription("stats-file", 
+							 "Writes the screening stage statistics (see option --screening-stats) as a JSON object to the specified file. "
+							 "The object lists for each stage its name, the number of passed and rejected candidates and the wall clock "
+							 "and CPU time in seconds.");
+
 	addOptionLongDescription("query", 
 							 "Specifies the file containing one or more pharmacophore(s) that shall be used as a query"
 							 "for the database search.\n\n" + pharm_formats_str);
@@ -309,6 +435,30 @@ void PSDScreenImpl::setMatchingMode(const std::string& mode)
 		throwValidationError("mode");
 }
 
+void PSDScreenImpl::setShardRange(const std::string& range)
+{
+	StringList tokens;
+
+	boost::split(tokens, range, boost::is_any_of("-"));
+
+	try {
+		if (tokens.size() < 1 || tokens.size() > 2)
+			throwValidationError("shards");
+
+		firstShard = boost::lexical_cast<std::size_t>(boost::trim_copy(tokens[0]));
+
+		std::size_t last_shard = (tokens.size() == 2 ? boost::lexical_cast<std::size_t>(boost::trim_copy(tokens[1])) : firstShard);
+
+		if (last_shard < firstShard)
+			throwValidationError("shards");
+
+		numShards = last_shard - firstShard + 1;
+
+	} catch (const boost::bad_lexical_cast& e) {
+		throwValidationError("shards");
+	}
+}
+
 int PSDScreenImpl::process()
 {
 	startTime = Clock::now();
@@ -348,6 +498,12 @@ int PSDScreenImpl::process()
 
 	printStatistics();
 
+	if (printScreeningStats)
+		printScreeningStatistics();
+
+	if (!statsFile.empty())
+		writeScreeningStatistics();
+
 	return EXIT_SUCCESS;
 }
 
@@ -575,6 +731,98 @@ void PSDScreenImpl::printStatistics()
 	printMessage(INFO, " Processing Time:         " + CmdLineLib::formatTimeDuration(proc_time));
 }
 
+void PSDScreenImpl::printScreeningStatistics()
+{
+	std::ostringstream oss;
+
+	oss << std::fixed << std::setprecision(3);
+
+	printMessage(INFO, "");
+	printMessage(INFO, "Screening Stage Statistics:");
+	printMessage(INFO, " Stage:                         | Passed       | Rejected     | Wall Time [s] | CPU Time [s]");
+
+	for (std::size_t i = 0; i < ScreeningStatistics::NUM_STAGES; i++) {
+		ScreeningStatistics::Stage stage = ScreeningStatistics::Stage(i);
+
+		oss.str("");
+		oss << ' ' << std::setw(31) << std::left << ScreeningStatistics::getStageName(stage) << "| " << std::right
+			<< std::setw(12) << screeningStats.getNumPassed(stage) << " | " 
+			<< std::setw(12) << screeningStats.getNumRejected(stage) << " | " 
+			<< std::setw(13) << screeningStats.getWallTime(stage) << " | " 
+			<< std::setw(12) << screeningStats.getCPUTime(stage);
+
+		printMessage(INFO, oss.str());
+	}
+
+	oss.str("");
+	oss << ' ' << std::setw(31) << std::left << "Total" << "| " << std::right
+		<< std::setw(12) << "" << " | " << std::setw(12) << "" << " | "
+		<< std::setw(13) << screeningStats.getTotalWallTime() << " | " 
+		<< std::setw(12) << screeningStats.getTotalCPUTime();
+
+	printMessage(INFO, oss.str());
+}
+
+void PSDScreenImpl::writeScreeningStatistics()
+{
+	using namespace CDPL;
+
+	std::ofstream os(statsFile.c_str());
+
+	if (!os)
+		throw Base::IOError("opening statistics output file '" + statsFile + "' failed");
+
+	double proc_time = boost::chrono::duration<double>(Clock::now() - startTime).count();
+
+	os << std::fixed << std::setprecision(6);
+	os << "{\n";
+	os << "  \"database\": \"" << escapeJSONString(screeningDB) << "\",\n";
+	os << "  \"query\": \"" << escapeJSONString(queryPharmFile) << "\",\n";
+	os << "  \"num_threads\": " << numThreads << ",\n";
+	os << "  \"num_screened_molecules\": " << (endMolIndex - startMolIndex) << ",\n";
+	os << "  \"num_hits\": " << numHits << ",\n";
+	os << "  \"processing_time\": " << proc_time << ",\n";
+	os << "  \"total_wall_time\": " << screeningStats.getTotalWallTime() << ",\n";
+	os << "  \"total_cpu_time\": " << screeningStats.getTotalCPUTime() << ",\n";
+	os << "  \"stages\": [\n";
+
+	for (std::size_t i = 0; i < ScreeningStatistics::NUM_STAGES; i++) {
+		ScreeningStatistics::Stage stage = ScreeningStatistics::Stage(i);
+
+		os << "    { \"name\": \"" << escapeJSONString(ScreeningStatistics::getStageName(stage)) 
+		   << "\", \"passed\": " << screeningStats.getNumPassed(stage) 
+		   << ", \"rejected\": " << screeningStats.getNumRejected(stage)
+		   << ", \"wall_time\": " << screeningStats.getWallTime(stage)
+		   << ", \"cpu_time\": " << screeningStats.getCPUTime(stage) << " }"
+		   << (i + 1 < ScreeningStatistics::NUM_STAGES ? ",\n" : "\n");
+	}
+
+	os << "  ]\n";
+	os << "}\n";
+
+	if (!os)
+		throw Base::IOError("writing statistics output file '" + statsFile + "' failed");
+
+	printMessage(INFO, "Wrote screening stage statistics to '" + statsFile + "'");
+}
+
+void PSDScreenImpl::addScreeningStatistics(const ScreeningStatistics& stats)
+{
+	if (numThreads > 0) {
+		boost::lock_guard<boost::mutex> lock(mutex);
+
+		screeningStats += stats;
+		return;
+	}
+
+	screeningStats += stats;
+}
+
+bool PSDScreenImpl::screeningStatisticsRequired() const
+{
+	return (printScreeningStats || !statsFile.empty());
+}
+
 void PSDScreenImpl::checkInputFiles() const
 {
 	using namespace CDPL;
@@ -584,6 +832,9 @@ void PSDScreenImpl::checkInputFiles() const
 
 	if (!Util::fileExists(screeningDB))
 		throw Base::IOError("screening database '" + screeningDB + "' does not exist");
+
+	if (numShards > 0 && !isShardedDatabase())
+		throw Base::IOError("screening database '" + screeningDB + "' is not a shard manifest");
 }
 
 void PSDScreenImpl::printOptionSummary()
@@ -591,6 +842,11 @@ void PSDScreenImpl::printOptionSummary()
 	printMessage(VERBOSE, "Option Summary:");
 	printMessage(VERBOSE, " Pharm. Query File(s):         " + queryPharmFile);
 	printMessage(VERBOSE, " Screening Database:           " + screeningDB);
+
+	if (isShardedDatabase())
+		printMessage(VERBOSE, " Screened Shards:              " + (numShards > 0 ? boost::lexical_cast<std::string>(firstShard) + '-' + 
+																		  boost::lexical_cast<std::string>(firstShard + numShards - 1) : std::string("All")));
+
 	printMessage(VERBOSE, " Hit Output File:              " + hitOutputFile);
  	printMessage(VERBOSE, " Conformation Matching Mode:   " + getMatchingModeString());
 	printMessage(VERBOSE, " Max. Num. Omitted Features:   " + boost::lexical_cast<std::string>(maxOmittedFtrs));
@@ -600,12 +856,19 @@ void PSDScreenImpl::printOptionSummary()
  	printMessage(VERBOSE, " Check X-Volume Clashes:       " + std::string(checkXVols ? "Yes" : "No"));
  	printMessage(VERBOSE, " Align Hit Molecules:          " + std::string(alignConfs ? "Yes" : "No"));
  	printMessage(VERBOSE, " Seek Best Alignments:         " + std::string(bestAlignments ? "Yes" : "No"));
+ 	printMessage(VERBOSE, " Prune Alignment Search:       " + std::string(pruneAlignments ? "Yes" : "No"));
+ 	printMessage(VERBOSE, " Single Pass Screening:        " + std::string(singlePass ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output Score Property:        " + std::string(outputScore ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output Mol. Index Property:   " + std::string(outputMolIndex ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output Conf. Index Property:  " + std::string(outputConfIndex ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output DB-Name Property:      " + std::string(outputDBName ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output Pharm. Name Property:  " + std::string(outputPharmName ? "Yes" : "No"));
  	printMessage(VERBOSE, " Output Pharm. Index Property: " + std::string(outputPharmIndex ? "Yes" : "No"));
+	printMessage(VERBOSE, " Print Screening Statistics:   " + std::string(printScreeningStats ? "Yes" : "No"));
+
+	if (!statsFile.empty())
+		printMessage(VERBOSE, " Statistics Output File:       " + statsFile);
+
 	printMessage(VERBOSE, " Multithreading:               " + std::string(numThreads > 0 ? "Yes" : "No"));
 
 	if (numThreads > 0)
@@ -656,10 +919,10 @@ void PSDScreenImpl::analyzeInputFiles()
 
 	printMessage(INFO, "Scanning Input Files...  ");
 
-	Pharm::PSDScreeningDBAccessor db_acc(screeningDB);
+	Pharm::ScreeningDBAccessor::SharedPointer db_acc = createDBAccessor();
 
-	numDBMolecules = db_acc.getNumMolecules();
-	numDBPharms = db_acc.getNumPharmacophores();
+	numDBMolecules = db_acc->getNumMolecules();
+	numDBPharms = db_acc->getNumPharmacophores();
 	numQueryPharms = queryPharmReader->getNumRecords();
 
 	if (endMolIndex == 0)
@@ -669,9 +932,38 @@ void PSDScreenImpl::analyzeInputFiles()
 
 	startMolIndex = std::min(startMolIndex, numDBMolecules);
 
+	if (isShardedDatabase()) {
+		const Pharm::ShardedScreeningDBAccessor& shard_acc = static_cast<const Pharm::ShardedScreeningDBAccessor&>(*db_acc);
+		const Pharm::ScreeningDBShardManifest& manifest = shard_acc.getManifest();
+		std::size_t num_sel_shards = shard_acc.getNumSelectedShards();
+
+		// restrict the molecule range to the molecules of the selected shards
+
+		if (num_sel_shards > 0) {
+			std::size_t last_shard = shard_acc.getFirstSelectedShard() + num_sel_shards - 1;
+
+			startMolIndex = std::max(startMolIndex, manifest.getShardMoleculeOffset(shard_acc.getFirstSelectedShard()));
+			endMolIndex = std::min(endMolIndex, manifest.getShardMoleculeOffset(last_shard) + manifest.getShardNumMolecules(last_shard));
+		} else
+			endMolIndex = startMolIndex;
+
+		endMolIndex = std::max(startMolIndex, endMolIndex);
+
+		printMessage(INFO, "- " + boost::lexical_cast<std::string>(num_sel_shards) + " of " + 
+					 boost::lexical_cast<std::string>(manifest.getNumShards()) + " Database Shard" + (manifest.getNumShards() != 1 ? "s" : "") + " Selected");
+	}
+
 	printMessage(INFO, "- " + boost::lexical_cast<std::string>(numQueryPharms) + " Query Pharmacophore" + (numQueryPharms != 1 ? "s" : ""));
-	printMessage(INFO, "- " + boost::lexical_cast<std::string>(numDBMolecules) + " Molecule" + (numDBMolecules != 1 ? "s/" : "/") + 
-				 boost::lexical_cast<std::string>(numDBPharms) + " Pharmacophore" + (numDBPharms != 1 ? "s" : "")+ " in Database");
+
+	// the pharmacophore count of a sharded database only covers the selected shards
+
+	if (isShardedDatabase() && numShards > 0) {
+		printMessage(INFO, "- " + boost::lexical_cast<std::string>(numDBMolecules) + " Molecule" + (numDBMolecules != 1 ? "s" : "") + " in Database");
+		printMessage(INFO, "- " + boost::lexical_cast<std::string>(numDBPharms) + " Pharmacophore" + (numDBPharms != 1 ? "s" : "") + " in Selected Shards");
+
+	} else
+		printMessage(INFO, "- " + boost::lexical_cast<std::string>(numDBMolecules) + " Molecule" + (numDBMolecules != 1 ? "s/" : "/") + 
+					 boost::lexical_cast<std::string>(numDBPharms) + " Pharmacophore" + (numDBPharms != 1 ? "s" : "")+ " in Database");
 
 	std::size_t num_screened = endMolIndex - startMolIndex;
 
@@ -679,6 +971,37 @@ void PSDScreenImpl::analyzeInputFiles()
 	printMessage(INFO, "");
 }
 
+bool PSDScreenImpl::isShardedDatabase() const
+{
+	std::string::size_type ext_pos = screeningDB.rfind('.');
+
+	if (ext_pos == std::string::npos)
+		return false;
+
+	return boost::iequals(screeningDB.substr(ext_pos + 1), "psdm");
+}
+
+CDPL::Pharm::ScreeningDBAccessor::SharedPointer PSDScreenImpl::createDBAccessor() const
+{
+	using namespace CDPL;
+
+	if (!isShardedDatabase())
+		return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::PSDScreeningDBAccessor(screeningDB));
+
+	Pharm::ShardedScreeningDBAccessor::SharedPointer db_acc(new Pharm::ShardedScreeningDBAccessor(screeningDB));
+
+	if (numShards > 0) {
+		if (firstShard >= db_acc->getManifest().getNumShards() || numShards > (db_acc->getManifest().getNumShards() - firstShard))
+			throw Base::IndexError("shard range " + boost::lexical_cast<std::string>(firstShard) + '-' +
+								   boost::lexical_cast<std::string>(firstShard + numShards - 1) + " exceeds the number of database shards (" +
+								   boost::lexical_cast<std::string>(db_acc->getManifest().getNumShards()) + ')');
+
+		db_acc->selectShards(firstShard, numShards);
+	}
+
+	return db_acc;
+}
+
 PSDScreenImpl::HitOutputHandlerPtr PSDScreenImpl::getHitOutputHandler(const std::string& file_path) const
 {
 	if (hitOutputHandler)
@@ -36,6 +36,8 @@
 #include <boost/shared_ptr.hpp>
 
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
 #include "CDPL/Base/DataReader.hpp"
 #include "CDPL/Base/DataWriter.hpp"
 #include "CDPL/Base/DataInputHandler.hpp"
@@ -79,6 +81,7 @@ namespace PSDScreen
 		typedef HitOutputHandler::SharedPointer HitOutputHandlerPtr;
 		typedef QueryInputHandler::SharedPointer QueryInputHandlerPtr;
 		typedef CDPL::Pharm::ScreeningProcessor::SearchHit SearchHit;
+		typedef CDPL::Pharm::ScreeningStatistics ScreeningStatistics;
 
 		const char* getProgName() const;
 		const char* getProgCopyright() const;
@@ -87,6 +90,7 @@ namespace PSDScreen
 		void setHitOutputFormat(const std::string& file_ext);
 		void setQueryInputFormat(const std::string& file_ext);
 		void setMatchingMode(const std::string& mode);
+		void setShardRange(const std::string& range);
 
 		int process();
 
@@ -97,6 +101,10 @@ namespace PSDScreen
 		bool haveErrorMessage();
 
 		void printStatistics();
+		void printScreeningStatistics();
+		void writeScreeningStatistics();
+		void addScreeningStatistics(const ScreeningStatistics& stats);
+		bool screeningStatisticsRequired() const;
 		void printOptionSummary();
 
 		void checkInputFiles() const;
@@ -104,6 +112,9 @@ namespace PSDScreen
 		void initHitCollector();
 		void analyzeInputFiles();
 
+		bool isShardedDatabase() const;
+		CDPL::Pharm::ScreeningDBAccessor::SharedPointer createDBAccessor() const;
+
 		bool getQueryPharmacophore(std::size_t idx, CDPL::Pharm::Pharmacophore& pharm);
 		bool doGetQueryPharmacophore(std::size_t idx, CDPL::Pharm::Pharmacophore& pharm);
 
@@ -130,19 +141,25 @@ namespace PSDScreen
 		std::string              queryPharmFile;
 		std::string              screeningDB;
 		std::string              hitOutputFile;
+		std::string              statsFile;
 		bool                     checkXVols;
 		bool                     alignConfs;
 		bool                     bestAlignments;
+		bool                     pruneAlignments;
+		bool                     singlePass;
 		bool                     outputScore;
 		bool                     outputMolIndex;
 		bool                     outputConfIndex;
 		bool                     outputDBName;
 		bool                     outputPharmName;
 		bool                     outputPharmIndex;
+		bool                     printScreeningStats;
 		std::size_t              numThreads;
 		std::size_t              startMolIndex;
 		std::size_t              endMolIndex;
 		std::size_t              maxOmittedFtrs;
+		std::size_t              firstShard;
+		std::size_t              numShards;
 		MatchingMode             matchingMode;
 		HitOutputHandlerPtr      hitOutputHandler;
 		QueryInputHandlerPtr     queryInputHandler;
@@ -153,6 +170,7 @@ namespace PSDScreen
 		boost::mutex             collHitMutex;
 		std::string              errorMessage;
 		Clock::time_point        startTime;
+		ScreeningStatistics      screeningStats;
 		std::size_t              numQueryPharms;
 		std::size_t              numDBMolecules;
 		std::size_t              numDBPharms;
@@ -984,13 +984,19 @@ void StructGenImpl::loadFragmentLibrary()
 	printMessage(INFO, "Loading Fragment Library '" + fragmentLibName + "'...");
 
 	fragmentLib.reset(new FragmentLibrary());
-	fragmentLib->load(is);
 
-	if (StructGenImpl::termSignalCaught())
-		return;
+	if (FragmentLibrary::isIndexedFile(fragmentLibName)) 
+		fragmentLib->loadIndexed(fragmentLibName);
 
-	if (!is)
-		throw Base::IOError("loading fragment library '" + fragmentLibName + "' failed");
+	else {
+		fragmentLib->load(is);
+
+		if (StructGenImpl::termSignalCaught())
+			return;
+
+		if (!is)
+			throw Base::IOError("loading fragment library '" + fragmentLibName + "' failed");
+	}
 
 	printMessage(INFO, " - Loaded " + boost::lexical_cast<std::string>(fragmentLib->getNumEntries()) + " fragments");
 	printMessage(INFO, "");
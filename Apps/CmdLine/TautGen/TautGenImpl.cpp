@@ -161,6 +161,13 @@ private:
 		tautGen.regardIsotopes(parent->regardIsotopes);
 		tautGen.regardStereochemistry(parent->regardStereo);
 		tautGen.setCustomSetupFunction(boost::bind(&setRingFlags, _1, false));
+		tautGen.setNumThreads(parent->numExpansionThreads);
+		tautGen.setMaxNumTautomers(parent->maxNumTautomers);
+		tautGen.setMaxFrontierSize(parent->maxFrontierSize);
+		tautGen.setMaxMemoryUsage(parent->maxMemoryUsage * 1024 * 1024);
+
+		if (parent->bestFirst)
+			tautGen.setScoringFunction(TautomerScore());
 
 		PatternBasedTautomerizationRule::SharedPointer h13_shift(new GenericHydrogen13ShiftTautomerization());
 		PatternBasedTautomerizationRule::SharedPointer h15_shift(new GenericHydrogen15ShiftTautomerization());
@@ -310,7 +317,9 @@ private:
 			}
 		}
 
-		return (parent->maxNumTautomers == 0 || numGenMolTauts < parent->maxNumTautomers);
+		// the tautomer count limit is enforced by the tautomer generator (see setMaxNumTautomers())
+
+		return true;
 	}
 
 	void initMolecule(CDPL::Chem::MolecularGraph& molgraph, bool override) const {
@@ -360,7 +369,8 @@ TautGenImpl::TautGenImpl():
 	imineEnamine(true), nitrosoOxime(true), amideImidicAcid(true),
 	lactamLactim(true), keteneYnol(true), nitroAci(true), phosphinicAcid(true),
 	sulfenicAcid(true), genericH13Shift(true), genericH15Shift(true),
-	numThreads(0), maxNumTautomers(0), mode(Mode::TOPOLOGICALLY_UNIQUE), 
+	numThreads(0), maxNumTautomers(0), numExpansionThreads(1), maxFrontierSize(0), maxMemoryUsage(0), 
+	bestFirst(false), mode(Mode::TOPOLOGICALLY_UNIQUE), 
 	inputHandler(), outputHandler(), outputWriter(), numOutTautomers(0)
 {
 	addOption("input,i", "Input file(s).", 
@@ -385,6 +395,17 @@ TautGenImpl::TautGenImpl():
 			  value<bool>(&neutralize)->implicit_value(true));
 	addOption("max-num-tautomers,n", "Maximum number of output tautomers for each molecule (default: 0, must be >= 0, 0 disables limit).",
 			  value<std::size_t>(&maxNumTautomers));
+	addOption("expansion-threads,x", "Number of threads used for the tautomer generation of a single molecule (default: 1, must be >= 0, "
+			  "0 selects the number of available hardware threads).",
+			  value<std::size_t>(&numExpansionThreads));
+	addOption("max-frontier-size,f", "Maximum number of pending tautomers that are kept for further expansion "
+			  "(default: 0, must be >= 0, 0 disables limit).",
+			  value<std::size_t>(&maxFrontierSize));
+	addOption("max-memory,y", "Approximate memory limit in MB for the tautomer generation of a single molecule "
+			  "(default: 0, must be >= 0, 0 disables limit).",
+			  value<std::size_t>(&maxMemoryUsage));
+	addOption("best-first,b", "Expand tautomers in the order of decreasing tautomer score instead of breadth-first (default: false).", 
+			  value<bool>(&bestFirst)->implicit_value(true));
 	addOption("keto-enol", "Enable keto <-> enol tautomerization (default: true).", 
 			  value<bool>(&ketoEnol)->implicit_value(true));
 	addOption("imine-enamine", "Enable imine <-> enamine tautomerization (default: true).", 
@@ -785,6 +806,10 @@ void TautGenImpl::printOptionSummary()
 	printMessage(VERBOSE, " Isotope Aware:                     " + std::string(regardIsotopes ? "Yes" : "No"));
 	printMessage(VERBOSE, " Neutralize Charges:                " + std::string(neutralize ? "Yes" : "No"));
 	printMessage(VERBOSE, " Max. Num. Tautomers:               " + boost::lexical_cast<std::string>(maxNumTautomers));
+	printMessage(VERBOSE, " Num. Expansion Threads:            " + boost::lexical_cast<std::string>(numExpansionThreads));
+	printMessage(VERBOSE, " Max. Frontier Size:                " + boost::lexical_cast<std::string>(maxFrontierSize));
+	printMessage(VERBOSE, " Max. Memory Usage (MB):            " + boost::lexical_cast<std::string>(maxMemoryUsage));
+	printMessage(VERBOSE, " Best-First Expansion:              " + std::string(bestFirst ? "Yes" : "No"));
 	printMessage(VERBOSE, " Keto-Enol Tautomerization:         " + std::string(ketoEnol ? "Yes" : "No"));
 	printMessage(VERBOSE, " Imine-Enamine Tautomerization:     " + std::string(imineEnamine ? "Yes" : "No"));
 	printMessage(VERBOSE, " Nitroso-Oxime Tautomerization:     " + std::string(nitrosoOxime ? "Yes" : "No"));
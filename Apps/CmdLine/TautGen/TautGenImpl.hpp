@@ -146,6 +146,10 @@ namespace TautGen
 		bool                           genericH15Shift;
 		std::size_t                    numThreads;
 		std::size_t                    maxNumTautomers;
+		std::size_t                    numExpansionThreads;
+		std::size_t                    maxFrontierSize;
+		std::size_t                    maxMemoryUsage;
+		bool                           bestFirst;
 		Mode                           mode;
 		InputHandlerPtr                inputHandler;
 		CompMoleculeReader             inputReader;
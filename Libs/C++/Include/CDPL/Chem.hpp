@@ -55,6 +55,7 @@
 #include "CDPL/Chem/BondMapping.hpp"
 #include "CDPL/Chem/AtomBondMapping.hpp"
 #include "CDPL/Chem/StringDataBlock.hpp"
+#include "CDPL/Chem/ConformerEnsemble.hpp"
 #include "CDPL/Chem/ElementHistogram.hpp"
 #include "CDPL/Chem/MassComposition.hpp"
 #include "CDPL/Chem/MatchConstraintList.hpp"
@@ -223,6 +224,7 @@
 #include "CDPL/Chem/SMILESReactionReader.hpp"
 #include "CDPL/Chem/SMILESMolecularGraphWriter.hpp"
 #include "CDPL/Chem/SMILESReactionWriter.hpp"
+#include "CDPL/Chem/SMILESBulkProcessor.hpp"
 #include "CDPL/Chem/SMARTSMoleculeReader.hpp"
 #include "CDPL/Chem/SMARTSReactionReader.hpp"
 #include "CDPL/Chem/SMARTSMolecularGraphWriter.hpp"
@@ -252,8 +254,11 @@
 #include "CDPL/Chem/CyclicSubstructure.hpp"
 #include "CDPL/Chem/ConnectedSubstructureSet.hpp"
 #include "CDPL/Chem/ComponentSet.hpp"
+#include "CDPL/Chem/PerceptionContext.hpp"
 
 #include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureFilterSet.hpp"
+#include "CDPL/Chem/SubstructureSearchDatabase.hpp"
 #include "CDPL/Chem/ReactionSubstructureSearch.hpp"
 #include "CDPL/Chem/CommonConnectedSubstructureSearch.hpp"
 #include "CDPL/Chem/MaxCommonAtomSubstructureSearch.hpp"
@@ -291,6 +296,7 @@
 #include "CDPL/Chem/PatternAtomTyper.hpp"
 #include "CDPL/Chem/SubstructureHistogramGenerator.hpp"
 #include "CDPL/Chem/PathFingerprintGenerator.hpp"
+#include "CDPL/Chem/SubstructureScreeningFingerprintGenerator.hpp"
 #include "CDPL/Chem/CircularFingerprintGenerator.hpp"
 #include "CDPL/Chem/GeneralizedBellAtomDensity.hpp"  
 #include "CDPL/Chem/AtomDensityGridCalculator.hpp"  
@@ -320,6 +326,7 @@
 #include "CDPL/Chem/Atom3DCoordinatesFunctor.hpp"
 #include "CDPL/Chem/AtomConformer3DCoordinatesFunctor.hpp"
 #include "CDPL/Chem/AtomArray3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/AtomConformerEnsemble3DCoordinatesFunctor.hpp"
 
 #include "CDPL/Chem/SimilarityFunctions.hpp"
 #include "CDPL/Chem/UtilityFunctions.hpp"
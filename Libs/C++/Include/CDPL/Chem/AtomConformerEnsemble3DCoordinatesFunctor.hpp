@@ -0,0 +1,94 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * AtomConformerEnsemble3DCoordinatesFunctor.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::AtomConformerEnsemble3DCoordinatesFunctor.
+ */
+
+#ifndef CDPL_CHEM_ATOMCONFORMERENSEMBLE3DCOORDINATESFUNCTOR_HPP
+#define CDPL_CHEM_ATOMCONFORMERENSEMBLE3DCOORDINATESFUNCTOR_HPP
+
+#include <functional>
+#include <cstddef>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Chem/ConformerEnsemble.hpp"
+#include "CDPL/Math/Vector.hpp"
+
+
+namespace CDPL 
+{
+
+    namespace Chem
+    {
+
+		class Atom;
+		class MolecularGraph;
+
+		/**
+		 * \addtogroup CDPL_CHEM_FUNCTORS
+		 * @{
+		 */
+
+		/**
+		 * \brief AtomConformerEnsemble3DCoordinatesFunctor.
+		 *
+		 * Provides access to the atom coordinates of a single conformer stored in a Chem::ConformerEnsemble without
+		 * copying. The ensemble must not be modified during the lifetime of the functor.
+		 */
+		class CDPL_CHEM_API AtomConformerEnsemble3DCoordinatesFunctor : public std::unary_function<Atom, const Math::Vector3D&>
+		{
+
+		  public:
+			/**
+			 * \brief Constructs the functor for the conformer at index \a conf_idx of the ensemble \a ensemble.
+			 * \param ensemble The conformer ensemble.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \param molgraph The molecular graph whose atoms correspond (in the same order) to the atoms of the conformers.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, ensemble.getNumConformers() - 1].
+			 */
+			AtomConformerEnsemble3DCoordinatesFunctor(const ConformerEnsemble& ensemble, std::size_t conf_idx, const MolecularGraph& molgraph): 
+				coordinates(ensemble.getCoordinates(conf_idx)), molGraph(&molgraph) {}
+
+			/**
+			 * \brief Returns the 3D-coordinates of the argument atom.
+			 * \param atom The atom.
+			 * \return The 3D-coordinates of the atom.
+			 */
+			const Math::Vector3D& operator()(const Atom& atom) const;
+
+		  private:
+			const Math::Vector3D* coordinates;
+			const MolecularGraph* molGraph;
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_CHEM_ATOMCONFORMERENSEMBLE3DCOORDINATESFUNCTOR_HPP
@@ -0,0 +1,219 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ConformerEnsemble.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::ConformerEnsemble.
+ */
+
+#ifndef CDPL_CHEM_CONFORMERENSEMBLE_HPP
+#define CDPL_CHEM_CONFORMERENSEMBLE_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class AtomContainer;
+		class MolecularGraph;
+
+		/**
+		 * \addtogroup CDPL_CHEM_DATA_STRUCTURES
+		 * @{
+		 */
+
+		/**
+		 * \brief Stores the atom coordinates and energies of a set of conformers of a molecular graph.
+		 *
+		 * The coordinates of all conformers are kept in a single contiguous buffer in conformer-major order, i.e. the
+		 * atom coordinates of a given conformer form a consecutive block of getNumAtoms() elements. Access to the
+		 * coordinates of a particular conformer is therefore possible without any copying (see getCoordinates()).
+		 *
+		 * A conformer ensemble is a snapshot of the conformations stored as per-atom 3D coordinates arrays (see 
+		 * Chem::AtomProperty::COORDINATES_3D_ARRAY) and conformer energies (see Chem::MolecularGraphProperty::CONFORMER_ENERGIES)
+		 * of a molecular graph at the time of construction or of the last call to assign(). The per-atom arrays remain the only storage
+		 * of the molecular graph's conformations, later changes are not reflected by the ensemble.
+		 */
+		class CDPL_CHEM_API ConformerEnsemble
+		{
+
+		public:
+			typedef boost::shared_ptr<ConformerEnsemble> SharedPointer;
+
+			/**
+			 * \brief Constructs an empty \c %ConformerEnsemble instance for conformers comprising \a num_atoms atoms.
+			 * \param num_atoms The number of atoms per conformer.
+			 */
+			explicit ConformerEnsemble(std::size_t num_atoms = 0);
+
+			/**
+			 * \brief Constructs a \c %ConformerEnsemble instance that stores the conformations of the molecular graph \a molgraph.
+			 * \param molgraph The molecular graph.
+			 * \see assign()
+			 */
+			explicit ConformerEnsemble(const MolecularGraph& molgraph);
+
+			/**
+			 * \brief Replaces the current contents by the conformations of the molecular graph \a molgraph.
+			 *
+			 * The number of conformers is given by Chem::getNumConformations(). Conformer energies are taken from
+			 * the property Chem::MolecularGraphProperty::CONFORMER_ENERGIES (if available) and set to zero otherwise.
+			 *
+			 * \param molgraph The molecular graph.
+			 */
+			void assign(const MolecularGraph& molgraph);
+
+			/**
+			 * \brief Removes all conformers.
+			 */
+			void clear();
+
+			/**
+			 * \brief Specifies the number of atoms per conformer.
+			 * \param num_atoms The number of atoms per conformer.
+			 * \note All previously stored conformers are removed.
+			 */
+			void setNumAtoms(std::size_t num_atoms);
+
+			/**
+			 * \brief Returns the number of atoms per conformer.
+			 * \return The number of atoms per conformer.
+			 */
+			std::size_t getNumAtoms() const;
+
+			/**
+			 * \brief Returns the number of stored conformers.
+			 * \return The number of stored conformers.
+			 */
+			std::size_t getNumConformers() const;
+
+			/**
+			 * \brief Reserves storage for \a num_confs conformers.
+			 * \param num_confs The number of conformers to reserve storage for.
+			 */
+			void reserve(std::size_t num_confs);
+
+			/**
+			 * \brief Appends a new conformer with uninitialized atom coordinates.
+			 * \param energy The energy of the conformer.
+			 * \return A pointer to the coordinates of the first atom of the new conformer.
+			 * \note The returned pointer gets invalidated by subsequent additions or removals of conformers.
+			 */
+			Math::Vector3D* addConformer(double energy = 0.0);
+
+			/**
+			 * \brief Appends a new conformer with the specified atom coordinates.
+			 * \param coords The atom coordinates of the new conformer.
+			 * \param energy The energy of the conformer.
+			 * \throw Base::SizeError if the number of elements in \a coords is smaller than getNumAtoms().
+			 */
+			void addConformer(const Math::Vector3DArray& coords, double energy = 0.0);
+
+			/**
+			 * \brief Removes the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer to remove.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			void removeConformer(std::size_t conf_idx);
+
+			/**
+			 * \brief Returns a pointer to the coordinates of the first atom of the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \return A pointer to the first element of a block of getNumAtoms() atom coordinates.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			Math::Vector3D* getCoordinates(std::size_t conf_idx);
+
+			/**
+			 * \brief Returns a pointer to the coordinates of the first atom of the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \return A pointer to the first element of a block of getNumAtoms() atom coordinates.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			const Math::Vector3D* getCoordinates(std::size_t conf_idx) const;
+
+			/**
+			 * \brief Returns the energy of the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \return The energy of the conformer.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			double getEnergy(std::size_t conf_idx) const;
+
+			/**
+			 * \brief Sets the energy of the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \param energy The new energy of the conformer.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			void setEnergy(std::size_t conf_idx, double energy);
+
+			/**
+			 * \brief Copies the atom coordinates of the conformer at index \a conf_idx to \a coords.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \param coords The output coordinates array.
+			 * \param append If \c true, the coordinates are appended to \a coords. Otherwise, \a coords gets cleared first.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 */
+			void getConformer(std::size_t conf_idx, Math::Vector3DArray& coords, bool append = false) const;
+
+			/**
+			 * \brief Sets the 3D coordinates (see Chem::AtomProperty::COORDINATES_3D) of the atoms in \a cntnr to the
+			 *        coordinates of the conformer at index \a conf_idx.
+			 * \param conf_idx The zero-based index of the conformer.
+			 * \param cntnr The atom container whose atoms correspond (in the same order) to the atoms of the conformers.
+			 * \throw Base::IndexError if \a conf_idx is not in the range [0, getNumConformers() - 1].
+			 * \throw Base::SizeError if the number of atoms in \a cntnr is not equal to getNumAtoms().
+			 */
+			void applyConformer(std::size_t conf_idx, AtomContainer& cntnr) const;
+
+		private:
+			typedef std::vector<Math::Vector3D> CoordinatesArray;
+			typedef std::vector<double> EnergyArray;
+
+			void checkIndex(std::size_t conf_idx) const;
+
+			std::size_t      numAtoms;
+			CoordinatesArray coordinates;
+			EnergyArray      energies;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_CONFORMERENSEMBLE_HPP
@@ -127,6 +127,19 @@ namespace CDPL
 			 */
 			std::size_t getMinTopologicalMappingSize();
 
+			/**
+			 * \brief Specifies whether the topological entity mappings shall be processed in the order of decreasing size.
+			 * \param order If \c true, larger mappings are processed first.
+			 * \see TopologicalEntityAlignment::orderCliquesBySize()
+			 */
+			void orderTopologicalMappingsBySize(bool order);
+
+			/**
+			 * \brief Tells whether the topological entity mappings are processed in the order of decreasing size.
+			 * \return \c true if larger mappings are processed first, and \c false otherwise.
+			 */
+			bool topologicalMappingsOrderedBySize() const;
+
 			/**
 			 * \brief Specifies a function for the retrieval of entity 3D-coordinates.
 			 * \param func The entity 3D-coordinates function.
@@ -243,6 +256,12 @@ namespace CDPL
 			 */
 			const Math::Matrix4D& getTransform() const;
 
+			/**
+			 * \brief Returns the topological entity mapping from which the transformation matrix of the last found alignment solution was calculated.
+			 * \return The topological entity mapping of the last found alignment solution.
+			 */
+			const EntityMapping& getTopologicalMapping() const;
+
 		private:
 			TopologicalAlignment                   topAlignment;
 			EntityMapping                          topEntityMapping;
@@ -278,6 +297,18 @@ std::size_t CDPL::Chem::GeometricalEntityAlignment<T, EM>::getMinTopologicalMapp
 	return minTopMappingSize;
 }
 
+template <typename T, typename EM>
+void CDPL::Chem::GeometricalEntityAlignment<T, EM>::orderTopologicalMappingsBySize(bool order)
+{
+	topAlignment.orderCliquesBySize(order);
+}
+
+template <typename T, typename EM>
+bool CDPL::Chem::GeometricalEntityAlignment<T, EM>::topologicalMappingsOrderedBySize() const
+{
+	return topAlignment.cliquesOrderedBySize();
+}
+
 template <typename T, typename EM>
 void CDPL::Chem::GeometricalEntityAlignment<T, EM>::setEntity3DCoordinatesFunction(const Entity3DCoordinatesFunction& func)
 {
@@ -435,4 +466,11 @@ const CDPL::Math::Matrix4D& CDPL::Chem::GeometricalEntityAlignment<T, EM>::getTr
 	return transform;
 }
 
+template <typename T, typename EM>
+const typename CDPL::Chem::GeometricalEntityAlignment<T, EM>::EntityMapping& 
+CDPL::Chem::GeometricalEntityAlignment<T, EM>::getTopologicalMapping() const 
+{
+	return topEntityMapping;
+}
+
 #endif // CDPL_CHEM_GEOMETRICALENTITYALIGNMENT_HPP
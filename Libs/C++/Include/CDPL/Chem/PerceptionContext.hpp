@@ -0,0 +1,213 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * PerceptionContext.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::PerceptionContext.
+ */
+
+#ifndef CDPL_CHEM_PERCEPTIONCONTEXT_HPP
+#define CDPL_CHEM_PERCEPTIONCONTEXT_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Chem/FragmentList.hpp"
+#include "CDPL/Chem/Fragment.hpp"
+#include "CDPL/Chem/SmallestSetOfSmallestRings.hpp"
+#include "CDPL/Chem/AromaticSubstructure.hpp"
+#include "CDPL/Chem/ComponentSet.hpp"
+#include "CDPL/Chem/CIPPriorityCalculator.hpp"
+#include "CDPL/Chem/MorganNumberingGenerator.hpp"
+#include "CDPL/Chem/CanonicalNumberingGenerator.hpp"
+#include "CDPL/Chem/AtomPropertyFlag.hpp"
+#include "CDPL/Chem/BondPropertyFlag.hpp"
+#include "CDPL/Util/Array.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class MolecularGraph;
+
+		/**
+		 * \addtogroup CDPL_CHEM_MOLECULAR_GRAPH_ALGORITHMS
+		 * @{
+		 */
+
+		/**
+		 * \brief PerceptionContext.
+		 *
+		 * Performs the perception of commonly required structural properties (components, SSSR, ring flags,
+		 * hybridization states, aromaticity flags, \e CIP priorities, Morgan and canonical atom numberings) of a
+		 * bound molecular graph. Like the corresponding functions in MolecularGraphFunctions.hpp, each method computes and
+		 * stores only properties that are not yet available. In contrast to these functions, intermediate results
+		 * are shared between the perception steps (e.g. the ring flags are derived from the SSSR instead of performing
+		 * a separate ring search) and the algorithm instances are kept for reuse.
+		 *
+		 * The context records the connectivity and the relevant atom and bond attributes (type, formal charge, isotope,
+		 * implicit hydrogen count, bond order) of the molecular graph. After the molecular graph has been edited, a
+		 * call to update() detects the changes and clears only those stored properties that depend on the changed
+		 * data. Edits that keep the connectivity (e.g. charge or bond order changes) leave the ring related properties
+		 * untouched and hybridization states get cleared only for the affected atoms and their neighbors.
+		 *
+		 * \note All perception methods throw a Base::NullPointerException if no molecular graph is bound.
+		 */
+		class CDPL_CHEM_API PerceptionContext
+		{
+
+		public:
+			typedef boost::shared_ptr<PerceptionContext> SharedPointer;
+
+			/**
+			 * \brief Constructs a \c %PerceptionContext instance that is not bound to any molecular graph.
+			 */
+			PerceptionContext();
+
+			/**
+			 * \brief Constructs a \c %PerceptionContext instance that is bound to the molecular graph \a molgraph.
+			 * \param molgraph The molecular graph to bind.
+			 */
+			PerceptionContext(MolecularGraph& molgraph);
+
+			/**
+			 * \brief Binds the context to the molecular graph \a molgraph and records its current state.
+			 *
+			 * Properties already present on \a molgraph are considered to be valid.
+			 *
+			 * \param molgraph The molecular graph to bind.
+			 */
+			void setMolecularGraph(MolecularGraph& molgraph);
+
+			/**
+			 * \brief Returns a pointer to the bound molecular graph.
+			 * \return A pointer to the bound molecular graph, or \e null if the context is unbound.
+			 */
+			MolecularGraph* getMolecularGraph() const;
+
+			/**
+			 * \brief Compares the current state of the bound molecular graph with the recorded state and clears
+			 *        all stored properties that have become invalid.
+			 *
+			 * Besides the properties perceived by the context itself, the \e CIP configuration labels of atoms and bonds
+			 * get cleared whenever the \e CIP priorities are cleared since they depend on the latter.
+			 *
+			 * \return \c true if any changes were detected, and \c false otherwise.
+			 */
+			bool update();
+
+			/**
+			 * \brief Releases the bound molecular graph.
+			 */
+			void clear();
+
+			const FragmentList::SharedPointer& perceiveComponents();
+
+			const FragmentList::SharedPointer& perceiveSSSR();
+
+			/**
+			 * \brief Sets the ring flags of all atoms and bonds and the cyclic substructure of the bound molecular graph.
+			 *
+			 * Since every ring atom and bond is a member of at least one ring of the SSSR, the ring flags are obtained
+			 * from the (already perceived or newly perceived) SSSR.
+			 */
+			void setRingFlags();
+
+			void perceiveHybridizationStates();
+
+			void setAromaticityFlags();
+
+			void calcCIPPriorities();
+
+			void generateMorganNumbering();
+
+			void generateCanonicalNumbering(unsigned int atom_flags = AtomPropertyFlag::DEFAULT, 
+											unsigned int bond_flags = BondPropertyFlag::DEFAULT);
+
+			/**
+			 * \brief Performs all perception steps that are required to prepare the bound molecular graph for substructure
+			 *        searching or fingerprint generation (components, SSSR, ring flags, hybridization states and aromaticity flags).
+			 */
+			void perceiveAll();
+
+		private:
+			struct AtomState
+			{
+
+				bool operator==(const AtomState& state) const;
+
+				bool operator!=(const AtomState& state) const;
+
+				unsigned int type;
+				long         charge;
+				std::size_t  isotope;
+				std::size_t  implHCount;
+			};
+
+			typedef std::vector<std::size_t> IndexArray;
+			typedef std::vector<AtomState> AtomStateArray;
+
+			PerceptionContext(const PerceptionContext&);
+
+			PerceptionContext& operator=(const PerceptionContext&);
+
+			MolecularGraph& getMolGraph() const;
+
+			void recordState(IndexArray& bond_atoms, AtomStateArray& atom_states, IndexArray& bond_orders) const;
+
+			void clearTopologyDependentProperties();
+			void clearChemistryDependentProperties();
+
+			MolecularGraph*             molGraph;
+			IndexArray                  bondAtomIndices;
+			AtomStateArray              atomStates;
+			IndexArray                  bondOrders;
+			IndexArray                  tmpBondAtomIndices;
+			AtomStateArray              tmpAtomStates;
+			IndexArray                  tmpBondOrders;
+			Util::BitSet                changedAtomMask;
+			SmallestSetOfSmallestRings  sssrPerceptor;
+			AromaticSubstructure        aromSubstructPerceptor;
+			ComponentSet                componentPerceptor;
+			CIPPriorityCalculator       cipPriorityCalculator;
+			MorganNumberingGenerator    morganNumberingGenerator;
+			CanonicalNumberingGenerator canonNumberingGenerator;
+			Util::STArray               atomNumbering;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_PERCEPTIONCONTEXT_HPP
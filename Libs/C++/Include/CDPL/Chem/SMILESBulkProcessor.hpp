@@ -0,0 +1,316 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SMILESBulkProcessor.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::SMILESBulkProcessor.
+ */
+
+#ifndef CDPL_CHEM_SMILESBULKPROCESSOR_HPP
+#define CDPL_CHEM_SMILESBULKPROCESSOR_HPP
+
+#include <vector>
+#include <utility>
+#include <string>
+#include <iosfwd>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/atomic.hpp>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Base/DataIOBase.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class Molecule;
+		class MolecularGraph;
+
+		/**
+		 * \addtogroup CDPL_CHEM_SMILES_IO
+		 * @{
+		 */
+
+		/**
+		 * \brief SMILESBulkProcessor.
+		 *
+		 * Provides a fast path for the high-throughput processing of line-delimited SMILES data. Records are parsed directly
+		 * from contiguous memory buffers into molecules that get reused for all records (atoms and bonds are recycled
+		 * instead of reallocated), and generated SMILES strings are appended to output buffers. Reader and writer state,
+		 * as well as the algorithm instances used for structure perception, are created once per worker thread and
+		 * reused across all processed records.
+		 *
+		 * Input data are expected to contain one record per line (empty lines are ignored). The SMILES input/output behavior
+		 * can be configured by the same control-parameters as used by Chem::SMILESMoleculeReader and
+		 * Chem::SMILESMolecularGraphWriter (see namespace Chem::ControlParameter). In particular, the control-parameter
+		 * Chem::ControlParameter::RECORD_SEPARATOR specifies the string that gets appended to each output record and,
+		 * if it consists of a single character, also the character that terminates the input records.
+		 *
+		 * The bulk processing methods process() distribute chunks of consecutive records over the number of threads
+		 * specified by setNumThreads(). The order of the output records always corresponds to the order of the input records.
+		 * Records that cannot be processed are skipped and reported to the error function (see setErrorFunction()).
+		 */
+		class CDPL_CHEM_API SMILESBulkProcessor : public Base::DataIOBase
+		{
+
+		public:
+			typedef boost::shared_ptr<SMILESBulkProcessor> SharedPointer;
+
+			/**
+			 * \brief A generic wrapper class used to store a user-defined molecule processing function.
+			 *
+			 * The function gets called for each successfully parsed record with the molecule and the zero-based index of
+			 * the record as arguments. If the function returns \c false, the record will not be written to the output.
+			 * When processing is performed by multiple threads, the function has to be thread-safe.
+			 */
+			typedef boost::function2<bool, Molecule&, std::size_t> ProcessingFunction;
+
+			/**
+			 * \brief A generic wrapper class used to store a user-defined error handling function.
+			 *
+			 * The function gets called for each record that could not be processed with the zero-based index of the record
+			 * and an error message as arguments. The function is always called from the thread that invoked process() and
+			 * in the order of the failed records.
+			 */
+			typedef boost::function2<void, std::size_t, const std::string&> ErrorFunction;
+
+			/**
+			 * \brief Constructs a \c %SMILESBulkProcessor instance.
+			 */
+			SMILESBulkProcessor();
+
+			/**
+			 * \brief Destructor.
+			 */
+			~SMILESBulkProcessor();
+
+			/**
+			 * \brief Specifies the maximum number of threads that will be used by the bulk processing methods.
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, processing is performed in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			/**
+			 * \brief Returns the specified maximum number of threads.
+			 * \return The maximum number of threads.
+			 */
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Specifies the number of consecutive records that form a unit of work for a single thread.
+			 * \param num_records The number of records per chunk (a value of zero is treated as one).
+			 * \note The default chunk size is \c 256 records.
+			 */
+			void setChunkSize(std::size_t num_records);
+
+			/**
+			 * \brief Returns the number of records per chunk.
+			 * \return The number of records per chunk.
+			 */
+			std::size_t getChunkSize() const;
+
+			/**
+			 * \brief Specifies the approximate number of bytes read at once by process(std::istream&, std::ostream&).
+			 * \param num_bytes The input block size in bytes.
+			 * \note The default block size is 16 MB.
+			 */
+			void setBlockSize(std::size_t num_bytes);
+
+			/**
+			 * \brief Returns the input block size.
+			 * \return The input block size in bytes.
+			 */
+			std::size_t getBlockSize() const;
+
+			/**
+			 * \brief Specifies whether components, rings, hybridization states and aromaticity of parsed molecules
+			 *        have to be perceived before they get passed to the processing function and are written.
+			 *
+			 * \param prepare If \c true, the molecules will be prepared (without overwriting already present properties).
+			 * \note By default, molecule preparation is enabled. Writing canonical SMILES requires at least
+			 *       perceived components.
+			 */
+			void prepareMolecules(bool prepare);
+
+			/**
+			 * \brief Tells whether parsed molecules get prepared before processing and output.
+			 * \return \c true if molecule preparation is enabled, and \c false otherwise.
+			 */
+			bool moleculesPrepared() const;
+
+			/**
+			 * \brief Specifies a function that gets called for each parsed record.
+			 * \param func The processing function.
+			 */
+			void setProcessingFunction(const ProcessingFunction& func);
+
+			/**
+			 * \brief Returns the currently specified processing function.
+			 * \return The processing function.
+			 */
+			const ProcessingFunction& getProcessingFunction() const;
+
+			/**
+			 * \brief Specifies a function that gets called for each record that could not be processed.
+			 * \param func The error handling function.
+			 */
+			void setErrorFunction(const ErrorFunction& func);
+
+			/**
+			 * \brief Returns the currently specified error handling function.
+			 * \return The error handling function.
+			 */
+			const ErrorFunction& getErrorFunction() const;
+
+			/**
+			 * \brief Returns the number of records that could not be processed by the last call to one of the
+			 *        process() methods.
+			 * \return The number of skipped erroneous records.
+			 */
+			std::size_t getNumFailedRecords() const;
+
+			/**
+			 * \brief Parses the SMILES record in the character range [\a rec_beg, \a rec_end) into \a mol.
+			 *
+			 * The previous contents of \a mol get replaced. If \a mol is a Chem::BasicMolecule, atom and bond objects
+			 * will be reused.
+			 *
+			 * \param rec_beg A pointer to the first character of the record.
+			 * \param rec_end A pointer to one past the last character of the record.
+			 * \param mol The molecule storing the read data.
+			 * \return \c true if a record was parsed, and \c false if the range contains only whitespace.
+			 * \throw Base::IOError if the record could not be parsed.
+			 * \note The molecule will not be prepared (see prepareMolecules()).
+			 */
+			bool parseMolecule(const char* rec_beg, const char* rec_end, Molecule& mol);
+
+			/**
+			 * \brief Parses the SMILES record \a rec into \a mol.
+			 * \param rec The SMILES record.
+			 * \param mol The molecule storing the read data.
+			 * \return \c true if a record was parsed, and \c false if \a rec contains only whitespace.
+			 * \throw Base::IOError if the record could not be parsed.
+			 * \see parseMolecule(const char*, const char*, Molecule&)
+			 */
+			bool parseMolecule(const std::string& rec, Molecule& mol);
+
+			/**
+			 * \brief Generates a SMILES record for \a molgraph and appends it to \a buffer.
+			 * \param molgraph The molecular graph to write.
+			 * \param buffer The output buffer.
+			 * \return \c true if the record was generated successfully, and \c false otherwise.
+			 * \throw Base::IOError if an error occurred.
+			 * \note No record separator gets appended.
+			 */
+			bool generateSMILES(const MolecularGraph& molgraph, std::string& buffer);
+
+			/**
+			 * \brief Processes all records in the character range [\a beg, \a end) and appends the output to \a output.
+			 *
+			 * Every record gets parsed, optionally prepared and passed to the processing function. Records accepted by
+			 * the processing function (or all records if none has been specified) are written to \a output, each
+			 * followed by the record separator. Records that cause an error get skipped and are reported to the
+			 * error function.
+			 *
+			 * \param beg A pointer to the first character of the input data.
+			 * \param end A pointer to one past the last character of the input data.
+			 * \param output The output buffer.
+			 * \return The number of written records.
+			 */
+			std::size_t process(const char* beg, const char* end, std::string& output);
+
+			/**
+			 * \brief Processes all records in \a input and appends the output to \a output.
+			 * \param input The input data.
+			 * \param output The output buffer.
+			 * \return The number of written records.
+			 * \see process(const char*, const char*, std::string&)
+			 */
+			std::size_t process(const std::string& input, std::string& output);
+
+			/**
+			 * \brief Processes all records read from the input stream \a is and writes the output to \a os.
+			 *
+			 * The input data are read block-wise (see setBlockSize()) and the records of each block get processed
+			 * as described for process(const char*, const char*, std::string&).
+			 *
+			 * \param is The input stream.
+			 * \param os The output stream.
+			 * \return The number of written records.
+			 * \throw Base::IOError if an I/O error occurred.
+			 */
+			std::size_t process(std::istream& is, std::ostream& os);
+
+		private:
+			struct ProcessingContext;
+
+			typedef boost::shared_ptr<ProcessingContext> ProcessingContextPtr;
+			typedef std::vector<ProcessingContextPtr> ProcessingContextList;
+			typedef std::pair<const char*, const char*> Record;
+			typedef std::vector<Record> RecordList;
+			typedef std::vector<std::string> OutputBufferList;
+			typedef std::pair<std::size_t, std::string> RecordError;
+			typedef std::vector<RecordError> RecordErrorList;
+
+			SMILESBulkProcessor(const SMILESBulkProcessor&);
+
+			SMILESBulkProcessor& operator=(const SMILESBulkProcessor&);
+
+			std::size_t processRecords(const char* beg, const char* end, std::string& output, std::size_t rec_idx_offs);
+
+			void processChunks(boost::atomic<std::size_t>& next_chunk, std::size_t rec_idx_offs, ProcessingContext& ctxt);
+
+			char getInputRecordSeparator() const;
+
+			ProcessingContext& getContext(std::size_t idx);
+
+			ProcessingContextList contexts;
+			RecordList            records;
+			OutputBufferList      outputBuffers;
+			ProcessingFunction    procFunction;
+			ErrorFunction         errorFunction;
+			RecordErrorList       recordErrors;
+			std::string           recordSeparator;
+			std::size_t           numFailedRecords;
+			std::size_t           numThreads;
+			std::size_t           chunkSize;
+			std::size_t           blockSize;
+			bool                  prepMolecules;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_SMILESBULKPROCESSOR_HPP
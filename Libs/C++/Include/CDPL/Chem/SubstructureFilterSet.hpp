@@ -0,0 +1,226 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SubstructureFilterSet.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::SubstructureFilterSet.
+ */
+
+#ifndef CDPL_CHEM_SUBSTRUCTUREFILTERSET_HPP
+#define CDPL_CHEM_SUBSTRUCTUREFILTERSET_HPP
+
+#include <vector>
+#include <utility>
+#include <string>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+	namespace Chem
+	{
+
+		/**
+		 * \addtogroup CDPL_CHEM_SUBGRAPH_ISOMORPHISM
+		 * @{
+		 */
+
+		/**
+		 * \brief SubstructureFilterSet.
+		 *
+		 * Tests a set of substructure query patterns against target molecular graphs. Target-side data (ring
+		 * perception, aromaticity, hybridization states, ...) and a set of atom feature counts derived from it
+		 * are computed only once per target and shared by all patterns. The feature counts are compared with the
+		 * minimum feature counts required by each pattern (as derived from the atom match constraints of the
+		 * pattern atoms) and only patterns passing this screen are subjected to a full substructure search.
+		 *
+		 * \note The query patterns have to be prepared for substructure searching (see Chem::initSubstructureSearchQuery()).
+		 */
+		class CDPL_CHEM_API SubstructureFilterSet
+		{
+
+		public:
+			typedef boost::shared_ptr<SubstructureFilterSet> SharedPointer;
+
+			typedef std::vector<MolecularGraph*> MolecularGraphList;
+			typedef std::vector<Util::BitSet> HitMaskList;
+
+			/**
+			 * \brief Constructs an empty \c %SubstructureFilterSet instance.
+			 */
+			SubstructureFilterSet();
+
+			/**
+			 * \brief Destructor.
+			 */
+			~SubstructureFilterSet();
+
+			/**
+			 * \brief Appends a new query pattern to the set.
+			 * \param pattern The query pattern to append.
+			 */
+			void addPattern(const MolecularGraph::SharedPointer& pattern);
+
+			/**
+			 * \brief Returns a reference to the query pattern at index \a idx.
+			 * \param idx The zero-based index of the query pattern to return.
+			 * \return A reference to the query pattern at index \a idx.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumPatterns() - 1].
+			 */
+			const MolecularGraph::SharedPointer& getPattern(std::size_t idx) const;
+
+			/**
+			 * \brief Removes the query pattern at index \a idx.
+			 * \param idx The zero-based index of the query pattern to remove.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumPatterns() - 1].
+			 */
+			void removePattern(std::size_t idx);
+
+			/**
+			 * \brief Removes all query patterns.
+			 */
+			void clear();
+
+			/**
+			 * \brief Returns the number of query patterns in the set.
+			 * \return The number of query patterns.
+			 */
+			std::size_t getNumPatterns() const;
+
+			/**
+			 * \brief Specifies whether the target molecular graphs have to be prepared for substructure searching
+			 *        (see Chem::initSubstructureSearchTarget()) before any pattern gets tested.
+			 *
+			 * \param init If \c true, the target molecular graphs will be initialized (without overwriting
+			 *             already present properties).
+			 * \note By default, target initialization is enabled.
+			 */
+			void initializeTargets(bool init);
+
+			/**
+			 * \brief Tells whether the target molecular graphs get prepared for substructure searching.
+			 * \return \c true if target initialization is enabled, and \c false otherwise.
+			 */
+			bool targetsInitialized() const;
+
+			/**
+			 * \brief Specifies the maximum number of threads that will be used by filter(const MolecularGraphList&, HitMaskList&).
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, processing is performed in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			/**
+			 * \brief Returns the specified maximum number of threads.
+			 * \return The maximum number of threads.
+			 */
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Tests all query patterns against the molecular graph \a molgraph.
+			 * \param molgraph The target molecular graph.
+			 * \param hit_mask Bit mask receiving the test results (bit \e i is set if the pattern at index \e i matches).
+			 * \return The number of matching query patterns.
+			 */
+			std::size_t filter(MolecularGraph& molgraph, Util::BitSet& hit_mask);
+
+			/**
+			 * \brief Tests all query patterns against each of the specified molecular graphs.
+			 *
+			 * The molecular graphs are distributed over the number of threads specified by setNumThreads().
+			 *
+			 * \param molgraphs The target molecular graphs.
+			 * \param hit_masks Receives one hit mask per molecular graph (see filter(MolecularGraph&, Util::BitSet&)).
+			 */
+			void filter(const MolecularGraphList& molgraphs, HitMaskList& hit_masks);
+
+		private:
+			typedef std::vector<std::size_t> FeatureCountArray;
+			typedef std::pair<std::size_t, std::size_t> FeatureCount;
+			typedef std::vector<FeatureCount> FeatureCountList;
+
+			struct PatternData
+			{
+
+				MolecularGraph::SharedPointer pattern;
+				Util::BitSet                  featureMask;
+				FeatureCountList              minFeatureCounts;
+			};
+
+			typedef boost::shared_ptr<PatternData> PatternDataPtr;
+			typedef std::vector<PatternDataPtr> PatternDataList;
+			typedef std::vector<SubstructureSearch::SharedPointer> SubstructureSearchList;
+
+			struct SearchContext
+			{
+
+				SubstructureSearchList substructSearches;
+				FeatureCountArray      featureCounts;
+				Util::BitSet           featureMask;
+				std::string            errorMessage;
+			};
+
+			typedef boost::shared_ptr<SearchContext> SearchContextPtr;
+			typedef std::vector<SearchContextPtr> SearchContextList;
+
+			SubstructureFilterSet(const SubstructureFilterSet&);
+
+			SubstructureFilterSet& operator=(const SubstructureFilterSet&);
+
+			void initPatternData(PatternData& ptn_data) const;
+
+			void initSearchContext(SearchContext& ctxt) const;
+
+			std::size_t doFilter(MolecularGraph& molgraph, Util::BitSet& hit_mask, SearchContext& ctxt) const;
+
+			void calcTargetFeatures(const MolecularGraph& molgraph, SearchContext& ctxt) const;
+
+			bool passesScreen(const PatternData& ptn_data, const SearchContext& ctxt) const;
+
+			void processMolGraphs(const MolecularGraphList& molgraphs, HitMaskList& hit_masks,
+								  boost::atomic<std::size_t>& next_idx, SearchContext& ctxt) const;
+
+			PatternDataList   patterns;
+			SearchContextList searchContexts;
+			bool              initTargets;
+			std::size_t       numThreads;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_SUBSTRUCTUREFILTERSET_HPP
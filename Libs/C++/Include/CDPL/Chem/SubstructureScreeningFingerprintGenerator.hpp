@@ -0,0 +1,147 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SubstructureScreeningFingerprintGenerator.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::SubstructureScreeningFingerprintGenerator.
+ */
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESCREENINGFINGERPRINTGENERATOR_HPP
+#define CDPL_CHEM_SUBSTRUCTURESCREENINGFINGERPRINTGENERATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class MolecularGraph;
+		class Atom;
+
+		/**
+		 * \addtogroup CDPL_CHEM_FINGERPRINTS
+		 * @{
+		 */
+
+		/**
+		 * \brief SubstructureScreeningFingerprintGenerator.
+		 *
+		 * Generates fingerprints for the fast elimination of molecules that cannot contain a given substructure.
+		 * The fingerprint bits encode minimum counts of chemical elements, heavy atoms, aromatic atoms and ring atoms, 
+		 * as well as linear atom paths labeled by element types. Query fingerprints only encode features that 
+		 * any target matched by the query is guaranteed to exhibit. Consequently, if the query fingerprint is 
+		 * not a subset of the target fingerprint, the query does not match the target.
+		 *
+		 * \note Query and target fingerprints are only comparable if they have been generated with identical
+		 *       settings. Target molecular graphs must be prepared for substructure searching (see 
+		 *       Chem::initSubstructureSearchTarget()), query molecular graphs must provide atom match constraints 
+		 *       (see Chem::initSubstructureSearchQuery()).
+		 */
+		class CDPL_CHEM_API SubstructureScreeningFingerprintGenerator
+		{
+
+		public:
+			/**
+			 * \brief Constructs the \c %SubstructureScreeningFingerprintGenerator instance.
+			 */
+			SubstructureScreeningFingerprintGenerator();
+
+			/**
+			 * \brief Allows to specify the maximum length of the atom paths that get encoded.
+			 * \param max_length The maximum path length in number of bonds.
+			 * \note By default, the maximum path length is \e 5. 
+			 */
+			void setMaxPathLength(std::size_t max_length);
+
+			/**
+			 * \brief Returns the maximum length of the atom paths that get encoded.
+			 * \return The maximum path length in number of bonds.
+			 */
+			std::size_t getMaxPathLength() const;
+
+			/**
+			 * \brief Allows to specify the desired fingerprint size.
+			 * \param num_bits The desired fingerprint size in number of bits.
+			 * \note By default, the generated fingerprints are \e 1024 bits wide.
+			 */
+			void setNumBits(std::size_t num_bits);
+
+			/**
+			 * \brief Returns the size of the generated fingerprints.
+			 * \return The fingerprint size in number of bits.
+			 */
+			std::size_t getNumBits() const;
+
+			/**
+			 * \brief Generates the screening fingerprint of the target molecular graph \a molgraph.
+			 * \param molgraph The target molecular graph for which to generate the fingerprint.
+			 * \param fp The generated fingerprint.
+			 */
+			void generateTargetFingerprint(const MolecularGraph& molgraph, Util::BitSet& fp);
+
+			/**
+			 * \brief Generates the screening fingerprint of the substructure query \a query.
+			 * \param query The query molecular graph for which to generate the fingerprint.
+			 * \param fp The generated fingerprint.
+			 */
+			void generateQueryFingerprint(const MolecularGraph& query, Util::BitSet& fp);
+
+		private:
+			typedef std::vector<unsigned int> LabelArray;
+			typedef std::vector<std::size_t> CountArray;
+			typedef std::vector<bool> FlagArray;
+
+			void init(const MolecularGraph& molgraph, Util::BitSet& fp);
+
+			void setCountBits(Util::BitSet& fp) const;
+
+			void setPathBits(const MolecularGraph& molgraph, Util::BitSet& fp);
+			void setPathBits(const MolecularGraph& molgraph, const Atom& atom, Util::BitSet& fp);
+
+			void setPathBit(Util::BitSet& fp);
+
+			std::size_t     maxPathLength;
+			std::size_t     numBits;
+			LabelArray      atomLabels;
+			CountArray      featureCounts;
+			LabelArray      pathLabels;
+			LabelArray      revPathLabels;
+			FlagArray       visAtomMask;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_SUBSTRUCTURESCREENINGFINGERPRINTGENERATOR_HPP
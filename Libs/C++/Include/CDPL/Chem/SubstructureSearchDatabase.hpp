@@ -0,0 +1,216 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SubstructureSearchDatabase.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Chem::SubstructureSearchDatabase.
+ */
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESEARCHDATABASE_HPP
+#define CDPL_CHEM_SUBSTRUCTURESEARCHDATABASE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+	namespace Chem
+	{
+
+		class MolecularGraph;
+		class Molecule;
+		class SubstructureSearchDatabaseImpl;
+
+		/**
+		 * \addtogroup CDPL_CHEM_SUBGRAPH_ISOMORPHISM
+		 * @{
+		 */
+
+		/**
+		 * \brief SubstructureSearchDatabase.
+		 *
+		 * Stores molecules in a compact binary (CDF) representation together with a substructure screening fingerprint
+		 * (see Chem::SubstructureScreeningFingerprintGenerator) for each of them. Substructure queries are answered by 
+		 * first eliminating all molecules whose fingerprint is not a superset of the query fingerprint and then performing 
+		 * an exact substructure search (see Chem::SubstructureSearch) on the remaining candidates only. Both stages are
+		 * distributed over a configurable number of threads.
+		 *
+		 * A database can be saved to a file and re-opened later. When opened from a file, only the fingerprints are 
+		 * loaded into memory, molecule records are read from the file when needed.
+		 *
+		 * \note The \c const methods getMolecule(), getFingerprint(), screen() and findMatches() keep all of their working
+		 *       data local to the call and may thus be invoked concurrently on the same instance. The non-\c const methods
+		 *       and save() require exclusive access (saving to the opened database file re-opens the file).
+		 */
+		class CDPL_CHEM_API SubstructureSearchDatabase
+		{
+
+		public:
+			typedef boost::shared_ptr<SubstructureSearchDatabase> SharedPointer;
+
+			typedef std::vector<std::size_t> MoleculeIndexList;
+
+			/**
+			 * \brief Constructs an empty \c %SubstructureSearchDatabase instance.
+			 */
+			SubstructureSearchDatabase();
+
+			/**
+			 * \brief Destructor.
+			 */
+			~SubstructureSearchDatabase();
+
+			/**
+			 * \brief Specifies the maximum number of threads that will be used for query processing.
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, queries are processed in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			/**
+			 * \brief Returns the specified maximum number of threads.
+			 * \return The maximum number of threads.
+			 */
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Returns the size of the stored screening fingerprints.
+			 * \return The fingerprint size in number of bits.
+			 */
+			std::size_t getNumFingerprintBits() const;
+
+			/**
+			 * \brief Returns the number of stored molecules.
+			 * \return The number of molecules.
+			 */
+			std::size_t getNumMolecules() const;
+
+			/**
+			 * \brief Adds a molecule to the database.
+			 *
+			 * The properties required for substructure searching are perceived on a copy of \a molgraph
+			 * (see Chem::initSubstructureSearchTarget()) which then gets stored.
+			 *
+			 * \param molgraph The molecular graph to add.
+			 * \return The index of the added molecule.
+			 */
+			std::size_t addMolecule(const MolecularGraph& molgraph);
+
+			/**
+			 * \brief Retrieves the molecule at index \a idx.
+			 * \param idx The zero-based index of the molecule to retrieve.
+			 * \param mol The molecule object receiving the stored data.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumMolecules() - 1], and Base::IOError
+			 *        if reading the molecule record failed.
+			 */
+			void getMolecule(std::size_t idx, Molecule& mol) const;
+
+			/**
+			 * \brief Retrieves the screening fingerprint of the molecule at index \a idx.
+			 * \param idx The zero-based index of the molecule.
+			 * \param fp The bitset receiving the fingerprint.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumMolecules() - 1].
+			 */
+			void getFingerprint(std::size_t idx, Util::BitSet& fp) const;
+
+			/**
+			 * \brief Determines the indices of all molecules whose screening fingerprint is a superset of the 
+			 *        fingerprint of \a query.
+			 * \param query The substructure query (see Chem::initSubstructureSearchQuery()).
+			 * \param cands Receives the indices of the candidate molecules in ascending order.
+			 * \return The number of candidate molecules.
+			 */
+			std::size_t screen(const MolecularGraph& query, MoleculeIndexList& cands) const;
+
+			/**
+			 * \brief Determines the indices of all molecules that contain the substructure \a query.
+			 * \param query The substructure query (see Chem::initSubstructureSearchQuery()).
+			 * \param hits Receives the indices of the matching molecules in ascending order.
+			 * \param max_num_hits The maximum number of hits to report (zero means no limit). If the limit is reached,
+			 *                     the reported hits are the matching molecules with the lowest indices.
+			 * \return The number of matching molecules.
+			 * \throw Base::CalculationFailed if a molecule record could not be read or processed.
+			 */
+			std::size_t findMatches(const MolecularGraph& query, MoleculeIndexList& hits, std::size_t max_num_hits = 0) const;
+
+			/**
+			 * \brief Removes all molecules and closes an opened database file.
+			 */
+			void clear();
+
+			/**
+			 * \brief Saves the database to the file \a file_name.
+			 *
+			 * The data are first written to a temporary file which then replaces \a file_name. Thus, it is
+			 * safe to save the database to the file it has been opened from.
+			 *
+			 * \param file_name The path of the output file.
+			 * \throw Base::IOError if writing the file failed.
+			 */
+			void save(const std::string& file_name) const;
+
+			/**
+			 * \brief Opens the database stored in the file \a file_name.
+			 *
+			 * Previously stored molecules are removed. Molecules added after opening are kept in memory until
+			 * the database gets saved.
+			 *
+			 * \param file_name The path of the database file.
+			 * \throw Base::IOError if the file cannot be opened or does not contain valid data.
+			 */
+			void open(const std::string& file_name);
+
+			/**
+			 * \brief Returns the path of the opened database file.
+			 * \return The path of the opened database file, or an empty string if no file has been opened.
+			 */
+			const std::string& getFileName() const;
+
+		private:
+			typedef std::auto_ptr<SubstructureSearchDatabaseImpl> ImplementationPointer;
+
+			SubstructureSearchDatabase(const SubstructureSearchDatabase&);
+
+			SubstructureSearchDatabase& operator=(const SubstructureSearchDatabase&);
+
+			ImplementationPointer impl;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_CHEM_SUBSTRUCTURESEARCHDATABASE_HPP
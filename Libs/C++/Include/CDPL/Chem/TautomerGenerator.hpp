@@ -32,12 +32,18 @@
 #define CDPL_CHEM_TAUTOMERGENERATOR_HPP
 
 #include <vector>
+#include <map>
+#include <utility>
+#include <string>
 #include <cstddef>
 
 #include <boost/function.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/array.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Chem/BasicMolecule.hpp"
@@ -77,6 +83,7 @@ namespace CDPL
 
 			typedef boost::function1<bool, MolecularGraph&> CallbackFunction;
 			typedef boost::function1<void, MolecularGraph&> CustomSetupFunction;
+			typedef boost::function1<double, const MolecularGraph&> ScoringFunction;
 
 			/**
 			 * \brief Constructs the \c %TautomerGenerator instance.
@@ -115,53 +122,178 @@ namespace CDPL
 
 			void setCustomSetupFunction(const CustomSetupFunction& func);
 
+			/**
+			 * \brief Specifies the number of threads that concurrently expand the set of pending tautomers.
+			 *
+			 * If more than one thread is used, the callback function gets invoked in a serialized manner,
+			 * but the order in which tautomers are reported is not deterministic. The custom setup and
+			 * scoring functions are copied for each thread.
+			 *
+			 * \param num_threads The number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, tautomers are generated in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Specifies the maximum number of tautomers (including the input structure) that get reported
+			 *        before generation stops.
+			 * \param max_num The maximum number of tautomers, or zero for no limit (default).
+			 */
+			void setMaxNumTautomers(std::size_t max_num);
+
+			std::size_t getMaxNumTautomers() const;
+
+			/**
+			 * \brief Specifies the maximum number of generated tautomers that are kept for further expansion.
+			 *
+			 * Once the limit is reached, newly found tautomers still get reported but are not expanded unless they 
+			 * rank higher than the lowest ranking pending tautomer, which then gets discarded.
+			 *
+			 * \param max_size The maximum number of pending tautomers, or zero for no limit (default).
+			 */
+			void setMaxFrontierSize(std::size_t max_size);
+
+			std::size_t getMaxFrontierSize() const;
+
+			/**
+			 * \brief Specifies an upper bound for the (estimated) amount of memory occupied by pending tautomers and
+			 *        the hash codes of the tautomers found so far.
+			 *
+			 * Pending tautomers are discarded as described for setMaxFrontierSize() to stay within the limit. Generation
+			 * stops if the hash codes alone exceed the limit.
+			 *
+			 * \param max_bytes The memory limit in bytes, or zero for no limit (default).
+			 */
+			void setMaxMemoryUsage(std::size_t max_bytes);
+
+			std::size_t getMaxMemoryUsage() const;
+
+			/**
+			 * \brief Specifies a function for ranking the generated tautomers (e.g. a Chem::TautomerScore instance).
+			 *
+			 * If a scoring function has been set, pending tautomers get expanded in the order of decreasing score (best-first,
+			 * ties are resolved in the order of discovery) instead of breadth-first. Without scoring function, all tautomers
+			 * of one generation (i.e. with the same number of tautomerization steps from the input structure) get expanded 
+			 * before those of the next generation and the tautomers of a generation are expanded in the reverse order of 
+			 * their discovery. The scoring function gets invoked on a copy of the tautomer for which the custom setup 
+			 * function has been called and the SSSR, ring flags and aromaticity flags have been perceived. The tautomer 
+			 * itself is left unchanged.
+			 *
+			 * \param func The scoring function, or an empty function object for breadth-first expansion (default).
+			 */
+			void setScoringFunction(const ScoringFunction& func);
+
+			const ScoringFunction& getScoringFunction() const;
+
 			/**
 			 * \brief Generates all unique tautomers of the molecular graph \a molgraph.
 			 * \param molgraph The molecular graph for which to generate the tautomers.
+			 * \throw Base::CalculationFailed if an error occurred in a worker thread.
 			 */
 			void generate(const MolecularGraph& molgraph);
 
 		  private:
 			typedef Util::ObjectPool<BasicMolecule> MoleculeCache;
 			typedef MoleculeCache::SharedObjectPointer MoleculePtr;
+			typedef boost::array<std::size_t, 3> BondDescriptor;
+			typedef std::vector<TautomerizationRule::SharedPointer> TautRuleList;
+			typedef std::vector<BondDescriptor> BondDescrArray;
+			typedef std::vector<std::size_t> SizeTArray;
+			typedef boost::unordered_set<Base::uint64> HashCodeSet;
+			typedef boost::array<std::size_t, 6> StereoCenter;
+			typedef std::vector<StereoCenter> StereoCenterList;
+			typedef std::pair<double, std::size_t> FrontierKey;
+
+			struct FrontierKeyLessCmp
+			{
+
+				bool operator()(const FrontierKey& key1, const FrontierKey& key2) const {
+					if (key1.first != key2.first)
+						return (key1.first > key2.first);
+
+					return (key1.second < key2.second);
+				}
+			};
+
+			typedef std::pair<MoleculePtr, std::size_t> FrontierEntry;
+			typedef std::map<FrontierKey, FrontierEntry, FrontierKeyLessCmp> Frontier;
+
+			struct ExpansionContext
+			{
+
+				TautRuleList          tautRules;
+				HashCodeCalculator    hashCalculator;
+				BondDescrArray        tautomerBonds;
+				SizeTArray            shaInput;
+				CustomSetupFunction   customSetupFunc;
+				ScoringFunction       scoringFunc;
+				BasicMolecule         scoringMolecule;
+				std::string           errorMessage;
+			};
+
+			struct HashCodeSetShard
+			{
+
+				boost::mutex          mutex;
+				HashCodeSet           hashCodes;
+			};
+
+			typedef boost::shared_ptr<ExpansionContext> ExpansionContextPtr;
+			typedef std::vector<ExpansionContextPtr> ExpansionContextList;
+
+			static const std::size_t NUM_HASH_CODE_SET_SHARDS = 16;
 
 			bool init(const MolecularGraph& molgraph);
-			void initHashCalculator();
+			void initExpansionContexts(std::size_t num_threads);
+			void initHashCalculator(HashCodeCalculator& calculator) const;
 
 			MoleculePtr copyInputMolGraph(const MolecularGraph& molgraph);
 
+			MoleculePtr allocMolecule();
+
 			void extractStereoCenters(const MolecularGraph& molgraph);
 			void extractAtomStereoCenters(const MolecularGraph& molgraph);
 			void extractBondStereoCenters(const MolecularGraph& molgraph);
 
-			bool addNewTautomer(const MoleculePtr& mol);
+			void runExpansionWorker(ExpansionContext& ctxt);
+			void expandFrontier(ExpansionContext& ctxt);
+			bool expandTautomer(const MoleculePtr& mol, std::size_t generation, ExpansionContext& ctxt);
 
-			Base::uint64 calcTautomerHashCode(const BasicMolecule& tautomer);
-		
-			typedef boost::array<std::size_t, 3> BondDescriptor;
-			typedef std::vector<MoleculePtr> MoleculeList;
-			typedef std::vector<TautomerizationRule::SharedPointer> TautRuleList;
-			typedef std::vector<BondDescriptor> BondDescrArray;
-			typedef std::vector<std::size_t> SizeTArray;
-			typedef boost::unordered_set<Base::uint64> HashCodeSet;
-			typedef boost::array<std::size_t, 6> StereoCenter;
-			typedef std::vector<StereoCenter> StereoCenterList;
+			bool addNewTautomer(const MoleculePtr& mol, std::size_t generation, ExpansionContext& ctxt);
+			bool insertHashCode(Base::uint64 hash);
+			void addToFrontier(const MoleculePtr& mol, double score, std::size_t generation);
 
-			MoleculeCache         molCache;
-			CallbackFunction      callbackFunc;
-			Mode                  mode;
-			bool                  regStereo;
-			bool                  regIsotopes;
-			CustomSetupFunction   customSetupFunc;
-			TautRuleList          tautRules;
-			MoleculeList          currGeneration;
-			MoleculeList          nextGeneration;
-			StereoCenterList      atomStereoCenters;
-			StereoCenterList      bondStereoCenters;
-			HashCodeSet           tautHashCodes;
-			HashCodeCalculator    hashCalculator;
-			BondDescrArray        tautomerBonds;
-			SizeTArray            shaInput;
+			Base::uint64 calcTautomerHashCode(const BasicMolecule& tautomer, ExpansionContext& ctxt) const;
+		
+			MoleculeCache             molCache;
+			CallbackFunction          callbackFunc;
+			Mode                      mode;
+			bool                      regStereo;
+			bool                      regIsotopes;
+			CustomSetupFunction       customSetupFunc;
+			ScoringFunction           scoringFunc;
+			std::size_t               numThreads;
+			std::size_t               maxNumTautomers;
+			std::size_t               maxFrontierSize;
+			std::size_t               maxMemoryUsage;
+			TautRuleList              tautRules;
+			StereoCenterList          atomStereoCenters;
+			StereoCenterList          bondStereoCenters;
+			ExpansionContextList      expansionContexts;
+			HashCodeSetShard          hashCodeSetShards[NUM_HASH_CODE_SET_SHARDS];
+			Frontier                  frontier;
+			boost::mutex              frontierMutex;
+			boost::condition_variable frontierCondition;
+			boost::mutex              callbackMutex;
+			boost::atomic<bool>       terminate;
+			boost::atomic<std::size_t> numHashCodes;
+			std::size_t               numGenTautomers;
+			std::size_t               numActiveWorkers;
+			std::size_t               nextFrontierSeqNo;
+			std::size_t               molMemoryUsage;
+			bool                      multiThreaded;
 		};
 
 		/**
@@ -34,6 +34,7 @@
 #include <cstddef>
 #include <vector>
 #include <utility>
+#include <algorithm>
 
 #include <boost/function.hpp>
 #include <boost/iterator/indirect_iterator.hpp>
@@ -93,7 +94,7 @@ namespace CDPL
 			/**
 			 * \brief Constructs the \c %TopologicalEntityAlignment instance.
 			 */
-			TopologicalEntityAlignment(): changes(true) {}
+			TopologicalEntityAlignment(): orderedCliques(false), cliqueIndex(0), changes(true) {}
 
 			/**
 			 * \brief Virtual destructor.
@@ -159,6 +160,25 @@ namespace CDPL
 			 */
 			ConstEntityIterator getEntitiesEnd(bool first_set) const;
 
+			/**
+			 * \brief Specifies whether the alignment solutions shall be reported in the order of decreasing size.
+			 *
+			 * If enabled, the maximal cliques of the entity-pair compatibility graph get enumerated in chunks of at most
+			 * \c MAX_ORDERED_CLIQUES cliques and the cliques of each chunk are returned largest first (solutions of equal size
+			 * retain the order in which they were found). The ordering is thus only complete if the number of cliques does not
+			 * exceed the chunk size, but memory consumption stays bounded for large compatibility graphs.
+			 *
+			 * \param order If \c true, solutions are ordered by size, if \c false they are reported in the order they are found.
+			 * \note By default, solutions are not ordered.
+			 */
+			void orderCliquesBySize(bool order);
+
+			/**
+			 * \brief Tells whether the alignment solutions are reported in the order of decreasing size.
+			 * \return \c true if solutions are ordered by size, and \c false otherwise.
+			 */
+			bool cliquesOrderedBySize() const;
+
 			/*
 			 * \brief Resets the internal state and prepares for a new search for entity alignments.
 			 * \note If addEntity() or clearEntities() was called before calling nextAlignment(), init() gets invoked automatically.
@@ -176,6 +196,13 @@ namespace CDPL
 		private:
 			typedef std::pair<const EntityType*, const EntityType*> EntityPair;
 			typedef std::vector<EntityPair> EntityPairArray;
+			typedef std::vector<Util::BitSet> CliqueArray;
+
+			static const std::size_t MAX_ORDERED_CLIQUES = 1000;
+
+			bool nextOrderedClique();
+
+			static bool compareCliqueSize(const Util::BitSet& clique1, const Util::BitSet& clique2);
 
 			EntityMatchFunction         entityMatchFunc;
 			EntityPairMatchFunction     entityPairMatchFunc;
@@ -183,6 +210,9 @@ namespace CDPL
 			EntityPairArray             compatGraphNodes;
 			Util::BitSetArray           adjMatrix;
 			Util::BitSet                clique;
+			CliqueArray                 cliques;
+			bool                        orderedCliques;
+			std::size_t                 cliqueIndex;
 			EntitySet                   firstEntities;
 			EntitySet                   secondEntities;
 			bool                        changes;
@@ -257,6 +287,19 @@ CDPL::Chem::TopologicalEntityAlignment<T, EM>::getEntitiesEnd(bool first_set) co
 	return (first_set ? firstEntities : secondEntities).end();
 }
 
+template <typename T, typename EM>
+void CDPL::Chem::TopologicalEntityAlignment<T, EM>::orderCliquesBySize(bool order)
+{
+	orderedCliques = order;
+	changes = true;
+}
+
+template <typename T, typename EM>
+bool CDPL::Chem::TopologicalEntityAlignment<T, EM>::cliquesOrderedBySize() const
+{
+	return orderedCliques;
+}
+
 template <typename T, typename EM>
 void CDPL::Chem::TopologicalEntityAlignment<T, EM>::init()
 {
@@ -310,6 +353,9 @@ void CDPL::Chem::TopologicalEntityAlignment<T, EM>::init()
 
 	bkAlgorithm.init(adjMatrix);
 
+	cliques.clear();
+	cliqueIndex = 0;
+
 	changes = false;
 }
 
@@ -319,7 +365,11 @@ bool CDPL::Chem::TopologicalEntityAlignment<T, EM>::nextAlignment(EntityMapping&
 	if (changes)
 		init();
 
-	if (!bkAlgorithm.nextClique(clique)) 
+	if (orderedCliques) {
+		if (!nextOrderedClique())
+			return false;
+
+	} else if (!bkAlgorithm.nextClique(clique)) 
 		return false;
 
 	mapping.clear();
@@ -330,4 +380,30 @@ bool CDPL::Chem::TopologicalEntityAlignment<T, EM>::nextAlignment(EntityMapping&
 	return true;
 }
 
+template <typename T, typename EM>
+bool CDPL::Chem::TopologicalEntityAlignment<T, EM>::nextOrderedClique()
+{
+	if (cliqueIndex >= cliques.size()) {
+		cliques.clear();
+		cliqueIndex = 0;
+
+		while (cliques.size() < MAX_ORDERED_CLIQUES && bkAlgorithm.nextClique(clique))
+			cliques.push_back(clique);
+
+		if (cliques.empty())
+			return false;
+
+		std::stable_sort(cliques.begin(), cliques.end(), &TopologicalEntityAlignment::compareCliqueSize);
+	}
+
+	clique = cliques[cliqueIndex++];
+	return true;
+}
+
+template <typename T, typename EM>
+bool CDPL::Chem::TopologicalEntityAlignment<T, EM>::compareCliqueSize(const Util::BitSet& clique1, const Util::BitSet& clique2)
+{
+	return (clique1.count() > clique2.count());
+}
+
 #endif // CDPL_CHEM_TOPOLOGICALENTITYALIGNMENT_HPP
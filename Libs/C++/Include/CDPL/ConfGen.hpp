@@ -39,6 +39,8 @@
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
 #include "CDPL/ConfGen/FragmentLibraryEntry.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
+#include "CDPL/ConfGen/FragmentLibraryMerger.hpp"
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
 #include "CDPL/ConfGen/TorsionRule.hpp"
 #include "CDPL/ConfGen/TorsionCategory.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
@@ -42,6 +42,7 @@
 #include "CDPL/ConfGen/ConformerGeneratorSettings.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
 
 
 namespace CDPL 
@@ -116,6 +117,14 @@ namespace CDPL
 
 			ConformerIterator getConformersEnd();
 
+			void enableStatistics(bool enable);
+
+			bool statisticsEnabled() const;
+
+			const ProcessingStatistics& getStatistics() const;
+
+			void clearStatistics();
+
 		private:
 			ConformerGenerator(const ConformerGenerator&);
 
@@ -104,6 +104,22 @@ namespace CDPL
 
 			std::size_t getTimeout() const;
 
+			/**
+			 * \brief Specifies the maximum number of threads that may be used for generating the conformers of
+			 *        a single molecule.
+			 *
+			 * If more than one thread is allowed, the conformers of independent torsion fragments get generated
+			 * concurrently and independent subtrees of the fragment trees used for torsion driving are processed 
+			 * in parallel.
+			 *
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, processing is performed in the calling thread only. Abort and timeout callbacks
+			 *       may get invoked from different threads if more than one thread is allowed.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			std::size_t getNumThreads() const;
+
 			void setForceFieldTypeSystematic(unsigned int type);
 	    
 			unsigned int getForceFieldTypeSystematic() const;
@@ -116,6 +132,21 @@ namespace CDPL
 
 			bool strictForceFieldParameterization() const;
 
+			/**
+			 * \brief Specifies whether the MMFF94 atom types, bond type indices and atom charges perceived for the processed
+			 *        molecules shall be looked up in and stored to the process-wide ForceField::MMFF94ParameterizationCache
+			 *        instance.
+			 *
+			 * Caching pays off if the same structures get processed repeatedly (regardless of their atom order), e.g. when
+			 * conformers are generated for the stereoisomers or multiple input records of a compound.
+			 *
+			 * \param cache \c true if the cache shall be used, and \c false otherwise.
+			 * \note By default, the cache is not used for the processed molecules.
+			 */
+			void cacheForceFieldParameterization(bool cache);
+
+			bool cacheForceFieldParameterization() const;
+
 			void setDielectricConstant(double de_const);
 
 			double getDielectricConstant() const;
@@ -167,9 +198,11 @@ namespace CDPL
 			double                             eWindow;
 			std::size_t                        maxPoolSize;
 			std::size_t                        timeout;
+			std::size_t                        numThreads;
 			unsigned int                       forceFieldTypeSys;
 			unsigned int                       forceFieldTypeStoch;
 			bool                               strictParam;
+			bool                               cacheParam;
 			double                             dielectricConst;
 			double                             distExponent;
 			std::size_t                        maxNumOutputConfs;
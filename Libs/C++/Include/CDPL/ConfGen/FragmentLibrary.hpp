@@ -32,6 +32,7 @@
 #define CDPL_CONFGEN_FRAGMENTLIBRARY_HPP
 
 #include <iosfwd>
+#include <string>
 #include <cstddef>
 
 #include <boost/shared_ptr.hpp>
@@ -51,6 +52,8 @@ namespace CDPL
     namespace ConfGen 
     {
 
+		class IndexedFragmentLibraryData;
+
 		/**
 		 * \addtogroup CDPL_CONFGEN_DATA_STRUCTURES
 		 * @{
@@ -109,6 +112,14 @@ namespace CDPL
 
 			void loadDefaults();
 
+			void loadIndexed(const std::string& file_name);
+
+			void saveIndexed(std::ostream& os) const;
+
+			bool isIndexed() const;
+
+			static bool isIndexedFile(const std::string& file_name);
+
 			boost::mutex& getMutex();
 
 			static void set(const SharedPointer& lib);
@@ -116,11 +127,19 @@ namespace CDPL
 			static const SharedPointer& get();
 
 		  private:
+			typedef boost::shared_ptr<IndexedFragmentLibraryData> IndexedDataPointer;
+
 			Entry& loadMolStructure(Entry& entry) const;
 
-			static SharedPointer      defaultLib;
-			mutable HashToFragmentMap hashToFragMap;
-			mutable boost::mutex      mutex;
+			void releaseIndexedData() const;
+
+			void addIndexedEntries(const IndexedFragmentLibraryData& data) const;
+
+			static SharedPointer       defaultLib;
+			mutable HashToFragmentMap  hashToFragMap;
+			mutable IndexedDataPointer indexedData;
+			mutable IndexedDataPointer releasedIndexedData;
+			mutable boost::mutex       mutex;
 		};
     
 		/**
@@ -0,0 +1,230 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * FragmentLibraryMerger.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::FragmentLibraryMerger.
+ */
+
+#ifndef CDPL_CONFGEN_FRAGMENTLIBRARYMERGER_HPP
+#define CDPL_CONFGEN_FRAGMENTLIBRARYMERGER_HPP
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+
+#include "CDPL/ConfGen/APIPrefix.hpp"
+#include "CDPL/ConfGen/CallbackFunction.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+		/**
+		 * \addtogroup CDPL_CONFGEN_HELPERS
+		 * @{
+		 */
+
+		/**
+		 * \brief FragmentLibraryMerger.
+		 *
+		 * Merges a set of fragment library files (e.g. the partial libraries generated for the shards of a large
+		 * input collection) into a single output library. The merge operates on the files directly: the input
+		 * libraries (CDF or indexed format) are scanned for the hash codes and file locations of their entries,
+		 * the resulting entry records get sorted by hash code in parallel, and the selected entry data are then
+		 * streamed to the output without decoding the fragment structures. Memory consumption is thus proportional
+		 * to the total number of input entries and not to the size of the libraries.
+		 *
+		 * Entries with the same hash code in more than one input library are resolved deterministically: the entry
+		 * providing the largest number of fragment conformers is kept and ties are broken in favor of the input
+		 * library that has been added first.
+		 */
+		class CDPL_CONFGEN_API FragmentLibraryMerger
+		{
+
+		  public:
+			typedef boost::shared_ptr<FragmentLibraryMerger> SharedPointer;
+
+			/**
+			 * \brief Constructs a \c %FragmentLibraryMerger instance without any input libraries.
+			 */
+			FragmentLibraryMerger();
+
+			/**
+			 * \brief Destructor.
+			 */
+			~FragmentLibraryMerger();
+
+			/**
+			 * \brief Appends the fragment library file \a file_name to the list of merged input libraries.
+			 * \param file_name The path of the fragment library file (CDF or indexed format).
+			 */
+			void addInputLibrary(const std::string& file_name);
+
+			/**
+			 * \brief Returns the path of the input library at index \a idx.
+			 * \param idx The zero-based index of the input library.
+			 * \return The path of the input library file.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumInputLibraries() - 1].
+			 */
+			const std::string& getInputLibrary(std::size_t idx) const;
+
+			/**
+			 * \brief Returns the number of input libraries.
+			 * \return The number of input libraries.
+			 */
+			std::size_t getNumInputLibraries() const;
+
+			/**
+			 * \brief Removes all input libraries.
+			 */
+			void clearInputLibraries();
+
+			/**
+			 * \brief Specifies the maximum number of threads that will be used for scanning the input libraries and
+			 *        sorting the entry records.
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, processing is performed in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			/**
+			 * \brief Returns the specified maximum number of threads.
+			 * \return The maximum number of threads.
+			 */
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Specifies whether the merged library shall be written in the indexed format (see FragmentLibrary::saveIndexed()).
+			 * \param indexed If \c true, the output is written in the indexed format, otherwise in CDF format.
+			 * \note By default, the output is written in CDF format.
+			 */
+			void setIndexedOutput(bool indexed);
+
+			/**
+			 * \brief Tells whether the merged library gets written in the indexed format.
+			 * \return \c true if the output is written in the indexed format, and \c false otherwise.
+			 */
+			bool getIndexedOutput() const;
+
+			/**
+			 * \brief Specifies a function that gets periodically called to check whether the merge shall be aborted.
+			 * \param func The abort callback function.
+			 */
+			void setAbortCallback(const CallbackFunction& func);
+
+			/**
+			 * \brief Returns the specified abort callback function.
+			 * \return The abort callback function.
+			 */
+			const CallbackFunction& getAbortCallback() const;
+
+			/**
+			 * \brief Merges the entries of all input libraries and writes the resulting library to the output stream \a os.
+			 * \param os The output stream.
+			 * \return \c true if the merge has been completed, and \c false if it has been aborted by the abort callback.
+			 * \throw Base::IOError if an input library could not be read or writing the output failed.
+			 */
+			bool merge(std::ostream& os);
+
+			/**
+			 * \brief Returns the total number of entries found in the input libraries by the last call to merge().
+			 * \return The total number of input entries.
+			 */
+			std::size_t getNumInputEntries() const;
+
+			/**
+			 * \brief Returns the number of entries written to the output library by the last call to merge().
+			 * \return The number of output entries.
+			 */
+			std::size_t getNumOutputEntries() const;
+
+			/**
+			 * \brief Returns the number of fragment hash codes that have been encountered in more than one input library
+			 *        during the last call to merge().
+			 * \return The number of resolved entry conflicts.
+			 */
+			std::size_t getNumConflicts() const;
+
+		  private:
+			struct EntryRecord
+			{
+
+				Base::uint64 fragHash;
+				Base::uint64 location;
+				Base::uint64 dataLength;
+				std::size_t  libIndex;
+
+				bool operator<(const EntryRecord& rec) const;
+			};
+
+			typedef std::vector<EntryRecord> EntryRecordList;
+			typedef std::vector<std::string> StringList;
+
+			class InputLibrary;
+
+			typedef boost::shared_ptr<InputLibrary> InputLibraryPtr;
+			typedef std::vector<InputLibraryPtr> InputLibraryList;
+
+			FragmentLibraryMerger(const FragmentLibraryMerger&);
+
+			FragmentLibraryMerger& operator=(const FragmentLibraryMerger&);
+
+			std::size_t getNumWorkerThreads(std::size_t num_tasks) const;
+
+			bool scanInputLibraries(InputLibraryList& libs, EntryRecordList& records);
+			bool sortEntryRecords(EntryRecordList& records) const;
+			bool writeOutput(std::ostream& os, InputLibraryList& libs, const EntryRecordList& records);
+
+			static void scanLibraries(InputLibraryList& libs, boost::atomic<std::size_t>& next_idx);
+			static void sortRecordRange(EntryRecordList::iterator begin, EntryRecordList::iterator end);
+			static void mergeRecordRanges(EntryRecordList::iterator begin, EntryRecordList::iterator mid, EntryRecordList::iterator end);
+
+			bool aborted() const;
+
+			StringList       inputLibFiles;
+			std::size_t      numThreads;
+			bool             indexedOutput;
+			CallbackFunction abortCallback;
+			std::size_t      numInputEntries;
+			std::size_t      numOutputEntries;
+			std::size_t      numConflicts;
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_CONFGEN_FRAGMENTLIBRARYMERGER_HPP
@@ -0,0 +1,168 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ProcessingStatistics.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::ProcessingStatistics.
+ */
+
+#ifndef CDPL_CONFGEN_PROCESSINGSTATISTICS_HPP
+#define CDPL_CONFGEN_PROCESSINGSTATISTICS_HPP
+
+#include <cstddef>
+
+#include "CDPL/ConfGen/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+		/**
+		 * \addtogroup CDPL_CONFGEN_HELPERS
+		 * @{
+		 */
+
+		/**
+		 * \brief ProcessingStatistics.
+		 *
+		 * Accumulates the time spent in the individual phases of conformer generation together with a set of event
+		 * counters. Phase times are wall clock times in seconds. Phases that are processed concurrently by multiple
+		 * threads (e.g. the conformer generation for different torsion fragments) contribute the summed times of all
+		 * involved threads. The energy minimization of hydrogen atoms that get added to provided input coordinates is
+		 * accounted for as well by the time of the phase it happens in (e.g. conformer selection).
+		 */
+		class CDPL_CONFGEN_API ProcessingStatistics
+		{
+
+		  public:
+			/**
+			 * \brief The tracked processing phases.
+			 */
+			enum Phase
+			{
+
+			  FORCE_FIELD_SETUP,
+			  FRAGMENT_SPLITTING,
+			  FRAGMENT_LIBRARY_LOOKUP,
+			  FRAGMENT_CONFORMER_GENERATION,
+			  TORSION_DRIVING,
+			  STRUCTURE_GENERATION,
+			  ENERGY_MINIMIZATION,
+			  CONFORMER_COMBINATION,
+			  CONFORMER_SELECTION,
+			  NUM_PHASES
+			};
+
+			/**
+			 * \brief The tracked event counters.
+			 */
+			enum Counter
+			{
+
+			  MOLECULES,
+			  OUTPUT_CONFORMERS,
+			  TORSION_FRAGMENTS,
+			  FRAGMENT_LIBRARY_HITS,
+			  FRAGMENT_CACHE_HITS,
+			  GENERATED_FRAGMENTS,
+			  ENERGY_MINIMIZATIONS,
+			  MINIMIZATION_ITERATIONS,
+			  NUM_COUNTERS
+			};
+
+			/**
+			 * \brief Constructs a \c %ProcessingStatistics instance with all times and counts set to zero.
+			 */
+			ProcessingStatistics();
+
+			/**
+			 * \brief Returns the accumulated time spent in the specified processing phase.
+			 * \param phase The processing phase.
+			 * \return The accumulated time in seconds.
+			 */
+			double getTime(Phase phase) const;
+
+			/**
+			 * \brief Adds \a secs to the accumulated time of the specified processing phase.
+			 * \param phase The processing phase.
+			 * \param secs The time in seconds to add.
+			 */
+			void addTime(Phase phase, double secs);
+
+			/**
+			 * \brief Returns the value of the specified event counter.
+			 * \param counter The event counter.
+			 * \return The counter value.
+			 */
+			std::size_t getCount(Counter counter) const;
+
+			/**
+			 * \brief Increments the specified event counter by \a num.
+			 * \param counter The event counter.
+			 * \param num The increment.
+			 */
+			void increment(Counter counter, std::size_t num = 1);
+
+			/**
+			 * \brief Sets all times and counts to zero.
+			 */
+			void clear();
+
+			/**
+			 * \brief Adds the times and counts of \a stats to the corresponding values of this instance.
+			 * \param stats The statistics to add.
+			 * \return A reference to itself.
+			 */
+			ProcessingStatistics& operator+=(const ProcessingStatistics& stats);
+
+			/**
+			 * \brief Returns a string representation of the specified processing phase.
+			 * \param phase The processing phase.
+			 * \return The name of the phase.
+			 */
+			static const char* getPhaseName(Phase phase);
+
+			/**
+			 * \brief Returns a string representation of the specified event counter.
+			 * \param counter The event counter.
+			 * \return The name of the counter.
+			 */
+			static const char* getCounterName(Counter counter);
+
+		  private:
+			double      times[NUM_PHASES];
+			std::size_t counts[NUM_COUNTERS];
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_CONFGEN_PROCESSINGSTATISTICS_HPP
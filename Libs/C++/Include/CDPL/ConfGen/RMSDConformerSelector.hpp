@@ -41,7 +41,6 @@
 #include "CDPL/Util/ObjectStack.hpp"
 #include "CDPL/Util/ObjectPool.hpp"
 #include "CDPL/Math/VectorArray.hpp"
-#include "CDPL/Math/VectorArrayAlignmentCalculator.hpp"
 
 
 namespace CDPL 
@@ -55,6 +54,15 @@ namespace CDPL
 		 * @{
 		 */
 
+		/**
+		 * \brief RMSDConformerSelector.
+		 *
+		 * Accepts a conformer only if its symmetry-corrected RMSD to every previously accepted conformer is not
+		 * below the specified minimum RMSD. The RMSD after optimal superposition is calculated by the quaternion
+		 * characteristic polynomial (QCP) method [\ref QCPRM] on pre-centered coordinates. Pairs of conformers whose
+		 * RMSD is already bounded from below by the minimum RMSD (as derived from the principal moments of the
+		 * centered coordinates) are not subjected to an exact calculation for any of the symmetry mappings.
+		 */
 		class CDPL_CONFGEN_API RMSDConformerSelector
 		{
 
@@ -76,8 +84,18 @@ namespace CDPL
 
 		  private:
 			typedef std::vector<std::size_t> IndexArray;
-			typedef Util::ObjectPool<Math::Vector3DArray> VectorArrayCache;
-			typedef VectorArrayCache::SharedObjectPointer VectorArrayPtr;
+			typedef std::vector<double> CoordinatesArray;
+
+			struct ConformerData
+			{
+
+				CoordinatesArray coords;
+				double           innerProduct;
+				double           principalExtents[3];
+			};
+
+			typedef Util::ObjectPool<ConformerData> ConformerDataCache;
+			typedef ConformerDataCache::SharedObjectPointer ConformerDataPtr;
 
 			RMSDConformerSelector(const RMSDConformerSelector&);
 
@@ -91,26 +109,30 @@ namespace CDPL
 								   const Chem::AtomBondMapping& mapping);
 			bool isValidSymMapping(const Chem::AtomBondMapping& mapping) const;
 
-			VectorArrayPtr buildCoordsArrayForMapping(const IndexArray& mapping, 
-													  const Math::Vector3DArray& conf_coords);
+			ConformerDataPtr buildConformerDataForMapping(const IndexArray& mapping, 
+														  const Math::Vector3DArray& conf_coords);
+
+			void calcPrincipalExtents(ConformerData& conf_data) const;
+
+			double calcRMSDLowerBound(const ConformerData& conf_data1, const ConformerData& conf_data2) const;
+
+			double calcRMSD(const ConformerData& conf_data1, const ConformerData& conf_data2, double min_rmsd) const;
 
 			typedef boost::unordered_map<const Chem::Atom*, Chem::StereoDescriptor> AtomStereoDescriptorMap;
 			typedef std::vector<const Chem::Atom*> AtomList;
 			typedef Util::ObjectStack<IndexArray> IndexArrayCache;
 			typedef std::vector<IndexArray*> IndexArrayList;
-			typedef std::vector<VectorArrayPtr> VectorArrayList;
-			typedef Math::VectorArrayAlignmentCalculator<Math::Vector3DArray> AlignmentCalculator;
+			typedef std::vector<ConformerDataPtr> ConformerDataList;
 
 			IndexArrayCache               idxArrayCache;
-			VectorArrayCache              vecArrayCache;
+			ConformerDataCache            confDataCache;
 			const Chem::MolecularGraph*   molGraph;
 			Chem::AutomorphismGroupSearch symMappingSearch;
 			Chem::Fragment                symMappingSearchMolGraph;
 			IndexArrayList                symMappings;
 			AtomStereoDescriptorMap       atomStereoDescrs;
-			AlignmentCalculator           alignmentCalc;
-			VectorArrayList               confAlignCoords;
-			VectorArrayList               selectedConfAlignCoords;
+			ConformerDataList             mappedConfData;
+			ConformerDataList             selectedConfData;
 			AtomList                      atomNeighbors;
 			double                        minRMSD;
 		};
@@ -75,6 +75,17 @@ namespace CDPL
 
 			std::size_t getMaxPoolSize() const;
 
+			/**
+			 * \brief Specifies the maximum number of threads that may be used for the concurrent processing of
+			 *        independent subtrees of the fragment tree.
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, processing is performed in the calling thread only. Abort and timeout callbacks
+			 *       may get invoked from different threads if more than one thread is allowed.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			std::size_t getNumThreads() const;
+
 			void setForceFieldType(unsigned int type);
 	    
 			unsigned int getForceFieldType() const;
@@ -97,6 +108,7 @@ namespace CDPL
 			bool         energyOrdered;
 			double       eWindow;
 			std::size_t  maxPoolSize;
+			std::size_t  numThreads;
 			unsigned int forceFieldType;
 			bool         strictParam;
 			double       dielectricConst;
@@ -32,11 +32,17 @@
 #define CDPL_CONFGEN_TORSIONRULEMATCHER_HPP
 
 #include <vector>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/cstdint.hpp>
 
 #include "CDPL/ConfGen/APIPrefix.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
 #include "CDPL/ConfGen/TorsionRuleMatch.hpp"
 #include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/MatchConstraintList.hpp"
 
 
 namespace CDPL 
@@ -50,12 +56,34 @@ namespace CDPL
 		 * @{
 		 */
 
+		/**
+		 * \brief TorsionRuleMatcher.
+		 *
+		 * On first use of a torsion library, the central bond atom requirements of all rules (atom type, aromaticity,
+		 * ring membership and hybridization state) are extracted, and the rules of each category get indexed by the
+		 * properties of the central atoms of the processed bonds. Thus, only rules that can possibly match a given
+		 * bond are subjected to a substructure search.
+		 *
+		 * If the matcher stops at the first matching rule, the matching rule found for a bond is additionally
+		 * cached together with the bond's local environment. The extent of this environment and the considered atom 
+		 * properties are derived from the rule patterns of the library. A cached result is only used if the environment
+		 * of the processed bond is isomorphic to the cached one. Bonds with an identical environment (e.g. the same amide, 
+		 * ester or aryl-alkyl environments in different molecules) then require at most a single substructure search.
+		 *
+		 * \note Compiled library data are kept until clearCache() is called. The torsion libraries must thus not be
+		 *       modified afterwards without clearing the cache.
+		 */
 		class CDPL_CONFGEN_API TorsionRuleMatcher
 		{
 
 			typedef std::vector<TorsionRuleMatch> RuleMatchList;
 
 		  public:
+			/**
+			 * \brief The default maximum number of cached bond environment match results per torsion library.
+			 */
+			static const std::size_t DEF_RESULT_CACHE_SIZE = 10000;
+
 			typedef RuleMatchList::const_iterator ConstMatchIterator;
 
 			TorsionRuleMatcher();
@@ -78,6 +106,23 @@ namespace CDPL
 
 			const TorsionLibrary::SharedPointer& getTorsionLibrary() const;
 
+			/**
+			 * \brief Specifies the maximum number of bond environment match results that get cached per torsion library.
+			 * \param max_size The maximum number of cached results. A value of zero disables result caching.
+			 */
+			void setResultCacheSize(std::size_t max_size);
+
+			/**
+			 * \brief Returns the maximum number of cached bond environment match results per torsion library.
+			 * \return The maximum number of cached results.
+			 */
+			std::size_t getResultCacheSize() const;
+
+			/**
+			 * \brief Discards all compiled torsion library data and cached match results.
+			 */
+			void clearCache();
+
 			/**
 			 * \brief Returns the number of stored torsion rule matches found by calls to findMatches().
 			 * \return The number of stored torsion rule matches.
@@ -107,19 +152,137 @@ namespace CDPL
 			bool findMatches(const Chem::Bond& bond, const Chem::MolecularGraph& molgraph, bool append = false);
 
 		  private:
-			bool findMatchingRules(const TorsionCategory& tor_cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
-			bool getRuleMatches(const TorsionRule& rule, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
-			bool matchesCategory(const TorsionCategory& tor_cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
+			struct AtomRequirements
+			{
+
+				AtomRequirements();
+
+				unsigned int type;
+				unsigned int hybState;
+				int          aromatic;
+				int          inRing;
+			};
+
+			struct CompiledRule
+			{
+
+				const TorsionRule* rule;
+				std::size_t        ctrBondIndex;
+				AtomRequirements   ctrAtomReqs[2];
+				int                ctrBondInRing;
+			};
+
+			struct CompiledCategory;
+
+			typedef boost::shared_ptr<CompiledCategory> CompiledCategoryPtr;
+			typedef std::vector<CompiledCategoryPtr> CompiledCategoryList;
+			typedef std::vector<CompiledRule> CompiledRuleList;
+			typedef std::vector<const CompiledRule*> CompiledRulePtrList;
+			typedef boost::unordered_map<boost::uint64_t, CompiledRulePtrList> CandidateRuleMap;
+
+			struct CompiledCategory
+			{
+
+				const TorsionCategory* category;
+				std::size_t            ctrBondIndex;
+				CompiledRuleList       rules;
+				CompiledCategoryList   categories;
+				CandidateRuleMap       candidateRules;
+			};
+
+			typedef std::vector<std::size_t> EnvironmentSignature;
+			typedef std::vector<std::size_t> IndexArray;
+			typedef std::vector<long> LabelValueArray;
+
+			struct BondEnvironment
+			{
+
+				void clear();
+
+				IndexArray      atomLabels;
+				IndexArray      labelValueOffsets;
+				LabelValueArray labelValues;
+				IndexArray      nbrOffsets;
+				IndexArray      nbrAtoms;
+				IndexArray      nbrBondLabels;
+			};
+
+			struct ResultCacheEntry
+			{
+
+				EnvironmentSignature signature;
+				BondEnvironment      environment;
+				const CompiledRule*  rule;
+			};
+
+			typedef boost::unordered_map<std::size_t, ResultCacheEntry> ResultCache;
+
+			struct CompiledLibrary
+			{
+
+				TorsionLibrary::SharedPointer library;
+				CompiledCategory              root;
+				bool                          cacheable;
+				std::size_t                   envRadius;
+				unsigned long                 atomConstraintMask;
+				ResultCache                   resultCache;
+			};
+
+			typedef boost::shared_ptr<CompiledLibrary> CompiledLibraryPtr;
+			typedef std::vector<CompiledLibraryPtr> CompiledLibraryList;
+
+			bool findMatchingRules(CompiledCategory& comp_cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph,
+								   boost::uint64_t bond_key, const CompiledRule*& first_rule);
+			bool getRuleMatches(const CompiledRule& comp_rule, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
+			bool matchesCategory(const CompiledCategory& comp_cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
 
 			void outputMatch(const Chem::AtomBondMapping& ab_mapping, const Chem::Bond& bond, const TorsionRule& rule);
 
 			std::size_t getCentralBondIndex(const Chem::MolecularGraph& ptn) const;
 
+			CompiledLibrary& getCompiledLibrary();
+
+			void compileCategory(const TorsionCategory& cat, CompiledCategory& comp_cat, CompiledLibrary& comp_lib);
+			void compileRule(const TorsionRule& rule, CompiledRule& comp_rule, CompiledLibrary& comp_lib);
+			void analyzePattern(const Chem::MolecularGraph& ptn, const Chem::Atom& start_atom1, const Chem::Atom& start_atom2, 
+								std::size_t base_dist, CompiledLibrary& comp_lib) const;
+			void analyzeConstraints(const Chem::MatchConstraintList& constr_list, bool atom_constrs, std::size_t atom_dist, 
+									CompiledLibrary& comp_lib) const;
+
+			void getAtomRequirements(const Chem::Atom& atom, const Chem::MatchConstraintList& constr_list, AtomRequirements& reqs) const;
+
+			bool atomMatchesRequirements(const AtomRequirements& reqs, boost::uint64_t atom_key) const;
+
+			const CompiledRulePtrList& getCandidateRules(CompiledCategory& comp_cat, boost::uint64_t bond_key) const;
+
+			bool findCachedMatches(CompiledLibrary& comp_lib, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph,
+								   boost::uint64_t bond_key);
+
+			std::size_t calcEnvironmentSignature(const CompiledLibrary& comp_lib, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph);
+			void getAtomLabelValues(const CompiledLibrary& comp_lib, const Chem::Atom& atom, const Chem::MolecularGraph& molgraph, 
+									LabelValueArray& values);
+
+			bool isCachedEnvironment(const BondEnvironment& cached_env);
+			bool mapEnvironmentAtoms(const BondEnvironment& cached_env, std::size_t pos);
+			bool environmentAtomsMatch(const BondEnvironment& cached_env, std::size_t pos, std::size_t cached_pos) const;
+
 			TorsionLibrary::SharedPointer torLib;
 			Chem::SubstructureSearch      subSearch;
 			bool                          uniqueMappingsOnly;
 			bool                          stopAtFirstRule;
 			RuleMatchList                 matches;
+			std::size_t                   maxResultCacheSize;
+			CompiledLibraryList           compiledLibs;
+			EnvironmentSignature          envSignature;
+			IndexArray                    envAtoms;
+			IndexArray                    envAtomDists;
+			IndexArray                    envAtomPositions;
+			BondEnvironment               bondEnv;
+			EnvironmentSignature          tmpEnvAtomLabels;
+			EnvironmentSignature          nbrLabels;
+			IndexArray                    envAtomMapping;
+			std::vector<bool>             mappedCachedEnvAtoms;
+			IndexArray                    ringSizes;
 		};
     
 		/**
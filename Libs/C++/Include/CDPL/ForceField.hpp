@@ -81,6 +81,7 @@
 #include "CDPL/ForceField/MMFF94VanDerWaalsInteractionParameterizer.hpp"
 #include "CDPL/ForceField/MMFF94ElectrostaticInteractionParameterizer.hpp"
 #include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
 
 #include "CDPL/ForceField/MMFF94SymbolicAtomTypePatternTable.hpp"
 #include "CDPL/ForceField/MMFF94HeavyToHydrogenAtomTypeMap.hpp"
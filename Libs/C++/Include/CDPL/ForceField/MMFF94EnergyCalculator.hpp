@@ -35,6 +35,7 @@
 #include "CDPL/ForceField/MMFF94EnergyFunctions.hpp"
 #include "CDPL/ForceField/UtilityFunctions.hpp"
 #include "CDPL/ForceField/InteractionType.hpp"
+#include "CDPL/Util/BitSet.hpp"
 
 
 namespace CDPL 
@@ -82,7 +83,39 @@ namespace CDPL
 
 			const ValueType& getVanDerWaalsEnergy() const;
 
+			/**
+			 * \brief Enables the incremental energy calculation mode for conformations that differ only in the positions 
+			 *        of the atoms flagged in \a mask.
+			 *
+			 * The energy contributions of the interactions that involve none of the flagged atoms are calculated by the
+			 * next call to operator() and then memorized. Subsequent calls only evaluate the interactions involving at 
+			 * least one flagged atom and add the memorized contributions. The positions of all other atoms must therefore
+			 * stay the same until the mask gets reset or specified anew (which also discards the memorized contributions).
+			 *
+			 * \param mask The bit mask flagging the atoms that change their position between calls to operator().
+			 *             An empty mask disables the incremental calculation mode.
+			 */
+			void setMovableAtomMask(const Util::BitSet& mask);
+
+			/**
+			 * \brief Returns the bit mask flagging the atoms that change their position between calls to operator().
+			 * \return The movable atom mask (empty if the incremental calculation mode is disabled).
+			 */
+			const Util::BitSet& getMovableAtomMask() const;
+
+			/**
+			 * \brief Disables the incremental energy calculation mode and discards the memorized contributions.
+			 */
+			void resetMovableAtomMask();
+
 		private:
+			template <typename CoordsArray>
+			void calcEnergies(const MMFF94InteractionData& ia_data, const CoordsArray& coords);
+
+			void addEnergies(const ValueType* energies);
+
+			void storeEnergies(ValueType* energies) const;
+
 			const MMFF94InteractionData* interactionData;
 			ValueType                    totalEnergy;
 			ValueType                    bondStretchingEnergy;
@@ -93,6 +126,11 @@ namespace CDPL
 			ValueType                    electrostaticEnergy;
 			ValueType                    vanDerWaalsEnergy;
 			unsigned int                 interactionTypes;
+			Util::BitSet                 movableAtomMask;
+			MMFF94InteractionData        movableAtomIaData;
+			MMFF94InteractionData        fixedAtomIaData;
+			ValueType                    fixedAtomEnergies[7];
+			bool                         fixedAtomEnergiesValid;
 		};
 
 		/**
@@ -109,20 +147,21 @@ template <typename ValueType>
 CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::MMFF94EnergyCalculator():
     interactionData(0), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(), 
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), fixedAtomEnergiesValid(false)
 {}
 
 template <typename ValueType>
 CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::MMFF94EnergyCalculator(const MMFF94InteractionData& ia_data):
     interactionData(&ia_data), totalEnergy(), bondStretchingEnergy(),
 	angleBendingEnergy(), stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(), 
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), fixedAtomEnergiesValid(false)
 {}
 
 template <typename ValueType>
 void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::setEnabledInteractionTypes(unsigned int types)
 {
 	interactionTypes = types;
+	fixedAtomEnergiesValid = false;
 }
 
 template <typename ValueType>
@@ -135,6 +174,7 @@ template <typename ValueType>
 void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::setup(const MMFF94InteractionData& ia_data)
 {
     interactionData = &ia_data;
+	fixedAtomEnergiesValid = false;
 }
 
 template <typename ValueType>
@@ -154,11 +194,107 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		return totalEnergy;
 	}
 
+	if (movableAtomMask.empty()) {
+		calcEnergies(*interactionData, coords);
+
+		return totalEnergy;
+	}
+
+	if (!fixedAtomEnergiesValid) {
+		movableAtomIaData.clear();
+		fixedAtomIaData.clear();
+
+		splitInteractions(*interactionData, movableAtomIaData, fixedAtomIaData, movableAtomMask);
+
+		calcEnergies(fixedAtomIaData, coords);
+		storeEnergies(fixedAtomEnergies);
+
+		fixedAtomEnergiesValid = true;
+	}
+
+	calcEnergies(movableAtomIaData, coords);
+	addEnergies(fixedAtomEnergies);
+
+    return totalEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getTotalEnergy() const
+{
+    return totalEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getBondStretchingEnergy() const
+{
+    return bondStretchingEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getAngleBendingEnergy() const
+{
+    return angleBendingEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getStretchBendEnergy() const
+{
+    return stretchBendEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getOutOfPlaneBendingEnergy() const
+{
+    return outOfPlaneEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getTorsionEnergy() const
+{
+    return torsionEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getElectrostaticEnergy() const
+{
+    return electrostaticEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getVanDerWaalsEnergy() const
+{
+    return vanDerWaalsEnergy;
+}
+
+template <typename ValueType>
+const CDPL::Util::BitSet& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getMovableAtomMask() const
+{
+	return movableAtomMask;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::setMovableAtomMask(const Util::BitSet& mask)
+{
+	movableAtomMask = mask;
+	fixedAtomEnergiesValid = false;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::resetMovableAtomMask()
+{
+	movableAtomMask.clear();
+	fixedAtomEnergiesValid = false;
+}
+
+template <typename ValueType>
+template <typename CoordsArray>
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::calcEnergies(const MMFF94InteractionData& ia_data, const CoordsArray& coords)
+{
 	totalEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::BOND_STRETCHING) {
-		bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
-																		 interactionData->getBondStretchingInteractions().getElementsEnd(), 
+		bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(ia_data.getBondStretchingInteractions().getElementsBegin(),
+																		 ia_data.getBondStretchingInteractions().getElementsEnd(), 
 																		 coords);
 		totalEnergy += bondStretchingEnergy;
 
@@ -167,8 +303,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 
 
 	if (interactionTypes & InteractionType::ANGLE_BENDING){
-		angleBendingEnergy = calcMMFF94AngleBendingEnergy<ValueType>(interactionData->getAngleBendingInteractions().getElementsBegin(),
-																	 interactionData->getAngleBendingInteractions().getElementsEnd(), 
+		angleBendingEnergy = calcMMFF94AngleBendingEnergy<ValueType>(ia_data.getAngleBendingInteractions().getElementsBegin(),
+																	 ia_data.getAngleBendingInteractions().getElementsEnd(), 
 																	 coords);
 		totalEnergy += angleBendingEnergy;
 
@@ -176,8 +312,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		angleBendingEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::STRETCH_BEND) {
-		stretchBendEnergy = calcMMFF94StretchBendEnergy<ValueType>(interactionData->getStretchBendInteractions().getElementsBegin(),
-																   interactionData->getStretchBendInteractions().getElementsEnd(), 
+		stretchBendEnergy = calcMMFF94StretchBendEnergy<ValueType>(ia_data.getStretchBendInteractions().getElementsBegin(),
+																   ia_data.getStretchBendInteractions().getElementsEnd(), 
 																   coords);
 		totalEnergy += stretchBendEnergy;
 
@@ -185,8 +321,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		stretchBendEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::OUT_OF_PLANE_BENDING) {
-		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingEnergy<ValueType>(interactionData->getOutOfPlaneBendingInteractions().getElementsBegin(),
-																		interactionData->getOutOfPlaneBendingInteractions().getElementsEnd(), 
+		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingEnergy<ValueType>(ia_data.getOutOfPlaneBendingInteractions().getElementsBegin(),
+																		ia_data.getOutOfPlaneBendingInteractions().getElementsEnd(), 
 																		coords);
 		totalEnergy += outOfPlaneEnergy;
 
@@ -194,8 +330,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		outOfPlaneEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::TORSION) {
-		torsionEnergy = calcMMFF94TorsionEnergy<ValueType>(interactionData->getTorsionInteractions().getElementsBegin(),
-														   interactionData->getTorsionInteractions().getElementsEnd(), 
+		torsionEnergy = calcMMFF94TorsionEnergy<ValueType>(ia_data.getTorsionInteractions().getElementsBegin(),
+														   ia_data.getTorsionInteractions().getElementsEnd(), 
 														   coords);
 		totalEnergy += torsionEnergy;
 
@@ -203,8 +339,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		torsionEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::ELECTROSTATIC) {
-		electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-																	   interactionData->getElectrostaticInteractions().getElementsEnd(), 
+		electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(ia_data.getElectrostaticInteractions().getElementsBegin(),
+																	   ia_data.getElectrostaticInteractions().getElementsEnd(), 
 																	   coords);
 		totalEnergy += electrostaticEnergy;
 
@@ -212,63 +348,40 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 		electrostaticEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-		vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-																   interactionData->getVanDerWaalsInteractions().getElementsEnd(), 
+		vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(ia_data.getVanDerWaalsInteractions().getElementsBegin(),
+																   ia_data.getVanDerWaalsInteractions().getElementsEnd(), 
 																   coords);
 		totalEnergy += vanDerWaalsEnergy;
 
 	} else 
 		vanDerWaalsEnergy = ValueType();
-
-    return totalEnergy;
 }
 
 template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getTotalEnergy() const
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::addEnergies(const ValueType* energies)
 {
-    return totalEnergy;
+	bondStretchingEnergy += energies[0];
+	angleBendingEnergy += energies[1];
+	stretchBendEnergy += energies[2];
+	outOfPlaneEnergy += energies[3];
+	torsionEnergy += energies[4];
+	electrostaticEnergy += energies[5];
+	vanDerWaalsEnergy += energies[6];
+
+	totalEnergy = bondStretchingEnergy + angleBendingEnergy + stretchBendEnergy + outOfPlaneEnergy + 
+		torsionEnergy + electrostaticEnergy + vanDerWaalsEnergy;
 }
 
 template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getBondStretchingEnergy() const
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::storeEnergies(ValueType* energies) const
 {
-    return bondStretchingEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getAngleBendingEnergy() const
-{
-    return angleBendingEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getStretchBendEnergy() const
-{
-    return stretchBendEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getOutOfPlaneBendingEnergy() const
-{
-    return outOfPlaneEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getTorsionEnergy() const
-{
-    return torsionEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getElectrostaticEnergy() const
-{
-    return electrostaticEnergy;
-}
-
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getVanDerWaalsEnergy() const
-{
-    return vanDerWaalsEnergy;
+	energies[0] = bondStretchingEnergy;
+	energies[1] = angleBendingEnergy;
+	energies[2] = stretchBendEnergy;
+	energies[3] = outOfPlaneEnergy;
+	energies[4] = torsionEnergy;
+	energies[5] = electrostaticEnergy;
+	energies[6] = vanDerWaalsEnergy;
 }
 
 // \endcond
@@ -32,12 +32,16 @@
 #define CDPL_FORCEFIELD_MMFF94GRADIENTCALCULATOR_HPP
 
 #include <cstddef>
+#include <algorithm>
 
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
 #include "CDPL/ForceField/MMFF94EnergyFunctions.hpp"
 #include "CDPL/ForceField/MMFF94GradientFunctions.hpp"
 #include "CDPL/ForceField/InteractionType.hpp"
 #include "CDPL/ForceField/GradientVectorTraits.hpp"
+#include "CDPL/ForceField/UtilityFunctions.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Util/BitSet.hpp"
 
 
@@ -95,7 +99,49 @@ namespace CDPL
 
 			void resetFixedAtomMask();
 
+			/**
+			 * \brief Enables the incremental energy and gradient calculation mode for conformations that differ only in 
+			 *        the positions of the atoms flagged in \a mask.
+			 *
+			 * The energy and gradient contributions of the interactions that involve none of the flagged atoms are calculated
+			 * by the next call to one of the operator() overloads and then memorized. Subsequent calls only evaluate the 
+			 * interactions involving at least one flagged atom and add the memorized contributions. The positions of all other 
+			 * atoms must therefore stay the same until the mask gets reset or specified anew (which also discards the memorized 
+			 * contributions). In energy minimizations where only a subset of the atoms is allowed to move, the mask typically
+			 * is the complement of the fixed atom mask.
+			 *
+			 * \param mask The bit mask flagging the atoms that change their position between calls to operator().
+			 *             An empty mask disables the incremental calculation mode.
+			 */
+			void setMovableAtomMask(const Util::BitSet& mask);
+
+			/**
+			 * \brief Returns the bit mask flagging the atoms that change their position between calls to operator().
+			 * \return The movable atom mask (empty if the incremental calculation mode is disabled).
+			 */
+			const Util::BitSet& getMovableAtomMask() const;
+
+			/**
+			 * \brief Disables the incremental energy and gradient calculation mode and discards the memorized contributions.
+			 */
+			void resetMovableAtomMask();
+
 		private:
+			typedef Math::VectorArray<Math::CVector<ValueType, 3> > GradientArray;
+
+			template <typename CoordsArray>
+			void calcEnergies(const MMFF94InteractionData& ia_data, const CoordsArray& coords);
+
+			template <typename CoordsArray, typename GradVector>
+			void calcGradient(const MMFF94InteractionData& ia_data, const CoordsArray& coords, GradVector& grad);
+
+			template <typename CoordsArray>
+			void calcFixedAtomContributions(const CoordsArray& coords);
+
+			void addEnergies(const ValueType* energies);
+
+			void storeEnergies(ValueType* energies) const;
+
 			const MMFF94InteractionData* interactionData;
 			std::size_t                  numAtoms;
 			ValueType                    totalEnergy;
@@ -108,6 +154,12 @@ namespace CDPL
 			ValueType                    vanDerWaalsEnergy;
 			unsigned int                 interactionTypes;
 			Util::BitSet                 fixedAtomMask;
+			Util::BitSet                 movableAtomMask;
+			MMFF94InteractionData        movableAtomIaData;
+			MMFF94InteractionData        fixedAtomIaData;
+			ValueType                    fixedAtomEnergies[7];
+			GradientArray                fixedAtomGradient;
+			bool                         fixedAtomTermsValid;
 		};
 
 		/**
@@ -124,20 +176,21 @@ template <typename ValueType>
 CDPL::ForceField::MMFF94GradientCalculator<ValueType>::MMFF94GradientCalculator():
     interactionData(0), numAtoms(0), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(), 
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), fixedAtomTermsValid(false)
 {}
 
 template <typename ValueType>
 CDPL::ForceField::MMFF94GradientCalculator<ValueType>::MMFF94GradientCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms):
     interactionData(&ia_data), numAtoms(num_atoms), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(), 
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), fixedAtomTermsValid(false)
 {}
 
 template <typename ValueType>
 void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setEnabledInteractionTypes(unsigned int types)
 {
 	interactionTypes = types;
+	fixedAtomTermsValid = false;
 }
 
 template <typename ValueType>
@@ -151,6 +204,7 @@ void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setup(const MMFF94In
 {
     interactionData = &ia_data;
 	numAtoms = num_atoms;
+	fixedAtomTermsValid = false;
 }
 
 template <typename ValueType>
@@ -170,11 +224,164 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		return totalEnergy;
 	}
 
+	if (movableAtomMask.empty()) {
+		calcEnergies(*interactionData, coords);
+
+		return totalEnergy;
+	}
+
+	if (!fixedAtomTermsValid)
+		calcFixedAtomContributions(coords);
+
+	calcEnergies(movableAtomIaData, coords);
+	addEnergies(fixedAtomEnergies);
+
+    return totalEnergy;
+}
+
+template <typename ValueType>
+template <typename CoordsArray, typename GradVector>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator()(const CoordsArray& coords, GradVector& grad)
+{
+	GradientVectorTraits<GradVector>::clear(grad, numAtoms);
+
+	if (!interactionData) {
+		totalEnergy = ValueType();
+		bondStretchingEnergy = ValueType();
+		angleBendingEnergy = ValueType();
+		stretchBendEnergy = ValueType();
+		outOfPlaneEnergy = ValueType();
+		torsionEnergy = ValueType();
+		electrostaticEnergy = ValueType();
+		vanDerWaalsEnergy = ValueType();
+
+		return totalEnergy;
+	}
+
+	if (movableAtomMask.empty())
+		calcGradient(*interactionData, coords, grad);
+
+	else {
+		if (!fixedAtomTermsValid)
+			calcFixedAtomContributions(coords);
+
+		calcGradient(movableAtomIaData, coords, grad);
+		addEnergies(fixedAtomEnergies);
+
+		for (std::size_t i = 0, num_grad_elem = std::min(numAtoms, fixedAtomGradient.getSize()); i < num_grad_elem; i++) {
+			if (movableAtomMask.test(i))
+				continue;
+
+			const typename GradientArray::ElementType& atom_grad = fixedAtomGradient[i];
+
+			grad[i][0] += atom_grad[0];
+			grad[i][1] += atom_grad[1];
+			grad[i][2] += atom_grad[2];
+		}
+	}
+
+	if (!fixedAtomMask.empty()) 
+		for (Util::BitSet::size_type i = fixedAtomMask.find_first(); i != Util::BitSet::npos; i = fixedAtomMask.find_next(i))
+			grad[i].clear(ValueType());
+	
+    return totalEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getTotalEnergy() const
+{
+    return totalEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getBondStretchingEnergy() const
+{
+    return bondStretchingEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getAngleBendingEnergy() const
+{
+    return angleBendingEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getStretchBendEnergy() const
+{
+    return stretchBendEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getOutOfPlaneBendingEnergy() const
+{
+    return outOfPlaneEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getTorsionEnergy() const
+{
+    return torsionEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getElectrostaticEnergy() const
+{
+    return electrostaticEnergy;
+}
+
+template <typename ValueType>
+const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getVanDerWaalsEnergy() const
+{
+    return vanDerWaalsEnergy;
+}
+
+template <typename ValueType>
+const CDPL::Util::BitSet& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getFixedAtomMask() const
+{
+	return fixedAtomMask;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setFixedAtomMask(const Util::BitSet& mask)
+{
+	fixedAtomMask = mask;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::resetFixedAtomMask()
+{
+	fixedAtomMask.clear();
+}
+
+template <typename ValueType>
+const CDPL::Util::BitSet& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getMovableAtomMask() const
+{
+	return movableAtomMask;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setMovableAtomMask(const Util::BitSet& mask)
+{
+	movableAtomMask = mask;
+	fixedAtomTermsValid = false;
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::resetMovableAtomMask()
+{
+	movableAtomMask.clear();
+	fixedAtomTermsValid = false;
+}
+
+template <typename ValueType>
+template <typename CoordsArray>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcEnergies(const MMFF94InteractionData& ia_data, const CoordsArray& coords)
+{
 	totalEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::BOND_STRETCHING) {
-		bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
-																		 interactionData->getBondStretchingInteractions().getElementsEnd(), 
+		bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(ia_data.getBondStretchingInteractions().getElementsBegin(),
+																		 ia_data.getBondStretchingInteractions().getElementsEnd(), 
 																		 coords);
 		totalEnergy += bondStretchingEnergy;
 
@@ -183,8 +390,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 
 
 	if (interactionTypes & InteractionType::ANGLE_BENDING){
-		angleBendingEnergy = calcMMFF94AngleBendingEnergy<ValueType>(interactionData->getAngleBendingInteractions().getElementsBegin(),
-																	 interactionData->getAngleBendingInteractions().getElementsEnd(), 
+		angleBendingEnergy = calcMMFF94AngleBendingEnergy<ValueType>(ia_data.getAngleBendingInteractions().getElementsBegin(),
+																	 ia_data.getAngleBendingInteractions().getElementsEnd(), 
 																	 coords);
 		totalEnergy += angleBendingEnergy;
 
@@ -192,8 +399,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		angleBendingEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::STRETCH_BEND) {
-		stretchBendEnergy = calcMMFF94StretchBendEnergy<ValueType>(interactionData->getStretchBendInteractions().getElementsBegin(),
-																   interactionData->getStretchBendInteractions().getElementsEnd(), 
+		stretchBendEnergy = calcMMFF94StretchBendEnergy<ValueType>(ia_data.getStretchBendInteractions().getElementsBegin(),
+																   ia_data.getStretchBendInteractions().getElementsEnd(), 
 																   coords);
 		totalEnergy += stretchBendEnergy;
 
@@ -201,8 +408,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		stretchBendEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::OUT_OF_PLANE_BENDING) {
-		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingEnergy<ValueType>(interactionData->getOutOfPlaneBendingInteractions().getElementsBegin(),
-																		interactionData->getOutOfPlaneBendingInteractions().getElementsEnd(), 
+		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingEnergy<ValueType>(ia_data.getOutOfPlaneBendingInteractions().getElementsBegin(),
+																		ia_data.getOutOfPlaneBendingInteractions().getElementsEnd(), 
 																		coords);
 		totalEnergy += outOfPlaneEnergy;
 
@@ -210,8 +417,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		outOfPlaneEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::TORSION) {
-		torsionEnergy = calcMMFF94TorsionEnergy<ValueType>(interactionData->getTorsionInteractions().getElementsBegin(),
-														   interactionData->getTorsionInteractions().getElementsEnd(), 
+		torsionEnergy = calcMMFF94TorsionEnergy<ValueType>(ia_data.getTorsionInteractions().getElementsBegin(),
+														   ia_data.getTorsionInteractions().getElementsEnd(), 
 														   coords);
 		totalEnergy += torsionEnergy;
 
@@ -219,8 +426,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		torsionEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::ELECTROSTATIC) {
-		electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-																	   interactionData->getElectrostaticInteractions().getElementsEnd(), 
+		electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(ia_data.getElectrostaticInteractions().getElementsBegin(),
+																	   ia_data.getElectrostaticInteractions().getElementsEnd(), 
 																	   coords);
 		totalEnergy += electrostaticEnergy;
 
@@ -228,41 +435,24 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		electrostaticEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-		vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-																   interactionData->getVanDerWaalsInteractions().getElementsEnd(), 
+		vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(ia_data.getVanDerWaalsInteractions().getElementsBegin(),
+																   ia_data.getVanDerWaalsInteractions().getElementsEnd(), 
 																   coords);
 		totalEnergy += vanDerWaalsEnergy;
 
 	} else 
 		vanDerWaalsEnergy = ValueType();
-
-    return totalEnergy;
 }
 
 template <typename ValueType>
 template <typename CoordsArray, typename GradVector>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator()(const CoordsArray& coords, GradVector& grad)
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcGradient(const MMFF94InteractionData& ia_data, const CoordsArray& coords, GradVector& grad)
 {
-	GradientVectorTraits<GradVector>::clear(grad, numAtoms);
-
-	if (!interactionData) {
-		totalEnergy = ValueType();
-		bondStretchingEnergy = ValueType();
-		angleBendingEnergy = ValueType();
-		stretchBendEnergy = ValueType();
-		outOfPlaneEnergy = ValueType();
-		torsionEnergy = ValueType();
-		electrostaticEnergy = ValueType();
-		vanDerWaalsEnergy = ValueType();
-
-		return totalEnergy;
-	}
-
 	totalEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::BOND_STRETCHING) {
-		bondStretchingEnergy = calcMMFF94BondStretchingGradient<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
-																		   interactionData->getBondStretchingInteractions().getElementsEnd(), 
+		bondStretchingEnergy = calcMMFF94BondStretchingGradient<ValueType>(ia_data.getBondStretchingInteractions().getElementsBegin(),
+																		   ia_data.getBondStretchingInteractions().getElementsEnd(), 
 																		   coords, grad);
 		totalEnergy += bondStretchingEnergy;
 
@@ -270,8 +460,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		bondStretchingEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::ANGLE_BENDING){
-		angleBendingEnergy = calcMMFF94AngleBendingGradient<ValueType>(interactionData->getAngleBendingInteractions().getElementsBegin(),
-																	   interactionData->getAngleBendingInteractions().getElementsEnd(), 
+		angleBendingEnergy = calcMMFF94AngleBendingGradient<ValueType>(ia_data.getAngleBendingInteractions().getElementsBegin(),
+																	   ia_data.getAngleBendingInteractions().getElementsEnd(), 
 																	   coords, grad);
  		totalEnergy += angleBendingEnergy;
 
@@ -279,8 +469,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		angleBendingEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::STRETCH_BEND) {
-		stretchBendEnergy = calcMMFF94StretchBendGradient<ValueType>(interactionData->getStretchBendInteractions().getElementsBegin(),
-																	 interactionData->getStretchBendInteractions().getElementsEnd(), 
+		stretchBendEnergy = calcMMFF94StretchBendGradient<ValueType>(ia_data.getStretchBendInteractions().getElementsBegin(),
+																	 ia_data.getStretchBendInteractions().getElementsEnd(), 
 																	 coords, grad);
 		totalEnergy += stretchBendEnergy;
 
@@ -288,8 +478,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		stretchBendEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::OUT_OF_PLANE_BENDING) {
-		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingGradient<ValueType>(interactionData->getOutOfPlaneBendingInteractions().getElementsBegin(),
-																		  interactionData->getOutOfPlaneBendingInteractions().getElementsEnd(), 
+		outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingGradient<ValueType>(ia_data.getOutOfPlaneBendingInteractions().getElementsBegin(),
+																		  ia_data.getOutOfPlaneBendingInteractions().getElementsEnd(), 
 																		  coords, grad);
 		totalEnergy += outOfPlaneEnergy;
 
@@ -297,8 +487,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		outOfPlaneEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::TORSION) {
-		torsionEnergy = calcMMFF94TorsionGradient<ValueType>(interactionData->getTorsionInteractions().getElementsBegin(),
-															 interactionData->getTorsionInteractions().getElementsEnd(), 
+		torsionEnergy = calcMMFF94TorsionGradient<ValueType>(ia_data.getTorsionInteractions().getElementsBegin(),
+															 ia_data.getTorsionInteractions().getElementsEnd(), 
 															 coords, grad);
 		totalEnergy += torsionEnergy;
 
@@ -306,8 +496,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		torsionEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::ELECTROSTATIC) {
-		electrostaticEnergy = calcMMFF94ElectrostaticGradient<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-																		 interactionData->getElectrostaticInteractions().getElementsEnd(), 
+		electrostaticEnergy = calcMMFF94ElectrostaticGradient<ValueType>(ia_data.getElectrostaticInteractions().getElementsBegin(),
+																		 ia_data.getElectrostaticInteractions().getElementsEnd(), 
 																		 coords, grad);
 		totalEnergy += electrostaticEnergy;
 
@@ -315,85 +505,59 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 		electrostaticEnergy = ValueType();
 
 	if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-		vanDerWaalsEnergy = calcMMFF94VanDerWaalsGradient<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-																	 interactionData->getVanDerWaalsInteractions().getElementsEnd(), 
+		vanDerWaalsEnergy = calcMMFF94VanDerWaalsGradient<ValueType>(ia_data.getVanDerWaalsInteractions().getElementsBegin(),
+																	 ia_data.getVanDerWaalsInteractions().getElementsEnd(), 
 																	 coords, grad);
    		totalEnergy += vanDerWaalsEnergy;
 
 	} else 
 		vanDerWaalsEnergy = ValueType();
-
-	if (!fixedAtomMask.empty()) 
-		for (Util::BitSet::size_type i = fixedAtomMask.find_first(); i != Util::BitSet::npos; i = fixedAtomMask.find_next(i))
-			grad[i].clear(ValueType());
-	
-    return totalEnergy;
 }
 
 template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getTotalEnergy() const
+template <typename CoordsArray>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcFixedAtomContributions(const CoordsArray& coords)
 {
-    return totalEnergy;
-}
+	movableAtomIaData.clear();
+	fixedAtomIaData.clear();
 
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getBondStretchingEnergy() const
-{
-    return bondStretchingEnergy;
-}
+	splitInteractions(*interactionData, movableAtomIaData, fixedAtomIaData, movableAtomMask);
 
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getAngleBendingEnergy() const
-{
-    return angleBendingEnergy;
-}
+	fixedAtomGradient.resize(numAtoms);
 
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getStretchBendEnergy() const
-{
-    return stretchBendEnergy;
-}
+	GradientVectorTraits<GradientArray>::clear(fixedAtomGradient, numAtoms);
 
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getOutOfPlaneBendingEnergy() const
-{
-    return outOfPlaneEnergy;
-}
+	calcGradient(fixedAtomIaData, coords, fixedAtomGradient);
+	storeEnergies(fixedAtomEnergies);
 
-template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getTorsionEnergy() const
-{
-    return torsionEnergy;
+	fixedAtomTermsValid = true;
 }
 
 template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getElectrostaticEnergy() const
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::addEnergies(const ValueType* energies)
 {
-    return electrostaticEnergy;
+	bondStretchingEnergy += energies[0];
+	angleBendingEnergy += energies[1];
+	stretchBendEnergy += energies[2];
+	outOfPlaneEnergy += energies[3];
+	torsionEnergy += energies[4];
+	electrostaticEnergy += energies[5];
+	vanDerWaalsEnergy += energies[6];
+
+	totalEnergy = bondStretchingEnergy + angleBendingEnergy + stretchBendEnergy + outOfPlaneEnergy + 
+		torsionEnergy + electrostaticEnergy + vanDerWaalsEnergy;
 }
 
 template <typename ValueType>
-const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getVanDerWaalsEnergy() const
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::storeEnergies(ValueType* energies) const
 {
-    return vanDerWaalsEnergy;
-}
-
-template <typename ValueType>
-const CDPL::Util::BitSet& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::getFixedAtomMask() const
-{
-	return fixedAtomMask;
-}
-
-template <typename ValueType>
-void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setFixedAtomMask(const Util::BitSet& mask)
-{
-	fixedAtomMask = mask;
-}
-
-template <typename ValueType>
-void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::resetFixedAtomMask()
-{
-	fixedAtomMask.clear();
+	energies[0] = bondStretchingEnergy;
+	energies[1] = angleBendingEnergy;
+	energies[2] = stretchBendEnergy;
+	energies[3] = outOfPlaneEnergy;
+	energies[4] = torsionEnergy;
+	energies[5] = electrostaticEnergy;
+	energies[6] = vanDerWaalsEnergy;
 }
 
 // \endcond
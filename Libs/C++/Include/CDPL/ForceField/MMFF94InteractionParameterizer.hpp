@@ -68,6 +68,8 @@
 #include "CDPL/ForceField/MMFF94AtomTyper.hpp"
 #include "CDPL/ForceField/MMFF94BondTyper.hpp"
 #include "CDPL/ForceField/MMFF94ChargeCalculator.hpp"
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
+#include "CDPL/Chem/CanonicalNumberingGenerator.hpp"
 #include "CDPL/Util/Array.hpp"
 #include "CDPL/Math/Matrix.hpp"
 
@@ -158,6 +160,19 @@ namespace CDPL
 
 			void setParameterSet(unsigned int param_set);
 
+			/**
+			 * \brief Specifies a cache for the perceived atom types, bond type indices and atom charges.
+			 *
+			 * If a cache has been specified, the perception results for a given molecular graph are looked up in the cache
+			 * and are stored there if not yet present. Results that are provided by the molecular graph itself in the form of
+			 * atom and bond properties are neither looked up nor stored.
+			 *
+			 * \param cache The cache to use, or a \e null pointer to disable caching (default).
+			 */
+			void setCache(const MMFF94ParameterizationCache::SharedPointer& cache);
+
+			const MMFF94ParameterizationCache::SharedPointer& getCache() const;
+
 			MMFF94InteractionParameterizer& operator=(const MMFF94InteractionParameterizer& parameterizer);
 
 			void parameterize(const Chem::MolecularGraph& molgraph, MMFF94InteractionData& ia_data,
@@ -181,6 +196,9 @@ namespace CDPL
 
 			void setup(const Chem::MolecularGraph& molgraph, unsigned int ia_types, bool strict);
 
+			void lookupCacheEntry(bool strict);
+			void updateCache(bool strict);
+
 			void setupAromaticRingSet();
 			void setupAtomTypes(bool strict);
 			void setupBondTypeIndices(bool strict);
@@ -206,6 +224,17 @@ namespace CDPL
 			Util::UIArray                                   bondTypeIndices;   
 			Util::DArray                                    atomCharges;
 			const Chem::MolecularGraph*                     molGraph;
+			MMFF94ParameterizationCache::SharedPointer      cache;
+			MMFF94ParameterizationCache::EntryPointer       cacheEntry;
+			MMFF94ParameterizationCache::Signature          cacheSignature;
+			Chem::CanonicalNumberingGenerator               canonNumGenerator;
+			Util::STArray                                   canonNumbering;
+			Util::STArray                                   cacheAtomOrder;
+			Util::STArray                                   cacheBondOrder;
+			Base::uint64                                    cacheHashCode;
+			bool                                            perceivedTypes;
+			bool                                            perceivedCharges;
+			bool                                            usedPropertyData;
 		};			
     
 		/**
@@ -0,0 +1,164 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * MMFF94ParameterizationCache.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ForceField::MMFF94ParameterizationCache.
+ */
+
+#ifndef CDPL_FORCEFIELD_MMFF94PARAMETERIZATIONCACHE_HPP
+#define CDPL_FORCEFIELD_MMFF94PARAMETERIZATIONCACHE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <list>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "CDPL/ForceField/APIPrefix.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+#include "CDPL/Util/Array.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class MolecularGraph;
+		class CanonicalNumberingGenerator;
+	}
+
+    namespace ForceField 
+    {
+
+		class MMFF94InteractionParameterizer;
+
+		/**
+		 * \addtogroup CDPL_FORCEFIELD_INTERACTION_PARAMETERIZATION
+		 * @{
+		 */
+
+		/**
+		 * \brief A thread-safe cache for the atom types, bond type indices and partial atom charges perceived by
+		 *        MMFF94InteractionParameterizer.
+		 *
+		 * Entries are keyed by a signature of the molecular graph that comprises the element, formal charge, implicit
+		 * hydrogen count, ring and aromaticity flags of the atoms and the connectivity, order and aromaticity flags of the
+		 * bonds. Atoms and bonds enter the signature in a canonical order (see Chem::CanonicalNumberingGenerator) and the
+		 * cached data are stored in this order, too. Molecular graphs that represent the same structure thus share an entry
+		 * regardless of the order of their atoms and bonds. The cache is bounded and discards the least recently used entries
+		 * when the maximum size is exceeded.
+		 *
+		 * A cache instance may be shared by any number of parameterizers running in different threads as long as all
+		 * of them use the same atom typing and charge parameter tables.
+		 */
+		class CDPL_FORCEFIELD_API MMFF94ParameterizationCache
+		{
+
+		  public:
+			static const std::size_t DEFAULT_MAX_SIZE = 10000;
+
+			typedef boost::shared_ptr<MMFF94ParameterizationCache> SharedPointer;
+
+			MMFF94ParameterizationCache(std::size_t max_size = DEFAULT_MAX_SIZE);
+
+			void setMaxSize(std::size_t max_size);
+
+			std::size_t getMaxSize() const;
+
+			std::size_t getSize() const;
+
+			std::size_t getNumHits() const;
+
+			std::size_t getNumMisses() const;
+
+			void clear();
+
+			/**
+			 * \brief Returns a process-wide cache instance.
+			 * \return A reference to the shared pointer to the process-wide cache instance.
+			 */
+			static const SharedPointer& get();
+
+		  private:
+			friend class MMFF94InteractionParameterizer;
+
+			struct Entry
+			{
+
+				Util::SArray  symAtomTypes;
+				Util::UIArray numAtomTypes;
+				Util::UIArray bondTypeIndices;
+				Util::DArray  atomCharges;
+				bool          hasCharges;
+			};
+
+			typedef boost::shared_ptr<const Entry> EntryPointer;
+			typedef std::vector<Base::uint64> Signature;
+
+			struct Record
+			{
+
+				Base::uint64 hashCode;
+				Signature    signature;
+				bool         strict;
+				EntryPointer entry;
+			};
+
+			typedef std::list<Record> RecordList;
+			typedef boost::unordered_map<Base::uint64, RecordList::iterator> HashToRecordMap;
+
+			MMFF94ParameterizationCache(const MMFF94ParameterizationCache& cache);
+
+			MMFF94ParameterizationCache& operator=(const MMFF94ParameterizationCache& cache);
+
+			EntryPointer getEntry(Base::uint64 hash_code, const Signature& sig, bool strict);
+
+			void addEntry(Base::uint64 hash_code, const Signature& sig, bool strict, const EntryPointer& entry);
+
+			void shrink();
+
+			static Base::uint64 calcSignature(const Chem::MolecularGraph& molgraph, bool strict, Chem::CanonicalNumberingGenerator& canon_num_gen,
+											  Util::STArray& canon_numbering, Util::STArray& atom_order, Util::STArray& bond_order, Signature& sig);
+
+			mutable boost::mutex mutex;
+			RecordList           records;
+			HashToRecordMap      hashToRecordMap;
+			std::size_t          maxSize;
+			std::size_t          numHits;
+			std::size_t          numMisses;
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_FORCEFIELD_MMFF94PARAMETERIZATIONCACHE_HPP
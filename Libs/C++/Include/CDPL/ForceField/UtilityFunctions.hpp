@@ -52,6 +52,17 @@ namespace CDPL
 
 		CDPL_FORCEFIELD_API void filterInteractions(const MMFF94InteractionData& ia_data, MMFF94InteractionData& filtered_ia_data, const Util::BitSet& inc_atom_mask);
 
+		/**
+		 * \brief Distributes the interactions in \a ia_data over two interaction sets depending on whether they involve
+		 *        any of the atoms flagged in \a atom_mask or not.
+		 * \param ia_data The interactions to split.
+		 * \param dep_ia_data Receives the interactions involving at least one of the flagged atoms.
+		 * \param indep_ia_data Receives the interactions involving none of the flagged atoms.
+		 * \param atom_mask The bit mask flagging the atoms of interest.
+		 */
+		CDPL_FORCEFIELD_API void splitInteractions(const MMFF94InteractionData& ia_data, MMFF94InteractionData& dep_ia_data, 
+												   MMFF94InteractionData& indep_ia_data, const Util::BitSet& atom_mask);
+
 		/**
 		 *\brief Calculates the squared distance \f$ r_{ij}^2 \f$ between two atoms \e i and \e j.
 		 *
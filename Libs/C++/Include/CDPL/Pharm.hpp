@@ -113,13 +113,17 @@
 
 #include "CDPL/Pharm/ScreeningDBCreator.hpp"
 #include "CDPL/Pharm/ScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
 #include "CDPL/Pharm/PharmacophoreFitScreeningScore.hpp"
+#include "CDPL/Pharm/PharmacophoreFingerprintStore.hpp"
 
 #include "CDPL/Pharm/FeatureRDFCodeCalculator.hpp"
 #include "CDPL/Pharm/FeatureAutoCorrelation3DVectorCalculator.hpp"
 #include "CDPL/Pharm/PharmacophoreRDFDescriptorCalculator.hpp"
 #include "CDPL/Pharm/PharmacophoreAutoCorr3DDescriptorCalculator.hpp"
+#include "CDPL/Pharm/PharmacophoreFingerprintGenerator.hpp"
 
 #include "CDPL/Pharm/MoleculeFunctions.hpp"  
 #include "CDPL/Pharm/PharmacophoreFunctions.hpp"  
@@ -166,5 +170,11 @@
 #include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
 
+# if defined(HAVE_BOOST_FILESYSTEM)
+
+#include "CDPL/Pharm/ShardedScreeningDBAccessor.hpp"
+
+# endif // defined(HAVE_BOOST_FILESYSTEM)
+
 #endif // HAVE_SQLITE3
 #endif // CDPL_PHARM_HPP
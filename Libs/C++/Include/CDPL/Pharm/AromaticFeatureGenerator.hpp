@@ -31,6 +31,8 @@
 #ifndef CDPL_PHARM_AROMATICFEATUREGENERATOR_HPP
 #define CDPL_PHARM_AROMATICFEATUREGENERATOR_HPP
 
+#include <vector>
+
 #include "CDPL/Pharm/APIPrefix.hpp"
 #include "CDPL/Pharm/PatternBasedFeatureGenerator.hpp"
 #include "CDPL/Pharm/FeatureType.hpp"
@@ -141,9 +143,13 @@ namespace CDPL
 			FeatureGenerator::SharedPointer clone() const;
 
 		  private:
+			typedef std::vector<Chem::Fragment::SharedPointer> RingList;
+
+			void prepareNonPatternFeatures(const Chem::MolecularGraph&);
 			void addNonPatternFeatures(const Chem::MolecularGraph&, Pharmacophore&);
 
 			Chem::AromaticSSSRSubset aromSSSRSubset;
+			RingList                 featureRings;
 			Util::BitSet             ringAtomMask;
 			unsigned int             featureType;
 			unsigned int             featureGeom;
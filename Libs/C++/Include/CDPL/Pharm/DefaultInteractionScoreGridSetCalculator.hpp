@@ -69,6 +69,7 @@ namespace CDPL
 			template <typename T>
 			void setCoordinatesTransform(const T& xform) {
 				coordsTransform = xform;
+				clearIncrementalState();
 			}
 
 			double getXStepSize() const;
@@ -100,6 +101,8 @@ namespace CDPL
 		  private:
 			Grid::DSpatialGrid::SharedPointer createGrid(unsigned int ftr_type, unsigned int tgt_ftr_type) const;
 
+			bool isGridValid(const Grid::DSpatialGrid& grid) const;
+
 			void init();
 
 			double                 xStepSize;          
@@ -95,6 +95,29 @@ namespace CDPL
 			 */
 			virtual void generate(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm) = 0;
 
+			/**
+			 * \brief Perceives the coordinate independent data (feature atoms, types and geometry rules) of the features
+			 *        of \a molgraph for subsequent calls to instantiate().
+			 *
+			 * The default implementation just remembers \a molgraph and lets instantiate() call generate().
+			 *
+			 * \param molgraph The molecular graph for which to perceive the features. The molecular graph has to stay
+			 *                 valid and must not be modified until the last call to instantiate().
+			 */
+			virtual void prepare(const Chem::MolecularGraph& molgraph);
+
+			/**
+			 * \brief Adds the features of the molecular graph specified by the last call to prepare() to the pharmacophore \a pharm.
+			 *
+			 * Feature positions and orientations get calculated from the atom coordinates delivered by the current atom 
+			 * 3D-coordinates function. Thus, the features of multiple conformations of a molecule can be generated
+			 * by a single call to prepare() followed by one call to instantiate() per conformation.
+			 *
+			 * \param pharm The output pharmacophore where to add the generated features.
+			 * \throw Base::OperationFailed if prepare() has not been called before.
+			 */
+			virtual void instantiate(Pharmacophore& pharm);
+
 			virtual SharedPointer clone() const = 0;
 
 		  protected:
@@ -108,6 +131,7 @@ namespace CDPL
 
 		  private:
 			Chem::Atom3DCoordinatesFunction coordsFunc;
+			const Chem::MolecularGraph*     preparedMolGraph;
 		};
 
 		/**
@@ -156,6 +156,8 @@ namespace CDPL
 			 */
 			HydrophobicAtomFeatureGenerator& operator=(const HydrophobicAtomFeatureGenerator& gen);
 
+			void prepareNonPatternFeatures(const Chem::MolecularGraph& molgraph);
+
 			void addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm);
 
 			FeatureGenerator::SharedPointer clone() const;
@@ -195,6 +195,7 @@ namespace CDPL
 			FeatureGenerator::SharedPointer clone() const;
 
 		  private:
+			void prepareNonPatternFeatures(const Chem::MolecularGraph&);
 			void addNonPatternFeatures(const Chem::MolecularGraph&, Pharmacophore&);
 
 			void init(const Chem::MolecularGraph&);
@@ -33,8 +33,12 @@
 
 #include <utility>
 #include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
 
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "CDPL/Pharm/APIPrefix.hpp"
 #include "CDPL/Pharm/FeatureMapping.hpp"
@@ -66,6 +70,9 @@ namespace CDPL
 			 */
 			typedef boost::function2<bool, const Feature&, const Feature&> ConstraintFunction;
 
+			typedef std::vector<const FeatureContainer*> FeatureContainerList;
+			typedef std::vector<FeatureMapping> FeatureMappingList;
+
 			/**
 			 * \brief Constructs the \c %InteractionAnalyzer instance.
 			 */
@@ -82,8 +89,12 @@ namespace CDPL
 			 * \param type1 An identifier for the type of the first feature.
 			 * \param type2 An identifier for the type of the second feature.
 			 * \param func The constraint check function.
+			 * \param max_dist The maximum distance between the positions of two features of the given types that may 
+			 *                 fulfill the constraints, or a negative value if no such upper bound is known. The distance bound 
+			 *                 is used for the spatial pruning of feature pairs by analyze() calls that operate on a prepared
+			 *                 second feature container.
 			 */
-			void setConstraintFunction(unsigned int type1, unsigned type2, const ConstraintFunction& func);
+			void setConstraintFunction(unsigned int type1, unsigned type2, const ConstraintFunction& func, double max_dist = -1.0);
 
 			/**
 			 * \brief Removes the constraint check function that was registered for the specified pair of feature types.
@@ -99,6 +110,14 @@ namespace CDPL
 			 * \return The registered constraint check function.
 			 */
 			const ConstraintFunction& getConstraintFunction(unsigned int type1, unsigned type2) const;
+
+			/**
+			 * \brief Returns the maximum feature distance that was specified for the given pair of feature types.
+			 * \param type1 An identifier for the type of the first feature.
+			 * \param type2 An identifier for the type of the second feature.
+			 * \return The maximum feature distance, or a negative value if no upper bound is known.
+			 */
+			double getMaximumDistance(unsigned int type1, unsigned type2) const;
  
 			/**
 			 * \brief Analyzes possible interactions of the features in feature container \a cntnr1 and with features of \a cntnr2 according
@@ -122,11 +141,69 @@ namespace CDPL
 			 */
 			void analyze(const FeatureContainer& cntnr1, const FeatureContainer& cntnr2, FeatureMapping& iactions, bool append = false) const;
 
+			/**
+			 * \brief Builds a spatial index of the features in \a cntnr2 for subsequent analyze() calls that take only
+			 *        the first feature container as argument.
+			 *
+			 * The features of \a cntnr2 get bucketed by type into spatial hash grids whose cell sizes correspond to the
+			 * largest maximum distance that was specified for the constraint functions involving the respective type as second
+			 * feature type. Interactions are then only tested for nearby features of compatible type. Features of types for which
+			 * a constraint function without maximum distance has been registered and features without 3D-coordinates always get tested.
+			 * The index gets rebuilt automatically when constraint functions are set or removed, but has to be rebuilt by 
+			 * another call to prepare() whenever \a cntnr2 changes.
+			 *
+			 * \param cntnr2 The second feature container (e.g. the pharmacophore of a receptor). The container has to stay valid
+			 *               as long as the index is in use.
+			 */
+			void prepare(const FeatureContainer& cntnr2);
+
+			/**
+			 * \brief Analyzes possible interactions of the features in feature container \a cntnr1 with the features of the 
+			 *        second feature container specified in the last call to prepare().
+			 *
+			 * Yields the same interactions (in the same order) as the analyze() variant that takes both feature containers as arguments.
+			 *
+			 * \param cntnr1 The first feature container.
+			 * \param iactions An output map that contains features of \a cntnr1 as keys and interacting features of the
+			 *                 prepared container as values.
+			 * \param append If \c false, \a iactions gets cleared before adding any feature mappings.
+			 * \throw Base::OperationFailed if prepare() has not been called before.
+			 */
+			void analyze(const FeatureContainer& cntnr1, FeatureMapping& iactions, bool append = false) const;
+
+			/**
+			 * \brief Analyzes possible interactions of the features in each of the feature containers \a cntnrs (e.g. a set of
+			 *        ligand poses) with the features of the second feature container specified in the last call to prepare().
+			 * \param cntnrs The list of first feature containers.
+			 * \param iactions An output list receiving the interaction mappings of the feature containers in \a cntnrs (in the same order). 
+			 * \param num_threads The maximum number of threads that may be used for processing the containers in parallel.
+			 *                    A value of zero selects the number of available hardware threads.
+			 * \throw Base::OperationFailed if prepare() has not been called before.
+			 * \note If more than one thread is used, the registered constraint functions must be safe to be called concurrently.
+			 */
+			void analyze(const FeatureContainerList& cntnrs, FeatureMappingList& iactions, std::size_t num_threads = 1) const;
+
 		  private:
+			struct ConstraintData
+			{
+
+				ConstraintFunction function;
+				double             maxDistance;
+			};
+
+			class SpatialIndex;
+
 			typedef std::pair<unsigned int, unsigned int> FeatureTypePair;
-			typedef std::map<FeatureTypePair, ConstraintFunction> ConstraintFunctionMap;
-		
+			typedef std::map<FeatureTypePair, ConstraintData> ConstraintFunctionMap;
+			typedef boost::shared_ptr<SpatialIndex> SpatialIndexPtr;
+
+			void updateSpatialIndex();
+
+			void analyzeRange(const FeatureContainerList& cntnrs, FeatureMappingList& iactions, std::size_t begin, std::size_t end, 
+							  std::string& error) const;
+
 			ConstraintFunctionMap constraintFuncMap;
+			SpatialIndexPtr       spatialIndex;
 		};
 
 		/**
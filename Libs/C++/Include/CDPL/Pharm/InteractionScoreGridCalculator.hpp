@@ -41,6 +41,7 @@
 #include "CDPL/Math/Vector.hpp"
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Grid/SpatialGrid.hpp"
+#include "CDPL/Grid/RegularGrid.hpp"
 
 
 namespace CDPL 
@@ -122,13 +123,46 @@ namespace CDPL
 	
 			void calculate(const FeatureContainer& features, Grid::DSpatialGrid& grid);
 
+			/**
+			 * \brief Calculates the scores of all grid points and additionally stores the unnormalized scores in \a raw_scores.
+			 *
+			 * The stored scores allow for a later partial recalculation of the grid by means of recalculate().
+			 */
+			void calculate(const FeatureContainer& features, Grid::DSpatialGrid& grid, const FeaturePredicate& tgt_ftr_pred, 
+						   Math::DVector& raw_scores);
+
+			/**
+			 * \brief Recalculates only the scores of grid points that lie within the distance cutoff of at least one of
+			 *        the positions in \a changed_pos.
+			 *
+			 * \a changed_pos has to comprise the previous and current positions of all target features that have been added, 
+			 * removed or modified since the calculation that produced \a raw_scores. If the size of \a raw_scores does not match
+			 * the number of grid points, a full calculation is performed. For a Grid::DRegularGrid, only the grid points in the 
+			 * bounding box of the cutoff sphere around each changed position get visited. Other grid types require a check of
+			 * all grid points.
+			 */
+			void recalculate(const FeatureContainer& features, Grid::DSpatialGrid& grid, const FeaturePredicate& tgt_ftr_pred, 
+							 const Math::Vector3DArray& changed_pos, Math::DVector& raw_scores);
+
 			InteractionScoreGridCalculator& operator=(const InteractionScoreGridCalculator& calc);
 
 		  private:
+			bool initTargetFeatures(const FeatureContainer& features, const FeaturePredicate& tgt_ftr_pred);
+
+			double calcScore(const Math::Vector3D& grid_pos);
+
+			void getAffectedGridPoints(const Grid::DSpatialGrid& grid, const Math::Vector3DArray& changed_pos);
+			void getAffectedGridPoints(const Grid::DRegularGrid& grid, const Math::Vector3DArray& changed_pos);
+
+			void copyScores(const Math::DVector& raw_scores, Grid::DSpatialGrid& grid) const;
+
+			void normalizeGridScores(Grid::DSpatialGrid& grid, double min_score, double max_score) const;
+
 			typedef std::vector<const Feature*> FeatureList;
 			typedef Internal::Octree<Math::Vector3D, Math::Vector3DArray, double> Octree;
 			typedef boost::shared_ptr<Octree> OctreePtr;
 			typedef std::vector<std::size_t> FeatureIndexList;
+			typedef std::vector<std::size_t> GridPointIndexList;
 
 			FeatureList              tgtFeatures;
 			Math::DVector            partialScores;
@@ -138,6 +172,7 @@ namespace CDPL
 			OctreePtr                octree;
 			Math::Vector3DArray      featureCoords;
 			FeatureIndexList         featureIndices;
+			GridPointIndexList       gridPointIndices;
 			bool                     normScores;
 		};
 
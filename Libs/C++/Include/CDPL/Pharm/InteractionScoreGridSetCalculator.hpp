@@ -33,10 +33,13 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <utility>
 
 #include "CDPL/Pharm/APIPrefix.hpp"
 #include "CDPL/Pharm/InteractionScoreGridCalculator.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Grid/RegularGrid.hpp"
 
 
@@ -61,6 +64,10 @@ namespace CDPL
 			typedef InteractionScoreGridCalculator::ScoringFunction ScoringFunction;
 			typedef InteractionScoreGridCalculator::ScoreCombinationFunction ScoreCombinationFunction;
 
+			InteractionScoreGridSetCalculator();
+
+			InteractionScoreGridSetCalculator(const InteractionScoreGridSetCalculator& calc);
+
 			virtual ~InteractionScoreGridSetCalculator() {}
 		
 			void enableInteraction(unsigned int ftr_type, unsigned int tgt_ftr_type, bool enable);
@@ -83,19 +90,74 @@ namespace CDPL
 
 			bool scoresNormalized() const;
 
+			/**
+			 * \brief Specifies whether grids computed by a previous calculation shall be updated incrementally.
+			 *
+			 * If enabled, the calculator keeps the unnormalized grid scores and a snapshot of the features that were used
+			 * for the last calculation. A subsequent calculation then compares the new features to the snapshot (by type,
+			 * geometry, weight, position and orientation) and recomputes only those grid points that lie within the distance
+			 * cutoff of added, removed or modified features. A full calculation is performed for the first call and whenever
+			 * the calculator settings or the previously computed grids have been changed in the meantime.
+			 *
+			 * \param enable \c true if incremental updates shall be performed, and \c false otherwise.
+			 */
+			void enableIncrementalCalculation(bool enable);
+
+			bool isIncrementalCalculationEnabled() const;
+
+			InteractionScoreGridSetCalculator& operator=(const InteractionScoreGridSetCalculator& calc);
+
 		  protected:
 			void calculate(const FeatureContainer& features);
 
+			void clearIncrementalState();
+
 		  private:
 			virtual Grid::DSpatialGrid::SharedPointer createGrid(unsigned int ftr_type, unsigned int tgt_ftr_type) const = 0;
 
+			virtual bool isGridValid(const Grid::DSpatialGrid& grid) const;
+
+			struct FeatureData
+			{
+
+				bool operator<(const FeatureData& data) const;
+
+				unsigned int   type;
+				unsigned int   geometry;
+				double         weight;
+				bool           hasOrientation;
+				Math::Vector3D position;
+				Math::Vector3D orientation;
+			};
+
+			struct GridData
+			{
+
+				Grid::DSpatialGrid::SharedPointer grid;
+				Math::DVector                     rawScores;
+			};
+
 			typedef std::pair<unsigned int, unsigned int> FeatureTypePair;
 			typedef std::map<FeatureTypePair, ScoringFunction> ScoringFuncMap;
 			typedef std::set<FeatureTypePair> EnabledInteractionsMap;
-		
+			typedef std::map<FeatureTypePair, GridData> GridDataMap;
+			typedef std::vector<FeatureData> FeatureDataList;
+			typedef std::map<unsigned int, Math::Vector3DArray> ChangedPositionsMap;
+
+			bool canUpdateGrids() const;
+
+			void getFeatureData(const FeatureContainer& features, FeatureDataList& ftr_data) const;
+
+			void getChangedPositions();
+
 			ScoringFuncMap                  scoringFuncMap;
 			EnabledInteractionsMap          enabledInteractions;
             InteractionScoreGridCalculator  gridCalculator;
+			bool                            incCalculation;
+			GridDataMap                     gridData;
+			FeatureDataList                 lastFeatureData;
+			FeatureDataList                 currFeatureData;
+			ChangedPositionsMap             changedPositions;
 		};
 
 		/**
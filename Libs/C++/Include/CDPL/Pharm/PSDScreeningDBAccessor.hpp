@@ -99,6 +99,16 @@ namespace CDPL
 
 			const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const; 
 
+			/**
+			 * \brief Retrieves the atom coordinates and van der Waals radii stored for the conformation of the pharmacophore at index \a pharm_idx.
+			 * \param pharm_idx The index of the pharmacophore.
+			 * \param coords The output array for the atom coordinates.
+			 * \param vdw_radii The output array for the atomic van der Waals radii.
+			 * \return \c true if the data are available, and \c false if the database has been created by an older
+			 *         version that did not store atom coordinates separately.
+			 */
+			bool getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii) const;
+
 		  private:
 			typedef std::auto_ptr<PSDScreeningDBAccessorImpl> ImplementationPointer;
 
@@ -98,6 +98,33 @@ namespace CDPL
 
 			std::size_t getNumInserted() const;
 
+			/**
+			 * \brief Specifies whether the generated database records shall be inserted by a dedicated writer thread.
+			 *
+			 * If enabled, process() may be called concurrently by multiple threads. The calling threads then only perform
+			 * the CPU-intensive part of the work (hash code calculation, pharmacophore generation and record serialization)
+			 * and pass the finished records to the writer thread which inserts them in large batched transactions. Since
+			 * the insertion happens asynchronously, flush() has to be called to make sure that all records processed so far
+			 * have been written before statistics are queried. Errors encountered by the writer thread are reported by
+			 * the next call to process(), merge(), flush() or close().
+			 *
+			 * \param use If \c true, records are inserted by a writer thread, and otherwise synchronously by the calling thread.
+			 * \note By default, records are inserted synchronously.
+			 */
+			void setUseWriterThread(bool use);
+
+			/**
+			 * \brief Tells whether the generated database records get inserted by a dedicated writer thread.
+			 * \return \c true if a writer thread is used, and \c false otherwise.
+			 */
+			bool getUseWriterThread() const;
+
+			/**
+			 * \brief Waits until all records passed to the writer thread have been inserted into the database.
+			 * \throw Base::IOError if the writer thread failed to insert the records.
+			 */
+			void flush();
+
 		  private:
 			typedef std::auto_ptr<PSDScreeningDBCreatorImpl> ImplementationPointer;
 
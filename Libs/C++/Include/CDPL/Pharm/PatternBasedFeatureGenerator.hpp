@@ -38,6 +38,7 @@
 #include "CDPL/Pharm/APIPrefix.hpp"
 #include "CDPL/Pharm/FeatureGenerator.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Fragment.hpp"
 #include "CDPL/Chem/AtomBondMapping.hpp"
 #include "CDPL/Chem/SubstructureSearch.hpp"
 #include "CDPL/Util/BitSet.hpp"
@@ -128,6 +129,20 @@ namespace CDPL
 			 */
 			void generate(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm);
 
+			/**
+			 * \brief Performs the substructure searches for the specified include/exclude patterns and stores the 
+			 *        matched feature atoms for subsequent calls to instantiate().
+			 * \param molgraph The molecular graph for which to perceive the features.
+			 */
+			void prepare(const Chem::MolecularGraph& molgraph);
+
+			/**
+			 * \brief Adds the features perceived by the last call to prepare() to the pharmacophore \a pharm.
+			 * \param pharm The output pharmacophore where to add the generated features.
+			 * \throw Base::OperationFailed if prepare() has not been called before.
+			 */
+			void instantiate(Pharmacophore& pharm);
+
 			/**
 			 * \brief Replaces the current set include/exclude patterns by the patterns in the
 			 *        \c %PatternBasedFeatureGenerator instance \a gen.
@@ -145,6 +160,8 @@ namespace CDPL
 			bool calcPlaneFeatureOrientation(const AtomList&, Math::Vector3D&, Math::Vector3D&);
 			bool calcCentroid(const AtomList&, Math::Vector3D&) const;
 
+			virtual void prepareNonPatternFeatures(const Chem::MolecularGraph& molgraph) {}
+
 			virtual void addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm) {}
 
 			bool isContainedInIncMatchList(const Util::BitSet&) const;
@@ -183,16 +200,32 @@ namespace CDPL
 				Chem::SubstructureSearch::SharedPointer subSearch;
 			};
 
+			struct FeatureMatch
+			{
+
+				unsigned int                  featureType;
+				double                        featureTol;
+				unsigned int                  featureGeom;
+				double                        vectorLength;
+				Chem::Fragment::SharedPointer substructure;
+				AtomList                      posRefAtoms;
+				AtomList                      geomRefAtoms1;
+				AtomList                      geomRefAtoms2;
+			};
+
 			typedef std::vector<IncludePattern> IncludePatternList;
 			typedef std::vector<ExcludePattern> ExcludePatternList;
 			typedef Util::ObjectStack<Util::BitSet> BitSetCache;
 			typedef std::vector<Util::BitSet*> BitSetList;
+			typedef std::vector<FeatureMatch> FeatureMatchList;
 
 			void init(const Chem::MolecularGraph& molgraph);
 
 			void getExcludeMatches();
+			void getIncludeMatches();
 
-			void addFeature(const Chem::AtomBondMapping&, const IncludePattern&, Pharmacophore&);
+			void addFeatureMatch(const Chem::AtomBondMapping&, const IncludePattern&);
+			void addFeature(const FeatureMatch&, Pharmacophore&);
 		
 			void createMatchedAtomMask(const Chem::AtomMapping&, Util::BitSet&, bool) const;
 			bool isContainedInList(const Util::BitSet&, const BitSetList&) const;
@@ -202,9 +235,7 @@ namespace CDPL
 			ExcludePatternList          excludePatterns;
 			BitSetList                  includeMatches;
 			BitSetList                  excludeMatches;
-			AtomList                    posRefAtomList;
-			AtomList                    geomRefAtom1List;
-			AtomList                    geomRefAtom2List;
+			FeatureMatchList            featureMatches;
 			Math::Matrix<double>        svdU;
 			Math::Matrix3D              svdV;
 			Math::Vector3D              svdW;
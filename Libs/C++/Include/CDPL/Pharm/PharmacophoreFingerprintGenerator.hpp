@@ -0,0 +1,203 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintGenerator.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::PharmacophoreFingerprintGenerator.
+ */
+
+#ifndef CDPL_PHARM_PHARMACOPHOREFINGERPRINTGENERATOR_HPP
+#define CDPL_PHARM_PHARMACOPHOREFINGERPRINTGENERATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/DefaultPharmacophoreGenerator.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class MolecularGraph;
+	}
+
+	namespace Pharm
+	{
+
+		class Feature;
+		class FeatureContainer;
+		class TwoPointPharmacophore;
+		class ThreePointPharmacophore;
+
+		/**
+		 * \addtogroup CDPL_PHARM_DESCRIPTORS
+		 * @{
+		 */
+
+		/**
+		 * \brief PharmacophoreFingerprintGenerator.
+		 *
+		 * Generates folded binary fingerprints that encode the 2-point (feature pair) and 3-point (feature triplet) 
+		 * pharmacophores of a feature container. A 2-point pharmacophore is described by the types of its features and
+		 * their binned distance. A 3-point pharmacophore is described by the types of its features, each combined with the
+		 * binned length of the opposite triangle side. The descriptions are canonicalized so that they do not depend on the 
+		 * order of the features and then get hashed to a bit position of the fingerprint. Exclusion volumes and disabled
+		 * features are ignored.
+		 *
+		 * The fingerprint of a molecule with multiple conformations is the union (bitwise OR) of the fingerprints of
+		 * the pharmacophores of the individual conformers.
+		 *
+		 * \note Fingerprints are only comparable if they have been generated with identical settings.
+		 */
+		class CDPL_PHARM_API PharmacophoreFingerprintGenerator
+		{
+
+		public:
+			/**
+			 * \brief Constructs the \c %PharmacophoreFingerprintGenerator instance.
+			 */
+			PharmacophoreFingerprintGenerator();
+
+			/**
+			 * \brief Allows to specify the desired fingerprint size.
+			 * \param num_bits The desired fingerprint size in number of bits.
+			 * \note By default, the generated fingerprints are \e 2048 bits wide.
+			 */
+			void setNumBits(std::size_t num_bits);
+
+			/**
+			 * \brief Returns the size of the generated fingerprints.
+			 * \return The fingerprint size in number of bits.
+			 */
+			std::size_t getNumBits() const;
+
+			/**
+			 * \brief Sets the width of the feature distance bins.
+			 * \param bin_size The distance bin width.
+			 * \note The default bin width is <em>1.0</em>&Aring;.
+			 */
+			void setDistanceBinSize(double bin_size);
+
+			/**
+			 * \brief Returns the width of the feature distance bins.
+			 * \return The distance bin width.
+			 */
+			double getDistanceBinSize() const;
+
+			/**
+			 * \brief Sets the maximum binned feature distance.
+			 * \param max_dist The maximum distance. Larger distances are assigned to the last bin.
+			 * \note The default maximum distance is <em>16.0</em>&Aring;.
+			 */
+			void setMaxDistance(double max_dist);
+
+			/**
+			 * \brief Returns the maximum binned feature distance.
+			 * \return The maximum distance.
+			 */
+			double getMaxDistance() const;
+
+			/**
+			 * \brief Specifies whether 2-point pharmacophores shall be encoded.
+			 * \param include \c true if 2-point pharmacophores shall be encoded, and \c false otherwise.
+			 * \note By default, 2-point pharmacophores are encoded.
+			 */
+			void include2PointPharmacophores(bool include);
+
+			/**
+			 * \brief Tells whether 2-point pharmacophores get encoded.
+			 * \return \c true if 2-point pharmacophores get encoded, and \c false otherwise.
+			 */
+			bool include2PointPharmacophores() const;
+
+			/**
+			 * \brief Specifies whether 3-point pharmacophores shall be encoded.
+			 * \param include \c true if 3-point pharmacophores shall be encoded, and \c false otherwise.
+			 * \note By default, 3-point pharmacophores are encoded.
+			 */
+			void include3PointPharmacophores(bool include);
+
+			/**
+			 * \brief Tells whether 3-point pharmacophores get encoded.
+			 * \return \c true if 3-point pharmacophores get encoded, and \c false otherwise.
+			 */
+			bool include3PointPharmacophores() const;
+
+			/**
+			 * \brief Generates the fingerprint of the feature container \a cntnr.
+			 * \param cntnr The feature container (e.g. the pharmacophore of a single conformer).
+			 * \param fp The generated fingerprint.
+			 * \param merge If \c true, the bits of \a cntnr are added to the bits already set in \a fp (bitwise OR), 
+			 *              otherwise \a fp gets cleared first.
+			 */
+			void generate(const FeatureContainer& cntnr, Util::BitSet& fp, bool merge = false);
+
+			/**
+			 * \brief Generates the merged fingerprint of the pharmacophores of all conformations of the molecular graph \a molgraph.
+			 *
+			 * The pharmacophores are generated by a Pharm::DefaultPharmacophoreGenerator instance with the same settings that
+			 * are used by Pharm::PSDScreeningDBCreator. If \a molgraph has no conformations, the pharmacophore of the 3D 
+			 * coordinates of its atoms is used.
+			 *
+			 * \param molgraph The molecular graph for which to generate the fingerprint.
+			 * \param fp The generated fingerprint.
+			 * \note \a molgraph has to be prepared for pharmacophore generation (see Pharm::prepareForPharmacophoreGeneration()).
+			 */
+			void generate(const Chem::MolecularGraph& molgraph, Util::BitSet& fp);
+
+		private:
+			typedef std::vector<const Feature*> FeatureList;
+
+			void setBit(const TwoPointPharmacophore& pharm, Util::BitSet& fp) const;
+			void setBit(const ThreePointPharmacophore& pharm, Util::BitSet& fp) const;
+
+			void setBit(Base::uint64 hash, Util::BitSet& fp) const;
+
+			Base::uint64 getDistanceBin(double dist) const;
+
+			std::size_t                   numBits;
+			double                        binSize;
+			double                        maxDistance;
+			bool                          inc2PointPharms;
+			bool                          inc3PointPharms;
+			FeatureList                   features;
+			DefaultPharmacophoreGenerator pharmGenerator;
+			BasicPharmacophore            pharmacophore;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_PHARM_PHARMACOPHOREFINGERPRINTGENERATOR_HPP
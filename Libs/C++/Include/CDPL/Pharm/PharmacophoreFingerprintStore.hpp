@@ -0,0 +1,190 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintStore.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::PharmacophoreFingerprintStore.
+ */
+
+#ifndef CDPL_PHARM_PHARMACOPHOREFINGERPRINTSTORE_HPP
+#define CDPL_PHARM_PHARMACOPHOREFINGERPRINTSTORE_HPP
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Pharm
+	{
+
+		/**
+		 * \addtogroup CDPL_PHARM_SCREENING
+		 * @{
+		 */
+
+		/**
+		 * \brief PharmacophoreFingerprintStore.
+		 *
+		 * Stores pharmacophore fingerprints (see Pharm::PharmacophoreFingerprintGenerator) in a compact word array and 
+		 * performs Tanimoto similarity searches on them, e.g. as a cheap first stage filter that selects the molecules
+		 * of a screening database which then get subjected to pharmacophore alignment (see Pharm::ScreeningProcessor). 
+		 * Fingerprint indices correspond to the order in which the fingerprints have been added (e.g. the molecule indices of the
+		 * screening database the fingerprints have been generated for). Similarity searches are distributed over a configurable 
+		 * number of threads.
+		 *
+		 * The stored fingerprints can be saved to a file and loaded again later.
+		 */
+		class CDPL_PHARM_API PharmacophoreFingerprintStore
+		{
+
+		public:
+			typedef boost::shared_ptr<PharmacophoreFingerprintStore> SharedPointer;
+
+			/**
+			 * \brief A search hit given by the fingerprint index and the Tanimoto similarity to the query fingerprint.
+			 */
+			typedef std::pair<std::size_t, double> SearchHit;
+			typedef std::vector<SearchHit> SearchHitList;
+
+			/**
+			 * \brief Constructs an empty \c %PharmacophoreFingerprintStore instance.
+			 */
+			PharmacophoreFingerprintStore();
+
+			/**
+			 * \brief Specifies the maximum number of threads that will be used for similarity searches.
+			 * \param num_threads The maximum number of threads. A value of zero selects the number of available hardware threads.
+			 * \note By default, searches are performed in the calling thread only.
+			 */
+			void setNumThreads(std::size_t num_threads);
+
+			/**
+			 * \brief Returns the specified maximum number of threads.
+			 * \return The maximum number of threads.
+			 */
+			std::size_t getNumThreads() const;
+
+			/**
+			 * \brief Returns the size of the stored fingerprints.
+			 * \return The fingerprint size in number of bits, or zero if no fingerprints have been stored yet.
+			 */
+			std::size_t getNumFingerprintBits() const;
+
+			/**
+			 * \brief Returns the number of stored fingerprints.
+			 * \return The number of fingerprints.
+			 */
+			std::size_t getNumFingerprints() const;
+
+			/**
+			 * \brief Adds the fingerprint \a fp to the store.
+			 * \param fp The fingerprint to add.
+			 * \return The index of the added fingerprint.
+			 * \throw Base::SizeError if the size of \a fp differs from the size of the already stored fingerprints.
+			 */
+			std::size_t addFingerprint(const Util::BitSet& fp);
+
+			/**
+			 * \brief Retrieves the fingerprint at index \a idx.
+			 * \param idx The zero-based index of the fingerprint.
+			 * \param fp The bitset receiving the fingerprint.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumFingerprints() - 1].
+			 */
+			void getFingerprint(std::size_t idx, Util::BitSet& fp) const;
+
+			/**
+			 * \brief Determines all stored fingerprints whose Tanimoto similarity to \a query is equal to or greater 
+			 *        than \a min_sim.
+			 * \param query The query fingerprint.
+			 * \param hits Receives the search hits in order of decreasing similarity (hits of equal similarity are 
+			 *             ordered by ascending fingerprint index).
+			 * \param min_sim The minimum Tanimoto similarity.
+			 * \param max_num_hits The maximum number of hits to report (zero means no limit). If the limit is exceeded, 
+			 *                     only the most similar fingerprints are reported.
+			 * \return The number of reported hits.
+			 * \throw Base::SizeError if the size of \a query differs from the size of the stored fingerprints.
+			 */
+			std::size_t findSimilar(const Util::BitSet& query, SearchHitList& hits, double min_sim, std::size_t max_num_hits = 0) const;
+
+			/**
+			 * \brief Removes all fingerprints.
+			 */
+			void clear();
+
+			/**
+			 * \brief Saves the stored fingerprints to the file \a file_name.
+			 * \param file_name The path of the output file.
+			 * \throw Base::IOError if writing the file failed.
+			 */
+			void save(const std::string& file_name) const;
+
+			/**
+			 * \brief Replaces the stored fingerprints by the fingerprints saved in the file \a file_name.
+			 * \param file_name The path of the fingerprint file.
+			 * \throw Base::IOError if the file cannot be opened or does not contain valid data.
+			 */
+			void open(const std::string& file_name);
+
+			/**
+			 * \brief Returns the path of the last opened fingerprint file.
+			 * \return The path of the opened file, or an empty string if no file has been opened.
+			 */
+			const std::string& getFileName() const;
+
+		private:
+			typedef std::vector<Base::uint64> UInt64Array;
+			typedef std::vector<std::size_t> CountArray;
+
+			void searchFingerprints(boost::atomic<std::size_t>& next_idx, const UInt64Array& query, std::size_t query_bit_count,
+									double min_sim, std::size_t max_num_hits, SearchHitList& hits) const;
+
+			static void selectBestHits(SearchHitList& hits, std::size_t max_num_hits);
+
+			std::size_t numThreads;
+			std::size_t numBits;
+			std::size_t numFPWords;
+			UInt64Array fingerprints;
+			CountArray  bitCounts;
+			std::string fileName;
+		};
+
+		/**
+		 * @}
+		 */
+	}
+}
+
+#endif // CDPL_PHARM_PHARMACOPHOREFINGERPRINTSTORE_HPP
@@ -121,6 +121,31 @@ namespace CDPL
 			 */
 			void generate(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm, bool append = false);
 
+			/**
+			 * \brief Performs the coordinate independent perception steps (e.g. substructure searches) of the enabled
+			 *        pharmacophore features of the molecular graph a\ molgraph.
+			 *
+			 * The perceived data serve as a template for all subsequent calls to instantiate(). Generating the pharmacophores of
+			 * multiple conformations of a molecule by a single call to prepare() and a call to instantiate() for each conformation
+			 * (with the atom 3D-coordinates function adjusted accordingly) avoids repeating the topological perception steps.
+			 *
+			 * \param molgraph The molecular graph for which to perceive the features. The molecular graph has to stay
+			 *                 valid and must not be modified until the last call to instantiate().
+			 */
+			void prepare(const Chem::MolecularGraph& molgraph);
+
+			/**
+			 * \brief Adds the features of the molecular graph specified by the last call to prepare() to the pharmacophore \a pharm.
+			 *
+			 * Feature positions and orientations get calculated from the atom coordinates delivered by the current atom 
+			 * 3D-coordinates function.
+			 *
+			 * \param pharm The pharmacophore instance where the generated output features get appended.
+			 * \param append If \c false, \a pharm gets cleared before adding any new features.
+			 * \throw Base::OperationFailed if prepare() has not been called before.
+			 */
+			void instantiate(Pharmacophore& pharm, bool append = false);
+
 			/**
 			 * \brief Specifies a function for the retrieval of atom 3D-coordinates for feature generation.
 			 * \param func The atom 3D-coordinates function.
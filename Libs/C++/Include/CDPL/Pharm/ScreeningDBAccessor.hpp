@@ -37,6 +37,8 @@
 #include <boost/shared_ptr.hpp>
 
 #include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+#include "CDPL/Util/Array.hpp"
 
 
 namespace CDPL 
@@ -99,6 +101,23 @@ namespace CDPL
 
 			virtual const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const = 0; 
 
+			/**
+			 * \brief Retrieves the atom coordinates of the molecule conformation the pharmacophore at index \a pharm_idx
+			 *        has been generated for, together with the van der Waals radii of the atoms.
+			 *
+			 * Databases may store these data separately from the molecule records which allows clients (e.g. exclusion
+			 * volume clash tests) to access them without retrieving and decoding the full molecule.
+			 *
+			 * \param pharm_idx The index of the pharmacophore.
+			 * \param coords The output array for the atom coordinates.
+			 * \param vdw_radii The output array for the atomic van der Waals radii.
+			 * \return \c true if the data are available, and \c false otherwise.
+			 * \note The default implementation returns \c false.
+			 */
+			virtual bool getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii) const {
+				return false;
+			}
+
 		  protected:
 			ScreeningDBAccessor& operator=(const ScreeningDBAccessor&) {
 				return *this;
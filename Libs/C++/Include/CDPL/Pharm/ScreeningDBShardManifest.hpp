@@ -0,0 +1,176 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningDBShardManifest.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::ScreeningDBShardManifest.
+ */
+
+#ifndef CDPL_PHARM_SCREENINGDBSHARDMANIFEST_HPP
+#define CDPL_PHARM_SCREENINGDBSHARDMANIFEST_HPP
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+
+
+namespace CDPL 
+{
+
+    namespace Pharm
+    {
+
+		/**
+		 * \addtogroup CDPL_PHARM_SCREENING
+		 * @{
+		 */
+
+		/**
+		 * \brief Describes a screening database that has been split into a sequence of shard database files.
+		 *
+		 * The molecules of all shards form a single global molecule index space. Each shard covers a contiguous
+		 * range of global molecule indices that starts at the sum of the molecule counts of all preceding shards
+		 * (the molecule index offset of the shard).
+		 *
+		 * In textual form, the manifest lists one shard per line in the format
+		 * <tt>&lt;mol. index offset&gt; &lt;num. molecules&gt; &lt;shard file path&gt;</tt>. Empty lines and lines
+		 * starting with '#' are ignored. Relative shard file paths are interpreted relative to the directory of
+		 * the manifest file.
+		 */
+		class CDPL_PHARM_API ScreeningDBShardManifest
+		{
+
+		  public:
+			typedef boost::shared_ptr<ScreeningDBShardManifest> SharedPointer;
+
+			/**
+			 * \brief Constructs an empty \c %ScreeningDBShardManifest instance.
+			 */
+			ScreeningDBShardManifest();
+
+			/**
+			 * \brief Appends a shard with the database file \a file_name that contains \a num_mols molecules.
+			 *
+			 * The molecule index offset of the new shard is the current total number of molecules.
+			 *
+			 * \param file_name The path of the shard database file.
+			 * \param num_mols The number of molecules stored in the shard.
+			 */
+			void addShard(const std::string& file_name, std::size_t num_mols);
+
+			/**
+			 * \brief Returns the number of shards.
+			 * \return The number of shards.
+			 */
+			std::size_t getNumShards() const;
+
+			/**
+			 * \brief Returns the database file path of the shard at index \a idx.
+			 * \param idx The zero-based index of the shard.
+			 * \return The path of the shard database file.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumShards() - 1].
+			 */
+			const std::string& getShardFileName(std::size_t idx) const;
+
+			/**
+			 * \brief Returns the global index of the first molecule stored in the shard at index \a idx.
+			 * \param idx The zero-based index of the shard.
+			 * \return The molecule index offset of the shard.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumShards() - 1].
+			 */
+			std::size_t getShardMoleculeOffset(std::size_t idx) const;
+
+			/**
+			 * \brief Returns the number of molecules stored in the shard at index \a idx.
+			 * \param idx The zero-based index of the shard.
+			 * \return The number of molecules in the shard.
+			 * \throw Base::IndexError if \a idx is not in the range [0, getNumShards() - 1].
+			 */
+			std::size_t getShardNumMolecules(std::size_t idx) const;
+
+			/**
+			 * \brief Returns the index of the shard that stores the molecule with the global index \a mol_idx.
+			 * \param mol_idx The global molecule index.
+			 * \return The index of the shard.
+			 * \throw Base::IndexError if \a mol_idx is not in the range [0, getNumMolecules() - 1].
+			 */
+			std::size_t findShard(std::size_t mol_idx) const;
+
+			/**
+			 * \brief Returns the total number of molecules stored in all shards.
+			 * \return The total number of molecules.
+			 */
+			std::size_t getNumMolecules() const;
+
+			/**
+			 * \brief Removes all shards.
+			 */
+			void clear();
+
+			/**
+			 * \brief Reads the manifest data from the input stream \a is.
+			 *
+			 * The current content gets replaced.
+			 *
+			 * \param is The input stream.
+			 * \throw Base::IOError if the manifest data are malformed or the molecule index offsets are not contiguous.
+			 */
+			void read(std::istream& is);
+
+			/**
+			 * \brief Writes the manifest data to the output stream \a os.
+			 * \param os The output stream.
+			 * \throw Base::IOError if writing the data failed.
+			 */
+			void write(std::ostream& os) const;
+
+		  private:
+			struct Shard
+			{
+
+				std::string fileName;
+				std::size_t molOffset;
+				std::size_t numMolecules;
+			};
+
+			typedef std::vector<Shard> ShardList;
+
+			const Shard& getShard(std::size_t idx) const;
+
+			ShardList shards;
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_PHARM_SCREENINGDBSHARDMANIFEST_HPP
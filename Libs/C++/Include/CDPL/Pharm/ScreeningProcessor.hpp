@@ -32,12 +32,14 @@
 #define CDPL_PHARM_SCREENINGPROCESSOR_HPP
 
 #include <memory>
+#include <vector>
 #include <cstddef>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
 
 #include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
 #include "CDPL/Math/Matrix.hpp"
 
 
@@ -84,7 +86,7 @@ namespace CDPL
 				SearchHit(const ScreeningProcessor& hit_prov, const FeatureContainer& qry_pharm,
 						  const FeatureContainer& hit_pharm, const Chem::Molecule& mol, 
 						  const Math::Matrix4D& xform, std::size_t pharm_idx, 
-						  std::size_t mol_idx, std::size_t conf_idx);
+						  std::size_t mol_idx, std::size_t conf_idx, std::size_t qry_idx = 0);
 
 				const ScreeningProcessor& getHitProvider() const;
 
@@ -102,6 +104,12 @@ namespace CDPL
 
 				std::size_t getHitConformationIndex() const;
 
+				/**
+				 * \brief Returns the index of the matched query pharmacophore in the query list passed to searchDB().
+				 * \return The query pharmacophore index (always zero for single query searches).
+				 */
+				std::size_t getQueryPharmacophoreIndex() const;
+
 			private:
 				const ScreeningProcessor*     provider;
 				const FeatureContainer*       qryPharm;
@@ -111,10 +119,13 @@ namespace CDPL
 				std::size_t                   pharmIndex;
 				std::size_t                   molIndex;
 				std::size_t                   confIndex;
+				std::size_t                   qryIndex;
 			};
 
 			typedef boost::shared_ptr<ScreeningProcessor> SharedPointer;
 
+			typedef std::vector<const FeatureContainer*> FeatureContainerList;
+
 			typedef boost::function2<bool, const SearchHit&, double> HitCallbackFunction;
 			typedef boost::function1<double, const SearchHit&> ScoringFunction;
 			typedef boost::function2<bool, std::size_t, std::size_t> ProgressCallbackFunction;
@@ -151,6 +162,24 @@ namespace CDPL
 
 			bool bestAlignmentsSeeked() const;
 
+			/**
+			 * \brief Specifies whether the search for the best alignment of a database pharmacophore shall be pruned.
+			 *
+			 * If enabled and best alignments are seeked, the maximal cliques of the query/database feature pair compatibility graph
+			 * are processed largest first (see Chem::TopologicalEntityAlignment::orderCliquesBySize()) and the alignment search
+			 * gets terminated as soon as the best alignment found so far reaches an upper bound of the score that is achievable
+			 * for the database pharmacophore. The bound assumes a perfect match of all query features whose type occurs in the
+			 * database pharmacophore. Since no alignment can exceed this score, pruning does not change the reported hit scores.
+			 *
+			 * \param prune If \c true, the best alignment search gets pruned, and if \c false all cliques are processed.
+			 * \note The score bound is only known for scoring functions of type PharmacophoreFitScreeningScore. For other scoring
+			 *       functions, cliques are still processed largest first but no early termination takes place.
+			 *       By default, the search is not pruned.
+			 */
+			void pruneAlignmentSearch(bool prune);
+
+			bool alignmentSearchPruned() const;
+
 			void setHitCallback(const HitCallbackFunction& func);
 
 			const HitCallbackFunction& getHitCallback() const;
@@ -163,8 +192,40 @@ namespace CDPL
 
 			const ScoringFunction& getScoringFunction() const;
 
+			/**
+			 * \brief Specifies whether per-stage screening statistics shall be collected.
+			 *
+			 * The statistics of subsequent searchDB() calls accumulate until clearStatistics() gets called. When disabled
+			 * (the default), no clocks are queried.
+			 *
+			 * \param enable \c true if statistics shall be collected, and \c false otherwise.
+			 */
+			void enableStatistics(bool enable);
+
+			bool statisticsEnabled() const;
+
+			const ScreeningStatistics& getStatistics() const;
+
+			void clearStatistics();
+
 			std::size_t searchDB(const FeatureContainer& query, std::size_t mol_start_idx = 0, std::size_t mol_end_idx = 0);
 
+			/**
+			 * \brief Screens the database for matches of multiple query pharmacophores in a single pass.
+			 *
+			 * Each database pharmacophore gets loaded and preprocessed only once and is then tested against all queries. 
+			 * Hit report mode semantics apply to each query separately and the reported hits can be attributed to their
+			 * query by means of SearchHit::getQueryPharmacophoreIndex(). For a given database pharmacophore, hits are 
+			 * reported in the order of the queries.
+			 *
+			 * \param queries The query pharmacophores.
+			 * \param mol_start_idx The index of the first database molecule to screen.
+			 * \param mol_end_idx One past the index of the last database molecule to screen (zero means screening 
+			 *                    up to the last molecule).
+			 * \return The total number of reported hits.
+			 */
+			std::size_t searchDB(const FeatureContainerList& queries, std::size_t mol_start_idx = 0, std::size_t mol_end_idx = 0);
+
 		  private:
 			typedef std::auto_ptr<ScreeningProcessorImpl> ImplementationPointer;
 
@@ -0,0 +1,181 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ScreeningStatistics.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::ScreeningStatistics.
+ */
+
+#ifndef CDPL_PHARM_SCREENINGSTATISTICS_HPP
+#define CDPL_PHARM_SCREENINGSTATISTICS_HPP
+
+#include <cstddef>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+		/**
+		 * \addtogroup CDPL_PHARM_SCREENING
+		 * @{
+		 */
+
+		/**
+		 * \brief ScreeningStatistics.
+		 *
+		 * Records for each stage of the screening process the number of candidates that passed or were rejected by
+		 * the stage together with the accumulated wall clock and thread CPU times (in seconds) spent in the stage.
+		 * Stage times are exclusive, i.e. the time of a stage does not comprise the times of other stages that
+		 * are entered while it is active (e.g. the loading of a database molecule for scoring is accounted for by
+		 * MOLECULE_LOADING and not by SCORING).
+		 *
+		 * The loading stages count each performed load as passed. The checks FEATURE_COUNT_CHECK and
+		 * TWO_POINT_PHARMACOPHORE_CHECK are performed once per pair of query and database pharmacophore, the
+		 * ALIGNMENT stage passes a pair if at least one of its alignments passed the GEOMETRY_CHECK and
+		 * XVOLUME_CLASH_CHECK stages which are performed for each generated alignment. SCORING counts the
+		 * number of scored alignments and HIT_REPORTING the number of hits passed to the hit callback.
+		 */
+		class CDPL_PHARM_API ScreeningStatistics
+		{
+
+		  public:
+			/**
+			 * \brief The tracked screening stages.
+			 */
+			enum Stage
+			{
+
+			  PHARMACOPHORE_LOADING,
+			  MOLECULE_LOADING,
+			  ATOM_COORDINATES_LOADING,
+			  FEATURE_COUNT_CHECK,
+			  TWO_POINT_PHARMACOPHORE_CHECK,
+			  ALIGNMENT,
+			  GEOMETRY_CHECK,
+			  XVOLUME_CLASH_CHECK,
+			  SCORING,
+			  HIT_REPORTING,
+			  NUM_STAGES
+			};
+
+			/**
+			 * \brief Constructs a \c %ScreeningStatistics instance with all counts and times set to zero.
+			 */
+			ScreeningStatistics();
+
+			/**
+			 * \brief Returns the number of candidates that passed the specified stage.
+			 * \param stage The screening stage.
+			 * \return The number of passed candidates.
+			 */
+			std::size_t getNumPassed(Stage stage) const;
+
+			/**
+			 * \brief Returns the number of candidates that were rejected by the specified stage.
+			 * \param stage The screening stage.
+			 * \return The number of rejected candidates.
+			 */
+			std::size_t getNumRejected(Stage stage) const;
+
+			/**
+			 * \brief Returns the accumulated wall clock time spent in the specified stage.
+			 * \param stage The screening stage.
+			 * \return The accumulated wall clock time in seconds.
+			 */
+			double getWallTime(Stage stage) const;
+
+			/**
+			 * \brief Returns the accumulated CPU time spent in the specified stage.
+			 * \param stage The screening stage.
+			 * \return The accumulated CPU time in seconds.
+			 */
+			double getCPUTime(Stage stage) const;
+
+			/**
+			 * \brief Returns the sum of the wall clock times of all stages.
+			 * \return The total wall clock time in seconds.
+			 */
+			double getTotalWallTime() const;
+
+			/**
+			 * \brief Returns the sum of the CPU times of all stages.
+			 * \return The total CPU time in seconds.
+			 */
+			double getTotalCPUTime() const;
+
+			/**
+			 * \brief Increments the pass or reject count of the specified stage by \a num.
+			 * \param stage The screening stage.
+			 * \param passed If \c true, the pass count is incremented, and the reject count otherwise.
+			 * \param num The increment.
+			 */
+			void addResult(Stage stage, bool passed, std::size_t num = 1);
+
+			/**
+			 * \brief Adds the specified wall clock and CPU times to the accumulated times of the given stage.
+			 * \param stage The screening stage.
+			 * \param wall_secs The wall clock time in seconds to add.
+			 * \param cpu_secs The CPU time in seconds to add.
+			 */
+			void addTime(Stage stage, double wall_secs, double cpu_secs);
+
+			/**
+			 * \brief Sets all counts and times to zero.
+			 */
+			void clear();
+
+			/**
+			 * \brief Adds the counts and times of \a stats to the corresponding values of this instance.
+			 * \param stats The statistics to add.
+			 * \return A reference to itself.
+			 */
+			ScreeningStatistics& operator+=(const ScreeningStatistics& stats);
+
+			/**
+			 * \brief Returns a string representation of the specified screening stage.
+			 * \param stage The screening stage.
+			 * \return The name of the stage.
+			 */
+			static const char* getStageName(Stage stage);
+
+		  private:
+			std::size_t numPassed[NUM_STAGES];
+			std::size_t numRejected[NUM_STAGES];
+			double      wallTimes[NUM_STAGES];
+			double      cpuTimes[NUM_STAGES];
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_PHARM_SCREENINGSTATISTICS_HPP
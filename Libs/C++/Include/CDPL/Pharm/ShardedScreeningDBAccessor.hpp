@@ -0,0 +1,181 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ShardedScreeningDBAccessor.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::ShardedScreeningDBAccessor.
+ */
+
+#ifndef CDPL_PHARM_SHARDEDSCREENINGDBACCESSOR_HPP
+#define CDPL_PHARM_SHARDEDSCREENINGDBACCESSOR_HPP
+
+#include <vector>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
+
+
+namespace CDPL 
+{
+
+    namespace Pharm
+    {
+	
+		class PSDScreeningDBAccessor;
+
+		/**
+		 * \addtogroup CDPL_PHARM_SCREENING
+		 * @{
+		 */
+
+		/**
+		 * \brief A class for accessing a set of pharmacophore screening database shards (see ScreeningDBShardManifest)
+		 *        in the built-in optimized format as a single logical database.
+		 *
+		 * The database name passed to open() specifies the path of the shard manifest file. Molecule indices always refer
+		 * to the global molecule index space defined by the manifest. The enumerated pharmacophores can be restricted to the
+		 * pharmacophores stored in a contiguous range of shards by means of selectShards(). This allows to screen only a
+		 * subset of the shards (e.g. on different compute nodes) while the reported molecule indices remain globally unique.
+		 * Shard database files get opened on first access only.
+		 */
+		class CDPL_PHARM_API ShardedScreeningDBAccessor : public ScreeningDBAccessor
+		{
+
+		  public:
+			typedef boost::shared_ptr<ShardedScreeningDBAccessor> SharedPointer;
+
+			ShardedScreeningDBAccessor();
+
+			/**
+			 * \brief Constructs a \c %ShardedScreeningDBAccessor instance that will read data from the 
+			 *        shard databases listed by the manifest file specified by \a name.
+			 * \param name The path of the shard manifest file.
+			 */
+			ShardedScreeningDBAccessor(const std::string& name);
+
+			/**
+			 * \brief Destructor.
+			 */
+			~ShardedScreeningDBAccessor();
+
+			/**
+			 * \brief Reads the shard manifest file \a name and selects all listed shards.
+			 * \param name The path of the shard manifest file.
+			 * \throw Base::IOError if the manifest file could not be read.
+			 */
+			void open(const std::string& name);
+
+			void close();
+
+			const std::string& getDatabaseName() const;
+
+			/**
+			 * \brief Returns the manifest describing the shards of the database.
+			 * \return The shard manifest.
+			 */
+			const ScreeningDBShardManifest& getManifest() const;
+
+			/**
+			 * \brief Restricts the enumerated pharmacophores to those stored in the shards with an index in the range 
+			 *        [\a first_idx, \a first_idx + \a num_shards).
+			 * \param first_idx The index of the first selected shard.
+			 * \param num_shards The number of selected shards.
+			 * \throw Base::IndexError if the specified range exceeds the number of shards.
+			 */
+			void selectShards(std::size_t first_idx, std::size_t num_shards);
+
+			/**
+			 * \brief Returns the index of the first selected shard.
+			 * \return The index of the first selected shard.
+			 */
+			std::size_t getFirstSelectedShard() const;
+
+			/**
+			 * \brief Returns the number of selected shards.
+			 * \return The number of selected shards.
+			 */
+			std::size_t getNumSelectedShards() const;
+
+			/**
+			 * \brief Returns the total number of molecules in all shards.
+			 * \return The number of molecules.
+			 */
+			std::size_t getNumMolecules() const;
+
+			/**
+			 * \brief Returns the number of pharmacophores stored in the selected shards.
+			 * \return The number of enumerated pharmacophores.
+			 */
+			std::size_t getNumPharmacophores() const;
+
+			std::size_t getNumPharmacophores(std::size_t mol_idx) const;
+
+			void getMolecule(std::size_t mol_idx, Chem::Molecule& mol, bool overwrite = true) const; 
+
+			void getPharmacophore(std::size_t pharm_idx, Pharmacophore& pharm, bool overwrite = true) const; 
+
+			void getPharmacophore(std::size_t mol_idx, std::size_t mol_conf_idx, Pharmacophore& pharm, bool overwrite = true) const; 
+
+			std::size_t getMoleculeIndex(std::size_t pharm_idx) const;
+
+			std::size_t getConformationIndex(std::size_t pharm_idx) const;
+
+			const FeatureTypeHistogram& getFeatureCounts(std::size_t pharm_idx) const;
+
+			const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const; 
+
+			bool getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii) const;
+
+		  private:
+			typedef boost::shared_ptr<PSDScreeningDBAccessor> ShardAccessorPtr;
+			typedef std::vector<ShardAccessorPtr> ShardAccessorList;
+			typedef std::vector<std::size_t> IndexArray;
+
+			ShardedScreeningDBAccessor(const ShardedScreeningDBAccessor&);
+
+			ShardedScreeningDBAccessor& operator=(const ShardedScreeningDBAccessor&);
+
+			const PSDScreeningDBAccessor& getShardAccessor(std::size_t shard_idx) const;
+			const PSDScreeningDBAccessor& getMoleculeShardAccessor(std::size_t& mol_idx) const;
+			const PSDScreeningDBAccessor& getPharmacophoreShardAccessor(std::size_t& pharm_idx, std::size_t& shard_idx) const;
+
+			void initPharmacophoreOffsets() const;
+
+			std::string               dbName;
+			ScreeningDBShardManifest  manifest;
+			std::size_t               firstSelShard;
+			std::size_t               numSelShards;
+			mutable ShardAccessorList shardAccessors;
+			mutable IndexArray        pharmOffsets;
+		};
+
+		/**
+		 * @}
+		 */
+    }
+}
+
+#endif // CDPL_PHARM_SHARDEDSCREENINGDBACCESSOR_HPP
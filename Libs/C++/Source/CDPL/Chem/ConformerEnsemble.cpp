@@ -0,0 +1,195 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ConformerEnsemble.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+
+#include "CDPL/Chem/ConformerEnsemble.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+Chem::ConformerEnsemble::ConformerEnsemble(std::size_t num_atoms): 
+	numAtoms(num_atoms)
+{}
+
+Chem::ConformerEnsemble::ConformerEnsemble(const MolecularGraph& molgraph): 
+	numAtoms(0)
+{
+	assign(molgraph);
+}
+
+void Chem::ConformerEnsemble::assign(const MolecularGraph& molgraph)
+{
+	std::size_t num_confs = getNumConformations(molgraph);
+
+	numAtoms = molgraph.getNumAtoms();
+
+	coordinates.resize(num_confs * numAtoms);
+	energies.assign(num_confs, 0.0);
+
+	if (num_confs == 0)
+		return;
+
+	for (std::size_t i = 0; i < numAtoms; i++) {
+		const Math::Vector3DArray::StorageType& atom_coords = get3DCoordinatesArray(molgraph.getAtom(i))->getData();
+
+		for (std::size_t j = 0; j < num_confs; j++)
+			coordinates[j * numAtoms + i] = atom_coords[j];
+	}
+
+	if (!hasConformerEnergies(molgraph))
+		return;
+
+	const Util::DArray& conf_energies = *getConformerEnergies(molgraph);
+
+	std::copy(conf_energies.getElementsBegin(), conf_energies.getElementsBegin() + std::min(num_confs, conf_energies.getSize()),
+			  energies.begin());
+}
+
+void Chem::ConformerEnsemble::clear()
+{
+	coordinates.clear();
+	energies.clear();
+}
+
+void Chem::ConformerEnsemble::setNumAtoms(std::size_t num_atoms)
+{
+	clear();
+
+	numAtoms = num_atoms;
+}
+
+std::size_t Chem::ConformerEnsemble::getNumAtoms() const
+{
+	return numAtoms;
+}
+
+std::size_t Chem::ConformerEnsemble::getNumConformers() const
+{
+	return energies.size();
+}
+
+void Chem::ConformerEnsemble::reserve(std::size_t num_confs)
+{
+	coordinates.reserve(num_confs * numAtoms);
+	energies.reserve(num_confs);
+}
+
+Math::Vector3D* Chem::ConformerEnsemble::addConformer(double energy)
+{
+	energies.push_back(energy);
+	coordinates.resize(coordinates.size() + numAtoms);
+
+	return getCoordinates(energies.size() - 1);
+}
+
+void Chem::ConformerEnsemble::addConformer(const Math::Vector3DArray& coords, double energy)
+{
+	if (coords.getSize() < numAtoms)
+		throw Base::SizeError("ConformerEnsemble: insufficient number of atom coordinates");
+
+	coordinates.insert(coordinates.end(), coords.getElementsBegin(), coords.getElementsBegin() + numAtoms);
+	energies.push_back(energy);
+}
+
+void Chem::ConformerEnsemble::removeConformer(std::size_t conf_idx)
+{
+	checkIndex(conf_idx);
+
+	coordinates.erase(coordinates.begin() + conf_idx * numAtoms, coordinates.begin() + (conf_idx + 1) * numAtoms);
+	energies.erase(energies.begin() + conf_idx);
+}
+
+Math::Vector3D* Chem::ConformerEnsemble::getCoordinates(std::size_t conf_idx)
+{
+	checkIndex(conf_idx);
+
+	return (numAtoms == 0 ? static_cast<Math::Vector3D*>(0) : &coordinates[conf_idx * numAtoms]);
+}
+
+const Math::Vector3D* Chem::ConformerEnsemble::getCoordinates(std::size_t conf_idx) const
+{
+	checkIndex(conf_idx);
+
+	return (numAtoms == 0 ? static_cast<const Math::Vector3D*>(0) : &coordinates[conf_idx * numAtoms]);
+}
+
+double Chem::ConformerEnsemble::getEnergy(std::size_t conf_idx) const
+{
+	checkIndex(conf_idx);
+
+	return energies[conf_idx];
+}
+
+void Chem::ConformerEnsemble::setEnergy(std::size_t conf_idx, double energy)
+{
+	checkIndex(conf_idx);
+
+	energies[conf_idx] = energy;
+}
+
+void Chem::ConformerEnsemble::getConformer(std::size_t conf_idx, Math::Vector3DArray& coords, bool append) const
+{
+	checkIndex(conf_idx);
+
+	if (!append)
+		coords.clear();
+
+	Math::Vector3DArray::StorageType& coords_data = coords.getData();
+	CoordinatesArray::const_iterator conf_coords = coordinates.begin() + conf_idx * numAtoms;
+
+	coords_data.insert(coords_data.end(), conf_coords, conf_coords + numAtoms);
+}
+
+void Chem::ConformerEnsemble::applyConformer(std::size_t conf_idx, AtomContainer& cntnr) const
+{
+	checkIndex(conf_idx);
+
+	if (cntnr.getNumAtoms() != numAtoms)
+		throw Base::SizeError("ConformerEnsemble: atom count mismatch");
+
+	CoordinatesArray::const_iterator conf_coords = coordinates.begin() + conf_idx * numAtoms;
+
+	for (AtomContainer::AtomIterator it = cntnr.getAtomsBegin(), end = cntnr.getAtomsEnd(); it != end; ++it, ++conf_coords)
+		set3DCoordinates(*it, *conf_coords);
+}
+
+void Chem::ConformerEnsemble::checkIndex(std::size_t conf_idx) const
+{
+	if (conf_idx >= energies.size())
+		throw Base::IndexError("ConformerEnsemble: conformer index out of bounds");
+}
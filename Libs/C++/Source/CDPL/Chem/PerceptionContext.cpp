@@ -0,0 +1,408 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * PerceptionContext.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include "CDPL/Chem/PerceptionContext.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/BondFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t UNDEF_IMPL_H_COUNT = ~std::size_t(0);
+
+	bool allAtomsHaveProperty(const Chem::MolecularGraph& molgraph, bool (*has_prop_func)(const Chem::Atom&))
+	{
+		for (Chem::MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it)
+			if (!has_prop_func(*it))
+				return false;
+
+		return true;
+	}
+
+	bool allBondsHaveProperty(const Chem::MolecularGraph& molgraph, bool (*has_prop_func)(const Chem::Bond&))
+	{
+		for (Chem::MolecularGraph::ConstBondIterator it = molgraph.getBondsBegin(), end = molgraph.getBondsEnd(); it != end; ++it)
+			if (!has_prop_func(*it))
+				return false;
+
+		return true;
+	}
+}
+
+
+bool Chem::PerceptionContext::AtomState::operator==(const AtomState& state) const
+{
+	return (type == state.type && charge == state.charge && isotope == state.isotope && implHCount == state.implHCount);
+}
+
+bool Chem::PerceptionContext::AtomState::operator!=(const AtomState& state) const
+{
+	return !operator==(state);
+}
+
+
+Chem::PerceptionContext::PerceptionContext(): 
+	molGraph(0)
+{}
+
+Chem::PerceptionContext::PerceptionContext(MolecularGraph& molgraph)
+{
+	setMolecularGraph(molgraph);
+}
+
+void Chem::PerceptionContext::setMolecularGraph(MolecularGraph& molgraph)
+{
+	molGraph = &molgraph;
+
+	recordState(bondAtomIndices, atomStates, bondOrders);
+}
+
+Chem::MolecularGraph* Chem::PerceptionContext::getMolecularGraph() const
+{
+	return molGraph;
+}
+
+bool Chem::PerceptionContext::update()
+{
+	if (!molGraph)
+		return false;
+
+	recordState(tmpBondAtomIndices, tmpAtomStates, tmpBondOrders);
+
+	bool changed = false;
+
+	if (tmpAtomStates.size() != atomStates.size() || tmpBondAtomIndices != bondAtomIndices) {
+		clearTopologyDependentProperties();
+		clearChemistryDependentProperties();
+
+		for (MolecularGraph::AtomIterator it = molGraph->getAtomsBegin(), end = molGraph->getAtomsEnd(); it != end; ++it)
+			clearHybridizationState(*it);
+
+		changed = true;
+
+	} else {
+		std::size_t num_atoms = atomStates.size();
+		std::size_t num_bonds = bondOrders.size();
+
+		changedAtomMask.resize(num_atoms);
+		changedAtomMask.reset();
+
+		for (std::size_t i = 0; i < num_atoms; i++)
+			if (tmpAtomStates[i] != atomStates[i])
+				changedAtomMask.set(i);
+
+		for (std::size_t i = 0; i < num_bonds; i++) {
+			if (tmpBondOrders[i] != bondOrders[i]) {
+				changedAtomMask.set(bondAtomIndices[i * 2]);
+				changedAtomMask.set(bondAtomIndices[i * 2 + 1]);
+			}
+		}
+
+		if (changedAtomMask.any()) {
+			clearChemistryDependentProperties();
+
+			for (Util::BitSet::size_type i = changedAtomMask.find_first(); i != Util::BitSet::npos; i = changedAtomMask.find_next(i)) {
+				Atom& atom = molGraph->getAtom(i);
+
+				clearHybridizationState(atom);
+
+				for (Atom::AtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it)
+					if (molGraph->containsAtom(*a_it))
+						clearHybridizationState(*a_it);
+			}
+
+			changed = true;
+		}
+	}
+
+	bondAtomIndices.swap(tmpBondAtomIndices);
+	atomStates.swap(tmpAtomStates);
+	bondOrders.swap(tmpBondOrders);
+
+	return changed;
+}
+
+void Chem::PerceptionContext::clear()
+{
+	molGraph = 0;
+
+	bondAtomIndices.clear();
+	atomStates.clear();
+	bondOrders.clear();
+}
+
+const Chem::FragmentList::SharedPointer& Chem::PerceptionContext::perceiveComponents()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (!hasComponents(molgraph)) {
+		FragmentList::SharedPointer comps_ptr(new FragmentList());
+
+		componentPerceptor.perceive(molgraph);
+		comps_ptr->swap(componentPerceptor);
+
+		setComponents(molgraph, comps_ptr);
+	}
+
+	return getComponents(molgraph);
+}
+
+const Chem::FragmentList::SharedPointer& Chem::PerceptionContext::perceiveSSSR()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (!hasSSSR(molgraph)) {
+		FragmentList::SharedPointer sssr_ptr(new FragmentList());
+
+		sssrPerceptor.perceive(molgraph);
+		sssr_ptr->swap(sssrPerceptor);
+
+		setSSSR(molgraph, sssr_ptr);
+	}
+
+	return getSSSR(molgraph);
+}
+
+void Chem::PerceptionContext::setRingFlags()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (allAtomsHaveProperty(molgraph, &hasRingFlag) && allBondsHaveProperty(molgraph, &hasRingFlag))
+		return;
+
+	const FragmentList& sssr = *perceiveSSSR();
+	Fragment::SharedPointer cyclic_substruct(new Fragment());
+
+	for (FragmentList::ConstElementIterator it = sssr.getElementsBegin(), end = sssr.getElementsEnd(); it != end; ++it) {
+		const Fragment& ring = *it;
+
+		for (Fragment::ConstBondIterator b_it = ring.getBondsBegin(), b_end = ring.getBondsEnd(); b_it != b_end; ++b_it) {
+			const Bond& bond = *b_it;
+
+			cyclic_substruct->addAtom(bond.getBegin());
+			cyclic_substruct->addAtom(bond.getEnd());
+			cyclic_substruct->addBond(bond);
+		}
+	}
+
+	setCyclicSubstructure(molgraph, cyclic_substruct);
+
+	for (MolecularGraph::AtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it) {
+		Atom& atom = *it;
+
+		setRingFlag(atom, cyclic_substruct->containsAtom(atom));
+	}
+
+	for (MolecularGraph::BondIterator it = molgraph.getBondsBegin(), end = molgraph.getBondsEnd(); it != end; ++it) {
+		Bond& bond = *it;
+
+		setRingFlag(bond, cyclic_substruct->containsBond(bond));
+	}
+}
+
+void Chem::PerceptionContext::perceiveHybridizationStates()
+{
+	Chem::perceiveHybridizationStates(getMolGraph(), false);
+}
+
+void Chem::PerceptionContext::setAromaticityFlags()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (allAtomsHaveProperty(molgraph, &hasAromaticityFlag) && allBondsHaveProperty(molgraph, &hasAromaticityFlag))
+		return;
+
+	perceiveSSSR();
+
+	Fragment::SharedPointer arom_substruct(new Fragment());
+
+	aromSubstructPerceptor.perceive(molgraph);
+	arom_substruct->swap(aromSubstructPerceptor);
+
+	setAromaticSubstructure(molgraph, arom_substruct);
+
+	for (MolecularGraph::AtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it) {
+		Atom& atom = *it;
+
+		setAromaticityFlag(atom, arom_substruct->containsAtom(atom));
+	}
+
+	for (MolecularGraph::BondIterator it = molgraph.getBondsBegin(), end = molgraph.getBondsEnd(); it != end; ++it) {
+		Bond& bond = *it;
+
+		setAromaticityFlag(bond, arom_substruct->containsBond(bond));
+	}
+}
+
+void Chem::PerceptionContext::calcCIPPriorities()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (allAtomsHaveProperty(molgraph, &hasCIPPriority))
+		return;
+
+	cipPriorityCalculator.calculate(molgraph, atomNumbering);
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+
+	for (std::size_t i = 0; i < num_atoms; i++) 
+		setCIPPriority(molgraph.getAtom(i), atomNumbering[i]);
+}
+
+void Chem::PerceptionContext::generateMorganNumbering()
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (allAtomsHaveProperty(molgraph, &hasMorganNumber))
+		return;
+
+	morganNumberingGenerator.generate(molgraph, atomNumbering);
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+
+	for (std::size_t i = 0; i < num_atoms; i++) 
+		setMorganNumber(molgraph.getAtom(i), atomNumbering[i]);
+}
+
+void Chem::PerceptionContext::generateCanonicalNumbering(unsigned int atom_flags, unsigned int bond_flags)
+{
+	MolecularGraph& molgraph = getMolGraph();
+
+	if (allAtomsHaveProperty(molgraph, &hasCanonicalNumber))
+		return;
+
+	if (atom_flags == AtomPropertyFlag::DEFAULT)
+		atom_flags = CanonicalNumberingGenerator::DEF_ATOM_PROPERTY_FLAGS;
+
+	if (bond_flags == BondPropertyFlag::DEFAULT)
+		bond_flags = CanonicalNumberingGenerator::DEF_BOND_PROPERTY_FLAGS;
+
+	canonNumberingGenerator.setAtomPropertyFlags(atom_flags);
+	canonNumberingGenerator.setBondPropertyFlags(bond_flags);
+	canonNumberingGenerator.generate(molgraph, atomNumbering);
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+
+	for (std::size_t i = 0; i < num_atoms; i++) 
+		setCanonicalNumber(molgraph.getAtom(i), atomNumbering[i]);
+}
+
+void Chem::PerceptionContext::perceiveAll()
+{
+	perceiveComponents();
+	setRingFlags();
+	perceiveHybridizationStates();
+	setAromaticityFlags();
+}
+
+Chem::MolecularGraph& Chem::PerceptionContext::getMolGraph() const
+{
+	if (!molGraph)
+		throw Base::NullPointerException("PerceptionContext: no molecular graph bound");
+
+	return *molGraph;
+}
+
+void Chem::PerceptionContext::recordState(IndexArray& bond_atoms, AtomStateArray& atom_states, IndexArray& bond_orders) const
+{
+	bond_atoms.clear();
+	atom_states.clear();
+	bond_orders.clear();
+
+	if (!molGraph)
+		return;
+
+	for (MolecularGraph::ConstAtomIterator it = molGraph->getAtomsBegin(), end = molGraph->getAtomsEnd(); it != end; ++it) {
+		const Atom& atom = *it;
+		AtomState state;
+
+		state.type = getType(atom);
+		state.charge = getFormalCharge(atom);
+		state.isotope = getIsotope(atom);
+		state.implHCount = (hasImplicitHydrogenCount(atom) ? getImplicitHydrogenCount(atom) : UNDEF_IMPL_H_COUNT);
+
+		atom_states.push_back(state);
+	}
+
+	for (MolecularGraph::ConstBondIterator it = molGraph->getBondsBegin(), end = molGraph->getBondsEnd(); it != end; ++it) {
+		const Bond& bond = *it;
+
+		bond_atoms.push_back(molGraph->getAtomIndex(bond.getBegin()));
+		bond_atoms.push_back(molGraph->getAtomIndex(bond.getEnd()));
+		bond_orders.push_back(getOrder(bond));
+	}
+}
+
+void Chem::PerceptionContext::clearTopologyDependentProperties()
+{
+	clearComponents(*molGraph);
+	clearSSSR(*molGraph);
+	clearRings(*molGraph);
+	clearCyclicSubstructure(*molGraph);
+	clearTopologicalDistanceMatrix(*molGraph);
+
+	for (MolecularGraph::AtomIterator it = molGraph->getAtomsBegin(), end = molGraph->getAtomsEnd(); it != end; ++it)
+		clearRingFlag(*it);
+
+	for (MolecularGraph::BondIterator it = molGraph->getBondsBegin(), end = molGraph->getBondsEnd(); it != end; ++it)
+		clearRingFlag(*it);
+}
+
+void Chem::PerceptionContext::clearChemistryDependentProperties()
+{
+	clearAromaticSubstructure(*molGraph);
+	clearHashCode(*molGraph);
+
+	for (MolecularGraph::AtomIterator it = molGraph->getAtomsBegin(), end = molGraph->getAtomsEnd(); it != end; ++it) {
+		Atom& atom = *it;
+
+		clearAromaticityFlag(atom);
+		clearCIPPriority(atom);
+		clearCIPConfiguration(atom);
+		clearMorganNumber(atom);
+		clearCanonicalNumber(atom);
+		clearSymmetryClass(atom);
+	}
+
+	for (MolecularGraph::BondIterator it = molGraph->getBondsBegin(), end = molGraph->getBondsEnd(); it != end; ++it) {
+		Bond& bond = *it;
+
+		clearAromaticityFlag(bond);
+		clearCIPConfiguration(bond);
+	}
+}
@@ -0,0 +1,386 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SMILESBulkProcessor.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include <istream>
+#include <ostream>
+#include <algorithm>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "CDPL/Chem/SMILESBulkProcessor.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/PerceptionContext.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "SMILESDataReader.hpp"
+#include "SMILESDataWriter.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t DEF_CHUNK_SIZE = 256;
+	const std::size_t DEF_BLOCK_SIZE = 16 * 1024 * 1024;
+
+	bool isBlankLine(const char* beg, const char* end)
+	{
+		for ( ; beg != end; ++beg)
+			if (*beg != ' ' && *beg != '\t' && *beg != '\r' && *beg != '\v' && *beg != '\f')
+				return false;
+
+		return true;
+	}
+}
+
+
+struct Chem::SMILESBulkProcessor::ProcessingContext
+{
+
+	ProcessingContext(const Base::DataIOBase& io_base):
+		reader(io_base), writer(io_base), numWritten(0) {}
+
+	SMILESDataReader  reader;
+	SMILESDataWriter  writer;
+	BasicMolecule     molecule;
+	PerceptionContext perceptionContext;
+	std::size_t       numWritten;
+	RecordErrorList   errors;
+};
+
+
+Chem::SMILESBulkProcessor::SMILESBulkProcessor():
+	numFailedRecords(0), numThreads(1), chunkSize(DEF_CHUNK_SIZE), blockSize(DEF_BLOCK_SIZE), prepMolecules(true)
+{}
+
+Chem::SMILESBulkProcessor::~SMILESBulkProcessor() {}
+
+void Chem::SMILESBulkProcessor::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t Chem::SMILESBulkProcessor::getNumThreads() const
+{
+	return numThreads;
+}
+
+void Chem::SMILESBulkProcessor::setChunkSize(std::size_t num_records)
+{
+	chunkSize = std::max(num_records, std::size_t(1));
+}
+
+std::size_t Chem::SMILESBulkProcessor::getChunkSize() const
+{
+	return chunkSize;
+}
+
+void Chem::SMILESBulkProcessor::setBlockSize(std::size_t num_bytes)
+{
+	blockSize = std::max(num_bytes, std::size_t(1));
+}
+
+std::size_t Chem::SMILESBulkProcessor::getBlockSize() const
+{
+	return blockSize;
+}
+
+void Chem::SMILESBulkProcessor::prepareMolecules(bool prepare)
+{
+	prepMolecules = prepare;
+}
+
+bool Chem::SMILESBulkProcessor::moleculesPrepared() const
+{
+	return prepMolecules;
+}
+
+void Chem::SMILESBulkProcessor::setProcessingFunction(const ProcessingFunction& func)
+{
+	procFunction = func;
+}
+
+const Chem::SMILESBulkProcessor::ProcessingFunction& Chem::SMILESBulkProcessor::getProcessingFunction() const
+{
+	return procFunction;
+}
+
+void Chem::SMILESBulkProcessor::setErrorFunction(const ErrorFunction& func)
+{
+	errorFunction = func;
+}
+
+const Chem::SMILESBulkProcessor::ErrorFunction& Chem::SMILESBulkProcessor::getErrorFunction() const
+{
+	return errorFunction;
+}
+
+std::size_t Chem::SMILESBulkProcessor::getNumFailedRecords() const
+{
+	return numFailedRecords;
+}
+
+bool Chem::SMILESBulkProcessor::parseMolecule(const char* rec_beg, const char* rec_end, Molecule& mol)
+{
+	mol.clear();
+
+	return getContext(0).reader.readMolecule(rec_beg, rec_end, mol);
+}
+
+bool Chem::SMILESBulkProcessor::parseMolecule(const std::string& rec, Molecule& mol)
+{
+	return parseMolecule(rec.data(), rec.data() + rec.size(), mol);
+}
+
+bool Chem::SMILESBulkProcessor::generateSMILES(const MolecularGraph& molgraph, std::string& buffer)
+{
+	return getContext(0).writer.writeMolGraph(buffer, molgraph);
+}
+
+std::size_t Chem::SMILESBulkProcessor::process(const char* beg, const char* end, std::string& output)
+{
+	numFailedRecords = 0;
+
+	return processRecords(beg, end, output, 0);
+}
+
+std::size_t Chem::SMILESBulkProcessor::process(const std::string& input, std::string& output)
+{
+	numFailedRecords = 0;
+
+	return processRecords(input.data(), input.data() + input.size(), output, 0);
+}
+
+std::size_t Chem::SMILESBulkProcessor::process(std::istream& is, std::ostream& os)
+{
+	std::vector<char> block;
+	std::string output;
+	std::size_t num_written = 0;
+	std::size_t rec_idx_offs = 0;
+	std::size_t carry_size = 0;
+	char rec_sep = getInputRecordSeparator();
+
+	numFailedRecords = 0;
+
+	while (true) {
+		block.resize(carry_size + blockSize);
+
+		is.read(&block[carry_size], std::streamsize(blockSize));
+
+		std::size_t block_size = carry_size + std::size_t(is.gcount());
+		bool at_end = !is;
+
+		if (is.bad())
+			throw Base::IOError("SMILESBulkProcessor: reading input data failed");
+
+		const char* block_beg = &block[0];
+		const char* block_end = block_beg + block_size;
+		const char* proc_end = block_end;
+
+		if (!at_end) {
+			std::vector<char>::const_reverse_iterator last_nl = std::find(block.rbegin() + (block.size() - block_size), block.rend(), rec_sep);
+
+			if (last_nl != block.rend())
+				proc_end = &*last_nl + 1;
+			else
+				proc_end = block_beg;
+		}
+
+		output.clear();
+
+		num_written += processRecords(block_beg, proc_end, output, rec_idx_offs);
+		rec_idx_offs += records.size();
+
+		if (!output.empty() && !os.write(output.data(), std::streamsize(output.size())))
+			throw Base::IOError("SMILESBulkProcessor: writing output data failed");
+
+		if (at_end)
+			break;
+
+		carry_size = block_end - proc_end;
+
+		std::copy(proc_end, block_end, block.begin());
+	}
+
+	return num_written;
+}
+
+std::size_t Chem::SMILESBulkProcessor::processRecords(const char* beg, const char* end, std::string& output, std::size_t rec_idx_offs)
+{
+	char rec_sep = getInputRecordSeparator();
+
+	records.clear();
+
+	for (const char* line_beg = beg; line_beg != end; ) {
+		const char* line_end = std::find(line_beg, end, rec_sep);
+
+		if (!isBlankLine(line_beg, line_end))
+			records.push_back(Record(line_beg, line_end));
+
+		line_beg = (line_end == end ? end : line_end + 1);
+	}
+
+	if (records.empty())
+		return 0;
+
+	std::size_t num_chunks = (records.size() + chunkSize - 1) / chunkSize;
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	num_threads = std::max(std::min(num_threads, num_chunks), std::size_t(1));
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		ProcessingContext& ctxt = getContext(i);
+
+		ctxt.numWritten = 0;
+		ctxt.errors.clear();
+	}
+
+	recordSeparator = getRecordSeparatorParameter(*this);
+
+	if (outputBuffers.size() < num_chunks)
+		outputBuffers.resize(num_chunks);
+
+	boost::atomic<std::size_t> next_chunk(0);
+
+	if (num_threads == 1)
+		processChunks(next_chunk, rec_idx_offs, *contexts.front());
+
+	else {
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 1; i < num_threads; i++)
+			thread_grp.create_thread(boost::bind(&SMILESBulkProcessor::processChunks, this, boost::ref(next_chunk),
+												 rec_idx_offs, boost::ref(*contexts[i])));
+
+		processChunks(next_chunk, rec_idx_offs, *contexts.front());
+
+		thread_grp.join_all();
+	}
+
+	std::size_t num_written = 0;
+
+	recordErrors.clear();
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		ProcessingContext& ctxt = *contexts[i];
+
+		recordErrors.insert(recordErrors.end(), ctxt.errors.begin(), ctxt.errors.end());
+		num_written += ctxt.numWritten;
+	}
+
+	numFailedRecords += recordErrors.size();
+
+	if (errorFunction && !recordErrors.empty()) {
+		std::sort(recordErrors.begin(), recordErrors.end());
+
+		for (RecordErrorList::const_iterator it = recordErrors.begin(), end = recordErrors.end(); it != end; ++it)
+			errorFunction(it->first, it->second);
+	}
+
+	std::size_t output_size = output.size();
+
+	for (std::size_t i = 0; i < num_chunks; i++)
+		output_size += outputBuffers[i].size();
+
+	output.reserve(output_size);
+
+	for (std::size_t i = 0; i < num_chunks; i++)
+		output.append(outputBuffers[i]);
+
+	return num_written;
+}
+
+void Chem::SMILESBulkProcessor::processChunks(boost::atomic<std::size_t>& next_chunk, std::size_t rec_idx_offs, ProcessingContext& ctxt)
+{
+	std::size_t num_records = records.size();
+	std::size_t num_chunks = (num_records + chunkSize - 1) / chunkSize;
+	Molecule& mol = ctxt.molecule;
+
+	for (std::size_t i = next_chunk++; i < num_chunks; i = next_chunk++) {
+		std::string& chunk_output = outputBuffers[i];
+		std::size_t chunk_end = std::min(num_records, (i + 1) * chunkSize);
+
+		chunk_output.clear();
+
+		for (std::size_t rec_idx = i * chunkSize; rec_idx < chunk_end; rec_idx++) {
+			const Record& rec = records[rec_idx];
+			std::size_t output_size = chunk_output.size();
+
+			try {
+				mol.clear();
+
+				if (!ctxt.reader.readMolecule(rec.first, rec.second, mol))
+					throw Base::IOError("no SMILES string found");
+
+				if (prepMolecules) {
+					calcImplicitHydrogenCounts(mol, false);
+
+					ctxt.perceptionContext.setMolecularGraph(mol);
+					ctxt.perceptionContext.perceiveAll();
+				}
+
+				if (procFunction && !procFunction(mol, rec_idx_offs + rec_idx))
+					continue;
+
+				if (!ctxt.writer.writeMolGraph(chunk_output, mol))
+					throw Base::IOError("writing SMILES string failed");
+
+				chunk_output.append(recordSeparator);
+				ctxt.numWritten++;
+
+			} catch (const std::exception& e) {
+				chunk_output.resize(output_size);
+				ctxt.errors.push_back(RecordError(rec_idx_offs + rec_idx, 
+												  "SMILESBulkProcessor: error while processing record " + 
+												  boost::lexical_cast<std::string>(rec_idx_offs + rec_idx) + ": " + e.what()));
+			}
+		}
+	}
+}
+
+char Chem::SMILESBulkProcessor::getInputRecordSeparator() const
+{
+	const std::string& rec_sep = getRecordSeparatorParameter(*this);
+
+	return (rec_sep.size() == 1 ? rec_sep[0] : '\n');
+}
+
+Chem::SMILESBulkProcessor::ProcessingContext& Chem::SMILESBulkProcessor::getContext(std::size_t idx)
+{
+	while (contexts.size() <= idx)
+		contexts.push_back(ProcessingContextPtr(new ProcessingContext(*this)));
+
+	return *contexts[idx];
+}
@@ -67,6 +67,22 @@ namespace
 {
 
 	const Chem::SMILESDataReader::STArray NO_BONDS;
+
+	struct IsWhitespace
+	{
+
+		bool operator()(char c) const {
+			return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f');
+		}
+	};
+
+	struct IsNonWhitespace
+	{
+
+		bool operator()(char c) const {
+			return !IsWhitespace()(c);
+		}
+	};
 }
 
 
@@ -205,6 +221,39 @@ bool Chem::SMILESDataReader::readMolecule(std::istream& is, Molecule& mol)
 	return true;
 }
 
+bool Chem::SMILESDataReader::readMolecule(const char* rec_beg, const char* rec_end, Molecule& mol)
+{
+	const char* smi_beg = std::find_if(rec_beg, rec_end, IsNonWhitespace());
+
+	if (smi_beg == rec_end)
+		return false;
+
+	const char* smi_end = std::find_if(smi_beg, rec_end, IsWhitespace());
+
+	getParameters();
+
+	atomMappingIDOffset = getMaxAtomMappingID(mol);
+	molSMILESString.assign(smi_beg, smi_end);
+
+	init(mol);
+
+	parseSMILES(mol, 0);
+
+	kekulizeBonds(mol);
+	setAtomStereoDescriptors(mol);
+	setBondStereoDescriptors(mol);
+
+	if (recordFormat == "SN") {
+		molSMILESString.assign(smi_end, rec_end);
+
+		Internal::trimString(molSMILESString);
+
+		setName(mol, molSMILESString);
+	}
+
+	return true;
+}
+
 bool Chem::SMILESDataReader::skipMolecule(std::istream& is)
 {
 	if (!hasMoreData(is))
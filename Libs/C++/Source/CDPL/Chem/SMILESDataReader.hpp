@@ -61,6 +61,7 @@ namespace CDPL
 
 			bool readReaction(std::istream&, Reaction&);
 			bool readMolecule(std::istream&, Molecule&);
+			bool readMolecule(const char*, const char*, Molecule&);
 
 			bool skipReaction(std::istream&);
 			bool skipMolecule(std::istream&);
@@ -121,6 +121,19 @@ bool Chem::SMILESDataWriter::writeMolGraph(std::ostream& os, const MolecularGrap
 	return os.good();
 }
 
+bool Chem::SMILESDataWriter::writeMolGraph(std::string& buf, const MolecularGraph& molgraph)
+{
+	recordStream.clear();
+	recordStream.str(std::string());
+
+	if (!writeMolGraph(recordStream, molgraph))
+		return false;
+
+	buf.append(recordStream.str());
+
+	return true;
+}
+
 template <typename T>
 void Chem::SMILESDataWriter::writeName(std::ostream& os, const T& obj) const
 {
@@ -369,7 +382,6 @@ void Chem::SMILESDataWriter::generateCanonComponentSMILES(const MolecularGraph&
 	canonNumberingGenerator->setAtomPropertyFlags(atom_prop_flags);
 	canonNumberingGenerator->setBondPropertyFlags(bond_prop_flags);
 
-	std::ostringstream oss;
 	FragmentList& components = *getComponents(molgraph);
 	FragmentList::ElementIterator comps_end = components.getElementsEnd();
 
@@ -398,11 +410,11 @@ void Chem::SMILESDataWriter::generateCanonComponentSMILES(const MolecularGraph&
 
 		buildCanonDFSTree(*canonMolGraph);
 		distRingClosureNumbers();
-		generateSMILES(oss);
+		generateSMILES(componentStream);
 
-		canonSMILESStrings.push_back(oss.str());
+		canonSMILESStrings.push_back(componentStream.str());
 
-		oss.str(std::string());
+		componentStream.str(std::string());
 	}
 }
 
@@ -28,6 +28,7 @@
 #define CDPL_CHEM_SMILESDATAWRITER_HPP
 
 #include <iosfwd>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <functional>
@@ -70,6 +71,7 @@ namespace CDPL
 
 			bool writeReaction(std::ostream&, const Reaction&);
 			bool writeMolGraph(std::ostream&, const MolecularGraph&);
+			bool writeMolGraph(std::string&, const MolecularGraph&);
 
 		private:
 			class DFSTreeNode;
@@ -264,6 +266,8 @@ namespace CDPL
 			CtrlParameters              ctrlParameters;
 			RingClosureNumberStack      ringClosureNumberStack;
 			std::size_t                 highestRingClosureNumber;
+			std::ostringstream          componentStream;
+			std::ostringstream          recordStream;
 		};
 	}
 }
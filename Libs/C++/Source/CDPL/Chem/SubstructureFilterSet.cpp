@@ -0,0 +1,346 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * SubstructureFilterSet.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Chem/SubstructureFilterSet.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "SubstructureScreeningUtilities.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t HEAVY_ATOM_FEATURE    = Chem::AtomType::MAX_ATOMIC_NO + 1;
+	const std::size_t AROMATIC_ATOM_FEATURE = Chem::AtomType::MAX_ATOMIC_NO + 2;
+	const std::size_t RING_ATOM_FEATURE     = Chem::AtomType::MAX_ATOMIC_NO + 3;
+	const std::size_t ATOM_COUNT_FEATURE    = Chem::AtomType::MAX_ATOMIC_NO + 4;
+	const std::size_t BOND_COUNT_FEATURE    = Chem::AtomType::MAX_ATOMIC_NO + 5;
+	const std::size_t NUM_FEATURES          = Chem::AtomType::MAX_ATOMIC_NO + 6;
+}
+
+
+Chem::SubstructureFilterSet::SubstructureFilterSet():
+	initTargets(true), numThreads(1)
+{}
+
+Chem::SubstructureFilterSet::~SubstructureFilterSet() {}
+
+void Chem::SubstructureFilterSet::addPattern(const MolecularGraph::SharedPointer& pattern)
+{
+	PatternDataPtr ptn_data(new PatternData());
+
+	ptn_data->pattern = pattern;
+
+	initPatternData(*ptn_data);
+
+	patterns.push_back(ptn_data);
+	searchContexts.clear();
+}
+
+const Chem::MolecularGraph::SharedPointer& Chem::SubstructureFilterSet::getPattern(std::size_t idx) const
+{
+	if (idx >= patterns.size())
+		throw Base::IndexError("SubstructureFilterSet: pattern index out of bounds");
+
+	return patterns[idx]->pattern;
+}
+
+void Chem::SubstructureFilterSet::removePattern(std::size_t idx)
+{
+	if (idx >= patterns.size())
+		throw Base::IndexError("SubstructureFilterSet: pattern index out of bounds");
+
+	patterns.erase(patterns.begin() + idx);
+	searchContexts.clear();
+}
+
+void Chem::SubstructureFilterSet::clear()
+{
+	patterns.clear();
+	searchContexts.clear();
+}
+
+std::size_t Chem::SubstructureFilterSet::getNumPatterns() const
+{
+	return patterns.size();
+}
+
+void Chem::SubstructureFilterSet::initializeTargets(bool init)
+{
+	initTargets = init;
+}
+
+bool Chem::SubstructureFilterSet::targetsInitialized() const
+{
+	return initTargets;
+}
+
+void Chem::SubstructureFilterSet::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t Chem::SubstructureFilterSet::getNumThreads() const
+{
+	return numThreads;
+}
+
+std::size_t Chem::SubstructureFilterSet::filter(MolecularGraph& molgraph, Util::BitSet& hit_mask)
+{
+	if (searchContexts.empty()) {
+		searchContexts.push_back(SearchContextPtr(new SearchContext()));
+
+		initSearchContext(*searchContexts.back());
+	}
+
+	return doFilter(molgraph, hit_mask, *searchContexts.front());
+}
+
+void Chem::SubstructureFilterSet::filter(const MolecularGraphList& molgraphs, HitMaskList& hit_masks)
+{
+	hit_masks.resize(molgraphs.size());
+
+	if (molgraphs.empty())
+		return;
+
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	num_threads = std::max(std::min(num_threads, molgraphs.size()), std::size_t(1));
+
+	while (searchContexts.size() < num_threads) {
+		searchContexts.push_back(SearchContextPtr(new SearchContext()));
+
+		initSearchContext(*searchContexts.back());
+	}
+
+	boost::atomic<std::size_t> next_idx(0);
+
+	if (num_threads == 1) {
+		processMolGraphs(molgraphs, hit_masks, next_idx, *searchContexts.front());
+		return;
+	}
+
+	boost::thread_group thread_grp;
+
+	for (std::size_t i = 1; i < num_threads; i++)
+		thread_grp.create_thread(boost::bind(&SubstructureFilterSet::processMolGraphs, this, boost::cref(molgraphs), boost::ref(hit_masks),
+											 boost::ref(next_idx), boost::ref(*searchContexts[i])));
+
+	processMolGraphs(molgraphs, hit_masks, next_idx, *searchContexts.front());
+
+	thread_grp.join_all();
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		SearchContext& ctxt = *searchContexts[i];
+
+		if (!ctxt.errorMessage.empty()) {
+			std::string err_msg;
+
+			err_msg.swap(ctxt.errorMessage);
+
+			throw Base::CalculationFailed("SubstructureFilterSet: " + err_msg);
+		}
+	}
+}
+
+void Chem::SubstructureFilterSet::processMolGraphs(const MolecularGraphList& molgraphs, HitMaskList& hit_masks,
+												   boost::atomic<std::size_t>& next_idx, SearchContext& ctxt) const
+{
+	try {
+		for (std::size_t i = next_idx++; i < molgraphs.size(); i = next_idx++)
+			doFilter(*molgraphs[i], hit_masks[i], ctxt);
+
+	} catch (const std::exception& e) {
+		ctxt.errorMessage = e.what();
+		next_idx = molgraphs.size();
+
+		if (ctxt.errorMessage.empty())
+			ctxt.errorMessage = "unspecified error";
+	}
+}
+
+std::size_t Chem::SubstructureFilterSet::doFilter(MolecularGraph& molgraph, Util::BitSet& hit_mask, SearchContext& ctxt) const
+{
+	std::size_t num_patterns = patterns.size();
+
+	hit_mask.resize(num_patterns);
+	hit_mask.reset();
+
+	if (num_patterns == 0)
+		return 0;
+
+	if (initTargets)
+		initSubstructureSearchTarget(molgraph, false);
+
+	calcTargetFeatures(molgraph, ctxt);
+
+	std::size_t num_hits = 0;
+
+	for (std::size_t i = 0; i < num_patterns; i++) {
+		if (!passesScreen(*patterns[i], ctxt))
+			continue;
+
+		if (ctxt.substructSearches[i]->mappingExists(molgraph)) {
+			hit_mask.set(i);
+			num_hits++;
+		}
+	}
+
+	return num_hits;
+}
+
+void Chem::SubstructureFilterSet::initPatternData(PatternData& ptn_data) const
+{
+	const MolecularGraph& ptn = *ptn_data.pattern;
+	FeatureCountArray counts(NUM_FEATURES, 0);
+
+	MolecularGraph::ConstAtomIterator atoms_end = ptn.getAtomsEnd();
+
+	for (MolecularGraph::ConstAtomIterator it = ptn.getAtomsBegin(); it != atoms_end; ++it) {
+		const Atom& atom = *it;
+		QueryAtomRequirements reqs;
+
+		getQueryAtomRequirements(atom, reqs);
+
+		if (reqs.type != AtomType::UNKNOWN)
+			counts[reqs.type]++;
+
+		if (reqs.heavy)
+			counts[HEAVY_ATOM_FEATURE]++;
+
+		if (reqs.aromatic)
+			counts[AROMATIC_ATOM_FEATURE]++;
+
+		if (reqs.ring)
+			counts[RING_ATOM_FEATURE]++;
+	}
+
+	counts[ATOM_COUNT_FEATURE] = ptn.getNumAtoms();
+	counts[BOND_COUNT_FEATURE] = getNumContainedBonds(ptn);
+
+	ptn_data.featureMask.resize(NUM_FEATURES);
+	ptn_data.featureMask.reset();
+	ptn_data.minFeatureCounts.clear();
+
+	for (std::size_t i = 0; i < NUM_FEATURES; i++) {
+		if (counts[i] == 0)
+			continue;
+
+		ptn_data.featureMask.set(i);
+		ptn_data.minFeatureCounts.push_back(FeatureCount(i, counts[i]));
+	}
+}
+
+void Chem::SubstructureFilterSet::initSearchContext(SearchContext& ctxt) const
+{
+	ctxt.substructSearches.clear();
+	ctxt.substructSearches.reserve(patterns.size());
+
+	for (PatternDataList::const_iterator it = patterns.begin(), end = patterns.end(); it != end; ++it)
+		ctxt.substructSearches.push_back(SubstructureSearch::SharedPointer(new SubstructureSearch(*(*it)->pattern)));
+
+	ctxt.featureCounts.resize(NUM_FEATURES);
+	ctxt.featureMask.resize(NUM_FEATURES);
+}
+
+void Chem::SubstructureFilterSet::calcTargetFeatures(const MolecularGraph& molgraph, SearchContext& ctxt) const
+{
+	FeatureCountArray& counts = ctxt.featureCounts;
+
+	std::fill(counts.begin(), counts.end(), 0);
+
+	bool arom_flags_avail = true;
+	bool ring_flags_avail = true;
+
+	MolecularGraph::ConstAtomIterator atoms_end = molgraph.getAtomsEnd();
+
+	for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(); it != atoms_end; ++it) {
+		const Atom& atom = *it;
+		unsigned int type = getType(atom);
+
+		if (type != AtomType::H)
+			counts[HEAVY_ATOM_FEATURE]++;
+
+		if (type <= AtomType::MAX_ATOMIC_NO)
+			counts[type]++;
+
+		if (!hasAromaticityFlag(atom))
+			arom_flags_avail = false;
+
+		else if (getAromaticityFlag(atom))
+			counts[AROMATIC_ATOM_FEATURE]++;
+
+		if (!hasRingFlag(atom))
+			ring_flags_avail = false;
+
+		else if (getRingFlag(atom))
+			counts[RING_ATOM_FEATURE]++;
+	}
+
+	// features that cannot be determined must not lead to the rejection of any pattern
+
+	if (!arom_flags_avail)
+		counts[AROMATIC_ATOM_FEATURE] = std::numeric_limits<std::size_t>::max();
+
+	if (!ring_flags_avail)
+		counts[RING_ATOM_FEATURE] = std::numeric_limits<std::size_t>::max();
+
+	counts[ATOM_COUNT_FEATURE] = molgraph.getNumAtoms();
+	counts[BOND_COUNT_FEATURE] = getNumContainedBonds(molgraph);
+
+	ctxt.featureMask.reset();
+
+	for (std::size_t i = 0; i < NUM_FEATURES; i++)
+		if (counts[i] > 0)
+			ctxt.featureMask.set(i);
+}
+
+bool Chem::SubstructureFilterSet::passesScreen(const PatternData& ptn_data, const SearchContext& ctxt) const
+{
+	if (!ptn_data.featureMask.is_subset_of(ctxt.featureMask))
+		return false;
+
+	for (FeatureCountList::const_iterator it = ptn_data.minFeatureCounts.begin(), end = ptn_data.minFeatureCounts.end(); it != end; ++it)
+		if (ctxt.featureCounts[it->first] < it->second)
+			return false;
+
+	return true;
+}
@@ -0,0 +1,252 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureScreeningFingerprintGenerator.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "CDPL/Chem/SubstructureScreeningFingerprintGenerator.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+
+#include "CDPL/Internal/RangeHashCode.hpp"
+
+#include "SubstructureScreeningUtilities.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t HEAVY_ATOM_FEATURE    = Chem::AtomType::MAX_ATOMIC_NO + 1;
+	const std::size_t AROMATIC_ATOM_FEATURE = Chem::AtomType::MAX_ATOMIC_NO + 2;
+	const std::size_t RING_ATOM_FEATURE     = Chem::AtomType::MAX_ATOMIC_NO + 3;
+	const std::size_t NUM_FEATURES          = Chem::AtomType::MAX_ATOMIC_NO + 4;
+
+	const std::size_t COUNT_THRESHOLDS[] = { 1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32 };
+
+	const std::size_t UNDEF_COUNT = std::numeric_limits<std::size_t>::max();
+}
+
+
+Chem::SubstructureScreeningFingerprintGenerator::SubstructureScreeningFingerprintGenerator():
+	maxPathLength(5), numBits(1024)
+{}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setMaxPathLength(std::size_t max_length)
+{
+	maxPathLength = max_length;
+}
+
+std::size_t Chem::SubstructureScreeningFingerprintGenerator::getMaxPathLength() const
+{
+	return maxPathLength;
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setNumBits(std::size_t num_bits)
+{
+	numBits = num_bits;
+}
+
+std::size_t Chem::SubstructureScreeningFingerprintGenerator::getNumBits() const
+{
+	return numBits;
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::generateTargetFingerprint(const MolecularGraph& molgraph, Util::BitSet& fp)
+{
+	init(molgraph, fp);
+
+	MolecularGraph::ConstAtomIterator atoms_end = molgraph.getAtomsEnd();
+	std::size_t i = 0;
+
+	for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(); it != atoms_end; ++it, i++) {
+		const Atom& atom = *it;
+		unsigned int type = getType(atom);
+
+		if (type <= AtomType::MAX_ATOMIC_NO) {
+			atomLabels[i] = type;
+			featureCounts[type]++;
+		}
+
+		// atoms of unknown or generic type might still be matched by generic query atoms
+
+		if (type != AtomType::H)
+			featureCounts[HEAVY_ATOM_FEATURE]++;
+
+		if (featureCounts[AROMATIC_ATOM_FEATURE] != UNDEF_COUNT) {
+			if (!hasAromaticityFlag(atom))
+				featureCounts[AROMATIC_ATOM_FEATURE] = UNDEF_COUNT;
+
+			else if (getAromaticityFlag(atom))
+				featureCounts[AROMATIC_ATOM_FEATURE]++;
+		}
+
+		if (featureCounts[RING_ATOM_FEATURE] != UNDEF_COUNT) {
+			if (!hasRingFlag(atom))
+				featureCounts[RING_ATOM_FEATURE] = UNDEF_COUNT;
+
+			else if (getRingFlag(atom))
+				featureCounts[RING_ATOM_FEATURE]++;
+		}
+	}
+
+	setCountBits(fp);
+	setPathBits(molgraph, fp);
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::generateQueryFingerprint(const MolecularGraph& query, Util::BitSet& fp)
+{
+	init(query, fp);
+
+	MolecularGraph::ConstAtomIterator atoms_end = query.getAtomsEnd();
+	std::size_t i = 0;
+
+	for (MolecularGraph::ConstAtomIterator it = query.getAtomsBegin(); it != atoms_end; ++it, i++) {
+		QueryAtomRequirements reqs;
+
+		getQueryAtomRequirements(*it, reqs);
+
+		if (reqs.type != AtomType::UNKNOWN) {
+			atomLabels[i] = reqs.type;
+			featureCounts[reqs.type]++;
+		}
+
+		if (reqs.heavy)
+			featureCounts[HEAVY_ATOM_FEATURE]++;
+
+		if (reqs.aromatic)
+			featureCounts[AROMATIC_ATOM_FEATURE]++;
+
+		if (reqs.ring)
+			featureCounts[RING_ATOM_FEATURE]++;
+	}
+
+	setCountBits(fp);
+	setPathBits(query, fp);
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::init(const MolecularGraph& molgraph, Util::BitSet& fp)
+{
+	fp.resize(numBits);
+	fp.reset();
+
+	atomLabels.assign(molgraph.getNumAtoms(), AtomType::UNKNOWN);
+	featureCounts.assign(NUM_FEATURES, 0);
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setCountBits(Util::BitSet& fp) const
+{
+	if (numBits == 0)
+		return;
+
+	std::size_t num_thresholds = sizeof(COUNT_THRESHOLDS) / sizeof(std::size_t);
+	Base::uint64 key[3] = { 0 };
+
+	for (std::size_t i = 0; i < NUM_FEATURES; i++) {
+		std::size_t count = featureCounts[i];
+
+		key[1] = i + 1;
+
+		for (std::size_t j = 0; j < num_thresholds && COUNT_THRESHOLDS[j] <= count; j++) {
+			key[2] = COUNT_THRESHOLDS[j];
+
+			fp.set(Internal::calcHashCode<Base::uint64>(key, key + 3) % numBits);
+		}
+	}
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setPathBits(const MolecularGraph& molgraph, Util::BitSet& fp)
+{
+	if (numBits == 0 || maxPathLength == 0)
+		return;
+
+	visAtomMask.assign(molgraph.getNumAtoms(), false);
+
+	MolecularGraph::ConstAtomIterator atoms_end = molgraph.getAtomsEnd();
+	std::size_t i = 0;
+
+	for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(); it != atoms_end; ++it, i++) {
+		if (atomLabels[i] == AtomType::UNKNOWN)
+			continue;
+
+		pathLabels.assign(1, atomLabels[i]);
+		visAtomMask[i] = true;
+
+		setPathBits(molgraph, *it, fp);
+
+		visAtomMask[i] = false;
+	}
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setPathBits(const MolecularGraph& molgraph, const Atom& atom, Util::BitSet& fp)
+{
+	if (pathLabels.size() > maxPathLength)
+		return;
+
+	Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+	for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it, ++b_it) {
+		const Atom& nbr_atom = *a_it;
+
+		if (!molgraph.containsBond(*b_it) || !molgraph.containsAtom(nbr_atom))
+			continue;
+
+		std::size_t nbr_idx = molgraph.getAtomIndex(nbr_atom);
+
+		if (visAtomMask[nbr_idx] || atomLabels[nbr_idx] == AtomType::UNKNOWN)
+			continue;
+
+		pathLabels.push_back(atomLabels[nbr_idx]);
+
+		setPathBit(fp);
+
+		visAtomMask[nbr_idx] = true;
+
+		setPathBits(molgraph, nbr_atom, fp);
+
+		visAtomMask[nbr_idx] = false;
+		pathLabels.pop_back();
+	}
+}
+
+void Chem::SubstructureScreeningFingerprintGenerator::setPathBit(Util::BitSet& fp)
+{
+	revPathLabels.assign(pathLabels.rbegin(), pathLabels.rend());
+
+	const LabelArray& labels = (std::lexicographical_compare(revPathLabels.begin(), revPathLabels.end(), 
+															 pathLabels.begin(), pathLabels.end()) ? revPathLabels : pathLabels);
+
+	fp.set(Internal::calcHashCode<Base::uint64>(labels.begin(), labels.end()) % numBits);
+}
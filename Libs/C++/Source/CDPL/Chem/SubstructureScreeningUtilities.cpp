@@ -0,0 +1,158 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureScreeningUtilities.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/AtomMatchConstraint.hpp"
+#include "CDPL/Chem/MatchConstraintList.hpp"
+
+#include "SubstructureScreeningUtilities.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	bool flagRequired(const Chem::MatchConstraint& constraint, bool atom_flag)
+	{
+		using namespace Chem;
+
+		bool value = (constraint.hasValue() ? constraint.getValue().toBool() : atom_flag);
+
+		switch (constraint.getRelation()) {
+
+			case MatchConstraint::EQUAL:
+				return value;
+
+			case MatchConstraint::NOT_EQUAL:
+				return !value;
+
+			default:
+				return false;
+		}
+	}
+
+	void getAtomRequirements(const Chem::Atom& atom, const Chem::MatchConstraintList& constr_list, Chem::QueryAtomRequirements& reqs)
+	{
+		using namespace Chem;
+
+		if (constr_list.getType() != MatchConstraintList::AND_LIST)
+			return;
+
+		MatchConstraintList::ConstElementIterator constr_end = constr_list.getElementsEnd();
+
+		for (MatchConstraintList::ConstElementIterator it = constr_list.getElementsBegin(); it != constr_end; ++it) {
+			const MatchConstraint& constraint = *it;
+
+			switch (constraint.getID()) {
+
+				case AtomMatchConstraint::CONSTRAINT_LIST:
+					if (constraint.getRelation() == MatchConstraint::EQUAL)
+						getAtomRequirements(atom, *constraint.getValue<MatchConstraintList::SharedPointer>(), reqs);
+
+					continue;
+
+				case AtomMatchConstraint::TYPE: {
+					if (constraint.getRelation() != MatchConstraint::EQUAL)
+						continue;
+
+					unsigned int type = (constraint.hasValue() ? constraint.getValue<unsigned int>() : getType(atom));
+
+					if (isHeavyAtomType(type))
+						reqs.heavy = true;
+
+					if (reqs.type == AtomType::UNKNOWN && type <= AtomType::MAX_ATOMIC_NO)
+						reqs.type = type;
+
+					continue;
+				}
+
+				case AtomMatchConstraint::AROMATICITY:
+					if (flagRequired(constraint, hasAromaticityFlag(atom) && getAromaticityFlag(atom)))
+						reqs.aromatic = true;
+
+					continue;
+
+				case AtomMatchConstraint::RING_TOPOLOGY:
+					if (flagRequired(constraint, hasRingFlag(atom) && getRingFlag(atom)))
+						reqs.ring = true;
+
+				default:
+					continue;
+			}
+		}
+	}
+}
+
+
+bool Chem::isHeavyAtomType(unsigned int type)
+{
+	switch (type) {
+
+		case AtomType::A:
+		case AtomType::Q:
+		case AtomType::M:
+		case AtomType::X:
+		case AtomType::HET:
+			return true;
+
+		case AtomType::UNKNOWN:
+		case AtomType::H:
+			return false;
+
+		default:
+			return (type <= AtomType::MAX_ATOMIC_NO);
+	}
+}
+
+void Chem::getQueryAtomRequirements(const Atom& atom, QueryAtomRequirements& reqs)
+{
+	reqs = QueryAtomRequirements();
+
+	getAtomRequirements(atom, *getMatchConstraints(atom), reqs);
+}
+
+std::size_t Chem::getNumContainedBonds(const MolecularGraph& molgraph)
+{
+	std::size_t count = 0;
+	MolecularGraph::ConstBondIterator bonds_end = molgraph.getBondsEnd();
+
+	for (MolecularGraph::ConstBondIterator it = molgraph.getBondsBegin(); it != bonds_end; ++it) {
+		const Bond& bond = *it;
+
+		if (molgraph.containsAtom(bond.getBegin()) && molgraph.containsAtom(bond.getEnd()))
+			count++;
+	}
+
+	return count;
+}
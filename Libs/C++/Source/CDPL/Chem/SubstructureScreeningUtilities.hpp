@@ -0,0 +1,68 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureScreeningUtilities.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESCREENINGUTILITIES_HPP
+#define CDPL_CHEM_SUBSTRUCTURESCREENINGUTILITIES_HPP
+
+#include <cstddef>
+
+#include "CDPL/Chem/AtomType.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class Atom;
+		class MolecularGraph;
+
+		struct QueryAtomRequirements
+		{
+
+			QueryAtomRequirements(): type(AtomType::UNKNOWN), heavy(false), aromatic(false), ring(false) {}
+
+			unsigned int type;
+			bool         heavy;
+			bool         aromatic;
+			bool         ring;
+		};
+
+		bool isHeavyAtomType(unsigned int type);
+
+		/*
+		 * Derives the properties that every target atom matched by the query atom must have.
+		 * Only constraints of AND-type constraint lists are considered, unknown requirements are left unset.
+		 */
+		void getQueryAtomRequirements(const Atom& atom, QueryAtomRequirements& reqs);
+
+		std::size_t getNumContainedBonds(const MolecularGraph& molgraph);
+	}
+}
+
+#endif // CDPL_CHEM_SUBSTRUCTURESCREENINGUTILITIES_HPP
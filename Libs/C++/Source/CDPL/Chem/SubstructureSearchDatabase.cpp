@@ -0,0 +1,107 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureSearchDatabase.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include "CDPL/Chem/SubstructureSearchDatabase.hpp"
+
+#include "SubstructureSearchDatabaseImpl.hpp"
+
+
+using namespace CDPL;
+
+
+Chem::SubstructureSearchDatabase::SubstructureSearchDatabase():
+	impl(new SubstructureSearchDatabaseImpl())
+{}
+
+Chem::SubstructureSearchDatabase::~SubstructureSearchDatabase() {}
+
+void Chem::SubstructureSearchDatabase::setNumThreads(std::size_t num_threads)
+{
+	impl->setNumThreads(num_threads);
+}
+
+std::size_t Chem::SubstructureSearchDatabase::getNumThreads() const
+{
+	return impl->getNumThreads();
+}
+
+std::size_t Chem::SubstructureSearchDatabase::getNumFingerprintBits() const
+{
+	return impl->getNumFingerprintBits();
+}
+
+std::size_t Chem::SubstructureSearchDatabase::getNumMolecules() const
+{
+	return impl->getNumMolecules();
+}
+
+std::size_t Chem::SubstructureSearchDatabase::addMolecule(const MolecularGraph& molgraph)
+{
+	return impl->addMolecule(molgraph);
+}
+
+void Chem::SubstructureSearchDatabase::getMolecule(std::size_t idx, Molecule& mol) const
+{
+	impl->getMolecule(idx, mol);
+}
+
+void Chem::SubstructureSearchDatabase::getFingerprint(std::size_t idx, Util::BitSet& fp) const
+{
+	impl->getFingerprint(idx, fp);
+}
+
+std::size_t Chem::SubstructureSearchDatabase::screen(const MolecularGraph& query, MoleculeIndexList& cands) const
+{
+	return impl->screen(query, cands);
+}
+
+std::size_t Chem::SubstructureSearchDatabase::findMatches(const MolecularGraph& query, MoleculeIndexList& hits, std::size_t max_num_hits) const
+{
+	return impl->findMatches(query, hits, max_num_hits);
+}
+
+void Chem::SubstructureSearchDatabase::clear()
+{
+	impl->clear();
+}
+
+void Chem::SubstructureSearchDatabase::save(const std::string& file_name) const
+{
+	impl->save(file_name);
+}
+
+void Chem::SubstructureSearchDatabase::open(const std::string& file_name)
+{
+	impl->open(file_name);
+}
+
+const std::string& Chem::SubstructureSearchDatabase::getFileName() const
+{
+	return impl->getFileName();
+}
@@ -0,0 +1,554 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureSearchDatabaseImpl.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "SubstructureSearchDatabaseImpl.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const Base::uint32 FORMAT_ID           = 0x42445353;
+	const Base::uint32 FORMAT_VERSION      = 1;
+	const std::size_t  HEADER_SIZE         = 32;
+	const std::size_t  FP_WORD_SIZE        = 64;
+	const std::size_t  PROC_CHUNK_SIZE     = 256;
+	const std::size_t  IO_CHUNK_SIZE       = 4096;
+	const std::size_t  DATA_COPY_CHUNK_SIZE = 1024 * 1024;
+
+	void convertFingerprint(const Util::BitSet& fp, Base::uint64* words, std::size_t num_words)
+	{
+		std::fill(words, words + num_words, Base::uint64(0));
+
+		for (Util::BitSet::size_type i = fp.find_first(); i != Util::BitSet::npos; i = fp.find_next(i))
+			words[i / FP_WORD_SIZE] |= Base::uint64(1) << (i % FP_WORD_SIZE);
+	}
+}
+
+
+Chem::SubstructureSearchDatabaseImpl::SubstructureSearchDatabaseImpl():
+	molWriter(controlParams), numThreads(1), molDataOffsets(1, 0), 
+	fileDataOffset(0), fileDataSize(0)
+{
+	setStrictErrorCheckingParameter(controlParams, true);
+	setCDFWriteSinglePrecisionFloatsParameter(controlParams, true);
+
+	numFPWords = (fpGenerator.getNumBits() + FP_WORD_SIZE - 1) / FP_WORD_SIZE;
+}
+
+void Chem::SubstructureSearchDatabaseImpl::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::getNumThreads() const
+{
+	return numThreads;
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::getNumFingerprintBits() const
+{
+	return fpGenerator.getNumBits();
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::getNumMolecules() const
+{
+	return (molDataOffsets.size() - 1);
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::addMolecule(const MolecularGraph& molgraph)
+{
+	tmpMolecule.copy(molgraph);
+
+	initSubstructureSearchTarget(tmpMolecule, true);
+
+	fpGenerator.generateTargetFingerprint(tmpMolecule, tmpFingerprint);
+	molWriter.writeMolGraph(tmpMolecule, byteBuffer);
+
+	std::size_t idx = getNumMolecules();
+
+	fingerprints.resize(fingerprints.size() + numFPWords);
+	convertFingerprint(tmpFingerprint, &fingerprints[idx * numFPWords], numFPWords);
+
+	molData.insert(molData.end(), byteBuffer.getData(), byteBuffer.getData() + byteBuffer.getSize());
+	molDataOffsets.push_back(molDataOffsets.back() + byteBuffer.getSize());
+
+	return idx;
+}
+
+void Chem::SubstructureSearchDatabaseImpl::getMolecule(std::size_t idx, Molecule& mol) const
+{
+	if (idx >= getNumMolecules())
+		throw Base::IndexError("SubstructureSearchDatabase: molecule index out of bounds");
+
+	// per-call I/O state keeps concurrent reads independent of each other
+
+	Internal::ByteBuffer bbuf;
+	CDFDataReader reader(controlParams);
+	std::ifstream is;
+
+	readMolecule(idx, mol, bbuf, reader, is);
+}
+
+void Chem::SubstructureSearchDatabaseImpl::getFingerprint(std::size_t idx, Util::BitSet& fp) const
+{
+	if (idx >= getNumMolecules())
+		throw Base::IndexError("SubstructureSearchDatabase: molecule index out of bounds");
+
+	std::size_t num_bits = fpGenerator.getNumBits();
+	const Base::uint64* words = &fingerprints[idx * numFPWords];
+
+	fp.resize(num_bits);
+	fp.reset();
+
+	for (std::size_t i = 0; i < num_bits; i++)
+		if (words[i / FP_WORD_SIZE] & (Base::uint64(1) << (i % FP_WORD_SIZE)))
+			fp.set(i);
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::screen(const MolecularGraph& query, MoleculeIndexList& cands) const
+{
+	return process(query, cands, 0, true);
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::findMatches(const MolecularGraph& query, MoleculeIndexList& hits, std::size_t max_num_hits) const
+{
+	return process(query, hits, max_num_hits, false);
+}
+
+void Chem::SubstructureSearchDatabaseImpl::clear()
+{
+	fingerprints.clear();
+	molDataOffsets.assign(1, 0);
+	molData.clear();
+	fileName.clear();
+
+	fileDataOffset = 0;
+	fileDataSize = 0;
+}
+
+void Chem::SubstructureSearchDatabaseImpl::save(const std::string& file_name)
+{
+	std::string tmp_file_name = file_name + ".tmp";
+
+	{
+		std::ofstream os(tmp_file_name.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!os)
+			throw Base::IOError("SubstructureSearchDatabase: could not open file '" + tmp_file_name + "' for writing");
+
+		Internal::ByteBuffer bbuf;
+
+		bbuf.putInt(FORMAT_ID, false);
+		bbuf.putInt(FORMAT_VERSION, false);
+		bbuf.putInt(Base::uint32(fpGenerator.getNumBits()), false);
+		bbuf.putInt(Base::uint32(fpGenerator.getMaxPathLength()), false);
+		bbuf.putInt(Base::uint64(getNumMolecules()), false);
+		bbuf.putInt(Base::uint64(molDataOffsets.back()), false);
+
+		bbuf.resize(bbuf.getIOPointer());
+		bbuf.writeBuffer(os);
+
+		writeIndexData(os, bbuf);
+		writeMoleculeData(os, bbuf);
+
+		os.flush();
+
+		if (!os.good()) {
+			os.close();
+			std::remove(tmp_file_name.c_str());
+
+			throw Base::IOError("SubstructureSearchDatabase: error while writing file '" + tmp_file_name + "'");
+		}
+	}
+
+	std::remove(file_name.c_str());
+
+	if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0)
+		throw Base::IOError("SubstructureSearchDatabase: could not rename file '" + tmp_file_name + "' to '" + file_name + "'");
+
+	// the molecule data offsets of the replaced file are no longer valid
+
+	if (file_name == fileName)
+		open(file_name);
+}
+
+void Chem::SubstructureSearchDatabaseImpl::open(const std::string& file_name)
+{
+	clear();
+
+	try {
+		fileName = file_name;
+
+		std::ifstream is;
+
+		openDataStream(is);
+
+		if (byteBuffer.readBuffer(is, HEADER_SIZE) != HEADER_SIZE)
+			throw Base::IOError("SubstructureSearchDatabase: unexpected end of file while reading header");
+
+		Base::uint32 format_id;
+		Base::uint32 format_version;
+		Base::uint32 num_bits;
+		Base::uint32 max_path_len;
+		Base::uint64 num_mols;
+		Base::uint64 data_size;
+
+		byteBuffer.setIOPointer(0);
+
+		byteBuffer.getInt(format_id);
+		byteBuffer.getInt(format_version);
+		byteBuffer.getInt(num_bits);
+		byteBuffer.getInt(max_path_len);
+		byteBuffer.getInt(num_mols);
+		byteBuffer.getInt(data_size);
+
+		if (format_id != FORMAT_ID)
+			throw Base::IOError("SubstructureSearchDatabase: invalid file format");
+
+		if (format_version != FORMAT_VERSION)
+			throw Base::IOError("SubstructureSearchDatabase: unsupported file format version");
+
+		fpGenerator.setNumBits(num_bits);
+		fpGenerator.setMaxPathLength(max_path_len);
+
+		numFPWords = (num_bits + FP_WORD_SIZE - 1) / FP_WORD_SIZE;
+
+		readFingerprints(is, byteBuffer, num_mols);
+		readOffsets(is, byteBuffer, num_mols);
+
+		if (molDataOffsets.back() != data_size)
+			throw Base::IOError("SubstructureSearchDatabase: inconsistent molecule data size");
+
+		fileDataOffset = HEADER_SIZE + (fingerprints.size() + molDataOffsets.size()) * sizeof(Base::uint64);
+		fileDataSize = data_size;
+
+	} catch (...) {
+		clear();
+		throw;
+	}
+}
+
+const std::string& Chem::SubstructureSearchDatabaseImpl::getFileName() const
+{
+	return fileName;
+}
+
+std::size_t Chem::SubstructureSearchDatabaseImpl::process(const MolecularGraph& query, MoleculeIndexList& results, 
+														  std::size_t max_num_hits, bool screen_only) const
+{
+	results.clear();
+
+	std::size_t num_mols = getNumMolecules();
+
+	if (num_mols == 0)
+		return 0;
+
+	// all state that gets modified during query processing is local to the call - concurrent queries on the 
+	// same database instance therefore do not interfere
+
+	SubstructureScreeningFingerprintGenerator fp_gen(fpGenerator);
+	Util::BitSet query_fp;
+	UInt64Array query_fp_words(numFPWords);
+
+	fp_gen.generateQueryFingerprint(query, query_fp);
+	convertFingerprint(query_fp, &query_fp_words[0], numFPWords);
+
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	num_threads = std::max(std::min(num_threads, (num_mols + PROC_CHUNK_SIZE - 1) / PROC_CHUNK_SIZE), std::size_t(1));
+
+	SearchContextList search_ctxts;
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		search_ctxts.push_back(SearchContextPtr(new SearchContext(controlParams)));
+
+		if (!screen_only)
+			search_ctxts.back()->substructSearch.reset(new SubstructureSearch(query));
+	}
+
+	ProcessingState state((num_mols + PROC_CHUNK_SIZE - 1) / PROC_CHUNK_SIZE, max_num_hits);
+
+	if (num_threads > 1) {
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 1; i < num_threads; i++)
+			thread_grp.create_thread(boost::bind(&SubstructureSearchDatabaseImpl::processMolecules, this, boost::ref(state), 
+												 screen_only, &query_fp_words[0], boost::ref(*search_ctxts[i])));
+
+		processMolecules(state, screen_only, &query_fp_words[0], *search_ctxts.front());
+
+		thread_grp.join_all();
+
+	} else
+		processMolecules(state, screen_only, &query_fp_words[0], *search_ctxts.front());
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		const SearchContext& ctxt = *search_ctxts[i];
+
+		if (!ctxt.errorMessage.empty())
+			throw Base::CalculationFailed("SubstructureSearchDatabase: " + ctxt.errorMessage);
+	}
+
+	// chunks are processed in the order of increasing molecule indices - concatenating the chunk results
+	// thus yields the hits in ascending order
+
+	for (MoleculeIndexListArray::const_iterator it = state.chunkResults.begin(), end = state.chunkResults.end(); it != end; ++it) 
+		results.insert(results.end(), it->begin(), it->end());
+
+	if (max_num_hits > 0 && results.size() > max_num_hits)
+		results.resize(max_num_hits);
+
+	return results.size();
+}
+
+void Chem::SubstructureSearchDatabaseImpl::processMolecules(ProcessingState& state, bool screen_only, const Base::uint64* query_fp,
+															SearchContext& ctxt) const
+{
+	std::size_t num_mols = getNumMolecules();
+
+	try {
+		for (std::size_t i = state.nextIndex.fetch_add(PROC_CHUNK_SIZE); i < num_mols; i = state.nextIndex.fetch_add(PROC_CHUNK_SIZE)) {
+			std::size_t chunk_idx = i / PROC_CHUNK_SIZE;
+			std::size_t max_num_hits = 0;
+
+			if (!getMaxNumChunkHits(state, chunk_idx, max_num_hits))
+				continue;
+
+			MoleculeIndexList& results = state.chunkResults[chunk_idx];
+
+			for (std::size_t j = i, end = std::min(i + PROC_CHUNK_SIZE, num_mols); j < end; j++) {
+				if (!passesScreen(j, query_fp))
+					continue;
+
+				if (!screen_only) {
+					readMolecule(j, ctxt.molecule, ctxt.byteBuffer, ctxt.molReader, ctxt.dataStream);
+					initSubstructureSearchTarget(ctxt.molecule, false);
+
+					if (!ctxt.substructSearch->mappingExists(ctxt.molecule))
+						continue;
+				}
+
+				results.push_back(j);
+
+				if (max_num_hits > 0 && results.size() >= max_num_hits)
+					break;
+			}
+
+			chunkProcessed(state, chunk_idx);
+		}
+
+	} catch (const std::exception& e) {
+		ctxt.errorMessage = e.what();
+		state.nextIndex = num_mols;
+
+		if (ctxt.errorMessage.empty())
+			ctxt.errorMessage = "unspecified error";
+	}
+}
+
+bool Chem::SubstructureSearchDatabaseImpl::getMaxNumChunkHits(ProcessingState& state, std::size_t chunk_idx, std::size_t& max_num_hits) const
+{
+	if (state.maxNumHits == 0)
+		return true;
+
+	boost::lock_guard<boost::mutex> lock(state.mutex);
+
+	if (state.numPrefixHits >= state.maxNumHits)
+		return false;
+
+	// if all preceding chunks are done, only the hits still missing from the limit are needed
+
+	max_num_hits = state.maxNumHits - (state.numDoneChunks == chunk_idx ? state.numPrefixHits : 0);
+
+	return true;
+}
+
+void Chem::SubstructureSearchDatabaseImpl::chunkProcessed(ProcessingState& state, std::size_t chunk_idx) const
+{
+	if (state.maxNumHits == 0)
+		return;
+
+	boost::lock_guard<boost::mutex> lock(state.mutex);
+
+	state.chunkDone[chunk_idx] = true;
+
+	for ( ; state.numDoneChunks < state.chunkDone.size() && state.chunkDone[state.numDoneChunks]; state.numDoneChunks++)
+		state.numPrefixHits += state.chunkResults[state.numDoneChunks].size();
+
+	// once the hits of the completed leading chunks reach the limit, the remaining chunks cannot contribute 
+	// to the hits with the lowest indices
+
+	if (state.numPrefixHits >= state.maxNumHits)
+		state.nextIndex = getNumMolecules();
+}
+
+bool Chem::SubstructureSearchDatabaseImpl::passesScreen(std::size_t idx, const Base::uint64* query_fp) const
+{
+	const Base::uint64* mol_fp = &fingerprints[idx * numFPWords];
+
+	for (std::size_t i = 0; i < numFPWords; i++)
+		if (query_fp[i] & ~mol_fp[i])
+			return false;
+
+	return true;
+}
+
+void Chem::SubstructureSearchDatabaseImpl::readMolecule(std::size_t idx, Molecule& mol, Internal::ByteBuffer& bbuf,
+														CDFDataReader& reader, std::ifstream& is) const
+{
+	Base::uint64 offset = molDataOffsets[idx];
+	std::size_t size = molDataOffsets[idx + 1] - offset;
+
+	if (offset < fileDataSize) {
+		if (!is.is_open())
+			openDataStream(is);
+
+		is.clear();
+		is.seekg(std::streamoff(fileDataOffset + offset));
+
+		if (bbuf.readBuffer(is, size) != size)
+			throw Base::IOError("SubstructureSearchDatabase: unexpected end of file while reading molecule data");
+
+	} else {
+		bbuf.resize(size);
+		bbuf.setIOPointer(0);
+		bbuf.putBytes(&molData[offset - fileDataSize], size);
+	}
+
+	mol.clear();
+
+	if (!reader.readMolecule(mol, bbuf))
+		throw Base::IOError("SubstructureSearchDatabase: invalid molecule record");
+}
+
+void Chem::SubstructureSearchDatabaseImpl::writeIndexData(std::ostream& os, Internal::ByteBuffer& bbuf) const
+{
+	for (std::size_t i = 0, num_words = fingerprints.size(); i < num_words; i += IO_CHUNK_SIZE) {
+		bbuf.setIOPointer(0);
+
+		for (std::size_t j = i, end = std::min(i + IO_CHUNK_SIZE, num_words); j < end; j++)
+			bbuf.putInt(fingerprints[j], false);
+
+		bbuf.resize(bbuf.getIOPointer());
+		bbuf.writeBuffer(os);
+	}
+
+	for (std::size_t i = 0, num_offsets = molDataOffsets.size(); i < num_offsets; i += IO_CHUNK_SIZE) {
+		bbuf.setIOPointer(0);
+
+		for (std::size_t j = i, end = std::min(i + IO_CHUNK_SIZE, num_offsets); j < end; j++)
+			bbuf.putInt(molDataOffsets[j], false);
+
+		bbuf.resize(bbuf.getIOPointer());
+		bbuf.writeBuffer(os);
+	}
+}
+
+void Chem::SubstructureSearchDatabaseImpl::writeMoleculeData(std::ostream& os, Internal::ByteBuffer& bbuf) const
+{
+	if (fileDataSize > 0) {
+		std::ifstream is;
+
+		openDataStream(is);
+
+		is.seekg(std::streamoff(fileDataOffset));
+
+		for (Base::uint64 num_copied = 0; num_copied < fileDataSize; ) {
+			std::size_t chunk_size = std::min(Base::uint64(DATA_COPY_CHUNK_SIZE), fileDataSize - num_copied);
+
+			if (bbuf.readBuffer(is, chunk_size) != chunk_size)
+				throw Base::IOError("SubstructureSearchDatabase: unexpected end of file while reading molecule data");
+
+			bbuf.writeBuffer(os);
+			num_copied += chunk_size;
+		}
+	}
+
+	if (!molData.empty())
+		os.write(&molData[0], molData.size());
+}
+
+void Chem::SubstructureSearchDatabaseImpl::readFingerprints(std::istream& is, Internal::ByteBuffer& bbuf, std::size_t num_mols)
+{
+	fingerprints.resize(num_mols * numFPWords);
+
+	for (std::size_t i = 0, num_words = fingerprints.size(); i < num_words; i += IO_CHUNK_SIZE) {
+		std::size_t chunk_size = std::min(IO_CHUNK_SIZE, num_words - i);
+
+		if (bbuf.readBuffer(is, chunk_size * sizeof(Base::uint64)) != chunk_size * sizeof(Base::uint64))
+			throw Base::IOError("SubstructureSearchDatabase: unexpected end of file while reading fingerprints");
+
+		bbuf.setIOPointer(0);
+
+		for (std::size_t j = 0; j < chunk_size; j++)
+			bbuf.getInt(fingerprints[i + j]);
+	}
+}
+
+void Chem::SubstructureSearchDatabaseImpl::readOffsets(std::istream& is, Internal::ByteBuffer& bbuf, std::size_t num_mols)
+{
+	molDataOffsets.resize(num_mols + 1);
+
+	for (std::size_t i = 0, num_offsets = molDataOffsets.size(); i < num_offsets; i += IO_CHUNK_SIZE) {
+		std::size_t chunk_size = std::min(IO_CHUNK_SIZE, num_offsets - i);
+
+		if (bbuf.readBuffer(is, chunk_size * sizeof(Base::uint64)) != chunk_size * sizeof(Base::uint64))
+			throw Base::IOError("SubstructureSearchDatabase: unexpected end of file while reading molecule data offsets");
+
+		bbuf.setIOPointer(0);
+
+		for (std::size_t j = 0; j < chunk_size; j++) {
+			bbuf.getInt(molDataOffsets[i + j]);
+
+			if ((i + j) == 0 ? molDataOffsets[0] != 0 : molDataOffsets[i + j] <= molDataOffsets[i + j - 1])
+				throw Base::IOError("SubstructureSearchDatabase: invalid molecule data offset");
+		}
+	}
+}
+
+void Chem::SubstructureSearchDatabaseImpl::openDataStream(std::ifstream& is) const
+{
+	is.open(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+
+	if (!is)
+		throw Base::IOError("SubstructureSearchDatabase: could not open file '" + fileName + "'");
+}
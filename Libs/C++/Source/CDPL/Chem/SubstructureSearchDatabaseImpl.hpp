@@ -0,0 +1,169 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureSearchDatabaseImpl.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESEARCHDATABASEIMPL_HPP
+#define CDPL_CHEM_SUBSTRUCTURESEARCHDATABASEIMPL_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "CDPL/Chem/SubstructureSearchDatabase.hpp"
+#include "CDPL/Chem/SubstructureScreeningFingerprintGenerator.hpp"
+#include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/CDFDataReader.hpp"
+#include "CDPL/Chem/CDFDataWriter.hpp"
+#include "CDPL/Base/ControlParameterList.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace Chem
+	{
+
+		class SubstructureSearchDatabaseImpl
+		{
+
+		public:
+			typedef SubstructureSearchDatabase::MoleculeIndexList MoleculeIndexList;
+
+			SubstructureSearchDatabaseImpl();
+
+			void setNumThreads(std::size_t num_threads);
+
+			std::size_t getNumThreads() const;
+
+			std::size_t getNumFingerprintBits() const;
+
+			std::size_t getNumMolecules() const;
+
+			std::size_t addMolecule(const MolecularGraph& molgraph);
+
+			void getMolecule(std::size_t idx, Molecule& mol) const;
+
+			void getFingerprint(std::size_t idx, Util::BitSet& fp) const;
+
+			std::size_t screen(const MolecularGraph& query, MoleculeIndexList& cands) const;
+
+			std::size_t findMatches(const MolecularGraph& query, MoleculeIndexList& hits, std::size_t max_num_hits) const;
+
+			void clear();
+
+			void save(const std::string& file_name);
+
+			void open(const std::string& file_name);
+
+			const std::string& getFileName() const;
+
+		private:
+			typedef std::vector<Base::uint64> UInt64Array;
+			typedef std::vector<char> DataArray;
+
+			struct SearchContext
+			{
+
+				SearchContext(const Base::ControlParameterContainer& ctrl_params): molReader(ctrl_params) {}
+
+				SubstructureSearch::SharedPointer substructSearch;
+				BasicMolecule                     molecule;
+				Internal::ByteBuffer              byteBuffer;
+				CDFDataReader                     molReader;
+				std::ifstream                     dataStream;
+				std::string                       errorMessage;
+			};
+
+			typedef std::vector<MoleculeIndexList> MoleculeIndexListArray;
+
+			struct ProcessingState
+			{
+
+				ProcessingState(std::size_t num_chunks, std::size_t max_num_hits): 
+					nextIndex(0), chunkResults(num_chunks), chunkDone(num_chunks, false), numDoneChunks(0),
+					numPrefixHits(0), maxNumHits(max_num_hits) {}
+
+				boost::atomic<std::size_t> nextIndex;
+				boost::mutex               mutex;
+				MoleculeIndexListArray     chunkResults;
+				std::vector<bool>          chunkDone;
+				std::size_t                numDoneChunks;
+				std::size_t                numPrefixHits;
+				std::size_t                maxNumHits;
+			};
+
+			typedef boost::shared_ptr<SearchContext> SearchContextPtr;
+			typedef std::vector<SearchContextPtr> SearchContextList;
+
+			std::size_t process(const MolecularGraph& query, MoleculeIndexList& results, std::size_t max_num_hits, bool screen_only) const;
+
+			void processMolecules(ProcessingState& state, bool screen_only, const Base::uint64* query_fp, 
+								  SearchContext& ctxt) const;
+
+			bool getMaxNumChunkHits(ProcessingState& state, std::size_t chunk_idx, std::size_t& max_num_hits) const;
+
+			void chunkProcessed(ProcessingState& state, std::size_t chunk_idx) const;
+
+			bool passesScreen(std::size_t idx, const Base::uint64* query_fp) const;
+
+			void readMolecule(std::size_t idx, Molecule& mol, Internal::ByteBuffer& bbuf,
+							  CDFDataReader& reader, std::ifstream& is) const;
+
+			void writeIndexData(std::ostream& os, Internal::ByteBuffer& bbuf) const;
+			void writeMoleculeData(std::ostream& os, Internal::ByteBuffer& bbuf) const;
+
+			void readFingerprints(std::istream& is, Internal::ByteBuffer& bbuf, std::size_t num_mols);
+			void readOffsets(std::istream& is, Internal::ByteBuffer& bbuf, std::size_t num_mols);
+
+			void openDataStream(std::ifstream& is) const;
+
+			Base::ControlParameterList                controlParams;
+			CDFDataWriter                             molWriter;
+			SubstructureScreeningFingerprintGenerator fpGenerator;
+			BasicMolecule                             tmpMolecule;
+			Util::BitSet                              tmpFingerprint;
+			Internal::ByteBuffer                      byteBuffer;
+			std::string                               fileName;
+			std::size_t                               numThreads;
+			std::size_t                               numFPWords;
+			UInt64Array                               fingerprints;
+			UInt64Array                               molDataOffsets;
+			Base::uint64                              fileDataOffset;
+			Base::uint64                              fileDataSize;
+			DataArray                                 molData;
+		};
+	}
+}
+
+#endif // CDPL_CHEM_SUBSTRUCTURESEARCHDATABASEIMPL_HPP
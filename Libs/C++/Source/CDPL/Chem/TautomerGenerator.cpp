@@ -28,8 +28,10 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 #include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 #include "CDPL/Chem/TautomerGenerator.hpp"
 #include "CDPL/Chem/BasicMolecule.hpp"
@@ -43,6 +45,7 @@
 #include "CDPL/Chem/AtomConfiguration.hpp"
 #include "CDPL/Chem/BondConfiguration.hpp"
 #include "CDPL/Chem/StereoDescriptor.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/SHA1.hpp"
 
 
@@ -50,6 +53,12 @@ namespace
 {
 
 	const std::size_t MAX_MOLECULE_CACHE_SIZE = 5000;
+
+	// rough per-item memory usage estimates (in bytes) used for enforcing the memory limit
+
+	const std::size_t ATOM_MEMORY_USAGE       = 320;
+	const std::size_t BOND_MEMORY_USAGE       = 192;
+	const std::size_t HASH_CODE_MEMORY_USAGE  = 32;
 }
 
 
@@ -58,14 +67,18 @@ using namespace CDPL;
 
 Chem::TautomerGenerator::TautomerGenerator():
 	molCache(MAX_MOLECULE_CACHE_SIZE),
-	mode(TOPOLOGICALLY_UNIQUE), regStereo(true), regIsotopes(true)
+	mode(TOPOLOGICALLY_UNIQUE), regStereo(true), regIsotopes(true), numThreads(1),
+	maxNumTautomers(0), maxFrontierSize(0), maxMemoryUsage(0), terminate(false), numHashCodes(0)
 {
 	molCache.setCleanupFunction(&BasicMolecule::clear);
 }
 
 Chem::TautomerGenerator::TautomerGenerator(const TautomerGenerator& gen):
 	molCache(MAX_MOLECULE_CACHE_SIZE),
-	callbackFunc(gen.callbackFunc), mode(gen.mode), regStereo(gen.regStereo), regIsotopes(gen.regIsotopes)
+	callbackFunc(gen.callbackFunc), mode(gen.mode), regStereo(gen.regStereo), regIsotopes(gen.regIsotopes),
+	customSetupFunc(gen.customSetupFunc), scoringFunc(gen.scoringFunc), numThreads(gen.numThreads), 
+	maxNumTautomers(gen.maxNumTautomers), maxFrontierSize(gen.maxFrontierSize), maxMemoryUsage(gen.maxMemoryUsage), 
+	terminate(false), numHashCodes(0)
 {
 	molCache.setCleanupFunction(&BasicMolecule::clear);
 
@@ -81,6 +94,12 @@ Chem::TautomerGenerator& Chem::TautomerGenerator::operator=(const TautomerGenera
 	mode = gen.mode;
 	regStereo = gen.regStereo;
 	regIsotopes = gen.regIsotopes;
+	customSetupFunc = gen.customSetupFunc;
+	scoringFunc = gen.scoringFunc;
+	numThreads = gen.numThreads;
+	maxNumTautomers = gen.maxNumTautomers;
+	maxFrontierSize = gen.maxFrontierSize;
+	maxMemoryUsage = gen.maxMemoryUsage;
 
 	tautRules.clear();
 
@@ -161,66 +180,156 @@ void Chem::TautomerGenerator::setCustomSetupFunction(const CustomSetupFunction&
 	customSetupFunc = func;
 }
 
+void Chem::TautomerGenerator::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t Chem::TautomerGenerator::getNumThreads() const
+{
+	return numThreads;
+}
+
+void Chem::TautomerGenerator::setMaxNumTautomers(std::size_t max_num)
+{
+	maxNumTautomers = max_num;
+}
+
+std::size_t Chem::TautomerGenerator::getMaxNumTautomers() const
+{
+	return maxNumTautomers;
+}
+
+void Chem::TautomerGenerator::setMaxFrontierSize(std::size_t max_size)
+{
+	maxFrontierSize = max_size;
+}
+
+std::size_t Chem::TautomerGenerator::getMaxFrontierSize() const
+{
+	return maxFrontierSize;
+}
+
+void Chem::TautomerGenerator::setMaxMemoryUsage(std::size_t max_bytes)
+{
+	maxMemoryUsage = max_bytes;
+}
+
+std::size_t Chem::TautomerGenerator::getMaxMemoryUsage() const
+{
+	return maxMemoryUsage;
+}
+
+void Chem::TautomerGenerator::setScoringFunction(const ScoringFunction& func)
+{
+	scoringFunc = func;
+}
+
+const Chem::TautomerGenerator::ScoringFunction& Chem::TautomerGenerator::getScoringFunction() const
+{
+	return scoringFunc;
+}
+
 void Chem::TautomerGenerator::generate(const MolecularGraph& molgraph)
 {
     if (!callbackFunc)
 		return;
 
-	if (!init(molgraph))
-		return;
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
 
-	TautRuleList::const_iterator rules_beg = tautRules.begin();
-	TautRuleList::const_iterator rules_end = tautRules.end();
+	num_threads = std::max(num_threads, std::size_t(1));
+	multiThreaded = (num_threads > 1);
 
-	while (!nextGeneration.empty()) {
-		currGeneration.swap(nextGeneration);
+	initExpansionContexts(num_threads);
 
-		while (!currGeneration.empty()) {
-			MoleculePtr mol = currGeneration.back();
-			currGeneration.pop_back();
+	if (init(molgraph)) {
+		if (!multiThreaded)
+			expandFrontier(*expansionContexts.front());
 
-			for (TautRuleList::const_iterator r_it = rules_beg; r_it != rules_end; ++r_it) {
-				TautomerizationRule& rule = **r_it;
+		else {
+			boost::thread_group thread_grp;
 
-				if (!rule.setup(*mol))
-					continue;
+			for (std::size_t i = 1; i < num_threads; i++)
+				thread_grp.create_thread(boost::bind(&TautomerGenerator::runExpansionWorker, this, 
+													 boost::ref(*expansionContexts[i])));
+
+			runExpansionWorker(*expansionContexts.front());
 
-				while (true) {
-					MoleculePtr tautomer = molCache.get();
+			thread_grp.join_all();
+		}
+	}
 
-					if (rule.generate(*tautomer)) {
-						if (!addNewTautomer(tautomer)) 
-							continue;
+	frontier.clear();
 
-						if (!callbackFunc(*tautomer))
-							return;
+	for (std::size_t i = 0; i < NUM_HASH_CODE_SET_SHARDS; i++)
+		hashCodeSetShards[i].hashCodes.clear();
 
-					} else
-						break;
-				}
-			}
+	for (ExpansionContextList::const_iterator it = expansionContexts.begin(), end = expansionContexts.end(); it != end; ++it) {
+		ExpansionContext& ctxt = **it;
+
+		if (!ctxt.errorMessage.empty()) {
+			std::string err_msg;
+
+			err_msg.swap(ctxt.errorMessage);
+
+			throw Base::CalculationFailed("TautomerGenerator: " + err_msg);
 		}
 	}
 }
 
 bool Chem::TautomerGenerator::init(const MolecularGraph& molgraph)
 {
-	tautHashCodes.clear();
-	currGeneration.clear();
-	nextGeneration.clear();
+	frontier.clear();
+
+	for (std::size_t i = 0; i < NUM_HASH_CODE_SET_SHARDS; i++)
+		hashCodeSetShards[i].hashCodes.clear();
+
+	terminate = false;
+	numHashCodes = 0;
+	numGenTautomers = 0;
+	numActiveWorkers = 0;
+	nextFrontierSeqNo = 0;
 
 	extractStereoCenters(molgraph);
-	initHashCalculator();
 
 	MoleculePtr mol = copyInputMolGraph(molgraph);
 
-	if (!addNewTautomer(mol))
-		return false;
+	molMemoryUsage = mol->getNumAtoms() * ATOM_MEMORY_USAGE + mol->getNumBonds() * BOND_MEMORY_USAGE;
 
-	return callbackFunc(*mol);
+	return addNewTautomer(mol, 0, *expansionContexts.front());
 }
 
-void Chem::TautomerGenerator::initHashCalculator()
+void Chem::TautomerGenerator::initExpansionContexts(std::size_t num_threads)
+{
+	expansionContexts.resize(num_threads);
+
+	for (std::size_t i = 0; i < num_threads; i++) {
+		if (!expansionContexts[i])
+			expansionContexts[i].reset(new ExpansionContext());
+
+		ExpansionContext& ctxt = *expansionContexts[i];
+
+		// rule instances are stateful, additional threads therefore operate on private copies
+
+		if (i == 0)
+			ctxt.tautRules = tautRules;
+
+		else {
+			ctxt.tautRules.clear();
+
+			std::transform(tautRules.begin(), tautRules.end(), std::back_inserter(ctxt.tautRules), 
+						   boost::bind(&TautomerizationRule::clone, _1));
+		}
+
+		ctxt.customSetupFunc = customSetupFunc;
+		ctxt.scoringFunc = scoringFunc;
+		ctxt.errorMessage.clear();
+
+		initHashCalculator(ctxt.hashCalculator);
+	}
+}
+
+void Chem::TautomerGenerator::initHashCalculator(HashCodeCalculator& calculator) const
 {
 	unsigned int atom_flags = AtomPropertyFlag::TYPE | AtomPropertyFlag::FORMAL_CHARGE;
 	unsigned int bond_flags = BondPropertyFlag::ORDER;
@@ -233,14 +342,110 @@ void Chem::TautomerGenerator::initHashCalculator()
 		bond_flags |= BondPropertyFlag::CIP_CONFIGURATION;
 	}
 
-	hashCalculator.setAtomHashSeedFunction(HashCodeCalculator::DefAtomHashSeedFunctor(hashCalculator, atom_flags));
-	hashCalculator.setBondHashSeedFunction(HashCodeCalculator::DefBondHashSeedFunctor(hashCalculator, bond_flags));
-	hashCalculator.includeGlobalStereoFeatures(regStereo);
+	calculator.setAtomHashSeedFunction(HashCodeCalculator::DefAtomHashSeedFunctor(calculator, atom_flags));
+	calculator.setBondHashSeedFunction(HashCodeCalculator::DefBondHashSeedFunctor(calculator, bond_flags));
+	calculator.includeGlobalStereoFeatures(regStereo);
+}
+
+void Chem::TautomerGenerator::runExpansionWorker(ExpansionContext& ctxt)
+{
+	try {
+		expandFrontier(ctxt);
+
+	} catch (const std::exception& e) {
+		ctxt.errorMessage = e.what();
+
+		if (ctxt.errorMessage.empty())
+			ctxt.errorMessage = "unspecified error";
+
+	} catch (...) {
+		ctxt.errorMessage = "unspecified error";
+	}
+}
+
+void Chem::TautomerGenerator::expandFrontier(ExpansionContext& ctxt)
+{
+	boost::unique_lock<boost::mutex> lock(frontierMutex);
+
+	while (true) {
+		while (!terminate && frontier.empty() && numActiveWorkers > 0)
+			frontierCondition.wait(lock);
+
+		if (terminate || frontier.empty())
+			break;
+
+		MoleculePtr mol = frontier.begin()->second.first;
+		std::size_t generation = frontier.begin()->second.second;
+
+		frontier.erase(frontier.begin());
+		numActiveWorkers++;
+
+		lock.unlock();
+
+		bool cont = false;
+
+		try {
+			cont = expandTautomer(mol, generation, ctxt);
+
+		} catch (...) {
+			lock.lock();
+
+			numActiveWorkers--;
+			terminate = true;
+
+			frontierCondition.notify_all();
+			throw;
+		}
+
+		mol.reset();
+		lock.lock();
+
+		numActiveWorkers--;
+
+		if (!cont)
+			terminate = true;
+
+		frontierCondition.notify_all();
+	}
+}
+
+bool Chem::TautomerGenerator::expandTautomer(const MoleculePtr& mol, std::size_t generation, ExpansionContext& ctxt)
+{
+	for (TautRuleList::const_iterator r_it = ctxt.tautRules.begin(), r_end = ctxt.tautRules.end(); r_it != r_end; ++r_it) {
+		TautomerizationRule& rule = **r_it;
+
+		if (!rule.setup(*mol))
+			continue;
+
+		while (!terminate) {
+			MoleculePtr tautomer = allocMolecule();
+
+			if (!rule.generate(*tautomer))
+				break;
+
+			addNewTautomer(tautomer, generation + 1, ctxt);
+		}
+
+		if (terminate)
+			return false;
+	}
+
+	return true;
+}
+
+Chem::TautomerGenerator::MoleculePtr Chem::TautomerGenerator::allocMolecule()
+{
+	// the molecule cache is not thread-safe
+
+	if (multiThreaded)
+		return MoleculePtr(new BasicMolecule());
+
+	return molCache.get();
 }
 
 Chem::TautomerGenerator::MoleculePtr Chem::TautomerGenerator::copyInputMolGraph(const MolecularGraph& molgraph)
 {
-	MoleculePtr mol_copy = molCache.get();
+	MoleculePtr mol_copy = allocMolecule();
 
 	for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it) {
 		const Atom& atom = *it;
@@ -450,7 +655,7 @@ void Chem::TautomerGenerator::extractBondStereoCenters(const MolecularGraph& mol
 	}
 }
 
-bool Chem::TautomerGenerator::addNewTautomer(const MoleculePtr& mol)
+bool Chem::TautomerGenerator::addNewTautomer(const MoleculePtr& mol, std::size_t generation, ExpansionContext& ctxt)
 {
 	if (regStereo) {
 		perceiveHybridizationStates(*mol, true);
@@ -497,27 +702,114 @@ bool Chem::TautomerGenerator::addNewTautomer(const MoleculePtr& mol)
 		}
 	}
 
-	Base::uint64 hash = calcTautomerHashCode(*mol);
+	if (!insertHashCode(calcTautomerHashCode(*mol, ctxt)))
+		return false;
+
+	if (ctxt.customSetupFunc)
+		ctxt.customSetupFunc(*mol);
+
+	double score = 0.0;
+
+	if (ctxt.scoringFunc) {
+		// perception results must not leak into the tautomer, the rule setup would otherwise see
+		// different input than in breadth-first mode
+
+		ctxt.scoringMolecule.copy(*mol);
+
+		perceiveSSSR(ctxt.scoringMolecule, true);
+		setRingFlags(ctxt.scoringMolecule, true);
+		setAromaticityFlags(ctxt.scoringMolecule, true);
+
+		score = ctxt.scoringFunc(ctxt.scoringMolecule);
+	}
+
+	{
+		boost::lock_guard<boost::mutex> lock(callbackMutex);
+
+		if (terminate)
+			return false;
+
+		numGenTautomers++;
+
+		if (!callbackFunc(*mol) || (maxNumTautomers > 0 && numGenTautomers >= maxNumTautomers)) {
+			terminate = true;
+			return false;
+		}
+	}
+
+	addToFrontier(mol, score, generation);
+
+	return true;
+}
+
+bool Chem::TautomerGenerator::insertHashCode(Base::uint64 hash)
+{
+	HashCodeSetShard& shard = hashCodeSetShards[hash % NUM_HASH_CODE_SET_SHARDS];
+
+	{
+		boost::lock_guard<boost::mutex> lock(shard.mutex);
+
+		if (!shard.hashCodes.insert(hash).second)
+			return false;
+	}
+
+	std::size_t num_hash_codes = ++numHashCodes;
+
+	if (maxMemoryUsage > 0 && num_hash_codes * HASH_CODE_MEMORY_USAGE > maxMemoryUsage) {
+		terminate = true;
+		return false;
+	}
+
+	return true;
+}
+
+void Chem::TautomerGenerator::addToFrontier(const MoleculePtr& mol, double score, std::size_t generation)
+{
+	boost::lock_guard<boost::mutex> lock(frontierMutex);
+
+	std::size_t seq_no = nextFrontierSeqNo++;
+
+	// without scoring function the tautomers of a generation get expanded before those of the next generation
+	// and, within a generation, in the reverse order of their discovery (as done by the former generation-wise 
+	// expansion); tautomers with equal scores are expanded in the order of their discovery
+
+	FrontierKey key = (scoringFunc ? FrontierKey(score, seq_no) : 
+					   FrontierKey(-double(generation), std::numeric_limits<std::size_t>::max() - seq_no));
+	std::size_t max_size = (maxFrontierSize == 0 ? std::numeric_limits<std::size_t>::max() : maxFrontierSize);
+
+	if (maxMemoryUsage > 0) {
+		std::size_t hash_mem_usage = numHashCodes * HASH_CODE_MEMORY_USAGE;
+
+		max_size = std::min(max_size, (hash_mem_usage >= maxMemoryUsage ? std::size_t(0) : 
+									   (maxMemoryUsage - hash_mem_usage) / std::max(molMemoryUsage, std::size_t(1))));
+	}
+
+	if (frontier.size() >= max_size) {
+		if (frontier.empty())
+			return;
+
+		Frontier::iterator worst_it = --frontier.end();
 
-	if (tautHashCodes.insert(hash).second) {
-		if (customSetupFunc)
-			customSetupFunc(*mol);
+		if (!frontier.key_comp()(key, worst_it->first))
+			return;
 
-		nextGeneration.push_back(mol);
-		return true;
+		frontier.erase(worst_it);
 	}
 
-	return false;
+	frontier.insert(Frontier::value_type(key, FrontierEntry(mol, generation)));
+	frontierCondition.notify_one();
 }
 
-Base::uint64 Chem::TautomerGenerator::calcTautomerHashCode(const BasicMolecule& tautomer)
+Base::uint64 Chem::TautomerGenerator::calcTautomerHashCode(const BasicMolecule& tautomer, ExpansionContext& ctxt) const
 {
 	if (mode == TOPOLOGICALLY_UNIQUE)
-		return hashCalculator.calculate(tautomer);
+		return ctxt.hashCalculator.calculate(tautomer);
 
+	BondDescrArray& tautomer_bonds = ctxt.tautomerBonds;
+	SizeTArray& sha_input = ctxt.shaInput;
 	BondDescriptor bond_desc;
 
-	tautomerBonds.clear();
+	tautomer_bonds.clear();
 
 	for (BasicMolecule::ConstBondIterator it = tautomer.getBondsBegin(), end = tautomer.getBondsEnd(); it != end; ++it) {
 		const Bond& bond = *it;
@@ -540,25 +832,25 @@ Base::uint64 Chem::TautomerGenerator::calcTautomerHashCode(const BasicMolecule&
 		bond_desc[1] = atom2_idx;
 		bond_desc[2] = getOrder(bond);
 
-		tautomerBonds.push_back(bond_desc);
+		tautomer_bonds.push_back(bond_desc);
 	}
 
-	std::sort(tautomerBonds.begin(), tautomerBonds.end());
+	std::sort(tautomer_bonds.begin(), tautomer_bonds.end());
 
-	shaInput.clear();
+	sha_input.clear();
 
-	for (BondDescrArray::const_iterator it = tautomerBonds.begin(), end = tautomerBonds.end(); it != end; ++it) {
+	for (BondDescrArray::const_iterator it = tautomer_bonds.begin(), end = tautomer_bonds.end(); it != end; ++it) {
 		const BondDescriptor& descr = *it;
 
-		shaInput.push_back(descr[0]);
-		shaInput.push_back(descr[1]);
-		shaInput.push_back(descr[2]);
+		sha_input.push_back(descr[0]);
+		sha_input.push_back(descr[1]);
+		sha_input.push_back(descr[2]);
 	}
 
 	Internal::SHA1 sha;
 	Base::uint8 sha_hash[Internal::SHA1::HASH_SIZE];
 
-	sha.input(shaInput.begin(), shaInput.end());
+	sha.input(sha_input.begin(), sha_input.end());
 	sha.getResult(&sha_hash[0]);
 
 	Base::uint64 hash_code = 0;
@@ -0,0 +1,164 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ConformerEnsembleTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/ConformerEnsemble.hpp"
+#include "CDPL/Chem/AtomConformerEnsemble3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/CDFMolecularGraphWriter.hpp"
+#include "CDPL/Chem/CDFMoleculeReader.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+	void makeConformer(std::size_t num_atoms, std::size_t conf_idx, CDPL::Math::Vector3DArray& coords)
+	{
+		coords.clear();
+
+		for (std::size_t i = 0; i < num_atoms; i++)
+			coords.addElement(CDPL::Math::vec(double(conf_idx), double(i), double(conf_idx * i)));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(ConformerEnsembleTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const std::size_t num_confs = 5;
+
+	BasicMolecule mol;
+
+	BOOST_CHECK(parseSMILES("CC(C)NCC(O)COc1ccccc1", mol));
+
+	std::size_t num_atoms = mol.getNumAtoms();
+	Math::Vector3DArray coords;
+
+	for (std::size_t i = 0; i < num_confs; i++) {
+		makeConformer(num_atoms, i, coords);
+		addConformation(mol, coords, i * 2.0);
+	}
+
+	// construction from per-atom conformations
+
+	ConformerEnsemble::SharedPointer ensemble(new ConformerEnsemble(mol));
+
+	BOOST_CHECK(ensemble->getNumAtoms() == num_atoms);
+	BOOST_CHECK(ensemble->getNumConformers() == num_confs);
+
+	for (std::size_t i = 0; i < num_confs; i++) {
+		makeConformer(num_atoms, i, coords);
+
+		const Math::Vector3D* conf_coords = ensemble->getCoordinates(i);
+
+		BOOST_CHECK(ensemble->getEnergy(i) == i * 2.0);
+		BOOST_CHECK(conf_coords + num_atoms == ensemble->getCoordinates(0) + (i + 1) * num_atoms);
+
+		AtomConformerEnsemble3DCoordinatesFunctor coords_func(*ensemble, i, mol);
+
+		for (std::size_t j = 0; j < num_atoms; j++) {
+			BOOST_CHECK(conf_coords[j] == coords[j]);
+			BOOST_CHECK(coords_func(mol.getAtom(j)) == coords[j]);
+		}
+
+		Math::Vector3DArray conf_coords_array;
+
+		ensemble->getConformer(i, conf_coords_array);
+
+		BOOST_CHECK(conf_coords_array.getSize() == num_atoms);
+		BOOST_CHECK(std::equal(conf_coords_array.getElementsBegin(), conf_coords_array.getElementsEnd(), coords.getElementsBegin()));
+
+		ensemble->applyConformer(i, mol);
+
+		for (std::size_t j = 0; j < num_atoms; j++)
+			BOOST_CHECK(get3DCoordinates(mol.getAtom(j)) == coords[j]);
+	}
+
+	BOOST_CHECK_THROW(ensemble->getCoordinates(num_confs), Base::IndexError);
+	BOOST_CHECK_THROW(ensemble->getEnergy(num_confs), Base::IndexError);
+	BOOST_CHECK_THROW(ensemble->addConformer(Math::Vector3DArray()), Base::SizeError);
+
+	// modification
+
+	ConformerEnsemble copy(*ensemble);
+
+	copy.removeConformer(1);
+
+	BOOST_CHECK(copy.getNumConformers() == num_confs - 1);
+	BOOST_CHECK(copy.getEnergy(1) == 4.0);
+	BOOST_CHECK(copy.getCoordinates(1)[1] == ensemble->getCoordinates(2)[1]);
+
+	Math::Vector3D* new_coords = copy.addConformer(-1.0);
+
+	for (std::size_t j = 0; j < num_atoms; j++)
+		new_coords[j] = coords[j];
+
+	BOOST_CHECK(copy.getNumConformers() == num_confs);
+	BOOST_CHECK(copy.getEnergy(num_confs - 1) == -1.0);
+	BOOST_CHECK(copy.getCoordinates(num_confs - 1)[num_atoms - 1] == coords[num_atoms - 1]);
+
+	// the ensemble is a snapshot, the per-atom arrays remain the storage used by the conformer access functions
+
+	Math::Vector3D new_atom_coords = Math::vec(-1.0, -2.0, -3.0);
+
+	(*get3DCoordinatesArray(mol.getAtom(0)))[0] = new_atom_coords;
+
+	getConformation(mol, 0, coords);
+
+	BOOST_CHECK(coords[0] == new_atom_coords);
+	BOOST_CHECK(ensemble->getCoordinates(0)[0] != new_atom_coords);
+
+	makeConformer(num_atoms, num_confs, coords);
+	addConformation(mol, coords, 0.0);
+
+	BOOST_CHECK(getNumConformations(mol) == num_confs + 1);
+	BOOST_CHECK(ensemble->getNumConformers() == num_confs);
+
+	ensemble->assign(mol);
+
+	BOOST_CHECK(ensemble->getNumConformers() == num_confs + 1);
+	BOOST_CHECK(ensemble->getCoordinates(0)[0] == new_atom_coords);
+	BOOST_CHECK(ensemble->getCoordinates(num_confs)[num_atoms - 1] == coords[num_atoms - 1]);
+
+	clearConformations(mol);
+
+	BOOST_CHECK(getNumConformations(mol) == 0);
+	BOOST_CHECK(ConformerEnsemble(mol).getNumConformers() == 0);
+}
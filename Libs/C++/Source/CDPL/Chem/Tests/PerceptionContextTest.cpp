@@ -0,0 +1,180 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PerceptionContextTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/PerceptionContext.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/BondFunctions.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Chem/AtomConfiguration.hpp"
+#include "CDPL/Chem/BondConfiguration.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+	const char* molecules[] = {
+		"CC(C)NCC(COC1=CC=C(C=C1)CCOC)O",
+		"C1C(=O)NC2=C(C=C(C=C2)Cl)C(=N1)C3=CC=CC=C3",
+		"C1CC1N2C=C(C(=O)C3=CC(=C(C=C32)N4CCNCC4)F)C(=O)O",
+		"C12C3C4C1C5C2C3C45",
+		"c1ccc2ccccc2c1.CCO",
+		"CCCC"
+	};
+}
+
+
+BOOST_AUTO_TEST_CASE(PerceptionContextTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const std::size_t num_mols = sizeof(molecules) / sizeof(const char*);
+
+	PerceptionContext ctxt;
+
+	BOOST_CHECK(!ctxt.getMolecularGraph());
+	BOOST_CHECK(!ctxt.update());
+	BOOST_CHECK_THROW(ctxt.perceiveSSSR(), Base::NullPointerException);
+
+	for (std::size_t i = 0; i < num_mols; i++) {
+		BasicMolecule mol;
+		BasicMolecule ref_mol;
+
+		BOOST_CHECK(parseSMILES(molecules[i], mol));
+		BOOST_CHECK(parseSMILES(molecules[i], ref_mol));
+
+		calcImplicitHydrogenCounts(mol, false);
+		calcImplicitHydrogenCounts(ref_mol, false);
+
+		perceiveComponents(ref_mol, false);
+		perceiveSSSR(ref_mol, false);
+		setRingFlags(ref_mol, false);
+		perceiveHybridizationStates(ref_mol, false);
+		setAromaticityFlags(ref_mol, false);
+		calcCIPPriorities(ref_mol, false);
+
+		ctxt.setMolecularGraph(mol);
+
+		BOOST_CHECK(ctxt.getMolecularGraph() == &mol);
+		BOOST_CHECK(!ctxt.update());
+
+		ctxt.perceiveAll();
+		ctxt.calcCIPPriorities();
+
+		BOOST_CHECK(getComponents(mol)->getSize() == getComponents(ref_mol)->getSize());
+		BOOST_CHECK(getSSSR(mol)->getSize() == getSSSR(ref_mol)->getSize());
+		BOOST_CHECK(getCyclicSubstructure(mol)->getNumAtoms() == getCyclicSubstructure(ref_mol)->getNumAtoms());
+		BOOST_CHECK(getCyclicSubstructure(mol)->getNumBonds() == getCyclicSubstructure(ref_mol)->getNumBonds());
+
+		for (std::size_t j = 0; j < mol.getNumAtoms(); j++) {
+			const Atom& atom = mol.getAtom(j);
+			const Atom& ref_atom = ref_mol.getAtom(j);
+
+			BOOST_CHECK(getRingFlag(atom) == getRingFlag(ref_atom));
+			BOOST_CHECK(getAromaticityFlag(atom) == getAromaticityFlag(ref_atom));
+			BOOST_CHECK(getHybridizationState(atom) == getHybridizationState(ref_atom));
+			BOOST_CHECK(getCIPPriority(atom) == getCIPPriority(ref_atom));
+		}
+
+		for (std::size_t j = 0; j < mol.getNumBonds(); j++) {
+			BOOST_CHECK(getRingFlag(mol.getBond(j)) == getRingFlag(ref_mol.getBond(j)));
+			BOOST_CHECK(getAromaticityFlag(mol.getBond(j)) == getAromaticityFlag(ref_mol.getBond(j)));
+		}
+	}
+
+	BasicMolecule mol;
+
+	BOOST_CHECK(parseSMILES("C1CCCCC1CC=O", mol));
+
+	calcImplicitHydrogenCounts(mol, false);
+
+	ctxt.setMolecularGraph(mol);
+	ctxt.perceiveAll();
+	ctxt.generateCanonicalNumbering();
+	ctxt.calcCIPPriorities();
+
+	setCIPConfiguration(mol.getAtom(5), AtomConfiguration::R);
+	setCIPConfiguration(mol.getBond(0), BondConfiguration::NONE);
+
+	FragmentList::SharedPointer sssr = getSSSR(mol);
+
+	// a bond order change keeps the ring related properties
+
+	setOrder(mol.getBond(mol.getNumBonds() - 1), 1);
+	setImplicitHydrogenCount(mol.getAtom(mol.getNumAtoms() - 1), 1);
+
+	BOOST_CHECK(ctxt.update());
+	BOOST_CHECK(!ctxt.update());
+
+	BOOST_CHECK(getSSSR(mol) == sssr);
+	BOOST_CHECK(hasRingFlag(mol.getAtom(0)));
+	BOOST_CHECK(!hasAromaticityFlag(mol.getAtom(0)));
+	BOOST_CHECK(!hasCanonicalNumber(mol.getAtom(0)));
+	BOOST_CHECK(!hasCIPPriority(mol.getAtom(0)));
+	BOOST_CHECK(!hasCIPConfiguration(mol.getAtom(5)));
+	BOOST_CHECK(!hasCIPConfiguration(mol.getBond(0)));
+	BOOST_CHECK(hasHybridizationState(mol.getAtom(0)));
+	BOOST_CHECK(!hasHybridizationState(mol.getAtom(mol.getNumAtoms() - 1)));
+	BOOST_CHECK(!hasHybridizationState(mol.getAtom(mol.getNumAtoms() - 2)));
+
+	ctxt.perceiveAll();
+
+	BOOST_CHECK(getSSSR(mol) == sssr);
+	BOOST_CHECK(hasAromaticityFlag(mol.getAtom(0)));
+	BOOST_CHECK(hasHybridizationState(mol.getAtom(mol.getNumAtoms() - 1)));
+
+	// closing a second ring invalidates the topology dependent properties
+
+	Bond& bond = mol.addBond(0, mol.getNumAtoms() - 1);
+
+	setOrder(bond, 1);
+	setImplicitHydrogenCount(mol.getAtom(mol.getNumAtoms() - 1), 0);
+
+	BOOST_CHECK(ctxt.update());
+	BOOST_CHECK(!hasSSSR(mol));
+	BOOST_CHECK(!hasComponents(mol));
+	BOOST_CHECK(!hasRingFlag(mol.getAtom(0)));
+
+	ctxt.perceiveAll();
+
+	BOOST_CHECK(getSSSR(mol)->getSize() == 2);
+	BOOST_CHECK(getRingFlag(mol.getAtom(mol.getNumAtoms() - 1)));
+	BOOST_CHECK(getRingFlag(bond));
+
+	ctxt.clear();
+
+	BOOST_CHECK(!ctxt.getMolecularGraph());
+}
@@ -0,0 +1,234 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SMILESBulkProcessorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Chem/SMILESBulkProcessor.hpp"
+#include "CDPL/Chem/SMILESMolecularGraphWriter.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+	const char* molecules[] = {
+		"CC(C)NCC(COC1=CC=C(C=C1)CCOC)O metoprolol",
+		"C1C(=O)NC2=C(C=C(C=C2)Cl)C(=N1)C3=CC=CC=C3 nordazepam",
+		"C1CC1N2C=C(C(=O)C3=CC(=C(C=C32)N4CCNCC4)F)C(=O)O ciprofloxacin",
+		"C12C3C4C1C5C2C3C45 cubane",
+		"c1ccc2ccccc2c1.CCO mixture",
+		"N[C@@H](C)C(=O)O alanine",
+		"F/C=C/F difluoroethene"
+	};
+
+	bool acceptEvenRecords(CDPL::Chem::Molecule&, std::size_t idx)
+	{
+		return (idx % 2 == 0);
+	}
+
+	void recordError(std::size_t idx, const std::string&, std::vector<std::size_t>& failed_recs)
+	{
+		failed_recs.push_back(idx);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(SMILESBulkProcessorTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const std::size_t num_mols = sizeof(molecules) / sizeof(const char*);
+	const std::size_t num_records = 200;
+
+	SMILESBulkProcessor proc;
+
+	setSMILESRecordFormatParameter(proc, "SN");
+	setSMILESWriteCanonicalFormParameter(proc, true);
+
+	BOOST_CHECK(proc.getNumThreads() == 1);
+	BOOST_CHECK(proc.moleculesPrepared());
+
+	// single record parsing
+
+	BasicMolecule mol;
+	BasicMolecule ref_mol;
+
+	for (std::size_t i = 0; i < num_mols; i++) {
+		BOOST_CHECK(proc.parseMolecule(molecules[i], mol));
+
+		std::string smiles(molecules[i]);
+
+		BOOST_CHECK(parseSMILES(smiles.substr(0, smiles.find(' ')), ref_mol));
+
+		BOOST_CHECK(mol.getNumAtoms() == ref_mol.getNumAtoms());
+		BOOST_CHECK(mol.getNumBonds() == ref_mol.getNumBonds());
+		BOOST_CHECK(getName(mol) == smiles.substr(smiles.find(' ') + 1));
+	}
+
+	BOOST_CHECK(!proc.parseMolecule(std::string(" \t "), mol));
+	BOOST_CHECK_THROW(proc.parseMolecule(std::string("CC[Cl"), mol), Base::IOError);
+
+	// bulk processing
+
+	std::string input;
+	std::ostringstream ref_output;
+	SMILESMolecularGraphWriter ref_writer(ref_output);
+
+	setSMILESRecordFormatParameter(ref_writer, "SN");
+	setSMILESWriteCanonicalFormParameter(ref_writer, true);
+	setRecordSeparatorParameter(ref_writer, "");
+
+	for (std::size_t i = 0; i < num_records; i++) {
+		const char* rec = molecules[i % num_mols];
+
+		input.append(rec).append(i % 10 == 0 ? "\r\n\n" : "\n");
+
+		BOOST_CHECK(proc.parseMolecule(rec, mol));
+
+		calcImplicitHydrogenCounts(mol, false);
+		perceiveComponents(mol, false);
+		perceiveSSSR(mol, false);
+		setRingFlags(mol, false);
+		perceiveHybridizationStates(mol, false);
+		setAromaticityFlags(mol, false);
+
+		BOOST_CHECK(ref_writer.write(mol));
+
+		ref_output << '\n';
+	}
+
+	std::string output;
+
+	BOOST_CHECK(proc.process(input, output) == num_records);
+	BOOST_CHECK(output == ref_output.str());
+
+	proc.setNumThreads(4);
+	proc.setChunkSize(7);
+
+	std::string mt_output;
+
+	BOOST_CHECK(proc.process(input, mt_output) == num_records);
+	BOOST_CHECK(mt_output == output);
+
+	// stream processing
+
+	std::istringstream iss(input);
+	std::ostringstream oss;
+
+	proc.setBlockSize(100);
+
+	BOOST_CHECK(proc.process(iss, oss) == num_records);
+	BOOST_CHECK(oss.str() == output);
+
+	// filtering by a processing function
+
+	proc.setProcessingFunction(&acceptEvenRecords);
+	mt_output.clear();
+
+	BOOST_CHECK(proc.process(input, mt_output) == num_records / 2);
+
+	iss.clear();
+	iss.str(input);
+	oss.str(std::string());
+
+	BOOST_CHECK(proc.process(iss, oss) == num_records / 2);
+	BOOST_CHECK(oss.str() == mt_output);
+
+	// erroneous records get skipped and reported
+
+	std::vector<std::size_t> failed_recs;
+	std::string err_input = "CC[Cl bad1\n" + input + "CC[Cl bad2\nCC)C bad3\n";
+
+	proc.setProcessingFunction(SMILESBulkProcessor::ProcessingFunction());
+	proc.setErrorFunction(boost::bind(&recordError, _1, _2, boost::ref(failed_recs)));
+	mt_output.clear();
+
+	BOOST_CHECK(proc.process(err_input, mt_output) == num_records);
+	BOOST_CHECK(proc.getNumFailedRecords() == 3);
+	BOOST_CHECK(mt_output == output);
+	BOOST_CHECK(failed_recs.size() == 3);
+	BOOST_CHECK(failed_recs[0] == 0);
+	BOOST_CHECK(failed_recs[1] == num_records + 1);
+	BOOST_CHECK(failed_recs[2] == num_records + 2);
+
+	failed_recs.clear();
+	iss.clear();
+	iss.str(err_input);
+	oss.str(std::string());
+
+	BOOST_CHECK(proc.process(iss, oss) == num_records);
+	BOOST_CHECK(proc.getNumFailedRecords() == 3);
+	BOOST_CHECK(oss.str() == output);
+	BOOST_CHECK(failed_recs.size() == 3);
+
+	BOOST_CHECK(proc.process(input, mt_output) == num_records);
+	BOOST_CHECK(proc.getNumFailedRecords() == 0);
+
+	// record separator
+
+	std::string sep_input = input;
+	std::string sep_output = output;
+
+	std::replace(sep_input.begin(), sep_input.end(), '\n', ';');
+	std::replace(sep_output.begin(), sep_output.end(), '\n', ';');
+
+	setRecordSeparatorParameter(proc, ";");
+	mt_output.clear();
+
+	BOOST_CHECK(proc.process(sep_input, mt_output) == num_records);
+	BOOST_CHECK(mt_output == sep_output);
+
+	iss.clear();
+	iss.str(sep_input);
+	oss.str(std::string());
+
+	BOOST_CHECK(proc.process(iss, oss) == num_records);
+	BOOST_CHECK(oss.str() == sep_output);
+
+	// records without SMILES string get reported like unparsable ones
+
+	failed_recs.clear();
+	mt_output.clear();
+
+	BOOST_CHECK(proc.process(sep_input + "\n;", mt_output) == num_records);
+	BOOST_CHECK(proc.getNumFailedRecords() == 1);
+	BOOST_CHECK(mt_output == sep_output);
+	BOOST_CHECK(failed_recs.size() == 1);
+	BOOST_CHECK(failed_recs[0] == num_records);
+}
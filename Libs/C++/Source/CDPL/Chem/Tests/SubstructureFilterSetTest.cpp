@@ -0,0 +1,141 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureFilterSetTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/SubstructureFilterSet.hpp"
+#include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+	const char* patterns[] = {
+		"c1ccccc1",
+		"C(=O)[OH1]",
+		"[#7]",
+		"[Cl,Br,I]",
+		"[R]@[R]",
+		"C(=O)N",
+		"[#6]~[#6]~[#6]~[#6]~[#6]~[#6]~[#6]~[#6]~[#6]~[#6]",
+		"[a;#7]",
+		"S(=O)(=O)N",
+		"[!#6;!#1]"
+	};
+
+	const char* targets[] = {
+		"CC(C)NCC(COC1=CC=C(C=C1)CCOC)O",
+		"C1C(=O)NC2=C(C=C(C=C2)Cl)C(=N1)C3=CC=CC=C3",
+		"C1CC1N2C=C(C(=O)C3=CC(=C(C=C32)N4CCNCC4)F)C(=O)O",
+		"CC1NC2=CC(=C(C=C2C(=O)N1C3=CC=CC=C3C)S(=O)(=O)N)Cl",
+		"C(C(C(C(C(CO)O)O)O)O)O",
+		"OC(=O)C1=CC(=CC=C1O)N=NC1=CC=C(C=C1)S(=O)(=O)NC1=NC=CC=C1",
+		"CCCC",
+		"c1ccncc1"
+	};
+}
+
+
+BOOST_AUTO_TEST_CASE(SubstructureFilterSetTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const std::size_t num_ptns = sizeof(patterns) / sizeof(const char*);
+	const std::size_t num_tgts = sizeof(targets) / sizeof(const char*);
+
+	SubstructureFilterSet filter_set;
+	std::vector<Molecule::SharedPointer> query_mols;
+
+	BOOST_CHECK(filter_set.getNumPatterns() == 0);
+	BOOST_CHECK(filter_set.getNumThreads() == 1);
+	BOOST_CHECK(filter_set.targetsInitialized());
+
+	for (std::size_t i = 0; i < num_ptns; i++) {
+		query_mols.push_back(parseSMARTS(patterns[i]));
+
+		filter_set.addPattern(query_mols.back());
+	}
+
+	BOOST_CHECK(filter_set.getNumPatterns() == num_ptns);
+	BOOST_CHECK(filter_set.getPattern(2) == query_mols[2]);
+
+	std::vector<BasicMolecule> target_mols(num_tgts);
+	SubstructureFilterSet::MolecularGraphList target_ptrs;
+
+	for (std::size_t i = 0; i < num_tgts; i++) {
+		BOOST_CHECK(parseSMILES(targets[i], target_mols[i]));
+
+		initSubstructureSearchTarget(target_mols[i], false);
+		target_ptrs.push_back(&target_mols[i]);
+	}
+
+	Util::BitSet hit_mask;
+	SubstructureSearch sub_search;
+
+	for (std::size_t i = 0; i < num_tgts; i++) {
+		std::size_t num_hits = filter_set.filter(target_mols[i], hit_mask);
+
+		BOOST_CHECK(hit_mask.size() == num_ptns);
+		BOOST_CHECK(hit_mask.count() == num_hits);
+
+		for (std::size_t j = 0; j < num_ptns; j++) {
+			sub_search.setQuery(*query_mols[j]);
+
+			BOOST_CHECK(hit_mask.test(j) == sub_search.mappingExists(target_mols[i]));
+		}
+	}
+
+	SubstructureFilterSet::HitMaskList seq_hit_masks;
+	SubstructureFilterSet::HitMaskList par_hit_masks;
+
+	filter_set.filter(target_ptrs, seq_hit_masks);
+	filter_set.setNumThreads(3);
+	filter_set.filter(target_ptrs, par_hit_masks);
+
+	BOOST_CHECK(seq_hit_masks.size() == num_tgts);
+	BOOST_CHECK(seq_hit_masks == par_hit_masks);
+
+	filter_set.removePattern(0);
+
+	BOOST_CHECK(filter_set.getNumPatterns() == num_ptns - 1);
+	BOOST_CHECK(filter_set.filter(target_mols[7], hit_mask) == seq_hit_masks[7].count() - (seq_hit_masks[7].test(0) ? 1 : 0));
+
+	BOOST_CHECK_THROW(filter_set.getPattern(num_ptns), Base::IndexError);
+
+	filter_set.clear();
+
+	BOOST_CHECK(filter_set.getNumPatterns() == 0);
+	BOOST_CHECK(filter_set.filter(target_mols[0], hit_mask) == 0);
+	BOOST_CHECK(hit_mask.size() == 0);
+}
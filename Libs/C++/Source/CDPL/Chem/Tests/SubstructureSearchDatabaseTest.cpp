@@ -0,0 +1,370 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureSearchDatabaseTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Chem/SubstructureSearchDatabase.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+	typedef CDPL::Chem::SubstructureSearchDatabase::MoleculeIndexList MoleculeIndexList;
+
+	// the database molecules are built from a few structural motifs so that the expected hits of the queries
+	// below directly follow from the molecule index; the number of molecules exceeds the size of the work 
+	// chunks processed by a single thread
+
+	const std::size_t NUM_MOLECULES = 700;
+
+	bool hasAmine(std::size_t idx)
+	{
+		return ((idx % 3) == 0);
+	}
+
+	bool hasPhenyl(std::size_t idx)
+	{
+		return ((idx % 5) == 0);
+	}
+
+	std::size_t getChainLength(std::size_t idx)
+	{
+		return ((idx % 12) + 1);
+	}
+
+	std::string getMoleculeSMILES(std::size_t idx)
+	{
+		return (std::string(hasAmine(idx) ? "N" : "") + std::string(getChainLength(idx), 'C') + (hasPhenyl(idx) ? "c1ccccc1" : ""));
+	}
+
+	struct Query
+	{
+
+		const char* smarts;
+		bool        (*isHit)(std::size_t idx);
+	};
+
+	bool isAmineHit(std::size_t idx)
+	{
+		return hasAmine(idx);
+	}
+
+	bool isLongChainHit(std::size_t idx)
+	{
+		return (getChainLength(idx) >= 10);
+	}
+
+	bool isAlkylBenzeneHit(std::size_t idx)
+	{
+		return (hasPhenyl(idx) && getChainLength(idx) >= 4);
+	}
+
+	bool isAminoAlkylBenzeneHit(std::size_t idx)
+	{
+		return (hasAmine(idx) && hasPhenyl(idx) && getChainLength(idx) <= 2);
+	}
+
+	bool isNoHit(std::size_t)
+	{
+		return false;
+	}
+
+	const Query QUERIES[] = {
+		{ "NC", &isAmineHit },
+		{ "CCCCCCCCCC", &isLongChainHit },
+		{ "CCCCc1ccccc1", &isAlkylBenzeneHit },
+		{ "N[CH2]-[$(c1ccccc1),$([CH2]c1ccccc1)]", &isAminoAlkylBenzeneHit },
+		{ "Br", &isNoHit }
+	};
+
+	const std::size_t NUM_QUERIES = sizeof(QUERIES) / sizeof(Query);
+
+	void getExpectedHits(const Query& query, MoleculeIndexList& hits)
+	{
+		hits.clear();
+
+		for (std::size_t i = 0; i < NUM_MOLECULES; i++)
+			if (query.isHit(i))
+				hits.push_back(i);
+	}
+
+	void initDatabase(CDPL::Chem::SubstructureSearchDatabase& db)
+	{
+		using namespace CDPL;
+
+		Chem::BasicMolecule mol;
+
+		for (std::size_t i = 0; i < NUM_MOLECULES; i++) {
+			mol.clear();
+
+			BOOST_REQUIRE(Chem::parseSMILES(getMoleculeSMILES(i), mol));
+			BOOST_REQUIRE(db.addMolecule(mol) == i);
+		}
+	}
+
+	void checkQueries(const CDPL::Chem::SubstructureSearchDatabase& db, std::size_t offset)
+	{
+		using namespace CDPL;
+
+		MoleculeIndexList cands;
+		MoleculeIndexList hits;
+		MoleculeIndexList exp_hits;
+
+		for (std::size_t i = 0; i < NUM_QUERIES; i++) {
+			const Query& query = QUERIES[(i + offset) % NUM_QUERIES];
+			Chem::Molecule::SharedPointer query_mol = Chem::parseSMARTS(query.smarts);
+
+			getExpectedHits(query, exp_hits);
+
+			BOOST_CHECK_MESSAGE(db.findMatches(*query_mol, hits) == exp_hits.size(), query.smarts);
+			BOOST_CHECK_MESSAGE(hits == exp_hits, query.smarts);
+
+			BOOST_CHECK(db.screen(*query_mol, cands) == cands.size());
+			BOOST_CHECK_MESSAGE(std::includes(cands.begin(), cands.end(), exp_hits.begin(), exp_hits.end()), query.smarts);
+		}
+	}
+
+	void checkQueriesConcurrently(const CDPL::Chem::SubstructureSearchDatabase* db, std::size_t offset, 
+								  std::size_t num_iter, bool* failed)
+	{
+		using namespace CDPL;
+
+		*failed = true;
+
+		MoleculeIndexList hits;
+		MoleculeIndexList exp_hits;
+		Chem::BasicMolecule mol;
+
+		for (std::size_t i = 0; i < num_iter; i++) {
+			const Query& query = QUERIES[(i + offset) % NUM_QUERIES];
+			Chem::Molecule::SharedPointer query_mol = Chem::parseSMARTS(query.smarts);
+
+			getExpectedHits(query, exp_hits);
+
+			if (db->findMatches(*query_mol, hits) != exp_hits.size() || hits != exp_hits)
+				return;
+
+			std::size_t mol_idx = (i * 37 + offset) % NUM_MOLECULES;
+
+			db->getMolecule(mol_idx, mol);
+
+			if (mol.getNumAtoms() != (hasAmine(mol_idx) ? 1 : 0) + getChainLength(mol_idx) + (hasPhenyl(mol_idx) ? 6 : 0))
+				return;
+		}
+
+		*failed = false;
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(SubstructureSearchDatabaseQueryTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	SubstructureSearchDatabase db;
+
+	BOOST_CHECK(db.getNumMolecules() == 0);
+	BOOST_CHECK(db.getNumThreads() == 1);
+	BOOST_CHECK(db.getFileName().empty());
+
+	MoleculeIndexList hits;
+
+	BOOST_CHECK(db.findMatches(*parseSMARTS("C"), hits) == 0);
+	BOOST_CHECK(hits.empty());
+
+	initDatabase(db);
+
+	BOOST_CHECK(db.getNumMolecules() == NUM_MOLECULES);
+
+	checkQueries(db, 0);
+
+	db.setNumThreads(4);
+
+	checkQueries(db, 0);
+
+	db.setNumThreads(0);
+
+	checkQueries(db, 0);
+
+	// bromine does not occur in any molecule - the fingerprint screen alone must reject all of them
+
+	MoleculeIndexList cands;
+
+	BOOST_CHECK(db.screen(*parseSMARTS("Br"), cands) == 0);
+
+	// hit limit
+
+	MoleculeIndexList exp_hits;
+
+	getExpectedHits(QUERIES[0], exp_hits);
+
+	BOOST_CHECK(exp_hits.size() > 100);
+
+	// the hits with the lowest indices must be reported regardless of the number of threads
+
+	for (std::size_t num_threads = 1; num_threads <= 4; num_threads += 3) {
+		db.setNumThreads(num_threads);
+
+		for (std::size_t i = 0; i < 5; i++) {
+			std::size_t max_num_hits = (i % 2 == 0 ? 5 : 100);
+
+			BOOST_CHECK(db.findMatches(*parseSMARTS(QUERIES[0].smarts), hits, max_num_hits) == max_num_hits);
+			BOOST_CHECK(std::equal(hits.begin(), hits.end(), exp_hits.begin()));
+		}
+	}
+
+	Util::BitSet fp;
+
+	BOOST_CHECK_THROW(db.getFingerprint(NUM_MOLECULES, fp), Base::IndexError);
+
+	BasicMolecule mol;
+
+	BOOST_CHECK_THROW(db.getMolecule(NUM_MOLECULES, mol), Base::IndexError);
+}
+
+BOOST_AUTO_TEST_CASE(SubstructureSearchDatabaseConcurrencyTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const std::size_t NUM_CALLERS = 4;
+	const char* file_name = "SubstructureSearchDatabaseConcurrencyTest.ssdb";
+
+	SubstructureSearchDatabase db;
+
+	initDatabase(db);
+
+	for (std::size_t k = 0; k < 2; k++) {
+		// first pass: molecule records in memory, second pass: molecule records read from file
+
+		if (k == 1) {
+			db.save(file_name);
+			db.open(file_name);
+		}
+
+		// each call distributes its work over two threads in addition
+
+		db.setNumThreads(2);
+
+		bool failed[NUM_CALLERS];
+		boost::thread_group callers;
+
+		for (std::size_t i = 0; i < NUM_CALLERS; i++)
+			callers.create_thread(boost::bind(&checkQueriesConcurrently, &db, i, NUM_QUERIES, &failed[i]));
+
+		callers.join_all();
+
+		for (std::size_t i = 0; i < NUM_CALLERS; i++)
+			BOOST_CHECK(!failed[i]);
+	}
+
+	std::remove(file_name);
+}
+
+BOOST_AUTO_TEST_CASE(SubstructureSearchDatabaseFileTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	const char* file_name = "SubstructureSearchDatabaseFileTest.ssdb";
+
+	SubstructureSearchDatabase db;
+
+	initDatabase(db);
+	db.save(file_name);
+
+	SubstructureSearchDatabase db2;
+
+	db2.open(file_name);
+
+	BOOST_CHECK(db2.getFileName() == file_name);
+	BOOST_CHECK(db2.getNumMolecules() == NUM_MOLECULES);
+	BOOST_CHECK(db2.getNumFingerprintBits() == db.getNumFingerprintBits());
+
+	Util::BitSet fp1, fp2;
+	BasicMolecule mol;
+
+	for (std::size_t i = 0; i < NUM_MOLECULES; i += 7) {
+		db.getFingerprint(i, fp1);
+		db2.getFingerprint(i, fp2);
+
+		BOOST_CHECK(fp1 == fp2);
+
+		db2.getMolecule(i, mol);
+
+		BOOST_CHECK(mol.getNumAtoms() == (hasAmine(i) ? 1 : 0) + getChainLength(i) + (hasPhenyl(i) ? 6 : 0));
+	}
+
+	checkQueries(db2, 0);
+
+	// molecules added after opening are kept in memory until the database gets saved to the opened file
+
+	BOOST_REQUIRE(parseSMILES("NCCCCBr", mol));
+	BOOST_CHECK(db2.addMolecule(mol) == NUM_MOLECULES);
+
+	MoleculeIndexList hits;
+
+	BOOST_CHECK(db2.findMatches(*parseSMARTS("Br"), hits) == 1);
+	BOOST_CHECK(hits.front() == NUM_MOLECULES);
+
+	db2.save(file_name);
+
+	BOOST_CHECK(db2.getNumMolecules() == NUM_MOLECULES + 1);
+	BOOST_CHECK(db2.findMatches(*parseSMARTS("Br"), hits) == 1);
+
+	db2.getMolecule(NUM_MOLECULES, mol);
+
+	BOOST_CHECK(mol.getNumAtoms() == 6);
+
+	MoleculeIndexList exp_hits;
+
+	getExpectedHits(QUERIES[0], exp_hits);
+	exp_hits.push_back(NUM_MOLECULES);
+
+	BOOST_CHECK(db2.findMatches(*parseSMARTS(QUERIES[0].smarts), hits) == exp_hits.size());
+	BOOST_CHECK(hits == exp_hits);
+
+	db2.clear();
+
+	BOOST_CHECK(db2.getNumMolecules() == 0);
+	BOOST_CHECK(db2.getFileName().empty());
+	BOOST_CHECK(db2.findMatches(*parseSMARTS("C"), hits) == 0);
+
+	std::remove(file_name);
+
+	BOOST_CHECK_THROW(db2.open(file_name), Base::IOError);
+}
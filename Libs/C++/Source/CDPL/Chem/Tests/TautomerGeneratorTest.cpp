@@ -0,0 +1,270 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * TautomerGeneratorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Chem/DefaultTautomerGenerator.hpp"
+#include "CDPL/Chem/TautomerScore.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/MoleculeFunctions.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/Atom.hpp"
+
+
+namespace
+{
+
+	typedef std::vector<std::string> SMILESList;
+
+	void initMolecule(CDPL::Chem::MolecularGraph& molgraph)
+	{
+		using namespace CDPL;
+		using namespace Chem;
+
+		calcImplicitHydrogenCounts(molgraph, false);
+		perceiveComponents(molgraph, false);
+		setRingFlags(molgraph, false);
+		perceiveHybridizationStates(molgraph, false);
+		perceiveSSSR(molgraph, false);
+		setAromaticityFlags(molgraph, false);
+	}
+
+	bool collectTautomer(CDPL::Chem::MolecularGraph& tautomer, SMILESList& tautomers)
+	{
+		using namespace CDPL;
+		using namespace Chem;
+
+		BasicMolecule mol(tautomer);
+		std::string smiles;
+
+		initMolecule(mol);
+		generateSMILES(mol, smiles, true);
+
+		tautomers.push_back(smiles);
+		return true;
+	}
+
+	void generateTautomers(CDPL::Chem::TautomerGenerator& gen, const std::string& smiles, SMILESList& tautomers)
+	{
+		using namespace CDPL;
+		using namespace Chem;
+
+		BasicMolecule mol;
+
+		BOOST_REQUIRE(parseSMILES(smiles, mol));
+
+		initMolecule(mol);
+		makeHydrogenComplete(mol);
+		initMolecule(mol);
+
+		tautomers.clear();
+
+		gen.setCallbackFunction(boost::bind(&collectTautomer, _1, boost::ref(tautomers)));
+		gen.generate(mol);
+	}
+
+	bool hasRingFlags(const CDPL::Chem::MolecularGraph& molgraph)
+	{
+		using namespace CDPL;
+		using namespace Chem;
+
+		for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it)
+			if (!hasRingFlag(*it))
+				return false;
+
+		return true;
+	}
+
+	bool checkUnperceivedTautomer(CDPL::Chem::MolecularGraph& tautomer, std::size_t& num_perceived)
+	{
+		if (hasRingFlags(tautomer))
+			num_perceived++;
+
+		return true;
+	}
+
+	double scorePerceivedTautomer(const CDPL::Chem::MolecularGraph& tautomer, std::size_t& num_unperceived)
+	{
+		if (!hasRingFlags(tautomer))
+			num_unperceived++;
+
+		return 0.0;
+	}
+
+	bool hasDuplicates(const SMILESList& tautomers)
+	{
+		return (std::set<std::string>(tautomers.begin(), tautomers.end()).size() != tautomers.size());
+	}
+
+	bool equalSets(const SMILESList& tautomers1, const SMILESList& tautomers2)
+	{
+		return (std::set<std::string>(tautomers1.begin(), tautomers1.end()) == std::set<std::string>(tautomers2.begin(), tautomers2.end()));
+	}
+
+	bool isSubset(const SMILESList& tautomers1, const SMILESList& tautomers2)
+	{
+		std::set<std::string> set2(tautomers2.begin(), tautomers2.end());
+
+		for (SMILESList::const_iterator it = tautomers1.begin(), end = tautomers1.end(); it != end; ++it)
+			if (set2.find(*it) == set2.end())
+				return false;
+
+		return true;
+	}
+
+	const char* TEST_MOLECULE = "CC(=O)CC(=O)CC(=O)NC(C)=N";
+}
+
+
+BOOST_AUTO_TEST_CASE(TautomerGeneratorTest)
+{
+	using namespace CDPL;
+	using namespace Chem;
+
+	DefaultTautomerGenerator gen;
+
+	BOOST_CHECK(gen.getNumThreads() == 1);
+	BOOST_CHECK(gen.getMaxNumTautomers() == 0);
+	BOOST_CHECK(gen.getMaxFrontierSize() == 0);
+	BOOST_CHECK(!gen.getScoringFunction());
+
+	// breadth-first expansion in the calling thread
+
+	SMILESList all_tauts;
+
+	generateTautomers(gen, TEST_MOLECULE, all_tauts);
+
+	BOOST_CHECK(all_tauts.size() > 5);
+	BOOST_CHECK(!hasDuplicates(all_tauts));
+
+	SMILESList tauts;
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts == all_tauts);
+
+	// concurrent expansion yields the same set of tautomers
+
+	gen.setNumThreads(4);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(!hasDuplicates(tauts));
+	BOOST_CHECK(equalSets(tauts, all_tauts));
+
+	gen.setNumThreads(1);
+
+	// tautomer count limit (the input structure gets reported first)
+
+	gen.setMaxNumTautomers(3);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts.size() == 3);
+	BOOST_CHECK(std::equal(tauts.begin(), tauts.end(), all_tauts.begin()));
+
+	gen.setMaxNumTautomers(1);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts.size() == 1);
+	BOOST_CHECK(tauts[0] == all_tauts[0]);
+
+	gen.setMaxNumTautomers(0);
+
+	// best-first expansion does not change the set of tautomers if no limits are set
+
+	gen.setScoringFunction(TautomerScore());
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts.size() == all_tauts.size());
+	BOOST_CHECK(tauts[0] == all_tauts[0]);
+	BOOST_CHECK(equalSets(tauts, all_tauts));
+
+	SMILESList best_first_tauts(tauts);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts == best_first_tauts);
+
+	gen.setNumThreads(4);
+	gen.setMaxNumTautomers(4);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(tauts.size() == 4);
+	BOOST_CHECK(!hasDuplicates(tauts));
+	BOOST_CHECK(isSubset(tauts, all_tauts));
+
+	gen.setNumThreads(1);
+	gen.setMaxNumTautomers(0);
+	gen.setScoringFunction(TautomerGenerator::ScoringFunction());
+
+	// frontier size limit
+
+	gen.setMaxFrontierSize(1);
+
+	generateTautomers(gen, TEST_MOLECULE, tauts);
+
+	BOOST_CHECK(!tauts.empty());
+	BOOST_CHECK(tauts.size() <= all_tauts.size());
+	BOOST_CHECK(tauts[0] == all_tauts[0]);
+	BOOST_CHECK(!hasDuplicates(tauts));
+	BOOST_CHECK(isSubset(tauts, all_tauts));
+
+	// scoring operates on a perceived copy, the reported tautomers are left unchanged
+
+	std::size_t num_perceived = 0;
+	std::size_t num_unperceived = 0;
+	BasicMolecule mol;
+
+	BOOST_REQUIRE(parseSMILES(TEST_MOLECULE, mol));
+
+	initMolecule(mol);
+	makeHydrogenComplete(mol);
+	initMolecule(mol);
+
+	gen.setMaxFrontierSize(0);
+	gen.regardStereochemistry(false);
+	gen.setScoringFunction(boost::bind(&scorePerceivedTautomer, _1, boost::ref(num_unperceived)));
+	gen.setCallbackFunction(boost::bind(&checkUnperceivedTautomer, _1, boost::ref(num_perceived)));
+	gen.generate(mol);
+
+	BOOST_CHECK(num_perceived == 0);
+	BOOST_CHECK(num_unperceived == 0);
+}
@@ -0,0 +1,210 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * Main.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Conformer generation throughput benchmark.
+ *
+ * Usage: confgen-benchmark [num_threads [smiles_file ...]]
+ *
+ * Runs ConformerGenerator with the default settings over the molecules of each given SMILES file (default: 
+ * the drug-like, macrocycle and highly flexible molecule sets in Data/Benchmarks/ConfGen) and reports the 
+ * throughput in molecules and conformers per second, the time spent in the individual processing phases, 
+ * the event counters and the peak memory usage of the process.
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include <boost/chrono/chrono.hpp>
+#include <boost/format.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <sys/resource.h>
+# define HAVE_GETRUSAGE
+#endif
+
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SMILESMoleculeReader.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/ConfGen/ConformerGenerator.hpp"
+#include "CDPL/ConfGen/MoleculeFunctions.hpp"
+#include "CDPL/ConfGen/ReturnCode.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const char* DEFAULT_DATA_SETS[] = { "DrugLike.smi", "Macrocycles.smi", "Flexible.smi" };
+
+	// the default timeouts (up to 30 min for macrocyclic ring systems) would let single molecules dominate the run time
+	const std::size_t MAX_MOLECULE_PROC_TIME = 30 * 1000;
+
+	long getPeakMemoryUsage()
+	{
+#ifdef HAVE_GETRUSAGE
+		rusage usage;
+
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return -1;
+
+# ifdef __APPLE__
+		return usage.ru_maxrss / 1024;
+# else
+		return usage.ru_maxrss;
+# endif
+#else
+		return -1;
+#endif
+	}
+
+	void printStatistics(const ConfGen::ProcessingStatistics& stats)
+	{
+		using namespace ConfGen;
+
+		for (int i = 0; i < ProcessingStatistics::NUM_PHASES; i++) {
+			ProcessingStatistics::Phase phase = ProcessingStatistics::Phase(i);
+
+			std::cout << boost::format("  %-32s %10.3f s\n") % ProcessingStatistics::getPhaseName(phase) % stats.getTime(phase);
+		}
+
+		for (int i = 0; i < ProcessingStatistics::NUM_COUNTERS; i++) {
+			ProcessingStatistics::Counter counter = ProcessingStatistics::Counter(i);
+
+			std::cout << boost::format("  %-32s %10u\n") % ProcessingStatistics::getCounterName(counter) % stats.getCount(counter);
+		}
+	}
+
+	bool runBenchmark(const std::string& file_name, std::size_t num_threads)
+	{
+		std::ifstream is(file_name.c_str());
+
+		if (!is) {
+			std::cerr << "Could not open molecule set '" << file_name << "'" << std::endl;
+			return false;
+		}
+
+		Chem::SMILESMoleculeReader reader(is);
+		Chem::BasicMolecule mol;
+		ConfGen::ConformerGenerator conf_gen;
+
+		Chem::setSMILESRecordFormatParameter(reader, "SN");
+
+		conf_gen.getSettings().setNumThreads(num_threads);
+		conf_gen.getSettings().setTimeout(MAX_MOLECULE_PROC_TIME);
+		conf_gen.enableStatistics(true);
+
+		std::size_t num_failed = 0;
+		std::size_t num_timeouts = 0;
+		double proc_time = 0.0;
+
+		while (reader.read(mol)) {
+			ConfGen::prepareForConformerGeneration(mol);
+
+			boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+			unsigned int ret_code = conf_gen.generate(mol);
+
+			proc_time += boost::chrono::duration<double>(boost::chrono::steady_clock::now() - start).count();
+
+			if (ret_code == ConfGen::ReturnCode::TIMEOUT)
+				num_timeouts++;
+
+			else if (ret_code != ConfGen::ReturnCode::SUCCESS)
+				num_failed++;
+
+			mol.clear();
+		}
+
+		const ConfGen::ProcessingStatistics& stats = conf_gen.getStatistics();
+		std::size_t num_mols = stats.getCount(ConfGen::ProcessingStatistics::MOLECULES);
+		std::size_t num_confs = stats.getCount(ConfGen::ProcessingStatistics::OUTPUT_CONFORMERS);
+
+		std::cout << "Molecule set: " << file_name << '\n';
+		std::cout << boost::format("  %-32s %10u\n") % "Failed molecules" % num_failed;
+		std::cout << boost::format("  %-32s %10u\n") % "Timed out molecules" % num_timeouts;
+		std::cout << boost::format("  %-32s %10.3f s\n") % "Total time" % proc_time;
+
+		if (proc_time > 0.0) {
+			std::cout << boost::format("  %-32s %10.3f\n") % "Molecules/s" % (num_mols / proc_time);
+			std::cout << boost::format("  %-32s %10.3f\n") % "Conformers/s" % (num_confs / proc_time);
+		}
+
+		printStatistics(stats);
+
+		long peak_mem = getPeakMemoryUsage();
+
+		if (peak_mem >= 0)
+			std::cout << boost::format("  %-32s %10d kB\n") % "Peak memory usage" % peak_mem;
+
+		std::cout << std::endl;
+
+		return true;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	std::size_t num_threads = 1;
+
+	if (argc > 1) {
+		char* end_ptr = 0;
+		long value = std::strtol(argv[1], &end_ptr, 10);
+
+		if (end_ptr == argv[1] || *end_ptr != '\0' || value < 0) {
+			std::cerr << "Error: invalid number of threads '" << argv[1] << "' (expected a non-negative integer)" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		num_threads = std::size_t(value);
+	}
+
+	std::vector<std::string> data_sets;
+
+	if (argc > 2)
+		data_sets.assign(argv + 2, argv + argc);
+	else
+		for (std::size_t i = 0; i < sizeof(DEFAULT_DATA_SETS) / sizeof(const char*); i++)
+			data_sets.push_back(std::string(CONFGEN_BENCHMARK_DATA_DIR) + '/' + DEFAULT_DATA_SETS[i]);
+
+	bool success = true;
+
+	try {
+		for (std::vector<std::string>::const_iterator it = data_sets.begin(), end = data_sets.end(); it != end; ++it)
+			success &= runBenchmark(*it, num_threads);
+
+	} catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
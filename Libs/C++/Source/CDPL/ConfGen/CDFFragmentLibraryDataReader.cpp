@@ -26,9 +26,6 @@
 
 #include "StaticInit.hpp"
 
-#include "CDPL/Chem/MolecularGraph.hpp"
-#include "CDPL/Base/Exceptions.hpp"
-
 #include "CDFFragmentLibraryDataReader.hpp"
 #include "CDFMoleculeDataFunctions.hpp"
 #include "CDFFormatData.hpp"
@@ -37,76 +34,23 @@
 using namespace CDPL;
 
 
-namespace
+bool ConfGen::CDFFragmentLibraryDataReader::read(std::istream& is, FragmentLibrary::Entry& entry)
 {
+	Base::uint64 mol_data_length;
 
-	class CDFMoleculeDataHolder : public Chem::MolecularGraph
-	{
-
-		void orderAtoms(const Chem::AtomCompareFunction& func) {}
-
-		void orderBonds(const Chem::BondCompareFunction& func) {}
-
-		const Chem::Atom& getAtom(std::size_t idx) const {
-			throw Base::IndexError("CDFMoleculeDataHolder: atom index out of bounds");
-		}
-		
-		Chem::Atom& getAtom(std::size_t idx) {
-			throw Base::IndexError("CDFMoleculeDataHolder: atom index out of bounds");
-		}
-
-		bool containsAtom(const Chem::Atom& atom) const {
-			return false;
-		}
-
-		std::size_t getAtomIndex(const Chem::Atom& atom) const {
-			throw Base::ItemNotFound("CDFMoleculeDataHolder: argument atom not part of the molecule");
-		}
-
-		std::size_t getNumAtoms() const {
-			return 0;
-		}
-
-		std::size_t getNumEntities() const {
-			return 0;
-		}
-
-		const Chem::Entity3D& getEntity(std::size_t idx) const {
-			throw Base::IndexError("CDFMoleculeDataHolder: entity index out of bounds");
-		}
-
-		Chem::Entity3D& getEntity(std::size_t idx) {
-			throw Base::IndexError("CDFMoleculeDataHolder: entity index out of bounds");
-		}
-
-		std::size_t getNumBonds() const {
-			return 0;
-		}
-	    
-		const Chem::Bond& getBond(std::size_t idx) const {
-			throw Base::IndexError("CDFMoleculeDataHolder: bond index out of bounds");
-		}
-
-		Chem::Bond& getBond(std::size_t idx) {
-			throw Base::IndexError("CDFMoleculeDataHolder: bond index out of bounds");
-		}
-
-		bool containsBond(const Chem::Bond& bond) const {
-			return false;
-		}
-
-		std::size_t getBondIndex(const Chem::Bond& bond) const {
-			throw Base::ItemNotFound("CDFMoleculeDataHolder: argument bond not part of the molecule");
-		}
-
-		Chem::MolecularGraph::SharedPointer clone() const {
-			return Chem::MolecularGraph::SharedPointer(new CDFMoleculeDataHolder(*this));
-		}
-	};
-}
+	if (!readEntryInfo(is, const_cast<Base::uint64&>(entry.first), mol_data_length))
+		return false;
+
+    MoleculeDataPointer mol_data_ptr(new Internal::ByteBuffer(mol_data_length));
 
+    readMoleculeData(is, mol_data_length, *mol_data_ptr);
 
-bool ConfGen::CDFFragmentLibraryDataReader::read(std::istream& is, FragmentLibrary::Entry& entry)
+    entry.second = createCDFMoleculeDataHolder(mol_data_ptr);
+
+    return true;
+}
+
+bool ConfGen::CDFFragmentLibraryDataReader::readEntryInfo(std::istream& is, Base::uint64& frag_hash, Base::uint64& mol_data_length)
 {
     CDF::Header header;
 
@@ -118,19 +62,13 @@ bool ConfGen::CDFFragmentLibraryDataReader::read(std::istream& is, FragmentLibra
     readData(is, header.recordDataLength, entryInfoBuffer);
 
     entryInfoBuffer.setIOPointer(0);
-    entryInfoBuffer.getInt(const_cast<Base::uint64&>(entry.first));
-
-	Base::uint64 mol_data_length;
-
+    entryInfoBuffer.getInt(frag_hash);
     entryInfoBuffer.getInt(mol_data_length);
 
-    MoleculeDataPointer mol_data_ptr(new Internal::ByteBuffer(mol_data_length));
-
-    readData(is, mol_data_length, *mol_data_ptr);
-
-    entry.second.reset(new CDFMoleculeDataHolder());
-
-    setCDFMoleculeData(*entry.second, mol_data_ptr);
-
     return true;
 }
+
+void ConfGen::CDFFragmentLibraryDataReader::readMoleculeData(std::istream& is, std::size_t length, Internal::ByteBuffer& data)
+{
+	readData(is, length, data);
+}
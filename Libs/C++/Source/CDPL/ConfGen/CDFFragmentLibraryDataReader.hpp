@@ -28,6 +28,7 @@
 #define CDPL_CONFGEN_CDFFRAGMENTLIBRARYDATAREADER_HPP
 
 #include <iosfwd>
+#include <cstddef>
 
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/Internal/CDFDataReaderBase.hpp"
@@ -46,6 +47,10 @@ namespace CDPL
 		public:
 			bool read(std::istream& is, FragmentLibrary::Entry& entry);
 
+			bool readEntryInfo(std::istream& is, Base::uint64& frag_hash, Base::uint64& mol_data_length);
+
+			void readMoleculeData(std::istream& is, std::size_t length, Internal::ByteBuffer& data);
+
 		private:
 			Internal::ByteBuffer entryInfoBuffer;
 		};
@@ -48,16 +48,19 @@ ConfGen::CDFFragmentLibraryDataWriter::CDFFragmentLibraryDataWriter(): molWriter
 
 bool ConfGen::CDFFragmentLibraryDataWriter::write(std::ostream& os, const FragmentLibrary::Entry& entry)
 {
-	const Internal::ByteBuffer* mol_buf = &molDataBuffer;
-
 	if (hasCDFMoleculeData(*entry.second)) 
-		mol_buf = getCDFMoleculeData(*entry.second).get();
-	else
-		molWriter.writeMolGraph(*entry.second, molDataBuffer);
+		return write(os, entry.first, *getCDFMoleculeData(*entry.second));
+
+	molWriter.writeMolGraph(*entry.second, molDataBuffer);
 
+	return write(os, entry.first, molDataBuffer);
+}
+
+bool ConfGen::CDFFragmentLibraryDataWriter::write(std::ostream& os, Base::uint64 frag_hash, const Internal::ByteBuffer& mol_data)
+{
 	entryInfoBuffer.setIOPointer(CDF::HEADER_SIZE);
-	entryInfoBuffer.putInt(entry.first, false);
-	entryInfoBuffer.putInt(boost::numeric_cast<Base::uint64>(mol_buf->getSize()), false);
+	entryInfoBuffer.putInt(frag_hash, false);
+	entryInfoBuffer.putInt(boost::numeric_cast<Base::uint64>(mol_data.getSize()), false);
 
 	entryInfoBuffer.resize(entryInfoBuffer.getIOPointer());
 	entryInfoBuffer.setIOPointer(0);
@@ -71,7 +74,7 @@ bool ConfGen::CDFFragmentLibraryDataWriter::write(std::ostream& os, const Fragme
 	putHeader(cdf_header, entryInfoBuffer);
 
 	entryInfoBuffer.writeBuffer(os);
-	mol_buf->writeBuffer(os);
+	mol_data.writeBuffer(os);
 
 	return os.good();
 }
@@ -50,6 +50,8 @@ namespace CDPL
 
 			bool write(std::ostream& os, const FragmentLibrary::Entry& entry);
 
+			bool write(std::ostream& os, Base::uint64 frag_hash, const Internal::ByteBuffer& mol_data);
+
 		private:
 			Internal::ByteBuffer       entryInfoBuffer;
 			Internal::ByteBuffer       molDataBuffer;
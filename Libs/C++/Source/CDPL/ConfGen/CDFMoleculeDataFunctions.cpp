@@ -42,9 +42,75 @@ namespace
 {
 
 	CDPL_DEFINE_LOOKUP_KEY(CDF_MOLECULE_DATA);
+
+	class CDFMoleculeDataHolder : public Chem::MolecularGraph
+	{
+
+		void orderAtoms(const Chem::AtomCompareFunction& func) {}
+
+		void orderBonds(const Chem::BondCompareFunction& func) {}
+
+		const Chem::Atom& getAtom(std::size_t idx) const {
+			throw Base::IndexError("CDFMoleculeDataHolder: atom index out of bounds");
+		}
+		
+		Chem::Atom& getAtom(std::size_t idx) {
+			throw Base::IndexError("CDFMoleculeDataHolder: atom index out of bounds");
+		}
+
+		bool containsAtom(const Chem::Atom& atom) const {
+			return false;
+		}
+
+		std::size_t getAtomIndex(const Chem::Atom& atom) const {
+			throw Base::ItemNotFound("CDFMoleculeDataHolder: argument atom not part of the molecule");
+		}
+
+		std::size_t getNumAtoms() const {
+			return 0;
+		}
+
+		std::size_t getNumEntities() const {
+			return 0;
+		}
+
+		const Chem::Entity3D& getEntity(std::size_t idx) const {
+			throw Base::IndexError("CDFMoleculeDataHolder: entity index out of bounds");
+		}
+
+		Chem::Entity3D& getEntity(std::size_t idx) {
+			throw Base::IndexError("CDFMoleculeDataHolder: entity index out of bounds");
+		}
+
+		std::size_t getNumBonds() const {
+			return 0;
+		}
+	    
+		const Chem::Bond& getBond(std::size_t idx) const {
+			throw Base::IndexError("CDFMoleculeDataHolder: bond index out of bounds");
+		}
+
+		Chem::Bond& getBond(std::size_t idx) {
+			throw Base::IndexError("CDFMoleculeDataHolder: bond index out of bounds");
+		}
+
+		bool containsBond(const Chem::Bond& bond) const {
+			return false;
+		}
+
+		std::size_t getBondIndex(const Chem::Bond& bond) const {
+			throw Base::ItemNotFound("CDFMoleculeDataHolder: argument bond not part of the molecule");
+		}
+
+		Chem::MolecularGraph::SharedPointer clone() const {
+			return Chem::MolecularGraph::SharedPointer(new CDFMoleculeDataHolder(*this));
+		}
+	};
 }
 
 
+
+
 const ConfGen::MoleculeDataPointer& ConfGen::getCDFMoleculeData(const Chem::MolecularGraph& molgraph)
 {
     return molgraph.getProperty<MoleculeDataPointer>(CDF_MOLECULE_DATA);
@@ -65,7 +131,21 @@ bool ConfGen::hasCDFMoleculeData(const Chem::MolecularGraph& molgraph)
     return molgraph.isPropertySet(CDF_MOLECULE_DATA);
 }
 
+Chem::MolecularGraph::SharedPointer ConfGen::createCDFMoleculeDataHolder(const MoleculeDataPointer& data)
+{
+	Chem::MolecularGraph::SharedPointer holder_ptr(new CDFMoleculeDataHolder());
+
+	setCDFMoleculeData(*holder_ptr, data);
+
+	return holder_ptr;
+}
+
 Chem::MolecularGraph::SharedPointer ConfGen::createMoleculeFromCDFData(const Chem::MolecularGraph& molgraph)
+{
+	return createMoleculeFromCDFData(*getCDFMoleculeData(molgraph));
+}
+
+Chem::MolecularGraph::SharedPointer ConfGen::createMoleculeFromCDFData(Internal::ByteBuffer& data)
 {
     using namespace Chem;
 
@@ -75,7 +155,7 @@ Chem::MolecularGraph::SharedPointer ConfGen::createMoleculeFromCDFData(const Che
  
     setStrictErrorCheckingParameter(ctrl_params, true);
 
-	if (!reader.readMolecule(*mol_ptr, *getCDFMoleculeData(molgraph)))
+	if (!reader.readMolecule(*mol_ptr, data))
 		throw Base::OperationFailed("createMoleculeFromCDFData(): error while reading CDF molecule data");
 
 	return mol_ptr;
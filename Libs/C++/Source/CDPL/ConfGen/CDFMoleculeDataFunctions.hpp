@@ -54,7 +54,11 @@ namespace CDPL
 
 	bool hasCDFMoleculeData(const Chem::MolecularGraph& molgraph);
 
+	Chem::MolecularGraph::SharedPointer createCDFMoleculeDataHolder(const MoleculeDataPointer& data);
+
 	Chem::MolecularGraph::SharedPointer createMoleculeFromCDFData(const Chem::MolecularGraph& molgraph);
+
+	Chem::MolecularGraph::SharedPointer createMoleculeFromCDFData(Internal::ByteBuffer& data);
     }
 }
 
@@ -153,3 +153,23 @@ ConfGen::ConformerGenerator::ConformerIterator ConfGen::ConformerGenerator::getC
 {
     return impl->getConformersEnd();
 }
+
+void ConfGen::ConformerGenerator::enableStatistics(bool enable)
+{
+	impl->enableStatistics(enable);
+}
+
+bool ConfGen::ConformerGenerator::statisticsEnabled() const
+{
+	return impl->statisticsEnabled();
+}
+
+const ConfGen::ProcessingStatistics& ConfGen::ConformerGenerator::getStatistics() const
+{
+	return impl->getStatistics();
+}
+
+void ConfGen::ConformerGenerator::clearStatistics()
+{
+	impl->clearStatistics();
+}
@@ -30,6 +30,7 @@
 #include <iterator>
 
 #include <boost/bind.hpp>
+#include <boost/thread.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions.hpp>
@@ -45,10 +46,12 @@
 #include "CDPL/Chem/AtomType.hpp"
 #include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
 #include "CDPL/ForceField/Exceptions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 #include "ConformerGeneratorImpl.hpp"
 #include "FragmentTreeNode.hpp"
 #include "UtilityFunctions.hpp"
+#include "ProcessingPhaseTimer.hpp"
 
 
 using namespace CDPL;
@@ -99,10 +102,12 @@ namespace
 ConfGen::ConformerGeneratorImpl::ConformerGeneratorImpl():
 	confDataCache(MAX_CONF_DATA_CACHE_SIZE), fragConfDataCache(MAX_FRAG_CONF_DATA_CACHE_SIZE),
 	confCombDataCache(MAX_FRAG_CONF_COMBINATION_CACHE_SIZE), settings(ConformerGeneratorSettings::DEFAULT),
-	energyMinimizer(boost::ref(mmff94GradientCalc), boost::ref(mmff94GradientCalc))
+	energyMinimizer(boost::ref(mmff94GradientCalc), boost::ref(mmff94GradientCalc)), collectStats(false)
 {
-	fragAssembler.setTimeoutCallback(boost::bind(&ConformerGeneratorImpl::timedout, this));
-	fragAssembler.setBondLengthFunction(boost::bind(&ConformerGeneratorImpl::getMMFF94BondLength, this, _1, _2));
+	fragLibs.push_back(FragmentLibrary::get());
+	torLibs.push_back(TorsionLibrary::get());
+
+	fragConfGenContexts.push_back(createFragmentConfGenContext());
 
 	torDriver.setTimeoutCallback(boost::bind(&ConformerGeneratorImpl::timedout, this));
 	
@@ -133,30 +138,48 @@ ConfGen::ConformerGeneratorSettings& ConfGen::ConformerGeneratorImpl::getSetting
 
 void ConfGen::ConformerGeneratorImpl::clearFragmentLibraries()
 {
-	fragAssembler.clearFragmentLibraries();
+	fragLibs.clear();
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it)
+		(*it)->fragAssembler.clearFragmentLibraries();
 }
 
 void ConfGen::ConformerGeneratorImpl::addFragmentLibrary(const FragmentLibrary::SharedPointer& lib)
 {
-	fragAssembler.addFragmentLibrary(lib);
+	fragLibs.push_back(lib);
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it)
+		(*it)->fragAssembler.addFragmentLibrary(lib);
 }
 
 void ConfGen::ConformerGeneratorImpl::clearTorsionLibraries()
 {
+	torLibs.clear();
 	torDriver.clearTorsionLibraries();
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it)
+		(*it)->torDriver.clearTorsionLibraries();
 }
 
 void ConfGen::ConformerGeneratorImpl::addTorsionLibrary(const TorsionLibrary::SharedPointer& lib)
 {
+	torLibs.push_back(lib);
 	torDriver.addTorsionLibrary(lib);
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it)
+		(*it)->torDriver.addTorsionLibrary(lib);
 }
 
 void ConfGen::ConformerGeneratorImpl::setAbortCallback(const CallbackFunction& func)
 {
 	abortCallback = func;
 
-	fragAssembler.setAbortCallback(func);
 	torDriver.setAbortCallback(func);
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it) {
+		(*it)->fragAssembler.setAbortCallback(func);
+		(*it)->torDriver.setAbortCallback(func);
+	}
 }
 
 const ConfGen::CallbackFunction& ConfGen::ConformerGeneratorImpl::getAbortCallback() const
@@ -179,7 +202,9 @@ void ConfGen::ConformerGeneratorImpl::setLogMessageCallback(const LogMessageCall
 	logCallback = func;
 
 	torDriver.setLogMessageCallback(func);
-	fragAssembler.setLogMessageCallback(func);
+
+	for (FragmentConfGenContextList::const_iterator it = fragConfGenContexts.begin(), end = fragConfGenContexts.end(); it != end; ++it)
+		setFragmentConfGenLogCallback(**it);
 }
 
 const ConfGen::LogMessageCallbackFunction& ConfGen::ConformerGeneratorImpl::getLogMessageCallback() const
@@ -194,6 +219,9 @@ unsigned int ConfGen::ConformerGeneratorImpl::generate(const Chem::MolecularGrap
 	const FragmentList& comps = *getComponents(molgraph);
 	unsigned int ret_code = ReturnCode::SUCCESS;
 
+	if (collectStats)
+		statistics.increment(ProcessingStatistics::MOLECULES);
+
 	if (molgraph.getNumAtoms() == 0 || comps.isEmpty()) {
 		outputConfs.clear();
 
@@ -217,6 +245,9 @@ unsigned int ConfGen::ConformerGeneratorImpl::generate(const Chem::MolecularGrap
 			ret_code = generateConformers(molgraph, comps, struct_gen_only);
 	}
 
+	if (collectStats)
+		statistics.increment(ProcessingStatistics::OUTPUT_CONFORMERS, outputConfs.size());
+
 	if (logCallback) {
 		logCallback(std::string(struct_gen_only ? "Structure" : "Conformer") + " generation finished with return code " + returnCodeToString(ret_code) + '\n');
 		logCallback("Processing time: " + timer.format(3, "%w") + "s\n");
@@ -256,6 +287,26 @@ ConfGen::ConformerGeneratorImpl::ConstConformerIterator ConfGen::ConformerGenera
 	return outputConfs.end();
 }
 
+void ConfGen::ConformerGeneratorImpl::enableStatistics(bool enable)
+{
+	collectStats = enable;
+}
+
+bool ConfGen::ConformerGeneratorImpl::statisticsEnabled() const
+{
+	return collectStats;
+}
+
+const ConfGen::ProcessingStatistics& ConfGen::ConformerGeneratorImpl::getStatistics() const
+{
+	return statistics;
+}
+
+void ConfGen::ConformerGeneratorImpl::clearStatistics()
+{
+	statistics.clear();
+}
+
 unsigned int ConfGen::ConformerGeneratorImpl::generateConformers(const Chem::MolecularGraph& molgraph, const Chem::FragmentList& comps, bool struct_gen_only)
 {
 	using namespace Chem;
@@ -473,6 +524,7 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersSystematic(bool
 
 	td_settings.setMaxPoolSize(settings.getMaxPoolSize());
 	td_settings.setEnergyWindow(settings.getEnergyWindow());
+	td_settings.setNumThreads(settings.getNumThreads());
 
 	splitIntoTorsionFragments();
 
@@ -481,6 +533,8 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersSystematic(bool
 	if (ret_code != ReturnCode::SUCCESS)
 		return ret_code;
 
+	ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::CONFORMER_COMBINATION);
+
 	if ((ret_code = generateFragmentConformerCombinations()) != ReturnCode::SUCCESS) 
 		return ret_code;
 	
@@ -536,7 +590,15 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersStochastic(bool
 		std::size_t j = 0;
 
 		for ( ; j < MAX_NUM_STRUCTURE_GEN_TRIALS; j++) {
-			if (!dgStructureGen.generate(conf_data)) 
+			bool generated;
+
+			{
+				ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::STRUCTURE_GENERATION);
+
+				generated = dgStructureGen.generate(conf_data);
+			}
+
+			if (!generated) 
 				continue;
 
 			if (!generateHydrogenCoordsAndMinimize(conf_data))
@@ -676,6 +738,11 @@ void ConfGen::ConformerGeneratorImpl::init(const Chem::MolecularGraph& molgraph,
 
 bool ConfGen::ConformerGeneratorImpl::generateHydrogenCoordsAndMinimize(ConformerData& conf_data)
 {
+	ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::ENERGY_MINIMIZATION);
+
+	if (collectStats)
+		statistics.increment(ProcessingStatistics::ENERGY_MINIMIZATIONS);
+
 	hCoordsGen.generate(conf_data, false);
 
 	Math::Vector3DArray::StorageType& conf_coords_data = conf_data.getData();
@@ -686,6 +753,9 @@ bool ConfGen::ConformerGeneratorImpl::generateHydrogenCoordsAndMinimize(Conforme
 	energyMinimizer.setup(conf_coords_data, energyGradient, 0.001, 0.25);
 
 	for (std::size_t j = 0; max_ref_iters == 0 || j < max_ref_iters; j++) {
+		if (collectStats)
+			statistics.increment(ProcessingStatistics::MINIMIZATION_ITERATIONS);
+
 		if (energyMinimizer.iterate(energy, conf_coords_data, energyGradient) != BFGSMinimizer::SUCCESS) {
 			if ((boost::math::isnan)(energy)) 
 				return false;
@@ -745,7 +815,18 @@ ConfGen::ConformerData::SharedPointer ConfGen::ConformerGeneratorImpl::getInputC
 		if (logCallback)
 			logCallback("Using provided input coordinates, generating missing hydrogen coordinates\n");
 
-		if (!generateHydrogenCoordsAndMinimize(*ipt_coords)) {
+		// only the hydrogens get moved - the contributions of interactions between core atoms need to be calculated only once
+
+		hAtomMask = coreAtomMask;
+		hAtomMask.flip();
+
+		mmff94GradientCalc.setMovableAtomMask(hAtomMask);
+
+		bool success = generateHydrogenCoordsAndMinimize(*ipt_coords);
+
+		mmff94GradientCalc.resetMovableAtomMask();
+
+		if (!success) {
 			if (logCallback)
 				logCallback("Generation of hydrogen coordinates failed!\n");
 
@@ -766,6 +847,8 @@ void ConfGen::ConformerGeneratorImpl::splitIntoTorsionFragments()
 {
 	using namespace Chem;
 
+	ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::FRAGMENT_SPLITTING);
+
 	std::size_t num_bonds = molGraph->getNumBonds();
 
 	tmpBitSet.resize(num_bonds);
@@ -799,12 +882,22 @@ void ConfGen::ConformerGeneratorImpl::splitIntoTorsionFragments()
 		torFragConfData.push_back(frag_conf_data);
 	}
 
+	if (collectStats)
+		statistics.increment(ProcessingStatistics::TORSION_FRAGMENTS, torFragConfData.size());
+
 	if (logCallback)
 		logCallback("Structure decomposed into " + boost::lexical_cast<std::string>(torFragConfData.size()) + " torsion fragment(s)\n");
 }
 
 bool ConfGen::ConformerGeneratorImpl::setupMMFF94Parameters(unsigned int ff_type)
 {
+	ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::FORCE_FIELD_SETUP);
+
+	if (settings.cacheForceFieldParameterization())
+		mmff94Parameterizer.setCache(ForceField::MMFF94ParameterizationCache::get());
+	else
+		mmff94Parameterizer.setCache(ForceField::MMFF94ParameterizationCache::SharedPointer());
+
 	try {
 		if (parameterizeMMFF94Interactions(*molGraph, mmff94Parameterizer, mmff94Data, ff_type, 
 										   settings.strictForceFieldParameterization(), settings.getDielectricConstant(),
@@ -827,46 +920,153 @@ bool ConfGen::ConformerGeneratorImpl::setupMMFF94Parameters(unsigned int ff_type
 
 unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(bool struct_gen_only)
 {
-	using namespace Chem;
+	std::size_t num_frags = torFragConfData.size();
+	std::size_t num_threads = settings.getNumThreads();
 
-	torDriver.getSettings().sampleAngleToleranceRanges(false);
+	if (num_threads == 0)
+		num_threads = boost::thread::hardware_concurrency();
 
-	FragmentAssemblerSettings& fa_settings = fragAssembler.getSettings();
+	num_threads = std::max(num_threads, std::size_t(1));
 
-	fa_settings.getFragmentBuildSettings() = settings.getFragmentBuildSettings();
-	fa_settings.enumerateRings(settings.enumerateRings());
-	fa_settings.setNitrogenEnumerationMode(settings.getNitrogenEnumerationMode());
-	fa_settings.generateCoordinatesFromScratch(settings.generateCoordinatesFromScratch());
+	std::size_t num_workers = std::max(std::min(num_threads, num_frags), std::size_t(1));
 
-	double e_window = settings.getEnergyWindow();
+	while (fragConfGenContexts.size() < num_workers)
+		fragConfGenContexts.push_back(createFragmentConfGenContext());
 
-	for (FragmentConfDataList::const_iterator it = torFragConfData.begin(), end = torFragConfData.end(); it != end; ++it) {
-		FragmentConfData& frag_conf_data = **it;
-		Fragment& frag = *frag_conf_data.fragment;
+	// if the torsion fragments get processed concurrently, torsion driving of each fragment is done single-threaded
 
-		if (logCallback)
-			logCallback("Generating conformers for torsion fragment " + getSMILES(frag) + "...\n");
+	for (std::size_t i = 0; i < num_workers; i++)
+		initFragmentConfGenContext(*fragConfGenContexts[i], num_workers > 1 ? std::size_t(1) : num_threads);
 
-		unsigned int ret_code = fragAssembler.assemble(frag, *molGraph);
+	unsigned int ret_code = ReturnCode::SUCCESS;
 
-		if (ret_code != ReturnCode::SUCCESS) {
-			if (ret_code == ReturnCode::TIMEOUT) {
-				if (logCallback)
-					logCallback("Time limit exceeded!\n");
+	if (num_workers == 1) {
+		FragmentConfGenContext& ctxt = *fragConfGenContexts.front();
 
-				return ReturnCode::CONF_GEN_FAILED;
+		for (FragmentConfDataList::const_iterator it = torFragConfData.begin(), end = torFragConfData.end(); it != end; ++it)
+			if ((ret_code = generateFragmentConformers(**it, ctxt, struct_gen_only)) != ReturnCode::SUCCESS)
+				break;
+
+	} else {
+		fragConfGenRetCodes.assign(num_frags, ReturnCode::SUCCESS);
+		fragConfGenLogs.assign(num_frags, std::string());
+
+		boost::atomic<std::size_t> next_idx(0);
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 1; i < num_workers; i++)
+			thread_grp.create_thread(boost::bind(&ConformerGeneratorImpl::processTorsionFragments, this, boost::ref(next_idx), 
+												 boost::ref(*fragConfGenContexts[i]), struct_gen_only));
+
+		processTorsionFragments(next_idx, *fragConfGenContexts.front(), struct_gen_only);
+
+		thread_grp.join_all();
+
+		for (std::size_t i = 0; i < num_workers; i++) {
+			FragmentConfGenContext& ctxt = *fragConfGenContexts[i];
+
+			if (!ctxt.errorMessage.empty()) {
+				std::string err_msg;
+
+				err_msg.swap(ctxt.errorMessage);
+
+				throw Base::OperationFailed("ConformerGenerator: " + err_msg);
 			}
+		}
 
-			return ret_code;
+		// emit the buffered log messages and report the first error in the order of sequential processing
+
+		for (std::size_t i = 0; i < num_frags; i++) {
+			if (logCallback && !fragConfGenLogs[i].empty())
+				logCallback(fragConfGenLogs[i]);
+
+			if ((ret_code = fragConfGenRetCodes[i]) != ReturnCode::SUCCESS)
+				break;
+		}
+	}
+
+	// fragments do not overlap, so the interaction masks and invertible nitrogen masks of the 
+	// individual contexts can be merged in any order
+
+	for (std::size_t i = 0; i < num_workers; i++) {
+		FragmentConfGenContext& ctxt = *fragConfGenContexts[i];
+
+		invertibleNMask |= ctxt.invertibleNMask;
+		mmff94InteractionMask &= ctxt.mmff94InteractionMask;
+
+		if (collectStats)
+			statistics += ctxt.statistics;
+	}
+
+	if (ret_code != ReturnCode::SUCCESS)
+		return ret_code;
+
+	std::sort(torFragConfData.begin(), torFragConfData.end(), &compareFragmentConfCount);
+
+	return ReturnCode::SUCCESS;
+}
+
+void ConfGen::ConformerGeneratorImpl::processTorsionFragments(boost::atomic<std::size_t>& next_idx, FragmentConfGenContext& ctxt, 
+															   bool struct_gen_only)
+{
+	std::size_t num_frags = torFragConfData.size();
+
+	try {
+		for (std::size_t i = next_idx++; i < num_frags; i = next_idx++) {
+			ctxt.logBuffer = &fragConfGenLogs[i];
+
+			if ((fragConfGenRetCodes[i] = generateFragmentConformers(*torFragConfData[i], ctxt, struct_gen_only)) != ReturnCode::SUCCESS) 
+				next_idx = num_frags;
+		}
+
+	} catch (const std::exception& e) {
+		ctxt.errorMessage = e.what();
+		next_idx = num_frags;
+
+		if (ctxt.errorMessage.empty())
+			ctxt.errorMessage = "unspecified error";
+	}
+
+	ctxt.logBuffer = 0;
+}
+
+unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(FragmentConfData& frag_conf_data, FragmentConfGenContext& ctxt, 
+																		 bool struct_gen_only)
+{
+	using namespace Chem;
+
+	double e_window = settings.getEnergyWindow();
+	Fragment& frag = *frag_conf_data.fragment;
+	FragmentAssemblerImpl& frag_assembler = ctxt.fragAssembler;
+	TorsionDriverImpl& tor_driver = ctxt.torDriver;
+
+	if (logCallback)
+		logFragmentConfGenMessage(&ctxt, "Generating conformers for torsion fragment " + getSMILES(frag) + "...\n");
+
+	unsigned int ret_code = frag_assembler.assemble(frag, *molGraph);
+
+	if (ret_code != ReturnCode::SUCCESS) {
+		if (ret_code == ReturnCode::TIMEOUT) {
+			if (logCallback)
+				logFragmentConfGenMessage(&ctxt, "Time limit exceeded!\n");
+
+			return ReturnCode::CONF_GEN_FAILED;
 		}
 
-		invertibleNMask |= fragAssembler.getInvertibleNitrogenMask();
+		return ret_code;
+	}
+
+	ctxt.invertibleNMask |= frag_assembler.getInvertibleNitrogenMask();
 
+	ProcessingStatistics* stats = (collectStats ? &ctxt.statistics : 0);
+
+	{
+		ProcessingPhaseTimer phase_timer(stats, ProcessingStatistics::FRAGMENT_SPLITTING);
 		std::size_t num_bonds = frag.getNumBonds();
 	
-		tmpBitSet.resize(num_bonds);
-		tmpBitSet.reset();
-		fragSplitBonds.clear();
+		ctxt.tmpBitSet.resize(num_bonds);
+		ctxt.tmpBitSet.reset();
+		ctxt.fragSplitBonds.clear();
 
 		for (std::size_t i = 0; i < num_bonds; i++) {
 			const Bond& bond = frag.getBond(i);
@@ -874,132 +1074,209 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(bool st
 			if (!isRotatableBond(bond, frag, false))
 				continue;
 
-			tmpBitSet.set(i);
-			fragSplitBonds.push_back(&bond);
+			ctxt.tmpBitSet.set(i);
+			ctxt.fragSplitBonds.push_back(&bond);
 		}
 
-		if (fragSplitBonds.empty()) {
-			fragments.clear();
-			fragments.addElement(frag_conf_data.fragment);
+		if (ctxt.fragSplitBonds.empty()) {
+			ctxt.fragments.clear();
+			ctxt.fragments.addElement(frag_conf_data.fragment);
 
 		} else 
-			Chem::splitIntoFragments(frag, fragments, tmpBitSet, false);
+			Chem::splitIntoFragments(frag, ctxt.fragments, ctxt.tmpBitSet, false);
+	}
 
-		if (logCallback && !fragSplitBonds.empty())
-			logCallback("Found " + boost::lexical_cast<std::string>(fragSplitBonds.size()) + " rotatable fragment bond(s), performing torsion driving...\n");
+	ProcessingPhaseTimer phase_timer(stats, ProcessingStatistics::TORSION_DRIVING);
 
-		torDriver.setup(fragments, *molGraph, fragSplitBonds.begin(), fragSplitBonds.end());
-		torDriver.setMMFF94Parameters(mmff94Data, mmff94InteractionMask);
+	if (logCallback && !ctxt.fragSplitBonds.empty())
+		logFragmentConfGenMessage(&ctxt, "Found " + boost::lexical_cast<std::string>(ctxt.fragSplitBonds.size()) + 
+								  " rotatable fragment bond(s), performing torsion driving...\n");
 
-		if (fragSplitBonds.empty()) {
-			FragmentTreeNode& frag_node = torDriver.getFragmentNode(0);
+	tor_driver.setup(ctxt.fragments, *molGraph, ctxt.fragSplitBonds.begin(), ctxt.fragSplitBonds.end());
+	tor_driver.setMMFF94Parameters(mmff94Data, ctxt.mmff94InteractionMask);
 
-			for (FragmentAssemblerImpl::ConstConformerIterator conf_it = fragAssembler.getConformersBegin(), conf_end = fragAssembler.getConformersEnd();
-				 conf_it != conf_end; ++conf_it) {
+	if (ctxt.fragSplitBonds.empty()) {
+		FragmentTreeNode& frag_node = tor_driver.getFragmentNode(0);
 
-				ConformerData& conf_data = **conf_it;
-				double energy = frag_node.calcMMFF94Energy(conf_data);
-				ConformerData::SharedPointer final_conf_data = confDataCache.get();
+		for (FragmentAssemblerImpl::ConstConformerIterator conf_it = frag_assembler.getConformersBegin(), conf_end = frag_assembler.getConformersEnd();
+			 conf_it != conf_end; ++conf_it) {
 
-				final_conf_data->swap(conf_data);
-				final_conf_data->setEnergy(energy);
+			ConformerData& conf_data = **conf_it;
+			double energy = frag_node.calcMMFF94Energy(conf_data);
+			ConformerData::SharedPointer final_conf_data = ctxt.confDataCache.get();
 
-				frag_conf_data.conformers.push_back(final_conf_data);
-			}
+			final_conf_data->swap(conf_data);
+			final_conf_data->setEnergy(energy);
 
-		} else {
-			double min_energy = 0.0;
+			frag_conf_data.conformers.push_back(final_conf_data);
+		}
 
-			for (FragmentAssemblerImpl::ConstConformerIterator fa_conf_it = fragAssembler.getConformersBegin(), fa_conf_end = fragAssembler.getConformersEnd();
-				 fa_conf_it != fa_conf_end; ++fa_conf_it) {
+	} else {
+		double min_energy = 0.0;
 
-				ConformerData& fa_conf_data = **fa_conf_it;
+		for (FragmentAssemblerImpl::ConstConformerIterator fa_conf_it = frag_assembler.getConformersBegin(), fa_conf_end = frag_assembler.getConformersEnd();
+			 fa_conf_it != fa_conf_end; ++fa_conf_it) {
 
-				torDriver.setInputCoordinates(fa_conf_data);
+			ConformerData& fa_conf_data = **fa_conf_it;
 
-				ret_code = torDriver.generateConformers();
+			tor_driver.setInputCoordinates(fa_conf_data);
 
-				if (ret_code != ReturnCode::SUCCESS) {
-					if (ret_code == ReturnCode::TIMEOUT) {
-						if (logCallback)
-							logCallback("Time limit exceeded!\n");
+			ret_code = tor_driver.generateConformers();
 
-						return ReturnCode::CONF_GEN_FAILED;
-					}
+			if (ret_code != ReturnCode::SUCCESS) {
+				if (ret_code == ReturnCode::TIMEOUT) {
+					if (logCallback)
+						logFragmentConfGenMessage(&ctxt, "Time limit exceeded!\n");
 
-					return ret_code;
+					return ReturnCode::CONF_GEN_FAILED;
 				}
 
-				if (struct_gen_only) {
-					TorsionDriverImpl::ConstConformerIterator min_e_conf = std::min_element(torDriver.getConformersBegin(), torDriver.getConformersEnd(), 
-																							&compareConformerEnergy);
+				return ret_code;
+			}
+
+			if (struct_gen_only) {
+				TorsionDriverImpl::ConstConformerIterator min_e_conf = std::min_element(tor_driver.getConformersBegin(), tor_driver.getConformersEnd(), 
+																						&compareConformerEnergy);
 
-					if (min_e_conf != torDriver.getConformersEnd()) {
-						ConformerData& conf_data = **min_e_conf;
-						double energy = conf_data.getEnergy();
+				if (min_e_conf != tor_driver.getConformersEnd()) {
+					ConformerData& conf_data = **min_e_conf;
+					double energy = conf_data.getEnergy();
 
-						if (frag_conf_data.conformers.empty() || energy < min_energy)
-							min_energy = energy;
+					if (frag_conf_data.conformers.empty() || energy < min_energy)
+						min_energy = energy;
 
-						else if (energy > (min_energy + e_window))
-							continue;
+					else if (energy > (min_energy + e_window))
+						continue;
 
-						ConformerData::SharedPointer final_conf_data = confDataCache.get();
+					ConformerData::SharedPointer final_conf_data = ctxt.confDataCache.get();
 
-						final_conf_data->swap(conf_data);
-						frag_conf_data.conformers.push_back(final_conf_data);
-					}
+					final_conf_data->swap(conf_data);
+					frag_conf_data.conformers.push_back(final_conf_data);
+				}
 
-				} else {
-					for (TorsionDriverImpl::ConstConformerIterator td_conf_it = torDriver.getConformersBegin(), td_conf_end = torDriver.getConformersEnd();
-						 td_conf_it != td_conf_end; ++td_conf_it) {
+			} else {
+				for (TorsionDriverImpl::ConstConformerIterator td_conf_it = tor_driver.getConformersBegin(), td_conf_end = tor_driver.getConformersEnd();
+					 td_conf_it != td_conf_end; ++td_conf_it) {
 
-						ConformerData& td_conf_data = **td_conf_it;
-						double energy = td_conf_data.getEnergy();
+					ConformerData& td_conf_data = **td_conf_it;
+					double energy = td_conf_data.getEnergy();
 
-						if (frag_conf_data.conformers.empty() || energy < min_energy)
-							min_energy = energy;
+					if (frag_conf_data.conformers.empty() || energy < min_energy)
+						min_energy = energy;
 
-						else if (energy > (min_energy + e_window))
-							continue;
+					else if (energy > (min_energy + e_window))
+						continue;
 
-						ConformerData::SharedPointer final_conf_data = confDataCache.get();
+					ConformerData::SharedPointer final_conf_data = ctxt.confDataCache.get();
 
-						final_conf_data->swap(td_conf_data);
-						frag_conf_data.conformers.push_back(final_conf_data);
-					}
+					final_conf_data->swap(td_conf_data);
+					frag_conf_data.conformers.push_back(final_conf_data);
 				}
 			}
+		}
 
-			if (frag_conf_data.conformers.size() > 1) {
-				double max_energy = min_energy + e_window;
+		if (frag_conf_data.conformers.size() > 1) {
+			double max_energy = min_energy + e_window;
 
-				for (ConformerDataArray::const_iterator conf_it = frag_conf_data.conformers.begin(), confs_end = frag_conf_data.conformers.end(); conf_it != confs_end; ++conf_it) {
-					const ConformerData::SharedPointer& conf_data = *conf_it;
+			for (ConformerDataArray::const_iterator conf_it = frag_conf_data.conformers.begin(), confs_end = frag_conf_data.conformers.end(); conf_it != confs_end; ++conf_it) {
+				const ConformerData::SharedPointer& conf_data = *conf_it;
 
-					if (conf_data->getEnergy() <= max_energy)
-						tmpWorkingConfs.push_back(conf_data);
-				}
-				
-				frag_conf_data.conformers.swap(tmpWorkingConfs);
-				tmpWorkingConfs.clear();
+				if (conf_data->getEnergy() <= max_energy)
+					ctxt.tmpConfs.push_back(conf_data);
 			}
+				
+			frag_conf_data.conformers.swap(ctxt.tmpConfs);
+			ctxt.tmpConfs.clear();
 		}
+	}
 
-		orderConformersByEnergy(frag_conf_data.conformers); 
+	orderConformersByEnergy(frag_conf_data.conformers); 
 
-		if (settings.getMaxPoolSize() > 0 && frag_conf_data.conformers.size() > settings.getMaxPoolSize())
-			frag_conf_data.conformers.resize(settings.getMaxPoolSize());
+	if (settings.getMaxPoolSize() > 0 && frag_conf_data.conformers.size() > settings.getMaxPoolSize())
+		frag_conf_data.conformers.resize(settings.getMaxPoolSize());
 
-		frag_conf_data.lastConfIdx = frag_conf_data.conformers.size();
+	frag_conf_data.lastConfIdx = frag_conf_data.conformers.size();
 
-		if (logCallback)
-			logCallback("Generated " + boost::lexical_cast<std::string>(frag_conf_data.lastConfIdx) + " torsion fragment conformer(s)\n");
+	if (logCallback)
+		logFragmentConfGenMessage(&ctxt, "Generated " + boost::lexical_cast<std::string>(frag_conf_data.lastConfIdx) + " torsion fragment conformer(s)\n");
+
+	return ReturnCode::SUCCESS;
+}
+
+ConfGen::ConformerGeneratorImpl::FragmentConfGenContextPtr ConfGen::ConformerGeneratorImpl::createFragmentConfGenContext()
+{
+	FragmentConfGenContextPtr ctxt_ptr(new FragmentConfGenContext());
+	FragmentConfGenContext& ctxt = *ctxt_ptr;
+
+	ctxt.confDataCache.setMaxSize(MAX_CONF_DATA_CACHE_SIZE);
+	ctxt.logBuffer = 0;
+
+	ctxt.fragAssembler.setTimeoutCallback(boost::bind(&ConformerGeneratorImpl::timedout, this));
+	ctxt.fragAssembler.setBondLengthFunction(boost::bind(&ConformerGeneratorImpl::getMMFF94BondLength, this, _1, _2));
+	ctxt.fragAssembler.setAbortCallback(abortCallback);
+	ctxt.fragAssembler.clearFragmentLibraries();
+
+	for (FragmentLibraryList::const_iterator it = fragLibs.begin(), end = fragLibs.end(); it != end; ++it)
+		ctxt.fragAssembler.addFragmentLibrary(*it);
+
+	ctxt.torDriver.setTimeoutCallback(boost::bind(&ConformerGeneratorImpl::timedout, this));
+	ctxt.torDriver.setAbortCallback(abortCallback);
+	ctxt.torDriver.clearTorsionLibraries();
+
+	for (TorsionLibraryList::const_iterator it = torLibs.begin(), end = torLibs.end(); it != end; ++it)
+		ctxt.torDriver.addTorsionLibrary(*it);
+
+	setFragmentConfGenLogCallback(ctxt);
+
+	return ctxt_ptr;
+}
+
+void ConfGen::ConformerGeneratorImpl::initFragmentConfGenContext(FragmentConfGenContext& ctxt, std::size_t num_tor_driver_threads)
+{
+	FragmentAssemblerSettings& fa_settings = ctxt.fragAssembler.getSettings();
+
+	fa_settings.getFragmentBuildSettings() = settings.getFragmentBuildSettings();
+	fa_settings.enumerateRings(settings.enumerateRings());
+	fa_settings.setNitrogenEnumerationMode(settings.getNitrogenEnumerationMode());
+	fa_settings.generateCoordinatesFromScratch(settings.generateCoordinatesFromScratch());
+
+	TorsionDriverSettings& td_settings = ctxt.torDriver.getSettings();
+
+	td_settings = torDriver.getSettings();
+	td_settings.sampleAngleToleranceRanges(false);
+	td_settings.setNumThreads(num_tor_driver_threads);
+
+	ctxt.mmff94InteractionMask = mmff94InteractionMask;
+	ctxt.invertibleNMask = invertibleNMask;
+	ctxt.logBuffer = 0;
+	ctxt.errorMessage.clear();
+	ctxt.statistics.clear();
+	ctxt.fragAssembler.setStatistics(collectStats ? &ctxt.statistics : 0);
+}
+
+void ConfGen::ConformerGeneratorImpl::setFragmentConfGenLogCallback(FragmentConfGenContext& ctxt)
+{
+	if (logCallback) {
+		LogMessageCallbackFunction func = boost::bind(&ConformerGeneratorImpl::logFragmentConfGenMessage, this, &ctxt, _1);
+
+		ctxt.fragAssembler.setLogMessageCallback(func);
+		ctxt.torDriver.setLogMessageCallback(func);
+
+	} else {
+		ctxt.fragAssembler.setLogMessageCallback(LogMessageCallbackFunction());
+		ctxt.torDriver.setLogMessageCallback(LogMessageCallbackFunction());
 	}
+}
 
-	std::sort(torFragConfData.begin(), torFragConfData.end(), &compareFragmentConfCount);
+void ConfGen::ConformerGeneratorImpl::logFragmentConfGenMessage(FragmentConfGenContext* ctxt, const std::string& msg)
+{
+	if (ctxt->logBuffer) {
+		ctxt->logBuffer->append(msg);
+		return;
+	}
 
-	return ReturnCode::SUCCESS;
+	if (logCallback)
+		logCallback(msg);
 }
 			
 unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformerCombinations()
@@ -1177,6 +1454,8 @@ bool ConfGen::ConformerGeneratorImpl::selectOutputConformers(bool struct_gen_onl
 {
 	using namespace Chem;
 
+	ProcessingPhaseTimer phase_timer(collectStats ? &statistics : 0, ProcessingStatistics::CONFORMER_SELECTION);
+
 	if (struct_gen_only) {
 		if (!outputConfs.empty())
 			return true;
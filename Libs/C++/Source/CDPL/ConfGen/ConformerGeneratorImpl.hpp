@@ -32,14 +32,18 @@
 #define CDPL_CONFGEN_CONFORMERGENERATORIMPL_HPP
 
 #include <vector>
+#include <string>
 #include <cstddef>
 #include <utility>
 
 #include <boost/timer/timer.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
 
 #include "CDPL/ConfGen/ConformerGeneratorSettings.hpp"
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
 #include "CDPL/ConfGen/CallbackFunction.hpp"
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
 #include "CDPL/ConfGen/RMSDConformerSelector.hpp"
 #include "CDPL/ConfGen/DGStructureGenerator.hpp"
 #include "CDPL/Chem/FragmentList.hpp"
@@ -107,12 +111,22 @@ namespace CDPL
 
 			ConstConformerIterator getConformersEnd() const;
 
+			void enableStatistics(bool enable);
+
+			bool statisticsEnabled() const;
+
+			const ProcessingStatistics& getStatistics() const;
+
+			void clearStatistics();
+
 		private:
 			struct FragmentConfData;
 			struct ConfCombinationData;
+			struct FragmentConfGenContext;
 
 			typedef Util::ObjectPool<FragmentConfData> FragmentConfDataCache;
 			typedef FragmentConfDataCache::SharedObjectPointer FragmentConfDataPtr;
+			typedef boost::shared_ptr<FragmentConfGenContext> FragmentConfGenContextPtr;
 		
 			ConformerGeneratorImpl(const ConformerGeneratorImpl&);
 
@@ -145,6 +159,20 @@ namespace CDPL
 			bool setupMMFF94Parameters(unsigned int ff_type);
 			
 			unsigned int generateFragmentConformers(bool struct_gen_only);
+
+			unsigned int generateFragmentConformers(FragmentConfData& frag_conf_data, FragmentConfGenContext& ctxt, 
+													bool struct_gen_only);
+
+			void processTorsionFragments(boost::atomic<std::size_t>& next_idx, FragmentConfGenContext& ctxt, 
+										 bool struct_gen_only);
+
+			FragmentConfGenContextPtr createFragmentConfGenContext();
+
+			void initFragmentConfGenContext(FragmentConfGenContext& ctxt, std::size_t num_tor_driver_threads);
+
+			void setFragmentConfGenLogCallback(FragmentConfGenContext& ctxt);
+
+			void logFragmentConfGenMessage(FragmentConfGenContext* ctxt, const std::string& msg);
 			
 			unsigned int generateFragmentConformerCombinations();
 		
@@ -194,6 +222,10 @@ namespace CDPL
 			typedef Util::ObjectStack<ConfCombinationData> ConfCombinationDataCache;
 			typedef Util::ObjectPool<ConformerData> ConformerDataCache;
 			typedef std::vector<FragmentConfDataPtr> FragmentConfDataList;
+			typedef std::vector<FragmentConfGenContextPtr> FragmentConfGenContextList;
+			typedef std::vector<FragmentLibrary::SharedPointer> FragmentLibraryList;
+			typedef std::vector<TorsionLibrary::SharedPointer> TorsionLibraryList;
+			typedef std::vector<std::string> StringArray;
 			typedef ForceField::MMFF94InteractionData MMFF94InteractionData;
 			typedef ForceField::MMFF94InteractionParameterizer MMFF94Parameterizer;
 			typedef ForceField::MMFF94GradientCalculator<double> MMFF94GradientCalculator;
@@ -201,9 +233,31 @@ namespace CDPL
 			typedef std::vector<ConfCombinationData*> ConfCombinationDataList;
 			typedef Math::BFGSMinimizer<Math::Vector3DArray::StorageType, double> BFGSMinimizer; 
 
+			struct FragmentConfGenContext
+			{
+
+				FragmentAssemblerImpl     fragAssembler;
+				TorsionDriverImpl         torDriver;
+				ConformerDataCache        confDataCache;
+				ForceFieldInteractionMask mmff94InteractionMask;
+				Util::BitSet              invertibleNMask;
+				Util::BitSet              tmpBitSet;
+				BondList                  fragSplitBonds;
+				Chem::FragmentList        fragments;
+				ConformerDataArray        tmpConfs;
+				std::string*              logBuffer;
+				std::string               errorMessage;
+				ProcessingStatistics      statistics;
+			};
+
 			ConformerDataCache                   confDataCache;
 			FragmentConfDataCache                fragConfDataCache;
 			ConfCombinationDataCache             confCombDataCache;
+			FragmentConfGenContextList           fragConfGenContexts;
+			FragmentLibraryList                  fragLibs;
+			TorsionLibraryList                   torLibs;
+			UIntArray                            fragConfGenRetCodes;
+			StringArray                          fragConfGenLogs;
 			ConformerGeneratorSettings           settings;
 			const Chem::MolecularGraph*          molGraph;
 			ConformerDataArray                   workingConfs;
@@ -215,7 +269,6 @@ namespace CDPL
 			boost::timer::cpu_timer              timer;
 			RMSDConformerSelector                confSelector;
 			TorsionDriverImpl                    torDriver;
-			FragmentAssemblerImpl                fragAssembler;
 			DGStructureGenerator                 dgStructureGen;
 			MMFF94Parameterizer                  mmff94Parameterizer;
 			MMFF94InteractionData                mmff94Data;
@@ -224,10 +277,10 @@ namespace CDPL
 			BFGSMinimizer                        energyMinimizer;
 			Chem::Hydrogen3DCoordinatesGenerator hCoordsGen;
 			BondList                             torDriveBonds;
-			BondList                             fragSplitBonds;
 			Chem::FragmentList                   fragments;
 			Util::BitSet                         tmpBitSet;
 			Util::BitSet                         coreAtomMask;
+			Util::BitSet                         hAtomMask;
 			Util::BitSet                         invertibleNMask;
 			Util::BitSet                         fixedAtomConfigMask;
 			FragmentConfDataList                 compConfData;
@@ -237,6 +290,8 @@ namespace CDPL
 			UIntArray                            parentAtomInds; 
 			Math::Vector3DArray::StorageType     energyGradient;
 			bool                                 inStochasticMode;
+			ProcessingStatistics                 statistics;
+			bool                                 collectStats;
 		};
     }
 }
@@ -39,9 +39,9 @@ using namespace CDPL;
 ConfGen::ConformerGeneratorSettings::ConformerGeneratorSettings():
 	samplingMode(ConformerSamplingMode::AUTO), sampleHetAtomHs(false), sampleTolRanges(true), 
 	enumRings(true), nitrogenEnumMode(NitrogenEnumerationMode::UNSPECIFIED_STEREO),
-	fromScratch(true), incInputCoords(false), eWindow(10.0), maxPoolSize(10000), timeout(60 * 60 * 1000), 
+	fromScratch(true), incInputCoords(false), eWindow(10.0), maxPoolSize(10000), timeout(60 * 60 * 1000), numThreads(1),
 	forceFieldTypeSys(ForceFieldType::MMFF94S_RTOR_NO_ESTAT), forceFieldTypeStoch(ForceFieldType::MMFF94S_RTOR), strictParam(true), 
-	dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DIELECTRIC_CONSTANT_WATER),
+	cacheParam(false), dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DIELECTRIC_CONSTANT_WATER),
 	distExponent(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DISTANCE_EXPONENT),
 	maxNumOutputConfs(100), minRMSD(0.5), maxNumRefIters(0), refTolerance(0.001), maxNumSampledConfs(2000),
 	convCheckCycleSize(100), mcRotorBondCountThresh(10)
@@ -147,6 +147,16 @@ std::size_t ConfGen::ConformerGeneratorSettings::getTimeout() const
 	return timeout;
 }
 
+void ConfGen::ConformerGeneratorSettings::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t ConfGen::ConformerGeneratorSettings::getNumThreads() const
+{
+	return numThreads;
+}
+
 void ConfGen::ConformerGeneratorSettings::setForceFieldTypeSystematic(unsigned int type)
 {
 	forceFieldTypeSys = type;
@@ -176,6 +186,16 @@ bool ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization() con
 {
 	return strictParam;
 }
+
+void ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization(bool cache)
+{
+	cacheParam = cache;
+}
+
+bool ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization() const
+{
+	return cacheParam;
+}
 			
 void ConfGen::ConformerGeneratorSettings::setDielectricConstant(double de_const)
 {
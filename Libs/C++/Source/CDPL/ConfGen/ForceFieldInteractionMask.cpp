@@ -70,3 +70,16 @@ void ConfGen::ForceFieldInteractionMask::setup(const ForceField::MMFF94Interacti
 		  ia_data.getVanDerWaalsInteractions().getSize(),
 		  ia_data.getElectrostaticInteractions().getSize());
 }
+
+ConfGen::ForceFieldInteractionMask& ConfGen::ForceFieldInteractionMask::operator&=(const ForceFieldInteractionMask& mask)
+{
+	bondStretching &= mask.bondStretching;
+	angleBending &= mask.angleBending;
+	stretchBend &= mask.stretchBend;
+	outOfPlaneBending &= mask.outOfPlaneBending;
+	torsion &= mask.torsion;
+	vanDerWaals &= mask.vanDerWaals;
+	electrostatic &= mask.electrostatic;
+
+	return *this;
+}
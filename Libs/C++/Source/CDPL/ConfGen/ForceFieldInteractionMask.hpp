@@ -56,6 +56,8 @@ namespace CDPL
 					  std::size_t num_els_ia);
 
 			void setup(const ForceField::MMFF94InteractionData& ia_data); 
+
+			ForceFieldInteractionMask& operator&=(const ForceFieldInteractionMask& mask);
 			
 			Util::BitSet bondStretching;
 			Util::BitSet angleBending;
@@ -57,6 +57,7 @@
 #include "TorsionLibraryDataReader.hpp"
 #include "FallbackTorsionLibrary.hpp"
 #include "FragmentConformerCache.hpp"
+#include "ProcessingPhaseTimer.hpp"
 #include "UtilityFunctions.hpp"
 
 
@@ -105,7 +106,7 @@ namespace
 
 ConfGen::FragmentAssemblerImpl::FragmentAssemblerImpl():
 	confDataCache(MAX_CONF_DATA_CACHE_SIZE), settings(FragmentAssemblerSettings::DEFAULT),
-	fragTree(MAX_TREE_CONF_DATA_CACHE_SIZE)
+	fragTree(MAX_TREE_CONF_DATA_CACHE_SIZE), statistics(0)
 {
 	fragLibs.push_back(FragmentLibrary::get());
 
@@ -202,6 +203,16 @@ const Util::BitSet& ConfGen::FragmentAssemblerImpl::getInvertibleNitrogenMask()
 	return invertibleNMask;
 }
 
+void ConfGen::FragmentAssemblerImpl::setStatistics(ProcessingStatistics* stats)
+{
+	statistics = stats;
+}
+
+ConfGen::ProcessingStatistics* ConfGen::FragmentAssemblerImpl::getStatistics() const
+{
+	return statistics;
+}
+
 unsigned int ConfGen::FragmentAssemblerImpl::assemble(const Chem::MolecularGraph& molgraph, 
 													  const Chem::MolecularGraph& parent_molgraph)
 {
@@ -303,7 +314,12 @@ unsigned int ConfGen::FragmentAssemblerImpl::getFragmentConformers()
 
 			initFragmentLibraryEntry(frag, frag_node);
 
-			if (!fetchConformersFromFragmentLibrary(frag_type, frag, frag_node) && !fetchConformersFromFragmentCache(frag_type, frag, frag_node)) {
+			if (!fetchConformersFromLibraryOrCache(frag_type, frag, frag_node)) {
+				ProcessingPhaseTimer phase_timer(statistics, ProcessingStatistics::FRAGMENT_CONFORMER_GENERATION);
+
+				if (statistics)
+					statistics->increment(ProcessingStatistics::GENERATED_FRAGMENTS);
+
 				unsigned int ret_code = generateFragmentConformers(frag_type, frag, frag_node);
 
 				if (ret_code != ReturnCode::SUCCESS) {
@@ -406,6 +422,28 @@ bool ConfGen::FragmentAssemblerImpl::copyInputCoordinates(unsigned int frag_type
 	return true;
 }
 
+bool ConfGen::FragmentAssemblerImpl::fetchConformersFromLibraryOrCache(unsigned int frag_type, const Chem::Fragment& frag, 
+																	   FragmentTreeNode* node)
+{
+	ProcessingPhaseTimer phase_timer(statistics, ProcessingStatistics::FRAGMENT_LIBRARY_LOOKUP);
+
+	if (fetchConformersFromFragmentLibrary(frag_type, frag, node)) {
+		if (statistics)
+			statistics->increment(ProcessingStatistics::FRAGMENT_LIBRARY_HITS);
+
+		return true;
+	}
+
+	if (fetchConformersFromFragmentCache(frag_type, frag, node)) {
+		if (statistics)
+			statistics->increment(ProcessingStatistics::FRAGMENT_CACHE_HITS);
+
+		return true;
+	}
+
+	return false;
+}
+
 bool ConfGen::FragmentAssemblerImpl::fetchConformersFromFragmentLibrary(unsigned int frag_type, const Chem::Fragment& frag, 
 																		FragmentTreeNode* node)
 {
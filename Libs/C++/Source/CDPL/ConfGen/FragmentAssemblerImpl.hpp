@@ -43,6 +43,7 @@
 #include "CDPL/ConfGen/FragmentLibraryEntry.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
 #include "CDPL/Chem/FragmentList.hpp"
 #include "CDPL/Util/ObjectStack.hpp"
 #include "CDPL/Util/BitSet.hpp"
@@ -106,6 +107,10 @@ namespace CDPL
 
 			const Util::BitSet& getInvertibleNitrogenMask() const;
 
+			void setStatistics(ProcessingStatistics* stats);
+
+			ProcessingStatistics* getStatistics() const;
+
 		private:
 			FragmentAssemblerImpl(const FragmentAssemblerImpl&);
 
@@ -120,6 +125,9 @@ namespace CDPL
 
 			bool copyInputCoordinates(unsigned int frag_type, const Chem::Fragment& frag, 
 									  FragmentTreeNode* node);
+			bool fetchConformersFromLibraryOrCache(unsigned int frag_type, const Chem::Fragment& frag, 
+												   FragmentTreeNode* node);
+
 			bool fetchConformersFromFragmentLibrary(unsigned int frag_type, const Chem::Fragment& frag, 
 													FragmentTreeNode* node);
 			bool fetchConformersFromFragmentCache(unsigned int frag_type, const Chem::Fragment& frag,
@@ -188,6 +196,7 @@ namespace CDPL
 			Util::BitSet                      invertibleNMask;
 			Util::BitSet                      invertedNMask;
 			Util::BitSet                      tmpBitSet;
+			ProcessingStatistics*             statistics;
 		};
     }
 }
@@ -49,6 +49,7 @@
 #include "CDPL/Math/VectorArrayFunctions.hpp"
 #include "CDPL/ForceField/UtilityFunctions.hpp"
 #include "CDPL/ForceField/Exceptions.hpp"
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
 
 #include "FragmentConformerGeneratorImpl.hpp"
 #include "UtilityFunctions.hpp"
@@ -85,6 +86,9 @@ ConfGen::FragmentConformerGeneratorImpl::FragmentConformerGeneratorImpl():
     dg_settings.regardBondConfiguration(true);
 	dg_settings.enablePlanarityConstraints(true);
 
+	// fragments extracted from the processed molecules recur frequently
+	mmff94Parameterizer.setCache(ForceField::MMFF94ParameterizationCache::get());
+
 	hCoordsGen.undefinedOnly(true);
 	hCoordsGen.setAtom3DCoordinatesCheckFunction(boost::bind(&FragmentConformerGeneratorImpl::has3DCoordinates, this, _1));
 
@@ -261,7 +265,18 @@ bool ConfGen::FragmentConformerGeneratorImpl::generateConformerFromInputCoordina
 		if (logCallback)
 			logCallback("Reusing fragment input cooordinates, generating missing hydrogen coordinates\n");
 
-		if (!generateHydrogenCoordsAndMinimize(*ipt_coords)) {
+		// only the hydrogens get moved - the contributions of interactions between core atoms need to be calculated only once
+
+		hAtomMask = coreAtomMask;
+		hAtomMask.flip();
+
+		mmff94GradientCalc.setMovableAtomMask(hAtomMask);
+
+		bool success = generateHydrogenCoordsAndMinimize(*ipt_coords);
+
+		mmff94GradientCalc.resetMovableAtomMask();
+
+		if (!success) {
 			if (logCallback)
 				logCallback("Generation of hydrogen coordinates failed!\n");
 
@@ -172,6 +172,7 @@ namespace CDPL
 			AtomList                               nbrHydrogens2;
 			Chem::Fragment                         symMappingSearchMolGraph;
 			Util::BitSet                           coreAtomMask;
+			Util::BitSet                           hAtomMask;
 			ConformerDataArray                     ringAtomCoords;
 			ConformerDataArray                     outputConfs;
 			ConformerDataArray                     workingConfs;
@@ -50,6 +50,8 @@
 #include "CDFFragmentLibraryDataReader.hpp"
 #include "CDFFragmentLibraryDataWriter.hpp"
 #include "CDFMoleculeDataFunctions.hpp"
+#include "IndexedFragmentLibraryData.hpp"
+#include "IndexedFragmentLibraryDataWriter.hpp"
 
 
 using namespace CDPL;
@@ -80,7 +82,7 @@ ConfGen::FragmentLibrary::SharedPointer ConfGen::FragmentLibrary::defaultLib = b
 
 ConfGen::FragmentLibrary::FragmentLibrary() {}
 
-ConfGen::FragmentLibrary::FragmentLibrary(const FragmentLibrary& lib) 
+ConfGen::FragmentLibrary::FragmentLibrary(const FragmentLibrary& lib): indexedData(lib.indexedData)
 {
 	for (HashToFragmentMap::iterator it = lib.hashToFragMap.begin(), end = lib.hashToFragMap.end(); it != end; ++it)
 		hashToFragMap.insert(Entry(it->first, hasCDFMoleculeData(*it->second) ? it->second->clone() : it->second));
@@ -94,6 +96,7 @@ ConfGen::FragmentLibrary& ConfGen::FragmentLibrary::operator=(const FragmentLibr
 		return *this;
 
 	hashToFragMap.clear();
+	indexedData = lib.indexedData;
 
 	for (HashToFragmentMap::iterator it = lib.hashToFragMap.begin(), end = lib.hashToFragMap.end(); it != end; ++it)
 		hashToFragMap.insert(Entry(it->first, hasCDFMoleculeData(*it->second) ? it->second->clone() : it->second));
@@ -103,8 +106,18 @@ ConfGen::FragmentLibrary& ConfGen::FragmentLibrary::operator=(const FragmentLibr
 
 void ConfGen::FragmentLibrary::addEntries(const FragmentLibrary& lib)
 {
-	for (HashToFragmentMap::iterator it = lib.hashToFragMap.begin(), end = lib.hashToFragMap.end(); it != end; ++it)
+	if (this == &lib)
+		return;
+
+	for (HashToFragmentMap::iterator it = lib.hashToFragMap.begin(), end = lib.hashToFragMap.end(); it != end; ++it) {
+		if (indexedData && indexedData->containsEntry(it->first))
+			continue;
+
 		hashToFragMap.insert(Entry(it->first, hasCDFMoleculeData(*it->second) ? it->second->clone() : it->second));
+	}
+
+	if (lib.indexedData && lib.indexedData != indexedData)
+		addIndexedEntries(*lib.indexedData);
 }
 
 bool ConfGen::FragmentLibrary::addEntry(Base::uint64 frag_hash, const Chem::MolecularGraph::SharedPointer& frag)
@@ -112,6 +125,9 @@ bool ConfGen::FragmentLibrary::addEntry(Base::uint64 frag_hash, const Chem::Mole
 	if (!frag)
 		return false;
 
+	if (indexedData && indexedData->containsEntry(frag_hash))
+		return false;
+
     return hashToFragMap.insert(Entry(frag_hash, frag)).second;
 }
 
@@ -119,8 +135,16 @@ const Chem::MolecularGraph::SharedPointer& ConfGen::FragmentLibrary::getEntry(Ba
 {
     HashToFragmentMap::iterator it = hashToFragMap.find(frag_hash);
 
-    if (it == hashToFragMap.end())
+    if (it == hashToFragMap.end()) {
+		if (indexedData) {
+			const Chem::MolecularGraph::SharedPointer* frag_ptr = indexedData->getEntry(frag_hash);
+
+			if (frag_ptr)
+				return *frag_ptr;
+		}
+
 		return NO_ENTRY;
+	}
 
 	loadMolStructure(*it);
 
@@ -129,22 +153,35 @@ const Chem::MolecularGraph::SharedPointer& ConfGen::FragmentLibrary::getEntry(Ba
 
 bool ConfGen::FragmentLibrary::containsEntry(Base::uint64 frag_hash) const
 {
-    return (hashToFragMap.find(frag_hash) != hashToFragMap.end());
+    if (hashToFragMap.find(frag_hash) != hashToFragMap.end())
+		return true;
+
+	return (indexedData && indexedData->containsEntry(frag_hash));
 }
 
 std::size_t ConfGen::FragmentLibrary::getNumEntries() const
 {
-    return hashToFragMap.size();
+    return (hashToFragMap.size() + (indexedData ? indexedData->getNumEntries() : std::size_t(0)));
 }
 
 void ConfGen::FragmentLibrary::clear()
 {
     hashToFragMap.clear();
+	indexedData.reset();
+	releasedIndexedData.reset();
 }
 
 bool ConfGen::FragmentLibrary::removeEntry(Base::uint64 frag_hash)
 {
-   return (hashToFragMap.erase(frag_hash) > 0);
+	if (hashToFragMap.erase(frag_hash) > 0)
+		return true;
+
+	if (!indexedData || !indexedData->containsEntry(frag_hash))
+		return false;
+
+	releaseIndexedData();
+
+	return (hashToFragMap.erase(frag_hash) > 0);
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::removeEntry(const EntryIterator& it)
@@ -154,21 +191,37 @@ ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::removeEntry(co
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::getEntriesBegin() const
 {
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+
+		releaseIndexedData();
+	}
+
     return ConstEntryIterator(hashToFragMap.begin(), boost::bind(&FragmentLibrary::loadMolStructure, this, _1));
 }
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::getEntriesEnd() const
 {
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+
+		releaseIndexedData();
+	}
+
     return ConstEntryIterator(hashToFragMap.end(), boost::bind(&FragmentLibrary::loadMolStructure, this, _1));
 }
 	
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::getEntriesBegin()
 {
+	releaseIndexedData();
+
     return EntryIterator(hashToFragMap.begin(), boost::bind(&FragmentLibrary::loadMolStructure, this, _1));
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::getEntriesEnd()
 {
+	releaseIndexedData();
+
     return EntryIterator(hashToFragMap.end(), boost::bind(&FragmentLibrary::loadMolStructure, this, _1));
 }
 
@@ -187,6 +240,9 @@ void ConfGen::FragmentLibrary::load(std::istream& is)
 			if (!reader.read(is, entry))
 				break;
 
+			if (indexedData && indexedData->containsEntry(entry.first))
+				continue;
+
 			hashToFragMap.insert(entry);
 
 		} catch (const std::exception& e) {
@@ -200,14 +256,22 @@ void ConfGen::FragmentLibrary::save(std::ostream& os) const
 	boost::lock_guard<boost::mutex> lock(mutex);
 	CDFFragmentLibraryDataWriter writer;
 
-	for (HashToFragmentMap::const_iterator it = hashToFragMap.begin(), end = hashToFragMap.end(); it != end; ++it) {
-		try {
+	try {
+		for (HashToFragmentMap::const_iterator it = hashToFragMap.begin(), end = hashToFragMap.end(); it != end; ++it)
 			if (!writer.write(os, *it))
-				throw Base::IOError("FragmentLibrary: unspecified error while saving fragment library");
+				throw Base::IOError("unspecified error");
 
-		} catch (const std::exception& e) {
-			throw Base::IOError("FragmentLibrary: error while saving fragment library: " + std::string(e.what()));
+		if (indexedData) {
+			Base::uint64 frag_hash;
+			Chem::MolecularGraph::SharedPointer frag;
+
+			for (std::size_t i = 0, num_slots = indexedData->getNumSlots(); i < num_slots; i++)
+				if (indexedData->getSlotEntry(i, frag_hash, frag) && !writer.write(os, Entry(frag_hash, frag)))
+					throw Base::IOError("unspecified error");
 		}
+
+	} catch (const std::exception& e) {
+		throw Base::IOError("FragmentLibrary: error while saving fragment library: " + std::string(e.what()));
 	}
 }
 
@@ -226,6 +290,52 @@ void ConfGen::FragmentLibrary::loadDefaults()
 	load(is);
 }
 
+void ConfGen::FragmentLibrary::loadIndexed(const std::string& file_name)
+{
+	IndexedDataPointer data(new IndexedFragmentLibraryData(file_name));
+
+	hashToFragMap.clear();
+	indexedData = data;
+	releasedIndexedData.reset();
+}
+
+void ConfGen::FragmentLibrary::saveIndexed(std::ostream& os) const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	try {
+		IndexedFragmentLibraryDataWriter writer(os);
+
+		for (HashToFragmentMap::const_iterator it = hashToFragMap.begin(), end = hashToFragMap.end(); it != end; ++it)
+			writer.addEntry(it->first, *it->second);
+
+		if (indexedData) {
+			Base::uint64 frag_hash;
+			const char* data;
+			std::size_t data_len;
+
+			for (std::size_t i = 0, num_slots = indexedData->getNumSlots(); i < num_slots; i++)
+				if (indexedData->getSlotEntryData(i, frag_hash, data, data_len))
+					writer.addEntry(frag_hash, data, data_len);
+		}
+
+		writer.close();
+
+	} catch (const std::exception& e) {
+		throw Base::IOError("FragmentLibrary: error while saving fragment library: " + std::string(e.what()));
+	}
+}
+
+bool ConfGen::FragmentLibrary::isIndexed() const
+{
+	return bool(indexedData);
+}
+
+bool ConfGen::FragmentLibrary::isIndexedFile(const std::string& file_name)
+{
+	return IndexedFragmentLibraryData::isIndexedFile(file_name);
+}
+
 void ConfGen::FragmentLibrary::set(const SharedPointer& lib)
 {
     defaultLib = (!lib ? builtinFragLib : lib);
@@ -249,3 +359,32 @@ ConfGen::FragmentLibrary::Entry& ConfGen::FragmentLibrary::loadMolStructure(Entr
 
 	return entry;
 }
+
+void ConfGen::FragmentLibrary::releaseIndexedData() const
+{
+	if (!indexedData)
+		return;
+
+	// the released data are kept alive since references returned by getEntry() may point into them
+
+	releasedIndexedData = indexedData;
+	indexedData.reset();
+
+	addIndexedEntries(*releasedIndexedData);
+}
+
+void ConfGen::FragmentLibrary::addIndexedEntries(const IndexedFragmentLibraryData& data) const
+{
+	Base::uint64 frag_hash;
+	Chem::MolecularGraph::SharedPointer frag;
+
+	for (std::size_t i = 0, num_slots = data.getNumSlots(); i < num_slots; i++) {
+		if (!data.getSlotEntry(i, frag_hash, frag))
+			continue;
+
+		if (indexedData && indexedData->containsEntry(frag_hash))
+			continue;
+
+		hashToFragMap.insert(Entry(frag_hash, frag));
+	}
+}
@@ -0,0 +1,495 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * FragmentLibraryMerger.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/ConfGen/FragmentLibraryMerger.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+#include "IndexedFragmentLibraryData.hpp"
+#include "IndexedFragmentLibraryDataWriter.hpp"
+#include "CDFFragmentLibraryDataReader.hpp"
+#include "CDFFragmentLibraryDataWriter.hpp"
+#include "CDFMoleculeDataFunctions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t MIN_PARALLEL_SORT_SIZE = 100000;
+	const std::size_t ABORT_CHECK_INTERVAL   = 1000;
+}
+
+
+class ConfGen::FragmentLibraryMerger::InputLibrary
+{
+
+  public:
+	InputLibrary(const std::string& file_name, std::size_t lib_idx):
+		fileName(file_name), libIndex(lib_idx) {}
+
+	void scan();
+
+	void getEntryData(const EntryRecord& rec, Internal::ByteBuffer& data);
+
+	EntryRecordList& getEntryRecords() {
+		return entryRecords;
+	}
+
+	std::string& getErrorMessage() {
+		return errorMessage;
+	}
+
+  private:
+	void scanIndexed();
+	void scanCDF();
+
+	std::string                               fileName;
+	std::size_t                               libIndex;
+	IndexedFragmentLibraryData::SharedPointer indexedData;
+	std::ifstream                             cdfStream;
+	CDFFragmentLibraryDataReader              cdfReader;
+	EntryRecordList                           entryRecords;
+	std::string                               errorMessage;
+};
+
+
+bool ConfGen::FragmentLibraryMerger::EntryRecord::operator<(const EntryRecord& rec) const
+{
+	if (fragHash < rec.fragHash)
+		return true;
+
+	if (fragHash > rec.fragHash)
+		return false;
+
+	if (libIndex < rec.libIndex)
+		return true;
+
+	if (libIndex > rec.libIndex)
+		return false;
+
+	return (location < rec.location);
+}
+
+
+void ConfGen::FragmentLibraryMerger::InputLibrary::scan()
+{
+	entryRecords.clear();
+
+	if (IndexedFragmentLibraryData::isIndexedFile(fileName))
+		scanIndexed();
+	else
+		scanCDF();
+}
+
+void ConfGen::FragmentLibraryMerger::InputLibrary::getEntryData(const EntryRecord& rec, Internal::ByteBuffer& data)
+{
+	if (indexedData) {
+		Base::uint64 frag_hash;
+		const char* entry_data;
+		std::size_t data_len;
+
+		if (!indexedData->getSlotEntryData(rec.location, frag_hash, entry_data, data_len))
+			throw Base::IOError("FragmentLibraryMerger: could not access entry data of fragment library '" + fileName + "'");
+
+		data.resize(data_len);
+		data.setIOPointer(0);
+
+		std::memcpy(data.getData(), entry_data, data_len);
+		return;
+	}
+
+	cdfStream.clear();
+
+	if (!cdfStream.seekg(rec.location))
+		throw Base::IOError("FragmentLibraryMerger: could not seek to entry data in fragment library '" + fileName + "'");
+
+	cdfReader.readMoleculeData(cdfStream, rec.dataLength, data);
+	data.setIOPointer(0);
+}
+
+void ConfGen::FragmentLibraryMerger::InputLibrary::scanIndexed()
+{
+	indexedData.reset(new IndexedFragmentLibraryData(fileName));
+
+	entryRecords.reserve(indexedData->getNumEntries());
+
+	EntryRecord rec;
+
+	rec.libIndex = libIndex;
+
+	for (std::size_t i = 0, num_slots = indexedData->getNumSlots(); i < num_slots; i++) {
+		const char* entry_data;
+		std::size_t data_len;
+
+		if (!indexedData->getSlotEntryData(i, rec.fragHash, entry_data, data_len))
+			continue;
+
+		rec.location = i;
+		rec.dataLength = data_len;
+
+		entryRecords.push_back(rec);
+	}
+}
+
+void ConfGen::FragmentLibraryMerger::InputLibrary::scanCDF()
+{
+	cdfStream.open(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+
+	if (!cdfStream)
+		throw Base::IOError("FragmentLibraryMerger: could not open fragment library '" + fileName + "'");
+
+	EntryRecord rec;
+
+	rec.libIndex = libIndex;
+
+	while (cdfReader.readEntryInfo(cdfStream, rec.fragHash, rec.dataLength)) {
+		rec.location = cdfStream.tellg();
+
+		if (!cdfStream.seekg(rec.dataLength, std::ios_base::cur))
+			throw Base::IOError("FragmentLibraryMerger: unexpected end of fragment library '" + fileName + "'");
+
+		entryRecords.push_back(rec);
+	}
+}
+
+
+ConfGen::FragmentLibraryMerger::FragmentLibraryMerger():
+	numThreads(1), indexedOutput(false), numInputEntries(0), numOutputEntries(0), numConflicts(0)
+{}
+
+ConfGen::FragmentLibraryMerger::~FragmentLibraryMerger() {}
+
+void ConfGen::FragmentLibraryMerger::addInputLibrary(const std::string& file_name)
+{
+	inputLibFiles.push_back(file_name);
+}
+
+const std::string& ConfGen::FragmentLibraryMerger::getInputLibrary(std::size_t idx) const
+{
+	if (idx >= inputLibFiles.size())
+		throw Base::IndexError("FragmentLibraryMerger: input library index out of bounds");
+
+	return inputLibFiles[idx];
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumInputLibraries() const
+{
+	return inputLibFiles.size();
+}
+
+void ConfGen::FragmentLibraryMerger::clearInputLibraries()
+{
+	inputLibFiles.clear();
+}
+
+void ConfGen::FragmentLibraryMerger::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumThreads() const
+{
+	return numThreads;
+}
+
+void ConfGen::FragmentLibraryMerger::setIndexedOutput(bool indexed)
+{
+	indexedOutput = indexed;
+}
+
+bool ConfGen::FragmentLibraryMerger::getIndexedOutput() const
+{
+	return indexedOutput;
+}
+
+void ConfGen::FragmentLibraryMerger::setAbortCallback(const CallbackFunction& func)
+{
+	abortCallback = func;
+}
+
+const ConfGen::CallbackFunction& ConfGen::FragmentLibraryMerger::getAbortCallback() const
+{
+	return abortCallback;
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumInputEntries() const
+{
+	return numInputEntries;
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumOutputEntries() const
+{
+	return numOutputEntries;
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumConflicts() const
+{
+	return numConflicts;
+}
+
+bool ConfGen::FragmentLibraryMerger::merge(std::ostream& os)
+{
+	numInputEntries = 0;
+	numOutputEntries = 0;
+	numConflicts = 0;
+
+	InputLibraryList libs;
+	EntryRecordList records;
+
+	for (std::size_t i = 0; i < inputLibFiles.size(); i++)
+		libs.push_back(InputLibraryPtr(new InputLibrary(inputLibFiles[i], i)));
+
+	if (!scanInputLibraries(libs, records))
+		return false;
+
+	numInputEntries = records.size();
+
+	if (!sortEntryRecords(records))
+		return false;
+
+	return writeOutput(os, libs, records);
+}
+
+std::size_t ConfGen::FragmentLibraryMerger::getNumWorkerThreads(std::size_t num_tasks) const
+{
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	return std::max(std::min(num_threads, num_tasks), std::size_t(1));
+}
+
+bool ConfGen::FragmentLibraryMerger::scanInputLibraries(InputLibraryList& libs, EntryRecordList& records)
+{
+	std::size_t num_threads = getNumWorkerThreads(libs.size());
+	boost::atomic<std::size_t> next_idx(0);
+
+	if (num_threads == 1)
+		scanLibraries(libs, next_idx);
+
+	else {
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 1; i < num_threads; i++)
+			thread_grp.create_thread(boost::bind(&FragmentLibraryMerger::scanLibraries, boost::ref(libs), boost::ref(next_idx)));
+
+		scanLibraries(libs, next_idx);
+
+		thread_grp.join_all();
+	}
+
+	std::size_t num_records = 0;
+
+	for (InputLibraryList::const_iterator it = libs.begin(), end = libs.end(); it != end; ++it) {
+		InputLibrary& lib = **it;
+
+		if (!lib.getErrorMessage().empty())
+			throw Base::IOError(lib.getErrorMessage());
+
+		num_records += lib.getEntryRecords().size();
+	}
+
+	if (aborted())
+		return false;
+
+	records.reserve(num_records);
+
+	for (InputLibraryList::const_iterator it = libs.begin(), end = libs.end(); it != end; ++it) {
+		EntryRecordList& lib_records = (*it)->getEntryRecords();
+
+		records.insert(records.end(), lib_records.begin(), lib_records.end());
+		EntryRecordList().swap(lib_records);
+	}
+
+	return true;
+}
+
+void ConfGen::FragmentLibraryMerger::scanLibraries(InputLibraryList& libs, boost::atomic<std::size_t>& next_idx)
+{
+	for (std::size_t i = next_idx++; i < libs.size(); i = next_idx++) {
+		InputLibrary& lib = *libs[i];
+
+		try {
+			lib.scan();
+
+		} catch (const std::exception& e) {
+			lib.getErrorMessage() = e.what();
+			next_idx = libs.size();
+
+			if (lib.getErrorMessage().empty())
+				lib.getErrorMessage() = "FragmentLibraryMerger: unspecified error";
+		}
+	}
+}
+
+bool ConfGen::FragmentLibraryMerger::sortEntryRecords(EntryRecordList& records) const
+{
+	std::size_t num_threads = getNumWorkerThreads(records.size() / MIN_PARALLEL_SORT_SIZE);
+
+	if (num_threads == 1) {
+		std::sort(records.begin(), records.end());
+		return !aborted();
+	}
+
+	// sort equally sized chunks in parallel, then merge adjacent pairs of sorted chunks until a single one remains
+
+	typedef std::vector<std::size_t> BoundaryList;
+
+	BoundaryList bounds;
+
+	for (std::size_t i = 0; i <= num_threads; i++)
+		bounds.push_back(records.size() * i / num_threads);
+
+	EntryRecordList::iterator recs_beg = records.begin();
+	boost::thread_group sort_thread_grp;
+
+	for (std::size_t i = 1; i < num_threads; i++)
+		sort_thread_grp.create_thread(boost::bind(&FragmentLibraryMerger::sortRecordRange, recs_beg + bounds[i], recs_beg + bounds[i + 1]));
+
+	sortRecordRange(recs_beg, recs_beg + bounds[1]);
+
+	sort_thread_grp.join_all();
+
+	while (bounds.size() > 2) {
+		if (aborted())
+			return false;
+
+		BoundaryList merged_bounds;
+		boost::thread_group merge_thread_grp;
+		std::size_t i = 0;
+
+		for ( ; i + 2 < bounds.size(); i += 2) {
+			merge_thread_grp.create_thread(boost::bind(&FragmentLibraryMerger::mergeRecordRanges, recs_beg + bounds[i],
+													   recs_beg + bounds[i + 1], recs_beg + bounds[i + 2]));
+			merged_bounds.push_back(bounds[i]);
+		}
+
+		for ( ; i < bounds.size(); i++)
+			merged_bounds.push_back(bounds[i]);
+
+		merge_thread_grp.join_all();
+		bounds.swap(merged_bounds);
+	}
+
+	return !aborted();
+}
+
+void ConfGen::FragmentLibraryMerger::sortRecordRange(EntryRecordList::iterator begin, EntryRecordList::iterator end)
+{
+	std::sort(begin, end);
+}
+
+void ConfGen::FragmentLibraryMerger::mergeRecordRanges(EntryRecordList::iterator begin, EntryRecordList::iterator mid, EntryRecordList::iterator end)
+{
+	std::inplace_merge(begin, mid, end);
+}
+
+bool ConfGen::FragmentLibraryMerger::writeOutput(std::ostream& os, InputLibraryList& libs, const EntryRecordList& records)
+{
+	boost::shared_ptr<IndexedFragmentLibraryDataWriter> indexed_writer;
+	CDFFragmentLibraryDataWriter cdf_writer;
+
+	if (indexedOutput)
+		indexed_writer.reset(new IndexedFragmentLibraryDataWriter(os));
+
+	Internal::ByteBuffer entry_data;
+	Internal::ByteBuffer cand_data;
+
+	for (EntryRecordList::const_iterator it = records.begin(), end = records.end(); it != end; ) {
+		if ((numOutputEntries % ABORT_CHECK_INTERVAL) == 0 && aborted())
+			return false;
+
+		const EntryRecord& rec = *it;
+
+		libs[rec.libIndex]->getEntryData(rec, entry_data);
+
+		EntryRecordList::const_iterator group_end = it + 1;
+
+		if (group_end != end && group_end->fragHash == rec.fragHash) {
+			// conflicting entries: keep the one with the most conformers, the records are ordered by library index
+			// and the first one wins ties
+
+			std::size_t max_num_confs = Chem::getNumConformations(*createMoleculeFromCDFData(entry_data));
+			bool conflict = false;
+
+			for ( ; group_end != end && group_end->fragHash == rec.fragHash; ++group_end) {
+				if (group_end->libIndex == group_end[-1].libIndex)
+					continue;
+
+				conflict = true;
+
+				libs[group_end->libIndex]->getEntryData(*group_end, cand_data);
+
+				std::size_t num_confs = Chem::getNumConformations(*createMoleculeFromCDFData(cand_data));
+
+				cand_data.setIOPointer(0);
+
+				if (num_confs > max_num_confs) {
+					max_num_confs = num_confs;
+					std::swap(entry_data, cand_data);
+				}
+			}
+
+			entry_data.setIOPointer(0);
+
+			if (conflict)
+				numConflicts++;
+		}
+
+		if (indexed_writer)
+			indexed_writer->addEntry(rec.fragHash, entry_data.getData(), entry_data.getSize());
+
+		else if (!cdf_writer.write(os, rec.fragHash, entry_data))
+			throw Base::IOError("FragmentLibraryMerger: writing output entry failed");
+
+		numOutputEntries++;
+		it = group_end;
+	}
+
+	if (indexed_writer)
+		indexed_writer->close();
+
+	return true;
+}
+
+bool ConfGen::FragmentLibraryMerger::aborted() const
+{
+	if (!abortCallback)
+		return false;
+
+	return abortCallback();
+}
@@ -41,6 +41,22 @@ namespace
 {
 
 	const std::size_t MAX_TREE_NODE_CACHE_SIZE  = 200;
+
+	struct LockedConformerDataRelease
+	{
+
+		LockedConformerDataRelease(const CDPL::ConfGen::ConformerData::SharedPointer& conf_data, boost::mutex& mutex): 
+			confData(conf_data), mutex(&mutex) {}
+
+		void operator()(CDPL::ConfGen::ConformerData*) {
+			boost::lock_guard<boost::mutex> lock(*mutex);
+
+			confData.reset();
+		}
+
+		CDPL::ConfGen::ConformerData::SharedPointer confData;
+		boost::mutex*                               mutex;
+	};
 }
 
 
@@ -50,7 +66,7 @@ using namespace CDPL;
 ConfGen::FragmentTree::FragmentTree(std::size_t max_conf_data_cache_size):
 	confDataCache(max_conf_data_cache_size),
 	nodeCache(boost::bind(&FragmentTree::createTreeNode, this), TreeNodeCache::DefaultDestructor(), MAX_TREE_NODE_CACHE_SIZE), 
-	molGraph(0)
+	molGraph(0), numThreads(1), numActiveThreads(0)
 {
 	nodeCache.setCleanupFunction(boost::bind(&FragmentTreeNode::clearConformers, _1));
 
@@ -90,6 +106,16 @@ const ConfGen::CallbackFunction& ConfGen::FragmentTree::getTimeoutCallback() con
 	return timeoutCallback;
 }
 
+void ConfGen::FragmentTree::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t ConfGen::FragmentTree::getNumThreads() const
+{
+	return numThreads;
+}
+
 std::size_t ConfGen::FragmentTree::getNumFragments() const
 {
 	return fragToNodeMap.size();
@@ -234,12 +260,55 @@ const Chem::Bond* ConfGen::FragmentTree::findConnectingBond(FragmentTreeNode* no
 
 ConfGen::ConformerData::SharedPointer ConfGen::FragmentTree::allocConformerData()
 {
-	ConformerData::SharedPointer conf_data = confDataCache.get();
+	if (numThreads == 1) {
+		ConformerData::SharedPointer conf_data = confDataCache.get();
+
+		conf_data->resize(molGraph->getNumAtoms());
+		conf_data->setEnergy(0.0);
+
+		return conf_data;
+	}
+
+	// subtrees may be processed concurrently - the conformer data cache must not be accessed
+	// without synchronization, neither for allocation nor for the automatic release
+
+	ConformerData::SharedPointer conf_data;
+
+	{
+		boost::lock_guard<boost::mutex> lock(confDataCacheMutex);
+
+		conf_data = confDataCache.get();
+	}
 
 	conf_data->resize(molGraph->getNumAtoms());
 	conf_data->setEnergy(0.0);
 
-	return conf_data;
+	ConformerData* conf_data_ptr = conf_data.get();
+
+	return ConformerData::SharedPointer(conf_data_ptr, LockedConformerDataRelease(conf_data, confDataCacheMutex));
+}
+
+bool ConfGen::FragmentTree::acquireThread()
+{
+	std::size_t max_num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	if (max_num_threads <= 1)
+		return false;
+
+	std::size_t num_active = numActiveThreads.load();
+
+	// the calling thread itself is not counted
+
+	while (num_active + 1 < max_num_threads)
+		if (numActiveThreads.compare_exchange_weak(num_active, num_active + 1))
+			return true;
+
+	return false;
+}
+
+void ConfGen::FragmentTree::releaseThread()
+{
+	numActiveThreads--;
 }
 
 ConfGen::FragmentTreeNode* ConfGen::FragmentTree::allocTreeNode()
@@ -35,6 +35,9 @@
 #include <vector>
 #include <cstddef>
 
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+
 #include "CDPL/ConfGen/ConformerData.hpp"
 #include "CDPL/ConfGen/CallbackFunction.hpp"
 #include "CDPL/Chem/Fragment.hpp"
@@ -78,6 +81,10 @@ namespace CDPL
 
 			const CallbackFunction& getTimeoutCallback() const;
 
+			void setNumThreads(std::size_t num_threads);
+
+			std::size_t getNumThreads() const;
+
 			const Chem::MolecularGraph* getMolecularGraph() const;
 
 			FragmentTreeNode* getRoot() const;
@@ -102,6 +109,9 @@ namespace CDPL
 
 			ConformerData::SharedPointer allocConformerData();
 
+			bool acquireThread();
+			void releaseThread();
+
 			FragmentTreeNode* allocTreeNode();
 			FragmentTreeNode* createTreeNode();
 
@@ -114,6 +124,7 @@ namespace CDPL
 			typedef std::vector<FragmentTreeNode*> TreeNodeList;
 			typedef std::vector<std::pair<Chem::Fragment::SharedPointer, FragmentTreeNode*> > FragmentToNodeMap;
 
+			boost::mutex                confDataCacheMutex;
 			ConformerDataCache          confDataCache;
 			TreeNodeCache               nodeCache;
 			const Chem::MolecularGraph* molGraph;
@@ -123,6 +134,8 @@ namespace CDPL
 			FragmentToNodeMap           fragToNodeMap;
 			CallbackFunction            abortCallback;
 			CallbackFunction            timeoutCallback;
+			std::size_t                 numThreads;
+			boost::atomic<std::size_t>  numActiveThreads;
 		};
     }
 }
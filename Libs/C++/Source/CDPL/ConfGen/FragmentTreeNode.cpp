@@ -28,6 +28,10 @@
 
 #include <cmath>
 #include <algorithm>
+#include <limits>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 
 #include "CDPL/ConfGen/ReturnCode.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
@@ -36,6 +40,7 @@
 #include "CDPL/Chem/AtomFunctions.hpp"
 #include "CDPL/Chem/UtilityFunctions.hpp"
 #include "CDPL/ForceField/UtilityFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 #include "FragmentTreeNode.hpp"
 #include "FragmentTree.hpp"
@@ -60,14 +65,31 @@ namespace
 		return (conf_data1->getEnergy() < conf_data2->getEnergy());
 	} 
 
+	bool spansSplitBond(std::size_t atom1_idx, std::size_t atom2_idx, const Util::BitSet& left_mask, const Util::BitSet& right_mask)
+	{
+		return ((left_mask.test(atom1_idx) && right_mask.test(atom2_idx)) || (right_mask.test(atom1_idx) && left_mask.test(atom2_idx)));
+	}
+
+	bool spansSplitBond(const ForceField::MMFF94TorsionInteraction& iaction, const Util::BitSet& left_mask, const Util::BitSet& right_mask)
+	{
+		std::size_t atom_inds[4] = { iaction.getAtom1Index(), iaction.getAtom2Index(), iaction.getAtom3Index(), iaction.getAtom4Index() };
+
+		return ((left_mask.test(atom_inds[0]) || left_mask.test(atom_inds[1]) || left_mask.test(atom_inds[2]) || left_mask.test(atom_inds[3])) &&
+				(right_mask.test(atom_inds[0]) || right_mask.test(atom_inds[1]) || right_mask.test(atom_inds[2]) || right_mask.test(atom_inds[3])));
+	}
+
 	const double CONFORMER_LINEUP_SPACING       = 4.0;
 	const double MAX_TORSION_REF_BOND_ANGLE_COS = std::cos(2.5 / 180.0 * M_PI);
 	const double MAX_PLANAR_ATOM_GEOM_OOP_ANGLE = 10.0 / 180.0 * M_PI;
+
+	// the buffered 14-7 potential reaches its minimum of approx. -1.0005648 * e_IJ at R_ij = 0.99618 * R_IJ* 
+
+	const double MMFF94_VDW_MIN_ENERGY_FACTOR   = 1.000565;
 }
 
 
 ConfGen::FragmentTreeNode::FragmentTreeNode(ConfGen::FragmentTree& owner): 
-	owner(owner), parent(0), splitBond(0), changed(true)
+	owner(owner), parent(0), splitBond(0), minMMFF94TorDepEnergy(0.0), minMMFF94VdWEnergy(0.0), changed(true)
 {
 	splitBondAtoms[0] = 0;
 	splitBondAtoms[1] = 0;
@@ -216,6 +238,8 @@ void ConfGen::FragmentTreeNode::distMMFF94Parameters(const ForceField::MMFF94Int
 											ia_mask.torsion, atomMask);
 
 	mmff94EnergyCalc.setup(mmff94Data);
+
+	splitMMFF94Parameters();
 }
 
 const ConfGen::ConformerDataArray& ConfGen::FragmentTreeNode::getConformers() const
@@ -306,12 +330,7 @@ unsigned int ConfGen::FragmentTreeNode::generateConformers(double e_window, std:
 		return ReturnCode::TORSION_DRIVING_FAILED;
 	}
 
-	unsigned int ret_code = leftChild->generateConformers(e_window, max_pool_size);
-
-	if (ret_code != ReturnCode::SUCCESS)
-		return ret_code;
-
-	ret_code = rightChild->generateConformers(e_window, max_pool_size);
+	unsigned int ret_code = generateChildConformers(e_window, max_pool_size);
 
 	if (ret_code != ReturnCode::SUCCESS)
 		return ret_code;
@@ -336,6 +355,72 @@ unsigned int ConfGen::FragmentTreeNode::generateConformers(double e_window, std:
 	return invokeCallbacks();
 }
 
+unsigned int ConfGen::FragmentTreeNode::generateChildConformers(double e_window, std::size_t max_pool_size)
+{
+	// the subtrees are independent of each other - if both of them require torsion driving
+	// and the owner grants an additional thread, the left subtree gets processed concurrently
+
+	if (!leftChild->conformers.empty() || !rightChild->conformers.empty() || 
+		!leftChild->hasChildren() || !rightChild->hasChildren() || !owner.acquireThread()) {
+
+		unsigned int ret_code = leftChild->generateConformers(e_window, max_pool_size);
+
+		if (ret_code != ReturnCode::SUCCESS)
+			return ret_code;
+
+		return rightChild->generateConformers(e_window, max_pool_size);
+	}
+
+	unsigned int left_ret_code = ReturnCode::SUCCESS;
+	unsigned int right_ret_code = ReturnCode::SUCCESS;
+	std::string left_error_msg;
+
+	try {
+		boost::thread left_thread(boost::bind(&FragmentTreeNode::generateConformersInThread, leftChild, e_window, max_pool_size,
+											  boost::ref(left_ret_code), boost::ref(left_error_msg)));
+		try {
+			right_ret_code = rightChild->generateConformers(e_window, max_pool_size);
+
+		} catch (...) {
+			left_thread.join();
+			throw;
+		}
+
+		left_thread.join();
+
+	} catch (...) {
+		owner.releaseThread();
+		throw;
+	}
+
+	owner.releaseThread();
+
+	if (!left_error_msg.empty())
+		throw Base::OperationFailed("FragmentTreeNode: " + left_error_msg);
+
+	if (left_ret_code != ReturnCode::SUCCESS)
+		return left_ret_code;
+
+	return right_ret_code;
+}
+
+void ConfGen::FragmentTreeNode::generateConformersInThread(double e_window, std::size_t max_pool_size, unsigned int& ret_code, 
+														   std::string& error_msg)
+{
+	try {
+		ret_code = generateConformers(e_window, max_pool_size);
+
+	} catch (const std::exception& e) {
+		error_msg = e.what();
+
+		if (error_msg.empty())
+			error_msg = "unspecified error";
+
+	} catch (...) {
+		error_msg = "unspecified error";
+	}
+}
+
 void ConfGen::FragmentTreeNode::lineupChildConformers(double e_window)
 {
 	std::size_t num_left_chld_confs = leftChild->conformers.size();
@@ -512,6 +597,8 @@ void ConfGen::FragmentTreeNode::alignAndRotateChildConformers(double e_window)
 				conformers.push_back(new_conf);
 
 			} else {
+				double tor_invar_energy = 0.0;
+
 				for (std::size_t k = 0; k < num_tor_angles; k++) {
 					if (!new_conf) {
 						new_conf = owner.allocConformerData();
@@ -522,7 +609,24 @@ void ConfGen::FragmentTreeNode::alignAndRotateChildConformers(double e_window)
 					rotateCoordinates(right_conf, rightChild->atomIndices, *new_conf, 
 										  torsionAngleSines[k], torsionAngleCosines[k], left_atom_idx);
 
-					double energy = conf_energy_sum + calcMMFF94Energy(*new_conf);
+					if (k == 0) {
+						tor_invar_energy = mmff94TorInvarEnergyCalc(new_conf->getData());
+
+						// skip all torsion angles of the conformer pair if even the lowest possible energy 
+						// would be out of the energy window
+
+						if (e_window > 0.0 && !conformers.empty() && 
+							(conf_energy_sum + tor_invar_energy + minMMFF94TorDepEnergy + 
+							 calcMinTorsionDependentMMFF94ElectrostaticEnergy(*new_conf)) > (min_energy + e_window))
+							break;
+					}
+
+					double max_tor_dep_energy = std::numeric_limits<double>::max();
+
+					if (e_window > 0.0 && !conformers.empty())
+						max_tor_dep_energy = min_energy + e_window - conf_energy_sum - tor_invar_energy;
+
+					double energy = conf_energy_sum + tor_invar_energy + calcTorsionDependentMMFF94Energy(*new_conf, max_tor_dep_energy);
 
 					if (e_window > 0.0) {
 						if (conformers.empty() || energy < min_energy) 
@@ -571,6 +675,151 @@ void ConfGen::FragmentTreeNode::removeOutOfWindowConformers(double max_energy)
 	tmpConformers.clear();
 }
 
+void ConfGen::FragmentTreeNode::splitMMFF94Parameters()
+{
+	// separate the interactions that depend on the torsion angle of the split bond (i.e. interactions between 
+	// atoms on different sides of the bond) from the ones that stay constant upon rotation about the bond
+
+	mmff94TorInvarData.clear();
+	mmff94TorDepData.clear();
+	minMMFF94TorDepEnergy = 0.0;
+	minMMFF94VdWEnergy = 0.0;
+
+	mmff94TorInvarData.getBondStretchingInteractions() = mmff94Data.getBondStretchingInteractions();
+	mmff94TorInvarData.getAngleBendingInteractions() = mmff94Data.getAngleBendingInteractions();
+	mmff94TorInvarData.getStretchBendInteractions() = mmff94Data.getStretchBendInteractions();
+	mmff94TorInvarData.getOutOfPlaneBendingInteractions() = mmff94Data.getOutOfPlaneBendingInteractions();
+
+	if (hasChildren() && splitBondAtoms[0] && splitBondAtoms[1]) {
+		Util::BitSet left_mask(leftChild->atomMask);
+		Util::BitSet right_mask(rightChild->atomMask);
+
+		left_mask -= rightChild->atomMask;
+		right_mask -= leftChild->atomMask;
+
+		using namespace ForceField;
+
+		for (MMFF94TorsionInteractionData::ConstElementIterator it = mmff94Data.getTorsionInteractions().getElementsBegin(), 
+				 end = mmff94Data.getTorsionInteractions().getElementsEnd(); it != end; ++it) {
+
+			const MMFF94TorsionInteraction& iaction = *it;
+
+			if (!spansSplitBond(iaction, left_mask, right_mask)) {
+				mmff94TorInvarData.getTorsionInteractions().addElement(iaction);
+				continue;
+			}
+
+			mmff94TorDepData.getTorsionInteractions().addElement(iaction);
+
+			minMMFF94TorDepEnergy += std::min(0.0, iaction.getTorsionParameter1()) + std::min(0.0, iaction.getTorsionParameter2()) +
+				std::min(0.0, iaction.getTorsionParameter3());
+		}
+
+		for (MMFF94ElectrostaticInteractionData::ConstElementIterator it = mmff94Data.getElectrostaticInteractions().getElementsBegin(), 
+				 end = mmff94Data.getElectrostaticInteractions().getElementsEnd(); it != end; ++it) {
+
+			const MMFF94ElectrostaticInteraction& iaction = *it;
+
+			if (spansSplitBond(iaction.getAtom1Index(), iaction.getAtom2Index(), left_mask, right_mask))
+				mmff94TorDepData.getElectrostaticInteractions().addElement(iaction);
+			else
+				mmff94TorInvarData.getElectrostaticInteractions().addElement(iaction);
+		}
+
+		for (MMFF94VanDerWaalsInteractionData::ConstElementIterator it = mmff94Data.getVanDerWaalsInteractions().getElementsBegin(), 
+				 end = mmff94Data.getVanDerWaalsInteractions().getElementsEnd(); it != end; ++it) {
+
+			const MMFF94VanDerWaalsInteraction& iaction = *it;
+
+			if (!spansSplitBond(iaction.getAtom1Index(), iaction.getAtom2Index(), left_mask, right_mask)) {
+				mmff94TorInvarData.getVanDerWaalsInteractions().addElement(iaction);
+				continue;
+			}
+
+			mmff94TorDepData.getVanDerWaalsInteractions().addElement(iaction);
+
+			minMMFF94VdWEnergy -= MMFF94_VDW_MIN_ENERGY_FACTOR * iaction.getEIJ();
+		}
+
+		// the lower bound of the electrostatic terms depends on the geometry of the child conformers 
+		// (see calcMinTorsionDependentMMFF94ElectrostaticEnergy())
+
+		minMMFF94TorDepEnergy += minMMFF94VdWEnergy;
+
+	} else {
+		mmff94TorInvarData.getTorsionInteractions() = mmff94Data.getTorsionInteractions();
+		mmff94TorInvarData.getElectrostaticInteractions() = mmff94Data.getElectrostaticInteractions();
+		mmff94TorInvarData.getVanDerWaalsInteractions() = mmff94Data.getVanDerWaalsInteractions();
+	}
+
+	mmff94TorInvarEnergyCalc.setup(mmff94TorInvarData);
+}
+
+double ConfGen::FragmentTreeNode::calcMinTorsionDependentMMFF94ElectrostaticEnergy(const Math::Vector3DArray& coords) const
+{
+	// the split bond is aligned to the x-axis and rotations of the right child conformer leave the x-coordinate and
+	// the distance to the x-axis of its atoms unchanged - the interatomic distance of a spanning atom pair thus stays 
+	// in the range [sqrt(dx^2 + (r1 - r2)^2), sqrt(dx^2 + (r1 + r2)^2)] and the energy of the pair is bounded by the 
+	// value at the lower (attractive pairs) or upper (repulsive pairs) end of the range
+
+	using namespace ForceField;
+
+	const Math::Vector3DArray::StorageType& coords_data = coords.getData();
+	double min_energy = 0.0;
+
+	for (MMFF94ElectrostaticInteractionData::ConstElementIterator it = mmff94TorDepData.getElectrostaticInteractions().getElementsBegin(), 
+			 end = mmff94TorDepData.getElectrostaticInteractions().getElementsEnd(); it != end; ++it) {
+
+		const MMFF94ElectrostaticInteraction& iaction = *it;
+		Math::Vector3D::ConstPointer atom1_pos = coords_data[iaction.getAtom1Index()].getData();
+		Math::Vector3D::ConstPointer atom2_pos = coords_data[iaction.getAtom2Index()].getData();
+
+		double dx = atom1_pos[0] - atom2_pos[0];
+		double r1 = std::sqrt(atom1_pos[1] * atom1_pos[1] + atom1_pos[2] * atom1_pos[2]);
+		double r2 = std::sqrt(atom2_pos[1] * atom2_pos[1] + atom2_pos[2] * atom2_pos[2]);
+		double dr = ((iaction.getAtom1Charge() * iaction.getAtom2Charge()) < 0.0 ? r1 - r2 : r1 + r2);
+
+		min_energy += calcMMFF94ElectrostaticEnergy<double>(std::sqrt(dx * dx + dr * dr), iaction.getAtom1Charge(), iaction.getAtom2Charge(),
+															iaction.getScalingFactor(), iaction.getDielectricConstant(), 
+															iaction.getDistanceExponent());
+	}
+
+	return min_energy;
+}
+
+double ConfGen::FragmentTreeNode::calcTorsionDependentMMFF94Energy(const Math::Vector3DArray& coords, double max_energy) const
+{
+	// the van der Waals terms are accumulated last - each one is bounded from below by approx. -1.0006 * e_IJ, so 
+	// the calculation can be stopped as soon as the partial energy plus the lower bound of the remaining 
+	// terms exceeds max_energy 
+
+	using namespace ForceField;
+
+	const Math::Vector3DArray::StorageType& coords_data = coords.getData();
+
+	double energy = calcMMFF94TorsionEnergy<double>(mmff94TorDepData.getTorsionInteractions().getElementsBegin(),
+													mmff94TorDepData.getTorsionInteractions().getElementsEnd(), coords_data);
+
+	energy += calcMMFF94ElectrostaticEnergy<double>(mmff94TorDepData.getElectrostaticInteractions().getElementsBegin(),
+													mmff94TorDepData.getElectrostaticInteractions().getElementsEnd(), coords_data);
+
+	double min_rem_energy = minMMFF94VdWEnergy;
+
+	for (MMFF94VanDerWaalsInteractionData::ConstElementIterator it = mmff94TorDepData.getVanDerWaalsInteractions().getElementsBegin(), 
+			 end = mmff94TorDepData.getVanDerWaalsInteractions().getElementsEnd(); it != end; ++it) {
+
+		if ((energy + min_rem_energy) > max_energy)
+			return (energy + min_rem_energy);
+
+		const MMFF94VanDerWaalsInteraction& iaction = *it;
+
+		energy += calcMMFF94VanDerWaalsEnergy<double>(iaction, coords_data);
+		min_rem_energy += MMFF94_VDW_MIN_ENERGY_FACTOR * iaction.getEIJ();
+	}
+
+	return energy;
+}
+
 void ConfGen::FragmentTreeNode::setParent(FragmentTreeNode* node)
 {
 	parent = node;
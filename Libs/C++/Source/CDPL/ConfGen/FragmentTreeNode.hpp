@@ -33,6 +33,7 @@
 
 #include <cstddef>
 #include <vector>
+#include <string>
 
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
@@ -132,12 +133,22 @@ namespace CDPL
 
 			FragmentTreeNode& operator=(const FragmentTreeNode&);
 
+			unsigned int generateChildConformers(double e_window, std::size_t max_pool_size);
+
+			void generateConformersInThread(double e_window, std::size_t max_pool_size, unsigned int& ret_code, 
+											std::string& error_msg);
+
 			void lineupChildConformers(double e_window);
 			void alignAndRotateChildConformers(double e_window);
 
 			void initTorsionAngleData();
 			void removeOutOfWindowConformers(double max_energy);
 
+			void splitMMFF94Parameters();
+
+			double calcMinTorsionDependentMMFF94ElectrostaticEnergy(const Math::Vector3DArray& coords) const;
+			double calcTorsionDependentMMFF94Energy(const Math::Vector3DArray& coords, double max_energy) const;
+
 			void setParent(FragmentTreeNode* node);
 			void setChildren(FragmentTreeNode* left, FragmentTreeNode* right);
 
@@ -195,6 +206,11 @@ namespace CDPL
 			DoubleArray             torsionAngleSines;
 			MMFF94InteractionData   mmff94Data;
 			MMFF94EnergyCalculator  mmff94EnergyCalc;
+			MMFF94InteractionData   mmff94TorInvarData;
+			MMFF94InteractionData   mmff94TorDepData;
+			MMFF94EnergyCalculator  mmff94TorInvarEnergyCalc;
+			double                  minMMFF94TorDepEnergy;
+			double                  minMMFF94VdWEnergy;
 			bool                    changed;
 		};
     }
@@ -0,0 +1,244 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * IndexedFragmentLibraryData.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+#include "IndexedFragmentLibraryData.hpp"
+#include "IndexedFragmentLibraryFormatData.hpp"
+
+
+using namespace CDPL;
+
+
+ConfGen::IndexedFragmentLibraryData::IndexedFragmentLibraryData(const std::string& file_name):
+	fileSize(0), numEntries(0), numSlots(0), slotData(0)
+{
+	using namespace IndexedFragLib;
+
+	try {
+
+#if defined(HAVE_BOOST_IOSTREAMS)
+
+		file.open(file_name);
+		fileSize = file.size();
+
+#else // defined(HAVE_BOOST_IOSTREAMS)
+
+		std::ifstream is(file_name.c_str(), std::ios_base::in | std::ios_base::binary);
+
+		if (!is)
+			throw Base::IOError("opening file failed");
+
+		file.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+
+		if (is.bad())
+			throw Base::IOError("reading file failed");
+
+		fileSize = file.size();
+
+#endif // defined(HAVE_BOOST_IOSTREAMS)
+
+	} catch (const std::exception& e) {
+		throw Base::IOError("IndexedFragmentLibraryData: could not open fragment library file '" + file_name + "': " + e.what());
+	}
+
+	const char* data = getFileData();
+
+	if (fileSize < HEADER_SIZE + TRAILER_SIZE || std::memcmp(data, MAGIC_CODE, MAGIC_CODE_SIZE) != 0 ||
+		std::memcmp(data + fileSize - MAGIC_CODE_SIZE, MAGIC_CODE, MAGIC_CODE_SIZE) != 0)
+		throw Base::IOError("IndexedFragmentLibraryData: '" + file_name + "' is not an indexed fragment library file");
+
+	if (getUInt64(data + MAGIC_CODE_SIZE) > CURR_FORMAT_VERSION)
+		throw Base::IOError("IndexedFragmentLibraryData: unsupported format version of fragment library file '" + file_name + "'");
+
+	const char* trailer = data + fileSize - TRAILER_SIZE;
+	Base::uint64 num_entries = getUInt64(trailer);
+	Base::uint64 num_slots = getUInt64(trailer + sizeof(Base::uint64));
+	Base::uint64 table_offs = getUInt64(trailer + 2 * sizeof(Base::uint64));
+
+	if (num_slots == 0 || (num_slots & (num_slots - 1)) != 0 || num_entries > num_slots || table_offs < HEADER_SIZE || 
+		table_offs > fileSize - TRAILER_SIZE || num_slots > (fileSize - TRAILER_SIZE - table_offs) / SLOT_SIZE)
+		throw Base::IOError("IndexedFragmentLibraryData: corrupt hash table in fragment library file '" + file_name + "'");
+
+	numEntries = num_entries;
+	numSlots = num_slots;
+	slotData = data + table_offs;
+
+	decodedEntries.reset(new DecodedEntryPtr[numSlots]);
+
+	for (std::size_t i = 0; i < numSlots; i++)
+		decodedEntries[i].store(0, boost::memory_order_relaxed);
+}
+
+ConfGen::IndexedFragmentLibraryData::~IndexedFragmentLibraryData()
+{
+	for (std::size_t i = 0; i < numSlots; i++)
+		delete decodedEntries[i].load(boost::memory_order_relaxed);
+}
+
+std::size_t ConfGen::IndexedFragmentLibraryData::getNumEntries() const
+{
+	return numEntries;
+}
+
+bool ConfGen::IndexedFragmentLibraryData::containsEntry(Base::uint64 frag_hash) const
+{
+	return (findSlot(frag_hash) != numSlots);
+}
+
+const Chem::MolecularGraph::SharedPointer* ConfGen::IndexedFragmentLibraryData::getEntry(Base::uint64 frag_hash) const
+{
+	std::size_t slot_idx = findSlot(frag_hash);
+
+	if (slot_idx == numSlots)
+		return 0;
+
+	const Chem::MolecularGraph::SharedPointer* frag_ptr = decodedEntries[slot_idx].load(boost::memory_order_acquire);
+
+	if (frag_ptr)
+		return frag_ptr;
+
+	return decodeEntry(slot_idx);
+}
+
+std::size_t ConfGen::IndexedFragmentLibraryData::getNumSlots() const
+{
+	return numSlots;
+}
+
+bool ConfGen::IndexedFragmentLibraryData::getSlotEntry(std::size_t slot_idx, Base::uint64& frag_hash, Chem::MolecularGraph::SharedPointer& frag) const
+{
+	const char* data;
+	std::size_t data_len;
+
+	if (!getSlotEntryData(slot_idx, frag_hash, data, data_len))
+		return false;
+
+	const Chem::MolecularGraph::SharedPointer* frag_ptr = decodedEntries[slot_idx].load(boost::memory_order_acquire);
+
+	if (frag_ptr) {
+		frag = *frag_ptr;
+		return true;
+	}
+
+	MoleculeDataPointer mol_data_ptr(new Internal::ByteBuffer(data_len));
+
+	mol_data_ptr->putBytes(data, data_len);
+	mol_data_ptr->setIOPointer(0);
+
+	frag = createCDFMoleculeDataHolder(mol_data_ptr);
+
+	return true;
+}
+
+bool ConfGen::IndexedFragmentLibraryData::getSlotEntryData(std::size_t slot_idx, Base::uint64& frag_hash, const char*& data, std::size_t& data_len) const
+{
+	using namespace IndexedFragLib;
+
+	const char* slot = slotData + slot_idx * SLOT_SIZE;
+	Base::uint64 data_offs = getUInt64(slot + sizeof(Base::uint64));
+
+	if (data_offs == 0)
+		return false;
+
+	Base::uint64 length = getUInt64(slot + 2 * sizeof(Base::uint64));
+
+	if (data_offs < HEADER_SIZE || data_offs > fileSize || length > fileSize - data_offs)
+		throw Base::IOError("IndexedFragmentLibraryData: corrupt hash table entry");
+
+	frag_hash = getUInt64(slot);
+	data = getFileData() + data_offs;
+	data_len = length;
+
+	return true;
+}
+
+bool ConfGen::IndexedFragmentLibraryData::isIndexedFile(const std::string& file_name)
+{
+	using namespace IndexedFragLib;
+
+	std::ifstream is(file_name.c_str(), std::ios_base::in | std::ios_base::binary);
+	char magic_code[MAGIC_CODE_SIZE];
+
+	if (!is.read(magic_code, MAGIC_CODE_SIZE))
+		return false;
+
+	return (std::memcmp(magic_code, MAGIC_CODE, MAGIC_CODE_SIZE) == 0);
+}
+
+const char* ConfGen::IndexedFragmentLibraryData::getFileData() const
+{
+	return &file.data()[0];
+}
+
+std::size_t ConfGen::IndexedFragmentLibraryData::findSlot(Base::uint64 frag_hash) const
+{
+	using namespace IndexedFragLib;
+
+	for (std::size_t i = getSlotIndex(frag_hash, numSlots), j = 0; j < numSlots; i = (i + 1) & (numSlots - 1), j++) {
+		const char* slot = slotData + i * SLOT_SIZE;
+
+		if (getUInt64(slot + sizeof(Base::uint64)) == 0)
+			return numSlots;
+
+		if (getUInt64(slot) == frag_hash)
+			return i;
+	}
+
+	return numSlots;
+}
+
+const Chem::MolecularGraph::SharedPointer* ConfGen::IndexedFragmentLibraryData::decodeEntry(std::size_t slot_idx) const
+{
+	Base::uint64 frag_hash;
+	const char* data;
+	std::size_t data_len;
+
+	getSlotEntryData(slot_idx, frag_hash, data, data_len);
+
+	Internal::ByteBuffer mol_data(data_len);
+
+	mol_data.putBytes(data, data_len);
+	mol_data.setIOPointer(0);
+
+	Chem::MolecularGraph::SharedPointer* frag_ptr = new Chem::MolecularGraph::SharedPointer(createMoleculeFromCDFData(mol_data));
+	const Chem::MolecularGraph::SharedPointer* exp_ptr = 0;
+
+	// another thread may have decoded the same entry in the meantime - the first published result wins
+	
+	if (decodedEntries[slot_idx].compare_exchange_strong(exp_ptr, frag_ptr, boost::memory_order_acq_rel, boost::memory_order_acquire))
+		return frag_ptr;
+
+	delete frag_ptr;
+
+	return exp_ptr;
+}
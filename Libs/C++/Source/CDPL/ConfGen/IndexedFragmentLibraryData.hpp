@@ -0,0 +1,123 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * IndexedFragmentLibraryData.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATA_HPP
+#define CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATA_HPP
+
+#include <string>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/atomic.hpp>
+
+#include "CDPL/Config.hpp"
+
+#if defined(HAVE_BOOST_IOSTREAMS)
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#else // defined(HAVE_BOOST_IOSTREAMS)
+
+#include <vector>
+
+#endif // defined(HAVE_BOOST_IOSTREAMS)
+
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+
+#include "CDFMoleculeDataFunctions.hpp"
+
+
+namespace CDPL 
+{
+
+    namespace ConfGen 
+    {
+
+		/*
+		 * Read-only view of a memory-mapped fragment library file in the indexed format (see IndexedFragmentLibraryFormatData.hpp).
+		 * Entry lookups do not require any locking. The CDF data of an entry get decoded on first access and
+		 * the resulting molecule is published atomically.
+		 */
+		class IndexedFragmentLibraryData
+		{
+	    
+		public:
+			typedef boost::shared_ptr<IndexedFragmentLibraryData> SharedPointer;
+
+			IndexedFragmentLibraryData(const std::string& file_name);
+
+			~IndexedFragmentLibraryData();
+
+			std::size_t getNumEntries() const;
+
+			bool containsEntry(Base::uint64 frag_hash) const;
+
+			const Chem::MolecularGraph::SharedPointer* getEntry(Base::uint64 frag_hash) const;
+
+			std::size_t getNumSlots() const;
+
+			bool getSlotEntry(std::size_t slot_idx, Base::uint64& frag_hash, Chem::MolecularGraph::SharedPointer& frag) const;
+
+			bool getSlotEntryData(std::size_t slot_idx, Base::uint64& frag_hash, const char*& data, std::size_t& data_len) const;
+
+			static bool isIndexedFile(const std::string& file_name);
+
+		private:
+			IndexedFragmentLibraryData(const IndexedFragmentLibraryData&);
+
+			IndexedFragmentLibraryData& operator=(const IndexedFragmentLibraryData&);
+
+			const char* getFileData() const;
+
+			std::size_t findSlot(Base::uint64 frag_hash) const;
+
+			const Chem::MolecularGraph::SharedPointer* decodeEntry(std::size_t slot_idx) const;
+
+			typedef boost::atomic<const Chem::MolecularGraph::SharedPointer*> DecodedEntryPtr;
+			typedef boost::scoped_array<DecodedEntryPtr> DecodedEntryPtrArray;
+
+#if defined(HAVE_BOOST_IOSTREAMS)
+
+			boost::iostreams::mapped_file_source file;
+
+#else // defined(HAVE_BOOST_IOSTREAMS)
+
+			std::vector<char>                    file;
+
+#endif // defined(HAVE_BOOST_IOSTREAMS)
+
+			std::size_t                          fileSize;
+			std::size_t                          numEntries;
+			std::size_t                          numSlots;
+			const char*                          slotData;
+			DecodedEntryPtrArray                 decodedEntries;
+		};
+    }
+}
+
+#endif // CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATA_HPP
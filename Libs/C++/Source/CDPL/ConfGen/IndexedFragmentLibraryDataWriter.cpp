@@ -0,0 +1,129 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * IndexedFragmentLibraryDataWriter.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <ostream>
+#include <algorithm>
+
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "IndexedFragmentLibraryDataWriter.hpp"
+#include "IndexedFragmentLibraryFormatData.hpp"
+#include "CDFMoleculeDataFunctions.hpp"
+
+
+using namespace CDPL;
+
+
+ConfGen::IndexedFragmentLibraryDataWriter::IndexedFragmentLibraryDataWriter(std::ostream& os): 
+	output(os), outputPos(0), molWriter(ctrlParams)
+{
+	using namespace IndexedFragLib;
+
+	Chem::setStrictErrorCheckingParameter(ctrlParams, true); 
+	Chem::setCDFWriteSinglePrecisionFloatsParameter(ctrlParams, true);
+
+	char header[HEADER_SIZE];
+
+	std::copy(MAGIC_CODE, MAGIC_CODE + MAGIC_CODE_SIZE, header);
+	putUInt64(CURR_FORMAT_VERSION, header + MAGIC_CODE_SIZE);
+
+	if (!output.write(header, HEADER_SIZE))
+		throw Base::IOError("IndexedFragmentLibraryDataWriter: writing file header failed");
+
+	outputPos = HEADER_SIZE;
+}
+
+void ConfGen::IndexedFragmentLibraryDataWriter::addEntry(Base::uint64 frag_hash, const Chem::MolecularGraph& frag)
+{
+	const Internal::ByteBuffer* mol_buf = &molDataBuffer;
+
+	if (hasCDFMoleculeData(frag)) 
+		mol_buf = getCDFMoleculeData(frag).get();
+
+	else
+		molWriter.writeMolGraph(frag, molDataBuffer);
+
+	addEntry(frag_hash, mol_buf->getData(), mol_buf->getSize());
+}
+
+void ConfGen::IndexedFragmentLibraryDataWriter::addEntry(Base::uint64 frag_hash, const char* data, std::size_t data_len)
+{
+	if (!output.write(data, data_len))
+		throw Base::IOError("IndexedFragmentLibraryDataWriter: writing entry data failed");
+
+	EntryInfo entry_info;
+
+	entry_info.fragHash = frag_hash;
+	entry_info.dataOffset = outputPos;
+	entry_info.dataLength = data_len;
+
+	entryInfos.push_back(entry_info);
+
+	outputPos += data_len;
+}
+
+void ConfGen::IndexedFragmentLibraryDataWriter::close()
+{
+	using namespace IndexedFragLib;
+
+	Base::uint64 num_slots = 2;
+
+	while (num_slots < entryInfos.size() * 2)
+		num_slots *= 2;
+
+	std::vector<char> table(num_slots * SLOT_SIZE, 0);
+
+	for (EntryInfoList::const_iterator it = entryInfos.begin(), end = entryInfos.end(); it != end; ++it) {
+		const EntryInfo& entry_info = *it;
+		std::size_t slot_idx = getSlotIndex(entry_info.fragHash, num_slots);
+
+		for ( ; getUInt64(&table[slot_idx * SLOT_SIZE + sizeof(Base::uint64)]) != 0; slot_idx = (slot_idx + 1) & (num_slots - 1))
+			if (getUInt64(&table[slot_idx * SLOT_SIZE]) == entry_info.fragHash)
+				throw Base::OperationFailed("IndexedFragmentLibraryDataWriter: duplicate fragment hash code");
+
+		char* slot = &table[slot_idx * SLOT_SIZE];
+
+		putUInt64(entry_info.fragHash, slot);
+		putUInt64(entry_info.dataOffset, slot + sizeof(Base::uint64));
+		putUInt64(entry_info.dataLength, slot + 2 * sizeof(Base::uint64));
+	}
+
+	char trailer[TRAILER_SIZE];
+
+	putUInt64(entryInfos.size(), trailer);
+	putUInt64(num_slots, trailer + sizeof(Base::uint64));
+	putUInt64(outputPos, trailer + 2 * sizeof(Base::uint64));
+	std::copy(MAGIC_CODE, MAGIC_CODE + MAGIC_CODE_SIZE, trailer + 3 * sizeof(Base::uint64));
+
+	if (!output.write(&table[0], table.size()) || !output.write(trailer, TRAILER_SIZE))
+		throw Base::IOError("IndexedFragmentLibraryDataWriter: writing hash table failed");
+
+	outputPos += table.size() + TRAILER_SIZE;
+	entryInfos.clear();
+}
@@ -0,0 +1,84 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * IndexedFragmentLibraryDataWriter.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATAWRITER_HPP
+#define CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATAWRITER_HPP
+
+#include <iosfwd>
+#include <vector>
+#include <cstddef>
+
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/CDFDataWriter.hpp"
+#include "CDPL/Base/ControlParameterList.hpp"
+#include "CDPL/Base/IntegerTypes.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+
+namespace CDPL 
+{
+
+	namespace ConfGen
+	{
+
+		/*
+		 * Writes fragment library entries in the indexed format (see IndexedFragmentLibraryFormatData.hpp).
+		 * The entry data are streamed out immediately, the hash table gets written by close().
+		 */
+		class IndexedFragmentLibraryDataWriter
+		{
+
+		public:
+			IndexedFragmentLibraryDataWriter(std::ostream& os);
+
+			void addEntry(Base::uint64 frag_hash, const Chem::MolecularGraph& frag);
+
+			void addEntry(Base::uint64 frag_hash, const char* data, std::size_t data_len);
+
+			void close();
+
+		private:
+			struct EntryInfo
+			{
+
+				Base::uint64 fragHash;
+				Base::uint64 dataOffset;
+				Base::uint64 dataLength;
+			};
+
+			typedef std::vector<EntryInfo> EntryInfoList;
+
+			std::ostream&              output;
+			Base::uint64               outputPos;
+			EntryInfoList              entryInfos;
+			Internal::ByteBuffer       molDataBuffer;
+			Base::ControlParameterList ctrlParams;
+			Chem::CDFDataWriter        molWriter;
+		};
+	}
+}
+
+#endif // CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYDATAWRITER_HPP
@@ -0,0 +1,90 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * IndexedFragmentLibraryFormatData.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYFORMATDATA_HPP
+#define CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYFORMATDATA_HPP
+
+#include <cstddef>
+
+#include "CDPL/Base/IntegerTypes.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+		/*
+		 * Layout of indexed fragment library files (all integers are stored in little-endian byte order):
+		 *
+		 *  - File header: magic code (8 bytes), format version (uint64)
+		 *  - Entry data: the CDF molecule data of all entries without any separators
+		 *  - Hash table: open addressing (linear probing) table of NUM_SLOTS slots, each comprising the fragment 
+		 *    hash code (uint64), the file offset of the entry data (uint64, 0 for empty slots) and the entry data 
+		 *    length (uint64)
+		 *  - File trailer: number of entries (uint64), number of hash table slots (uint64, a power of 2), 
+		 *    file offset of the hash table (uint64), magic code (8 bytes)
+		 */
+		namespace IndexedFragLib
+		{
+			
+			const char         MAGIC_CODE[]        = { 'C', 'D', 'P', 'L', 'F', 'L', 'I', 'X' };
+			const std::size_t  MAGIC_CODE_SIZE     = sizeof(MAGIC_CODE);
+			const Base::uint64 CURR_FORMAT_VERSION = 1;
+			const std::size_t  HEADER_SIZE         = MAGIC_CODE_SIZE + sizeof(Base::uint64);
+			const std::size_t  SLOT_SIZE           = 3 * sizeof(Base::uint64);
+			const std::size_t  TRAILER_SIZE        = 3 * sizeof(Base::uint64) + MAGIC_CODE_SIZE;
+
+			inline std::size_t getSlotIndex(Base::uint64 frag_hash, Base::uint64 num_slots)
+			{
+				frag_hash ^= (frag_hash >> 33);
+				frag_hash *= 0xff51afd7ed558ccdULL;
+				frag_hash ^= (frag_hash >> 33);
+
+				return std::size_t(frag_hash & (num_slots - 1));
+			}
+
+			inline Base::uint64 getUInt64(const char* data)
+			{
+				Base::uint64 value = 0;
+
+				for (std::size_t i = 0; i < sizeof(Base::uint64); i++)
+					value |= Base::uint64(Base::uint8(data[i])) << (i * 8);
+
+				return value;
+			}
+
+			inline void putUInt64(Base::uint64 value, char* data)
+			{
+				for (std::size_t i = 0; i < sizeof(Base::uint64); i++, value >>= 8)
+					data[i] = char(value & 0xff);
+			}
+		}
+    }
+}
+
+#endif // CDPL_CONFGEN_INDEXEDFRAGMENTLIBRARYFORMATDATA_HPP
@@ -0,0 +1,77 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ProcessingPhaseTimer.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::ProcessingPhaseTimer.
+ */
+
+#ifndef CDPL_CONFGEN_PROCESSINGPHASETIMER_HPP
+#define CDPL_CONFGEN_PROCESSINGPHASETIMER_HPP
+
+#include <boost/chrono/chrono.hpp>
+
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+		/*
+		 * Adds the time elapsed between construction and destruction to the given phase -
+		 * does nothing (and does not query the clock) if no statistics object is specified.
+		 */
+		class ProcessingPhaseTimer
+		{
+
+		public:
+			ProcessingPhaseTimer(ProcessingStatistics* stats, ProcessingStatistics::Phase phase):
+				statistics(stats), phase(phase) {
+
+				if (stats)
+					startTime = boost::chrono::steady_clock::now();
+			}
+
+			~ProcessingPhaseTimer() {
+				if (statistics)
+					statistics->addTime(phase, boost::chrono::duration<double>(boost::chrono::steady_clock::now() - startTime).count());
+			}
+
+		private:
+			ProcessingPhaseTimer(const ProcessingPhaseTimer&);
+
+			ProcessingPhaseTimer& operator=(const ProcessingPhaseTimer&);
+
+			ProcessingStatistics*                    statistics;
+			ProcessingStatistics::Phase              phase;
+			boost::chrono::steady_clock::time_point  startTime;
+		};
+    }
+}
+
+#endif // CDPL_CONFGEN_PROCESSINGPHASETIMER_HPP
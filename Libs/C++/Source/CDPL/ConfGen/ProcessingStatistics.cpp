@@ -0,0 +1,134 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ProcessingStatistics.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const char* PHASE_NAMES[] = {
+		"Force field setup",
+		"Fragment splitting",
+		"Fragment library lookup",
+		"Fragment conformer generation",
+		"Torsion driving",
+		"Structure generation",
+		"Energy minimization",
+		"Conformer combination",
+		"Conformer selection"
+	};
+
+	const char* COUNTER_NAMES[] = {
+		"Molecules",
+		"Output conformers",
+		"Torsion fragments",
+		"Fragment library hits",
+		"Fragment cache hits",
+		"Generated fragments",
+		"Energy minimizations",
+		"Minimization iterations"
+	};
+}
+
+
+ConfGen::ProcessingStatistics::ProcessingStatistics()
+{
+	clear();
+}
+
+double ConfGen::ProcessingStatistics::getTime(Phase phase) const
+{
+	if (phase >= NUM_PHASES)
+		throw Base::IndexError("ProcessingStatistics: phase out of bounds");
+
+	return times[phase];
+}
+
+void ConfGen::ProcessingStatistics::addTime(Phase phase, double secs)
+{
+	if (phase >= NUM_PHASES)
+		throw Base::IndexError("ProcessingStatistics: phase out of bounds");
+
+	times[phase] += secs;
+}
+
+std::size_t ConfGen::ProcessingStatistics::getCount(Counter counter) const
+{
+	if (counter >= NUM_COUNTERS)
+		throw Base::IndexError("ProcessingStatistics: counter out of bounds");
+
+	return counts[counter];
+}
+
+void ConfGen::ProcessingStatistics::increment(Counter counter, std::size_t num)
+{
+	if (counter >= NUM_COUNTERS)
+		throw Base::IndexError("ProcessingStatistics: counter out of bounds");
+
+	counts[counter] += num;
+}
+
+void ConfGen::ProcessingStatistics::clear()
+{
+	std::fill(times, times + NUM_PHASES, 0.0);
+	std::fill(counts, counts + NUM_COUNTERS, std::size_t(0));
+}
+
+ConfGen::ProcessingStatistics& ConfGen::ProcessingStatistics::operator+=(const ProcessingStatistics& stats)
+{
+	for (std::size_t i = 0; i < NUM_PHASES; i++)
+		times[i] += stats.times[i];
+
+	for (std::size_t i = 0; i < NUM_COUNTERS; i++)
+		counts[i] += stats.counts[i];
+
+	return *this;
+}
+
+const char* ConfGen::ProcessingStatistics::getPhaseName(Phase phase)
+{
+	if (phase >= NUM_PHASES)
+		throw Base::IndexError("ProcessingStatistics: phase out of bounds");
+
+	return PHASE_NAMES[phase];
+}
+
+const char* ConfGen::ProcessingStatistics::getCounterName(Counter counter)
+{
+	if (counter >= NUM_COUNTERS)
+		throw Base::IndexError("ProcessingStatistics: counter out of bounds");
+
+	return COUNTER_NAMES[counter];
+}
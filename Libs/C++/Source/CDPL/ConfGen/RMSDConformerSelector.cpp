@@ -41,7 +41,8 @@
 #include "CDPL/Chem/HybridizationState.hpp"
 #include "CDPL/Chem/AtomConfiguration.hpp"
 #include "CDPL/ForceField/UtilityFunctions.hpp"
-#include "CDPL/Math/VectorArrayFunctions.hpp"
+#include "CDPL/Math/Matrix.hpp"
+#include "CDPL/Math/JacobiDiagonalization.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 
@@ -49,8 +50,10 @@ namespace
 {
 
 	const std::size_t MAX_INDEX_ARRAY_CACHE_SIZE          = 1000;
-	const std::size_t MAX_VECTOR_ARRAY_CACHE_SIZE         = 2000;
+	const std::size_t MAX_CONFORMER_DATA_CACHE_SIZE       = 2000;
 	const double      MIN_TETRAHEDRAL_ATOM_GEOM_OOP_ANGLE = 10.0 / 180.0 * M_PI;
+	const std::size_t MAX_QCP_NEWTON_ITERATIONS           = 50;
+	const double      QCP_EIGENVALUE_PRECISION            = 1.0e-11;
 }
 
 
@@ -58,7 +61,7 @@ using namespace CDPL;
 
 
 ConfGen::RMSDConformerSelector::RMSDConformerSelector(): 
-	idxArrayCache(MAX_INDEX_ARRAY_CACHE_SIZE), vecArrayCache(MAX_VECTOR_ARRAY_CACHE_SIZE), 
+	idxArrayCache(MAX_INDEX_ARRAY_CACHE_SIZE), confDataCache(MAX_CONFORMER_DATA_CACHE_SIZE), 
 	molGraph(0), minRMSD(0.0)
 {
 	using namespace Chem;
@@ -90,8 +93,8 @@ void ConfGen::RMSDConformerSelector::setup(const Chem::MolecularGraph& molgraph,
 
 	atomStereoDescrs.clear();
 	idxArrayCache.putAll();
-	confAlignCoords.clear();
-	selectedConfAlignCoords.clear();
+	mappedConfData.clear();
+	selectedConfData.clear();
 	symMappings.clear();
 }
 
@@ -116,38 +119,35 @@ bool ConfGen::RMSDConformerSelector::selected(const Math::Vector3DArray& conf_co
 			throw Base::OperationFailed("RMSDConformerSelector: could not perceive molecular graph automorphism group");
 	}
 
-	if (!selectedConfAlignCoords.empty()) {
+	mappedConfData.clear();
+	mappedConfData.push_back(buildConformerDataForMapping(*symMappings.front(), conf_coords));
+
+	if (!selectedConfData.empty()) {
 		std::size_t num_mappings = symMappings.size();
-		bool first_pass = true;
-		Math::Matrix4D conf_xform;
 
-		confAlignCoords.clear();
+		calcPrincipalExtents(*mappedConfData.front());
+
+		for (ConformerDataList::const_reverse_iterator it = selectedConfData.rbegin(), end = selectedConfData.rend(); it != end; ++it) {
+			const ConformerData& sel_conf_data = **it;
 
-		for (VectorArrayList::const_reverse_iterator it = selectedConfAlignCoords.rbegin(), end = selectedConfAlignCoords.rend(); 
-			 it != end; ++it, first_pass = false) {
+			// the lower bound is invariant under atom permutations and thus valid for all symmetry mappings
 
-			const Math::Vector3DArray& sel_conf_algn_coords = **it;
+			if (calcRMSDLowerBound(sel_conf_data, *mappedConfData.front()) >= minRMSD)
+				continue;
 
 			for (std::size_t i = 0; i < num_mappings; i++) {
-				if (first_pass) 
-					confAlignCoords.push_back(buildCoordsArrayForMapping(*symMappings[i], conf_coords));
+				if (i == mappedConfData.size()) 
+					mappedConfData.push_back(buildConformerDataForMapping(*symMappings[i], conf_coords));
 				
-				if (!alignmentCalc.calculate(sel_conf_algn_coords, *confAlignCoords[i], false)) 
-					return false;
-
-				conf_xform.assign(alignmentCalc.getTransform());
-
-				double rmsd = calcRMSD(sel_conf_algn_coords, *confAlignCoords[i], conf_xform);
-
-				if (rmsd < minRMSD) 
+				if (calcRMSD(sel_conf_data, *mappedConfData[i], minRMSD) < minRMSD) 
 					return false;
 			}
 		}
 
-		selectedConfAlignCoords.push_back(confAlignCoords.front());
-
 	} else
-		selectedConfAlignCoords.push_back(buildCoordsArrayForMapping(*symMappings.front(), conf_coords));
+		calcPrincipalExtents(*mappedConfData.front());
+
+	selectedConfData.push_back(mappedConfData.front());
 
 	return true;
 }
@@ -310,28 +310,194 @@ bool ConfGen::RMSDConformerSelector::isValidSymMapping(const Chem::AtomBondMappi
 	return true;
 }
 
-ConfGen::RMSDConformerSelector::VectorArrayPtr 
-ConfGen::RMSDConformerSelector::buildCoordsArrayForMapping(const IndexArray& mapping, const Math::Vector3DArray& conf_coords)
+ConfGen::RMSDConformerSelector::ConformerDataPtr 
+ConfGen::RMSDConformerSelector::buildConformerDataForMapping(const IndexArray& mapping, const Math::Vector3DArray& conf_coords)
 {
-	VectorArrayPtr coords_ptr = vecArrayCache.get();
-	Math::Vector3DArray& coords = *coords_ptr;
-	Math::Vector3DArray::StorageType& coords_data = coords.getData();
-	std::size_t arr_size = mapping.size();
+	ConformerDataPtr conf_data_ptr = confDataCache.get();
+	ConformerData& conf_data = *conf_data_ptr;
+	std::size_t num_atoms = mapping.size();
 	Math::Vector3D ctr;
 
-	coords.resize(arr_size);
+	conf_data.coords.resize(num_atoms * 3);
+
+	// coordinates are stored component-wise (all x, all y, all z) to allow for a vectorized
+	// accumulation of the inner products
 
-	for (std::size_t i = 0; i < arr_size; i++) {
+	double* x = &conf_data.coords[0];
+	double* y = x + num_atoms;
+	double* z = y + num_atoms;
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
 		const Math::Vector3D& pos = conf_coords[mapping[i]];
 
 		ctr.plusAssign(pos);
-		coords_data[i].assign(pos);
+
+		x[i] = pos(0);
+		y[i] = pos(1);
+		z[i] = pos(2);
 	}
 
-	ctr /= arr_size;
+	ctr /= num_atoms;
+
+	double ctr_x = ctr(0);
+	double ctr_y = ctr(1);
+	double ctr_z = ctr(2);
+	double inner_prod = 0.0;
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		x[i] -= ctr_x;
+		y[i] -= ctr_y;
+		z[i] -= ctr_z;
+
+		inner_prod += x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+	}
+
+	conf_data.innerProduct = inner_prod;
+
+	return conf_data_ptr;
+}
+
+void ConfGen::RMSDConformerSelector::calcPrincipalExtents(ConformerData& conf_data) const
+{
+	std::size_t num_atoms = conf_data.coords.size() / 3;
+	const double* x = &conf_data.coords[0];
+	const double* y = x + num_atoms;
+	const double* z = y + num_atoms;
+	double sxx = 0.0, sxy = 0.0, sxz = 0.0, syy = 0.0, syz = 0.0, szz = 0.0;
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		sxx += x[i] * x[i];
+		sxy += x[i] * y[i];
+		sxz += x[i] * z[i];
+		syy += y[i] * y[i];
+		syz += y[i] * z[i];
+		szz += z[i] * z[i];
+	}
+
+	Math::Matrix3D cov_mtx;
+	Math::Matrix3D eigen_vecs;
+	Math::Vector3D eigen_vals;
+
+	cov_mtx(0, 0) = sxx; cov_mtx(0, 1) = sxy; cov_mtx(0, 2) = sxz;
+	cov_mtx(1, 0) = sxy; cov_mtx(1, 1) = syy; cov_mtx(1, 2) = syz;
+	cov_mtx(2, 0) = sxz; cov_mtx(2, 1) = syz; cov_mtx(2, 2) = szz;
+
+	if (!Math::jacobiDiagonalize(cov_mtx, eigen_vals, eigen_vecs)) {
+		// no bound available - make sure that the exact RMSD always gets calculated
 
-	for (Math::Vector3DArray::ElementIterator it = coords.getElementsBegin(), end = coords.getElementsEnd(); it != end; ++it)
-		it->minusAssign(ctr);
+		conf_data.principalExtents[0] = -1.0;
+		return;
+	}
+
+	for (std::size_t i = 0; i < 3; i++)
+		conf_data.principalExtents[i] = std::sqrt(std::max(eigen_vals(i), 0.0));
+
+	std::sort(conf_data.principalExtents, conf_data.principalExtents + 3);
+}
+
+double ConfGen::RMSDConformerSelector::calcRMSDLowerBound(const ConformerData& conf_data1, const ConformerData& conf_data2) const
+{
+	// The singular values of the centered coordinate matrices bound the trace of the rotated correlation matrix
+	// from above (von Neumann's trace inequality), which yields a lower bound of the RMSD after superposition
+
+	if (conf_data1.principalExtents[0] < 0.0 || conf_data2.principalExtents[0] < 0.0)
+		return 0.0;
+
+	double sd = 0.0;
+
+	for (std::size_t i = 0; i < 3; i++) {
+		double diff = conf_data1.principalExtents[i] - conf_data2.principalExtents[i];
+
+		sd += diff * diff;
+	}
+
+	return std::sqrt(sd / (conf_data1.coords.size() / 3));
+}
+
+double ConfGen::RMSDConformerSelector::calcRMSD(const ConformerData& conf_data1, const ConformerData& conf_data2, double min_rmsd) const
+{
+	std::size_t num_atoms = conf_data1.coords.size() / 3;
+
+	if (num_atoms == 0)
+		return 0.0;
+
+	const double* x1 = &conf_data1.coords[0];
+	const double* y1 = x1 + num_atoms;
+	const double* z1 = y1 + num_atoms;
+	const double* x2 = &conf_data2.coords[0];
+	const double* y2 = x2 + num_atoms;
+	const double* z2 = y2 + num_atoms;
+
+	double sxx = 0.0, sxy = 0.0, sxz = 0.0;
+	double syx = 0.0, syy = 0.0, syz = 0.0;
+	double szx = 0.0, szy = 0.0, szz = 0.0;
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		sxx += x1[i] * x2[i];
+		sxy += x1[i] * y2[i];
+		sxz += x1[i] * z2[i];
+		syx += y1[i] * x2[i];
+		syy += y1[i] * y2[i];
+		syz += y1[i] * z2[i];
+		szx += z1[i] * x2[i];
+		szy += z1[i] * y2[i];
+		szz += z1[i] * z2[i];
+	}
+
+	// coefficients of the characteristic polynomial of the key matrix
+
+	double sxx2 = sxx * sxx, syy2 = syy * syy, szz2 = szz * szz;
+	double sxy2 = sxy * sxy, syz2 = syz * syz, sxz2 = sxz * sxz;
+	double syx2 = syx * syx, szy2 = szy * szy, szx2 = szx * szx;
+
+	double syz_szy_m_syy_szz2 = 2.0 * (syz * szy - syy * szz);
+	double sxx2_syy2_szz2_syz2_szy2 = syy2 + szz2 - sxx2 + syz2 + szy2;
+
+	double c2 = -2.0 * (sxx2 + syy2 + szz2 + sxy2 + syx2 + sxz2 + szx2 + syz2 + szy2);
+	double c1 = 8.0 * (sxx * syz * szy + syy * szx * sxz + szz * sxy * syx - sxx * syy * szz - syz * szx * sxy - szy * syx * sxz);
+
+	double sxz_p_szx = sxz + szx;
+	double syz_p_szy = syz + szy;
+	double sxy_p_syx = sxy + syx;
+	double syz_m_szy = syz - szy;
+	double sxz_m_szx = sxz - szx;
+	double sxy_m_syx = sxy - syx;
+	double sxx_p_syy = sxx + syy;
+	double sxx_m_syy = sxx - syy;
+	double sxy2_sxz2_syx2_szx2 = sxy2 + sxz2 - syx2 - szx2;
+
+	double c0 = sxy2_sxz2_syx2_szx2 * sxy2_sxz2_syx2_szx2
+		+ (sxx2_syy2_szz2_syz2_szy2 + syz_szy_m_syy_szz2) * (sxx2_syy2_szz2_syz2_szy2 - syz_szy_m_syy_szz2)
+		+ (-sxz_p_szx * syz_m_szy + sxy_m_syx * (sxx_m_syy - szz)) * (-sxz_m_szx * syz_p_szy + sxy_m_syx * (sxx_m_syy + szz))
+		+ (-sxz_p_szx * syz_p_szy - sxy_p_syx * (sxx_p_syy - szz)) * (-sxz_m_szx * syz_m_szy - sxy_p_syx * (sxx_p_syy + szz))
+		+ (sxy_p_syx * syz_p_szy + sxz_p_szx * (sxx_m_syy + szz)) * (-sxy_m_syx * syz_m_szy + sxz_p_szx * (sxx_p_syy + szz))
+		+ (sxy_p_syx * syz_m_szy + sxz_m_szx * (sxx_m_syy - szz)) * (-sxy_m_syx * syz_p_szy + sxz_m_szx * (sxx_p_syy - szz));
+
+	// Newton-Raphson iteration for the largest eigenvalue starting from its upper bound E0 - the iterates
+	// decrease monotonically, hence each of them yields a lower bound of the final RMSD
+
+	double e0 = (conf_data1.innerProduct + conf_data2.innerProduct) * 0.5;
+	double max_sd_diff = min_rmsd * min_rmsd * num_atoms * 0.5;
+	double max_eigen_val = e0;
+
+	for (std::size_t i = 0; i < MAX_QCP_NEWTON_ITERATIONS; i++) {
+		double prev_eigen_val = max_eigen_val;
+		double x2 = max_eigen_val * max_eigen_val;
+		double b = (x2 + c2) * max_eigen_val;
+		double a = b + c1;
+		double denom = 2.0 * x2 * max_eigen_val + b + a;
+
+		if (denom == 0.0)
+			break;
+
+		max_eigen_val -= (a * max_eigen_val + c0) / denom;
+
+		if (std::abs(max_eigen_val - prev_eigen_val) < std::abs(QCP_EIGENVALUE_PRECISION * max_eigen_val))
+			break;
+
+		if ((e0 - max_eigen_val) >= max_sd_diff)
+			break;
+	}
 
-	return coords_ptr;
+	return std::sqrt(std::abs(2.0 * (e0 - max_eigen_val) / num_atoms));
 }
@@ -0,0 +1,254 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * FragmentLibraryMergerTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/FragmentLibraryMerger.hpp"
+#include "CDPL/ConfGen/FragmentLibrary.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+
+
+namespace
+{
+
+	// the two overlapping bulk ranges provide enough entry records for a parallel sort
+
+	const std::size_t NUM_BULK_ENTRIES   = 100000;
+	const std::size_t NONE               = std::size_t(-1);
+	const CDPL::Base::uint64 CASE_HASH_BASE = 10000000;
+
+	const char* LIB_FRAG_SMILES[]  = { "C", "N", "O" };
+	const unsigned int LIB_FRAG_ATOM_TYPES[] = { CDPL::Chem::AtomType::C, CDPL::Chem::AtomType::N, CDPL::Chem::AtomType::O };
+	const bool LIB_INDEXED[]       = { false, true, false };
+	const std::size_t NUM_LIBS     = 3;
+
+	struct ConflictCase
+	{
+
+		std::size_t numConfs[NUM_LIBS];
+		std::size_t winnerLib;
+	};
+
+	const ConflictCase CONFLICT_CASES[] = {
+		{ { 1, 2, NONE }, 1 },
+		{ { 2, 2, NONE }, 0 },
+		{ { 0, 1, 3 }, 2 },
+		{ { NONE, 2, 2 }, 1 },
+		{ { NONE, NONE, 1 }, 2 },
+		{ { 3, NONE, 1 }, 0 }
+	};
+
+	const std::size_t NUM_CONFLICT_CASES = sizeof(CONFLICT_CASES) / sizeof(ConflictCase);
+
+	CDPL::Chem::MolecularGraph::SharedPointer createFragment(std::size_t lib_idx, std::size_t num_confs)
+	{
+		using namespace CDPL;
+
+		Chem::BasicMolecule::SharedPointer frag(new Chem::BasicMolecule());
+
+		BOOST_CHECK(Chem::parseSMILES(LIB_FRAG_SMILES[lib_idx], *frag));
+
+		Math::Vector3DArray coords;
+
+		coords.resize(frag->getNumAtoms());
+
+		for (std::size_t i = 0; i < num_confs; i++) {
+			coords[0](0) = double(i);
+
+			Chem::addConformation(*frag, coords);
+		}
+
+		return frag;
+	}
+
+	std::string getLibraryFileName(std::size_t lib_idx)
+	{
+		std::ostringstream oss;
+
+		oss << "FragmentLibraryMergerTest_" << lib_idx << ".tmp";
+
+		return oss.str();
+	}
+
+	void createInputLibrary(std::size_t lib_idx, std::size_t bulk_start, std::size_t bulk_end)
+	{
+		using namespace CDPL;
+
+		ConfGen::FragmentLibrary lib;
+		Chem::MolecularGraph::SharedPointer bulk_frag = createFragment(lib_idx, 0);
+
+		for (std::size_t i = bulk_start; i < bulk_end; i++)
+			lib.addEntry(i, bulk_frag);
+
+		for (std::size_t i = 0; i < NUM_CONFLICT_CASES; i++)
+			if (CONFLICT_CASES[i].numConfs[lib_idx] != NONE)
+				lib.addEntry(CASE_HASH_BASE + i, createFragment(lib_idx, CONFLICT_CASES[i].numConfs[lib_idx]));
+
+		std::ofstream os(getLibraryFileName(lib_idx).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (LIB_INDEXED[lib_idx])
+			lib.saveIndexed(os);
+		else
+			lib.save(os);
+
+		BOOST_CHECK(os.good());
+	}
+
+	unsigned int getFragmentAtomType(const CDPL::ConfGen::FragmentLibrary& lib, CDPL::Base::uint64 hash)
+	{
+		const CDPL::Chem::MolecularGraph::SharedPointer& frag = lib.getEntry(hash);
+
+		BOOST_REQUIRE(frag);
+
+		return getType(frag->getAtom(0));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(FragmentLibraryMergerTest)
+{
+	using namespace CDPL;
+	using namespace ConfGen;
+
+	// library 0 (CDF): bulk hashes [0, N), library 1 (indexed): bulk hashes [N / 2, 3 * N / 2), library 2 (CDF): no bulk entries
+
+	createInputLibrary(0, 0, NUM_BULK_ENTRIES);
+	createInputLibrary(1, NUM_BULK_ENTRIES / 2, NUM_BULK_ENTRIES * 3 / 2);
+	createInputLibrary(2, 0, 0);
+
+	std::size_t num_case_entries = 0;
+	std::size_t num_case_conflicts = 0;
+
+	for (std::size_t i = 0; i < NUM_CONFLICT_CASES; i++) {
+		std::size_t num_libs = 0;
+
+		for (std::size_t j = 0; j < NUM_LIBS; j++)
+			if (CONFLICT_CASES[i].numConfs[j] != NONE)
+				num_libs++;
+
+		num_case_entries += num_libs;
+		num_case_conflicts += (num_libs > 1 ? 1 : 0);
+	}
+
+	std::size_t num_exp_entries = NUM_BULK_ENTRIES * 3 / 2 + NUM_CONFLICT_CASES;
+
+	FragmentLibraryMerger merger;
+
+	for (std::size_t i = 0; i < NUM_LIBS; i++)
+		merger.addInputLibrary(getLibraryFileName(i));
+
+	BOOST_CHECK(merger.getNumInputLibraries() == NUM_LIBS);
+
+	// the output must not depend on the number of threads
+
+	std::string cdf_output;
+	std::string indexed_output;
+	const std::size_t num_threads[] = { 1, 2, 4 };
+
+	for (std::size_t i = 0; i < 3; i++) {
+		merger.setNumThreads(num_threads[i]);
+
+		for (int indexed = 0; indexed < 2; indexed++) {
+			std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
+
+			merger.setIndexedOutput(indexed);
+
+			BOOST_CHECK(merger.merge(oss));
+			BOOST_CHECK(merger.getNumInputEntries() == NUM_BULK_ENTRIES * 2 + num_case_entries);
+			BOOST_CHECK(merger.getNumOutputEntries() == num_exp_entries);
+			BOOST_CHECK(merger.getNumConflicts() == NUM_BULK_ENTRIES / 2 + num_case_conflicts);
+
+			std::string& output = (indexed ? indexed_output : cdf_output);
+
+			if (i == 0)
+				output = oss.str();
+			else
+				BOOST_CHECK(oss.str() == output);
+		}
+	}
+
+	// one entry per hash code, conflicts are resolved in favor of the most conformers and then of the first input library
+
+	std::stringstream ss(cdf_output, std::ios_base::in | std::ios_base::binary);
+	FragmentLibrary cdf_lib;
+
+	cdf_lib.load(ss);
+
+	BOOST_CHECK(cdf_lib.getNumEntries() == num_exp_entries);
+
+	const char* out_file_name = "FragmentLibraryMergerTest_out.tmp";
+
+	{
+		std::ofstream os(out_file_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		os << indexed_output;
+		BOOST_CHECK(os.good());
+	}
+
+	FragmentLibrary idx_lib;
+
+	idx_lib.loadIndexed(out_file_name);
+
+	BOOST_CHECK(idx_lib.getNumEntries() == num_exp_entries);
+
+	const ConfGen::FragmentLibrary* libs[] = { &cdf_lib, &idx_lib };
+
+	for (std::size_t i = 0; i < 2; i++) {
+		const FragmentLibrary& lib = *libs[i];
+
+		BOOST_CHECK(getFragmentAtomType(lib, 0) == Chem::AtomType::C);
+		BOOST_CHECK(getFragmentAtomType(lib, NUM_BULK_ENTRIES / 2) == Chem::AtomType::C);
+		BOOST_CHECK(getFragmentAtomType(lib, NUM_BULK_ENTRIES - 1) == Chem::AtomType::C);
+		BOOST_CHECK(getFragmentAtomType(lib, NUM_BULK_ENTRIES) == Chem::AtomType::N);
+		BOOST_CHECK(getFragmentAtomType(lib, NUM_BULK_ENTRIES * 3 / 2 - 1) == Chem::AtomType::N);
+		BOOST_CHECK(!lib.containsEntry(NUM_BULK_ENTRIES * 3 / 2));
+
+		for (std::size_t j = 0; j < NUM_CONFLICT_CASES; j++) {
+			const ConflictCase& cc = CONFLICT_CASES[j];
+			const Chem::MolecularGraph::SharedPointer& frag = lib.getEntry(CASE_HASH_BASE + j);
+
+			BOOST_REQUIRE(frag);
+			BOOST_CHECK(getType(frag->getAtom(0)) == LIB_FRAG_ATOM_TYPES[cc.winnerLib]);
+			BOOST_CHECK(Chem::getNumConformations(*frag) == cc.numConfs[cc.winnerLib]);
+		}
+	}
+
+	for (std::size_t i = 0; i < NUM_LIBS; i++)
+		std::remove(getLibraryFileName(i).c_str());
+
+	std::remove(out_file_name);
+}
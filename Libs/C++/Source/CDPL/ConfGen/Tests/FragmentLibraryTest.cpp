@@ -0,0 +1,146 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * FragmentLibraryTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/FragmentLibrary.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+
+
+namespace
+{
+
+	const char* FRAG_SMILES[] = {
+		"c1ccccc1", "C1CCCCC1", "c1ccncc1", "C1CCNCC1", "c1ccc2ccccc2c1", "C1CCOC1", "c1ccsc1", 0
+	};
+
+	CDPL::Base::uint64 getFragmentHash(std::size_t idx)
+	{
+		return (CDPL::Base::uint64(idx) * 0x9E3779B97F4A7C15ULL + 1);
+	}
+
+	void checkEntries(const CDPL::ConfGen::FragmentLibrary& lib)
+	{
+		using namespace CDPL;
+
+		std::size_t num_frags = 0;
+
+		for ( ; FRAG_SMILES[num_frags]; num_frags++) {
+			Chem::BasicMolecule mol;
+
+			BOOST_CHECK(Chem::parseSMILES(FRAG_SMILES[num_frags], mol));
+
+			const Chem::MolecularGraph::SharedPointer& entry = lib.getEntry(getFragmentHash(num_frags));
+
+			BOOST_CHECK(lib.containsEntry(getFragmentHash(num_frags)));
+			BOOST_REQUIRE(entry);
+			BOOST_CHECK(entry->getNumAtoms() == mol.getNumAtoms());
+			BOOST_CHECK(entry->getNumBonds() == mol.getNumBonds());
+		}
+
+		BOOST_CHECK(lib.getNumEntries() == num_frags);
+		BOOST_CHECK(!lib.containsEntry(getFragmentHash(num_frags)));
+		BOOST_CHECK(!lib.getEntry(getFragmentHash(num_frags)));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(FragmentLibraryTest)
+{
+	using namespace CDPL;
+	using namespace ConfGen;
+
+	FragmentLibrary lib;
+
+	for (std::size_t i = 0; FRAG_SMILES[i]; i++) {
+		Chem::BasicMolecule::SharedPointer mol(new Chem::BasicMolecule());
+
+		BOOST_CHECK(Chem::parseSMILES(FRAG_SMILES[i], *mol));
+		BOOST_CHECK(lib.addEntry(getFragmentHash(i), mol));
+	}
+
+	checkEntries(lib);
+
+	// binary (indexed) save/reload round trip
+
+	const char* idx_file_name = "FragmentLibraryTest.tmp";
+
+	{
+		std::ofstream os(idx_file_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		lib.saveIndexed(os);
+		BOOST_CHECK(os.good());
+	}
+
+	BOOST_CHECK(FragmentLibrary::isIndexedFile(idx_file_name));
+
+	FragmentLibrary idx_lib;
+
+	idx_lib.loadIndexed(idx_file_name);
+
+	BOOST_CHECK(idx_lib.isIndexed());
+
+	checkEntries(idx_lib);
+
+	// saving an indexed library must not release the indexed data
+
+	std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+	idx_lib.save(ss);
+
+	BOOST_CHECK(idx_lib.isIndexed());
+
+	FragmentLibrary reloaded_lib;
+
+	reloaded_lib.load(ss);
+
+	checkEntries(reloaded_lib);
+
+	// entry references obtained from an indexed library stay valid after the entries got released by iteration
+
+	const FragmentLibrary& const_idx_lib = idx_lib;
+	const Chem::MolecularGraph::SharedPointer& entry = const_idx_lib.getEntry(getFragmentHash(4));
+	std::size_t num_atoms = entry->getNumAtoms();
+	std::size_t num_iter_entries = 0;
+
+	for (FragmentLibrary::ConstEntryIterator it = const_idx_lib.getEntriesBegin(), end = const_idx_lib.getEntriesEnd(); it != end; ++it, num_iter_entries++)
+		BOOST_CHECK(it->second);
+
+	BOOST_CHECK(!idx_lib.isIndexed());
+	BOOST_CHECK(num_iter_entries == idx_lib.getNumEntries());
+	BOOST_REQUIRE(entry);
+	BOOST_CHECK(entry->getNumAtoms() == num_atoms);
+
+	checkEntries(idx_lib);
+
+	std::remove(idx_file_name);
+}
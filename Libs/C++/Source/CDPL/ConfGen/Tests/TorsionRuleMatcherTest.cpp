@@ -0,0 +1,110 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * TorsionRuleMatcherTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/TorsionRuleMatcher.hpp"
+#include "CDPL/ConfGen/TorsionLibrary.hpp"
+#include "CDPL/ConfGen/MoleculeFunctions.hpp"
+#include "CDPL/ConfGen/BondFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+
+
+BOOST_AUTO_TEST_CASE(TorsionRuleMatcherTest)
+{
+	using namespace CDPL;
+	using namespace ConfGen;
+
+	// molecules with recurring bond environments, some of them differing only beyond the first shell
+
+	const char* smiles[] = {
+		"CC(=O)NCc1ccccc1", "CC(=O)NCc1ccncc1", "CC(=O)N(C)Cc1ccccc1", "CCOC(=O)c1ccccc1", "CCOC(=O)c1ccccc1O",
+		"CC(C)NCC(O)COc1ccccc1", "OC(=O)CCCCC(N)C(=O)O", "CN1CCN(CC1)c1ccc(cc1)C(=O)NCCO", "c1ccccc1-c1ccccc1",
+		"c1ccccc1-c1ccccn1", "Cc1ccccc1-c1ccccc1C", "CS(=O)(=O)Nc1ccccc1", "CCCCCCCC", "CCCCOCCCC", "FC(F)(F)c1ccccc1CC",
+		"O=C(NC1CC1)c1cccs1", "O=C(NC1CCC1)c1cccs1", "O=C(NC1CCC1)c1ccco1", 0
+	};
+
+	TorsionRuleMatcher cached_matcher(TorsionLibrary::get());
+	TorsionRuleMatcher uncached_matcher(TorsionLibrary::get());
+
+	uncached_matcher.setResultCacheSize(0);
+
+	BOOST_CHECK(cached_matcher.getResultCacheSize() == TorsionRuleMatcher::DEF_RESULT_CACHE_SIZE);
+	BOOST_CHECK(uncached_matcher.getResultCacheSize() == 0);
+
+	std::size_t num_checked_bonds = 0;
+
+	// process the molecules twice so that the second pass mostly gets answered from the cache
+
+	for (std::size_t pass = 0; pass < 2; pass++) {
+		for (std::size_t i = 0; smiles[i]; i++) {
+			Chem::BasicMolecule mol;
+
+			BOOST_CHECK(Chem::parseSMILES(smiles[i], mol));
+
+			prepareForConformerGeneration(mol);
+
+			for (Chem::BasicMolecule::ConstBondIterator it = mol.getBondsBegin(), end = mol.getBondsEnd(); it != end; ++it) {
+				const Chem::Bond& bond = *it;
+
+				if (!isRotatableBond(bond, mol, false))
+					continue;
+
+				bool cached_res = cached_matcher.findMatches(bond, mol);
+				bool uncached_res = uncached_matcher.findMatches(bond, mol);
+
+				BOOST_CHECK(cached_res == uncached_res);
+				BOOST_CHECK(cached_matcher.getNumMatches() == uncached_matcher.getNumMatches());
+
+				if (cached_matcher.getNumMatches() != uncached_matcher.getNumMatches())
+					continue;
+
+				for (std::size_t j = 0; j < cached_matcher.getNumMatches(); j++) {
+					const TorsionRuleMatch& cached_match = cached_matcher.getMatch(j);
+					const TorsionRuleMatch& uncached_match = uncached_matcher.getMatch(j);
+
+					BOOST_CHECK(&cached_match.getRule() == &uncached_match.getRule());
+					BOOST_CHECK(&cached_match.getBond() == &bond);
+
+					for (std::size_t k = 0; k < 4; k++)
+						BOOST_CHECK(cached_match.getAtoms()[k] == uncached_match.getAtoms()[k]);
+				}
+
+				num_checked_bonds++;
+			}
+		}
+	}
+
+	BOOST_CHECK(num_checked_bonds > 0);
+
+	cached_matcher.clearCache();
+
+	BOOST_CHECK(cached_matcher.getNumMatches() == uncached_matcher.getNumMatches());
+}
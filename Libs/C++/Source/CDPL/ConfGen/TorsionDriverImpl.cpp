@@ -325,6 +325,8 @@ ConfGen::FragmentTreeNode& ConfGen::TorsionDriverImpl::getFragmentNode(std::size
 
 unsigned int ConfGen::TorsionDriverImpl::generateConformers()
 {
+	fragTree.setNumThreads(settings.getNumThreads());
+
 	unsigned int ret_code = fragTree.getRoot()->generateConformers(settings.getEnergyWindow(), settings.getMaxPoolSize());
 
 	if (ret_code != ReturnCode::SUCCESS)
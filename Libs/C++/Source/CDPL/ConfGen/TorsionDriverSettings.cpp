@@ -35,7 +35,7 @@ using namespace CDPL;
 
 
 ConfGen::TorsionDriverSettings::TorsionDriverSettings(): 
-	sampleHetAtomHs(false), sampleTolRanges(false), energyOrdered(true), eWindow(0.0), maxPoolSize(10000),
+	sampleHetAtomHs(false), sampleTolRanges(false), energyOrdered(true), eWindow(0.0), maxPoolSize(10000), numThreads(1),
 	forceFieldType(ForceFieldType::MMFF94S_NO_ESTAT), strictParam(true),
 	dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DIELECTRIC_CONSTANT_WATER),
 	distExponent(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DISTANCE_EXPONENT)
@@ -91,6 +91,16 @@ std::size_t ConfGen::TorsionDriverSettings::getMaxPoolSize() const
 	return maxPoolSize;
 }
 
+void ConfGen::TorsionDriverSettings::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t ConfGen::TorsionDriverSettings::getNumThreads() const
+{
+	return numThreads;
+}
+
 void ConfGen::TorsionDriverSettings::setForceFieldType(unsigned int type)
 {
 	forceFieldType = type;
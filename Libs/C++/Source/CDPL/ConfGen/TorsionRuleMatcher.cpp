@@ -27,19 +27,138 @@
 #include "StaticInit.hpp"
 
 #include <algorithm>
+#include <limits>
 
 #include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
 
 #include "CDPL/ConfGen/TorsionRuleMatcher.hpp"
 #include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/BondFunctions.hpp"
+#include "CDPL/Chem/Atom.hpp"
 #include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/Fragment.hpp"
+#include "CDPL/Chem/FragmentList.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomMatchConstraint.hpp"
+#include "CDPL/Chem/BondMatchConstraint.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Chem/HybridizationState.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 
 using namespace CDPL;
 
 
-ConfGen::TorsionRuleMatcher::TorsionRuleMatcher(): uniqueMappingsOnly(true), stopAtFirstRule(true) 
+const std::size_t ConfGen::TorsionRuleMatcher::DEF_RESULT_CACHE_SIZE;
+
+
+namespace
+{
+
+	const unsigned int UNKNOWN_FLAG      = 2;
+	const unsigned int UNKNOWN_HYB_STATE = 0xf;
+	const std::size_t  NO_ENV_ATOM_POS   = std::numeric_limits<std::size_t>::max();
+
+	unsigned int getFlagCode(bool has_flag, bool flag)
+	{
+		return (has_flag ? (unsigned int)flag : UNKNOWN_FLAG);
+	}
+
+	boost::uint64_t getAtomKey(const Chem::Atom& atom)
+	{
+		using namespace Chem;
+
+		boost::uint64_t key = getType(atom) & 0x3ff;
+
+		key |= boost::uint64_t(hasHybridizationState(atom) ? (getHybridizationState(atom) & 0xf) : UNKNOWN_HYB_STATE) << 10;
+		key |= boost::uint64_t(getFlagCode(hasAromaticityFlag(atom), hasAromaticityFlag(atom) && getAromaticityFlag(atom))) << 14;
+		key |= boost::uint64_t(getFlagCode(hasRingFlag(atom), hasRingFlag(atom) && getRingFlag(atom))) << 16;
+
+		return key;
+	}
+
+	boost::uint64_t getBondKey(const Chem::Bond& bond)
+	{
+		using namespace Chem;
+
+		boost::uint64_t atom1_key = getAtomKey(bond.getBegin());
+		boost::uint64_t atom2_key = getAtomKey(bond.getEnd());
+
+		if (atom1_key > atom2_key)
+			std::swap(atom1_key, atom2_key);
+
+		return (atom1_key | (atom2_key << 18) | 
+				(boost::uint64_t(getFlagCode(hasRingFlag(bond), hasRingFlag(bond) && getRingFlag(bond))) << 36));
+	}
+
+	bool flagMatches(int req_flag, unsigned int flag_code)
+	{
+		return (req_flag < 0 || flag_code == UNKNOWN_FLAG || unsigned(req_flag) == flag_code);
+	}
+
+	int getRequiredFlag(const Chem::MatchConstraint& constraint, bool ptn_flag)
+	{
+		using namespace Chem;
+
+		bool value = (constraint.hasValue() ? constraint.getValue().toBool() : ptn_flag);
+
+		switch (constraint.getRelation()) {
+
+			case MatchConstraint::EQUAL:
+				return value;
+
+			case MatchConstraint::NOT_EQUAL:
+				return !value;
+
+			default:
+				return -1;
+		}
+	}
+
+	std::size_t getBondLabel(const Chem::Bond& bond)
+	{
+		using namespace Chem;
+
+		// flag codes are in the range [0, 2]
+
+		return (getOrder(bond) * 9 + getFlagCode(hasAromaticityFlag(bond), hasAromaticityFlag(bond) && getAromaticityFlag(bond)) * 3 +
+				getFlagCode(hasRingFlag(bond), hasRingFlag(bond) && getRingFlag(bond)));
+	}
+
+	void getBondRingRequirement(const Chem::Bond& bond, const Chem::MatchConstraintList& constr_list, int& in_ring)
+	{
+		using namespace Chem;
+
+		if (constr_list.getType() != MatchConstraintList::AND_LIST)
+			return;
+
+		for (MatchConstraintList::ConstElementIterator it = constr_list.getElementsBegin(), end = constr_list.getElementsEnd(); it != end; ++it) {
+			const MatchConstraint& constraint = *it;
+
+			switch (constraint.getID()) {
+
+				case BondMatchConstraint::CONSTRAINT_LIST:
+					if (constraint.getRelation() == MatchConstraint::EQUAL)
+						getBondRingRequirement(bond, *constraint.getValue<MatchConstraintList::SharedPointer>(), in_ring);
+
+					continue;
+
+				case BondMatchConstraint::RING_TOPOLOGY:
+					if (in_ring < 0)
+						in_ring = getRequiredFlag(constraint, hasRingFlag(bond) && getRingFlag(bond));
+
+				default:
+					continue;
+			}
+		}
+	}
+}
+
+
+ConfGen::TorsionRuleMatcher::TorsionRuleMatcher(): 
+	uniqueMappingsOnly(true), stopAtFirstRule(true), maxResultCacheSize(DEF_RESULT_CACHE_SIZE)
 {
 	findAllRuleMappings(false);
 	
@@ -47,7 +166,7 @@ ConfGen::TorsionRuleMatcher::TorsionRuleMatcher(): uniqueMappingsOnly(true), sto
 }
 
 ConfGen::TorsionRuleMatcher::TorsionRuleMatcher(const TorsionLibrary::SharedPointer& lib):
-	torLib(lib), uniqueMappingsOnly(true), stopAtFirstRule(true)
+	torLib(lib), uniqueMappingsOnly(true), stopAtFirstRule(true), maxResultCacheSize(DEF_RESULT_CACHE_SIZE)
 {
 	findAllRuleMappings(false);
 
@@ -97,6 +216,28 @@ const ConfGen::TorsionLibrary::SharedPointer& ConfGen::TorsionRuleMatcher::getTo
     return torLib;
 }
 
+void ConfGen::TorsionRuleMatcher::setResultCacheSize(std::size_t max_size)
+{
+	maxResultCacheSize = max_size;
+
+	for (CompiledLibraryList::iterator it = compiledLibs.begin(), end = compiledLibs.end(); it != end; ++it) {
+		ResultCache& cache = (*it)->resultCache;
+
+		if (cache.size() > max_size)
+			cache.clear();
+	}
+}
+
+std::size_t ConfGen::TorsionRuleMatcher::getResultCacheSize() const
+{
+	return maxResultCacheSize;
+}
+
+void ConfGen::TorsionRuleMatcher::clearCache()
+{
+	compiledLibs.clear();
+}
+
 std::size_t ConfGen::TorsionRuleMatcher::getNumMatches() const
 {
 	return matches.size();
@@ -129,21 +270,85 @@ bool ConfGen::TorsionRuleMatcher::findMatches(const Chem::Bond& bond, const Chem
 	if (!torLib)
 		return false;
 
-	return findMatchingRules(*torLib, bond, molgraph);
+	CompiledLibrary& comp_lib = getCompiledLibrary();
+	boost::uint64_t bond_key = getBondKey(bond);
+
+	// with appended matches, the uniqueness check of outputMatch() may depend on previous calls
+
+	if (stopAtFirstRule && !append && maxResultCacheSize > 0 && comp_lib.cacheable)
+		return findCachedMatches(comp_lib, bond, molgraph, bond_key);
+
+	const CompiledRule* first_rule = 0;
+
+	return findMatchingRules(comp_lib.root, bond, molgraph, bond_key, first_rule);
+}
+
+void ConfGen::TorsionRuleMatcher::BondEnvironment::clear()
+{
+	atomLabels.clear();
+	labelValueOffsets.assign(1, 0);
+	labelValues.clear();
+	nbrOffsets.assign(1, 0);
+	nbrAtoms.clear();
+	nbrBondLabels.clear();
+}
+
+bool ConfGen::TorsionRuleMatcher::findCachedMatches(CompiledLibrary& comp_lib, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph,
+													boost::uint64_t bond_key)
+{
+	std::size_t env_hash = calcEnvironmentSignature(comp_lib, bond, molgraph);
+	ResultCache::iterator it = comp_lib.resultCache.find(env_hash);
+
+	// the outcome of the rule search only depends on the (labeled) bond environment - equal hash codes and 
+	// refined label multisets are necessary but not sufficient for identical environments, so the cached 
+	// result gets used only if the environments are isomorphic
+
+	if (it != comp_lib.resultCache.end() && it->second.signature == envSignature && isCachedEnvironment(it->second.environment)) {
+		if (!it->second.rule)
+			return false;
+
+		// the atom mapping of the cached rule has to be determined anyway - if the rule unexpectedly does 
+		// not match, the full rule hierarchy will be searched again
+
+		if (getRuleMatches(*it->second.rule, bond, molgraph))
+			return true;
+	}
+
+	const CompiledRule* first_rule = 0;
+	bool have_matches = findMatchingRules(comp_lib.root, bond, molgraph, bond_key, first_rule);
+
+	if (comp_lib.resultCache.size() >= maxResultCacheSize)
+		comp_lib.resultCache.clear();
+
+	ResultCacheEntry& entry = comp_lib.resultCache[env_hash];
+
+	entry.signature = envSignature;
+	entry.environment = bondEnv;
+	entry.rule = first_rule;
+
+	return have_matches;
 }
 
-bool ConfGen::TorsionRuleMatcher::findMatchingRules(const TorsionCategory& cat, const Chem::Bond& bond, 
-													const Chem::MolecularGraph& molgraph)
+bool ConfGen::TorsionRuleMatcher::findMatchingRules(CompiledCategory& comp_cat, const Chem::Bond& bond, 
+													const Chem::MolecularGraph& molgraph, boost::uint64_t bond_key,
+													const CompiledRule*& first_rule)
 {
-	if (&cat != torLib.get() && !matchesCategory(cat, bond, molgraph)) 
+	if (comp_cat.category != torLib.get() && !matchesCategory(comp_cat, bond, molgraph)) 
 		return false;
 
 	bool have_matches = false;
 
 // category rules first
 
-	for (TorsionCategory::ConstRuleIterator it = cat.getRulesBegin(), end = cat.getRulesEnd(); it != end; ++it) {
-		if (getRuleMatches(*it, bond, molgraph)) {
+	const CompiledRulePtrList& cand_rules = getCandidateRules(comp_cat, bond_key);
+
+	for (CompiledRulePtrList::const_iterator it = cand_rules.begin(), end = cand_rules.end(); it != end; ++it) {
+		const CompiledRule& comp_rule = **it;
+
+		if (getRuleMatches(comp_rule, bond, molgraph)) {
+			if (!first_rule)
+				first_rule = &comp_rule;
+
 			if (stopAtFirstRule)
 				return true;
 
@@ -153,8 +358,8 @@ bool ConfGen::TorsionRuleMatcher::findMatchingRules(const TorsionCategory& cat,
 
 // subcategories second
 
-	for (TorsionCategory::ConstCategoryIterator it = cat.getCategoriesBegin(), end = cat.getCategoriesEnd(); it != end; ++it) {
-		if (findMatchingRules(*it, bond, molgraph)) {
+	for (CompiledCategoryList::const_iterator it = comp_cat.categories.begin(), end = comp_cat.categories.end(); it != end; ++it) {
+		if (findMatchingRules(**it, bond, molgraph, bond_key, first_rule)) {
 			if (stopAtFirstRule)
 				return true;
 
@@ -165,19 +370,19 @@ bool ConfGen::TorsionRuleMatcher::findMatchingRules(const TorsionCategory& cat,
 	return have_matches;
 }
 
-bool ConfGen::TorsionRuleMatcher::getRuleMatches(const TorsionRule& rule, const Chem::Bond& bond, 
+bool ConfGen::TorsionRuleMatcher::getRuleMatches(const CompiledRule& comp_rule, const Chem::Bond& bond, 
 												 const Chem::MolecularGraph& molgraph)
 {
 	using namespace Chem;
 
+	const TorsionRule& rule = *comp_rule.rule;
 	const MolecularGraph& ptn = *rule.getMatchPattern();
-	std::size_t ctr_bond_idx = getCentralBondIndex(ptn);
 
-	if (ctr_bond_idx == ptn.getNumBonds())
+	if (comp_rule.ctrBondIndex == ptn.getNumBonds())
 		return false;
 
 	subSearch.clearBondMappingConstraints();
-	subSearch.addBondMappingConstraint(ctr_bond_idx, molgraph.getBondIndex(bond));
+	subSearch.addBondMappingConstraint(comp_rule.ctrBondIndex, molgraph.getBondIndex(bond));
 	subSearch.setQuery(ptn);
 	
 	if (!subSearch.findMappings(molgraph)) 
@@ -237,21 +442,18 @@ void ConfGen::TorsionRuleMatcher::outputMatch(const Chem::AtomBondMapping& ab_ma
 	matches.push_back(TorsionRuleMatch(rule, bond, atoms[0], atoms[1], atoms[2], atoms[3]));
 }
 
-bool ConfGen::TorsionRuleMatcher::matchesCategory(const TorsionCategory& cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph)
+bool ConfGen::TorsionRuleMatcher::matchesCategory(const CompiledCategory& comp_cat, const Chem::Bond& bond, const Chem::MolecularGraph& molgraph)
 {
 	using namespace Chem;
 
+	const TorsionCategory& cat = *comp_cat.category;
+
 	if (cat.getMatchPattern()) {
 		const MolecularGraph& ptn = *cat.getMatchPattern();
 
 		if (ptn.getNumBonds() > 0) {
-			std::size_t ctr_bond_idx = getCentralBondIndex(ptn);
-
-			if (ctr_bond_idx == ptn.getNumBonds())
-				ctr_bond_idx = 0;
-
 			subSearch.clearBondMappingConstraints();
-			subSearch.addBondMappingConstraint(ctr_bond_idx, molgraph.getBondIndex(bond));
+			subSearch.addBondMappingConstraint(comp_cat.ctrBondIndex, molgraph.getBondIndex(bond));
 			subSearch.setQuery(ptn);
 		
 			return subSearch.mappingExists(molgraph);
@@ -282,3 +484,638 @@ std::size_t ConfGen::TorsionRuleMatcher::getCentralBondIndex(const Chem::Molecul
 
 	return num_bonds;
 }
+
+ConfGen::TorsionRuleMatcher::CompiledLibrary& ConfGen::TorsionRuleMatcher::getCompiledLibrary()
+{
+	for (CompiledLibraryList::const_iterator it = compiledLibs.begin(), end = compiledLibs.end(); it != end; ++it)
+		if ((*it)->library == torLib)
+			return **it;
+
+	CompiledLibraryPtr comp_lib(new CompiledLibrary());
+
+	comp_lib->library = torLib;
+	comp_lib->cacheable = true;
+	comp_lib->envRadius = 0;
+	comp_lib->atomConstraintMask = 0;
+
+	compileCategory(*torLib, comp_lib->root, *comp_lib);
+
+	compiledLibs.push_back(comp_lib);
+
+	return *comp_lib;
+}
+
+void ConfGen::TorsionRuleMatcher::compileCategory(const TorsionCategory& cat, CompiledCategory& comp_cat, CompiledLibrary& comp_lib)
+{
+	using namespace Chem;
+
+	comp_cat.category = &cat;
+	comp_cat.ctrBondIndex = 0;
+
+	if (cat.getMatchPattern() && cat.getMatchPattern()->getNumBonds() > 0) {
+		const MolecularGraph& ptn = *cat.getMatchPattern();
+
+		comp_cat.ctrBondIndex = getCentralBondIndex(ptn);
+
+		if (comp_cat.ctrBondIndex == ptn.getNumBonds())
+			comp_cat.ctrBondIndex = 0;
+
+		const Bond& ctr_bond = ptn.getBond(comp_cat.ctrBondIndex);
+
+		analyzePattern(ptn, ctr_bond.getBegin(), ctr_bond.getEnd(), 0, comp_lib);
+	}
+
+	comp_cat.rules.resize(cat.getNumRules());
+
+	std::size_t i = 0;
+
+	for (TorsionCategory::ConstRuleIterator it = cat.getRulesBegin(), end = cat.getRulesEnd(); it != end; ++it, i++) 
+		compileRule(*it, comp_cat.rules[i], comp_lib);
+
+	for (TorsionCategory::ConstCategoryIterator it = cat.getCategoriesBegin(), end = cat.getCategoriesEnd(); it != end; ++it) {
+		comp_cat.categories.push_back(CompiledCategoryPtr(new CompiledCategory()));
+
+		compileCategory(*it, *comp_cat.categories.back(), comp_lib);
+	}
+}
+
+void ConfGen::TorsionRuleMatcher::compileRule(const TorsionRule& rule, CompiledRule& comp_rule, CompiledLibrary& comp_lib)
+{
+	using namespace Chem;
+
+	comp_rule.rule = &rule;
+	comp_rule.ctrBondInRing = -1;
+
+	if (!rule.getMatchPattern()) {
+		comp_rule.ctrBondIndex = 0;
+		return;
+	}
+
+	const MolecularGraph& ptn = *rule.getMatchPattern();
+
+	comp_rule.ctrBondIndex = getCentralBondIndex(ptn);
+
+	if (comp_rule.ctrBondIndex == ptn.getNumBonds()) // never matches
+		return;
+
+	const Bond& ctr_bond = ptn.getBond(comp_rule.ctrBondIndex);
+
+	for (std::size_t i = 0; i < 2; i++) {
+		const Atom& atom = ctr_bond.getAtom(i);
+
+		getAtomRequirements(atom, *getMatchConstraints(atom), comp_rule.ctrAtomReqs[getAtomMappingID(atom) == 2 ? 0 : 1]);
+	}
+
+	getBondRingRequirement(ctr_bond, *getMatchConstraints(ctr_bond), comp_rule.ctrBondInRing);
+
+	analyzePattern(ptn, ctr_bond.getBegin(), ctr_bond.getEnd(), 0, comp_lib);
+}
+
+void ConfGen::TorsionRuleMatcher::analyzePattern(const Chem::MolecularGraph& ptn, const Chem::Atom& start_atom1, const Chem::Atom& start_atom2, 
+												 std::size_t base_dist, CompiledLibrary& comp_lib) const
+{
+	using namespace Chem;
+
+	// determine the topological distances of the pattern atoms from the start atoms - the environment of a bond
+	// that needs to be considered for result caching must cover the most distant atom of any pattern
+
+	std::size_t num_atoms = ptn.getNumAtoms();
+	IndexArray atom_dists(num_atoms, num_atoms);
+	IndexArray queue;
+
+	for (std::size_t i = 0; i < 2; i++) {
+		std::size_t atom_idx = ptn.getAtomIndex(i == 0 ? start_atom1 : start_atom2);
+
+		if (atom_dists[atom_idx] == 0)
+			continue;
+
+		atom_dists[atom_idx] = 0;
+		queue.push_back(atom_idx);
+	}
+
+	for (std::size_t i = 0; i < queue.size(); i++) {
+		const Atom& atom = ptn.getAtom(queue[i]);
+		std::size_t dist = atom_dists[queue[i]];
+
+		Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+		for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it, ++b_it) {
+			if (!ptn.containsBond(*b_it) || !ptn.containsAtom(*a_it))
+				continue;
+
+			std::size_t nbr_idx = ptn.getAtomIndex(*a_it);
+
+			if (atom_dists[nbr_idx] <= dist + 1)
+				continue;
+
+			atom_dists[nbr_idx] = dist + 1;
+			queue.push_back(nbr_idx);
+		}
+	}
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		if (atom_dists[i] == num_atoms) { // disconnected pattern atoms may match anywhere
+			comp_lib.cacheable = false;
+			return;
+		}
+
+		std::size_t dist = base_dist + atom_dists[i];
+
+		comp_lib.envRadius = std::max(comp_lib.envRadius, dist);
+
+		analyzeConstraints(*getMatchConstraints(ptn.getAtom(i)), true, dist, comp_lib);
+	}
+
+	for (MolecularGraph::ConstBondIterator it = ptn.getBondsBegin(), end = ptn.getBondsEnd(); it != end; ++it)
+		analyzeConstraints(*getMatchConstraints(*it), false, 0, comp_lib);
+}
+
+void ConfGen::TorsionRuleMatcher::analyzeConstraints(const Chem::MatchConstraintList& constr_list, bool atom_constrs, 
+													 std::size_t atom_dist, CompiledLibrary& comp_lib) const
+{
+	using namespace Chem;
+
+	for (MatchConstraintList::ConstElementIterator it = constr_list.getElementsBegin(), end = constr_list.getElementsEnd(); it != end; ++it) {
+		const MatchConstraint& constraint = *it;
+
+		if (!atom_constrs) {
+			switch (constraint.getID()) {
+
+				case BondMatchConstraint::CONSTRAINT_LIST:
+					analyzeConstraints(*constraint.getValue<MatchConstraintList::SharedPointer>(), false, 0, comp_lib);
+					continue;
+
+				case BondMatchConstraint::ORDER:
+				case BondMatchConstraint::AROMATICITY:
+				case BondMatchConstraint::RING_TOPOLOGY:
+					continue;
+
+				default:                  // stereo and reaction constraints are not covered
+					comp_lib.cacheable = false;
+					continue;
+			}
+		}
+
+		switch (constraint.getID()) {
+
+			case AtomMatchConstraint::CONSTRAINT_LIST:
+				analyzeConstraints(*constraint.getValue<MatchConstraintList::SharedPointer>(), true, atom_dist, comp_lib);
+				continue;
+
+			case AtomMatchConstraint::ENVIRONMENT: {
+				const Molecule& env_ptn = *constraint.getValue<Molecule::SharedPointer>();
+
+				if (env_ptn.getNumAtoms() > 0)
+					analyzePattern(env_ptn, env_ptn.getAtom(0), env_ptn.getAtom(0), atom_dist, comp_lib);
+
+				continue;
+			}
+
+			case AtomMatchConstraint::CONFIGURATION:
+				comp_lib.cacheable = false;
+				continue;
+
+			default:
+				if (constraint.getID() > AtomMatchConstraint::HYBRIDIZATION_STATE) {
+					comp_lib.cacheable = false;
+					continue;
+				}
+
+				comp_lib.atomConstraintMask |= (1UL << constraint.getID());
+		}
+	}
+}
+
+const ConfGen::TorsionRuleMatcher::CompiledRulePtrList& 
+ConfGen::TorsionRuleMatcher::getCandidateRules(CompiledCategory& comp_cat, boost::uint64_t bond_key) const
+{
+	CandidateRuleMap::iterator it = comp_cat.candidateRules.find(bond_key);
+
+	if (it != comp_cat.candidateRules.end())
+		return it->second;
+
+	CompiledRulePtrList& cand_rules = comp_cat.candidateRules[bond_key];
+	boost::uint64_t atom1_key = bond_key & 0x3ffff;
+	boost::uint64_t atom2_key = (bond_key >> 18) & 0x3ffff;
+	unsigned int bond_in_ring = (bond_key >> 36) & 0x3;
+
+	for (CompiledRuleList::const_iterator r_it = comp_cat.rules.begin(), r_end = comp_cat.rules.end(); r_it != r_end; ++r_it) {
+		const CompiledRule& comp_rule = *r_it;
+
+		if (!flagMatches(comp_rule.ctrBondInRing, bond_in_ring))
+			continue;
+
+		if ((atomMatchesRequirements(comp_rule.ctrAtomReqs[0], atom1_key) && atomMatchesRequirements(comp_rule.ctrAtomReqs[1], atom2_key)) ||
+			(atomMatchesRequirements(comp_rule.ctrAtomReqs[0], atom2_key) && atomMatchesRequirements(comp_rule.ctrAtomReqs[1], atom1_key)))
+			cand_rules.push_back(&comp_rule);
+	}
+
+	return cand_rules;
+}
+
+std::size_t ConfGen::TorsionRuleMatcher::calcEnvironmentSignature(const CompiledLibrary& comp_lib, const Chem::Bond& bond, 
+																  const Chem::MolecularGraph& molgraph)
+{
+	using namespace Chem;
+
+	// collect all atoms within comp_lib.envRadius bonds of the bond atoms
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+
+	// atoms outside the environment are marked by an invalid position that does not depend on the size of the 
+	// processed molecular graph
+
+	if (envAtomPositions.size() < num_atoms)
+		envAtomPositions.resize(num_atoms, NO_ENV_ATOM_POS);
+
+	envAtoms.clear();
+	envAtomDists.clear();
+
+	for (std::size_t i = 0; i < 2; i++) {
+		std::size_t atom_idx = molgraph.getAtomIndex(bond.getAtom(i));
+
+		envAtomPositions[atom_idx] = envAtoms.size();
+		envAtoms.push_back(atom_idx);
+		envAtomDists.push_back(0);
+	}
+
+	for (std::size_t i = 0; i < envAtoms.size(); i++) {
+		std::size_t dist = envAtomDists[i];
+
+		if (dist == comp_lib.envRadius)
+			continue;
+
+		const Atom& atom = molgraph.getAtom(envAtoms[i]);
+		Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+		for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it, ++b_it) {
+			if (!molgraph.containsBond(*b_it) || !molgraph.containsAtom(*a_it))
+				continue;
+
+			std::size_t nbr_idx = molgraph.getAtomIndex(*a_it);
+
+			if (envAtomPositions[nbr_idx] != NO_ENV_ATOM_POS)
+				continue;
+
+			envAtomPositions[nbr_idx] = envAtoms.size();
+			envAtoms.push_back(nbr_idx);
+			envAtomDists.push_back(dist + 1);
+		}
+	}
+
+	// record the exact atom labels and the bonds between environment atoms
+
+	std::size_t num_env_atoms = envAtoms.size();
+
+	bondEnv.clear();
+	bondEnv.atomLabels.resize(num_env_atoms);
+	tmpEnvAtomLabels.resize(num_env_atoms);
+
+	for (std::size_t i = 0; i < num_env_atoms; i++) {
+		const Atom& atom = molgraph.getAtom(envAtoms[i]);
+		std::size_t offset = bondEnv.labelValues.size();
+
+		getAtomLabelValues(comp_lib, atom, molgraph, bondEnv.labelValues);
+
+		bondEnv.labelValues.push_back(envAtomDists[i]);
+		bondEnv.labelValueOffsets.push_back(bondEnv.labelValues.size());
+		bondEnv.atomLabels[i] = boost::hash_range(bondEnv.labelValues.begin() + offset, bondEnv.labelValues.end());
+
+		Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+		for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it, ++b_it) {
+			const Bond& nbr_bond = *b_it;
+
+			if (!molgraph.containsBond(nbr_bond) || !molgraph.containsAtom(*a_it))
+				continue;
+
+			std::size_t nbr_pos = envAtomPositions[molgraph.getAtomIndex(*a_it)];
+
+			if (nbr_pos == NO_ENV_ATOM_POS)
+				continue;
+
+			bondEnv.nbrAtoms.push_back(nbr_pos);
+			bondEnv.nbrBondLabels.push_back(getBondLabel(nbr_bond));
+		}
+
+		bondEnv.nbrOffsets.push_back(bondEnv.nbrAtoms.size());
+	}
+
+	for (IndexArray::const_iterator it = envAtoms.begin(), end = envAtoms.end(); it != end; ++it)
+		envAtomPositions[*it] = NO_ENV_ATOM_POS;
+
+	// iteratively refine the atom labels by the labels of their bonded environment atoms
+
+	for (std::size_t i = 0; i <= comp_lib.envRadius; i++) {
+		for (std::size_t j = 0; j < num_env_atoms; j++) {
+			nbrLabels.clear();
+
+			for (std::size_t k = bondEnv.nbrOffsets[j], nbrs_end = bondEnv.nbrOffsets[j + 1]; k < nbrs_end; k++) {
+				std::size_t nbr_label = bondEnv.nbrBondLabels[k];
+
+				boost::hash_combine(nbr_label, bondEnv.atomLabels[bondEnv.nbrAtoms[k]]);
+
+				nbrLabels.push_back(nbr_label);
+			}
+
+			std::sort(nbrLabels.begin(), nbrLabels.end());
+
+			std::size_t label = bondEnv.atomLabels[j];
+
+			boost::hash_range(label, nbrLabels.begin(), nbrLabels.end());
+
+			tmpEnvAtomLabels[j] = label;
+		}
+
+		bondEnv.atomLabels.swap(tmpEnvAtomLabels);
+	}
+
+	envSignature.assign(bondEnv.atomLabels.begin(), bondEnv.atomLabels.end());
+
+	std::sort(envSignature.begin(), envSignature.end());
+
+	return boost::hash_range(envSignature.begin(), envSignature.end());
+}
+
+void ConfGen::TorsionRuleMatcher::getAtomLabelValues(const CompiledLibrary& comp_lib, const Chem::Atom& atom, 
+													const Chem::MolecularGraph& molgraph, LabelValueArray& values)
+{
+	using namespace Chem;
+
+	// only properties that are checked by the rule patterns of the library contribute to the label
+
+	values.push_back(getType(atom));
+	unsigned long constr_mask = comp_lib.atomConstraintMask;
+
+	for (unsigned int i = AtomMatchConstraint::ISOTOPE; i <= AtomMatchConstraint::HYBRIDIZATION_STATE; i++) {
+		if (!(constr_mask & (1UL << i)))
+			continue;
+
+		switch (i) {
+
+			case AtomMatchConstraint::ISOTOPE:
+				values.push_back(getIsotope(atom));
+				continue;
+
+			case AtomMatchConstraint::CHARGE:
+				values.push_back(getFormalCharge(atom));
+				continue;
+
+			case AtomMatchConstraint::RING_BOND_COUNT:
+				values.push_back(getRingBondCount(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::H_COUNT:
+				values.push_back(getAtomCount(atom, molgraph, AtomType::H, true));
+				continue;
+
+			case AtomMatchConstraint::IMPLICIT_H_COUNT:
+				values.push_back(hasImplicitHydrogenCount(atom) ? getImplicitHydrogenCount(atom) : std::size_t(0));
+				continue;
+
+			case AtomMatchConstraint::EXPLICIT_H_COUNT:
+				values.push_back(getExplicitAtomCount(atom, molgraph, AtomType::H, true));
+				continue;
+
+			case AtomMatchConstraint::BOND_COUNT:
+				values.push_back(getBondCount(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::EXPLICIT_BOND_COUNT:
+				values.push_back(getExplicitBondCount(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::HEAVY_BOND_COUNT:
+				values.push_back(getHeavyBondCount(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::VALENCE:
+				values.push_back(calcValence(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::EXPLICIT_VALENCE:
+				values.push_back(calcExplicitValence(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::AROMATICITY:
+				values.push_back(getFlagCode(hasAromaticityFlag(atom), hasAromaticityFlag(atom) && getAromaticityFlag(atom)));
+				continue;
+
+			case AtomMatchConstraint::RING_TOPOLOGY:
+				values.push_back(getFlagCode(hasRingFlag(atom), hasRingFlag(atom) && getRingFlag(atom)));
+				continue;
+
+			case AtomMatchConstraint::UNSATURATION:
+				values.push_back(isUnsaturated(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::SSSR_RING_COUNT:
+				values.push_back(getNumContainingSSSRRings(atom, molgraph));
+				continue;
+
+			case AtomMatchConstraint::SSSR_RING_SIZE: {
+				const FragmentList& sssr = *getSSSR(molgraph);
+
+				ringSizes.clear();
+
+				for (FragmentList::ConstElementIterator it = sssr.getElementsBegin(), end = sssr.getElementsEnd(); it != end; ++it)
+					if (it->containsAtom(atom))
+						ringSizes.push_back(it->getNumAtoms());
+
+				std::sort(ringSizes.begin(), ringSizes.end());
+
+				values.push_back(ringSizes.size());
+				values.insert(values.end(), ringSizes.begin(), ringSizes.end());
+				continue;
+			}
+
+			case AtomMatchConstraint::HYBRIDIZATION_STATE:
+				values.push_back(hasHybridizationState(atom) ? getHybridizationState(atom) : UNKNOWN_HYB_STATE);
+				continue;
+
+			default:
+				continue;
+		}
+	}
+}
+
+bool ConfGen::TorsionRuleMatcher::isCachedEnvironment(const BondEnvironment& cached_env)
+{
+	std::size_t num_env_atoms = bondEnv.atomLabels.size();
+
+	if (cached_env.atomLabels.size() != num_env_atoms || cached_env.labelValues.size() != bondEnv.labelValues.size() ||
+		cached_env.nbrAtoms.size() != bondEnv.nbrAtoms.size())
+		return false;
+
+	envAtomMapping.assign(num_env_atoms, num_env_atoms);
+	mappedCachedEnvAtoms.assign(num_env_atoms, false);
+
+	return mapEnvironmentAtoms(cached_env, 0);
+}
+
+bool ConfGen::TorsionRuleMatcher::mapEnvironmentAtoms(const BondEnvironment& cached_env, std::size_t pos)
+{
+	// environment atoms are processed in breadth-first order, so every atom but the bond atoms has a
+	// previously mapped neighbor whose image restricts the candidate atoms of the cached environment
+
+	std::size_t num_env_atoms = bondEnv.atomLabels.size();
+
+	if (pos == num_env_atoms)
+		return true;
+
+	std::size_t cands_beg = 0;
+	std::size_t cands_end = 0;
+	const IndexArray* cands = 0;
+
+	for (std::size_t i = bondEnv.nbrOffsets[pos], nbrs_end = bondEnv.nbrOffsets[pos + 1]; i < nbrs_end; i++) {
+		std::size_t nbr_image = envAtomMapping[bondEnv.nbrAtoms[i]];
+
+		if (nbr_image == num_env_atoms)
+			continue;
+
+		cands = &cached_env.nbrAtoms;
+		cands_beg = cached_env.nbrOffsets[nbr_image];
+		cands_end = cached_env.nbrOffsets[nbr_image + 1];
+		break;
+	}
+
+	if (!cands) {
+		cands_beg = 0;
+		cands_end = num_env_atoms;
+	}
+
+	for (std::size_t i = cands_beg; i < cands_end; i++) {
+		std::size_t cand_pos = (cands ? (*cands)[i] : i);
+
+		if (mappedCachedEnvAtoms[cand_pos] || !environmentAtomsMatch(cached_env, pos, cand_pos))
+			continue;
+
+		envAtomMapping[pos] = cand_pos;
+		mappedCachedEnvAtoms[cand_pos] = true;
+
+		if (mapEnvironmentAtoms(cached_env, pos + 1))
+			return true;
+
+		mappedCachedEnvAtoms[cand_pos] = false;
+	}
+
+	envAtomMapping[pos] = num_env_atoms;
+
+	return false;
+}
+
+bool ConfGen::TorsionRuleMatcher::environmentAtomsMatch(const BondEnvironment& cached_env, std::size_t pos, std::size_t cached_pos) const
+{
+	if (bondEnv.atomLabels[pos] != cached_env.atomLabels[cached_pos])
+		return false;
+
+	if ((bondEnv.nbrOffsets[pos + 1] - bondEnv.nbrOffsets[pos]) != (cached_env.nbrOffsets[cached_pos + 1] - cached_env.nbrOffsets[cached_pos]))
+		return false;
+
+	if ((bondEnv.labelValueOffsets[pos + 1] - bondEnv.labelValueOffsets[pos]) != 
+		(cached_env.labelValueOffsets[cached_pos + 1] - cached_env.labelValueOffsets[cached_pos]))
+		return false;
+
+	if (!std::equal(bondEnv.labelValues.begin() + bondEnv.labelValueOffsets[pos], bondEnv.labelValues.begin() + bondEnv.labelValueOffsets[pos + 1],
+					cached_env.labelValues.begin() + cached_env.labelValueOffsets[cached_pos]))
+		return false;
+
+	// bonds to already mapped atoms must have a counterpart of the same type in the cached environment and vice versa
+
+	std::size_t num_env_atoms = bondEnv.atomLabels.size();
+	std::size_t num_mapped_nbrs = 0;
+
+	for (std::size_t i = bondEnv.nbrOffsets[pos], nbrs_end = bondEnv.nbrOffsets[pos + 1]; i < nbrs_end; i++) {
+		std::size_t nbr_image = envAtomMapping[bondEnv.nbrAtoms[i]];
+
+		if (nbr_image == num_env_atoms)
+			continue;
+
+		bool found = false;
+
+		for (std::size_t j = cached_env.nbrOffsets[cached_pos], c_nbrs_end = cached_env.nbrOffsets[cached_pos + 1]; j < c_nbrs_end; j++) {
+			if (cached_env.nbrAtoms[j] == nbr_image && cached_env.nbrBondLabels[j] == bondEnv.nbrBondLabels[i]) {
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+			return false;
+
+		num_mapped_nbrs++;
+	}
+
+	for (std::size_t j = cached_env.nbrOffsets[cached_pos], c_nbrs_end = cached_env.nbrOffsets[cached_pos + 1]; j < c_nbrs_end; j++)
+		if (mappedCachedEnvAtoms[cached_env.nbrAtoms[j]])
+			num_mapped_nbrs--;
+
+	return (num_mapped_nbrs == 0);
+}
+
+
+void ConfGen::TorsionRuleMatcher::getAtomRequirements(const Chem::Atom& atom, const Chem::MatchConstraintList& constr_list, 
+													  AtomRequirements& reqs) const
+{
+	using namespace Chem;
+
+	if (constr_list.getType() != MatchConstraintList::AND_LIST)
+		return;
+
+	for (MatchConstraintList::ConstElementIterator it = constr_list.getElementsBegin(), end = constr_list.getElementsEnd(); it != end; ++it) {
+		const MatchConstraint& constraint = *it;
+
+		switch (constraint.getID()) {
+
+			case AtomMatchConstraint::CONSTRAINT_LIST:
+				if (constraint.getRelation() == MatchConstraint::EQUAL)
+					getAtomRequirements(atom, *constraint.getValue<MatchConstraintList::SharedPointer>(), reqs);
+
+				continue;
+
+			case AtomMatchConstraint::TYPE:
+				if (constraint.getRelation() == MatchConstraint::EQUAL && reqs.type == AtomType::UNKNOWN)
+					reqs.type = (constraint.hasValue() ? constraint.getValue<unsigned int>() : getType(atom));
+
+				continue;
+
+			case AtomMatchConstraint::HYBRIDIZATION_STATE:
+				if (constraint.getRelation() == MatchConstraint::EQUAL && constraint.hasValue() && reqs.hybState == HybridizationState::UNKNOWN)
+					reqs.hybState = constraint.getValue<unsigned int>();
+
+				continue;
+
+			case AtomMatchConstraint::AROMATICITY:
+				if (reqs.aromatic < 0)
+					reqs.aromatic = getRequiredFlag(constraint, hasAromaticityFlag(atom) && getAromaticityFlag(atom));
+
+				continue;
+
+			case AtomMatchConstraint::RING_TOPOLOGY:
+				if (reqs.inRing < 0)
+					reqs.inRing = getRequiredFlag(constraint, hasRingFlag(atom) && getRingFlag(atom));
+
+			default:
+				continue;
+		}
+	}
+}
+
+bool ConfGen::TorsionRuleMatcher::atomMatchesRequirements(const AtomRequirements& reqs, boost::uint64_t atom_key) const
+{
+	using namespace Chem;
+
+	if (reqs.type != AtomType::UNKNOWN && !atomTypesMatch(reqs.type, atom_key & 0x3ff))
+		return false;
+
+	unsigned int hyb_state = (atom_key >> 10) & 0xf;
+
+	if (reqs.hybState != HybridizationState::UNKNOWN && hyb_state != UNKNOWN_HYB_STATE && reqs.hybState != hyb_state)
+		return false;
+
+	return (flagMatches(reqs.aromatic, (atom_key >> 14) & 0x3) && flagMatches(reqs.inRing, (atom_key >> 16) & 0x3));
+}
+
+ConfGen::TorsionRuleMatcher::AtomRequirements::AtomRequirements():
+	type(Chem::AtomType::UNKNOWN), hybState(Chem::HybridizationState::UNKNOWN), aromatic(-1), inRing(-1)
+{}
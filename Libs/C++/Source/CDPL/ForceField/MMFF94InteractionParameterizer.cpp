@@ -57,7 +57,8 @@ ForceField::MMFF94InteractionParameterizer::MMFF94InteractionParameterizer(const
 	electrostaticParameterizer(parameterizer.electrostaticParameterizer),
 	atomTyper(parameterizer.atomTyper),
 	bondTyper(parameterizer.bondTyper),
-	chargeCalculator(parameterizer.chargeCalculator)
+	chargeCalculator(parameterizer.chargeCalculator),
+	cache(parameterizer.cache)
 {
 	setPropertyFunctions();
 }
@@ -220,6 +221,16 @@ void ForceField::MMFF94InteractionParameterizer::setParameterSet(unsigned int pa
 	torsionParameterizer.setTorsionParameterTable(MMFF94TorsionParameterTable::get(param_set));
 }
 
+void ForceField::MMFF94InteractionParameterizer::setCache(const MMFF94ParameterizationCache::SharedPointer& cache)
+{
+	this->cache = cache;
+}
+
+const ForceField::MMFF94ParameterizationCache::SharedPointer& ForceField::MMFF94InteractionParameterizer::getCache() const
+{
+	return cache;
+}
+
 void ForceField::MMFF94InteractionParameterizer::parameterize(const Chem::MolecularGraph& molgraph, MMFF94InteractionData& ia_data,
 															  unsigned int ia_types, bool strict)
 {
@@ -269,6 +280,7 @@ ForceField::MMFF94InteractionParameterizer& ForceField::MMFF94InteractionParamet
 	atomTyper = parameterizer.atomTyper;
 	bondTyper = parameterizer.bondTyper;
 	chargeCalculator = parameterizer.chargeCalculator;
+	cache = parameterizer.cache;
 	
 	setPropertyFunctions();
 
@@ -345,6 +357,11 @@ std::size_t ForceField::MMFF94InteractionParameterizer::getTopologicalDistance(c
 void ForceField::MMFF94InteractionParameterizer::setup(const Chem::MolecularGraph& molgraph, unsigned int ia_types, bool strict)
 {
 	molGraph = &molgraph;
+	perceivedTypes = false;
+	perceivedCharges = false;
+	usedPropertyData = false;
+
+	lookupCacheEntry(strict);
 
 	setupAromaticRingSet();
 	setupAtomTypes(strict);
@@ -355,6 +372,59 @@ void ForceField::MMFF94InteractionParameterizer::setup(const Chem::MolecularGrap
 
 	if (ia_types & InteractionType::ELECTROSTATIC)
 		setupAtomCharges(strict);
+
+	updateCache(strict);
+}
+
+void ForceField::MMFF94InteractionParameterizer::lookupCacheEntry(bool strict)
+{
+	cacheEntry.reset();
+
+	if (!cache)
+		return;
+
+	cacheHashCode = MMFF94ParameterizationCache::calcSignature(*molGraph, strict, canonNumGenerator, canonNumbering, 
+															   cacheAtomOrder, cacheBondOrder, cacheSignature);
+	cacheEntry = cache->getEntry(cacheHashCode, cacheSignature, strict);
+}
+
+void ForceField::MMFF94InteractionParameterizer::updateCache(bool strict)
+{
+	if (!cache || usedPropertyData)
+		return;
+
+	if (!perceivedTypes && !perceivedCharges)
+		return;
+
+	MMFF94ParameterizationCache::Entry* entry = new MMFF94ParameterizationCache::Entry();
+	MMFF94ParameterizationCache::EntryPointer entry_ptr(entry);
+
+	// cache entries store the data in canonical atom and bond order
+
+	std::size_t num_atoms = cacheAtomOrder.size();
+	std::size_t num_bonds = cacheBondOrder.size();
+
+	entry->hasCharges = (perceivedCharges || (cacheEntry && cacheEntry->hasCharges));
+
+	entry->symAtomTypes.resize(num_atoms);
+	entry->numAtomTypes.resize(num_atoms);
+	entry->bondTypeIndices.resize(num_bonds);
+
+	if (entry->hasCharges)
+		entry->atomCharges.resize(num_atoms);
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		entry->symAtomTypes[i] = symAtomTypes[cacheAtomOrder[i]];
+		entry->numAtomTypes[i] = numAtomTypes[cacheAtomOrder[i]];
+
+		if (entry->hasCharges)
+			entry->atomCharges[i] = atomCharges[cacheAtomOrder[i]];
+	}
+
+	for (std::size_t i = 0; i < num_bonds; i++)
+		entry->bondTypeIndices[i] = bondTypeIndices[cacheBondOrder[i]];
+
+	cache->addEntry(cacheHashCode, cacheSignature, strict, entry_ptr);
 }
 
 void ForceField::MMFF94InteractionParameterizer::setupAromaticRingSet()
@@ -391,7 +461,17 @@ void ForceField::MMFF94InteractionParameterizer::setupAtomTypes(bool strict)
 				throw ParameterizationFailed("MMFF94InteractionParameterizer: encountered invalid MMFF94 type for atom #" + boost::lexical_cast<std::string>(i));
 
 		} else {
+			if (cacheEntry) {
+				for (std::size_t j = 0; j < num_atoms; j++) {
+					symAtomTypes[cacheAtomOrder[j]] = cacheEntry->symAtomTypes[j];
+					numAtomTypes[cacheAtomOrder[j]] = cacheEntry->numAtomTypes[j];
+				}
+
+				return;
+			}
+
 			atomTyper.perceiveTypes(*molGraph, symAtomTypes, numAtomTypes, strict);
+			perceivedTypes = true;
 
 			if (strict) {
 				for (std::size_t j = 0; j < num_atoms; j++) 
@@ -402,6 +482,8 @@ void ForceField::MMFF94InteractionParameterizer::setupAtomTypes(bool strict)
 			return;
 		}
 	}
+
+	usedPropertyData = true;
 }
 
 void ForceField::MMFF94InteractionParameterizer::setupBondTypeIndices(bool strict)
@@ -419,10 +501,20 @@ void ForceField::MMFF94InteractionParameterizer::setupBondTypeIndices(bool stric
 			bondTypeIndices[i] = getMMFF94TypeIndex(bond);
 
 		} else {
-			bondTyper.perceiveTypes(*molGraph, bondTypeIndices, strict);
+			if (cacheEntry && !perceivedTypes && !usedPropertyData) {
+				for (std::size_t j = 0; j < num_bonds; j++)
+					bondTypeIndices[cacheBondOrder[j]] = cacheEntry->bondTypeIndices[j];
+
+			} else {
+				bondTyper.perceiveTypes(*molGraph, bondTypeIndices, strict);
+				perceivedTypes = true;
+			}
+
 			return;
 		}
 	}
+
+	usedPropertyData = true;
 }
 
 void ForceField::MMFF94InteractionParameterizer::setupAtomCharges(bool strict)
@@ -440,10 +532,20 @@ void ForceField::MMFF94InteractionParameterizer::setupAtomCharges(bool strict)
 			atomCharges[i] = getMMFF94Charge(atom);
 
 		else {
-			chargeCalculator.calculate(*molGraph, atomCharges, strict);
+			if (cacheEntry && cacheEntry->hasCharges && !perceivedTypes && !usedPropertyData) {
+				for (std::size_t j = 0; j < num_atoms; j++)
+					atomCharges[cacheAtomOrder[j]] = cacheEntry->atomCharges[j];
+
+			} else {
+				chargeCalculator.calculate(*molGraph, atomCharges, strict);
+				perceivedCharges = true;
+			}
+
 			return;
 		}
 	}
+
+	usedPropertyData = true;
 }
 
 void ForceField::MMFF94InteractionParameterizer::setupTopDistances()
@@ -0,0 +1,312 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * MMFF94ParameterizationCache.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+ 
+#include "StaticInit.hpp"
+
+#include <algorithm>
+
+#include <boost/functional/hash.hpp>
+#include <boost/thread/once.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/BondFunctions.hpp"
+#include "CDPL/Chem/CanonicalNumberingGenerator.hpp"
+#include "CDPL/Chem/AtomPropertyFlag.hpp"
+#include "CDPL/Chem/BondPropertyFlag.hpp"
+
+
+using namespace CDPL; 
+
+
+namespace
+{
+
+	ForceField::MMFF94ParameterizationCache::SharedPointer globalCache;
+	boost::once_flag                                       initGlobalCacheFlag = BOOST_ONCE_INIT;
+
+	void initGlobalCache() 
+	{
+		globalCache.reset(new ForceField::MMFF94ParameterizationCache());
+	}
+
+	const Base::uint64 UNDEF_PROPERTY = ~Base::uint64(0);
+
+	struct AtomCanonOrderLessCmp
+	{
+
+		AtomCanonOrderLessCmp(const CDPL::Util::STArray& numbering): numbering(numbering) {}
+
+		bool operator()(std::size_t idx1, std::size_t idx2) const {
+			if (numbering[idx1] != numbering[idx2])
+				return (numbering[idx1] < numbering[idx2]);
+
+			return (idx1 < idx2);
+		}
+
+		const CDPL::Util::STArray& numbering;
+	};
+
+	struct BondCanonOrderLessCmp
+	{
+
+		BondCanonOrderLessCmp(const std::vector<CDPL::Base::uint64>& bond_keys): bondKeys(bond_keys) {}
+
+		bool operator()(std::size_t idx1, std::size_t idx2) const {
+			for (std::size_t i = 0; i < 3; i++)
+				if (bondKeys[idx1 * 3 + i] != bondKeys[idx2 * 3 + i])
+					return (bondKeys[idx1 * 3 + i] < bondKeys[idx2 * 3 + i]);
+
+			return (idx1 < idx2);
+		}
+
+		const std::vector<CDPL::Base::uint64>& bondKeys;
+	};
+}
+
+
+const std::size_t ForceField::MMFF94ParameterizationCache::DEFAULT_MAX_SIZE;
+
+
+ForceField::MMFF94ParameterizationCache::MMFF94ParameterizationCache(std::size_t max_size):
+	maxSize(max_size), numHits(0), numMisses(0)
+{}
+
+void ForceField::MMFF94ParameterizationCache::setMaxSize(std::size_t max_size)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	maxSize = max_size;
+
+	shrink();
+}
+
+std::size_t ForceField::MMFF94ParameterizationCache::getMaxSize() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	return maxSize;
+}
+
+std::size_t ForceField::MMFF94ParameterizationCache::getSize() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	return hashToRecordMap.size();
+}
+
+std::size_t ForceField::MMFF94ParameterizationCache::getNumHits() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	return numHits;
+}
+
+std::size_t ForceField::MMFF94ParameterizationCache::getNumMisses() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	return numMisses;
+}
+
+void ForceField::MMFF94ParameterizationCache::clear()
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	records.clear();
+	hashToRecordMap.clear();
+
+	numHits = 0;
+	numMisses = 0;
+}
+
+const ForceField::MMFF94ParameterizationCache::SharedPointer& ForceField::MMFF94ParameterizationCache::get()
+{
+	boost::call_once(&initGlobalCache, initGlobalCacheFlag);
+
+	return globalCache;
+}
+
+ForceField::MMFF94ParameterizationCache::EntryPointer 
+ForceField::MMFF94ParameterizationCache::getEntry(Base::uint64 hash_code, const Signature& sig, bool strict)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	HashToRecordMap::iterator it = hashToRecordMap.find(hash_code);
+
+	if (it == hashToRecordMap.end() || it->second->strict != strict || it->second->signature != sig) {
+		numMisses++;
+		return EntryPointer();
+	}
+
+	// move record to the front of the LRU list
+
+	records.splice(records.begin(), records, it->second);
+	numHits++;
+
+	return records.front().entry;
+}
+
+void ForceField::MMFF94ParameterizationCache::addEntry(Base::uint64 hash_code, const Signature& sig, bool strict, const EntryPointer& entry)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	if (maxSize == 0)
+		return;
+
+	HashToRecordMap::iterator it = hashToRecordMap.find(hash_code);
+
+	if (it != hashToRecordMap.end()) { // replace existing record (update or hash collision)
+		Record& rec = *it->second;
+
+		rec.signature = sig;
+		rec.strict = strict;
+		rec.entry = entry;
+
+		records.splice(records.begin(), records, it->second);
+		return;
+	}
+
+	records.push_front(Record());
+
+	Record& rec = records.front();
+
+	rec.hashCode = hash_code;
+	rec.signature = sig;
+	rec.strict = strict;
+	rec.entry = entry;
+
+	hashToRecordMap.insert(HashToRecordMap::value_type(hash_code, records.begin()));
+
+	shrink();
+}
+
+void ForceField::MMFF94ParameterizationCache::shrink()
+{
+	while (hashToRecordMap.size() > maxSize) {
+		hashToRecordMap.erase(records.back().hashCode);
+		records.pop_back();
+	}
+}
+
+Base::uint64 ForceField::MMFF94ParameterizationCache::calcSignature(const Chem::MolecularGraph& molgraph, bool strict, 
+																   Chem::CanonicalNumberingGenerator& canon_num_gen, Util::STArray& canon_numbering,
+																   Util::STArray& atom_order, Util::STArray& bond_order, Signature& sig)
+{
+	using namespace Chem;
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+	std::size_t num_bonds = molgraph.getNumBonds();
+
+	// establish a canonical atom order - only properties that are guaranteed to be available get considered, atoms 
+	// that are not distinguished by them are ordered by their index and may cause a cache miss but never a wrong hit
+
+	canon_num_gen.setAtomPropertyFlags(AtomPropertyFlag::TYPE | AtomPropertyFlag::FORMAL_CHARGE | AtomPropertyFlag::H_COUNT);
+	canon_num_gen.setBondPropertyFlags(BondPropertyFlag::ORDER);
+	canon_num_gen.generate(molgraph, canon_numbering);
+
+	atom_order.resize(num_atoms);
+
+	for (std::size_t i = 0; i < num_atoms; i++)
+		atom_order[i] = i;
+
+	std::sort(atom_order.getElementsBegin(), atom_order.getElementsEnd(), AtomCanonOrderLessCmp(canon_numbering));
+
+	for (std::size_t i = 0; i < num_atoms; i++)
+		canon_numbering[atom_order[i]] = i;
+
+	// order the bonds by the canonical indices of their atoms (sig temporarily holds the sort keys)
+
+	Signature& bond_keys = sig;
+
+	bond_keys.resize(num_bonds * 3);
+	bond_order.resize(num_bonds);
+
+	for (std::size_t i = 0; i < num_bonds; i++) {
+		const Bond& bond = molgraph.getBond(i);
+
+		if (!molgraph.containsAtom(bond.getBegin()) || !molgraph.containsAtom(bond.getEnd())) { // sanity check
+			bond_keys[i * 3] = num_atoms;
+			bond_keys[i * 3 + 1] = num_atoms;
+
+		} else {
+			std::size_t atom1_idx = canon_numbering[molgraph.getAtomIndex(bond.getBegin())];
+			std::size_t atom2_idx = canon_numbering[molgraph.getAtomIndex(bond.getEnd())];
+
+			bond_keys[i * 3] = std::min(atom1_idx, atom2_idx);
+			bond_keys[i * 3 + 1] = std::max(atom1_idx, atom2_idx);
+		}
+
+		bond_keys[i * 3 + 2] = getOrder(bond);
+		bond_order[i] = i;
+	}
+
+	std::sort(bond_order.getElementsBegin(), bond_order.getElementsEnd(), BondCanonOrderLessCmp(bond_keys));
+
+	sig.clear();
+	sig.reserve(num_atoms * 5 + num_bonds * 4 + 2);
+
+	sig.push_back(num_atoms);
+	sig.push_back(num_bonds);
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		const Atom& atom = molgraph.getAtom(atom_order[i]);
+
+		sig.push_back(getType(atom));
+		sig.push_back(Base::uint64(getFormalCharge(atom)));
+		sig.push_back(hasImplicitHydrogenCount(atom) ? Base::uint64(getImplicitHydrogenCount(atom)) : UNDEF_PROPERTY);
+		sig.push_back(hasRingFlag(atom) ? Base::uint64(getRingFlag(atom)) : UNDEF_PROPERTY);
+		sig.push_back(hasAromaticityFlag(atom) ? Base::uint64(getAromaticityFlag(atom)) : UNDEF_PROPERTY);
+	}
+
+	for (std::size_t i = 0; i < num_bonds; i++) {
+		const Bond& bond = molgraph.getBond(bond_order[i]);
+
+		if (!molgraph.containsAtom(bond.getBegin()) || !molgraph.containsAtom(bond.getEnd())) // sanity check
+			sig.push_back(UNDEF_PROPERTY);
+
+		else {
+			std::size_t atom1_idx = canon_numbering[molgraph.getAtomIndex(bond.getBegin())];
+			std::size_t atom2_idx = canon_numbering[molgraph.getAtomIndex(bond.getEnd())];
+
+			sig.push_back(std::min(atom1_idx, atom2_idx));
+			sig.push_back(std::max(atom1_idx, atom2_idx));
+		}
+
+		sig.push_back(getOrder(bond));
+		sig.push_back(hasAromaticityFlag(bond) ? Base::uint64(getAromaticityFlag(bond)) : UNDEF_PROPERTY);
+	}
+
+	std::size_t hash_code = boost::hash_range(sig.begin(), sig.end());
+
+	boost::hash_combine(hash_code, strict);
+
+	return hash_code;
+}
@@ -36,6 +36,7 @@
 #include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
 #include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Util/BitSet.hpp"
 
 #include "MMFF94TestData.hpp"
 
@@ -53,8 +54,10 @@ BOOST_AUTO_TEST_CASE(MMFF94GradientCalculatorTest)
     ForceField::MMFF94InteractionData ia_data;
     ForceField::MMFF94EnergyCalculator<double> en_calc;
     ForceField::MMFF94GradientCalculator<double> gr_calc;
+    ForceField::MMFF94GradientCalculator<double> ref_gr_calc;
     Math::Vector3DArray coords;
     Math::Vector3DArray grad;
+    Math::Vector3DArray inc_grad;
     Math::Vector3D num_atom_grad;
 
 	for (bool stat = false; !stat; stat = true) {
@@ -76,6 +79,7 @@ BOOST_AUTO_TEST_CASE(MMFF94GradientCalculatorTest)
 			parameterizer.parameterize(mol, ia_data);
 			en_calc.setup(ia_data);
 			gr_calc.setup(ia_data, mol.getNumAtoms());
+			ref_gr_calc.setup(ia_data, mol.getNumAtoms());
 
 			gr_calc(coords, grad);
 			en_calc(coords);
@@ -136,6 +140,47 @@ BOOST_AUTO_TEST_CASE(MMFF94GradientCalculatorTest)
 			BOOST_CHECK_MESSAGE((max_diff <= GRAD_DELTA_MAX), 
 								"Gradient deviation too large for molecule #" << mol_idx << " (" << getName(mol) <<
 								"): max. numerical/analytical grad. element deviation of " << max_diff << " > " << GRAD_DELTA_MAX);
+
+			// incremental calculation mode: displace every second atom and compare with a full calculation
+
+			Util::BitSet mov_atom_mask(coords.getSize());
+
+			for (std::size_t i = 0; i < coords.getSize(); i += 2)
+				mov_atom_mask.set(i);
+
+			en_calc.setMovableAtomMask(mov_atom_mask);
+			gr_calc.setMovableAtomMask(mov_atom_mask);
+			
+			inc_grad.resize(coords.getSize());
+
+			for (std::size_t j = 0; j < 3; j++) {
+				for (std::size_t i = 0; i < coords.getSize(); i += 2)
+					coords[i][j] += 0.05;
+
+				en_calc(coords);
+				gr_calc(coords, inc_grad);
+				ref_gr_calc(coords, grad);
+
+				BOOST_CHECK_MESSAGE(std::abs(en_calc.getTotalEnergy() - ref_gr_calc.getTotalEnergy()) <= E_DELTA_MAX, 
+									"Incremental total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+									"): energy calculator energy " << en_calc.getTotalEnergy() << " != " << ref_gr_calc.getTotalEnergy());
+
+				BOOST_CHECK_MESSAGE(std::abs(gr_calc.getTotalEnergy() - ref_gr_calc.getTotalEnergy()) <= E_DELTA_MAX, 
+									"Incremental total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+									"): grad. calculator energy " << gr_calc.getTotalEnergy() << " != " << ref_gr_calc.getTotalEnergy());
+
+				max_diff = 0.0;
+
+				for (std::size_t i = 0; i < coords.getSize(); i++)
+					max_diff = std::max(max_diff, normInf(grad[i] - inc_grad[i]));
+
+				BOOST_CHECK_MESSAGE((max_diff <= E_DELTA_MAX), 
+									"Incremental gradient deviation too large for molecule #" << mol_idx << " (" << getName(mol) <<
+									"): max. grad. element deviation of " << max_diff << " > " << E_DELTA_MAX);
+			}
+
+			en_calc.resetMovableAtomMask();
+			gr_calc.resetMovableAtomMask();
 		}
     }
 }
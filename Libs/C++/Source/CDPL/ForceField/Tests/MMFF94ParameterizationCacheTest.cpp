@@ -0,0 +1,190 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * MMFF94ParameterizationCacheTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ForceField/MMFF94InteractionData.hpp"
+#include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
+#include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
+#include "CDPL/ForceField/AtomFunctions.hpp"
+#include "CDPL/ForceField/BondFunctions.hpp"
+#include "CDPL/ForceField/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Fragment.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+
+#include "MMFF94TestData.hpp"
+
+
+BOOST_AUTO_TEST_CASE(MMFF94ParameterizationCacheTest)
+{
+    using namespace CDPL;
+    using namespace Testing;
+
+	const MMFF94TestData::MoleculeList& mols = MMFF94TestData::DYN_TEST_MOLECULES;
+
+	MMFF94TestData::MoleculeList untyped_mols;
+
+	for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+		Chem::BasicMolecule::SharedPointer mol_ptr(new Chem::BasicMolecule(*mols[mol_idx]));
+		Chem::BasicMolecule& mol = *mol_ptr;
+
+		for (Chem::BasicMolecule::AtomIterator it = mol.getAtomsBegin(), end = mol.getAtomsEnd(); it != end; ++it) {
+			ForceField::clearMMFF94SymbolicType(*it);
+			ForceField::clearMMFF94NumericType(*it);
+		}
+
+		for (Chem::BasicMolecule::BondIterator it = mol.getBondsBegin(), end = mol.getBondsEnd(); it != end; ++it) 
+			ForceField::clearMMFF94TypeIndex(*it);
+
+		// ring and distance data of the copied molecule refer to the atoms and bonds of the source molecule
+
+		perceiveSSSR(mol, true);
+		calcTopologicalDistanceMatrix(mol, true);
+		ForceField::perceiveMMFF94AromaticRings(mol, true);
+
+		untyped_mols.push_back(mol_ptr);
+	}
+
+	ForceField::MMFF94ParameterizationCache::SharedPointer cache(new ForceField::MMFF94ParameterizationCache());
+	ForceField::MMFF94InteractionParameterizer parameterizer(ForceField::MMFF94ParameterSet::DYNAMIC);
+	ForceField::MMFF94InteractionParameterizer cached_parameterizer(ForceField::MMFF94ParameterSet::DYNAMIC);
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::MMFF94InteractionData cached_ia_data;
+    ForceField::MMFF94EnergyCalculator<double> en_calc;
+    ForceField::MMFF94EnergyCalculator<double> cached_en_calc;
+    Math::Vector3DArray coords;
+
+	BOOST_CHECK(!parameterizer.getCache());
+
+	cached_parameterizer.setCache(cache);
+
+	BOOST_CHECK(cached_parameterizer.getCache() == cache);
+
+	for (std::size_t pass = 0; pass < 2; pass++) {
+		std::size_t num_hits = cache->getNumHits();
+
+		for (std::size_t mol_idx = 0; mol_idx < untyped_mols.size(); mol_idx++) {
+			const Chem::Molecule& mol = *untyped_mols[mol_idx];
+
+			coords.clear();
+			get3DCoordinates(mol, coords);
+
+			parameterizer.parameterize(mol, ia_data);
+			cached_parameterizer.parameterize(mol, cached_ia_data);
+
+			BOOST_CHECK_MESSAGE(ia_data.getElectrostaticInteractions().getSize() == cached_ia_data.getElectrostaticInteractions().getSize(), 
+								"Electrostatic interaction count mismatch for molecule #" << mol_idx << " (" << getName(mol) << ")");
+
+			BOOST_CHECK_MESSAGE(ia_data.getTorsionInteractions().getSize() == cached_ia_data.getTorsionInteractions().getSize(), 
+								"Torsion interaction count mismatch for molecule #" << mol_idx << " (" << getName(mol) << ")");
+
+			en_calc.setup(ia_data);
+			cached_en_calc.setup(cached_ia_data);
+
+			en_calc(coords);
+			cached_en_calc(coords);
+
+			BOOST_CHECK_MESSAGE(en_calc.getTotalEnergy() == cached_en_calc.getTotalEnergy(), 
+								"Total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) << ") in pass " << pass << 
+								": cached parameters energy " << cached_en_calc.getTotalEnergy() << " != " << en_calc.getTotalEnergy());
+
+			BOOST_CHECK_MESSAGE(en_calc.getElectrostaticEnergy() == cached_en_calc.getElectrostaticEnergy(), 
+								"Electrostatic energy mismatch for molecule #" << mol_idx << " (" << getName(mol) << ") in pass " << pass << 
+								": cached parameters energy " << cached_en_calc.getElectrostaticEnergy() << " != " << en_calc.getElectrostaticEnergy());
+		}
+
+		if (pass > 0)
+			BOOST_CHECK_EQUAL(cache->getNumHits() - num_hits, untyped_mols.size());
+	}
+
+	BOOST_CHECK(cache->getSize() <= untyped_mols.size());
+
+	// entries are keyed on a canonical atom order and thus also serve molecular graphs with permuted atoms and bonds
+
+	std::size_t num_hits = cache->getNumHits();
+
+	for (std::size_t mol_idx = 0; mol_idx < untyped_mols.size(); mol_idx++) {
+		const Chem::Molecule& mol = *untyped_mols[mol_idx];
+		Chem::Fragment rev_molgraph;
+
+		for (std::size_t i = mol.getNumAtoms(); i > 0; i--)
+			rev_molgraph.addAtom(mol.getAtom(i - 1));
+
+		for (std::size_t i = mol.getNumBonds(); i > 0; i--)
+			rev_molgraph.addBond(mol.getBond(i - 1));
+
+		perceiveSSSR(rev_molgraph, true);
+		calcTopologicalDistanceMatrix(rev_molgraph, true);
+		ForceField::perceiveMMFF94AromaticRings(rev_molgraph, true);
+
+		coords.clear();
+		get3DCoordinates(rev_molgraph, coords);
+
+		parameterizer.parameterize(rev_molgraph, ia_data);
+		cached_parameterizer.parameterize(rev_molgraph, cached_ia_data);
+
+		en_calc.setup(ia_data);
+		cached_en_calc.setup(cached_ia_data);
+
+		en_calc(coords);
+		cached_en_calc(coords);
+
+		// cached charges were calculated in a different atom order and may thus differ in the last digits
+
+		BOOST_CHECK_MESSAGE(std::abs(en_calc.getTotalEnergy() - cached_en_calc.getTotalEnergy()) <= 1.0e-8 * std::max(1.0, std::abs(en_calc.getTotalEnergy())), 
+							"Total energy mismatch for reordered molecule #" << mol_idx << " (" << getName(mol) << 
+							"): cached parameters energy " << cached_en_calc.getTotalEnergy() << " != " << en_calc.getTotalEnergy());
+	}
+
+	BOOST_CHECK_EQUAL(cache->getNumHits() - num_hits, untyped_mols.size());
+
+	// molecules with assigned MMFF94 atom and bond types bypass the cache
+
+	std::size_t cache_size = cache->getSize();
+
+	cache->clear();
+
+	BOOST_CHECK_EQUAL(cache->getSize(), std::size_t(0));
+
+	for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) 
+		cached_parameterizer.parameterize(*mols[mol_idx], cached_ia_data);
+
+	BOOST_CHECK_EQUAL(cache->getSize(), std::size_t(0));
+
+	cache->setMaxSize(1);
+	
+	for (std::size_t mol_idx = 0; mol_idx < untyped_mols.size() && mol_idx < cache_size; mol_idx++) 
+		cached_parameterizer.parameterize(*untyped_mols[mol_idx], cached_ia_data);
+
+	BOOST_CHECK_EQUAL(cache->getSize(), std::size_t(1));
+}
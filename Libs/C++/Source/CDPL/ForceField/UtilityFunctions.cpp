@@ -33,6 +33,41 @@
 using namespace CDPL;
 
 
+namespace
+{
+
+	template <typename IactionType>
+	bool involvesAtom2(const IactionType& iactn, const Util::BitSet& atom_mask)
+	{
+		return (atom_mask.test(iactn.getAtom1Index()) || atom_mask.test(iactn.getAtom2Index()));
+	}
+
+	template <typename IactionType>
+	bool involvesAtom3(const IactionType& iactn, const Util::BitSet& atom_mask)
+	{
+		return (involvesAtom2(iactn, atom_mask) || atom_mask.test(iactn.getAtom3Index()));
+	}
+
+	template <typename IactionType>
+	bool involvesAtom4(const IactionType& iactn, const Util::BitSet& atom_mask)
+	{
+		return (involvesAtom3(iactn, atom_mask) || atom_mask.test(iactn.getAtom4Index()));
+	}
+
+	template <typename IactionData, typename Pred>
+	void splitInteractionData(const IactionData& ia_data, IactionData& dep_ia_data, IactionData& indep_ia_data,
+							  const Util::BitSet& atom_mask, const Pred& pred)
+	{
+		for (typename IactionData::ConstElementIterator it = ia_data.getElementsBegin(), end = ia_data.getElementsEnd(); it != end; ++it) {
+			if (pred(*it, atom_mask))
+				dep_ia_data.addElement(*it);
+			else
+				indep_ia_data.addElement(*it);
+		}
+	}
+}
+
+
 void ForceField::filterInteractions(const MMFF94InteractionData& ia_data, MMFF94InteractionData& filtered_ia_data, 
 									const Util::BitSet& inc_atom_mask)
 {
@@ -145,3 +180,22 @@ void ForceField::filterInteractions(const MMFF94InteractionData& ia_data, MMFF94
 		filtered_ia_data.getTorsionInteractions().addElement(iactn);
     }
 }
+
+void ForceField::splitInteractions(const MMFF94InteractionData& ia_data, MMFF94InteractionData& dep_ia_data, 
+								   MMFF94InteractionData& indep_ia_data, const Util::BitSet& atom_mask)
+{
+	splitInteractionData(ia_data.getBondStretchingInteractions(), dep_ia_data.getBondStretchingInteractions(), 
+						 indep_ia_data.getBondStretchingInteractions(), atom_mask, &involvesAtom2<MMFF94BondStretchingInteraction>);
+	splitInteractionData(ia_data.getVanDerWaalsInteractions(), dep_ia_data.getVanDerWaalsInteractions(), 
+						 indep_ia_data.getVanDerWaalsInteractions(), atom_mask, &involvesAtom2<MMFF94VanDerWaalsInteraction>);
+	splitInteractionData(ia_data.getElectrostaticInteractions(), dep_ia_data.getElectrostaticInteractions(), 
+						 indep_ia_data.getElectrostaticInteractions(), atom_mask, &involvesAtom2<MMFF94ElectrostaticInteraction>);
+	splitInteractionData(ia_data.getAngleBendingInteractions(), dep_ia_data.getAngleBendingInteractions(), 
+						 indep_ia_data.getAngleBendingInteractions(), atom_mask, &involvesAtom3<MMFF94AngleBendingInteraction>);
+	splitInteractionData(ia_data.getStretchBendInteractions(), dep_ia_data.getStretchBendInteractions(), 
+						 indep_ia_data.getStretchBendInteractions(), atom_mask, &involvesAtom3<MMFF94StretchBendInteraction>);
+	splitInteractionData(ia_data.getOutOfPlaneBendingInteractions(), dep_ia_data.getOutOfPlaneBendingInteractions(), 
+						 indep_ia_data.getOutOfPlaneBendingInteractions(), atom_mask, &involvesAtom4<MMFF94OutOfPlaneBendingInteraction>);
+	splitInteractionData(ia_data.getTorsionInteractions(), dep_ia_data.getTorsionInteractions(), 
+						 indep_ia_data.getTorsionInteractions(), atom_mask, &involvesAtom4<MMFF94TorsionInteraction>);
+}
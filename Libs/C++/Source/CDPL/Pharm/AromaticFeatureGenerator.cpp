@@ -115,10 +115,12 @@ Pharm::FeatureGenerator::SharedPointer Pharm::AromaticFeatureGenerator::clone()
 	return FeatureGenerator::SharedPointer(new AromaticFeatureGenerator(*this));
 }
 
-void Pharm::AromaticFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+void Pharm::AromaticFeatureGenerator::prepareNonPatternFeatures(const Chem::MolecularGraph& molgraph)
 {
 	using namespace Chem;
 
+	featureRings.clear();
+
 	aromSSSRSubset.extract(molgraph);
 	ringAtomMask.resize(molgraph.getNumAtoms());
 
@@ -136,6 +138,17 @@ void Pharm::AromaticFeatureGenerator::addNonPatternFeatures(const Chem::Molecula
 		if (isContainedInExMatchList(ringAtomMask) || isContainedInIncMatchList(ringAtomMask))
 			continue;
 
+		featureRings.push_back(*it);
+	}
+}
+
+void Pharm::AromaticFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+{
+	using namespace Chem;
+
+	for (RingList::const_iterator it = featureRings.begin(), end = featureRings.end(); it != end; ++it) {
+		const Fragment& ring = **it;
+
 		featureAtoms.clear();
 
 		std::transform(ring.getAtomsBegin(), ring.getAtomsEnd(), 
@@ -26,6 +26,9 @@
 
 #include "StaticInit.hpp"
 
+#include <cmath>
+#include <algorithm>
+
 #include "CDPL/Pharm/DefaultInteractionAnalyzer.hpp"
 #include "CDPL/Pharm/IonicInteractionConstraint.hpp"
 #include "CDPL/Pharm/HydrophobicInteractionConstraint.hpp"
@@ -40,6 +43,19 @@
 using namespace CDPL; 
 
 
+namespace
+{
+
+	// distance between the donor feature and the hydrogen atom as assumed by HBondingInteractionConstraint
+	const double H_BOND_LENGTH = 1.05;
+
+	double calcPlaneDistanceBound(double max_v_dist, double max_h_dist)
+	{
+		return std::sqrt(max_v_dist * max_v_dist + max_h_dist * max_h_dist);
+	}
+}
+
+
 Pharm::DefaultInteractionAnalyzer::DefaultInteractionAnalyzer()
 {
     init();
@@ -53,19 +69,30 @@ Pharm::DefaultInteractionAnalyzer::DefaultInteractionAnalyzer(const FeatureConta
 
 void Pharm::DefaultInteractionAnalyzer::init()
 {
-	setConstraintFunction(FeatureType::POS_IONIZABLE, FeatureType::NEG_IONIZABLE, IonicInteractionConstraint());
-	setConstraintFunction(FeatureType::NEG_IONIZABLE, FeatureType::POS_IONIZABLE, IonicInteractionConstraint());
+	setConstraintFunction(FeatureType::POS_IONIZABLE, FeatureType::NEG_IONIZABLE, IonicInteractionConstraint(), 
+						  IonicInteractionConstraint::DEF_MAX_DISTANCE);
+	setConstraintFunction(FeatureType::NEG_IONIZABLE, FeatureType::POS_IONIZABLE, IonicInteractionConstraint(), 
+						  IonicInteractionConstraint::DEF_MAX_DISTANCE);
 
-	setConstraintFunction(FeatureType::HYDROPHOBIC, FeatureType::HYDROPHOBIC, HydrophobicInteractionConstraint());
+	setConstraintFunction(FeatureType::HYDROPHOBIC, FeatureType::HYDROPHOBIC, HydrophobicInteractionConstraint(), 
+						  HydrophobicInteractionConstraint::DEF_MAX_DISTANCE);
 
-	setConstraintFunction(FeatureType::H_BOND_DONOR, FeatureType::H_BOND_ACCEPTOR, HBondingInteractionConstraint(true));
-	setConstraintFunction(FeatureType::H_BOND_ACCEPTOR, FeatureType::H_BOND_DONOR, HBondingInteractionConstraint(false));
+	setConstraintFunction(FeatureType::H_BOND_DONOR, FeatureType::H_BOND_ACCEPTOR, HBondingInteractionConstraint(true), 
+						  HBondingInteractionConstraint::DEF_MAX_HB_LENGTH + H_BOND_LENGTH);
+	setConstraintFunction(FeatureType::H_BOND_ACCEPTOR, FeatureType::H_BOND_DONOR, HBondingInteractionConstraint(false), 
+						  HBondingInteractionConstraint::DEF_MAX_HB_LENGTH + H_BOND_LENGTH);
 
-	setConstraintFunction(FeatureType::AROMATIC, FeatureType::POS_IONIZABLE, CationPiInteractionConstraint(true));
-	setConstraintFunction(FeatureType::POS_IONIZABLE, FeatureType::AROMATIC, CationPiInteractionConstraint(false));
+	setConstraintFunction(FeatureType::AROMATIC, FeatureType::POS_IONIZABLE, CationPiInteractionConstraint(true), 
+						  CationPiInteractionConstraint::DEF_MAX_DISTANCE);
+	setConstraintFunction(FeatureType::POS_IONIZABLE, FeatureType::AROMATIC, CationPiInteractionConstraint(false), 
+						  CationPiInteractionConstraint::DEF_MAX_DISTANCE);
 
 	setConstraintFunction(FeatureType::AROMATIC, FeatureType::AROMATIC, 
 						  InteractionConstraintConnector(false, 
 														 OrthogonalPiPiInteractionConstraint(), 
-														 ParallelPiPiInteractionConstraint()));
+														 ParallelPiPiInteractionConstraint()),
+						  std::max(calcPlaneDistanceBound(OrthogonalPiPiInteractionConstraint::DEF_MAX_V_DISTANCE, 
+														  OrthogonalPiPiInteractionConstraint::DEF_MAX_H_DISTANCE),
+								   calcPlaneDistanceBound(ParallelPiPiInteractionConstraint::DEF_MAX_V_DISTANCE, 
+														  ParallelPiPiInteractionConstraint::DEF_MAX_H_DISTANCE)));
 }
@@ -81,6 +81,8 @@ double Pharm::DefaultInteractionScoreGridSetCalculator::getXStepSize() const
 void Pharm::DefaultInteractionScoreGridSetCalculator::setXStepSize(double size)
 {
     xStepSize = size;
+
+    clearIncrementalState();
 }
 
 double Pharm::DefaultInteractionScoreGridSetCalculator::getYStepSize() const
@@ -91,6 +93,8 @@ double Pharm::DefaultInteractionScoreGridSetCalculator::getYStepSize() const
 void Pharm::DefaultInteractionScoreGridSetCalculator::setYStepSize(double size)
 {
     yStepSize = size;
+
+    clearIncrementalState();
 }
 
 double Pharm::DefaultInteractionScoreGridSetCalculator::getZStepSize() const
@@ -101,6 +105,8 @@ double Pharm::DefaultInteractionScoreGridSetCalculator::getZStepSize() const
 void Pharm::DefaultInteractionScoreGridSetCalculator::setZStepSize(double size)
 {
     zStepSize = size;
+
+    clearIncrementalState();
 }
 
 std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridXSize() const
@@ -111,6 +117,8 @@ std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridXSize() cons
 void Pharm::DefaultInteractionScoreGridSetCalculator::setGridXSize(std::size_t size)
 {
     gridXSize = size;
+
+    clearIncrementalState();
 }
 
 std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridYSize() const
@@ -121,6 +129,8 @@ std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridYSize() cons
 void Pharm::DefaultInteractionScoreGridSetCalculator::setGridYSize(std::size_t size)
 {
     gridYSize = size;
+
+    clearIncrementalState();
 }
 
 std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridZSize() const
@@ -131,6 +141,8 @@ std::size_t Pharm::DefaultInteractionScoreGridSetCalculator::getGridZSize() cons
 void Pharm::DefaultInteractionScoreGridSetCalculator::setGridZSize(std::size_t size)
 {
     gridZSize = size;
+
+    clearIncrementalState();
 }
 
 void Pharm::DefaultInteractionScoreGridSetCalculator::calculate(const FeatureContainer& features, Grid::DRegularGridSet& grid_set)
@@ -155,6 +167,15 @@ Grid::DSpatialGrid::SharedPointer Pharm::DefaultInteractionScoreGridSetCalculato
 	return grid_ptr;
 }
 
+bool Pharm::DefaultInteractionScoreGridSetCalculator::isGridValid(const Grid::DSpatialGrid& grid) const
+{
+	for (std::size_t i = 0, num_grids = gridSet->getSize(); i < num_grids; i++)
+		if (&(*gridSet)[i] == &grid)
+			return true;
+
+	return false;
+}
+
 void Pharm::DefaultInteractionScoreGridSetCalculator::init()
 {
 	setScoringFunction(FeatureType::POS_IONIZABLE, FeatureType::NEG_IONIZABLE, IonicInteractionScore());
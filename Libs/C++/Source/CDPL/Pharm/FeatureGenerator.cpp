@@ -29,14 +29,15 @@
 #include "CDPL/Pharm/FeatureGenerator.hpp"
 #include "CDPL/Chem/Atom.hpp"
 #include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 
 using namespace CDPL; 
 
 
-Pharm::FeatureGenerator::FeatureGenerator(): coordsFunc(&Chem::get3DCoordinates) {}
+Pharm::FeatureGenerator::FeatureGenerator(): coordsFunc(&Chem::get3DCoordinates), preparedMolGraph(0) {}
 
-Pharm::FeatureGenerator::FeatureGenerator(const FeatureGenerator& gen): coordsFunc(gen.coordsFunc) {}
+Pharm::FeatureGenerator::FeatureGenerator(const FeatureGenerator& gen): coordsFunc(gen.coordsFunc), preparedMolGraph(0) {}
 
 void Pharm::FeatureGenerator::setAtom3DCoordinatesFunction(const Chem::Atom3DCoordinatesFunction& func)
 {
@@ -48,6 +49,19 @@ const Chem::Atom3DCoordinatesFunction& Pharm::FeatureGenerator::getAtom3DCoordin
 	return coordsFunc;
 }
 
+void Pharm::FeatureGenerator::prepare(const Chem::MolecularGraph& molgraph)
+{
+	preparedMolGraph = &molgraph;
+}
+
+void Pharm::FeatureGenerator::instantiate(Pharmacophore& pharm)
+{
+	if (!preparedMolGraph)
+		throw Base::OperationFailed("FeatureGenerator: prepare() has to be called before instantiate()");
+
+	generate(*preparedMolGraph, pharm);
+}
+
 Pharm::FeatureGenerator& Pharm::FeatureGenerator::operator=(const FeatureGenerator& gen)
 {
 	if (this != &gen)
@@ -125,9 +125,13 @@ Pharm::FeatureGenerator::SharedPointer Pharm::HydrophobicAtomFeatureGenerator::c
 	return FeatureGenerator::SharedPointer(new HydrophobicAtomFeatureGenerator(*this));
 }
 
-void Pharm::HydrophobicAtomFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+void Pharm::HydrophobicAtomFeatureGenerator::prepareNonPatternFeatures(const Chem::MolecularGraph& molgraph)
 {
 	init(molgraph);
+}
+
+void Pharm::HydrophobicAtomFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+{
 	genFeatures(pharm);
 }
 
@@ -167,9 +167,16 @@ Pharm::FeatureGenerator::SharedPointer Pharm::HydrophobicFeatureGenerator::clone
 	return FeatureGenerator::SharedPointer(new HydrophobicFeatureGenerator(*this));
 }
 
-void Pharm::HydrophobicFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+void Pharm::HydrophobicFeatureGenerator::prepareNonPatternFeatures(const Chem::MolecularGraph& molgraph)
 {
 	init(molgraph);
+}
+
+// ring features are subject to a geometrical check and therefore all features get perceived per conformation
+
+void Pharm::HydrophobicFeatureGenerator::addNonPatternFeatures(const Chem::MolecularGraph& molgraph, Pharmacophore& pharm)
+{
+	procAtomMask.reset();
 
 	genRingFeatures(pharm);
 	genGroupFeatures(pharm);
@@ -183,7 +190,6 @@ void Pharm::HydrophobicFeatureGenerator::init(const Chem::MolecularGraph& molgra
 	std::size_t num_atoms = molgraph.getNumAtoms();
 
 	procAtomMask.resize(num_atoms);
-	procAtomMask.reset();
 
 	hAtomMask.resize(num_atoms);
 	hAtomMask.reset();
@@ -26,10 +26,21 @@
 
 #include "StaticInit.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
 #include "CDPL/Pharm/InteractionAnalyzer.hpp"
 #include "CDPL/Pharm/FeatureContainer.hpp"
 #include "CDPL/Pharm/Feature.hpp"
 #include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 
 using namespace CDPL; 
@@ -39,17 +50,200 @@ namespace
 {
 
     const Pharm::InteractionAnalyzer::ConstraintFunction DEF_FUNC;
+
+	const double DIST_CHECK_TOLERANCE = 1.0e-6;
 }
 
 
-void Pharm::InteractionAnalyzer::setConstraintFunction(unsigned int type1, unsigned int type2, const ConstraintFunction& func)
+class Pharm::InteractionAnalyzer::SpatialIndex
+{
+
+  public:
+	typedef std::vector<std::size_t> IndexList;
+
+	struct CellKey
+	{
+
+		CellKey(long x, long y, long z): x(x), y(y), z(z) {}
+
+		bool operator==(const CellKey& key) const {
+			return (x == key.x && y == key.y && z == key.z);
+		}
+
+		friend std::size_t hash_value(const CellKey& key) {
+			std::size_t seed = 0;
+
+			boost::hash_combine(seed, key.x);
+			boost::hash_combine(seed, key.y);
+			boost::hash_combine(seed, key.z);
+
+			return seed;
+		}
+
+		long x;
+		long y;
+		long z;
+	};
+
+	typedef boost::unordered_map<CellKey, IndexList, boost::hash<CellKey> > CellMap;
+
+	struct TypeGrid
+	{
+
+		TypeGrid(): cellSize(-1.0) {}
+
+		double    cellSize;
+		CellMap   cells;
+		IndexList allFeatures;
+		IndexList nonPosFeatures;
+	};
+
+	typedef std::map<unsigned int, TypeGrid> TypeGridMap;
+
+	SpatialIndex(const FeatureContainer& cntnr, const ConstraintFunctionMap& cf_map);
+
+	const FeatureContainer& getContainer() const {
+		return container;
+	}
+
+	const Feature& getFeature(std::size_t idx) const {
+		return *features[idx];
+	}
+
+	void getCandidates(const Feature& ftr, const ConstraintFunctionMap& cf_map, IndexList& cands) const;
+
+  private:
+	static CellKey getCellKey(const Math::Vector3D& pos, double cell_size) {
+		return CellKey(long(std::floor(pos[0] / cell_size)), long(std::floor(pos[1] / cell_size)), long(std::floor(pos[2] / cell_size)));
+	}
+
+	typedef std::vector<const Feature*> FeatureList;
+	typedef std::vector<Math::Vector3D> CoordinatesList;
+
+	const FeatureContainer& container;
+	FeatureList             features;
+	CoordinatesList         positions;
+	TypeGridMap             typeGrids;
+};
+
+
+Pharm::InteractionAnalyzer::SpatialIndex::SpatialIndex(const FeatureContainer& cntnr, const ConstraintFunctionMap& cf_map):
+	container(cntnr)
 {
-    constraintFuncMap[FeatureTypePair(type1, type2)] = func;
+	for (ConstraintFunctionMap::const_iterator it = cf_map.begin(), end = cf_map.end(); it != end; ++it) {
+		if (!it->second.function)
+			continue;
+
+		TypeGrid& grid = typeGrids[it->first.second];
+
+		if (grid.cellSize == 0.0)
+			continue;
+
+		if (it->second.maxDistance < 0.0)
+			grid.cellSize = 0.0;
+		else
+			grid.cellSize = std::max(grid.cellSize, it->second.maxDistance + DIST_CHECK_TOLERANCE);
+	}
+
+	for (FeatureContainer::ConstFeatureIterator it = cntnr.getFeaturesBegin(), end = cntnr.getFeaturesEnd(); it != end; ++it) {
+		const Feature& ftr = *it;
+		TypeGridMap::iterator tg_it = typeGrids.find(getType(ftr));
+
+		if (tg_it == typeGrids.end())
+			continue;
+
+		TypeGrid& grid = tg_it->second;
+		std::size_t idx = features.size();
+
+		features.push_back(&ftr);
+		grid.allFeatures.push_back(idx);
+
+		if (!has3DCoordinates(ftr)) {
+			positions.push_back(Math::Vector3D());
+			grid.nonPosFeatures.push_back(idx);
+			continue;
+		}
+
+		positions.push_back(get3DCoordinates(ftr));
+
+		if (grid.cellSize > 0.0)
+			grid.cells[getCellKey(positions.back(), grid.cellSize)].push_back(idx);
+	}
+}
+
+void Pharm::InteractionAnalyzer::SpatialIndex::getCandidates(const Feature& ftr, const ConstraintFunctionMap& cf_map, IndexList& cands) const
+{
+	cands.clear();
+
+	ConstraintFunctionMap::const_iterator cf_map_end = cf_map.end();
+	FeatureTypePair type_pair(getType(ftr), 0);
+	bool has_pos = has3DCoordinates(ftr);
+	const Math::Vector3D* pos = (has_pos ? &get3DCoordinates(ftr) : 0);
+	Math::Vector3D ftr_vec;
+
+	for (TypeGridMap::const_iterator tg_it = typeGrids.begin(), tg_end = typeGrids.end(); tg_it != tg_end; ++tg_it) {
+		type_pair.second = tg_it->first;
+
+		ConstraintFunctionMap::const_iterator cf_it = cf_map.find(type_pair);
+
+		if (cf_it == cf_map_end || !cf_it->second.function)
+			continue;
+
+		const TypeGrid& grid = tg_it->second;
+		double max_dist = cf_it->second.maxDistance;
+
+		if (!has_pos || max_dist < 0.0 || grid.cellSize <= 0.0 || max_dist >= grid.cellSize) {
+			cands.insert(cands.end(), grid.allFeatures.begin(), grid.allFeatures.end());
+			continue;
+		}
+
+		cands.insert(cands.end(), grid.nonPosFeatures.begin(), grid.nonPosFeatures.end());
+
+		if (grid.cells.empty())
+			continue;
+
+		CellKey key = getCellKey(*pos, grid.cellSize);
+		CellMap::const_iterator cells_end = grid.cells.end();
+		double max_dist_sqrd = (max_dist + DIST_CHECK_TOLERANCE) * (max_dist + DIST_CHECK_TOLERANCE);
+
+		for (long x = key.x - 1; x <= key.x + 1; x++) {
+			for (long y = key.y - 1; y <= key.y + 1; y++) {
+				for (long z = key.z - 1; z <= key.z + 1; z++) {
+					CellMap::const_iterator c_it = grid.cells.find(CellKey(x, y, z));
+
+					if (c_it == cells_end)
+						continue;
+
+					for (IndexList::const_iterator it = c_it->second.begin(), end = c_it->second.end(); it != end; ++it) {
+						ftr_vec.assign(positions[*it] - *pos);
+
+						if (innerProd(ftr_vec, ftr_vec) <= max_dist_sqrd)
+							cands.push_back(*it);
+					}
+				}
+			}
+		}
+	}
+
+	std::sort(cands.begin(), cands.end());
+}
+
+//-----
+
+void Pharm::InteractionAnalyzer::setConstraintFunction(unsigned int type1, unsigned int type2, const ConstraintFunction& func, double max_dist)
+{
+	ConstraintData& data = constraintFuncMap[FeatureTypePair(type1, type2)];
+
+	data.function = func;
+	data.maxDistance = max_dist;
+
+	updateSpatialIndex();
 }
 
 void Pharm::InteractionAnalyzer::removeConstraintFunction(unsigned int type1, unsigned int type2)
 {
-    constraintFuncMap.erase(FeatureTypePair(type1, type2));
+    if (constraintFuncMap.erase(FeatureTypePair(type1, type2)) > 0)
+		updateSpatialIndex();
 }
 
 const Pharm::InteractionAnalyzer::ConstraintFunction& 
@@ -57,7 +251,14 @@ Pharm::InteractionAnalyzer::getConstraintFunction(unsigned int type1, unsigned i
 {
     ConstraintFunctionMap::const_iterator it = constraintFuncMap.find(FeatureTypePair(type1, type2));
 
-    return (it == constraintFuncMap.end() ? DEF_FUNC : it->second);
+    return (it == constraintFuncMap.end() ? DEF_FUNC : it->second.function);
+}
+
+double Pharm::InteractionAnalyzer::getMaximumDistance(unsigned int type1, unsigned int type2) const
+{
+    ConstraintFunctionMap::const_iterator it = constraintFuncMap.find(FeatureTypePair(type1, type2));
+
+    return (it == constraintFuncMap.end() ? -1.0 : it->second.maxDistance);
 }
 
 void Pharm::InteractionAnalyzer::analyze(const FeatureContainer& cntnr1, const FeatureContainer& cntnr2, 
@@ -79,11 +280,105 @@ void Pharm::InteractionAnalyzer::analyze(const FeatureContainer& cntnr1, const F
 
 			ConstraintFunctionMap::const_iterator cf_it = constraintFuncMap.find(type_pair);
 
-			if (cf_it == cf_map_end || !cf_it->second)
+			if (cf_it == cf_map_end || !cf_it->second.function)
 				continue;
 
-			if (cf_it->second(ftr1, ftr2))
+			if (cf_it->second.function(ftr1, ftr2))
 				iactions.insertEntry(&ftr1, &ftr2);
 		}
 	}
 }
+
+void Pharm::InteractionAnalyzer::prepare(const FeatureContainer& cntnr2)
+{
+	spatialIndex.reset(new SpatialIndex(cntnr2, constraintFuncMap));
+}
+
+void Pharm::InteractionAnalyzer::analyze(const FeatureContainer& cntnr1, FeatureMapping& iactions, bool append) const
+{
+	if (!spatialIndex)
+		throw Base::OperationFailed("InteractionAnalyzer: no prepared feature container");
+
+	if (!append)
+		iactions.clear();
+
+	SpatialIndex::IndexList cands;
+	FeatureTypePair type_pair;
+
+	for (FeatureContainer::ConstFeatureIterator it1 = cntnr1.getFeaturesBegin(), end1 = cntnr1.getFeaturesEnd(); it1 != end1; ++it1) {
+		const Feature& ftr1 = *it1;
+
+		spatialIndex->getCandidates(ftr1, constraintFuncMap, cands);
+
+		if (cands.empty())
+			continue;
+
+		type_pair.first = getType(ftr1);
+
+		for (SpatialIndex::IndexList::const_iterator it2 = cands.begin(), end2 = cands.end(); it2 != end2; ++it2) {
+			const Feature& ftr2 = spatialIndex->getFeature(*it2);
+			type_pair.second = getType(ftr2);
+
+			if (constraintFuncMap.find(type_pair)->second.function(ftr1, ftr2))
+				iactions.insertEntry(&ftr1, &ftr2);
+		}
+	}
+}
+
+void Pharm::InteractionAnalyzer::analyze(const FeatureContainerList& cntnrs, FeatureMappingList& iactions, std::size_t num_threads) const
+{
+	if (!spatialIndex)
+		throw Base::OperationFailed("InteractionAnalyzer: no prepared feature container");
+
+	iactions.resize(cntnrs.size());
+
+	if (num_threads == 0)
+		num_threads = boost::thread::hardware_concurrency();
+
+	num_threads = std::max(std::min(num_threads, cntnrs.size()), std::size_t(1));
+
+	std::vector<std::string> errors(num_threads);
+
+	if (num_threads == 1)
+		analyzeRange(cntnrs, iactions, 0, cntnrs.size(), errors[0]);
+
+	else {
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 1; i < num_threads; i++)
+			thread_grp.create_thread(boost::bind(&InteractionAnalyzer::analyzeRange, this, boost::cref(cntnrs), boost::ref(iactions), 
+												 cntnrs.size() * i / num_threads, cntnrs.size() * (i + 1) / num_threads, 
+												 boost::ref(errors[i])));
+
+		analyzeRange(cntnrs, iactions, 0, cntnrs.size() / num_threads, errors[0]);
+
+		thread_grp.join_all();
+	}
+
+	for (std::vector<std::string>::const_iterator it = errors.begin(), end = errors.end(); it != end; ++it)
+		if (!it->empty())
+			throw Base::OperationFailed(*it);
+}
+
+void Pharm::InteractionAnalyzer::updateSpatialIndex()
+{
+	// the grids of the index depend on the registered feature type pairs and distance bounds
+
+	if (spatialIndex)
+		spatialIndex.reset(new SpatialIndex(spatialIndex->getContainer(), constraintFuncMap));
+}
+
+void Pharm::InteractionAnalyzer::analyzeRange(const FeatureContainerList& cntnrs, FeatureMappingList& iactions, std::size_t begin, std::size_t end, 
+											  std::string& error) const
+{
+	try {
+		for (std::size_t i = begin; i < end; i++)
+			analyze(*cntnrs[i], iactions[i], false);
+
+	} catch (const std::exception& e) {
+		error = e.what();
+
+		if (error.empty())
+			error = "InteractionAnalyzer: unspecified error";
+	}
+}
@@ -139,7 +139,8 @@ void Pharm::InteractionPharmacophoreGenerator::generate(const Chem::MolecularGra
 	corePharmGen.generate(core, corePharm, false);
 	envPharmGen.generate(*env, envPharm, false);
 	
-	iaAnalyzer.analyze(corePharm, envPharm, iaMapping, false);
+	iaAnalyzer.prepare(envPharm);
+	iaAnalyzer.analyze(corePharm, iaMapping, false);
 
 	buildInteractionPharmacophore(ia_pharm, iaMapping, append);
 
@@ -29,6 +29,7 @@
 #include <iterator>
 #include <limits>
 #include <algorithm>
+#include <cmath>
 
 #include "CDPL/Pharm/InteractionScoreGridCalculator.hpp"
 #include "CDPL/Pharm/FeatureContainer.hpp"  
@@ -56,7 +57,7 @@ Pharm::InteractionScoreGridCalculator::InteractionScoreGridCalculator(const Scor
 {}
 
 Pharm::InteractionScoreGridCalculator::InteractionScoreGridCalculator(const InteractionScoreGridCalculator& calc):
-	scoringFunc(calc.scoringFunc), scoreCombinationFunc(calc.scoreCombinationFunc), distCutoff(calc.distCutoff) {}
+	scoringFunc(calc.scoringFunc), scoreCombinationFunc(calc.scoreCombinationFunc), distCutoff(calc.distCutoff), normScores(calc.normScores) {}
 
 Pharm::InteractionScoreGridCalculator::~InteractionScoreGridCalculator() {}
 
@@ -108,6 +109,7 @@ Pharm::InteractionScoreGridCalculator& Pharm::InteractionScoreGridCalculator::op
 	scoringFunc = calc.scoringFunc;
 	scoreCombinationFunc = calc.scoreCombinationFunc;
 	distCutoff = calc.distCutoff;
+	normScores = calc.normScores;
 
 	return *this;
 }
@@ -118,6 +120,181 @@ void Pharm::InteractionScoreGridCalculator::calculate(const FeatureContainer& fe
 }
 
 void Pharm::InteractionScoreGridCalculator::calculate(const FeatureContainer& features, Grid::DSpatialGrid& grid, const FeaturePredicate& tgt_ftr_pred)
+{
+	bool have_ftrs = initTargetFeatures(features, tgt_ftr_pred);
+	std::size_t num_pts = grid.getNumElements();
+
+	if (!have_ftrs) {
+		for (std::size_t i = 0; i < num_pts; i++)
+			grid(i) = 0.0;
+
+		return;
+	}
+	
+	Math::Vector3D grid_pos;
+	double max_score = -std::numeric_limits<double>::max();
+	double min_score = std::numeric_limits<double>::max();
+
+    for (std::size_t i = 0; i < num_pts; i++) {
+		grid.getCoordinates(i, grid_pos);
+		grid(i) = calcScore(grid_pos);
+
+		max_score = std::max(grid(i), max_score);
+		min_score = std::min(grid(i), min_score);
+	}
+
+	if (normScores)
+		normalizeGridScores(grid, min_score, max_score);
+}
+
+void Pharm::InteractionScoreGridCalculator::calculate(const FeatureContainer& features, Grid::DSpatialGrid& grid, const FeaturePredicate& tgt_ftr_pred,
+													  Math::DVector& raw_scores)
+{
+	bool have_ftrs = initTargetFeatures(features, tgt_ftr_pred);
+	std::size_t num_pts = grid.getNumElements();
+	Math::Vector3D grid_pos;
+
+	raw_scores.resize(num_pts, false);
+
+    for (std::size_t i = 0; i < num_pts; i++) {
+		if (have_ftrs) {
+			grid.getCoordinates(i, grid_pos);
+			raw_scores(i) = calcScore(grid_pos);
+
+		} else
+			raw_scores(i) = 0.0;
+	}
+
+	copyScores(raw_scores, grid);
+}
+
+void Pharm::InteractionScoreGridCalculator::recalculate(const FeatureContainer& features, Grid::DSpatialGrid& grid, const FeaturePredicate& tgt_ftr_pred,
+														const Math::Vector3DArray& changed_pos, Math::DVector& raw_scores)
+{
+	std::size_t num_pts = grid.getNumElements();
+
+	if (raw_scores.getSize() != num_pts) {
+		calculate(features, grid, tgt_ftr_pred, raw_scores);
+		return;
+	}
+
+	std::size_t num_changed = changed_pos.getSize();
+
+	if (num_changed == 0)
+		return;
+
+	bool have_ftrs = initTargetFeatures(features, tgt_ftr_pred);
+	const Grid::DRegularGrid* reg_grid = dynamic_cast<const Grid::DRegularGrid*>(&grid);
+
+	if (reg_grid)
+		getAffectedGridPoints(*reg_grid, changed_pos);
+	else
+		getAffectedGridPoints(grid, changed_pos);
+
+	Math::Vector3D grid_pos;
+
+	for (GridPointIndexList::const_iterator it = gridPointIndices.begin(), end = gridPointIndices.end(); it != end; ++it) {
+		grid.getCoordinates(*it, grid_pos);
+
+		raw_scores(*it) = (have_ftrs ? calcScore(grid_pos) : 0.0);
+	}
+
+	copyScores(raw_scores, grid);
+}
+
+void Pharm::InteractionScoreGridCalculator::getAffectedGridPoints(const Grid::DSpatialGrid& grid, const Math::Vector3DArray& changed_pos)
+{
+	std::size_t num_changed = changed_pos.getSize();
+	double sqr_cutoff = distCutoff * distCutoff;
+	Math::Vector3D grid_pos;
+	Math::Vector3D tmp;
+
+	gridPointIndices.clear();
+
+	for (std::size_t i = 0, num_pts = grid.getNumElements(); i < num_pts; i++) {
+		grid.getCoordinates(i, grid_pos);
+
+		for (std::size_t j = 0; j < num_changed; j++) {
+			tmp.assign(grid_pos - changed_pos[j]);
+
+			if (innerProd(tmp, tmp) <= sqr_cutoff) {
+				gridPointIndices.push_back(i);
+				break;
+			}
+		}
+	}
+}
+
+void Pharm::InteractionScoreGridCalculator::getAffectedGridPoints(const Grid::DRegularGrid& grid, const Math::Vector3DArray& changed_pos)
+{
+	typedef Grid::DRegularGrid::SSizeType SSizeType;
+
+	const SSizeType grid_size[3] = { SSizeType(grid.getSize1()), SSizeType(grid.getSize2()), SSizeType(grid.getSize3()) };
+	const double step_size[3] = { grid.getXStepSize(), grid.getYStepSize(), grid.getZStepSize() };
+	double sqr_cutoff = distCutoff * distCutoff;
+	Math::Vector3D origin;
+	Math::Vector3D corner;
+	Math::Vector3D local_pos;
+	Math::Vector3D grid_pos;
+	Math::Vector3D tmp;
+	SSizeType min_idx[3];
+	SSizeType max_idx[3];
+
+	grid.getLocalCoordinates(0, 0, 0, origin);
+	gridPointIndices.clear();
+
+	for (std::size_t i = 0, num_changed = changed_pos.getSize(); i < num_changed; i++) {
+		const Math::Vector3D& pos = changed_pos[i];
+		double min_local_pos[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+		double max_local_pos[3] = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max() };
+
+		// the grid transform can be any affine mapping - the local bounding box of the cutoff sphere is thus 
+		// determined from the transformed corners of its world bounding box
+
+		for (std::size_t j = 0; j < 8; j++) {
+			corner[0] = pos[0] + ((j & 1) ? distCutoff : -distCutoff);
+			corner[1] = pos[1] + ((j & 2) ? distCutoff : -distCutoff);
+			corner[2] = pos[2] + ((j & 4) ? distCutoff : -distCutoff);
+
+			grid.getLocalCoordinates(corner, local_pos);
+
+			for (std::size_t k = 0; k < 3; k++) {
+				min_local_pos[k] = std::min(min_local_pos[k], local_pos[k]);
+				max_local_pos[k] = std::max(max_local_pos[k], local_pos[k]);
+			}
+		}
+
+		bool empty = false;
+
+		for (std::size_t k = 0; k < 3 && !empty; k++) {
+			min_idx[k] = std::max(SSizeType(0), SSizeType(std::floor((min_local_pos[k] - origin[k]) / step_size[k])));
+			max_idx[k] = std::min(grid_size[k] - 1, SSizeType(std::ceil((max_local_pos[k] - origin[k]) / step_size[k])));
+			empty = (min_idx[k] > max_idx[k]);
+		}
+
+		if (empty)
+			continue;
+
+		for (SSizeType z = min_idx[2]; z <= max_idx[2]; z++) {
+			for (SSizeType y = min_idx[1]; y <= max_idx[1]; y++) {
+				for (SSizeType x = min_idx[0]; x <= max_idx[0]; x++) {
+					grid.getCoordinates(x, y, z, grid_pos);
+					tmp.assign(grid_pos - pos);
+
+					if (innerProd(tmp, tmp) <= sqr_cutoff)
+						gridPointIndices.push_back((z * grid_size[1] + y) * grid_size[0] + x);
+				}
+			}
+		}
+	}
+
+	// points within the cutoff of several changed positions must be rescored only once
+
+	std::sort(gridPointIndices.begin(), gridPointIndices.end());
+	gridPointIndices.erase(std::unique(gridPointIndices.begin(), gridPointIndices.end()), gridPointIndices.end());
+}
+
+bool Pharm::InteractionScoreGridCalculator::initTargetFeatures(const FeatureContainer& features, const FeaturePredicate& tgt_ftr_pred)
 {
 	tgtFeatures.clear();
 
@@ -130,12 +307,8 @@ void Pharm::InteractionScoreGridCalculator::calculate(const FeatureContainer& fe
 
 	std::size_t num_features = tgtFeatures.size();
 
-	if (num_features == 0) {
-		for (std::size_t i = 0, num_pts = grid.getNumElements(); i < num_pts; i++)
-			grid(i) = 0.0;
-
-		return;
-	}
+	if (num_features == 0)
+		return false;
 	
 	featureCoords.resize(num_features);
 
@@ -147,40 +320,49 @@ void Pharm::InteractionScoreGridCalculator::calculate(const FeatureContainer& fe
 
 	octree->initialize(featureCoords, 4);
 
-	std::size_t num_pts = grid.getNumElements();
-	Math::Vector3D grid_pos;
-	double max_score = -std::numeric_limits<double>::max();
-	double min_score = std::numeric_limits<double>::max();
+	return true;
+}
 
-    for (std::size_t i = 0; i < num_pts; i++) {
-		grid.getCoordinates(i, grid_pos);
-		featureIndices.clear();
+double Pharm::InteractionScoreGridCalculator::calcScore(const Math::Vector3D& grid_pos)
+{
+	featureIndices.clear();
 
-		octree->radiusNeighbors<Octree::L2Distance>(grid_pos, distCutoff, std::back_inserter(featureIndices));
+	octree->radiusNeighbors<Octree::L2Distance>(grid_pos, distCutoff, std::back_inserter(featureIndices));
 
-		std::size_t num_inc_ftrs = featureIndices.size();
+	std::size_t num_inc_ftrs = featureIndices.size();
 
-		if (num_inc_ftrs == 0) {
-			grid(i) = 0.0;
+	if (num_inc_ftrs == 0) 
+		return 0.0;
 
-		} else {
-			partialScores.resize(num_inc_ftrs, false);
+	partialScores.resize(num_inc_ftrs, false);
 
-			for (std::size_t j = 0; j < num_inc_ftrs; j++) 
-				partialScores[j] = scoringFunc(grid_pos, *tgtFeatures[featureIndices[j]]);
+	for (std::size_t j = 0; j < num_inc_ftrs; j++) 
+		partialScores[j] = scoringFunc(grid_pos, *tgtFeatures[featureIndices[j]]);
 
-			grid(i) = scoreCombinationFunc(partialScores);
-		}
+	return scoreCombinationFunc(partialScores);
+}
+
+void Pharm::InteractionScoreGridCalculator::copyScores(const Math::DVector& raw_scores, Grid::DSpatialGrid& grid) const
+{
+	double max_score = -std::numeric_limits<double>::max();
+	double min_score = std::numeric_limits<double>::max();
+
+	for (std::size_t i = 0, num_pts = grid.getNumElements(); i < num_pts; i++) {
+		grid(i) = raw_scores(i);
 
 		max_score = std::max(grid(i), max_score);
 		min_score = std::min(grid(i), min_score);
 	}
 
-	if (!normScores)
-		return;
+	if (normScores)
+		normalizeGridScores(grid, min_score, max_score);
+}
 
+void Pharm::InteractionScoreGridCalculator::normalizeGridScores(Grid::DSpatialGrid& grid, double min_score, double max_score) const
+{
 	// normalize to range [0, 1]
 
+	std::size_t num_pts = grid.getNumElements();
 	double score_range = max_score - min_score;
 
 	if (score_range > 0.0) {
@@ -27,11 +27,15 @@
 #include "StaticInit.hpp"
 
 #include <functional>
+#include <algorithm>
 
 #include <boost/bind.hpp>
 
 #include "CDPL/Pharm/InteractionScoreGridSetCalculator.hpp"
 #include "CDPL/Pharm/FeatureFunctions.hpp"  
+#include "CDPL/Pharm/FeatureContainer.hpp"  
+#include "CDPL/Pharm/Feature.hpp"  
+#include "CDPL/Chem/Entity3DFunctions.hpp"
 
 
 using namespace CDPL;
@@ -41,6 +45,45 @@ namespace
 {
 
 	const Pharm::InteractionScoreGridCalculator::ScoringFunction NO_SCORING_FUNC;
+
+	template <typename V>
+	int compareVectors(const V& v1, const V& v2)
+	{
+		for (std::size_t i = 0; i < 3; i++) {
+			if (v1[i] < v2[i])
+				return -1;
+
+			if (v2[i] < v1[i])
+				return 1;
+		}
+
+		return 0;
+	}
+}
+
+
+Pharm::InteractionScoreGridSetCalculator::InteractionScoreGridSetCalculator(): 
+	incCalculation(false)
+{}
+
+Pharm::InteractionScoreGridSetCalculator::InteractionScoreGridSetCalculator(const InteractionScoreGridSetCalculator& calc): 
+	scoringFuncMap(calc.scoringFuncMap), enabledInteractions(calc.enabledInteractions), gridCalculator(calc.gridCalculator),
+	incCalculation(calc.incCalculation)
+{}
+
+Pharm::InteractionScoreGridSetCalculator& Pharm::InteractionScoreGridSetCalculator::operator=(const InteractionScoreGridSetCalculator& calc) 
+{
+	if (this == &calc)
+		return *this;
+
+	scoringFuncMap = calc.scoringFuncMap;
+	enabledInteractions = calc.enabledInteractions;
+	gridCalculator = calc.gridCalculator;
+	incCalculation = calc.incCalculation;
+
+	clearIncrementalState();
+
+	return *this;
 }
 
 
@@ -50,6 +93,8 @@ void Pharm::InteractionScoreGridSetCalculator::enableInteraction(unsigned int ft
 		enabledInteractions.insert(FeatureTypePair(ftr_type, tgt_ftr_type));
     else
 		enabledInteractions.erase(FeatureTypePair(ftr_type, tgt_ftr_type));
+
+	clearIncrementalState();
 }
 
 bool Pharm::InteractionScoreGridSetCalculator::isInteractionEnabled(unsigned int ftr_type, unsigned int tgt_ftr_type) const
@@ -60,11 +105,15 @@ bool Pharm::InteractionScoreGridSetCalculator::isInteractionEnabled(unsigned int
 void Pharm::InteractionScoreGridSetCalculator::clearEnabledInteractions()
 {
     enabledInteractions.clear();
+
+	clearIncrementalState();
 }
 
 void Pharm::InteractionScoreGridSetCalculator::setScoringFunction(unsigned int ftr_type, unsigned int tgt_ftr_type, const ScoringFunction& func)
 {
     scoringFuncMap[FeatureTypePair(ftr_type, tgt_ftr_type)] = func;
+
+	clearIncrementalState();
 }
 
 const Pharm::InteractionScoreGridSetCalculator::ScoringFunction& 
@@ -78,11 +127,15 @@ Pharm::InteractionScoreGridSetCalculator::getScoringFunction(unsigned int ftr_ty
 void Pharm::InteractionScoreGridSetCalculator::removeScoringFunction(unsigned int ftr_type, unsigned int tgt_ftr_type)
 {
     scoringFuncMap.erase(FeatureTypePair(ftr_type, tgt_ftr_type));
+
+	clearIncrementalState();
 }
 
 void Pharm::InteractionScoreGridSetCalculator::setScoreCombinationFunction(const ScoreCombinationFunction& func)
 {
     gridCalculator.setScoreCombinationFunction(func);
+
+	clearIncrementalState();
 }
 
 const Pharm::InteractionScoreGridSetCalculator::ScoreCombinationFunction& Pharm::InteractionScoreGridSetCalculator::getScoreCombinationFunction() const
@@ -93,6 +146,8 @@ const Pharm::InteractionScoreGridSetCalculator::ScoreCombinationFunction& Pharm:
 void Pharm::InteractionScoreGridSetCalculator::normalizeScores(bool normalize)
 {
 	gridCalculator.normalizeScores(normalize);
+
+	clearIncrementalState();
 }
 
 bool Pharm::InteractionScoreGridSetCalculator::scoresNormalized() const
@@ -100,8 +155,51 @@ bool Pharm::InteractionScoreGridSetCalculator::scoresNormalized() const
 	return gridCalculator.scoresNormalized();
 }
 
+void Pharm::InteractionScoreGridSetCalculator::enableIncrementalCalculation(bool enable)
+{
+	incCalculation = enable;
+
+	clearIncrementalState();
+}
+
+bool Pharm::InteractionScoreGridSetCalculator::isIncrementalCalculationEnabled() const
+{
+	return incCalculation;
+}
+
+void Pharm::InteractionScoreGridSetCalculator::clearIncrementalState()
+{
+	gridData.clear();
+	lastFeatureData.clear();
+}
+
 void Pharm::InteractionScoreGridSetCalculator::calculate(const FeatureContainer& features)
 {
+	if (incCalculation) {
+		getFeatureData(features, currFeatureData);
+
+		if (canUpdateGrids()) {
+			getChangedPositions();
+
+			for (GridDataMap::iterator it = gridData.begin(), end = gridData.end(); it != end; ++it) {
+				unsigned int tgt_ftr_type = it->first.second;
+				ChangedPositionsMap::const_iterator cp_it = changedPositions.find(tgt_ftr_type);
+
+				if (cp_it == changedPositions.end())
+					continue;
+
+				gridCalculator.setScoringFunction(scoringFuncMap[it->first]);
+				gridCalculator.recalculate(features, *it->second.grid, boost::bind(std::equal_to<unsigned int>(), boost::bind(&Pharm::getType, _1), tgt_ftr_type),
+										   cp_it->second, it->second.rawScores); 
+			}
+
+			lastFeatureData.swap(currFeatureData);
+			return;
+		}
+
+		gridData.clear();
+	}
+
     for (ScoringFuncMap::const_iterator it = scoringFuncMap.begin(), end = scoringFuncMap.end(); it != end; ++it) {
 		if (!it->second)
 			continue;
@@ -115,6 +213,115 @@ void Pharm::InteractionScoreGridSetCalculator::calculate(const FeatureContainer&
 		Grid::DSpatialGrid::SharedPointer grid_ptr = createGrid(ftr_type, tgt_ftr_type);
 
 		gridCalculator.setScoringFunction(it->second);
-		gridCalculator.calculate(features, *grid_ptr, boost::bind(std::equal_to<unsigned int>(), boost::bind(&Pharm::getType, _1), tgt_ftr_type)); 
+
+		if (!incCalculation) {
+			gridCalculator.calculate(features, *grid_ptr, boost::bind(std::equal_to<unsigned int>(), boost::bind(&Pharm::getType, _1), tgt_ftr_type)); 
+			continue;
+		}
+
+		GridData& data = gridData[it->first];
+
+		data.grid = grid_ptr;
+
+		gridCalculator.calculate(features, *grid_ptr, boost::bind(std::equal_to<unsigned int>(), boost::bind(&Pharm::getType, _1), tgt_ftr_type),
+								 data.rawScores); 
     }
+
+	if (incCalculation)
+		lastFeatureData.swap(currFeatureData);
+}
+
+bool Pharm::InteractionScoreGridSetCalculator::isGridValid(const Grid::DSpatialGrid& grid) const
+{
+	return true;
+}
+
+bool Pharm::InteractionScoreGridSetCalculator::canUpdateGrids() const
+{
+	if (gridData.empty())
+		return false;
+
+	for (GridDataMap::const_iterator it = gridData.begin(), end = gridData.end(); it != end; ++it) {
+		const Grid::DSpatialGrid& grid = *it->second.grid;
+
+		if (it->second.rawScores.getSize() != grid.getNumElements())
+			return false;
+
+		if (!isGridValid(grid))
+			return false;
+	}
+
+	return true;
+}
+
+void Pharm::InteractionScoreGridSetCalculator::getFeatureData(const FeatureContainer& features, FeatureDataList& ftr_data) const
+{
+	ftr_data.clear();
+
+	FeatureData data;
+
+	for (FeatureContainer::ConstFeatureIterator it = features.getFeaturesBegin(), end = features.getFeaturesEnd(); it != end; ++it) {
+		const Feature& ftr = *it;
+
+		data.type = getType(ftr);
+		data.geometry = getGeometry(ftr);
+		data.weight = getWeight(ftr);
+		data.hasOrientation = hasOrientation(ftr);
+		data.position = get3DCoordinates(ftr);
+
+		if (data.hasOrientation)
+			data.orientation = getOrientation(ftr);
+		else
+			data.orientation.clear();
+
+		ftr_data.push_back(data);
+	}
+
+	std::sort(ftr_data.begin(), ftr_data.end());
+}
+
+void Pharm::InteractionScoreGridSetCalculator::getChangedPositions()
+{
+	changedPositions.clear();
+
+	FeatureDataList::const_iterator last_it = lastFeatureData.begin(), last_end = lastFeatureData.end();
+	FeatureDataList::const_iterator curr_it = currFeatureData.begin(), curr_end = currFeatureData.end();
+
+	while (last_it != last_end || curr_it != curr_end) {
+		if (curr_it == curr_end || (last_it != last_end && *last_it < *curr_it)) {
+			changedPositions[last_it->type].addElement(last_it->position);
+			++last_it;
+
+		} else if (last_it == last_end || *curr_it < *last_it) {
+			changedPositions[curr_it->type].addElement(curr_it->position);
+			++curr_it;
+
+		} else {
+			++last_it;
+			++curr_it;
+		}
+	}
+}
+
+
+bool Pharm::InteractionScoreGridSetCalculator::FeatureData::operator<(const FeatureData& data) const
+{
+	if (type != data.type)
+		return (type < data.type);
+
+	if (geometry != data.geometry)
+		return (geometry < data.geometry);
+
+	if (weight != data.weight)
+		return (weight < data.weight);
+
+	if (hasOrientation != data.hasOrientation)
+		return (hasOrientation < data.hasOrientation);
+
+	int res = compareVectors(position, data.position);
+
+	if (res != 0)
+		return (res < 0);
+
+	return (compareVectors(orientation, data.orientation) < 0);
 }
@@ -121,3 +121,8 @@ const Pharm::FeatureTypeHistogram& Pharm::PSDScreeningDBAccessor::getFeatureCoun
 {
 	return impl->getFeatureCounts(mol_idx, mol_conf_idx);
 }
+
+bool Pharm::PSDScreeningDBAccessor::getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii) const
+{
+	return impl->getAtomCoordinates(pharm_idx, coords, vdw_radii);
+}
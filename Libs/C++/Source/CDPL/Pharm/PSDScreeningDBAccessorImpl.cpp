@@ -51,6 +51,15 @@ namespace
 		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " = ?1 AND " +
 		Pharm::SQLScreeningDB::MOL_CONF_IDX_COLUMN_NAME + " = ?2;";
 
+	const std::string ATOM_COORDS_DATA_QUERY_SQL = "SELECT " +
+		Pharm::SQLScreeningDB::ATOM_COORDS_DATA_COLUMN_NAME + " FROM " +
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + " WHERE " +
+		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " = ?1 AND " +
+		Pharm::SQLScreeningDB::MOL_CONF_IDX_COLUMN_NAME + " = ?2;";
+
+	const std::string ATOM_COORDS_TABLE_CHECK_SQL = "SELECT name FROM sqlite_master WHERE type = 'table' AND name = '" +
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + "';";
+
 	const std::string MOL_ID_FROM_MOL_TABLE_QUERY_SQL = "SELECT " +
 		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " FROM " +
 		Pharm::SQLScreeningDB::MOL_TABLE_NAME + ";";
@@ -70,7 +79,7 @@ namespace
 
 
 Pharm::PSDScreeningDBAccessorImpl::PSDScreeningDBAccessorImpl():
-	pharmReader(controlParams), molReader(controlParams)
+	atomCoordsTableStatus(-1), pharmReader(controlParams), molReader(controlParams)
 {
 	initControlParams();
 }
@@ -252,6 +261,70 @@ const Pharm::FeatureTypeHistogram& Pharm::PSDScreeningDBAccessorImpl::getFeature
 	return featureCounts[pharm_idx];
 }
 
+bool Pharm::PSDScreeningDBAccessorImpl::getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii)
+{
+	if (!getDBConnection())
+		throw Base::IOError("PSDScreeningDBAccessorImpl: no open database connection");
+
+	initPharmIdxMolIDConfIdxMappings();
+
+	if (pharm_idx >= pharmIdxToMolIDConfIdxMap.size())
+		throw Base::IndexError("PSDScreeningDBAccessorImpl: pharmacophore index out of bounds");
+
+	if (!hasAtomCoordsTable())
+		return false;
+
+	setupStatement(selAtomCoordsDataStmt, ATOM_COORDS_DATA_QUERY_SQL, true);
+
+	if (sqlite3_bind_int64(selAtomCoordsDataStmt.get(), 1, pharmIdxToMolIDConfIdxMap[pharm_idx].first) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while binding atom coordinates molecule id to prepared statement");
+
+	if (sqlite3_bind_int(selAtomCoordsDataStmt.get(), 2, pharmIdxToMolIDConfIdxMap[pharm_idx].second) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while binding atom coordinates molecule conformation index to prepared statement");
+
+	int res = sqlite3_step(selAtomCoordsDataStmt.get());
+
+	if (res != SQLITE_ROW && res != SQLITE_DONE)
+		throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while loading requested atom coordinates");
+
+	if (res != SQLITE_ROW)
+		return false;
+
+	const void* blob = sqlite3_column_blob(selAtomCoordsDataStmt.get(), 0);
+	std::size_t num_bytes = sqlite3_column_bytes(selAtomCoordsDataStmt.get(), 0);
+	
+	byteBuffer.resize(0);
+	byteBuffer.setIOPointer(0);
+	byteBuffer.putBytes(reinterpret_cast<const char*>(blob), num_bytes);
+	byteBuffer.setIOPointer(0);
+
+	Base::uint32 num_atoms = 0;
+
+	byteBuffer.getInt(num_atoms);
+
+	if (byteBuffer.getSize() != sizeof(Base::uint32) + num_atoms * 4 * sizeof(float))
+		throw Base::IOError("PSDScreeningDBAccessorImpl: invalid atom coordinates data size");
+
+	coords.resize(num_atoms);
+	vdw_radii.resize(num_atoms);
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		float value;
+		Math::Vector3D& pos = coords[i];
+
+		byteBuffer.getFloat(value);
+		pos[0] = value;
+		byteBuffer.getFloat(value);
+		pos[1] = value;
+		byteBuffer.getFloat(value);
+		pos[2] = value;
+		byteBuffer.getFloat(value);
+		vdw_radii[i] = value;
+	}
+
+	return true;
+}
+
 void Pharm::PSDScreeningDBAccessorImpl::loadPharmacophore(Base::int64 mol_id, int mol_conf_idx, Pharmacophore& pharm)
 {
 	setupStatement(selPharmDataStmt, PHARM_DATA_QUERY_SQL, true);
@@ -292,9 +365,12 @@ void Pharm::PSDScreeningDBAccessorImpl::closeDBConnection()
 	selMolIDStmt.reset();
 	selMolIDConfIdxStmt.reset();
 	selFtrCountsStmt.reset();
+	selAtomCoordsDataStmt.reset();
 
 	SQLiteDataIOBase::closeDBConnection();
 
+	atomCoordsTableStatus = -1;
+
 	featureCounts.clear();
 	molIdxToIDMap.clear();
 	molIDToIdxMap.clear();
@@ -381,3 +457,24 @@ void Pharm::PSDScreeningDBAccessorImpl::loadFeatureCounts()
 	if (res != SQLITE_DONE)
 		throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while loading feature counts");
 }
+
+bool Pharm::PSDScreeningDBAccessorImpl::hasAtomCoordsTable()
+{
+	if (atomCoordsTableStatus >= 0)
+		return (atomCoordsTableStatus > 0);
+
+	// the atom coordinates table is missing in databases created by previous versions
+
+	SQLite3StmtPointer stmt_ptr;
+
+	setupStatement(stmt_ptr, ATOM_COORDS_TABLE_CHECK_SQL, false);
+
+	int res = sqlite3_step(stmt_ptr.get());
+
+	if (res != SQLITE_ROW && res != SQLITE_DONE)
+		throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while checking for atom coordinates table");
+
+	atomCoordsTableStatus = (res == SQLITE_ROW ? 1 : 0);
+
+	return (atomCoordsTableStatus > 0);
+}
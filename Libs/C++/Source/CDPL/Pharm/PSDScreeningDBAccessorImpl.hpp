@@ -36,6 +36,8 @@
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Pharm/CDFPharmacophoreDataReader.hpp"
 #include "CDPL/Chem/CDFDataReader.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+#include "CDPL/Util/Array.hpp"
 #include "CDPL/Base/ControlParameterList.hpp"
 #include "CDPL/Base/IntegerTypes.hpp"
 #include "CDPL/Internal/ByteBuffer.hpp"
@@ -85,6 +87,8 @@ namespace CDPL
 
 			const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx); 
 
+			bool getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii);
+
 		private:
 			void initControlParams();
 
@@ -95,6 +99,8 @@ namespace CDPL
 			void initMolIdxIDMappings();
 			void initPharmIdxMolIDConfIdxMappings();
 			void loadFeatureCounts();
+
+			bool hasAtomCoordsTable();
 	
 			typedef std::vector<FeatureTypeHistogram> FeatureCountsArray;
 			typedef std::pair<Base::int64, std::size_t> MolIDConfIdxPair;
@@ -108,6 +114,8 @@ namespace CDPL
 			SQLite3StmtPointer               selMolIDStmt;
 			SQLite3StmtPointer               selMolIDConfIdxStmt;
 			SQLite3StmtPointer               selFtrCountsStmt;
+			SQLite3StmtPointer               selAtomCoordsDataStmt;
+			int                              atomCoordsTableStatus;
 			FeatureCountsArray               featureCounts;
 			MolIDArray                       molIdxToIDMap;
 			MolIDToUIntMap                   molIDToIdxMap;
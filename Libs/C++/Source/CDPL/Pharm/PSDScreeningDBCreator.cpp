@@ -100,3 +100,18 @@ std::size_t Pharm::PSDScreeningDBCreator::getNumInserted() const
 {
 	return impl->getNumInserted();
 }
+
+void Pharm::PSDScreeningDBCreator::setUseWriterThread(bool use)
+{
+	impl->setUseWriterThread(use);
+}
+
+bool Pharm::PSDScreeningDBCreator::getUseWriterThread() const
+{
+	return impl->getUseWriterThread();
+}
+
+void Pharm::PSDScreeningDBCreator::flush()
+{
+	impl->flush();
+}
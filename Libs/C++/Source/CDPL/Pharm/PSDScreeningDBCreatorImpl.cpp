@@ -26,7 +26,10 @@
 
 #include "StaticInit.hpp"
 
+#include <algorithm>
+
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/bind.hpp>
 
 #include "CDPL/Pharm/ControlParameterFunctions.hpp"
 #include "CDPL/Pharm/FeatureContainerFunctions.hpp"
@@ -37,6 +40,9 @@
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
 #include "CDPL/Chem/AtomContainerFunctions.hpp"
 #include "CDPL/Chem/AtomArray3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/AtomConformerEnsemble3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/AtomDictionary.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "PSDScreeningDBCreatorImpl.hpp"
@@ -79,15 +85,28 @@ namespace
 	const std::string DROP_FTR_COUNT_TABLE_SQL = "DROP TABLE IF EXISTS " + 
 		Pharm::SQLScreeningDB::FTR_COUNT_TABLE_NAME + ";";
 
+	const std::string CREATE_ATOM_COORDS_TABLE_SQL = "CREATE TABLE IF NOT EXISTS " + 
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + "(" + 
+		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " INTEGER, " + 
+		Pharm::SQLScreeningDB::MOL_CONF_IDX_COLUMN_NAME + " INTEGER, " + 
+		Pharm::SQLScreeningDB::ATOM_COORDS_DATA_COLUMN_NAME + " BLOB, PRIMARY KEY(" +
+		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + ", " +
+		Pharm::SQLScreeningDB::MOL_CONF_IDX_COLUMN_NAME + "));";
+
+	const std::string DROP_ATOM_COORDS_TABLE_SQL = "DROP TABLE IF EXISTS " + 
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + ";";
+
 	const std::string CREATE_TABLES_SQL = 
 		CREATE_MOL_TABLE_SQL +
 		CREATE_PHARM_TABLE_SQL +
-		CREATE_FTR_COUNT_TABLE_SQL;
+		CREATE_FTR_COUNT_TABLE_SQL +
+		CREATE_ATOM_COORDS_TABLE_SQL;
 	
 	const std::string DROP_TABLES_SQL = 
 		DROP_MOL_TABLE_SQL +
 		DROP_PHARM_TABLE_SQL +
-		DROP_FTR_COUNT_TABLE_SQL;
+		DROP_FTR_COUNT_TABLE_SQL +
+		DROP_ATOM_COORDS_TABLE_SQL;
 
 	const std::string MOL_ID_AND_HASH_QUERY_SQL = "SELECT " +
 		Pharm::SQLScreeningDB::MOL_HASH_COLUMN_NAME + ", " +
@@ -106,6 +125,10 @@ namespace
 		Pharm::SQLScreeningDB::FTR_COUNT_TABLE_NAME + " WHERE " +
 		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " = ?1;";
 
+	const std::string DELETE_ATOM_COORDS_WITH_MOL_ID_SQL = "DELETE FROM " +
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + " WHERE " +
+		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + " = ?1;";
+
 	const std::string INSERT_MOL_DATA_SQL = "INSERT INTO " +
 		Pharm::SQLScreeningDB::MOL_TABLE_NAME + "(" +
 		Pharm::SQLScreeningDB::MOL_HASH_COLUMN_NAME + ", " +
@@ -124,6 +147,12 @@ namespace
 		Pharm::SQLScreeningDB::FTR_TYPE_COLUMN_NAME + ", " +
 		Pharm::SQLScreeningDB::FTR_COUNT_COLUMN_NAME + ") VALUES (?1, ?2, ?3, ?4);";
 
+	const std::string INSERT_ATOM_COORDS_DATA_SQL = "INSERT INTO " +
+		Pharm::SQLScreeningDB::ATOM_COORDS_TABLE_NAME + "(" +
+		Pharm::SQLScreeningDB::MOL_ID_COLUMN_NAME + ", " +
+		Pharm::SQLScreeningDB::MOL_CONF_IDX_COLUMN_NAME + ", " +
+		Pharm::SQLScreeningDB::ATOM_COORDS_DATA_COLUMN_NAME + ") VALUES (?1, ?2, ?3);";
+
 	const std::string BEGIN_TRANSACTION_SQL    = "BEGIN TRANSACTION;";
 	const std::string COMMIT_TRANSACTION_SQL   = "COMMIT TRANSACTION;";
 	const std::string ROLLBACK_TRANSACTION_SQL = "ROLLBACK TRANSACTION;";
@@ -140,6 +169,9 @@ namespace
 		"PRAGMA journal_mode = DELETE;" 
 */
 
+	const std::size_t MAX_RECORD_QUEUE_SIZE  = 512;
+	const std::size_t MAX_TRANSACTION_SIZE   = 256;
+
 	class TransactionRollback
 	{
 		
@@ -163,14 +195,21 @@ namespace
 
 
 Pharm::PSDScreeningDBCreatorImpl::PSDScreeningDBCreatorImpl():
-	pharmWriter(controlParams),	molWriter(controlParams), pharmGenerator(true), mode(ScreeningDBCreator::CREATE),
+	numPendingRecords(0), stopWriter(false), useWriterThread(false), mode(ScreeningDBCreator::CREATE),
 	allowDupEntries(true), numProcessed(0), numRejected(0), numDeleted(0), numInserted(0)
+{}
+
+Pharm::PSDScreeningDBCreatorImpl::~PSDScreeningDBCreatorImpl()
 {
-	initControlParams();
+	stopWriterThread();
 }
 
 void Pharm::PSDScreeningDBCreatorImpl::open(const std::string& name, ScreeningDBCreator::Mode mode, bool allow_dup_entries)
 {
+	stopWriterThread();
+
+	writerError.clear();
+
 	openDBConnection(name, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
 
 	this->mode = mode;
@@ -182,7 +221,16 @@ void Pharm::PSDScreeningDBCreatorImpl::open(const std::string& name, ScreeningDB
 
 void Pharm::PSDScreeningDBCreatorImpl::close()
 {
+	stopWriterThread();
+
+	std::string error;
+
+	error.swap(writerError);
+
 	closeDBConnection();
+
+	if (!error.empty())
+		throw Base::IOError(error);
 }
 
 const std::string& Pharm::PSDScreeningDBCreatorImpl::getDatabaseName() const
@@ -199,9 +247,11 @@ void Pharm::PSDScreeningDBCreatorImpl::closeDBConnection()
 	insMoleculeStmt.reset();
 	insPharmStmt.reset();
 	insFtrCountStmt.reset();
+	insAtomCoordsStmt.reset();
 	delMolWithMolIDStmt.reset();
 	delPharmsWithMolIDStmt.reset();
 	delFeatureCountsWithMolIDStmt.reset();
+	delAtomCoordsWithMolIDStmt.reset();
 	delTwoPointPharmsWithMolIDStmt.reset();
 	delThreePointPharmsWithMolIDStmt.reset();
 
@@ -225,148 +275,150 @@ bool Pharm::PSDScreeningDBCreatorImpl::allowDuplicateEntries() const
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumProcessed() const
 {
+	boost::lock_guard<boost::mutex> lock(mutex);
+
 	return numProcessed;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumRejected() const
 {
+	boost::lock_guard<boost::mutex> lock(mutex);
+
 	return numRejected;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumDeleted() const
 {
+	boost::lock_guard<boost::mutex> lock(mutex);
+
 	return numDeleted;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumInserted() const
 {
+	boost::lock_guard<boost::mutex> lock(mutex);
+
 	return numInserted;
 }
 
+void Pharm::PSDScreeningDBCreatorImpl::setUseWriterThread(bool use)
+{
+	if (!use)
+		stopWriterThread();
+
+	useWriterThread = use;
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::getUseWriterThread() const
+{
+	return useWriterThread;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::flush()
+{
+	boost::unique_lock<boost::mutex> lock(mutex);
+
+	while (numPendingRecords > 0 && writerError.empty())
+		queueFlushedCondition.wait(lock);
+
+	if (!writerError.empty())
+		throw Base::IOError(writerError);
+}
+
 bool Pharm::PSDScreeningDBCreatorImpl::process(const Chem::MolecularGraph& molgraph)
 {
 	if (!getDBConnection())
 		throw Base::IOError("PSDScreeningDBCreatorImpl: no open database connection");
 
-	numProcessed++;
-	Base::uint64 mol_hash = hashCalculator.calculate(molgraph);
+	checkWriterError();
 
-	if (!allowDupEntries) {
-		if (procMolecules.find(mol_hash) != procMolecules.end()) {
-			numRejected++;
-			return false;
-		}
+	RecordGeneratorPtr rec_gen = acquireRecordGenerator();
+	Base::uint64 mol_hash = 0;
+	bool registered = false;
 
-		if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end()) {
-			numRejected++;
+	try {
+		mol_hash = rec_gen->calcHashCode(molgraph);
+		
+		if (!registerMolecule(mol_hash)) {
+			releaseRecordGenerator(rec_gen);
 			return false;
 		}
-	}
 
-	beginTransaction();
+		registered = true;
 
-	TransactionRollback trb(getDBConnection().get());
-	std::size_t num_del = 0;
+		MoleculeRecordPtr rec(new MoleculeRecord());
 
-	if (mode == ScreeningDBCreator::UPDATE)
-		num_del = deleteEntries(mol_hash);
+		rec->molHash = mol_hash;
+		rec_gen->generate(molgraph, *rec);
 
-	genAndInsertPharmData(molgraph, insertMolecule(molgraph, mol_hash));
+		releaseRecordGenerator(rec_gen);
+		rec_gen.reset();
 
-	commitTransaction();
-	trb.disable();
+		submitRecord(rec);
 
-	numDeleted += num_del;
-	numInserted++;
+	} catch (...) {
+		if (rec_gen)
+			releaseRecordGenerator(rec_gen);
 
-	if (mode == ScreeningDBCreator::UPDATE)
-		molHashToIDMap.erase(mol_hash);
+		if (registered)
+			unregisterMolecule(mol_hash);
 
-	if (!allowDupEntries)
-		procMolecules.insert(mol_hash);
+		throw;
+	}
 
 	return true;
 }
 
-bool  Pharm::PSDScreeningDBCreatorImpl::merge(const ScreeningDBAccessor& db_acc, const ScreeningDBCreator::ProgressCallbackFunction& func)
+bool Pharm::PSDScreeningDBCreatorImpl::merge(const ScreeningDBAccessor& db_acc, const ScreeningDBCreator::ProgressCallbackFunction& func)
 {
 	if (!getDBConnection())
 		throw Base::IOError("PSDScreeningDBCreatorImpl: no open database connection");
 
+	flush();
+
+	RecordGeneratorPtr rec_gen = acquireRecordGenerator();
 	Chem::BasicMolecule mol;
 	std::size_t num_mols = db_acc.getNumMolecules();
-	std::size_t old_num_ins = numInserted;
-
-	for (std::size_t i = 0; i < num_mols; i++) {
-		if (func && !func(double(i) / num_mols))
-			return (numInserted > old_num_ins);
+	std::size_t old_num_ins = getNumInserted();
+	bool completed = true;
+
+	try {
+		for (std::size_t i = 0; i < num_mols; i++) {
+			if (func && !func(double(i) / num_mols)) {
+				completed = false;
+				break;
+			}
 
-		db_acc.getMolecule(i, mol);
+			db_acc.getMolecule(i, mol);
 
-		calcCIPPriorities(mol, false);
-		numProcessed++;
+			calcCIPPriorities(mol, false);
 
-		Base::uint64 mol_hash = hashCalculator.calculate(mol);
+			Base::uint64 mol_hash = rec_gen->calcHashCode(mol);
 	
-		if (!allowDupEntries) {
-			if (procMolecules.find(mol_hash) != procMolecules.end()) {
-				numRejected++;
+			if (!registerMolecule(mol_hash))
 				continue;
-			}
-
-			if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end()) {
-				numRejected++;
-				continue;
-			}
-		}
-
-		beginTransaction();
 
-		TransactionRollback trb(getDBConnection().get());
-		std::size_t num_del = 0;
+			MoleculeRecordPtr rec(new MoleculeRecord());
 
-		if (mode == ScreeningDBCreator::UPDATE)
-			num_del = deleteEntries(mol_hash);
+			rec->molHash = mol_hash;
+			rec_gen->generate(mol, db_acc, i, *rec);
 
-		Base::int64 mol_id = insertMolecule(mol, mol_hash);
-		std::size_t num_pharms = db_acc.getNumPharmacophores(i);
-
-		for (std::size_t j = 0; j < num_pharms; j++) {
-			pharmacophore.clear();
-			db_acc.getPharmacophore(i, j, pharmacophore);
-
-			featureCounts = db_acc.getFeatureCounts(i, j);
-
-			insertPharmacophore(mol_id, j);
-			insertFtrCounts(mol_id, j);
+			submitRecord(rec);
 		}
 
-		commitTransaction();
-		trb.disable();
-
-		numDeleted += num_del;
-		numInserted++;
-
-		if (mode == ScreeningDBCreator::UPDATE)
-			molHashToIDMap.erase(mol_hash);
+		flush();
 
-		if (!allowDupEntries)
-			procMolecules.insert(mol_hash);
+	} catch (...) {
+		releaseRecordGenerator(rec_gen);
+		throw;
 	}
 
-	if (func)
-		func(1.0);
-
-	return (numInserted > old_num_ins);
-}
+	releaseRecordGenerator(rec_gen);
 
-void Pharm::PSDScreeningDBCreatorImpl::initControlParams()
-{
-	Pharm::setStrictErrorCheckingParameter(controlParams, true);
-	Chem::setStrictErrorCheckingParameter(controlParams, true);
+	if (completed && func)
+		func(1.0);
 
-	Pharm::setCDFWriteSinglePrecisionFloatsParameter(controlParams, true);
-	Chem::setCDFWriteSinglePrecisionFloatsParameter(controlParams, true);
+	return (getNumInserted() > old_num_ins);
 }
 
 void Pharm::PSDScreeningDBCreatorImpl::setupTables()
@@ -413,79 +465,240 @@ void Pharm::PSDScreeningDBCreatorImpl::loadMolHashToIDMap()
 		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while loading existing molecule IDs and hashes");
 }
 
-std::size_t Pharm::PSDScreeningDBCreatorImpl::deleteEntries(Base::uint64 mol_hash)
+Pharm::PSDScreeningDBCreatorImpl::RecordGeneratorPtr Pharm::PSDScreeningDBCreatorImpl::acquireRecordGenerator()
 {
-	std::size_t num_del = 0;
-	std::pair<MolHashToIDMap::iterator, MolHashToIDMap::iterator> mols_with_hash = molHashToIDMap.equal_range(mol_hash);
+	boost::lock_guard<boost::mutex> lock(mutex);
 
-	for (MolHashToIDMap::iterator it = mols_with_hash.first; it != mols_with_hash.second; ++it, num_del++) {
-		Base::uint64 mol_id = it->second;
-		
-		deleteRowsWithMolID(delMolWithMolIDStmt, DELETE_MOL_WITH_MOL_ID_SQL, mol_id);
-		deleteRowsWithMolID(delPharmsWithMolIDStmt, DELETE_PHARMS_WITH_MOL_ID_SQL, mol_id);
-		deleteRowsWithMolID(delFeatureCountsWithMolIDStmt, DELETE_FTR_COUNTS_WITH_MOL_ID_SQL, mol_id);
+	if (recordGenerators.empty())
+		return RecordGeneratorPtr(new RecordGenerator());
+
+	RecordGeneratorPtr gen = recordGenerators.back();
+
+	recordGenerators.pop_back();
+
+	return gen;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::releaseRecordGenerator(const RecordGeneratorPtr& gen)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	recordGenerators.push_back(gen);
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::registerMolecule(Base::uint64 mol_hash)
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	numProcessed++;
+
+	if (allowDupEntries)
+		return true;
+
+	if (procMolecules.find(mol_hash) != procMolecules.end()) {
+		numRejected++;
+		return false;
 	}
 
-	return num_del;
+	if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end()) {
+		numRejected++;
+		return false;
+	}
+
+	procMolecules.insert(mol_hash);
+	return true;
 }
 
-Base::int64 Pharm::PSDScreeningDBCreatorImpl::insertMolecule(const Chem::MolecularGraph& molgraph, Base::uint64 mol_hash)
+void Pharm::PSDScreeningDBCreatorImpl::unregisterMolecule(Base::uint64 mol_hash)
 {
-	molWriter.writeMolGraph(molgraph, byteBuffer);
+	if (allowDupEntries)
+		return;
 
-	setupStatement(insMoleculeStmt, INSERT_MOL_DATA_SQL, true);
+	boost::lock_guard<boost::mutex> lock(mutex);
 
-	if (sqlite3_bind_int64(insMoleculeStmt.get(), 1, mol_hash) != SQLITE_OK)
-		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule hashcode to prepared statement");
+	procMolecules.erase(mol_hash);
+}
 
-	if (sqlite3_bind_blob(insMoleculeStmt.get(), 2, byteBuffer.getData(), boost::numeric_cast<int>(byteBuffer.getSize()),
-						  SQLITE_TRANSIENT) != SQLITE_OK)
-		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule data BLOB to prepared statement");
+void Pharm::PSDScreeningDBCreatorImpl::submitRecord(const MoleculeRecordPtr& rec)
+{
+	if (!useWriterThread) {
+		insertRecords(MoleculeRecordList(1, rec));
+		return;
+	}
 
-	evalStatement(insMoleculeStmt);
+	boost::unique_lock<boost::mutex> lock(mutex);
 
-	return sqlite3_last_insert_rowid(getDBConnection().get());
+	while (recordQueue.size() >= MAX_RECORD_QUEUE_SIZE && writerError.empty())
+		queueNotFullCondition.wait(lock);
+
+	if (!writerError.empty())
+		throw Base::IOError(writerError);
+
+	if (!writerThread.joinable())
+		startWriterThread();
+
+	recordQueue.push_back(rec);
+	numPendingRecords++;
+
+	queueNotEmptyCondition.notify_one();
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genAndInsertPharmData(const Chem::MolecularGraph& molgraph, Base::int64 mol_id)
+void Pharm::PSDScreeningDBCreatorImpl::startWriterThread()
 {
-	std::size_t num_confs = getNumConformations(molgraph);
+	stopWriter = false;
+	writerThread = boost::thread(boost::bind(&PSDScreeningDBCreatorImpl::processRecordQueue, this));
+}
 
-	if (num_confs == 0) {
-		if (hasCoordinates(molgraph, 3)) {
-			coordinates.clear();
-			get3DCoordinates(molgraph, coordinates);
+void Pharm::PSDScreeningDBCreatorImpl::stopWriterThread()
+{
+	if (!writerThread.joinable())
+		return;
 
-			pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(coordinates, molgraph));
-			genAndInsertPharmData(molgraph, mol_id, 0);
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+
+		stopWriter = true;
+	}
+
+	queueNotEmptyCondition.notify_all();
+	writerThread.join();
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::processRecordQueue()
+{
+	MoleculeRecordList batch;
+
+	while (true) {
+		{
+			boost::unique_lock<boost::mutex> lock(mutex);
+
+			while (recordQueue.empty() && !stopWriter)
+				queueNotEmptyCondition.wait(lock);
+
+			if (recordQueue.empty())
+				return;
+
+			// everything that has been queued in the meantime goes into a single transaction
+
+			std::size_t num_recs = std::min(recordQueue.size(), MAX_TRANSACTION_SIZE);
+
+			batch.assign(recordQueue.begin(), recordQueue.begin() + num_recs);
+			recordQueue.erase(recordQueue.begin(), recordQueue.begin() + num_recs);
 		}
 
-		return;
+		queueNotFullCondition.notify_all();
+
+		try {
+			insertRecords(batch);
+
+		} catch (const std::exception& e) {
+			boost::lock_guard<boost::mutex> lock(mutex);
+
+			writerError = std::string("PSDScreeningDBCreatorImpl: writing database records failed: ") + e.what();
+			recordQueue.clear();
+			numPendingRecords = 0;
+
+			queueNotFullCondition.notify_all();
+			queueFlushedCondition.notify_all();
+			return;
+		}
+
+		batch.clear();
 	}
+}
 
-	for (std::size_t i = 0; i < num_confs; i++) {
-		coordinates.clear();
-		getConformation(molgraph, i, coordinates);
+void Pharm::PSDScreeningDBCreatorImpl::checkWriterError() const
+{
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	if (!writerError.empty())
+		throw Base::IOError(writerError);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::insertRecords(const MoleculeRecordList& recs)
+{
+	beginTransaction();
 
-		pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(coordinates, molgraph));
-		genAndInsertPharmData(molgraph, mol_id, i);
+	TransactionRollback trb(getDBConnection().get());
+	std::size_t num_del = 0;
+
+	for (MoleculeRecordList::const_iterator it = recs.begin(), end = recs.end(); it != end; ++it)
+		insertRecord(**it, num_del);
+
+	commitTransaction();
+	trb.disable();
+
+	boost::lock_guard<boost::mutex> lock(mutex);
+
+	numDeleted += num_del;
+	numInserted += recs.size();
+
+	if (useWriterThread) {
+		numPendingRecords -= recs.size();
+
+		if (numPendingRecords == 0)
+			queueFlushedCondition.notify_all();
 	}
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genAndInsertPharmData(const Chem::MolecularGraph& molgraph, Base::int64 mol_id, std::size_t conf_idx)
+void Pharm::PSDScreeningDBCreatorImpl::insertRecord(const MoleculeRecord& rec, std::size_t& num_del)
 {
-	pharmacophore.clear();
-	pharmGenerator.generate(molgraph, pharmacophore);
+	if (mode == ScreeningDBCreator::UPDATE) {
+		num_del += deleteEntries(rec.molHash);
+		molHashToIDMap.erase(rec.molHash);
+	}
+
+	Base::int64 mol_id = insertMolecule(rec);
+	std::size_t conf_idx = 0;
+
+	for (ConformerRecordList::const_iterator it = rec.confRecords.begin(), end = rec.confRecords.end(); it != end; ++it, conf_idx++) {
+		const ConformerRecord& conf_rec = *it;
 
-	insertPharmacophore(mol_id, conf_idx);
-	genFtrCounts();
-	insertFtrCounts(mol_id, conf_idx);
+		insertPharmacophore(mol_id, conf_idx, conf_rec);
+
+		for (FeatureCountList::const_iterator fc_it = conf_rec.ftrCounts.begin(), fc_end = conf_rec.ftrCounts.end(); fc_it != fc_end; ++fc_it)
+			insertFtrCount(mol_id, conf_idx, fc_it->first, fc_it->second);
+
+		if (!conf_rec.atomCoordsData.empty())
+			insertAtomCoords(mol_id, conf_idx, conf_rec);
+	}
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(Base::int64 mol_id, std::size_t conf_idx)
+std::size_t Pharm::PSDScreeningDBCreatorImpl::deleteEntries(Base::uint64 mol_hash)
 {
-	pharmWriter.writeFeatureContainer(pharmacophore, byteBuffer);
+	std::size_t num_del = 0;
+	std::pair<MolHashToIDMap::iterator, MolHashToIDMap::iterator> mols_with_hash = molHashToIDMap.equal_range(mol_hash);
+
+	for (MolHashToIDMap::iterator it = mols_with_hash.first; it != mols_with_hash.second; ++it, num_del++) {
+		Base::uint64 mol_id = it->second;
+		
+		deleteRowsWithMolID(delMolWithMolIDStmt, DELETE_MOL_WITH_MOL_ID_SQL, mol_id);
+		deleteRowsWithMolID(delPharmsWithMolIDStmt, DELETE_PHARMS_WITH_MOL_ID_SQL, mol_id);
+		deleteRowsWithMolID(delFeatureCountsWithMolIDStmt, DELETE_FTR_COUNTS_WITH_MOL_ID_SQL, mol_id);
+		deleteRowsWithMolID(delAtomCoordsWithMolIDStmt, DELETE_ATOM_COORDS_WITH_MOL_ID_SQL, mol_id);
+	}
+
+	return num_del;
+}
+
+Base::int64 Pharm::PSDScreeningDBCreatorImpl::insertMolecule(const MoleculeRecord& rec)
+{
+	setupStatement(insMoleculeStmt, INSERT_MOL_DATA_SQL, true);
+
+	if (sqlite3_bind_int64(insMoleculeStmt.get(), 1, rec.molHash) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule hashcode to prepared statement");
+
+	if (sqlite3_bind_blob(insMoleculeStmt.get(), 2, &rec.molData[0], boost::numeric_cast<int>(rec.molData.size()),
+						  SQLITE_STATIC) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule data BLOB to prepared statement");
+
+	evalStatement(insMoleculeStmt);
 
+	return sqlite3_last_insert_rowid(getDBConnection().get());
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(Base::int64 mol_id, std::size_t conf_idx, const ConformerRecord& conf_rec)
+{
 	setupStatement(insPharmStmt, INSERT_PHARM_DATA_SQL, true);
 
 	if (sqlite3_bind_int64(insPharmStmt.get(), 1, mol_id) != SQLITE_OK)
@@ -494,25 +707,13 @@ void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(Base::int64 mol_id, s
 	if (sqlite3_bind_int(insPharmStmt.get(), 2, boost::numeric_cast<int>(conf_idx)) != SQLITE_OK)
 		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding pharmacophore conf. index to prepared statement");
 
-	if (sqlite3_bind_blob(insPharmStmt.get(), 3, byteBuffer.getData(), boost::numeric_cast<int>(byteBuffer.getSize()),
-						  SQLITE_TRANSIENT) != SQLITE_OK)
+	if (sqlite3_bind_blob(insPharmStmt.get(), 3, &conf_rec.pharmData[0], boost::numeric_cast<int>(conf_rec.pharmData.size()),
+						  SQLITE_STATIC) != SQLITE_OK)
 		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding pharmacophore data BLOB to prepared statement");
 
 	evalStatement(insPharmStmt);
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genFtrCounts()
-{
-	featureCounts.clear();
-	buildFeatureTypeHistogram(pharmacophore, featureCounts);
-}
-
-void Pharm::PSDScreeningDBCreatorImpl::insertFtrCounts(Base::int64 mol_id, std::size_t conf_idx)
-{
-	for (FeatureTypeHistogram::ConstEntryIterator it = featureCounts.getEntriesBegin(), end = featureCounts.getEntriesEnd(); it != end; ++it)
-		insertFtrCount(mol_id, conf_idx, it->first, it->second);
-}
-
 void Pharm::PSDScreeningDBCreatorImpl::insertFtrCount(Base::int64 mol_id, std::size_t conf_idx, unsigned int ftr_type, std::size_t ftr_count)
 {
 	setupStatement(insFtrCountStmt, INSERT_FTR_COUNT_SQL, true);
@@ -532,6 +733,23 @@ void Pharm::PSDScreeningDBCreatorImpl::insertFtrCount(Base::int64 mol_id, std::s
 	evalStatement(insFtrCountStmt);
 }
 
+void Pharm::PSDScreeningDBCreatorImpl::insertAtomCoords(Base::int64 mol_id, std::size_t conf_idx, const ConformerRecord& conf_rec)
+{
+	setupStatement(insAtomCoordsStmt, INSERT_ATOM_COORDS_DATA_SQL, true);
+
+	if (sqlite3_bind_int64(insAtomCoordsStmt.get(), 1, mol_id) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding atom coordinates molecule ID to prepared statement");
+
+	if (sqlite3_bind_int(insAtomCoordsStmt.get(), 2, boost::numeric_cast<int>(conf_idx)) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding atom coordinates conf. index to prepared statement");
+
+	if (sqlite3_bind_blob(insAtomCoordsStmt.get(), 3, &conf_rec.atomCoordsData[0], boost::numeric_cast<int>(conf_rec.atomCoordsData.size()),
+						  SQLITE_STATIC) != SQLITE_OK)
+		throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding atom coordinates data BLOB to prepared statement");
+
+	evalStatement(insAtomCoordsStmt);
+}
+
 void Pharm::PSDScreeningDBCreatorImpl::deleteRowsWithMolID(SQLite3StmtPointer& stmt_ptr, const std::string& sql_stmt, Base::int64 mol_id) const
 {
 	setupStatement(stmt_ptr, sql_stmt, true);
@@ -553,3 +771,158 @@ void Pharm::PSDScreeningDBCreatorImpl::commitTransaction()
 	setupStatement(commitTransStmt, COMMIT_TRANSACTION_SQL, false);
 	evalStatement(commitTransStmt);
 }
+
+// RecordGenerator
+
+Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::RecordGenerator():
+	pharmWriter(controlParams), molWriter(controlParams), pharmGenerator(true)
+{
+	Pharm::setStrictErrorCheckingParameter(controlParams, true);
+	Chem::setStrictErrorCheckingParameter(controlParams, true);
+
+	Pharm::setCDFWriteSinglePrecisionFloatsParameter(controlParams, true);
+	Chem::setCDFWriteSinglePrecisionFloatsParameter(controlParams, true);
+}
+
+Base::uint64 Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::calcHashCode(const Chem::MolecularGraph& molgraph)
+{
+	return hashCalculator.calculate(molgraph);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::generate(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec)
+{
+	serializeMolecule(molgraph, rec);
+
+	rec.confRecords.clear();
+
+	std::size_t num_confs = getNumConformations(molgraph);
+
+	if (num_confs == 0) {
+		if (hasCoordinates(molgraph, 3)) {
+			get3DCoordinates(molgraph, coordinates);
+
+			pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(coordinates, molgraph));
+			pharmGenerator.prepare(molgraph);
+			genConformerRecords(molgraph, rec);
+		}
+
+		return;
+	}
+
+	confEnsemble.assign(molgraph);
+	pharmGenerator.prepare(molgraph);
+
+	rec.confRecords.reserve(num_confs);
+
+	for (std::size_t i = 0; i < num_confs; i++) {
+		pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomConformerEnsemble3DCoordinatesFunctor(confEnsemble, i, molgraph));
+		confEnsemble.getConformer(i, coordinates);
+		genConformerRecords(molgraph, rec);
+	}
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::generate(const Chem::MolecularGraph& molgraph, const ScreeningDBAccessor& db_acc, 
+																   std::size_t mol_idx, MoleculeRecord& rec)
+{
+	serializeMolecule(molgraph, rec);
+
+	rec.confRecords.clear();
+
+	std::size_t num_pharms = db_acc.getNumPharmacophores(mol_idx);
+	std::size_t num_confs = getNumConformations(molgraph);
+
+	rec.confRecords.reserve(num_pharms);
+
+	for (std::size_t i = 0; i < num_pharms; i++) {
+		ConformerRecord& conf_rec = addConformerRecord(rec);
+
+		pharmacophore.clear();
+		db_acc.getPharmacophore(mol_idx, i, pharmacophore);
+
+		featureCounts = db_acc.getFeatureCounts(mol_idx, i);
+
+		serializePharmacophore(conf_rec);
+		copyFtrCounts(conf_rec);
+
+		if (i < num_confs) 
+			getConformation(molgraph, i, coordinates);
+
+		else if (num_confs == 0 && hasCoordinates(molgraph, 3)) 
+			get3DCoordinates(molgraph, coordinates);
+		else
+			continue;
+
+		serializeAtomCoords(molgraph, conf_rec);
+	}
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::genConformerRecords(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec)
+{
+	ConformerRecord& conf_rec = addConformerRecord(rec);
+
+	pharmacophore.clear();
+	pharmGenerator.instantiate(pharmacophore);
+
+	featureCounts.clear();
+	buildFeatureTypeHistogram(pharmacophore, featureCounts);
+
+	serializePharmacophore(conf_rec);
+	copyFtrCounts(conf_rec);
+	serializeAtomCoords(molgraph, conf_rec);
+}
+
+Pharm::PSDScreeningDBCreatorImpl::ConformerRecord& Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::addConformerRecord(MoleculeRecord& rec)
+{
+	rec.confRecords.push_back(ConformerRecord());
+
+	return rec.confRecords.back();
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::serializeMolecule(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec)
+{
+	molWriter.writeMolGraph(molgraph, byteBuffer);
+	copyBufferData(rec.molData);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::serializePharmacophore(ConformerRecord& conf_rec)
+{
+	pharmWriter.writeFeatureContainer(pharmacophore, byteBuffer);
+	copyBufferData(conf_rec.pharmData);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::serializeAtomCoords(const Chem::MolecularGraph& molgraph, ConformerRecord& conf_rec)
+{
+	// compact single precision block of the atom positions of the conformation (taken from the 
+	// coordinates array) and the atomic van der Waals radii for fast exclusion volume clash tests
+
+	std::size_t num_atoms = molgraph.getNumAtoms();
+
+	if (coordinates.getSize() != num_atoms)
+		throw Base::CalculationFailed("PSDScreeningDBCreatorImpl: conformer atom coordinates count mismatch");
+
+	byteBuffer.setIOPointer(0);
+	byteBuffer.putInt(boost::numeric_cast<Base::uint32>(num_atoms), false);
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		const Math::Vector3D& pos = coordinates[i];
+
+		byteBuffer.putFloat(float(pos[0]));
+		byteBuffer.putFloat(float(pos[1]));
+		byteBuffer.putFloat(float(pos[2]));
+		byteBuffer.putFloat(float(Chem::AtomDictionary::getVdWRadius(getType(molgraph.getAtom(i)))));
+	}
+
+	byteBuffer.resize(byteBuffer.getIOPointer());
+
+	copyBufferData(conf_rec.atomCoordsData);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::copyFtrCounts(ConformerRecord& conf_rec) const
+{
+	conf_rec.ftrCounts.assign(featureCounts.getEntriesBegin(), featureCounts.getEntriesEnd());
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::RecordGenerator::copyBufferData(ByteArray& data) const
+{
+	data.assign(byteBuffer.getData(), byteBuffer.getData() + byteBuffer.getSize());
+}
@@ -27,8 +27,15 @@
 #ifndef CDPL_PHARM_PSDSCREENINGDBCREATORIMPL_HPP
 #define CDPL_PHARM_PSDSCREENINGDBCREATORIMPL_HPP
 
+#include <vector>
+#include <deque>
+#include <string>
+#include <utility>
+
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
 
 #include "CDPL/Pharm/SQLiteDataIOBase.hpp"
 #include "CDPL/Pharm/ScreeningDBCreator.hpp"
@@ -38,6 +45,7 @@
 #include "CDPL/Pharm/CDFPharmacophoreDataWriter.hpp"
 #include "CDPL/Chem/CDFDataWriter.hpp"
 #include "CDPL/Chem/HashCodeCalculator.hpp"
+#include "CDPL/Chem/ConformerEnsemble.hpp"
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Base/ControlParameterList.hpp"
 #include "CDPL/Base/IntegerTypes.hpp"
@@ -64,6 +72,8 @@ namespace CDPL
 		public:
 			PSDScreeningDBCreatorImpl();
 
+			~PSDScreeningDBCreatorImpl();
+
             void open(const std::string& name, ScreeningDBCreator::Mode mode = ScreeningDBCreator::CREATE, bool allow_dup_entries = true);
 
 			void close();
@@ -86,8 +96,75 @@ namespace CDPL
 
 			std::size_t getNumInserted() const;
 
+			void setUseWriterThread(bool use);
+
+			bool getUseWriterThread() const;
+
+			void flush();
+
 		private:
-			void initControlParams();
+			typedef std::vector<char> ByteArray;
+			typedef std::vector<std::pair<unsigned int, std::size_t> > FeatureCountList;
+
+			struct ConformerRecord
+			{
+
+				ByteArray        pharmData;
+				FeatureCountList ftrCounts;
+				ByteArray        atomCoordsData;
+			};
+
+			typedef std::vector<ConformerRecord> ConformerRecordList;
+
+			struct MoleculeRecord
+			{
+
+				Base::uint64        molHash;
+				ByteArray           molData;
+				ConformerRecordList confRecords;
+			};
+
+			typedef boost::shared_ptr<MoleculeRecord> MoleculeRecordPtr;
+			typedef std::vector<MoleculeRecordPtr> MoleculeRecordList;
+			typedef std::deque<MoleculeRecordPtr> MoleculeRecordQueue;
+
+			class RecordGenerator
+			{
+
+			public:
+				RecordGenerator();
+
+				Base::uint64 calcHashCode(const Chem::MolecularGraph& molgraph);
+
+				void generate(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec);
+				void generate(const Chem::MolecularGraph& molgraph, const ScreeningDBAccessor& db_acc, std::size_t mol_idx, MoleculeRecord& rec);
+
+			private:
+				void genConformerRecords(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec);
+				ConformerRecord& addConformerRecord(MoleculeRecord& rec);
+
+				void serializeMolecule(const Chem::MolecularGraph& molgraph, MoleculeRecord& rec);
+				void serializePharmacophore(ConformerRecord& conf_rec);
+				void serializeAtomCoords(const Chem::MolecularGraph& molgraph, ConformerRecord& conf_rec);
+
+				void copyFtrCounts(ConformerRecord& conf_rec) const;
+
+				void copyBufferData(ByteArray& data) const;
+
+				Chem::HashCodeCalculator      hashCalculator;
+				Internal::ByteBuffer          byteBuffer;
+				Base::ControlParameterList    controlParams;
+				CDFPharmacophoreDataWriter    pharmWriter;
+				Chem::CDFDataWriter           molWriter;
+				BasicPharmacophore            pharmacophore;
+				DefaultPharmacophoreGenerator pharmGenerator;
+				FeatureTypeHistogram          featureCounts;
+				Math::Vector3DArray           coordinates;
+				Chem::ConformerEnsemble       confEnsemble;
+			};
+
+			typedef boost::shared_ptr<RecordGenerator> RecordGeneratorPtr;
+			typedef std::vector<RecordGeneratorPtr> RecordGeneratorList;
 
 			void closeDBConnection();
 
@@ -95,18 +172,29 @@ namespace CDPL
 
 			void loadMolHashToIDMap();
 
-			std::size_t deleteEntries(Base::uint64 mol_hash);
+			RecordGeneratorPtr acquireRecordGenerator();
+			void releaseRecordGenerator(const RecordGeneratorPtr& gen);
+
+			bool registerMolecule(Base::uint64 mol_hash);
+			void unregisterMolecule(Base::uint64 mol_hash);
 
-			Base::int64 insertMolecule(const Chem::MolecularGraph& molgraph, Base::uint64 mol_hash);
+			void submitRecord(const MoleculeRecordPtr& rec);
 
-			void genAndInsertPharmData(const Chem::MolecularGraph& molgraph, Base::int64 mol_id);
-			void genAndInsertPharmData(const Chem::MolecularGraph& molgraph, Base::int64 mol_id, std::size_t conf_idx);
+			void startWriterThread();
+			void stopWriterThread();
+			void processRecordQueue();
+			void checkWriterError() const;
+
+			void insertRecords(const MoleculeRecordList& recs);
+			void insertRecord(const MoleculeRecord& rec, std::size_t& num_del);
+
+			std::size_t deleteEntries(Base::uint64 mol_hash);
 
-			void insertPharmacophore(Base::int64 mol_id, std::size_t conf_idx);
+			Base::int64 insertMolecule(const MoleculeRecord& rec);
 
-			void genFtrCounts();
-			void insertFtrCounts(Base::int64 mol_id, std::size_t conf_idx);
+			void insertPharmacophore(Base::int64 mol_id, std::size_t conf_idx, const ConformerRecord& conf_rec);
 			void insertFtrCount(Base::int64 mol_id, std::size_t conf_idx, unsigned int ftr_type, std::size_t ftr_count);
+			void insertAtomCoords(Base::int64 mol_id, std::size_t conf_idx, const ConformerRecord& conf_rec);
 
 			void deleteRowsWithMolID(SQLite3StmtPointer& stmt_ptr, const std::string& sql_stmt, Base::int64 mol_id) const;
 
@@ -121,22 +209,26 @@ namespace CDPL
 			SQLite3StmtPointer               insMoleculeStmt;
 			SQLite3StmtPointer               insPharmStmt;
 			SQLite3StmtPointer               insFtrCountStmt;
+			SQLite3StmtPointer               insAtomCoordsStmt;
 			SQLite3StmtPointer               delMolWithMolIDStmt;
 			SQLite3StmtPointer               delPharmsWithMolIDStmt;
 			SQLite3StmtPointer               delFeatureCountsWithMolIDStmt;
+			SQLite3StmtPointer               delAtomCoordsWithMolIDStmt;
 			SQLite3StmtPointer               delTwoPointPharmsWithMolIDStmt;
 			SQLite3StmtPointer               delThreePointPharmsWithMolIDStmt;
 			MolHashToIDMap                   molHashToIDMap;
 			MolHashSet                       procMolecules;
-			Chem::HashCodeCalculator         hashCalculator;
-			Internal::ByteBuffer             byteBuffer;
-			Base::ControlParameterList       controlParams;
-			CDFPharmacophoreDataWriter       pharmWriter;
-			Chem::CDFDataWriter              molWriter;
-			BasicPharmacophore               pharmacophore;
-			DefaultPharmacophoreGenerator    pharmGenerator;
-			FeatureTypeHistogram             featureCounts;
-			Math::Vector3DArray              coordinates;
+			RecordGeneratorList              recordGenerators;
+			MoleculeRecordQueue              recordQueue;
+			std::size_t                      numPendingRecords;
+			boost::thread                    writerThread;
+			mutable boost::mutex             mutex;
+			boost::condition_variable        queueNotEmptyCondition;
+			boost::condition_variable        queueNotFullCondition;
+			boost::condition_variable        queueFlushedCondition;
+			std::string                      writerError;
+			bool                             stopWriter;
+			bool                             useWriterThread;
 			ScreeningDBCreator::Mode         mode;
 			bool                             allowDupEntries;
 			std::size_t                      numProcessed;
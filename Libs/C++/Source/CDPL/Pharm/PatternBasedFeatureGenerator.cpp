@@ -41,6 +41,7 @@
 #include "CDPL/Chem/AtomFunctions.hpp"
 #include "CDPL/Chem/Entity3DFunctions.hpp"
 #include "CDPL/Math/SVDecomposition.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 
 namespace
@@ -54,11 +55,11 @@ using namespace CDPL;
 
 
 Pharm::PatternBasedFeatureGenerator::PatternBasedFeatureGenerator():
-	bitSetCache(MAX_BIT_SET_CACHE_SIZE)
+	molGraph(0), bitSetCache(MAX_BIT_SET_CACHE_SIZE)
 {}
 
 Pharm::PatternBasedFeatureGenerator::PatternBasedFeatureGenerator(const PatternBasedFeatureGenerator& gen): 
-	FeatureGenerator(gen), bitSetCache(MAX_BIT_SET_CACHE_SIZE)
+	FeatureGenerator(gen), molGraph(0), bitSetCache(MAX_BIT_SET_CACHE_SIZE)
 {
 	for (IncludePatternList::const_iterator it = gen.includePatterns.begin(), end = gen.includePatterns.end(); it != end; ++it)
 		includePatterns.push_back(IncludePattern(it->subQuery, it->featureType, it->featureTol, it->featureGeom, it->vectorLength));
@@ -93,18 +94,41 @@ void Pharm::PatternBasedFeatureGenerator::clearExcludePatterns()
 
 void Pharm::PatternBasedFeatureGenerator::generate(const Chem:: MolecularGraph& molgraph, Pharmacophore& pharm)
 {
-	using namespace Chem;
+	prepare(molgraph);
+	instantiate(pharm);
+}
 
+void Pharm::PatternBasedFeatureGenerator::prepare(const Chem::MolecularGraph& molgraph)
+{
 	init(molgraph);
 
 	getExcludeMatches();
+	getIncludeMatches();
+
+	prepareNonPatternFeatures(molgraph);
+}
+
+void Pharm::PatternBasedFeatureGenerator::instantiate(Pharmacophore& pharm)
+{
+	if (!molGraph)
+		throw Base::OperationFailed("PatternBasedFeatureGenerator: prepare() has to be called before instantiate()");
+
+	for (FeatureMatchList::const_iterator it = featureMatches.begin(), end = featureMatches.end(); it != end; ++it)
+		addFeature(*it, pharm);
+
+	addNonPatternFeatures(*molGraph, pharm);
+}
+
+void Pharm::PatternBasedFeatureGenerator::getIncludeMatches()
+{
+	using namespace Chem;
 
 	Util::BitSet* atom_mask = 0;
 
 	for (IncludePatternList::const_iterator p_it = includePatterns.begin(), p_end = includePatterns.end(); p_it != p_end; ++p_it) {
 		const IncludePattern& ptn = *p_it;
 
-		ptn.subSearch->findMappings(molgraph);
+		ptn.subSearch->findMappings(*molGraph);
 
 		for (SubstructureSearch::ConstMappingIterator m_it = ptn.subSearch->getMappingsBegin(),
 				 m_end = ptn.subSearch->getMappingsEnd(); m_it != m_end; ++m_it) {
@@ -122,14 +146,12 @@ void Pharm::PatternBasedFeatureGenerator::generate(const Chem:: MolecularGraph&
 			if (isContainedInList(*atom_mask, includeMatches))
 				continue;
 	
-			addFeature(mapping, ptn, pharm);
+			addFeatureMatch(mapping, ptn);
 
 			includeMatches.push_back(atom_mask);
 			atom_mask = 0;
 		}
 	}
-
-	addNonPatternFeatures(molgraph, pharm);
 }
 
 Pharm::FeatureGenerator::SharedPointer Pharm::PatternBasedFeatureGenerator::clone() const
@@ -157,21 +179,20 @@ Pharm::PatternBasedFeatureGenerator& Pharm::PatternBasedFeatureGenerator::operat
 	return *this;
 }
 
-void Pharm::PatternBasedFeatureGenerator::addFeature(const Chem::AtomBondMapping& mapping, const IncludePattern& ftr_ptn, 
-													 Pharmacophore& pharm)
+void Pharm::PatternBasedFeatureGenerator::addFeatureMatch(const Chem::AtomBondMapping& mapping, const IncludePattern& ftr_ptn)
 {
 	using namespace Chem;
 
-	Feature& feature = pharm.addFeature();
+	featureMatches.resize(featureMatches.size() + 1);
+
+	FeatureMatch& ftr_match = featureMatches.back();
 
-	setType(feature, ftr_ptn.featureType);
-	setTolerance(feature, ftr_ptn.featureTol);
+	ftr_match.featureType = ftr_ptn.featureType;
+	ftr_match.featureTol = ftr_ptn.featureTol;
+	ftr_match.featureGeom = ftr_ptn.featureGeom;
+	ftr_match.vectorLength = ftr_ptn.vectorLength;
 
 	Fragment::SharedPointer substruct_ptr(new Fragment());
-	
-	posRefAtomList.clear();
-	geomRefAtom1List.clear();
-	geomRefAtom2List.clear();
 
 	for (AtomMapping::ConstEntryIterator it = mapping.getAtomMapping().getEntriesBegin(), 
 			 end = mapping.getAtomMapping().getEntriesEnd(); it != end; ++it) {
@@ -185,13 +206,13 @@ void Pharm::PatternBasedFeatureGenerator::addFeature(const Chem::AtomBondMapping
 			substruct_ptr->addAtom(mpd_atom);
 		
 		if (label & POS_REF_ATOM_FLAG)
-			posRefAtomList.push_back(&mpd_atom);
+			ftr_match.posRefAtoms.push_back(&mpd_atom);
 
 		if (label & GEOM_REF_ATOM1_FLAG)
-			geomRefAtom1List.push_back(&mpd_atom);
+			ftr_match.geomRefAtoms1.push_back(&mpd_atom);
 
 		if (label & GEOM_REF_ATOM2_FLAG)
-			geomRefAtom2List.push_back(&mpd_atom);
+			ftr_match.geomRefAtoms2.push_back(&mpd_atom);
 	}
 
 	for (BondMapping::ConstEntryIterator it = mapping.getBondMapping().getEntriesBegin(), 
@@ -203,22 +224,31 @@ void Pharm::PatternBasedFeatureGenerator::addFeature(const Chem::AtomBondMapping
 			substruct_ptr->addBond(mpd_bond);
 	}
 
-	setSubstructure(feature, substruct_ptr);
+	ftr_match.substructure = substruct_ptr;
+}
+
+void Pharm::PatternBasedFeatureGenerator::addFeature(const FeatureMatch& ftr_match, Pharmacophore& pharm)
+{
+	Feature& feature = pharm.addFeature();
+
+	setType(feature, ftr_match.featureType);
+	setTolerance(feature, ftr_match.featureTol);
+	setSubstructure(feature, ftr_match.substructure);
 
 	Math::Vector3D pos;
 
-	if (calcCentroid(posRefAtomList, pos))
+	if (calcCentroid(ftr_match.posRefAtoms, pos))
 		set3DCoordinates(feature, pos);
 
-	switch (ftr_ptn.featureGeom) {
+	switch (ftr_match.featureGeom) {
 
 		case FeatureGeometry::VECTOR: {
 			Math::Vector3D orient;
-			double length = calcVecFeatureOrientation(geomRefAtom1List, geomRefAtom2List, orient);
+			double length = calcVecFeatureOrientation(ftr_match.geomRefAtoms1, ftr_match.geomRefAtoms2, orient);
 
 			if (length >= 0.0) {
 				setOrientation(feature, orient);
-				setLength(feature, ftr_ptn.vectorLength < 0.0 ? length : ftr_ptn.vectorLength);
+				setLength(feature, ftr_match.vectorLength < 0.0 ? length : ftr_match.vectorLength);
 			}
 
 			break;
@@ -227,7 +257,7 @@ void Pharm::PatternBasedFeatureGenerator::addFeature(const Chem::AtomBondMapping
 		case FeatureGeometry::PLANE: {
 			Math::Vector3D orient, tmp;
 
-			if (calcPlaneFeatureOrientation(geomRefAtom1List, orient, tmp))
+			if (calcPlaneFeatureOrientation(ftr_match.geomRefAtoms1, orient, tmp))
 				setOrientation(feature, orient);
 		}
 
@@ -235,7 +265,7 @@ void Pharm::PatternBasedFeatureGenerator::addFeature(const Chem::AtomBondMapping
 			break;
 	}
 
-	setGeometry(feature, ftr_ptn.featureGeom);
+	setGeometry(feature, ftr_match.featureGeom);
 }
 
 double Pharm::PatternBasedFeatureGenerator::calcVecFeatureOrientation(const AtomList& alist1, const AtomList& alist2, Math::Vector3D& orient) const
@@ -370,6 +400,7 @@ void Pharm::PatternBasedFeatureGenerator::init(const Chem::MolecularGraph& molgr
 
 	includeMatches.clear();
 	excludeMatches.clear();
+	featureMatches.clear();
 
 	bitSetCache.putAll();
 }
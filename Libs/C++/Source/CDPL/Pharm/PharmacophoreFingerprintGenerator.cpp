@@ -0,0 +1,264 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintGenerator.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include "CDPL/Pharm/PharmacophoreFingerprintGenerator.hpp"
+#include "CDPL/Pharm/FeatureContainer.hpp"
+#include "CDPL/Pharm/Feature.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/Atom3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/AtomConformer3DCoordinatesFunctor.hpp"
+
+#include "TwoPointPharmacophore.hpp"
+#include "ThreePointPharmacophore.hpp"
+#include "TwoPointPharmacophoreGenerator.hpp"
+#include "ThreePointPharmacophoreGenerator.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::size_t  DEF_NUM_BITS             = 2048;
+	const double       DEF_DISTANCE_BIN_SIZE    = 1.0;
+	const double       DEF_MAX_DISTANCE         = 16.0;
+
+	const Base::uint64 TWO_POINT_PHARM_SEED     = Base::uint64(0x2545F4914F6CDD1DULL);
+	const Base::uint64 THREE_POINT_PHARM_SEED   = Base::uint64(0x9E6C63D0676A9A99ULL);
+
+	// platform independent hash value combination - fingerprints may get persisted
+
+	Base::uint64 combineHash(Base::uint64 seed, Base::uint64 value)
+	{
+		Base::uint64 h = seed ^ (value + Base::uint64(0x9E3779B97F4A7C15ULL) + (seed << 6) + (seed >> 2));
+
+		h ^= h >> 30;
+		h *= Base::uint64(0xBF58476D1CE4E5B9ULL);
+		h ^= h >> 27;
+		h *= Base::uint64(0x94D049BB133111EBULL);
+		h ^= h >> 31;
+
+		return h;
+	}
+}
+
+
+Pharm::PharmacophoreFingerprintGenerator::PharmacophoreFingerprintGenerator():
+	numBits(DEF_NUM_BITS), binSize(DEF_DISTANCE_BIN_SIZE), maxDistance(DEF_MAX_DISTANCE), 
+	inc2PointPharms(true), inc3PointPharms(true), pharmGenerator(true)
+{}
+
+void Pharm::PharmacophoreFingerprintGenerator::setNumBits(std::size_t num_bits)
+{
+	numBits = num_bits;
+}
+
+std::size_t Pharm::PharmacophoreFingerprintGenerator::getNumBits() const
+{
+	return numBits;
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::setDistanceBinSize(double bin_size)
+{
+	binSize = bin_size;
+}
+
+double Pharm::PharmacophoreFingerprintGenerator::getDistanceBinSize() const
+{
+	return binSize;
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::setMaxDistance(double max_dist)
+{
+	maxDistance = max_dist;
+}
+
+double Pharm::PharmacophoreFingerprintGenerator::getMaxDistance() const
+{
+	return maxDistance;
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::include2PointPharmacophores(bool include)
+{
+	inc2PointPharms = include;
+}
+
+bool Pharm::PharmacophoreFingerprintGenerator::include2PointPharmacophores() const
+{
+	return inc2PointPharms;
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::include3PointPharmacophores(bool include)
+{
+	inc3PointPharms = include;
+}
+
+bool Pharm::PharmacophoreFingerprintGenerator::include3PointPharmacophores() const
+{
+	return inc3PointPharms;
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::generate(const FeatureContainer& cntnr, Util::BitSet& fp, bool merge)
+{
+	if (!merge) {
+		fp.resize(numBits);
+		fp.reset();
+
+	} else if (fp.size() != numBits)
+		fp.resize(numBits);
+
+	if (numBits == 0)
+		return;
+
+	features.clear();
+
+	for (FeatureContainer::ConstFeatureIterator it = cntnr.getFeaturesBegin(), end = cntnr.getFeaturesEnd(); it != end; ++it) {
+		const Feature& ftr = *it;
+
+		if (getType(ftr) == FeatureType::X_VOLUME)
+			continue;
+
+		if (getDisabledFlag(ftr))
+			continue;
+
+		features.push_back(&ftr);
+	}
+
+	typedef boost::indirect_iterator<FeatureList::const_iterator, const Feature> FeatureListIterator;
+
+	if (inc2PointPharms) {
+		typedef void (PharmacophoreFingerprintGenerator::*SetBitFunc)(const TwoPointPharmacophore&, Util::BitSet&) const;
+
+		TwoPointPharmacophoreGenerator<TwoPointPharmacophore>().generate(FeatureListIterator(features.begin()), FeatureListIterator(features.end()),
+																		 boost::make_function_output_iterator(boost::bind(static_cast<SetBitFunc>(&PharmacophoreFingerprintGenerator::setBit),
+																														  this, _1, boost::ref(fp))));
+	}
+
+	if (inc3PointPharms) {
+		typedef void (PharmacophoreFingerprintGenerator::*SetBitFunc)(const ThreePointPharmacophore&, Util::BitSet&) const;
+
+		ThreePointPharmacophoreGenerator<ThreePointPharmacophore>().generate(FeatureListIterator(features.begin()), FeatureListIterator(features.end()),
+																			 boost::make_function_output_iterator(boost::bind(static_cast<SetBitFunc>(&PharmacophoreFingerprintGenerator::setBit),
+																															  this, _1, boost::ref(fp))), false);
+	}
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::generate(const Chem::MolecularGraph& molgraph, Util::BitSet& fp)
+{
+	fp.resize(numBits);
+	fp.reset();
+
+	std::size_t num_confs = getNumConformations(molgraph);
+
+	if (num_confs == 0) {
+		if (!hasCoordinates(molgraph, 3))
+			return;
+
+		pharmGenerator.setAtom3DCoordinatesFunction(Chem::Atom3DCoordinatesFunctor());
+		pharmGenerator.prepare(molgraph);
+
+		pharmacophore.clear();
+		pharmGenerator.instantiate(pharmacophore);
+
+		generate(pharmacophore, fp, true);
+		return;
+	}
+
+	pharmGenerator.prepare(molgraph);
+
+	for (std::size_t i = 0; i < num_confs; i++) {
+		pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomConformer3DCoordinatesFunctor(i));
+
+		pharmacophore.clear();
+		pharmGenerator.instantiate(pharmacophore);
+
+		generate(pharmacophore, fp, true);
+	}
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::setBit(const TwoPointPharmacophore& pharm, Util::BitSet& fp) const
+{
+	// feature types are in canonical (ascending) order
+
+	Base::uint64 hash = combineHash(TWO_POINT_PHARM_SEED, pharm.getFeature1Type());
+
+	hash = combineHash(hash, pharm.getFeature2Type());
+	hash = combineHash(hash, getDistanceBin(pharm.getFeatureDistance()));
+
+	setBit(hash, fp);
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::setBit(const ThreePointPharmacophore& pharm, Util::BitSet& fp) const
+{
+	// each feature type is paired with the bin of the opposite triangle side - sorting the pairs 
+	// yields a description that is independent of the feature order
+
+	Base::uint64 ftr_descrs[3] = {
+		(Base::uint64(pharm.getFeature1Type()) << 32) | getDistanceBin(pharm.getFeature23Distance()),
+		(Base::uint64(pharm.getFeature2Type()) << 32) | getDistanceBin(pharm.getFeature13Distance()),
+		(Base::uint64(pharm.getFeature3Type()) << 32) | getDistanceBin(pharm.getFeature12Distance())
+	};
+
+	std::sort(ftr_descrs, ftr_descrs + 3);
+
+	Base::uint64 hash = combineHash(THREE_POINT_PHARM_SEED, ftr_descrs[0]);
+
+	hash = combineHash(hash, ftr_descrs[1]);
+	hash = combineHash(hash, ftr_descrs[2]);
+
+	setBit(hash, fp);
+}
+
+void Pharm::PharmacophoreFingerprintGenerator::setBit(Base::uint64 hash, Util::BitSet& fp) const
+{
+	fp.set(std::size_t(hash % numBits));
+}
+
+Base::uint64 Pharm::PharmacophoreFingerprintGenerator::getDistanceBin(double dist) const
+{
+	if (binSize <= 0.0)
+		return 0;
+
+	Base::uint64 max_bin = Base::uint64(std::max(std::ceil(maxDistance / binSize), 1.0)) - 1;
+
+	if (dist >= maxDistance)
+		return max_bin;
+
+	return std::min(Base::uint64(dist / binSize), max_bin);
+}
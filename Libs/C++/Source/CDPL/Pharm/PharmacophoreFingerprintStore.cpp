@@ -0,0 +1,380 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintStore.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Pharm/PharmacophoreFingerprintStore.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const Base::uint32 FORMAT_ID       = 0x53504650;
+	const Base::uint32 FORMAT_VERSION  = 1;
+	const std::size_t  HEADER_SIZE     = 24;
+	const std::size_t  FP_WORD_SIZE    = 64;
+	const std::size_t  PROC_CHUNK_SIZE = 1024;
+	const std::size_t  IO_CHUNK_SIZE   = 4096;
+
+	void convertFingerprint(const Util::BitSet& fp, Base::uint64* words, std::size_t num_words)
+	{
+		std::fill(words, words + num_words, Base::uint64(0));
+
+		for (Util::BitSet::size_type i = fp.find_first(); i != Util::BitSet::npos; i = fp.find_next(i))
+			words[i / FP_WORD_SIZE] |= Base::uint64(1) << (i % FP_WORD_SIZE);
+	}
+
+	inline std::size_t countBits(Base::uint64 word)
+	{
+#if defined(__GNUC__)
+		return __builtin_popcountll(word);
+#else
+		word = word - ((word >> 1) & Base::uint64(0x5555555555555555ULL));
+		word = (word & Base::uint64(0x3333333333333333ULL)) + ((word >> 2) & Base::uint64(0x3333333333333333ULL));
+		word = (word + (word >> 4)) & Base::uint64(0x0F0F0F0F0F0F0F0FULL);
+
+		return std::size_t((word * Base::uint64(0x0101010101010101ULL)) >> 56);
+#endif
+	}
+
+	std::size_t countBits(const Base::uint64* words, std::size_t num_words)
+	{
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < num_words; i++)
+			count += countBits(words[i]);
+
+		return count;
+	}
+
+	struct SearchHitCmpFunc
+	{
+
+		bool operator()(const Pharm::PharmacophoreFingerprintStore::SearchHit& hit1, 
+						const Pharm::PharmacophoreFingerprintStore::SearchHit& hit2) const {
+			if (hit1.second > hit2.second)
+				return true;
+
+			if (hit1.second < hit2.second)
+				return false;
+
+			return (hit1.first < hit2.first);
+		}
+	};
+}
+
+
+Pharm::PharmacophoreFingerprintStore::PharmacophoreFingerprintStore():
+	numThreads(1), numBits(0), numFPWords(0)
+{}
+
+void Pharm::PharmacophoreFingerprintStore::setNumThreads(std::size_t num_threads)
+{
+	numThreads = num_threads;
+}
+
+std::size_t Pharm::PharmacophoreFingerprintStore::getNumThreads() const
+{
+	return numThreads;
+}
+
+std::size_t Pharm::PharmacophoreFingerprintStore::getNumFingerprintBits() const
+{
+	return numBits;
+}
+
+std::size_t Pharm::PharmacophoreFingerprintStore::getNumFingerprints() const
+{
+	return bitCounts.size();
+}
+
+std::size_t Pharm::PharmacophoreFingerprintStore::addFingerprint(const Util::BitSet& fp)
+{
+	std::size_t idx = getNumFingerprints();
+
+	if (idx == 0) {
+		numBits = fp.size();
+		numFPWords = (numBits + FP_WORD_SIZE - 1) / FP_WORD_SIZE;
+
+	} else if (fp.size() != numBits)
+		throw Base::SizeError("PharmacophoreFingerprintStore: fingerprint size mismatch");
+
+	fingerprints.resize(fingerprints.size() + numFPWords);
+
+	if (numFPWords > 0)
+		convertFingerprint(fp, &fingerprints[idx * numFPWords], numFPWords);
+
+	bitCounts.push_back(fp.count());
+
+	return idx;
+}
+
+void Pharm::PharmacophoreFingerprintStore::getFingerprint(std::size_t idx, Util::BitSet& fp) const
+{
+	if (idx >= getNumFingerprints())
+		throw Base::IndexError("PharmacophoreFingerprintStore: fingerprint index out of bounds");
+
+	fp.resize(numBits);
+	fp.reset();
+
+	const Base::uint64* words = &fingerprints[idx * numFPWords];
+
+	for (std::size_t i = 0; i < numBits; i++)
+		if (words[i / FP_WORD_SIZE] & (Base::uint64(1) << (i % FP_WORD_SIZE)))
+			fp.set(i);
+}
+
+std::size_t Pharm::PharmacophoreFingerprintStore::findSimilar(const Util::BitSet& query, SearchHitList& hits, double min_sim, 
+															   std::size_t max_num_hits) const
+{
+	hits.clear();
+
+	std::size_t num_fps = getNumFingerprints();
+
+	if (num_fps == 0)
+		return 0;
+
+	if (query.size() != numBits)
+		throw Base::SizeError("PharmacophoreFingerprintStore: query fingerprint size mismatch");
+
+	UInt64Array query_words(numFPWords);
+
+	if (numFPWords > 0)
+		convertFingerprint(query, &query_words[0], numFPWords);
+
+	std::size_t query_bit_count = query.count();
+	std::size_t num_threads = (numThreads == 0 ? std::size_t(boost::thread::hardware_concurrency()) : numThreads);
+
+	num_threads = std::max(std::min(num_threads, (num_fps + PROC_CHUNK_SIZE - 1) / PROC_CHUNK_SIZE), std::size_t(1));
+
+	boost::atomic<std::size_t> next_idx(0);
+
+	if (num_threads > 1) {
+		std::vector<SearchHitList> thread_hits(num_threads - 1);
+		boost::thread_group thread_grp;
+
+		for (std::size_t i = 0; i < num_threads - 1; i++)
+			thread_grp.create_thread(boost::bind(&PharmacophoreFingerprintStore::searchFingerprints, this, boost::ref(next_idx), 
+												 boost::cref(query_words), query_bit_count, min_sim, max_num_hits, boost::ref(thread_hits[i])));
+
+		searchFingerprints(next_idx, query_words, query_bit_count, min_sim, max_num_hits, hits);
+
+		thread_grp.join_all();
+
+		for (std::size_t i = 0; i < num_threads - 1; i++)
+			hits.insert(hits.end(), thread_hits[i].begin(), thread_hits[i].end());
+
+	} else
+		searchFingerprints(next_idx, query_words, query_bit_count, min_sim, max_num_hits, hits);
+
+	if (max_num_hits > 0 && hits.size() > max_num_hits)
+		selectBestHits(hits, max_num_hits);
+
+	std::sort(hits.begin(), hits.end(), SearchHitCmpFunc());
+
+	return hits.size();
+}
+
+void Pharm::PharmacophoreFingerprintStore::clear()
+{
+	fingerprints.clear();
+	bitCounts.clear();
+	fileName.clear();
+
+	numBits = 0;
+	numFPWords = 0;
+}
+
+void Pharm::PharmacophoreFingerprintStore::save(const std::string& file_name) const
+{
+	std::ofstream os(file_name.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+	if (!os)
+		throw Base::IOError("PharmacophoreFingerprintStore: could not open file '" + file_name + "' for writing");
+
+	Internal::ByteBuffer bbuf;
+
+	bbuf.putInt(FORMAT_ID, false);
+	bbuf.putInt(FORMAT_VERSION, false);
+	bbuf.putInt(Base::uint32(numBits), false);
+	bbuf.putInt(Base::uint32(0), false);
+	bbuf.putInt(Base::uint64(getNumFingerprints()), false);
+
+	bbuf.writeBuffer(os);
+
+	for (std::size_t i = 0, num_words = fingerprints.size(); i < num_words; i += IO_CHUNK_SIZE) {
+		bbuf.setIOPointer(0);
+
+		for (std::size_t j = i, end = std::min(i + IO_CHUNK_SIZE, num_words); j < end; j++)
+			bbuf.putInt(fingerprints[j], false);
+
+		bbuf.resize(bbuf.getIOPointer());
+		bbuf.writeBuffer(os);
+	}
+
+	os.flush();
+
+	if (!os.good()) {
+		os.close();
+		std::remove(file_name.c_str());
+
+		throw Base::IOError("PharmacophoreFingerprintStore: error while writing file '" + file_name + "'");
+	}
+}
+
+void Pharm::PharmacophoreFingerprintStore::open(const std::string& file_name)
+{
+	clear();
+
+	try {
+		std::ifstream is(file_name.c_str(), std::ios_base::in | std::ios_base::binary);
+
+		if (!is)
+			throw Base::IOError("PharmacophoreFingerprintStore: could not open file '" + file_name + "'");
+
+		Internal::ByteBuffer bbuf;
+
+		if (bbuf.readBuffer(is, HEADER_SIZE) != HEADER_SIZE)
+			throw Base::IOError("PharmacophoreFingerprintStore: unexpected end of file while reading header");
+
+		Base::uint32 format_id;
+		Base::uint32 format_version;
+		Base::uint32 num_bits;
+		Base::uint32 reserved;
+		Base::uint64 num_fps;
+
+		bbuf.setIOPointer(0);
+
+		bbuf.getInt(format_id);
+		bbuf.getInt(format_version);
+		bbuf.getInt(num_bits);
+		bbuf.getInt(reserved);
+		bbuf.getInt(num_fps);
+
+		if (format_id != FORMAT_ID)
+			throw Base::IOError("PharmacophoreFingerprintStore: invalid file format");
+
+		if (format_version != FORMAT_VERSION)
+			throw Base::IOError("PharmacophoreFingerprintStore: unsupported file format version");
+
+		numBits = num_bits;
+		numFPWords = (numBits + FP_WORD_SIZE - 1) / FP_WORD_SIZE;
+
+		fingerprints.resize(num_fps * numFPWords);
+
+		for (std::size_t i = 0, num_words = fingerprints.size(); i < num_words; i += IO_CHUNK_SIZE) {
+			std::size_t chunk_size = std::min(IO_CHUNK_SIZE, num_words - i);
+
+			if (bbuf.readBuffer(is, chunk_size * sizeof(Base::uint64)) != chunk_size * sizeof(Base::uint64))
+				throw Base::IOError("PharmacophoreFingerprintStore: unexpected end of file while reading fingerprints");
+
+			bbuf.setIOPointer(0);
+
+			for (std::size_t j = 0; j < chunk_size; j++)
+				bbuf.getInt(fingerprints[i + j]);
+		}
+
+		bitCounts.resize(num_fps);
+
+		for (std::size_t i = 0; i < num_fps; i++)
+			bitCounts[i] = (numFPWords > 0 ? countBits(&fingerprints[i * numFPWords], numFPWords) : 0);
+
+		fileName = file_name;
+
+	} catch (...) {
+		clear();
+		throw;
+	}
+}
+
+const std::string& Pharm::PharmacophoreFingerprintStore::getFileName() const
+{
+	return fileName;
+}
+
+void Pharm::PharmacophoreFingerprintStore::searchFingerprints(boost::atomic<std::size_t>& next_idx, const UInt64Array& query, 
+															  std::size_t query_bit_count, double min_sim, std::size_t max_num_hits, 
+															  SearchHitList& hits) const
+{
+	std::size_t num_fps = getNumFingerprints();
+	double sim_threshold = min_sim;
+
+	for (std::size_t i = next_idx.fetch_add(PROC_CHUNK_SIZE); i < num_fps; i = next_idx.fetch_add(PROC_CHUNK_SIZE)) {
+		for (std::size_t j = i, end = std::min(i + PROC_CHUNK_SIZE, num_fps); j < end; j++) {
+			std::size_t bit_count = bitCounts[j];
+			std::size_t max_bit_count = std::max(bit_count, query_bit_count);
+
+			if (max_bit_count == 0)
+				continue;
+
+			// the ratio of the bit counts is an upper bound of the Tanimoto coefficient 
+
+			if (double(std::min(bit_count, query_bit_count)) / max_bit_count < sim_threshold)
+				continue;
+
+			const Base::uint64* fp_words = &fingerprints[j * numFPWords];
+			std::size_t num_common = 0;
+
+			for (std::size_t k = 0; k < numFPWords; k++)
+				num_common += countBits(fp_words[k] & query[k]);
+
+			double sim = double(num_common) / (bit_count + query_bit_count - num_common);
+
+			if (sim < sim_threshold)
+				continue;
+
+			hits.push_back(SearchHit(j, sim));
+
+			if (max_num_hits > 0 && hits.size() >= 2 * max_num_hits) {
+				selectBestHits(hits, max_num_hits);
+
+				sim_threshold = std::max(sim_threshold, hits.back().second);
+			}
+		}
+	}
+}
+
+void Pharm::PharmacophoreFingerprintStore::selectBestHits(SearchHitList& hits, std::size_t max_num_hits)
+{
+	std::nth_element(hits.begin(), hits.begin() + (max_num_hits - 1), hits.end(), SearchHitCmpFunc());
+
+	// the least similar of the retained hits is now at the back
+
+	hits.resize(max_num_hits);
+}
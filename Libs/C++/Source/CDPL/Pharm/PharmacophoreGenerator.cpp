@@ -107,6 +107,23 @@ void Pharm::PharmacophoreGenerator::generate(const Chem::MolecularGraph& molgrap
 			it->second->generate(molgraph, pharm);
 }
 
+void Pharm::PharmacophoreGenerator::prepare(const Chem::MolecularGraph& molgraph)
+{
+	for (FeatureGeneratorMap::const_iterator it = featureGeneratorMap.begin(), end = featureGeneratorMap.end(); it != end; ++it)
+		if (isFeatureEnabled(it->first) && it->second)
+			it->second->prepare(molgraph);
+}
+
+void Pharm::PharmacophoreGenerator::instantiate(Pharmacophore& pharm, bool append)
+{
+	if (!append)
+		pharm.clear();
+
+	for (FeatureGeneratorMap::const_iterator it = featureGeneratorMap.begin(), end = featureGeneratorMap.end(); it != end; ++it)
+		if (isFeatureEnabled(it->first) && it->second)
+			it->second->instantiate(pharm);
+}
+
 void Pharm::PharmacophoreGenerator::setAtom3DCoordinatesFunction(const Chem::Atom3DCoordinatesFunction& func)
 {
 	coordsFunc = func;
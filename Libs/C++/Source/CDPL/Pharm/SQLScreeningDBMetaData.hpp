@@ -42,6 +42,7 @@ namespace CDPL
 			const std::string MOL_TABLE_NAME              = "molecules";
 			const std::string PHARM_TABLE_NAME            = "pharmacophores";
 			const std::string FTR_COUNT_TABLE_NAME        = "ftr_counts";
+			const std::string ATOM_COORDS_TABLE_NAME      = "atom_coords";
 		
 			const std::string MOL_ID_COLUMN_NAME          = "mol_id";
 			const std::string MOL_HASH_COLUMN_NAME        = "mol_hash";
@@ -52,6 +53,8 @@ namespace CDPL
 
 			const std::string FTR_TYPE_COLUMN_NAME        = "ftr_type";
 			const std::string FTR_COUNT_COLUMN_NAME       = "ftr_count";
+
+			const std::string ATOM_COORDS_DATA_COLUMN_NAME = "atom_coords_data";
 		}
     }
 }
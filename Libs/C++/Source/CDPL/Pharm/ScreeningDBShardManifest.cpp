@@ -0,0 +1,178 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningDBShardManifest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+#include <boost/lexical_cast.hpp>
+
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const std::string WHITESPACE_CHARS = " \t\r\n";
+}
+
+
+Pharm::ScreeningDBShardManifest::ScreeningDBShardManifest()
+{}
+
+void Pharm::ScreeningDBShardManifest::addShard(const std::string& file_name, std::size_t num_mols)
+{
+	Shard shard;
+
+	shard.fileName = file_name;
+	shard.molOffset = getNumMolecules();
+	shard.numMolecules = num_mols;
+
+	shards.push_back(shard);
+}
+
+std::size_t Pharm::ScreeningDBShardManifest::getNumShards() const
+{
+	return shards.size();
+}
+
+const std::string& Pharm::ScreeningDBShardManifest::getShardFileName(std::size_t idx) const
+{
+	return getShard(idx).fileName;
+}
+
+std::size_t Pharm::ScreeningDBShardManifest::getShardMoleculeOffset(std::size_t idx) const
+{
+	return getShard(idx).molOffset;
+}
+
+std::size_t Pharm::ScreeningDBShardManifest::getShardNumMolecules(std::size_t idx) const
+{
+	return getShard(idx).numMolecules;
+}
+
+std::size_t Pharm::ScreeningDBShardManifest::findShard(std::size_t mol_idx) const
+{
+	if (mol_idx >= getNumMolecules())
+		throw Base::IndexError("ScreeningDBShardManifest: molecule index out of bounds");
+
+	// the last shard with an offset <= mol_idx is never empty since mol_idx < total number of molecules
+
+	std::size_t lo = 0, hi = shards.size();
+
+	while (hi - lo > 1) {
+		std::size_t mid = (lo + hi) / 2;
+
+		if (mol_idx < shards[mid].molOffset)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	return lo;
+}
+
+std::size_t Pharm::ScreeningDBShardManifest::getNumMolecules() const
+{
+	if (shards.empty())
+		return 0;
+
+	return (shards.back().molOffset + shards.back().numMolecules);
+}
+
+void Pharm::ScreeningDBShardManifest::clear()
+{
+	shards.clear();
+}
+
+void Pharm::ScreeningDBShardManifest::read(std::istream& is)
+{
+	ShardList new_shards;
+	std::string line;
+	std::size_t num_mols = 0;
+
+	for (std::size_t line_no = 1; std::getline(is, line); line_no++) {
+		std::string::size_type start = line.find_first_not_of(WHITESPACE_CHARS);
+
+		if (start == std::string::npos || line[start] == '#')
+			continue;
+
+		std::istringstream iss(line);
+		Shard shard;
+
+		if (!(iss >> shard.molOffset >> shard.numMolecules))
+			throw Base::IOError("ScreeningDBShardManifest: invalid shard specification in line " + boost::lexical_cast<std::string>(line_no));
+
+		std::string::size_type path_start = (iss.eof() ? std::string::npos : 
+											  line.find_first_not_of(WHITESPACE_CHARS, std::string::size_type(iss.tellg())));
+
+		if (path_start == std::string::npos)
+			throw Base::IOError("ScreeningDBShardManifest: missing shard file path in line " + boost::lexical_cast<std::string>(line_no));
+
+		shard.fileName = line.substr(path_start, line.find_last_not_of(WHITESPACE_CHARS) + 1 - path_start);
+
+		if (shard.molOffset != num_mols)
+			throw Base::IOError("ScreeningDBShardManifest: molecule index offset in line " + boost::lexical_cast<std::string>(line_no) + 
+								" does not match the total number of molecules in the preceding shards");
+
+		num_mols += shard.numMolecules;
+
+		new_shards.push_back(shard);
+	}
+
+	if (is.bad())
+		throw Base::IOError("ScreeningDBShardManifest: error while reading manifest data");
+
+	shards.swap(new_shards);
+}
+
+void Pharm::ScreeningDBShardManifest::write(std::ostream& os) const
+{
+	os << "# Screening database shard manifest\n";
+	os << "# <mol. index offset> <num. molecules> <shard file path>\n";
+
+	for (ShardList::const_iterator it = shards.begin(), end = shards.end(); it != end; ++it)
+		os << it->molOffset << ' ' << it->numMolecules << ' ' << it->fileName << '\n';
+
+	os.flush();
+
+	if (!os.good())
+		throw Base::IOError("ScreeningDBShardManifest: error while writing manifest data");
+}
+
+const Pharm::ScreeningDBShardManifest::Shard& Pharm::ScreeningDBShardManifest::getShard(std::size_t idx) const
+{
+	if (idx >= shards.size())
+		throw Base::IndexError("ScreeningDBShardManifest: shard index out of bounds");
+
+	return shards[idx];
+}
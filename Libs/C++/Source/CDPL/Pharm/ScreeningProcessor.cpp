@@ -39,9 +39,9 @@ using namespace CDPL;
 Pharm::ScreeningProcessor::SearchHit::SearchHit(const ScreeningProcessor& hit_prov, const FeatureContainer& qry_pharm,
 												const FeatureContainer& hit_pharm, const Chem::Molecule& mol, 
 												const Math::Matrix4D& xform, std::size_t pharm_idx, 
-												std::size_t mol_idx, std::size_t conf_idx):
+												std::size_t mol_idx, std::size_t conf_idx, std::size_t qry_idx):
 	provider(&hit_prov), qryPharm(&qry_pharm), hitPharm(&hit_pharm), molecule(&mol),
-	almntTransform(&xform), pharmIndex(pharm_idx), molIndex(mol_idx), confIndex(conf_idx) {}
+	almntTransform(&xform), pharmIndex(pharm_idx), molIndex(mol_idx), confIndex(conf_idx), qryIndex(qry_idx) {}
 
 const Pharm::ScreeningProcessor& Pharm::ScreeningProcessor::SearchHit::getHitProvider() const
 {
@@ -83,6 +83,11 @@ std::size_t Pharm::ScreeningProcessor::SearchHit::getHitConformationIndex() cons
 	return confIndex;
 }
 
+std::size_t Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophoreIndex() const
+{
+	return qryIndex;
+}
+
 
 // ScreeningProcessor
 
@@ -142,6 +147,16 @@ bool Pharm::ScreeningProcessor::bestAlignmentsSeeked() const
 	return impl->bestAlignmentsSeeked();
 }
 
+void Pharm::ScreeningProcessor::pruneAlignmentSearch(bool prune)
+{
+	impl->pruneAlignmentSearch(prune);
+}
+
+bool Pharm::ScreeningProcessor::alignmentSearchPruned() const
+{
+	return impl->alignmentSearchPruned();
+}
+
 void Pharm::ScreeningProcessor::setHitCallback(const HitCallbackFunction& func)
 {
 	impl->setHitCallback(func);
@@ -172,7 +187,32 @@ const Pharm::ScreeningProcessor::ScoringFunction& Pharm::ScreeningProcessor::get
 	return impl->getScoringFunction();
 }
 
+void Pharm::ScreeningProcessor::enableStatistics(bool enable)
+{
+	impl->enableStatistics(enable);
+}
+
+bool Pharm::ScreeningProcessor::statisticsEnabled() const
+{
+	return impl->statisticsEnabled();
+}
+
+const Pharm::ScreeningStatistics& Pharm::ScreeningProcessor::getStatistics() const
+{
+	return impl->getStatistics();
+}
+
+void Pharm::ScreeningProcessor::clearStatistics()
+{
+	impl->clearStatistics();
+}
+
 std::size_t Pharm::ScreeningProcessor::searchDB(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx)
 {
 	return impl->searchDB(query, mol_start_idx, mol_end_idx);
 }
+
+std::size_t Pharm::ScreeningProcessor::searchDB(const FeatureContainerList& queries, std::size_t mol_start_idx, std::size_t mol_end_idx)
+{
+	return impl->searchDB(queries, mol_start_idx, mol_end_idx);
+}
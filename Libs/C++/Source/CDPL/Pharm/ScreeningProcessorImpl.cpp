@@ -50,6 +50,7 @@
 #include "CDPL/Math/VectorAdapter.hpp"
 
 #include "ScreeningProcessorImpl.hpp"
+#include "ScreeningStageTimer.hpp"
 
 
 using namespace CDPL;
@@ -73,14 +74,10 @@ namespace
 
 Pharm::ScreeningProcessorImpl::ScreeningProcessorImpl(ScreeningProcessor& parent, ScreeningDBAccessor& db_acc): 
 	parent(&parent), dbAccessor(&db_acc), reportMode(ScreeningProcessor::FIRST_MATCHING_CONF), maxOmittedFeatures(0),
-	checkXVolumes(true), bestAlignments(false), hitCallback(), progressCallback(), 
-	scoringFunction(PharmacophoreFitScreeningScore()), featureGeomMatchFunction(false), pharmAlignment(true)
-{
-	pharmAlignment.setTopAlignmentConstraintFunction(
-		boost::bind(&ScreeningProcessorImpl::checkTopologicalMapping, this, _1));
-	pharmAlignment.setEntity3DCoordinatesFunction(
-		boost::bind(&ScreeningProcessorImpl::getFeatureCoordinates, this, _1));
-}
+	checkXVolumes(true), bestAlignments(false), pruneAlmntSearch(false), hitCallback(), progressCallback(), 
+	scoringFunction(PharmacophoreFitScreeningScore()), featureGeomMatchFunction(false), numQueries(0), currQuery(0),
+	collectStats(false), activeStageTimer(0)
+{}
 
 void Pharm::ScreeningProcessorImpl::setDBAccessor(ScreeningDBAccessor& db_acc)
 {
@@ -132,6 +129,16 @@ bool Pharm::ScreeningProcessorImpl::bestAlignmentsSeeked() const
 	return bestAlignments;
 }
 
+void Pharm::ScreeningProcessorImpl::pruneAlignmentSearch(bool prune)
+{
+	pruneAlmntSearch = prune;
+}
+
+bool Pharm::ScreeningProcessorImpl::alignmentSearchPruned() const
+{
+	return pruneAlmntSearch;
+}
+
 void Pharm::ScreeningProcessorImpl::setHitCallback(const HitCallbackFunction& func)
 {
 	hitCallback = func;
@@ -162,21 +169,49 @@ const Pharm::ScreeningProcessor::ScoringFunction& Pharm::ScreeningProcessorImpl:
 	return scoringFunction;
 }
 
+void Pharm::ScreeningProcessorImpl::enableStatistics(bool enable)
+{
+	collectStats = enable;
+}
+
+bool Pharm::ScreeningProcessorImpl::statisticsEnabled() const
+{
+	return collectStats;
+}
+
+const Pharm::ScreeningStatistics& Pharm::ScreeningProcessorImpl::getStatistics() const
+{
+	return statistics;
+}
+
+void Pharm::ScreeningProcessorImpl::clearStatistics()
+{
+	statistics.clear();
+}
+
 std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainer& query, std::size_t mol_start_idx, 
 													std::size_t mol_end_idx)
 {
-	prepareDBSearch(query, mol_start_idx, mol_end_idx);
+	return searchDB(FeatureContainerList(1, &query), mol_start_idx, mol_end_idx);
+}
+
+std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainerList& queries, std::size_t mol_start_idx, 
+													std::size_t mol_end_idx)
+{
+	prepareDBSearch(queries, mol_start_idx, mol_end_idx);
 
 	std::size_t num_pharm_entries = pharmIndices.size();
 
 	for (std::size_t i = 0; i <= num_pharm_entries; i++) {
-		if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF && !std::isnan(bestConfAlmntScore) &&
-			(i == num_pharm_entries || pharmIndices[i].second != bestConfAlmntMolIdx)) {
-			
-			if (!reportHit(SearchHit(*parent, query, dbPharmacophore, dbMolecule, bestConfAlmntTransform,
-									 bestConfAlmntPharmIdx, bestConfAlmntMolIdx, bestConfAlmntConfIdx),
-						   bestConfAlmntScore))
-				return numHits;
+		if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF) {
+			for (std::size_t j = 0; j < numQueries; j++) {
+				currQuery = queryData[j].get();
+
+				if (!std::isnan(currQuery->bestConfAlmntScore) &&
+					(i == num_pharm_entries || pharmIndices[i].second != currQuery->bestConfAlmntMolIdx) &&
+					!reportBestConfAlignment(*currQuery))
+					return numHits;
+			}
 		}
 
 		if (progressCallback && !progressCallback(i, num_pharm_entries))
@@ -186,63 +221,80 @@ std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainer& quer
 			continue;
 
 		std::size_t mol_idx = pharmIndices[i].second;
+		std::size_t pharm_idx = pharmIndices[i].first;
 
-		if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF && molHitSet.test(mol_idx)) 
-			continue;
+		// the DB pharmacophore (and the data derived from it) gets loaded only once and is then shared by all queries
 
-		std::size_t pharm_idx = pharmIndices[i].first;
+		for (std::size_t j = 0; j < numQueries; j++) {
+			currQuery = queryData[j].get();
 
-		if (!checkFeatureCounts(pharm_idx))
-			continue;
+			if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF && currQuery->molHitSet.test(mol_idx)) 
+				continue;
 
-		if (!check2PointPharmacophores(pharm_idx))
-			continue;
+			if (!checkFeatureCounts(pharm_idx))
+				continue;
 
-		if (!performAlignment(pharm_idx, mol_idx))
-			return numHits;
+			if (!check2PointPharmacophores(pharm_idx))
+				continue;
+
+			if (!performAlignment(pharm_idx, mol_idx))
+				return numHits;
+		}
 	}
 
 	return numHits;
 }
 
-void Pharm::ScreeningProcessorImpl::prepareDBSearch(const FeatureContainer& query, std::size_t mol_start_idx, 
+void Pharm::ScreeningProcessorImpl::prepareDBSearch(const FeatureContainerList& queries, std::size_t mol_start_idx, 
 													std::size_t mol_end_idx)
 {
-	initQueryData(query);
-
 	numHits = 0;
+	numQueries = queries.size();
 	loadedPharmIndex = dbAccessor->getNumPharmacophores();
 	loadedMolIndex = dbAccessor->getNumMolecules();
 
-	if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF) {
-		molHitSet.resize(loadedMolIndex);
-		molHitSet.reset();
+	for (std::size_t i = 0; i < numQueries; i++) {
+		if (i == queryData.size())
+			queryData.push_back(QueryDataPtr(new QueryData(*this)));
+
+		QueryData& query_data = *queryData[i];
 
-	} else if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF)
-		bestConfAlmntScore = NAN_SCORE;
+		query_data.index = i;
+
+		initQueryData(query_data, *queries[i]);
+		initMaxAlignmentScore(query_data);
+
+		if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF) {
+			query_data.molHitSet.resize(loadedMolIndex);
+			query_data.molHitSet.reset();
+
+		} else if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF)
+			query_data.bestConfAlmntScore = NAN_SCORE;
+	}
 
 	initPharmIndexList(mol_start_idx, mol_end_idx);
 }
 
-void Pharm::ScreeningProcessorImpl::initQueryData(const FeatureContainer& query)
+void Pharm::ScreeningProcessorImpl::initQueryData(QueryData& query_data, const FeatureContainer& query)
 {
-	queryPharmacophore = &query;
+	query_data.pharmacophore = &query;
 
-	queryMandFeatures.clear();
-	queryMandFeatureTypes.clear();
-	queryOptFeatures.clear();
-	alignedQueryMandFeatures.clear();
-	queryFeatureCounts.clear();
-	queryFeatureTolerances.clear();
-	queryFeaturePositions.clear();
-	pharmAlignment.clearEntities(true);
-	xVolumeIndices.clear();
+	query_data.mandFeatures.clear();
+	query_data.mandFeatureTypes.clear();
+	query_data.optFeatures.clear();
+	query_data.alignedMandFeatures.clear();
+	query_data.alignedOptFeatures.clear();
+	query_data.featureCounts.clear();
+	query_data.featureTolerances.clear();
+	query_data.featurePositions.clear();
+	query_data.alignment.clearEntities(true);
+	query_data.xVolumeIndices.clear();
 
 	for (FeatureContainer::ConstFeatureIterator it = query.getFeaturesBegin(), end = query.getFeaturesEnd(); it != end; ++it) {
 		const Feature& ftr = *it;
 
-		queryFeatureTolerances.push_back(getTolerance(ftr));
-		queryFeaturePositions.addElement(get3DCoordinates(ftr));
+		query_data.featureTolerances.push_back(getTolerance(ftr));
+		query_data.featurePositions.addElement(get3DCoordinates(ftr));
 
 		if (getDisabledFlag(ftr))
 			continue;
@@ -251,47 +303,115 @@ void Pharm::ScreeningProcessorImpl::initQueryData(const FeatureContainer& query)
 			if (getOptionalFlag(ftr))
 				continue;
 
-			xVolumeIndices.push_back(ftr.getIndex());
+			query_data.xVolumeIndices.push_back(ftr.getIndex());
 			continue;
 		}
 
 		if (getOptionalFlag(ftr))
-			insertFeature(ftr, queryOptFeatures);
+			insertFeature(ftr, query_data.optFeatures);
 		else
-			insertFeature(ftr, queryMandFeatures);
+			insertFeature(ftr, query_data.mandFeatures);
 	}
 
-	for (FeatureMatrix::iterator it = queryMandFeatures.begin(), end = queryMandFeatures.end(); it != end; ++it) {
+	for (FeatureMatrix::iterator it = query_data.mandFeatures.begin(), end = query_data.mandFeatures.end(); it != end; ++it) {
 		FeatureList& ftr_list = *it; assert(!ftr_list.empty());		
 		const Feature& max_tol_ftr = **std::max_element(ftr_list.begin(), ftr_list.end(), FeatureTolCmpFunc());
 		unsigned int type = getType(max_tol_ftr);
 
-		pharmAlignment.addEntity(max_tol_ftr, true);
-		alignedQueryMandFeatures.push_back(&max_tol_ftr);
-		queryMandFeatureTypes.push_back(type);
-		queryFeatureCounts[type]++;
+		query_data.alignment.addEntity(max_tol_ftr, true);
+		query_data.alignedMandFeatures.push_back(&max_tol_ftr);
+		query_data.mandFeatureTypes.push_back(type);
+		query_data.featureCounts[type]++;
 	}
 
-	for (FeatureMatrix::iterator it = queryOptFeatures.begin(), end = queryOptFeatures.end(); it != end; ++it) {
+	for (FeatureMatrix::iterator it = query_data.optFeatures.begin(), end = query_data.optFeatures.end(); it != end; ++it) {
 		FeatureList& ftr_list = *it; assert(!ftr_list.empty());		
 		const Feature& max_tol_ftr = **std::max_element(ftr_list.begin(), ftr_list.end(), FeatureTolCmpFunc());
 		
-		pharmAlignment.addEntity(max_tol_ftr, true);
-		alignedQueryOptFeatures.push_back(&max_tol_ftr);
+		query_data.alignment.addEntity(max_tol_ftr, true);
+		query_data.alignedOptFeatures.push_back(&max_tol_ftr);
 	}
 
-	query2PointPharmList.clear();
+	query_data.twoPointPharmList.clear();
+
+	query2PointPharmGen.generate(FeatureListIterator(query_data.alignedMandFeatures.begin()),
+								 FeatureListIterator(query_data.alignedMandFeatures.end()),
+								 std::back_inserter(query_data.twoPointPharmList));
+
+	std::size_t min_num_ftrs = (query_data.mandFeatures.size() > maxOmittedFeatures ? 
+								std::size_t(query_data.mandFeatures.size() - maxOmittedFeatures) : std::size_t(0));
+
+	query_data.minNum2PointPharmMatches = (min_num_ftrs < 2 ? std::size_t(0) : (min_num_ftrs * (min_num_ftrs - 1)) / 2);
+
+	query_data.alignment.setMinTopologicalMappingSize(min_num_ftrs);
+}
+
+void Pharm::ScreeningProcessorImpl::initMaxAlignmentScore(QueryData& query_data) const
+{
+	query_data.maxFeatureScore = NAN_SCORE;
+	query_data.numScoredFeatures = 0;
+	query_data.scoredFeatureCounts.clear();
+
+	bool prune = (bestAlignments && pruneAlmntSearch);
+
+	query_data.alignment.orderTopologicalMappingsBySize(prune);
 
-	query2PointPharmGen.generate(FeatureListIterator(alignedQueryMandFeatures.begin()),
-								 FeatureListIterator(alignedQueryMandFeatures.end()),
-								 std::back_inserter(query2PointPharmList));
+	if (!prune)
+		return;
+
+	const PharmacophoreFitScreeningScore* fit_score = scoringFunction.target<PharmacophoreFitScreeningScore>();
+
+	if (!fit_score)
+		return;
+
+	// the per-feature match count, position and geometry scores are all within [0, 1] and only features of the same type
+	// get matched - query features of a type that is missing in the database pharmacophore thus always score zero, all others
+	// at most the sum of the positive factors
+
+	for (FeatureContainer::ConstFeatureIterator it = query_data.pharmacophore->getFeaturesBegin(), end = query_data.pharmacophore->getFeaturesEnd(); it != end; ++it) {
+		const Feature& ftr = *it;
+
+		if (getDisabledFlag(ftr))
+			continue;
 
-	std::size_t min_num_ftrs = (queryMandFeatures.size() > maxOmittedFeatures ? 
-								std::size_t(queryMandFeatures.size() - maxOmittedFeatures) : std::size_t(0));
+		unsigned int type = getType(ftr);
 
-	minNum2PointPharmMatches = (min_num_ftrs < 2 ? std::size_t(0) : (min_num_ftrs * (min_num_ftrs - 1)) / 2);
+		if (type == FeatureType::X_VOLUME)
+			continue;
 
-	pharmAlignment.setMinTopologicalMappingSize(min_num_ftrs);
+		query_data.scoredFeatureCounts[type]++;
+		query_data.numScoredFeatures++;
+	}
+
+	query_data.maxFeatureScore = std::max(fit_score->getFeatureMatchCountFactor(), 0.0) + std::max(fit_score->getFeaturePositionMatchFactor(), 0.0) +
+		std::max(fit_score->getFeatureGeometryMatchFactor(), 0.0);
+}
+
+double Pharm::ScreeningProcessorImpl::getMaxAlignmentScore(std::size_t pharm_idx) const
+{
+	if (std::isnan(currQuery->maxFeatureScore))
+		return NAN_SCORE;
+
+	if (currQuery->numScoredFeatures == 0)
+		return 0.0;
+
+	const FeatureTypeHistogram& db_ftr_cnts = dbAccessor->getFeatureCounts(pharm_idx);
+	std::size_t num_matchable = 0;
+
+	for (FeatureTypeHistogram::ConstEntryIterator it = currQuery->scoredFeatureCounts.getEntriesBegin(), 
+			 end = currQuery->scoredFeatureCounts.getEntriesEnd(); it != end; ++it)
+		if (db_ftr_cnts.getValue(it->first, 0) > 0)
+			num_matchable += it->second;
+
+	return (num_matchable * currQuery->maxFeatureScore / currQuery->numScoredFeatures);
+}
+
+bool Pharm::ScreeningProcessorImpl::reportBestConfAlignment(QueryData& query_data)
+{
+	return reportHit(SearchHit(*parent, *query_data.pharmacophore, dbPharmacophore, dbMolecule, query_data.bestConfAlmntTransform,
+							   query_data.bestConfAlmntPharmIdx, query_data.bestConfAlmntMolIdx, query_data.bestConfAlmntConfIdx,
+							   query_data.index),
+					 query_data.bestConfAlmntScore);
 }
 
 void Pharm::ScreeningProcessorImpl::insertFeature(const Feature& ftr, FeatureMatrix& ftr_mtx) const
@@ -337,8 +457,10 @@ void Pharm::ScreeningProcessorImpl::initPharmIndexList(std::size_t mol_start_idx
 	std::sort(pharmIndices.begin(), pharmIndices.end(), IndexPair2ndCmpFunc());
 }
 
-bool Pharm::ScreeningProcessorImpl::checkFeatureCounts(std::size_t pharm_idx) const
+bool Pharm::ScreeningProcessorImpl::checkFeatureCounts(std::size_t pharm_idx)
 {
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::FEATURE_COUNT_CHECK, activeStageTimer);
+
 	const FeatureTypeHistogram& db_ftr_cnts = dbAccessor->getFeatureCounts(pharm_idx);
 	std::size_t num_db_ftrs = 0;
 
@@ -346,40 +468,46 @@ bool Pharm::ScreeningProcessorImpl::checkFeatureCounts(std::size_t pharm_idx) co
 			 end = db_ftr_cnts.getEntriesEnd(); it != end; ++it)
 		num_db_ftrs += it->second;
 	
-	if ((num_db_ftrs + maxOmittedFeatures) < queryMandFeatures.size())
-		return false;
+	if ((num_db_ftrs + maxOmittedFeatures) < currQuery->mandFeatures.size())
+		return timer.record(false);
 
-	for (FeatureTypeHistogram::ConstEntryIterator it = queryFeatureCounts.getEntriesBegin(), 
-			 end = queryFeatureCounts.getEntriesEnd(); it != end; ++it) {
+	for (FeatureTypeHistogram::ConstEntryIterator it = currQuery->featureCounts.getEntriesBegin(), 
+			 end = currQuery->featureCounts.getEntriesEnd(); it != end; ++it) {
 
 		std::size_t db_ftr_cnt = db_ftr_cnts.getValue(it->first, 0);
 
 		if ((db_ftr_cnt + maxOmittedFeatures) < it->second)
-			return false;
+			return timer.record(false);
 	}
 
-	return true;
+	return timer.record(true);
 }
 
 bool Pharm::ScreeningProcessorImpl::check2PointPharmacophores(std::size_t pharm_idx)
 {
-	if (minNum2PointPharmMatches == 0)
-		return true;
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::TWO_POINT_PHARMACOPHORE_CHECK, activeStageTimer);
+
+	if (currQuery->minNum2PointPharmMatches == 0)
+		return timer.record(true);
 
 	loadPharmacophore(pharm_idx);
 
-	db2PointPharmSet.clear();
-	db2PointPharmGen.generate(dbPharmacophore.getFeaturesBegin(),
-							  dbPharmacophore.getFeaturesEnd(),
-							  std::inserter(db2PointPharmSet, db2PointPharmSet.begin()));
+	if (initDB2PointPharmSet) {
+		db2PointPharmSet.clear();
+		db2PointPharmGen.generate(dbPharmacophore.getFeaturesBegin(),
+								  dbPharmacophore.getFeaturesEnd(),
+								  std::inserter(db2PointPharmSet, db2PointPharmSet.begin()));
+
+		initDB2PointPharmSet = false;
+	}
 
 	typedef std::pair<TwoPointPharmacophoreSet::const_iterator, TwoPointPharmacophoreSet::const_iterator> IterPair;
 
-	std::size_t num_query_2pt_pharms = query2PointPharmList.size();
-	std::size_t max_num_mismatches = num_query_2pt_pharms - minNum2PointPharmMatches;
+	std::size_t num_query_2pt_pharms = currQuery->twoPointPharmList.size();
+	std::size_t max_num_mismatches = num_query_2pt_pharms - currQuery->minNum2PointPharmMatches;
 
 	for (std::size_t i = 0, num_matches = 0, num_mismatches = 0; i < num_query_2pt_pharms; i++) {
-		const QueryTwoPointPharmacophore& query_2pt_pharm = query2PointPharmList[i];
+		const QueryTwoPointPharmacophore& query_2pt_pharm = currQuery->twoPointPharmList[i];
 
 		double min_dist = query_2pt_pharm.getFeatureDistance() - query_2pt_pharm.getFeature1Tolerance() 
 			- query_2pt_pharm.getFeature2Tolerance();
@@ -398,8 +526,8 @@ bool Pharm::ScreeningProcessorImpl::check2PointPharmacophores(std::size_t pharm_
 			if (dist >= min_dist && dist <= max_dist) {
 				num_matches++;
 
-				if (num_matches >= minNum2PointPharmMatches)
-					return true;
+				if (num_matches >= currQuery->minNum2PointPharmMatches)
+					return timer.record(true);
 
 				match = true;
 				break;
@@ -410,53 +538,63 @@ bool Pharm::ScreeningProcessorImpl::check2PointPharmacophores(std::size_t pharm_
 			num_mismatches++;
 
 			if (num_mismatches > max_num_mismatches)
-				return false;
+				return timer.record(false);
 		}
 	}
 
-	return false;
+	return timer.record(false);
 }
 
 bool Pharm::ScreeningProcessorImpl::performAlignment(std::size_t pharm_idx, std::size_t mol_idx)
 {
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::ALIGNMENT, activeStageTimer);
+
 	loadPharmacophore(pharm_idx);
 
-	pharmAlignment.clearEntities(false);
-	pharmAlignment.addFeatures(dbPharmacophore, false);
+	currQuery->alignment.clearEntities(false);
+	currQuery->alignment.addFeatures(dbPharmacophore, false);
 
 	double best_score = NAN_SCORE;
+	double max_score = (bestAlignments ? getMaxAlignmentScore(pharm_idx) : NAN_SCORE);
 	std::size_t conf_idx = dbAccessor->getConformationIndex(pharm_idx);
 
-	while (pharmAlignment.nextAlignment()) {
+	while (currQuery->alignment.nextAlignment()) {
+		if (!std::isnan(max_score) && !std::isnan(best_score) && best_score >= max_score)
+			break;
+
 		if (!checkGeomAlignment())
 			continue;
 
 		if (!checkXVolumeClashes(mol_idx, conf_idx))
 			continue;
 
-		SearchHit hit(*parent, *queryPharmacophore, dbPharmacophore, dbMolecule, 
-					  pharmAlignment.getTransform(), pharm_idx, mol_idx, conf_idx);
+		SearchHit hit(*parent, *currQuery->pharmacophore, dbPharmacophore, dbMolecule, 
+					  currQuery->alignment.getTransform(), pharm_idx, mol_idx, conf_idx, currQuery->index);
 		double score = calcScore(hit);
 
-		if (!bestAlignments)
+		if (!bestAlignments) {
+			timer.record(true);
 			return processHit(hit, score);
+		}
 
 		if (std::isnan(best_score) || score > best_score) {
 			best_score = score;
-			bestAlmntTransform = pharmAlignment.getTransform();
+			bestAlmntTransform = currQuery->alignment.getTransform();
 		}
 	}
 
-	if (!std::isnan(best_score))
-		return processHit(SearchHit(*parent, *queryPharmacophore, dbPharmacophore, dbMolecule, 
-									bestAlmntTransform, pharm_idx, mol_idx, conf_idx), best_score);
+	if (timer.record(!std::isnan(best_score)))
+		return processHit(SearchHit(*parent, *currQuery->pharmacophore, dbPharmacophore, dbMolecule, 
+									bestAlmntTransform, pharm_idx, mol_idx, conf_idx, currQuery->index), best_score);
 
 	return true;
 }
 
 bool Pharm::ScreeningProcessorImpl::checkGeomAlignment()
 {
-	std::size_t num_al_mand_ftrs = alignedQueryMandFeatures.size();
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::GEOMETRY_CHECK, activeStageTimer);
+
+	std::size_t num_al_mand_ftrs = currQuery->alignedMandFeatures.size();
 	std::size_t min_num_matches = (num_al_mand_ftrs > maxOmittedFeatures ? 
 								   std::size_t(num_al_mand_ftrs - maxOmittedFeatures) : std::size_t(0));
 
@@ -472,7 +610,7 @@ bool Pharm::ScreeningProcessorImpl::checkGeomAlignment()
 		initDBFeaturesByType = false;
 	}
 
-	const Math::Matrix4D& xform = pharmAlignment.getTransform();
+	const Math::Matrix4D& xform = currQuery->alignment.getTransform();
 	Math::Vector3D tmp;
 	
 	alignedDBFeaturePositions = dbFeaturePositions;
@@ -482,12 +620,12 @@ bool Pharm::ScreeningProcessorImpl::checkGeomAlignment()
 	std::size_t num_matches = 0;
 
 	for (std::size_t i = 0; i < num_al_mand_ftrs; i++) {
-		std::size_t query_ftr_idx = alignedQueryMandFeatures[i]->getIndex();
+		std::size_t query_ftr_idx = currQuery->alignedMandFeatures[i]->getIndex();
 
-		const Math::Vector3D& query_pos = queryFeaturePositions[query_ftr_idx];
-		double query_tol = queryFeatureTolerances[query_ftr_idx];
+		const Math::Vector3D& query_pos = currQuery->featurePositions[query_ftr_idx];
+		double query_tol = currQuery->featureTolerances[query_ftr_idx];
 
-		const FeatureList& db_ftr_list = dbFeaturesByType[queryMandFeatureTypes[i]];
+		const FeatureList& db_ftr_list = dbFeaturesByType[currQuery->mandFeatureTypes[i]];
 		bool match = false;
 
 		for (FeatureList::const_iterator db_ftr_it = db_ftr_list.begin(), db_ftr_end = db_ftr_list.end(); db_ftr_it != db_ftr_end && !match; ++db_ftr_it) {
@@ -500,7 +638,7 @@ bool Pharm::ScreeningProcessorImpl::checkGeomAlignment()
 			if (length(tmp) > query_tol)
 				continue;
 
-			const FeatureList& query_ftr_list = queryMandFeatures[i];
+			const FeatureList& query_ftr_list = currQuery->mandFeatures[i];
 
 			for (FeatureList::const_iterator ftr_it = query_ftr_list.begin(), ftr_end = query_ftr_list.end(); ftr_it != ftr_end; ++ftr_it) {
 				if (featureGeomMatchFunction(**ftr_it, db_ftr, xform)) {
@@ -514,57 +652,140 @@ bool Pharm::ScreeningProcessorImpl::checkGeomAlignment()
 			num_missing++;
 
 			if (num_missing > maxOmittedFeatures)
-				return false;
+				return timer.record(false);
 
 		} else {
 			num_matches++;
 
 			if (num_matches >= min_num_matches)
-				return true;
+				return timer.record(true);
 		}
 	}
 
-	return true;
+	return timer.record(true);
 }
 
 bool Pharm::ScreeningProcessorImpl::checkXVolumeClashes(std::size_t mol_idx, std::size_t conf_idx)
 {
-	if (!checkXVolumes || xVolumeIndices.empty())
+	if (!checkXVolumes || currQuery->xVolumeIndices.empty())
 		return true;
 
-	loadMolecule(mol_idx);
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::XVOLUME_CLASH_CHECK, activeStageTimer);
 
-	if (atomVdWRadii.empty())
-		for (Chem::BasicMolecule::ConstAtomIterator it = dbMolecule.getAtomsBegin(), 
-				 end = dbMolecule.getAtomsEnd(); it != end; ++it)
-			atomVdWRadii.push_back(Chem::AtomDictionary::getVdWRadius(getType(*it)) * VDW_RADIUS_FACTOR);
+	loadAtomClashData(mol_idx, conf_idx);
 
-	if (atomCoordinates.isEmpty())
-		getConformation(dbMolecule, conf_idx, atomCoordinates);
+	// the alignment transform is a rigid body transformation - instead of transforming all atom positions, the 
+	// exclusion volume centers get mapped into the frame of the database molecule by means of the inverse transform
 
-	const Math::Matrix4D& xform = pharmAlignment.getTransform();
-	Math::Vector3D al_pos;
+	const Math::Matrix4D& xform = currQuery->alignment.getTransform();
+	Math::Vector3D xvol_pos;
 	Math::Vector3D tmp;
 
+	std::size_t num_atoms = atomClashRadii.size();
+
+	if (num_atoms == 0)
+		return timer.record(true);
+
+	std::size_t num_x_vols = currQuery->xVolumeIndices.size();
+
+	for (std::size_t i = 0; i < num_x_vols; i++) {
+		std::size_t xvol_idx = currQuery->xVolumeIndices[i];
+		const Math::Vector3D& pos = currQuery->featurePositions[xvol_idx];
+		double tol = currQuery->featureTolerances[xvol_idx];
+
+		for (std::size_t j = 0; j < 3; j++)
+			xvol_pos[j] = xform(0, j) * (pos[0] - xform(0, 3)) + xform(1, j) * (pos[1] - xform(1, 3)) + xform(2, j) * (pos[2] - xform(2, 3));
+
+		tmp.assign(xvol_pos - atomBSphereCenter);
+
+		if (length(tmp) >= (atomBSphereRadius + tol))
+			continue;
+
+		const double* x_coords = &atomXCoords[0];
+		const double* y_coords = &atomYCoords[0];
+		const double* z_coords = &atomZCoords[0];
+		const double* radii = &atomClashRadii[0];
+		double xv_x = xvol_pos[0];
+		double xv_y = xvol_pos[1];
+		double xv_z = xvol_pos[2];
+		bool clash = false;
+
+		for (std::size_t j = 0; j < num_atoms; j++) {
+			double dx = x_coords[j] - xv_x;
+			double dy = y_coords[j] - xv_y;
+			double dz = z_coords[j] - xv_z;
+			double min_dist = radii[j] + tol;
+
+			clash |= ((dx * dx + dy * dy + dz * dz) < min_dist * min_dist);
+		}
+
+		if (clash)
+			return timer.record(false);
+	}
+
+	return timer.record(true);
+}
+
+void Pharm::ScreeningProcessorImpl::loadAtomClashData(std::size_t mol_idx, std::size_t conf_idx)
+{
+	if (!initAtomClashData)
+		return;
+
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::ATOM_COORDINATES_LOADING, activeStageTimer);
+
+	initAtomClashData = false;
+	timer.record(true);
+
+	if (!dbAccessor->getAtomCoordinates(loadedPharmIndex, atomCoordinates, atomVdWRadii)) {
+		loadMolecule(mol_idx);
+
+		getConformation(dbMolecule, conf_idx, atomCoordinates);
+
+		atomVdWRadii.clear();
+
+		for (Chem::BasicMolecule::ConstAtomIterator it = dbMolecule.getAtomsBegin(), 
+				 end = dbMolecule.getAtomsEnd(); it != end; ++it)
+			atomVdWRadii.addElement(Chem::AtomDictionary::getVdWRadius(getType(*it)));
+	}
+
 	std::size_t num_atoms = atomCoordinates.getSize();
-	std::size_t num_x_vols = xVolumeIndices.size();
+
+	atomXCoords.resize(num_atoms);
+	atomYCoords.resize(num_atoms);
+	atomZCoords.resize(num_atoms);
+	atomClashRadii.resize(num_atoms);
+
+	atomBSphereCenter.clear();
 
 	for (std::size_t i = 0; i < num_atoms; i++) {
-		al_pos.assign(range(prod(xform, homog(atomCoordinates[i])), 0, 3));
+		const Math::Vector3D& pos = atomCoordinates[i];
 
-		for (std::size_t j = 0; j < num_x_vols; j++) {
-			tmp.assign(al_pos - queryFeaturePositions[xVolumeIndices[j]]);
+		atomXCoords[i] = pos[0];
+		atomYCoords[i] = pos[1];
+		atomZCoords[i] = pos[2];
+		atomClashRadii[i] = atomVdWRadii[i] * VDW_RADIUS_FACTOR;
 
-			if (length(tmp) < (queryFeatureTolerances[xVolumeIndices[j]] + atomVdWRadii[i]))
-				return false;
-		}
+		atomBSphereCenter.plusAssign(pos);
 	}
 
-	return true;
+	if (num_atoms > 0)
+		atomBSphereCenter /= num_atoms;
+
+	atomBSphereRadius = 0.0;
+
+	for (std::size_t i = 0; i < num_atoms; i++) {
+		Math::Vector3D tmp(atomCoordinates[i] - atomBSphereCenter);
+
+		atomBSphereRadius = std::max(atomBSphereRadius, length(tmp) + atomClashRadii[i]);
+	}
 }
 
 double Pharm::ScreeningProcessorImpl::calcScore(const SearchHit& hit)
 {
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::SCORING, activeStageTimer);
+
+	timer.record(true);
+
 	if (!scoringFunction)
 		return 0.0;
 
@@ -575,12 +796,12 @@ double Pharm::ScreeningProcessorImpl::calcScore(const SearchHit& hit)
 
 bool Pharm::ScreeningProcessorImpl::checkTopologicalMapping(const FeaturePairList& mapping) const
 {
-	if (alignedQueryOptFeatures.empty())
+	if (currQuery->alignedOptFeatures.empty())
 		return true;
 
 	std::size_t num_missing = 0;
 
-	for (FeatureList::const_iterator it = alignedQueryMandFeatures.begin(), end = alignedQueryMandFeatures.end(); it != end; ++it)
+	for (FeatureList::const_iterator it = currQuery->alignedMandFeatures.begin(), end = currQuery->alignedMandFeatures.end(); it != end; ++it)
 		if (!mapping.getValue(*it)) {
 			num_missing++;
 
@@ -596,7 +817,9 @@ void Pharm::ScreeningProcessorImpl::loadMolecule(std::size_t mol_idx)
 	if (mol_idx == loadedMolIndex)
 		return;
 
-	atomVdWRadii.clear();
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::MOLECULE_LOADING, activeStageTimer);
+
+	timer.record(true);
 
 	dbAccessor->getMolecule(mol_idx, dbMolecule);
 
@@ -608,9 +831,13 @@ void Pharm::ScreeningProcessorImpl::loadPharmacophore(std::size_t pharm_idx)
 	if (pharm_idx == loadedPharmIndex)
 		return;
 
-	atomCoordinates.clear();
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::PHARMACOPHORE_LOADING, activeStageTimer);
+
+	timer.record(true);
+	initAtomClashData = true;
 	dbFeaturePositions.clear();
 	initDBFeaturesByType = true;
+	initDB2PointPharmSet = true;
 
 	dbAccessor->getPharmacophore(pharm_idx, dbPharmacophore);
 
@@ -620,14 +847,14 @@ void Pharm::ScreeningProcessorImpl::loadPharmacophore(std::size_t pharm_idx)
 bool Pharm::ScreeningProcessorImpl::processHit(const SearchHit& hit, double score)
 {
 	if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF) {
-		if (!std::isnan(bestConfAlmntScore) && score <= bestConfAlmntScore)
+		if (!std::isnan(currQuery->bestConfAlmntScore) && score <= currQuery->bestConfAlmntScore)
 			return true;
 
-		bestConfAlmntScore = score;
-		bestConfAlmntTransform = hit.getHitAlignmentTransform();
-		bestConfAlmntMolIdx = hit.getHitMoleculeIndex();
-		bestConfAlmntConfIdx = hit.getHitConformationIndex();
-		bestConfAlmntPharmIdx = hit.getHitPharmacophoreIndex();
+		currQuery->bestConfAlmntScore = score;
+		currQuery->bestConfAlmntTransform = hit.getHitAlignmentTransform();
+		currQuery->bestConfAlmntMolIdx = hit.getHitMoleculeIndex();
+		currQuery->bestConfAlmntConfIdx = hit.getHitConformationIndex();
+		currQuery->bestConfAlmntPharmIdx = hit.getHitPharmacophoreIndex();
 		
 		return true;
 	} 
@@ -637,13 +864,16 @@ bool Pharm::ScreeningProcessorImpl::processHit(const SearchHit& hit, double scor
 
 bool Pharm::ScreeningProcessorImpl::reportHit(const SearchHit& hit, double score)
 {
+	ScreeningStageTimer timer(getStatisticsPointer(), ScreeningStatistics::HIT_REPORTING, activeStageTimer);
+
+	timer.record(true);
 	numHits++;
 
 	if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF) {
-		molHitSet.set(hit.getHitMoleculeIndex());
+		currQuery->molHitSet.set(hit.getHitMoleculeIndex());
 
 	} else if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF) 
-		bestConfAlmntScore = NAN_SCORE;
+		currQuery->bestConfAlmntScore = NAN_SCORE;
 
 	if (!hitCallback)
 		return true;
@@ -656,11 +886,26 @@ bool Pharm::ScreeningProcessorImpl::reportHit(const SearchHit& hit, double score
 
 const Math::Vector3D& Pharm::ScreeningProcessorImpl::getFeatureCoordinates(const Feature& ftr)
 {
-	if (&ftr.getPharmacophore() == queryPharmacophore)
-		return queryFeaturePositions[ftr.getIndex()];
+	if (&ftr.getPharmacophore() == currQuery->pharmacophore)
+		return currQuery->featurePositions[ftr.getIndex()];
 
 	if (dbFeaturePositions.isEmpty())
 		get3DCoordinates(dbPharmacophore, dbFeaturePositions);
 
 	return dbFeaturePositions[ftr.getIndex()];
 }
+
+Pharm::ScreeningStatistics* Pharm::ScreeningProcessorImpl::getStatisticsPointer()
+{
+	return (collectStats ? &statistics : 0);
+}
+
+Pharm::ScreeningProcessorImpl::QueryData::QueryData(ScreeningProcessorImpl& impl):
+	pharmacophore(0), index(0), alignment(true), minNum2PointPharmMatches(0), bestConfAlmntMolIdx(0),
+	bestConfAlmntConfIdx(0), bestConfAlmntPharmIdx(0), bestConfAlmntScore(NAN_SCORE)
+{
+	alignment.setTopAlignmentConstraintFunction(
+		boost::bind(&ScreeningProcessorImpl::checkTopologicalMapping, &impl, _1));
+	alignment.setEntity3DCoordinatesFunction(
+		boost::bind(&ScreeningProcessorImpl::getFeatureCoordinates, &impl, _1));
+}
@@ -32,8 +32,10 @@
 
 #include <boost/iterator/indirect_iterator.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
 #include "CDPL/Pharm/PharmacophoreAlignment.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Pharm/BasicPharmacophore.hpp"
@@ -46,6 +48,7 @@
 #include "CDPL/Math/Vector.hpp"
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Util/BitSet.hpp"
+#include "CDPL/Util/Array.hpp"
 
 
 namespace CDPL 
@@ -56,6 +59,7 @@ namespace CDPL
 	
 		class ScreeningDBAccessor;
 		class FeatureMapping;
+		class ScreeningStageTimer;
 
 		class ScreeningProcessorImpl
 		{
@@ -64,6 +68,7 @@ namespace CDPL
 			typedef ScreeningProcessor::ProgressCallbackFunction ProgressCallbackFunction;
 			typedef ScreeningProcessor::ScoringFunction ScoringFunction;
 			typedef ScreeningProcessor::SearchHit SearchHit;
+			typedef ScreeningProcessor::FeatureContainerList FeatureContainerList;
 
 		public:
 			ScreeningProcessorImpl(ScreeningProcessor& parent, ScreeningDBAccessor& db_acc);
@@ -88,6 +93,10 @@ namespace CDPL
 
 			bool bestAlignmentsSeeked() const;
 
+			void pruneAlignmentSearch(bool prune);
+
+			bool alignmentSearchPruned() const;
+
 			void setHitCallback(const HitCallbackFunction& func);
 
 			const HitCallbackFunction& getHitCallback() const;
@@ -100,8 +109,18 @@ namespace CDPL
 
 			const ScoringFunction& getScoringFunction() const;
 
+			void enableStatistics(bool enable);
+
+			bool statisticsEnabled() const;
+
+			const ScreeningStatistics& getStatistics() const;
+
+			void clearStatistics();
+
 			std::size_t searchDB(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx);
 
+			std::size_t searchDB(const FeatureContainerList& queries, std::size_t mol_start_idx, std::size_t mol_end_idx);
+
 		private:
 			typedef std::vector<QueryTwoPointPharmacophore> TwoPointPharmacophoreList;
 			typedef std::vector<const Feature*> FeatureList;
@@ -111,6 +130,7 @@ namespace CDPL
 			typedef std::vector<unsigned int> FeatureTypeTable;
 			typedef std::vector<std::size_t> IndexList;
 			typedef std::vector<double> RadiusTable;
+			typedef std::vector<double> CoordinatesArray;
 			typedef boost::unordered_map<unsigned int, FeatureList> TypeToFeatureListMap;
 
 			typedef TwoPointPharmacophoreGenerator<TwoPointPharmacophore> DB2PointPharmGenerator;
@@ -118,6 +138,39 @@ namespace CDPL
 
 			typedef boost::indirect_iterator<FeatureList::const_iterator, const Feature> FeatureListIterator;
 
+			struct QueryData
+			{
+
+				QueryData(ScreeningProcessorImpl& impl);
+
+				const FeatureContainer*   pharmacophore;
+				std::size_t               index;
+				PharmacophoreAlignment    alignment;
+				FeatureTypeHistogram      featureCounts; 
+				TwoPointPharmacophoreList twoPointPharmList;
+				std::size_t               minNum2PointPharmMatches;
+				FeatureMatrix             mandFeatures;
+				FeatureMatrix             optFeatures;
+				FeatureList               alignedMandFeatures;
+				FeatureList               alignedOptFeatures;
+				FeatureTypeTable          mandFeatureTypes;
+				IndexList                 xVolumeIndices;
+				RadiusTable               featureTolerances;
+				Math::Vector3DArray       featurePositions;
+				FeatureTypeHistogram      scoredFeatureCounts;
+				std::size_t               numScoredFeatures;
+				double                    maxFeatureScore;
+				Util::BitSet              molHitSet;
+				Math::Matrix4D            bestConfAlmntTransform;
+				std::size_t               bestConfAlmntMolIdx;
+				std::size_t               bestConfAlmntConfIdx;
+				std::size_t               bestConfAlmntPharmIdx;
+				double                    bestConfAlmntScore;
+			};
+
+			typedef boost::shared_ptr<QueryData> QueryDataPtr;
+			typedef std::vector<QueryDataPtr> QueryDataList;
+
 			struct IndexPair2ndCmpFunc
 			{
 
@@ -126,19 +179,25 @@ namespace CDPL
 				}
 			};
 		
-			void prepareDBSearch(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx);
+			void prepareDBSearch(const FeatureContainerList& queries, std::size_t mol_start_idx, std::size_t mol_end_idx);
 
-			void initQueryData(const FeatureContainer& query);
+			void initQueryData(QueryData& query_data, const FeatureContainer& query);
 			void initPharmIndexList(std::size_t mol_start_idx, std::size_t mol_end_idx);
+			void initMaxAlignmentScore(QueryData& query_data) const;
+
+			double getMaxAlignmentScore(std::size_t pharm_idx) const;
+
+			bool reportBestConfAlignment(QueryData& query_data);
 
 			void insertFeature(const Feature& ftr, FeatureMatrix& ftr_mtx) const;
 
-			bool checkFeatureCounts(std::size_t pharm_idx) const;
+			bool checkFeatureCounts(std::size_t pharm_idx);
 			bool check2PointPharmacophores(std::size_t pharm_idx);
 			bool performAlignment(std::size_t pharm_idx, std::size_t mol_idx);
 
 			bool checkGeomAlignment();
 			bool checkXVolumeClashes(std::size_t mol_idx, std::size_t conf_idx);
+			void loadAtomClashData(std::size_t mol_idx, std::size_t conf_idx);
 
 			bool checkTopologicalMapping(const FeaturePairList& mapping) const;
 
@@ -149,6 +208,8 @@ namespace CDPL
 
 			const Math::Vector3D& getFeatureCoordinates(const Feature& ftr);
 
+			ScreeningStatistics* getStatisticsPointer();
+
 			bool processHit(const SearchHit& hit, double score);
 			bool reportHit(const SearchHit& hit, double score);
 
@@ -158,45 +219,41 @@ namespace CDPL
 			std::size_t                           maxOmittedFeatures;
 			bool                                  checkXVolumes;
 			bool                                  bestAlignments;
+			bool                                  pruneAlmntSearch;
 			HitCallbackFunction                   hitCallback;
 			ProgressCallbackFunction              progressCallback;
 			ScoringFunction                       scoringFunction;
 			FeatureGeometryMatchFunctor           featureGeomMatchFunction;
-			const FeatureContainer*               queryPharmacophore;
 			BasicPharmacophore                    dbPharmacophore;
 			Chem::BasicMolecule                   dbMolecule;
-			PharmacophoreAlignment                pharmAlignment;
 			Query2PointPharmGenerator             query2PointPharmGen;
 			DB2PointPharmGenerator                db2PointPharmGen;
-			FeatureTypeHistogram                  queryFeatureCounts; 
-			TwoPointPharmacophoreList             query2PointPharmList;
 			TwoPointPharmacophoreSet              db2PointPharmSet;
-			std::size_t                           minNum2PointPharmMatches;
-			FeatureMatrix                         queryMandFeatures;
-			FeatureMatrix                         queryOptFeatures;
-			FeatureList                           alignedQueryMandFeatures;
-			FeatureList                           alignedQueryOptFeatures;
-			FeatureTypeTable                      queryMandFeatureTypes;
-			IndexList                             xVolumeIndices;
+			bool                                  initDB2PointPharmSet;
 			Math::Vector3DArray                   atomCoordinates;
-			RadiusTable                           atomVdWRadii;
-			RadiusTable                           queryFeatureTolerances;
-			Math::Vector3DArray                   queryFeaturePositions;
+			Util::DArray                          atomVdWRadii;
+			CoordinatesArray                      atomXCoords;
+			CoordinatesArray                      atomYCoords;
+			CoordinatesArray                      atomZCoords;
+			RadiusTable                           atomClashRadii;
+			Math::Vector3D                        atomBSphereCenter;
+			double                                atomBSphereRadius;
+			bool                                  initAtomClashData;
 			Math::Vector3DArray                   dbFeaturePositions;
 			Math::Vector3DArray                   alignedDBFeaturePositions;
 			TypeToFeatureListMap                  dbFeaturesByType;
 			bool                                  initDBFeaturesByType;
 			IndexPairList                         pharmIndices;  
-			Util::BitSet                          molHitSet;
 			std::size_t                           numHits;
 			std::size_t                           loadedPharmIndex;
 			std::size_t                           loadedMolIndex;
 			Math::Matrix4D                        bestAlmntTransform;
-			Math::Matrix4D                        bestConfAlmntTransform;
-			std::size_t                           bestConfAlmntMolIdx;
-			std::size_t                           bestConfAlmntConfIdx;
-			std::size_t                           bestConfAlmntPharmIdx;
-			double                                bestConfAlmntScore;
+			QueryDataList                         queryData;
+			std::size_t                           numQueries;
+			QueryData*                            currQuery;
+			bool                                  collectStats;
+			ScreeningStatistics                   statistics;
+			ScreeningStageTimer*                  activeStageTimer;
 		};
     }
 }
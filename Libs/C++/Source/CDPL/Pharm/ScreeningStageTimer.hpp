@@ -0,0 +1,134 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ScreeningStageTimer.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::Pharm::ScreeningStageTimer.
+ */
+
+#ifndef CDPL_PHARM_SCREENINGSTAGETIMER_HPP
+#define CDPL_PHARM_SCREENINGSTAGETIMER_HPP
+
+#include "CDPL/Config.hpp"
+
+#ifdef HAVE_BOOST_CHRONO
+# include <boost/chrono/chrono.hpp>
+# include <boost/chrono/thread_clock.hpp>
+#endif // HAVE_BOOST_CHRONO
+
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+		/*
+		 * Adds the wall clock and thread CPU time elapsed between construction and destruction to the given stage.
+		 * The times of timers that get started while the timer is the active one are subtracted so that each stage
+		 * only gets charged with its exclusive time. Does nothing (and does not query any clock) if no statistics
+		 * object is specified. Without Boost.Chrono only the pass/reject counts are recorded.
+		 */
+		class ScreeningStageTimer
+		{
+
+		public:
+			ScreeningStageTimer(ScreeningStatistics* stats, ScreeningStatistics::Stage stage, ScreeningStageTimer*& active_timer):
+				statistics(stats), stage(stage), activeTimer(active_timer), parentTimer(active_timer),
+				nestedWallTime(0.0), nestedCPUTime(0.0) {
+
+				if (!stats)
+					return;
+
+				activeTimer = this;
+#ifdef HAVE_BOOST_CHRONO
+				wallStartTime = WallClock::now();
+# ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+				cpuStartTime = CPUClock::now();
+# endif // BOOST_CHRONO_HAS_THREAD_CLOCK
+#endif // HAVE_BOOST_CHRONO
+			}
+
+			~ScreeningStageTimer() {
+				if (!statistics)
+					return;
+
+				activeTimer = parentTimer;
+
+				double wall_time = 0.0;
+				double cpu_time = 0.0;
+#ifdef HAVE_BOOST_CHRONO
+# ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+				cpu_time = boost::chrono::duration<double>(CPUClock::now() - cpuStartTime).count();
+# endif // BOOST_CHRONO_HAS_THREAD_CLOCK
+				wall_time = boost::chrono::duration<double>(WallClock::now() - wallStartTime).count();
+#endif // HAVE_BOOST_CHRONO
+
+				statistics->addTime(stage, wall_time - nestedWallTime, cpu_time - nestedCPUTime);
+
+				if (parentTimer) {
+					parentTimer->nestedWallTime += wall_time;
+					parentTimer->nestedCPUTime += cpu_time;
+				}
+			}
+
+			bool record(bool passed) {
+				if (statistics)
+					statistics->addResult(stage, passed);
+
+				return passed;
+			}
+
+		private:
+			ScreeningStageTimer(const ScreeningStageTimer&);
+
+			ScreeningStageTimer& operator=(const ScreeningStageTimer&);
+
+#ifdef HAVE_BOOST_CHRONO
+			typedef boost::chrono::steady_clock WallClock;
+# ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+			typedef boost::chrono::thread_clock CPUClock;
+# endif // BOOST_CHRONO_HAS_THREAD_CLOCK
+#endif // HAVE_BOOST_CHRONO
+
+			ScreeningStatistics*        statistics;
+			ScreeningStatistics::Stage  stage;
+			ScreeningStageTimer*&       activeTimer;
+			ScreeningStageTimer*        parentTimer;
+			double                      nestedWallTime;
+			double                      nestedCPUTime;
+#ifdef HAVE_BOOST_CHRONO
+			WallClock::time_point       wallStartTime;
+# ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+			CPUClock::time_point        cpuStartTime;
+# endif // BOOST_CHRONO_HAS_THREAD_CLOCK
+#endif // HAVE_BOOST_CHRONO
+		};
+    }
+}
+
+#endif // CDPL_PHARM_SCREENINGSTAGETIMER_HPP
@@ -0,0 +1,150 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/*
+ * ScreeningStatistics.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+	const char* STAGE_NAMES[] = {
+		"Pharmacophore loading",
+		"Molecule loading",
+		"Atom coordinates loading",
+		"Feature count check",
+		"Two-point pharmacophore check",
+		"Alignment",
+		"Geometry check",
+		"X-volume clash check",
+		"Scoring",
+		"Hit reporting"
+	};
+}
+
+
+Pharm::ScreeningStatistics::ScreeningStatistics()
+{
+	clear();
+}
+
+std::size_t Pharm::ScreeningStatistics::getNumPassed(Stage stage) const
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	return numPassed[stage];
+}
+
+std::size_t Pharm::ScreeningStatistics::getNumRejected(Stage stage) const
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	return numRejected[stage];
+}
+
+double Pharm::ScreeningStatistics::getWallTime(Stage stage) const
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	return wallTimes[stage];
+}
+
+double Pharm::ScreeningStatistics::getCPUTime(Stage stage) const
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	return cpuTimes[stage];
+}
+
+double Pharm::ScreeningStatistics::getTotalWallTime() const
+{
+	return std::accumulate(wallTimes, wallTimes + NUM_STAGES, 0.0);
+}
+
+double Pharm::ScreeningStatistics::getTotalCPUTime() const
+{
+	return std::accumulate(cpuTimes, cpuTimes + NUM_STAGES, 0.0);
+}
+
+void Pharm::ScreeningStatistics::addResult(Stage stage, bool passed, std::size_t num)
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	if (passed)
+		numPassed[stage] += num;
+	else
+		numRejected[stage] += num;
+}
+
+void Pharm::ScreeningStatistics::addTime(Stage stage, double wall_secs, double cpu_secs)
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	wallTimes[stage] += wall_secs;
+	cpuTimes[stage] += cpu_secs;
+}
+
+void Pharm::ScreeningStatistics::clear()
+{
+	std::fill(numPassed, numPassed + NUM_STAGES, std::size_t(0));
+	std::fill(numRejected, numRejected + NUM_STAGES, std::size_t(0));
+	std::fill(wallTimes, wallTimes + NUM_STAGES, 0.0);
+	std::fill(cpuTimes, cpuTimes + NUM_STAGES, 0.0);
+}
+
+Pharm::ScreeningStatistics& Pharm::ScreeningStatistics::operator+=(const ScreeningStatistics& stats)
+{
+	for (std::size_t i = 0; i < NUM_STAGES; i++) {
+		numPassed[i] += stats.numPassed[i];
+		numRejected[i] += stats.numRejected[i];
+		wallTimes[i] += stats.wallTimes[i];
+		cpuTimes[i] += stats.cpuTimes[i];
+	}
+
+	return *this;
+}
+
+const char* Pharm::ScreeningStatistics::getStageName(Stage stage)
+{
+	if (stage >= NUM_STAGES)
+		throw Base::IndexError("ScreeningStatistics: stage out of bounds");
+
+	return STAGE_NAMES[stage];
+}
@@ -0,0 +1,261 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ShardedScreeningDBAccessor.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "CDPL/Pharm/ShardedScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/Pharmacophore.hpp"
+#include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+Pharm::ShardedScreeningDBAccessor::ShardedScreeningDBAccessor():
+	firstSelShard(0), numSelShards(0)
+{}
+
+Pharm::ShardedScreeningDBAccessor::ShardedScreeningDBAccessor(const std::string& name):
+	firstSelShard(0), numSelShards(0)
+{
+	open(name);
+}
+	
+Pharm::ShardedScreeningDBAccessor::~ShardedScreeningDBAccessor() {}
+
+void Pharm::ShardedScreeningDBAccessor::open(const std::string& name)
+{
+	std::ifstream is(name.c_str());
+
+	if (!is)
+		throw Base::IOError("ShardedScreeningDBAccessor: could not open manifest file '" + name + '\'');
+
+	ScreeningDBShardManifest new_manifest;
+
+	new_manifest.read(is);
+
+	close();
+
+	boost::filesystem::path manifest_dir = boost::filesystem::path(name).parent_path();
+
+	for (std::size_t i = 0; i < new_manifest.getNumShards(); i++) {
+		boost::filesystem::path shard_path(new_manifest.getShardFileName(i));
+
+		if (shard_path.is_relative())
+			shard_path = manifest_dir / shard_path;
+
+		manifest.addShard(shard_path.string(), new_manifest.getShardNumMolecules(i));
+	}
+
+	dbName = name;
+	numSelShards = manifest.getNumShards();
+
+	shardAccessors.resize(numSelShards);
+}
+
+void Pharm::ShardedScreeningDBAccessor::close()
+{
+	dbName.clear();
+	manifest.clear();
+	shardAccessors.clear();
+	pharmOffsets.clear();
+
+	firstSelShard = 0;
+	numSelShards = 0;
+}
+
+const std::string& Pharm::ShardedScreeningDBAccessor::getDatabaseName() const
+{
+	return dbName;
+}
+
+const Pharm::ScreeningDBShardManifest& Pharm::ShardedScreeningDBAccessor::getManifest() const
+{
+	return manifest;
+}
+
+void Pharm::ShardedScreeningDBAccessor::selectShards(std::size_t first_idx, std::size_t num_shards)
+{
+	if (first_idx > manifest.getNumShards() || num_shards > (manifest.getNumShards() - first_idx))
+		throw Base::IndexError("ShardedScreeningDBAccessor: shard range out of bounds");
+
+	firstSelShard = first_idx;
+	numSelShards = num_shards;
+
+	pharmOffsets.clear();
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getFirstSelectedShard() const
+{
+	return firstSelShard;
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getNumSelectedShards() const
+{
+	return numSelShards;
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getNumMolecules() const
+{
+	return manifest.getNumMolecules();
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getNumPharmacophores() const
+{
+	initPharmacophoreOffsets();
+
+	return pharmOffsets.back();
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getNumPharmacophores(std::size_t mol_idx) const
+{
+	return getMoleculeShardAccessor(mol_idx).getNumPharmacophores(mol_idx);
+}
+
+void Pharm::ShardedScreeningDBAccessor::getMolecule(std::size_t mol_idx, Chem::Molecule& mol, bool overwrite) const
+{
+	getMoleculeShardAccessor(mol_idx).getMolecule(mol_idx, mol, overwrite);
+}
+
+void Pharm::ShardedScreeningDBAccessor::getPharmacophore(std::size_t pharm_idx, Pharmacophore& pharm, bool overwrite) const
+{
+	std::size_t shard_idx;
+
+	getPharmacophoreShardAccessor(pharm_idx, shard_idx).getPharmacophore(pharm_idx, pharm, overwrite);
+}
+
+void Pharm::ShardedScreeningDBAccessor::getPharmacophore(std::size_t mol_idx, std::size_t mol_conf_idx, Pharmacophore& pharm, bool overwrite) const
+{
+	getMoleculeShardAccessor(mol_idx).getPharmacophore(mol_idx, mol_conf_idx, pharm, overwrite);
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getMoleculeIndex(std::size_t pharm_idx) const
+{
+	std::size_t shard_idx;
+	const PSDScreeningDBAccessor& shard_acc = getPharmacophoreShardAccessor(pharm_idx, shard_idx);
+
+	return (shard_acc.getMoleculeIndex(pharm_idx) + manifest.getShardMoleculeOffset(shard_idx));
+}
+
+std::size_t Pharm::ShardedScreeningDBAccessor::getConformationIndex(std::size_t pharm_idx) const
+{
+	std::size_t shard_idx;
+
+	return getPharmacophoreShardAccessor(pharm_idx, shard_idx).getConformationIndex(pharm_idx);
+}
+
+const Pharm::FeatureTypeHistogram& Pharm::ShardedScreeningDBAccessor::getFeatureCounts(std::size_t pharm_idx) const
+{
+	std::size_t shard_idx;
+
+	return getPharmacophoreShardAccessor(pharm_idx, shard_idx).getFeatureCounts(pharm_idx);
+}
+
+const Pharm::FeatureTypeHistogram& Pharm::ShardedScreeningDBAccessor::getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const
+{
+	return getMoleculeShardAccessor(mol_idx).getFeatureCounts(mol_idx, mol_conf_idx);
+}
+
+bool Pharm::ShardedScreeningDBAccessor::getAtomCoordinates(std::size_t pharm_idx, Math::Vector3DArray& coords, Util::DArray& vdw_radii) const
+{
+	std::size_t shard_idx;
+
+	return getPharmacophoreShardAccessor(pharm_idx, shard_idx).getAtomCoordinates(pharm_idx, coords, vdw_radii);
+}
+
+const Pharm::PSDScreeningDBAccessor& Pharm::ShardedScreeningDBAccessor::getShardAccessor(std::size_t shard_idx) const
+{
+	ShardAccessorPtr& acc_ptr = shardAccessors[shard_idx];
+
+	if (!acc_ptr) {
+		const std::string& file_name = manifest.getShardFileName(shard_idx);
+		ShardAccessorPtr new_acc_ptr(new PSDScreeningDBAccessor(file_name));
+
+		if (new_acc_ptr->getNumMolecules() != manifest.getShardNumMolecules(shard_idx))
+			throw Base::IOError("ShardedScreeningDBAccessor: number of molecules in shard database '" + file_name + 
+								"' does not match the manifest (" + boost::lexical_cast<std::string>(new_acc_ptr->getNumMolecules()) + 
+								" instead of " + boost::lexical_cast<std::string>(manifest.getShardNumMolecules(shard_idx)) + ')');
+
+		acc_ptr = new_acc_ptr;
+	}
+
+	return *acc_ptr;
+}
+
+const Pharm::PSDScreeningDBAccessor& Pharm::ShardedScreeningDBAccessor::getMoleculeShardAccessor(std::size_t& mol_idx) const
+{
+	std::size_t shard_idx = manifest.findShard(mol_idx);
+
+	mol_idx -= manifest.getShardMoleculeOffset(shard_idx);
+
+	return getShardAccessor(shard_idx);
+}
+
+const Pharm::PSDScreeningDBAccessor& Pharm::ShardedScreeningDBAccessor::getPharmacophoreShardAccessor(std::size_t& pharm_idx, std::size_t& shard_idx) const
+{
+	initPharmacophoreOffsets();
+
+	if (pharm_idx >= pharmOffsets.back())
+		throw Base::IndexError("ShardedScreeningDBAccessor: pharmacophore index out of bounds");
+
+	// find the last selected shard with a pharmacophore offset <= pharm_idx (is never empty)
+
+	std::size_t lo = 0, hi = numSelShards;
+
+	while (hi - lo > 1) {
+		std::size_t mid = (lo + hi) / 2;
+
+		if (pharm_idx < pharmOffsets[mid])
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	pharm_idx -= pharmOffsets[lo];
+	shard_idx = firstSelShard + lo;
+
+	return getShardAccessor(shard_idx);
+}
+
+void Pharm::ShardedScreeningDBAccessor::initPharmacophoreOffsets() const
+{
+	if (!pharmOffsets.empty())
+		return;
+
+	IndexArray offsets(1, 0);
+
+	for (std::size_t i = 0; i < numSelShards; i++)
+		offsets.push_back(offsets.back() + getShardAccessor(firstSelShard + i).getNumPharmacophores());
+
+	pharmOffsets.swap(offsets);
+}
@@ -0,0 +1,197 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * DefaultInteractionScoreGridSetCalculatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cmath>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/DefaultInteractionScoreGridSetCalculator.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Pharm/AttributedGridFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Grid/RegularGridSet.hpp"
+#include "CDPL/Math/AffineTransform.hpp"
+#include "CDPL/Math/Matrix.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	bool compareGridSets(const CDPL::Grid::DRegularGridSet& grid_set1, const CDPL::Grid::DRegularGridSet& grid_set2)
+	{
+		using namespace CDPL;
+
+		if (grid_set1.getSize() != grid_set2.getSize())
+			return false;
+
+		for (std::size_t i = 0; i < grid_set1.getSize(); i++) {
+			const Grid::DRegularGrid& grid1 = grid_set1[i];
+			const Grid::DRegularGrid& grid2 = grid_set2[i];
+
+			if (Pharm::getFeatureType(grid1) != Pharm::getFeatureType(grid2) ||
+				Pharm::getTargetFeatureType(grid1) != Pharm::getTargetFeatureType(grid2))
+				return false;
+
+			if (grid1.getNumElements() != grid2.getNumElements())
+				return false;
+
+			for (std::size_t j = 0; j < grid1.getNumElements(); j++)
+				if (std::abs(grid1(j) - grid2(j)) > 1.0e-10)
+					return false;
+		}
+
+		return true;
+	}
+
+	bool gridSetsDiffer(const CDPL::Grid::DRegularGridSet& grid_set1, const CDPL::Grid::DRegularGridSet& grid_set2)
+	{
+		for (std::size_t i = 0; i < grid_set1.getSize() && i < grid_set2.getSize(); i++)
+			for (std::size_t j = 0; j < grid_set1[i].getNumElements() && j < grid_set2[i].getNumElements(); j++)
+				if (grid_set1[i](j) != grid_set2[i](j))
+					return true;
+
+		return false;
+	}
+
+	void moveFeature(CDPL::Pharm::Feature& ftr, double dx, double dy, double dz)
+	{
+		using namespace CDPL;
+
+		Math::Vector3D pos = get3DCoordinates(ftr);
+
+		pos[0] += dx;
+		pos[1] += dy;
+		pos[2] += dz;
+
+		set3DCoordinates(ftr, pos);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(DefaultInteractionScoreGridSetCalculatorIncrementalTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 12);
+
+	BasicPharmacophore pharm;
+
+	for (std::size_t i = 0; i < mols.size(); i += 4) {
+		BasicPharmacophore mol_pharm;
+
+		TestUtils::generatePharmacophore(*mols[i], mol_pharm);
+
+		pharm += mol_pharm;
+	}
+
+	BOOST_CHECK(pharm.getNumFeatures() > 10);
+
+	Math::Vector3D ctr;
+
+	ctr.clear();
+
+	for (BasicPharmacophore::ConstFeatureIterator it = pharm.getFeaturesBegin(), end = pharm.getFeaturesEnd(); it != end; ++it)
+		ctr.plusAssign(get3DCoordinates(*it));
+
+	ctr /= pharm.getNumFeatures();
+
+	// a rotated grid checks that only the correct grid points get rescored for arbitrary grid orientations
+
+	Math::Matrix4D xform;
+
+	xform.assign(prod(Math::TranslationMatrix<double>(4, ctr[0], ctr[1], ctr[2]), Math::RotationMatrix<double>(4, 0.7, 0.3, -0.8, 0.52)));
+
+	for (int normalize = 0; normalize < 2; normalize++) {
+		DefaultInteractionScoreGridSetCalculator inc_calc(0.75, 0.6, 0.9, 26, 30, 20);
+		DefaultInteractionScoreGridSetCalculator full_calc(0.75, 0.6, 0.9, 26, 30, 20);
+
+		inc_calc.setCoordinatesTransform(xform);
+		inc_calc.normalizeScores(normalize);
+		inc_calc.enableIncrementalCalculation(true);
+
+		full_calc.setCoordinatesTransform(xform);
+		full_calc.normalizeScores(normalize);
+
+		BasicPharmacophore curr_pharm(pharm);
+		Grid::DRegularGridSet inc_grids;
+		Grid::DRegularGridSet full_grids;
+		Grid::DRegularGridSet prev_grids;
+
+		inc_calc.calculate(curr_pharm, inc_grids);
+		full_calc.calculate(curr_pharm, full_grids);
+
+		BOOST_CHECK(inc_grids.getSize() > 0);
+		BOOST_CHECK(compareGridSets(inc_grids, full_grids));
+
+		for (std::size_t i = 0; i < 4; i++) {
+			switch (i) {
+
+				case 0:
+					moveFeature(curr_pharm.getFeature(1), 1.5, -0.5, 2.0);
+					break;
+
+				case 1:
+					curr_pharm.removeFeature(3);
+					break;
+
+				case 2: {
+					Feature& ftr = curr_pharm.addFeature();
+
+					ftr = curr_pharm.getFeature(0);
+					moveFeature(ftr, -2.0, 1.0, 0.5);
+					break;
+				}
+
+				default:
+					setType(curr_pharm.getFeature(2), getType(curr_pharm.getFeature(2)) == FeatureType::HYDROPHOBIC ? 
+							FeatureType::AROMATIC : FeatureType::HYDROPHOBIC);
+					moveFeature(curr_pharm.getFeature(curr_pharm.getNumFeatures() - 1), 0.0, 0.0, -3.0);
+			}
+
+			prev_grids.clear();
+
+			for (std::size_t j = 0; j < full_grids.getSize(); j++)
+				prev_grids.addElement(Grid::DRegularGrid::SharedPointer(new Grid::DRegularGrid(full_grids[j])));
+
+			inc_calc.calculate(curr_pharm, inc_grids);
+
+			full_grids.clear();
+			full_calc.calculate(curr_pharm, full_grids);
+
+			BOOST_CHECK(gridSetsDiffer(prev_grids, full_grids));
+			BOOST_CHECK(compareGridSets(inc_grids, full_grids));
+		}
+	}
+}
@@ -0,0 +1,144 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * InteractionAnalyzerTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Pharm/InteractionAnalyzer.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureMapping.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Math/Vector.hpp"
+
+
+namespace
+{
+
+	bool checkDistance(const CDPL::Pharm::Feature& ftr1, const CDPL::Pharm::Feature& ftr2, double max_dist)
+	{
+		return (CDPL::Math::length(CDPL::Chem::get3DCoordinates(ftr1) - CDPL::Chem::get3DCoordinates(ftr2)) <= max_dist);
+	}
+
+	void addFeatures(CDPL::Pharm::Pharmacophore& pharm, std::size_t num_ftrs, unsigned int seed)
+	{
+		using namespace CDPL;
+
+		for (std::size_t i = 0; i < num_ftrs; i++) {
+			Pharm::Feature& ftr = pharm.addFeature();
+			Math::Vector3D pos;
+
+			seed = seed * 1103515245 + 12345;
+			pos[0] = (seed >> 8) % 2000 / 100.0;
+			seed = seed * 1103515245 + 12345;
+			pos[1] = (seed >> 8) % 2000 / 100.0;
+			seed = seed * 1103515245 + 12345;
+			pos[2] = (seed >> 8) % 2000 / 100.0;
+
+			Pharm::setType(ftr, 1 + i % 3);
+			Chem::set3DCoordinates(ftr, pos);
+		}
+	}
+
+	typedef std::vector<std::pair<const CDPL::Pharm::Feature*, const CDPL::Pharm::Feature*> > InteractionList;
+
+	void getInteractions(const CDPL::Pharm::FeatureMapping& mapping, InteractionList& iactions)
+	{
+		iactions.assign(mapping.getEntriesBegin(), mapping.getEntriesEnd());
+	}
+
+	std::size_t compareResults(const CDPL::Pharm::InteractionAnalyzer& analyzer, const CDPL::Pharm::Pharmacophore& pharm1, 
+							   const CDPL::Pharm::Pharmacophore& pharm2)
+	{
+		using namespace CDPL;
+
+		Pharm::FeatureMapping mapping;
+		InteractionList exhaustive_iactions;
+		InteractionList indexed_iactions;
+
+		analyzer.analyze(pharm1, pharm2, mapping);
+		getInteractions(mapping, exhaustive_iactions);
+
+		analyzer.analyze(pharm1, mapping);
+		getInteractions(mapping, indexed_iactions);
+
+		BOOST_CHECK(exhaustive_iactions == indexed_iactions);
+
+		return exhaustive_iactions.size();
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(InteractionAnalyzerTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+
+	BasicPharmacophore pharm1;
+	BasicPharmacophore pharm2;
+
+	addFeatures(pharm1, 40, 1);
+	addFeatures(pharm2, 300, 2);
+
+	InteractionAnalyzer analyzer;
+	FeatureMapping mapping;
+
+	BOOST_CHECK_THROW(analyzer.analyze(pharm1, mapping), Base::OperationFailed);
+
+	analyzer.setConstraintFunction(1, 1, boost::bind(&checkDistance, _1, _2, 3.0), 3.0);
+	analyzer.prepare(pharm2);
+
+	BOOST_CHECK(compareResults(analyzer, pharm1, pharm2) > 0);
+
+	// constraint functions changed after prepare() must be honored by the indexed analysis
+
+	analyzer.setConstraintFunction(1, 2, boost::bind(&checkDistance, _1, _2, 4.0), 4.0);
+
+	std::size_t num_iactions = compareResults(analyzer, pharm1, pharm2);
+
+	analyzer.setConstraintFunction(3, 2, boost::bind(&checkDistance, _1, _2, 5.0), 5.0);
+
+	BOOST_CHECK(compareResults(analyzer, pharm1, pharm2) > num_iactions);
+
+	analyzer.setConstraintFunction(1, 1, boost::bind(&checkDistance, _1, _2, 8.0), 8.0);
+	compareResults(analyzer, pharm1, pharm2);
+
+	analyzer.setConstraintFunction(2, 3, boost::bind(&checkDistance, _1, _2, 6.0));
+	compareResults(analyzer, pharm1, pharm2);
+
+	analyzer.removeConstraintFunction(1, 1);
+	compareResults(analyzer, pharm1, pharm2);
+
+	analyzer.removeConstraintFunction(1, 2);
+	analyzer.removeConstraintFunction(3, 2);
+	analyzer.removeConstraintFunction(2, 3);
+
+	BOOST_CHECK(compareResults(analyzer, pharm1, pharm2) == 0);
+}
@@ -0,0 +1,176 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PSDScreeningDBCreatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+#include "CDPL/Util/Array.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	typedef std::vector<std::string> RecordList;
+
+	void getRecords(const std::string& db_name, RecordList& records)
+	{
+		using namespace CDPL;
+
+		Pharm::PSDScreeningDBAccessor db_acc(db_name);
+		Chem::BasicMolecule mol;
+		Pharm::BasicPharmacophore pharm;
+		Math::Vector3DArray coords;
+		Util::DArray vdw_radii;
+
+		records.clear();
+
+		for (std::size_t i = 0; i < db_acc.getNumPharmacophores(); i++) {
+			std::ostringstream oss;
+
+			oss.precision(17);
+
+			db_acc.getMolecule(db_acc.getMoleculeIndex(i), mol);
+
+			for (Chem::BasicMolecule::ConstAtomIterator it = mol.getAtomsBegin(), end = mol.getAtomsEnd(); it != end; ++it)
+				oss << getType(*it) << ' ';
+
+			oss << "| " << mol.getNumBonds() << " | " << db_acc.getConformationIndex(i) << " |";
+
+			db_acc.getPharmacophore(i, pharm);
+
+			for (Pharm::BasicPharmacophore::ConstFeatureIterator it = pharm.getFeaturesBegin(), end = pharm.getFeaturesEnd(); it != end; ++it) {
+				const Math::Vector3D& pos = get3DCoordinates(*it);
+
+				oss << ' ' << getType(*it) << ' ' << pos[0] << ' ' << pos[1] << ' ' << pos[2];
+			}
+
+			oss << " |";
+
+			const Pharm::FeatureTypeHistogram& ftr_cnts = db_acc.getFeatureCounts(i);
+
+			for (Pharm::FeatureTypeHistogram::ConstEntryIterator it = ftr_cnts.getEntriesBegin(), end = ftr_cnts.getEntriesEnd(); it != end; ++it)
+				oss << ' ' << it->first << ':' << it->second;
+
+			oss << " |";
+
+			BOOST_CHECK(db_acc.getAtomCoordinates(i, coords, vdw_radii));
+
+			for (std::size_t j = 0; j < coords.getSize(); j++)
+				oss << ' ' << coords[j][0] << ' ' << coords[j][1] << ' ' << coords[j][2] << ' ' << vdw_radii[j];
+
+			records.push_back(oss.str());
+		}
+	}
+
+	void processMolecules(CDPL::Pharm::PSDScreeningDBCreator* db_creator, const Testing::TestUtils::MoleculeList* mols, 
+						  std::size_t offset, std::size_t stride)
+	{
+		for (std::size_t i = offset; i < mols->size(); i += stride)
+			db_creator->process(*(*mols)[i]);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(PSDScreeningDBCreatorWriterThreadTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	const char* sync_db_name = "PSDScreeningDBCreatorTest_sync.psd";
+	const char* async_db_name = "PSDScreeningDBCreatorTest_async.psd";
+	const std::size_t NUM_THREADS = 4;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+
+	RecordList sync_records;
+	RecordList async_records;
+
+	TestUtils::createScreeningDB(sync_db_name, mols, false);
+	getRecords(sync_db_name, sync_records);
+
+	BOOST_CHECK_EQUAL(sync_records.size(), mols.size());
+
+	// a single calling thread: records get inserted in the same order
+
+	TestUtils::createScreeningDB(async_db_name, mols, true);
+	getRecords(async_db_name, async_records);
+
+	BOOST_CHECK(sync_records == async_records);
+
+	// concurrent calling threads: same records, but the order of the molecules is not defined
+
+	{
+		PSDScreeningDBCreator db_creator;
+
+		db_creator.setUseWriterThread(true);
+		db_creator.open(async_db_name, ScreeningDBCreator::CREATE);
+
+		boost::thread_group threads;
+
+		for (std::size_t i = 0; i < NUM_THREADS; i++)
+			threads.create_thread(boost::bind(&processMolecules, &db_creator, &mols, i, NUM_THREADS));
+
+		threads.join_all();
+		db_creator.flush();
+
+		BOOST_CHECK_EQUAL(db_creator.getNumProcessed(), mols.size());
+		BOOST_CHECK_EQUAL(db_creator.getNumInserted(), mols.size());
+
+		db_creator.close();
+	}
+
+	getRecords(async_db_name, async_records);
+
+	std::sort(sync_records.begin(), sync_records.end());
+	std::sort(async_records.begin(), async_records.end());
+
+	BOOST_CHECK(sync_records == async_records);
+
+	std::remove(sync_db_name);
+	std::remove(async_db_name);
+}
@@ -0,0 +1,161 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/PharmacophoreFingerprintGenerator.hpp"
+#include "CDPL/Pharm/PharmacophoreFingerprintStore.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureContainerFunctions.hpp"
+#include "CDPL/Math/AffineTransform.hpp"
+#include "CDPL/Math/Matrix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+#include "TestUtils.hpp"
+
+
+BOOST_AUTO_TEST_CASE(PharmacophoreFingerprintGeneratorTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+
+	PharmacophoreFingerprintGenerator fp_gen;
+	Util::BitSet fp;
+	Util::BitSet moved_fp;
+	Util::BitSet reord_fp;
+
+	Math::Matrix4D xform;
+
+	xform.assign(prod(Math::TranslationMatrix<double>(4, 3.5, -12.25, 7.0), Math::RotationMatrix<double>(4, 2.1, 0.3, -0.8, 0.52)));
+
+	for (std::size_t i = 0; i < mols.size(); i++) {
+		BasicPharmacophore pharm;
+
+		TestUtils::generatePharmacophore(*mols[i], pharm);
+
+		fp_gen.generate(pharm, fp);
+
+		BOOST_CHECK_EQUAL(fp.size(), fp_gen.getNumBits());
+		BOOST_CHECK(pharm.getNumFeatures() < 2 || fp.any());
+
+		// the fingerprint must not depend on the order of the features...
+
+		BasicPharmacophore reord_pharm;
+
+		for (std::size_t j = pharm.getNumFeatures(); j > 0; j--)
+			reord_pharm.addFeature() = pharm.getFeature(j - 1);
+
+		fp_gen.generate(reord_pharm, reord_fp);
+
+		BOOST_CHECK(fp == reord_fp);
+
+		// ...and on the position and orientation of the pharmacophore
+
+		transform3DCoordinates(pharm, xform);
+
+		fp_gen.generate(pharm, moved_fp);
+
+		BOOST_CHECK(fp == moved_fp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(PharmacophoreFingerprintStoreFileTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	const char* file_name = "PharmacophoreFingerprintStoreFileTest.pfp";
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+
+	PharmacophoreFingerprintGenerator fp_gen;
+	PharmacophoreFingerprintStore store;
+	Util::BitSet fp;
+
+	for (std::size_t i = 0; i < mols.size(); i++) {
+		BasicPharmacophore pharm;
+
+		TestUtils::generatePharmacophore(*mols[i], pharm);
+		fp_gen.generate(pharm, fp);
+
+		BOOST_CHECK_EQUAL(store.addFingerprint(fp), i);
+	}
+
+	store.save(file_name);
+
+	PharmacophoreFingerprintStore loaded_store;
+
+	loaded_store.open(file_name);
+
+	BOOST_CHECK_EQUAL(loaded_store.getFileName(), file_name);
+	BOOST_CHECK_EQUAL(loaded_store.getNumFingerprints(), store.getNumFingerprints());
+	BOOST_CHECK_EQUAL(loaded_store.getNumFingerprintBits(), store.getNumFingerprintBits());
+
+	Util::BitSet loaded_fp;
+	PharmacophoreFingerprintStore::SearchHitList hits;
+	PharmacophoreFingerprintStore::SearchHitList loaded_hits;
+
+	for (std::size_t i = 0; i < store.getNumFingerprints(); i++) {
+		store.getFingerprint(i, fp);
+		loaded_store.getFingerprint(i, loaded_fp);
+
+		BOOST_CHECK(fp == loaded_fp);
+
+		store.findSimilar(fp, hits, 0.5);
+		loaded_store.findSimilar(fp, loaded_hits, 0.5);
+
+		BOOST_CHECK(!hits.empty());
+		BOOST_CHECK(hits == loaded_hits);
+	}
+
+	// fingerprints added after opening get saved together with the loaded ones
+
+	store.getFingerprint(0, fp);
+
+	BOOST_CHECK_EQUAL(loaded_store.addFingerprint(fp), store.getNumFingerprints());
+
+	loaded_store.save(file_name);
+	store.open(file_name);
+
+	BOOST_CHECK_EQUAL(store.getNumFingerprints(), loaded_store.getNumFingerprints());
+
+	store.getFingerprint(store.getNumFingerprints() - 1, loaded_fp);
+
+	BOOST_CHECK(fp == loaded_fp);
+
+	std::remove(file_name);
+}
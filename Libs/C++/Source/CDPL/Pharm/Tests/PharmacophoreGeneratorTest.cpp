@@ -0,0 +1,230 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreGeneratorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cmath>
+#include <cstddef>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/DefaultPharmacophoreGenerator.hpp"
+#include "CDPL/Pharm/HydrophobicFeatureGenerator.hpp"
+#include "CDPL/Pharm/AromaticFeatureGenerator.hpp"
+#include "CDPL/Pharm/HBondDonorFeatureGenerator.hpp"
+#include "CDPL/Pharm/HBondAcceptorFeatureGenerator.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/Feature.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Chem/AtomArray3DCoordinatesFunctor.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Chem/Fragment.hpp"
+#include "CDPL/Math/AffineTransform.hpp"
+#include "CDPL/Math/Matrix.hpp"
+#include "CDPL/Math/VectorArrayFunctions.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	const std::size_t NUM_CONFORMERS = 4;
+
+	bool equal(double val1, double val2)
+	{
+		return (std::abs(val1 - val2) <= 1e-10);
+	}
+
+	bool equal(const CDPL::Math::Vector3D& vec1, const CDPL::Math::Vector3D& vec2)
+	{
+		return (equal(vec1(0), vec2(0)) && equal(vec1(1), vec2(1)) && equal(vec1(2), vec2(2)));
+	}
+
+	bool equalSubstructures(const CDPL::Pharm::Feature& ftr1, const CDPL::Pharm::Feature& ftr2)
+	{
+		using namespace CDPL;
+
+		if (Pharm::hasSubstructure(ftr1) != Pharm::hasSubstructure(ftr2))
+			return false;
+
+		if (!Pharm::hasSubstructure(ftr1))
+			return true;
+
+		const Chem::Fragment& substruct1 = *Pharm::getSubstructure(ftr1);
+		const Chem::Fragment& substruct2 = *Pharm::getSubstructure(ftr2);
+
+		if (substruct1.getNumAtoms() != substruct2.getNumAtoms() || substruct1.getNumBonds() != substruct2.getNumBonds())
+			return false;
+
+		for (Chem::Fragment::ConstAtomIterator it = substruct1.getAtomsBegin(), end = substruct1.getAtomsEnd(); it != end; ++it)
+			if (!substruct2.containsAtom(*it))
+				return false;
+
+		return true;
+	}
+
+	void checkEqualFeatures(const CDPL::Pharm::Pharmacophore& pharm1, const CDPL::Pharm::Pharmacophore& pharm2)
+	{
+		using namespace CDPL;
+		using namespace Pharm;
+
+		BOOST_REQUIRE_EQUAL(pharm1.getNumFeatures(), pharm2.getNumFeatures());
+
+		for (std::size_t i = 0, num_ftrs = pharm1.getNumFeatures(); i < num_ftrs; i++) {
+			const Feature& ftr1 = pharm1.getFeature(i);
+			const Feature& ftr2 = pharm2.getFeature(i);
+
+			BOOST_CHECK_EQUAL(getType(ftr1), getType(ftr2));
+			BOOST_CHECK_EQUAL(getGeometry(ftr1), getGeometry(ftr2));
+			BOOST_CHECK(equal(get3DCoordinates(ftr1), get3DCoordinates(ftr2)));
+			BOOST_CHECK(equal(getTolerance(ftr1), getTolerance(ftr2)));
+			BOOST_CHECK(equal(getLength(ftr1), getLength(ftr2)));
+			BOOST_CHECK(equal(getWeight(ftr1), getWeight(ftr2)));
+			BOOST_CHECK_EQUAL(getDisabledFlag(ftr1), getDisabledFlag(ftr2));
+			BOOST_CHECK_EQUAL(getOptionalFlag(ftr1), getOptionalFlag(ftr2));
+			BOOST_CHECK_EQUAL(hasHydrophobicity(ftr1), hasHydrophobicity(ftr2));
+			BOOST_CHECK_EQUAL(hasOrientation(ftr1), hasOrientation(ftr2));
+
+			if (hasHydrophobicity(ftr1) && hasHydrophobicity(ftr2))
+				BOOST_CHECK(equal(getHydrophobicity(ftr1), getHydrophobicity(ftr2)));
+
+			if (hasOrientation(ftr1) && hasOrientation(ftr2))
+				BOOST_CHECK(equal(getOrientation(ftr1), getOrientation(ftr2)));
+
+			BOOST_CHECK(equalSubstructures(ftr1, ftr2));
+		}
+	}
+
+	void genConformers(const CDPL::Chem::MolecularGraph& molgraph, CDPL::Math::Vector3DArray (&confs)[NUM_CONFORMERS])
+	{
+		using namespace CDPL;
+
+		get3DCoordinates(molgraph, confs[0]);
+
+		// the other conformers are distorted and moved copies of the input coordinates
+
+		for (std::size_t i = 1; i < NUM_CONFORMERS; i++) {
+			Math::Matrix4D xform;
+
+			xform.assign(prod(Math::TranslationMatrix<double>(4, 1.5 * i, -2.0, 0.5 * i), Math::RotationMatrix<double>(4, 0.7 * i, 0.3, -0.8, 0.52)));
+
+			confs[i] = confs[0];
+
+			for (std::size_t j = 0; j < confs[i].getSize(); j++) {
+				confs[i][j](0) += 0.15 * std::sin(double(i * 7 + j));
+				confs[i][j](1) += 0.15 * std::cos(double(i * 3 + j));
+			}
+
+			transform(confs[i], xform);
+		}
+	}
+
+	template <typename GenType>
+	void checkPreparedGeneration(GenType& gen, GenType& prep_gen, const Testing::TestUtils::MoleculeList& mols)
+	{
+		using namespace CDPL;
+
+		Math::Vector3DArray confs[NUM_CONFORMERS];
+		Pharm::BasicPharmacophore gen_pharm;
+		Pharm::BasicPharmacophore inst_pharm;
+		std::size_t num_ftrs = 0;
+
+		for (std::size_t i = 0; i < mols.size(); i++) {
+			const Chem::MolecularGraph& molgraph = *mols[i];
+
+			genConformers(molgraph, confs);
+
+			prep_gen.prepare(molgraph);
+
+			for (std::size_t j = 0; j < NUM_CONFORMERS; j++) {
+				gen.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(confs[j], molgraph));
+				prep_gen.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(confs[j], molgraph));
+
+				gen_pharm.clear();
+				inst_pharm.clear();
+
+				gen.generate(molgraph, gen_pharm);
+				prep_gen.instantiate(inst_pharm);
+
+				checkEqualFeatures(gen_pharm, inst_pharm);
+
+				num_ftrs += gen_pharm.getNumFeatures();
+			}
+		}
+
+		BOOST_CHECK(num_ftrs > 0);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(PharmacophoreGeneratorPrepareInstantiateTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+
+	BOOST_REQUIRE(!mols.empty());
+
+	// prepare() followed by instantiate() for each conformer yields the features of a per-conformer generate()
+
+	DefaultPharmacophoreGenerator pharm_gen(false);
+	DefaultPharmacophoreGenerator prep_pharm_gen(false);
+
+	checkPreparedGeneration(pharm_gen, prep_pharm_gen, mols);
+
+	DefaultPharmacophoreGenerator fuzzy_pharm_gen(true);
+	DefaultPharmacophoreGenerator prep_fuzzy_pharm_gen(true);
+
+	checkPreparedGeneration(fuzzy_pharm_gen, prep_fuzzy_pharm_gen, mols);
+
+	// feature generators that prepare additional non-pattern based features
+
+	HydrophobicFeatureGenerator h_gen;
+	HydrophobicFeatureGenerator prep_h_gen;
+
+	checkPreparedGeneration(h_gen, prep_h_gen, mols);
+
+	AromaticFeatureGenerator ar_gen;
+	AromaticFeatureGenerator prep_ar_gen;
+
+	checkPreparedGeneration(ar_gen, prep_ar_gen, mols);
+
+	// pattern based feature generators using the default preparation
+
+	HBondDonorFeatureGenerator don_gen(false);
+	HBondDonorFeatureGenerator prep_don_gen(false);
+
+	checkPreparedGeneration(don_gen, prep_don_gen, mols);
+
+	HBondAcceptorFeatureGenerator acc_gen;
+	HBondAcceptorFeatureGenerator prep_acc_gen;
+
+	checkPreparedGeneration(acc_gen, prep_acc_gen, mols);
+}
@@ -0,0 +1,118 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningDBShardManifestTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <sstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+BOOST_AUTO_TEST_CASE(ScreeningDBShardManifestTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+
+	ScreeningDBShardManifest manifest;
+
+	BOOST_CHECK(manifest.getNumShards() == 0);
+	BOOST_CHECK(manifest.getNumMolecules() == 0);
+
+	BOOST_CHECK_THROW(manifest.getShardFileName(0), Base::IndexError);
+	BOOST_CHECK_THROW(manifest.findShard(0), Base::IndexError);
+
+	manifest.addShard("shard0.psd", 3);
+	manifest.addShard("dir/shard 1.psd", 0);
+	manifest.addShard("/abs/shard2.psd", 5);
+
+	BOOST_CHECK(manifest.getNumShards() == 3);
+	BOOST_CHECK(manifest.getNumMolecules() == 8);
+
+	BOOST_CHECK(manifest.getShardMoleculeOffset(0) == 0);
+	BOOST_CHECK(manifest.getShardMoleculeOffset(1) == 3);
+	BOOST_CHECK(manifest.getShardMoleculeOffset(2) == 3);
+	BOOST_CHECK(manifest.getShardNumMolecules(2) == 5);
+
+	BOOST_CHECK(manifest.findShard(0) == 0);
+	BOOST_CHECK(manifest.findShard(2) == 0);
+	BOOST_CHECK(manifest.findShard(3) == 2);
+	BOOST_CHECK(manifest.findShard(7) == 2);
+	BOOST_CHECK_THROW(manifest.findShard(8), Base::IndexError);
+
+	std::stringstream ss;
+
+	manifest.write(ss);
+
+	ScreeningDBShardManifest read_manifest;
+
+	read_manifest.addShard("old.psd", 1);
+	read_manifest.read(ss);
+
+	BOOST_CHECK(read_manifest.getNumShards() == 3);
+	BOOST_CHECK(read_manifest.getNumMolecules() == 8);
+
+	for (std::size_t i = 0; i < 3; i++) {
+		BOOST_CHECK(read_manifest.getShardFileName(i) == manifest.getShardFileName(i));
+		BOOST_CHECK(read_manifest.getShardMoleculeOffset(i) == manifest.getShardMoleculeOffset(i));
+		BOOST_CHECK(read_manifest.getShardNumMolecules(i) == manifest.getShardNumMolecules(i));
+	}
+
+	std::istringstream iss("# comment\n\n  0 2   a.psd  \n\t# indented comment\n2\t4 b c.psd\n   \n");
+
+	read_manifest.read(iss);
+
+	BOOST_CHECK(read_manifest.getNumShards() == 2);
+	BOOST_CHECK(read_manifest.getNumMolecules() == 6);
+	BOOST_CHECK(read_manifest.getShardFileName(0) == "a.psd");
+	BOOST_CHECK(read_manifest.getShardFileName(1) == "b c.psd");
+	BOOST_CHECK(read_manifest.getShardMoleculeOffset(1) == 2);
+
+	// malformed or non-contiguous input must leave the current content untouched
+
+	iss.clear();
+	iss.str("0 2 a.psd\n3 4 b.psd\n");
+
+	BOOST_CHECK_THROW(read_manifest.read(iss), Base::IOError);
+
+	iss.clear();
+	iss.str("0 2\n");
+
+	BOOST_CHECK_THROW(read_manifest.read(iss), Base::IOError);
+
+	iss.clear();
+	iss.str("0 x a.psd\n");
+
+	BOOST_CHECK_THROW(read_manifest.read(iss), Base::IOError);
+
+	BOOST_CHECK(read_manifest.getNumShards() == 2);
+	BOOST_CHECK(read_manifest.getShardFileName(1) == "b c.psd");
+
+	read_manifest.clear();
+
+	BOOST_CHECK(read_manifest.getNumShards() == 0);
+	BOOST_CHECK(read_manifest.getNumMolecules() == 0);
+}
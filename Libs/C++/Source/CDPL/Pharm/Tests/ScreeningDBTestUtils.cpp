@@ -0,0 +1,46 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningDBTestUtils.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
+
+#include "TestUtils.hpp"
+
+
+using namespace CDPL;
+
+
+void Testing::TestUtils::createScreeningDB(const std::string& db_name, const MoleculeList& mols, bool use_writer_thread)
+{
+	Pharm::PSDScreeningDBCreator db_creator;
+
+	db_creator.setUseWriterThread(use_writer_thread);
+	db_creator.open(db_name, Pharm::ScreeningDBCreator::CREATE);
+
+	for (MoleculeList::const_iterator it = mols.begin(), end = mols.end(); it != end; ++it)
+		db_creator.process(**it);
+
+	db_creator.close();
+}
@@ -0,0 +1,280 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningProcessorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+#include <utility>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/FeatureContainerFunctions.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Pharm/PharmacophoreFitScreeningScore.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	typedef std::pair<std::size_t, std::size_t> HitKey;
+	typedef std::map<HitKey, double> HitList;
+
+	bool collectHit(HitList& hits, const CDPL::Pharm::ScreeningProcessor::SearchHit& hit, double score)
+	{
+		hits[HitKey(hit.getHitMoleculeIndex(), hit.getHitConformationIndex())] = score;
+		return true;
+	}
+
+	void searchDB(CDPL::Pharm::ScreeningProcessor& scr_proc, const CDPL::Pharm::Pharmacophore& query, HitList& hits)
+	{
+		hits.clear();
+
+		scr_proc.setHitCallback(boost::bind(&collectHit, boost::ref(hits), _1, _2));
+		scr_proc.searchDB(query);
+	}
+
+	std::size_t getNumGeometryChecks(const CDPL::Pharm::ScreeningProcessor& scr_proc)
+	{
+		using namespace CDPL;
+
+		const Pharm::ScreeningStatistics& stats = scr_proc.getStatistics();
+
+		return (stats.getNumPassed(Pharm::ScreeningStatistics::GEOMETRY_CHECK) + stats.getNumRejected(Pharm::ScreeningStatistics::GEOMETRY_CHECK));
+	}
+
+	void checkHitsEqual(const HitList& hits, const HitList& pruned_hits)
+	{
+		BOOST_CHECK_EQUAL(hits.size(), pruned_hits.size());
+
+		for (HitList::const_iterator it = hits.begin(), end = hits.end(); it != end; ++it) {
+			HitList::const_iterator p_it = pruned_hits.find(it->first);
+
+			BOOST_CHECK(p_it != pruned_hits.end());
+
+			if (p_it != pruned_hits.end())
+				BOOST_CHECK_SMALL(it->second - p_it->second, 1.0e-6);
+		}
+	}
+
+	typedef std::set<HitKey> QueryHitSet;
+
+	bool collectQueryHit(QueryHitSet& hits, const CDPL::Pharm::ScreeningProcessor::SearchHit& hit, double score)
+	{
+		hits.insert(HitKey(hit.getQueryPharmacophoreIndex(), hit.getHitPharmacophoreIndex()));
+		return true;
+	}
+
+	bool checkFeatureCounts(const CDPL::Pharm::FeatureTypeHistogram& query_cnts, const CDPL::Pharm::FeatureTypeHistogram& db_cnts,
+							std::size_t max_omitted)
+	{
+		using namespace CDPL;
+
+		for (Pharm::FeatureTypeHistogram::ConstEntryIterator it = query_cnts.getEntriesBegin(), end = query_cnts.getEntriesEnd(); it != end; ++it)
+			if (db_cnts.getValue(it->first, 0) + max_omitted < it->second)
+				return false;
+
+		return true;
+	}
+
+	const char* TEST_DB_NAME = "ScreeningProcessorTest.psd";
+}
+
+
+BOOST_AUTO_TEST_CASE(ScreeningProcessorPrunedAlignmentSearchTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+
+	BOOST_CHECK(mols.size() == 40);
+
+	TestUtils::createScreeningDB(TEST_DB_NAME, mols);
+
+	{
+		PSDScreeningDBAccessor db_acc(TEST_DB_NAME);
+		ScreeningProcessor scr_proc(db_acc);
+
+		scr_proc.setHitReportMode(ScreeningProcessor::ALL_MATCHING_CONFS);
+		scr_proc.seekBestAlignments(true);
+		scr_proc.enableStatistics(true);
+
+		std::size_t num_hits = 0;
+
+		for (std::size_t i = 0; i < 8; i++) {
+			BasicPharmacophore query;
+
+			TestUtils::generatePharmacophore(*mols[i * 5], query, 4);
+
+			HitList hits;
+			HitList pruned_hits;
+
+			scr_proc.pruneAlignmentSearch(false);
+			searchDB(scr_proc, query, hits);
+
+			scr_proc.pruneAlignmentSearch(true);
+			searchDB(scr_proc, query, pruned_hits);
+
+			checkHitsEqual(hits, pruned_hits);
+
+			num_hits += hits.size();
+		}
+
+		BOOST_CHECK(num_hits > 8);
+
+		// an optional query feature of a type that no database pharmacophore provides can never be matched - a match count
+		// score of 1 is thus out of reach and the search may only terminate early if this feature is excluded from the bound
+
+		scr_proc.setScoringFunction(PharmacophoreFitScreeningScore(1.0, 0.0, 0.0));
+
+		std::size_t num_geom_checks = 0;
+		std::size_t num_pruned_geom_checks = 0;
+
+		num_hits = 0;
+
+		for (std::size_t i = 0; i < 8; i++) {
+			BasicPharmacophore query;
+
+			TestUtils::generatePharmacophore(*mols[i * 5], query, 4);
+
+			Feature& unmatched_ftr = query.addFeature();
+
+			setType(unmatched_ftr, FeatureType::UNKNOWN);
+			setTolerance(unmatched_ftr, 1.0);
+			setOptionalFlag(unmatched_ftr, true);
+			set3DCoordinates(unmatched_ftr, get3DCoordinates(query.getFeature(0)));
+
+			HitList hits;
+			HitList pruned_hits;
+
+			scr_proc.clearStatistics();
+			scr_proc.pruneAlignmentSearch(false);
+			searchDB(scr_proc, query, hits);
+
+			num_geom_checks += getNumGeometryChecks(scr_proc);
+
+			scr_proc.clearStatistics();
+			scr_proc.pruneAlignmentSearch(true);
+			searchDB(scr_proc, query, pruned_hits);
+
+			num_pruned_geom_checks += getNumGeometryChecks(scr_proc);
+
+			checkHitsEqual(hits, pruned_hits);
+
+			for (HitList::const_iterator it = hits.begin(), end = hits.end(); it != end; ++it)
+				BOOST_CHECK(it->second < 1.0);
+
+			num_hits += hits.size();
+		}
+
+		BOOST_CHECK(num_hits > 8);
+		BOOST_CHECK(num_pruned_geom_checks < num_geom_checks);
+	}
+
+	std::remove(TEST_DB_NAME);
+}
+
+BOOST_AUTO_TEST_CASE(ScreeningProcessorFeatureCountFilterTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+	TestUtils::createScreeningDB(TEST_DB_NAME, mols);
+
+	{
+		PSDScreeningDBAccessor db_acc(TEST_DB_NAME);
+		ScreeningProcessor scr_proc(db_acc);
+
+		std::vector<BasicPharmacophore> queries(8);
+		std::vector<FeatureTypeHistogram> query_ftr_cnts(queries.size());
+		ScreeningProcessor::FeatureContainerList query_list;
+
+		for (std::size_t i = 0; i < queries.size(); i++) {
+			db_acc.getPharmacophore(i * 5, 0, queries[i]);
+
+			while (queries[i].getNumFeatures() > 6)
+				queries[i].removeFeature(queries[i].getNumFeatures() - 1);
+
+			buildFeatureTypeHistogram(queries[i], query_ftr_cnts[i]);
+			query_list.push_back(&queries[i]);
+		}
+
+		for (std::size_t max_omitted = 0; max_omitted < 2; max_omitted++) {
+			scr_proc.setMaxNumOmittedFeatures(max_omitted);
+
+			// every hit must pass the feature count check of its own query, and each query
+			// must at least be matched by the database pharmacophore it was derived from 
+
+			QueryHitSet single_pass_hits;
+
+			scr_proc.setHitCallback(boost::bind(&collectQueryHit, boost::ref(single_pass_hits), _1, _2));
+			scr_proc.searchDB(query_list);
+
+			QueryHitSet hits;
+
+			for (std::size_t i = 0; i < queries.size(); i++) {
+				QueryHitSet query_hits;
+
+				scr_proc.setHitCallback(boost::bind(&collectQueryHit, boost::ref(query_hits), _1, _2));
+				scr_proc.searchDB(queries[i]);
+
+				bool self_hit = false;
+
+				for (QueryHitSet::const_iterator it = query_hits.begin(), end = query_hits.end(); it != end; ++it) {
+					BOOST_CHECK(checkFeatureCounts(query_ftr_cnts[i], db_acc.getFeatureCounts(it->second), max_omitted));
+
+					hits.insert(HitKey(i, it->second));
+					self_hit |= (db_acc.getMoleculeIndex(it->second) == i * 5);
+				}
+
+				BOOST_CHECK(self_hit);
+			}
+
+			BOOST_CHECK(single_pass_hits == hits);
+		}
+	}
+
+	std::remove(TEST_DB_NAME);
+}
@@ -0,0 +1,217 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningStatisticsTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
+#include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	struct ScreeningWorker
+	{
+
+		typedef CDPL::Pharm::ScreeningProcessor::FeatureContainerList QueryList;
+
+		ScreeningWorker(const char* db_name, const QueryList& queries, std::size_t start_mol_idx, std::size_t end_mol_idx,
+						CDPL::Pharm::ScreeningStatistics& stats, boost::mutex& mutex):
+			dbName(db_name), queries(queries), startMolIndex(start_mol_idx), endMolIndex(end_mol_idx), 
+			stats(stats), mutex(mutex) {}
+
+		void operator()() {
+			using namespace CDPL;
+
+			Pharm::PSDScreeningDBAccessor db_acc(dbName);
+			Pharm::ScreeningProcessor scr_proc(db_acc);
+
+			scr_proc.enableStatistics(true);
+
+			for (QueryList::const_iterator it = queries.begin(), end = queries.end(); it != end; ++it)
+				scr_proc.searchDB(**it, startMolIndex, endMolIndex);
+
+			boost::lock_guard<boost::mutex> lock(mutex);
+
+			stats += scr_proc.getStatistics();
+		}
+
+		const char*                       dbName;
+		const QueryList&                  queries;
+		std::size_t                       startMolIndex;
+		std::size_t                       endMolIndex;
+		CDPL::Pharm::ScreeningStatistics& stats;
+		boost::mutex&                     mutex;
+	};
+
+	const char* TEST_DB_NAME = "ScreeningStatisticsTest.psd";
+}
+
+
+BOOST_AUTO_TEST_CASE(ScreeningStatisticsTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+
+	ScreeningStatistics stats;
+
+	for (std::size_t i = 0; i < ScreeningStatistics::NUM_STAGES; i++) {
+		ScreeningStatistics::Stage stage = ScreeningStatistics::Stage(i);
+
+		BOOST_CHECK(stats.getNumPassed(stage) == 0);
+		BOOST_CHECK(stats.getNumRejected(stage) == 0);
+		BOOST_CHECK(stats.getWallTime(stage) == 0.0);
+		BOOST_CHECK(stats.getCPUTime(stage) == 0.0);
+	}
+
+	stats.addResult(ScreeningStatistics::ALIGNMENT, true);
+	stats.addResult(ScreeningStatistics::ALIGNMENT, false, 3);
+	stats.addResult(ScreeningStatistics::SCORING, true, 5);
+	stats.addTime(ScreeningStatistics::ALIGNMENT, 1.5, 1.0);
+	stats.addTime(ScreeningStatistics::SCORING, 0.25, 0.5);
+
+	BOOST_CHECK(stats.getNumPassed(ScreeningStatistics::ALIGNMENT) == 1);
+	BOOST_CHECK(stats.getNumRejected(ScreeningStatistics::ALIGNMENT) == 3);
+	BOOST_CHECK(stats.getNumPassed(ScreeningStatistics::SCORING) == 5);
+	BOOST_CHECK(stats.getNumRejected(ScreeningStatistics::SCORING) == 0);
+	BOOST_CHECK_CLOSE(stats.getTotalWallTime(), 1.75, 1.0e-10);
+	BOOST_CHECK_CLOSE(stats.getTotalCPUTime(), 1.5, 1.0e-10);
+
+	ScreeningStatistics sum_stats(stats);
+
+	sum_stats += stats;
+
+	BOOST_CHECK(sum_stats.getNumPassed(ScreeningStatistics::ALIGNMENT) == 2);
+	BOOST_CHECK(sum_stats.getNumRejected(ScreeningStatistics::ALIGNMENT) == 6);
+	BOOST_CHECK_CLOSE(sum_stats.getWallTime(ScreeningStatistics::ALIGNMENT), 3.0, 1.0e-10);
+	BOOST_CHECK_CLOSE(sum_stats.getCPUTime(ScreeningStatistics::SCORING), 1.0, 1.0e-10);
+
+	sum_stats.clear();
+
+	BOOST_CHECK(sum_stats.getNumPassed(ScreeningStatistics::ALIGNMENT) == 0);
+	BOOST_CHECK(sum_stats.getTotalWallTime() == 0.0);
+	BOOST_CHECK(sum_stats.getTotalCPUTime() == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(ScreeningStatisticsThreadMergeTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	const std::size_t NUM_THREADS = 4;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, 40);
+	TestUtils::createScreeningDB(TEST_DB_NAME, mols);
+
+	std::vector<BasicPharmacophore> queries(6);
+	ScreeningProcessor::FeatureContainerList query_list;
+
+	for (std::size_t i = 0; i < queries.size(); i++) {
+		TestUtils::generatePharmacophore(*mols[i * 7], queries[i], 4);
+		query_list.push_back(&queries[i]);
+	}
+
+	// screening the database in a single thread yields the reference counts
+
+	ScreeningStatistics ref_stats;
+
+	{
+		PSDScreeningDBAccessor db_acc(TEST_DB_NAME);
+		ScreeningProcessor scr_proc(db_acc);
+
+		BOOST_CHECK(!scr_proc.statisticsEnabled());
+
+		scr_proc.enableStatistics(true);
+
+		for (std::size_t i = 0; i < queries.size(); i++)
+			scr_proc.searchDB(queries[i]);
+
+		ref_stats = scr_proc.getStatistics();
+	}
+
+	BOOST_CHECK(ref_stats.getNumPassed(ScreeningStatistics::PHARMACOPHORE_LOADING) > 0);
+	BOOST_CHECK(ref_stats.getNumPassed(ScreeningStatistics::HIT_REPORTING) > 0);
+	BOOST_CHECK(ref_stats.getNumRejected(ScreeningStatistics::FEATURE_COUNT_CHECK) + 
+				ref_stats.getNumRejected(ScreeningStatistics::TWO_POINT_PHARMACOPHORE_CHECK) + 
+				ref_stats.getNumRejected(ScreeningStatistics::ALIGNMENT) > 0);
+
+	// the statistics of threads screening disjoint molecule ranges must add up to the reference counts
+
+	ScreeningStatistics merged_stats;
+	boost::mutex mutex;
+	boost::thread_group thread_grp;
+	std::size_t num_mols = mols.size();
+
+	for (std::size_t i = 0; i < NUM_THREADS; i++)
+		thread_grp.create_thread(ScreeningWorker(TEST_DB_NAME, query_list, i * num_mols / NUM_THREADS, (i + 1) * num_mols / NUM_THREADS, 
+												 merged_stats, mutex));
+	thread_grp.join_all();
+
+	for (std::size_t i = 0; i < ScreeningStatistics::NUM_STAGES; i++) {
+		ScreeningStatistics::Stage stage = ScreeningStatistics::Stage(i);
+
+		BOOST_CHECK_MESSAGE(merged_stats.getNumPassed(stage) == ref_stats.getNumPassed(stage), ScreeningStatistics::getStageName(stage));
+		BOOST_CHECK_MESSAGE(merged_stats.getNumRejected(stage) == ref_stats.getNumRejected(stage), ScreeningStatistics::getStageName(stage));
+		BOOST_CHECK(merged_stats.getWallTime(stage) >= 0.0);
+		BOOST_CHECK(merged_stats.getCPUTime(stage) >= 0.0);
+	}
+
+	// screening all queries in a single pass performs the same checks
+
+	ScreeningStatistics single_pass_stats;
+
+	{
+		PSDScreeningDBAccessor db_acc(TEST_DB_NAME);
+		ScreeningProcessor scr_proc(db_acc);
+
+		scr_proc.enableStatistics(true);
+		scr_proc.searchDB(query_list);
+
+		single_pass_stats = scr_proc.getStatistics();
+
+		scr_proc.clearStatistics();
+
+		BOOST_CHECK(scr_proc.getStatistics().getNumPassed(ScreeningStatistics::PHARMACOPHORE_LOADING) == 0);
+	}
+
+	BOOST_CHECK(single_pass_stats.getNumPassed(ScreeningStatistics::HIT_REPORTING) == ref_stats.getNumPassed(ScreeningStatistics::HIT_REPORTING));
+
+	std::remove(TEST_DB_NAME);
+}
@@ -0,0 +1,263 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ShardedScreeningDBAccessorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <fstream>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "CDPL/Pharm/ShardedScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "TestUtils.hpp"
+
+
+namespace
+{
+
+	typedef std::pair<std::size_t, std::size_t> HitKey;
+	typedef std::map<HitKey, double> HitList;
+
+	// hit list entry ordered the way PSDMergeHits ranks hits (decreasing score, increasing molecule index)
+
+	typedef std::pair<double, std::size_t> RankedHit;
+	typedef std::vector<RankedHit> RankedHitList;
+
+	bool compareRankedHits(const RankedHit& hit1, const RankedHit& hit2)
+	{
+		if (hit1.first != hit2.first)
+			return (hit1.first > hit2.first);
+
+		return (hit1.second < hit2.second);
+	}
+
+	bool collectHit(HitList& hits, RankedHitList& ranked_hits, const CDPL::Pharm::ScreeningProcessor::SearchHit& hit, double score)
+	{
+		hits[HitKey(hit.getHitMoleculeIndex(), hit.getHitConformationIndex())] = score;
+		ranked_hits.push_back(RankedHit(score, hit.getHitMoleculeIndex()));
+
+		return true;
+	}
+
+	void searchDB(CDPL::Pharm::ScreeningProcessor& scr_proc, const CDPL::Pharm::Pharmacophore& query, HitList& hits, RankedHitList& ranked_hits)
+	{
+		scr_proc.setHitCallback(boost::bind(&collectHit, boost::ref(hits), boost::ref(ranked_hits), _1, _2));
+		scr_proc.searchDB(query);
+	}
+
+	bool compareHitLists(const HitList& hits1, const HitList& hits2)
+	{
+		if (hits1.size() != hits2.size())
+			return false;
+
+		for (HitList::const_iterator it1 = hits1.begin(), it2 = hits2.begin(), end = hits1.end(); it1 != end; ++it1, ++it2)
+			if (it1->first != it2->first || std::abs(it1->second - it2->second) > 1.0e-6)
+				return false;
+
+		return true;
+	}
+
+	bool comparePharmacophores(const CDPL::Pharm::Pharmacophore& pharm1, const CDPL::Pharm::Pharmacophore& pharm2)
+	{
+		using namespace CDPL;
+
+		if (pharm1.getNumFeatures() != pharm2.getNumFeatures())
+			return false;
+
+		for (std::size_t i = 0; i < pharm1.getNumFeatures(); i++) {
+			const Pharm::Feature& ftr1 = pharm1.getFeature(i);
+			const Pharm::Feature& ftr2 = pharm2.getFeature(i);
+
+			if (getType(ftr1) != getType(ftr2))
+				return false;
+
+			if (normInf(get3DCoordinates(ftr1) - get3DCoordinates(ftr2)) > 1.0e-6)
+				return false;
+		}
+
+		return true;
+	}
+
+	const char* FULL_DB_NAME   = "ShardedScreeningDBAccessorTest.psd";
+	const char* MANIFEST_NAME  = "ShardedScreeningDBAccessorTest.psdm";
+	const std::size_t NUM_MOLS = 40;
+	const std::size_t NUM_SHARDS = 3;
+	const std::size_t SHARD_SIZES[NUM_SHARDS] = { 15, 0, 25 };
+
+	std::string getShardFileName(std::size_t idx) 
+	{
+		return "ShardedScreeningDBAccessorTest_" + boost::lexical_cast<std::string>(idx) + ".psd";
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(ShardedScreeningDBAccessorTest)
+{
+	using namespace CDPL;
+	using namespace Pharm;
+	using namespace Testing;
+
+	TestUtils::MoleculeList mols;
+
+	TestUtils::readTestMolecules(mols, NUM_MOLS);
+
+	BOOST_CHECK(mols.size() == NUM_MOLS);
+
+	TestUtils::createScreeningDB(FULL_DB_NAME, mols);
+
+	ScreeningDBShardManifest manifest;
+
+	for (std::size_t i = 0, offset = 0; i < NUM_SHARDS; offset += SHARD_SIZES[i++]) {
+		TestUtils::createScreeningDB(getShardFileName(i), 
+									 TestUtils::MoleculeList(mols.begin() + offset, mols.begin() + offset + SHARD_SIZES[i]));
+		manifest.addShard(getShardFileName(i), SHARD_SIZES[i]);
+	}
+
+	{
+		std::ofstream os(MANIFEST_NAME);
+
+		manifest.write(os);
+	}
+
+	{
+		PSDScreeningDBAccessor full_db_acc(FULL_DB_NAME);
+		ShardedScreeningDBAccessor shard_db_acc(MANIFEST_NAME);
+
+		BOOST_CHECK(shard_db_acc.getManifest().getNumShards() == NUM_SHARDS);
+		BOOST_CHECK(shard_db_acc.getFirstSelectedShard() == 0);
+		BOOST_CHECK(shard_db_acc.getNumSelectedShards() == NUM_SHARDS);
+
+		BOOST_CHECK_EQUAL(shard_db_acc.getNumMolecules(), full_db_acc.getNumMolecules());
+		BOOST_CHECK_EQUAL(shard_db_acc.getNumPharmacophores(), full_db_acc.getNumPharmacophores());
+
+		BasicPharmacophore full_pharm;
+		BasicPharmacophore shard_pharm;
+
+		for (std::size_t i = 0; i < full_db_acc.getNumMolecules(); i++)
+			BOOST_CHECK_EQUAL(shard_db_acc.getNumPharmacophores(i), full_db_acc.getNumPharmacophores(i));
+
+		for (std::size_t i = 0; i < full_db_acc.getNumPharmacophores(); i++) {
+			BOOST_CHECK_EQUAL(shard_db_acc.getMoleculeIndex(i), full_db_acc.getMoleculeIndex(i));
+			BOOST_CHECK_EQUAL(shard_db_acc.getConformationIndex(i), full_db_acc.getConformationIndex(i));
+			BOOST_CHECK(shard_db_acc.getFeatureCounts(i) == full_db_acc.getFeatureCounts(i));
+
+			full_db_acc.getPharmacophore(i, full_pharm);
+			shard_db_acc.getPharmacophore(i, shard_pharm);
+
+			BOOST_CHECK(comparePharmacophores(full_pharm, shard_pharm));
+
+			shard_db_acc.getPharmacophore(full_db_acc.getMoleculeIndex(i), full_db_acc.getConformationIndex(i), shard_pharm);
+
+			BOOST_CHECK(comparePharmacophores(full_pharm, shard_pharm));
+		}
+
+		// a shard selection restricts the enumerated pharmacophores but keeps global molecule indices
+
+		shard_db_acc.selectShards(2, 1);
+
+		BOOST_CHECK(shard_db_acc.getNumMolecules() == NUM_MOLS);
+		BOOST_CHECK(shard_db_acc.getNumPharmacophores() == PSDScreeningDBAccessor(getShardFileName(2)).getNumPharmacophores());
+		BOOST_CHECK(shard_db_acc.getMoleculeIndex(0) == SHARD_SIZES[0] + SHARD_SIZES[1]);
+
+		shard_db_acc.selectShards(1, 1);
+
+		BOOST_CHECK(shard_db_acc.getNumPharmacophores() == 0);
+
+		BOOST_CHECK_THROW(shard_db_acc.selectShards(NUM_SHARDS + 1, 0), Base::IndexError);
+		BOOST_CHECK_THROW(shard_db_acc.selectShards(1, NUM_SHARDS), Base::IndexError);
+
+		// screening the shards one after the other and merging the hits must yield the hit list of the full database
+
+		ScreeningProcessor full_scr_proc(full_db_acc);
+		ScreeningProcessor shard_scr_proc(shard_db_acc);
+		std::size_t num_hits = 0;
+
+		for (std::size_t i = 0; i < 8; i++) {
+			BasicPharmacophore query;
+
+			TestUtils::generatePharmacophore(*mols[i * 5], query, 4);
+
+			HitList full_hits;
+			RankedHitList full_ranked_hits;
+
+			searchDB(full_scr_proc, query, full_hits, full_ranked_hits);
+
+			HitList shard_hits;
+			RankedHitList shard_ranked_hits;
+
+			shard_db_acc.selectShards(0, NUM_SHARDS);
+			searchDB(shard_scr_proc, query, shard_hits, shard_ranked_hits);
+
+			BOOST_CHECK(compareHitLists(full_hits, shard_hits));
+
+			shard_hits.clear();
+			shard_ranked_hits.clear();
+
+			for (std::size_t j = 0; j < NUM_SHARDS; j++) {
+				shard_db_acc.selectShards(j, 1);
+				searchDB(shard_scr_proc, query, shard_hits, shard_ranked_hits);
+			}
+
+			BOOST_CHECK(compareHitLists(full_hits, shard_hits));
+
+			std::sort(full_ranked_hits.begin(), full_ranked_hits.end(), &compareRankedHits);
+			std::sort(shard_ranked_hits.begin(), shard_ranked_hits.end(), &compareRankedHits);
+
+			BOOST_CHECK_EQUAL(full_ranked_hits.size(), shard_ranked_hits.size());
+
+			for (std::size_t j = 0; j < std::min(full_ranked_hits.size(), shard_ranked_hits.size()); j++) {
+				BOOST_CHECK_EQUAL(full_ranked_hits[j].second, shard_ranked_hits[j].second);
+				BOOST_CHECK_SMALL(full_ranked_hits[j].first - shard_ranked_hits[j].first, 1.0e-6);
+			}
+
+			num_hits += full_hits.size();
+		}
+
+		BOOST_CHECK(num_hits > 8);
+	}
+
+	std::remove(FULL_DB_NAME);
+	std::remove(MANIFEST_NAME);
+
+	for (std::size_t i = 0; i < NUM_SHARDS; i++)
+		std::remove(getShardFileName(i).c_str());
+}
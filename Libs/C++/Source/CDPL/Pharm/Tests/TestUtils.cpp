@@ -0,0 +1,83 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * TestUtils.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+
+#include "CDPL/Chem/MOL2MoleculeReader.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Pharm/DefaultPharmacophoreGenerator.hpp"
+#include "CDPL/Pharm/Pharmacophore.hpp"
+#include "CDPL/Pharm/Feature.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+
+#include "TestUtils.hpp"
+
+
+using namespace CDPL;
+
+
+void Testing::TestUtils::readTestMolecules(MoleculeList& mols, std::size_t max_num)
+{
+	Util::FileDataReader<Chem::MOL2MoleculeReader> mol_reader(std::getenv("CDPKIT_TEST_DATA_DIR") + std::string("/MMFF94/MMFF94_dative.mol2"));
+
+	mols.clear();
+
+	while (mols.size() < max_num) {
+		Chem::BasicMolecule::SharedPointer mol_ptr(new Chem::BasicMolecule());
+
+		if (!mol_reader.read(*mol_ptr))
+			return;
+
+		if (getHeavyAtomCount(*mol_ptr) < 6)
+			continue;
+
+		perceiveComponents(*mol_ptr, false);
+		perceiveSSSR(*mol_ptr, false);
+		setRingFlags(*mol_ptr, false);
+		calcImplicitHydrogenCounts(*mol_ptr, false);
+		perceiveHybridizationStates(*mol_ptr, false);
+		setAromaticityFlags(*mol_ptr, false);
+		calcCIPPriorities(*mol_ptr, false);
+		calcAtomCIPConfigurations(*mol_ptr, false);
+		calcBondCIPConfigurations(*mol_ptr, false);
+
+		mols.push_back(mol_ptr);
+	}
+}
+
+void Testing::TestUtils::generatePharmacophore(const Chem::MolecularGraph& molgraph, Pharm::Pharmacophore& pharm, std::size_t max_num_ftrs)
+{
+	Pharm::DefaultPharmacophoreGenerator pharm_gen(false);
+
+	pharm_gen.generate(molgraph, pharm);
+
+	if (max_num_ftrs == 0)
+		return;
+
+	while (pharm.getNumFeatures() > max_num_ftrs)
+		pharm.removeFeature(pharm.getNumFeatures() - 1);
+}
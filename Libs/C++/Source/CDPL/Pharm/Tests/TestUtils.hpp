@@ -0,0 +1,63 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * TestUtils.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_PHARM_TEST_TESTUTILS_HPP
+#define CDPL_PHARM_TEST_TESTUTILS_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "CDPL/Chem/BasicMolecule.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+		class Pharmacophore;
+    }
+}
+
+namespace Testing
+{
+
+	namespace TestUtils
+	{
+
+		typedef std::vector<CDPL::Chem::BasicMolecule::SharedPointer> MoleculeList;
+
+		void readTestMolecules(MoleculeList& mols, std::size_t max_num);
+
+		void createScreeningDB(const std::string& db_name, const MoleculeList& mols, bool use_writer_thread = true);
+
+		void generatePharmacophore(const CDPL::Chem::MolecularGraph& molgraph, CDPL::Pharm::Pharmacophore& pharm, std::size_t max_num_ftrs = 0);
+	}
+}
+
+#endif // CDPL_PHARM_TEST_TESTUTILS_HPP
@@ -32,6 +32,9 @@
 
 #include <boost/python.hpp>
 #include <boost/type_traits.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "GILStateGuards.hpp"
 
 
 namespace CDPLPythonBase 
@@ -76,21 +79,41 @@ namespace CDPLPythonBase
 		return MakeRef<T, boost::is_fundamental<T>::value>::make(arg);
 	}
 
+	/*
+	 * The adapters below may get copied, invoked and destroyed in threads other than the one that created them.
+	 * The wrapped Python objects are therefore shared between copies and only accessed with the GIL held.
+	 */
+	typedef boost::shared_ptr<boost::python::object> ObjectPointer;
+
+	inline void deleteObject(boost::python::object* obj)
+	{
+		GILStateLock lock;
+
+		delete obj;
+	}
+
+	inline ObjectPointer makeObjectPointer(const boost::python::object& obj)
+	{
+		return ObjectPointer(new boost::python::object(obj), &deleteObject);
+	}
+
 	template <typename ResType, typename Arg1Type, typename Arg2Type, typename Arg3Type, typename Arg4Type>
 	class QuarternaryFunctionAdapter
 	{
 
 	public:
-		QuarternaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		QuarternaryFunctionAdapter(const boost::python::object& callable): callable(makeObjectPointer(callable)) {}
 
 		ResType operator()(const Arg1Type& arg1, const Arg2Type& arg2, const Arg3Type& arg3, const Arg4Type& arg4) const {
 			using namespace boost;
 
-			return python::call<ResType>(callable.ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3), makeRef(arg4));
+			GILStateLock lock;
+
+			return python::call<ResType>(callable->ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3), makeRef(arg4));
 		}
 
 	private:
-		boost::python::object callable;
+		ObjectPointer callable;
 	};
 
 	template <typename ResType, typename Arg1Type, typename Arg2Type, typename Arg3Type, typename Arg4Type>
@@ -98,19 +121,22 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		QuarternaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		QuarternaryFunctionAdapter(const boost::python::object& callable): 
+			callable(makeObjectPointer(callable)), result(makeObjectPointer(boost::python::object())) {}
 
 		ResType& operator()(const Arg1Type& arg1, const Arg2Type& arg2, const Arg3Type& arg3, const Arg4Type& arg4) {
 			using namespace boost;
 
-			result = python::call<python::object>(callable.ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3), makeRef(arg4));
+			GILStateLock lock;
 
-			return python::extract<ResType&>(result);
+			*result = python::call<python::object>(callable->ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3), makeRef(arg4));
+
+			return python::extract<ResType&>(*result);
 		}
 
 	private:
-		boost::python::object callable;
-		boost::python::object result;
+		ObjectPointer callable;
+		ObjectPointer result;
 	};
 
 //----------
@@ -120,16 +146,18 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		TernaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		TernaryFunctionAdapter(const boost::python::object& callable): callable(makeObjectPointer(callable)) {}
 
 		ResType operator()(const Arg1Type& arg1, const Arg2Type& arg2, const Arg3Type& arg3) const {
 			using namespace boost;
 
-			return python::call<ResType>(callable.ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3));
+			GILStateLock lock;
+
+			return python::call<ResType>(callable->ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3));
 		}
 
 	private:
-		boost::python::object callable;
+		ObjectPointer callable;
 	};
 
 	template <typename ResType, typename Arg1Type, typename Arg2Type, typename Arg3Type>
@@ -137,19 +165,22 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		TernaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		TernaryFunctionAdapter(const boost::python::object& callable): 
+			callable(makeObjectPointer(callable)), result(makeObjectPointer(boost::python::object())) {}
 
 		ResType& operator()(const Arg1Type& arg1, const Arg2Type& arg2, const Arg3Type& arg3) {
 			using namespace boost;
 
-			result = python::call<python::object>(callable.ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3));
+			GILStateLock lock;
+
+			*result = python::call<python::object>(callable->ptr(), makeRef(arg1), makeRef(arg2), makeRef(arg3));
 
-			return python::extract<ResType&>(result);
+			return python::extract<ResType&>(*result);
 		}
 
 	private:
-		boost::python::object callable;
-		boost::python::object result;
+		ObjectPointer callable;
+		ObjectPointer result;
 	};
 
 //----------
@@ -159,16 +190,18 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		BinaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		BinaryFunctionAdapter(const boost::python::object& callable): callable(makeObjectPointer(callable)) {}
 
 		ResType operator()(const Arg1Type& arg1, const Arg2Type& arg2) const {
 			using namespace boost;
 
-			return python::call<ResType>(callable.ptr(), makeRef(arg1), makeRef(arg2));
+			GILStateLock lock;
+
+			return python::call<ResType>(callable->ptr(), makeRef(arg1), makeRef(arg2));
 		}
 
 	private:
-		boost::python::object callable;
+		ObjectPointer callable;
 	};
 
 	template <typename ResType, typename Arg1Type, typename Arg2Type>
@@ -176,19 +209,22 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		BinaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		BinaryFunctionAdapter(const boost::python::object& callable): 
+			callable(makeObjectPointer(callable)), result(makeObjectPointer(boost::python::object())) {}
 
 		ResType& operator()(const Arg1Type& arg1, const Arg2Type& arg2) {
 			using namespace boost;
 
-			result = python::call<python::object>(callable.ptr(), makeRef(arg1), makeRef(arg2));
+			GILStateLock lock;
+
+			*result = python::call<python::object>(callable->ptr(), makeRef(arg1), makeRef(arg2));
 
-			return python::extract<ResType&>(result);
+			return python::extract<ResType&>(*result);
 		}
 
 	private:
-		boost::python::object callable;
-		boost::python::object result;
+		ObjectPointer callable;
+		ObjectPointer result;
 	};
 
 //----------
@@ -198,16 +234,18 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		UnaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		UnaryFunctionAdapter(const boost::python::object& callable): callable(makeObjectPointer(callable)) {}
 
 		ResType operator()(const ArgType& arg) const {
 			using namespace boost;
 
-			return python::call<ResType>(callable.ptr(), makeRef(arg));
+			GILStateLock lock;
+
+			return python::call<ResType>(callable->ptr(), makeRef(arg));
 		}
 
 	private:
-		boost::python::object callable;
+		ObjectPointer callable;
 	};
 
 	template <typename ResType, typename ArgType>
@@ -215,19 +253,22 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		UnaryFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		UnaryFunctionAdapter(const boost::python::object& callable): 
+			callable(makeObjectPointer(callable)), result(makeObjectPointer(boost::python::object())) {}
 
 		ResType& operator()(const ArgType& arg) {
 			using namespace boost;
 
-			result = python::call<python::object>(callable.ptr(), makeRef(arg));
+			GILStateLock lock;
+
+			*result = python::call<python::object>(callable->ptr(), makeRef(arg));
 
-			return python::extract<ResType&>(result);
+			return python::extract<ResType&>(*result);
 		}
 
 	private:
-		boost::python::object callable;
-		boost::python::object result;
+		ObjectPointer callable;
+		ObjectPointer result;
 	};
 
 //----------
@@ -237,16 +278,18 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		NoArgFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		NoArgFunctionAdapter(const boost::python::object& callable): callable(makeObjectPointer(callable)) {}
 
 		ResType operator()() const {
 			using namespace boost;
 
-			return python::call<ResType>(callable.ptr());
+			GILStateLock lock;
+
+			return python::call<ResType>(callable->ptr());
 		}
 
 	private:
-		boost::python::object callable;
+		ObjectPointer callable;
 	};
 
 	template <typename ResType>
@@ -254,19 +297,22 @@ namespace CDPLPythonBase
 	{
 
 	public:
-		NoArgFunctionAdapter(const boost::python::object& callable): callable(callable) {}
+		NoArgFunctionAdapter(const boost::python::object& callable): 
+			callable(makeObjectPointer(callable)), result(makeObjectPointer(boost::python::object())) {}
 
 		ResType& operator()() {
 			using namespace boost;
 
-			result = python::call<python::object>(callable.ptr());
+			GILStateLock lock;
+
+			*result = python::call<python::object>(callable->ptr());
 
-			return python::extract<ResType&>(result);
+			return python::extract<ResType&>(*result);
 		}
 
 	private:
-		boost::python::object callable;
-		boost::python::object result;
+		ObjectPointer callable;
+		ObjectPointer result;
 	};
 }
 
@@ -0,0 +1,79 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * GILStateGuards.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CDPL_PYTHON_BASE_GILSTATEGUARDS_HPP
+#define CDPL_PYTHON_BASE_GILSTATEGUARDS_HPP
+
+#include <boost/python.hpp>
+
+
+namespace CDPLPythonBase 
+{
+
+	/*
+	 * Acquires the global interpreter lock for the lifetime of the object. May be used in threads
+	 * that have not been created by Python.
+	 */
+	class GILStateLock
+	{
+
+	public:
+		GILStateLock(): state(PyGILState_Ensure()) {}
+
+		~GILStateLock() {
+			PyGILState_Release(state);
+		}
+
+	private:
+		GILStateLock(const GILStateLock&);
+
+		GILStateLock& operator=(const GILStateLock&);
+
+		PyGILState_STATE state;
+	};
+
+	/*
+	 * Releases the global interpreter lock held by the current thread for the lifetime of the object.
+	 */
+	class GILStateRelease
+	{
+
+	public:
+		GILStateRelease(): threadState(PyEval_SaveThread()) {}
+
+		~GILStateRelease() {
+			PyEval_RestoreThread(threadState);
+		}
+
+	private:
+		GILStateRelease(const GILStateRelease&);
+
+		GILStateRelease& operator=(const GILStateRelease&);
+
+		PyThreadState* threadState;
+	};
+}
+
+#endif // CDPL_PYTHON_BASE_GILSTATEGUARDS_HPP
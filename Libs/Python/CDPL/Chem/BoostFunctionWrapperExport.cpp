@@ -29,6 +29,7 @@
 #include "CDPL/Chem/Entity3DMapping.hpp"
 #include "CDPL/Chem/AtomMapping.hpp"
 #include "CDPL/Chem/Entity3D.hpp"
+#include "CDPL/Chem/Molecule.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
 #include "CDPL/Chem/Atom.hpp"
 #include "CDPL/Chem/Bond.hpp"
@@ -72,6 +73,7 @@ void CDPLPythonChem::exportBoostFunctionWrappers()
 	CDPLPythonBase::BoostFunction1Export<BondPredicate, Bond&>("BondPredicate");
 	CDPLPythonBase::BoostFunction1Export<boost::function1<double, const Math::DVector&> >("DoubleDVectorFunctor"); 
 	CDPLPythonBase::BoostFunction1Export<boost::function1<bool, const MolecularGraph&> >("BoolConstMolecularGraphFunctor");
+	CDPLPythonBase::BoostFunction1Export<boost::function1<double, const MolecularGraph&> >("DoubleConstMolecularGraphFunctor");
 	CDPLPythonBase::BoostFunction1Export<boost::function1<bool, MolecularGraph&> >("BoolMolecularGraphFunctor");
 	CDPLPythonBase::BoostFunction1Export<boost::function1<void, MolecularGraph&> >("VoidMolecularGraphFunctor");
 
@@ -83,6 +85,8 @@ void CDPLPythonChem::exportBoostFunctionWrappers()
     CDPLPythonBase::BoostFunction2Export<boost::function2<Base::uint64, const Atom&, const MolecularGraph&>, Atom&, MolecularGraph&>("UInt64AtomMolecularGraphFunctor");
     CDPLPythonBase::BoostFunction2Export<boost::function2<std::size_t, const Atom&, const MolecularGraph&>, Atom&, MolecularGraph&>("SizeTypeAtomMolecularGraphFunctor");
 	CDPLPythonBase::BoostFunction2Export<boost::function2<bool, const MolecularGraph&, const AtomBondMapping&> >("BoolMolecularGraphAtomBondMappingFunctor");
+	CDPLPythonBase::BoostFunction2Export<boost::function2<bool, Molecule&, std::size_t>, Molecule&, std::size_t>("BoolMoleculeSizeTypeFunctor");
+	CDPLPythonBase::BoostFunction2Export<boost::function2<void, std::size_t, const std::string&>, std::size_t, const std::string&>("VoidSizeTypeStringFunctor");
 
 	CDPLPythonBase::BoostFunction3Export<boost::function3<double, const Math::Vector3D&, const Math::Vector3D&, const Atom&>,
 										 const Math::Vector3D&, const Math::Vector3D&, Atom&>("DoubleVector3D2AtomFunctor");
@@ -51,6 +51,7 @@ namespace CDPLPythonChem
 	void exportAtomBondMapping();
 	void exportFragmentList();
 	void exportStringDataBlock();
+	void exportConformerEnsemble();
 	void exportMassComposition();
 	void exportElementHistogram();
 	void exportStereoDescriptor();
@@ -78,6 +79,10 @@ namespace CDPLPythonChem
 	void exportReactionComponentGroupingMatchExpression();
 
 	void exportSubstructureSearch();
+	void exportSubstructureFilterSet();
+	void exportPerceptionContext();
+	void exportSubstructureSearchDatabase();
+	void exportSubstructureScreeningFingerprintGenerator();
 	void exportReactionSubstructureSearch();
 	void exportCommonConnectedSubstructureSearch();
 	void exportMaxCommonAtomSubstructureSearch();
@@ -89,6 +94,7 @@ namespace CDPLPythonChem
 	void exportAtom3DCoordinatesFunctor();
 	void exportAtomConformer3DCoordinatesFunctor();
 	void exportAtomArray3DCoordinatesFunctor();
+	void exportAtomConformerEnsemble3DCoordinatesFunctor();
 
 	void exportTopologicalEntityAlignments();
 	void exportGeometricalEntityAlignments();
@@ -169,6 +175,7 @@ namespace CDPLPythonChem
 	void exportSMILESReactionReader();
 	void exportSMILESMolecularGraphWriter();
 	void exportSMILESReactionWriter();
+	void exportSMILESBulkProcessor();
 	void exportSMARTSMoleculeReader();
 	void exportSMARTSReactionReader();
 	void exportSMARTSMolecularGraphWriter();
@@ -0,0 +1,90 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ConformerEnsembleExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/ConformerEnsemble.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/AtomContainer.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+	CDPL::Math::Vector3D getCoordinates(const CDPL::Chem::ConformerEnsemble& ensemble, std::size_t conf_idx, std::size_t atom_idx)
+	{
+		if (atom_idx >= ensemble.getNumAtoms())
+			throw CDPL::Base::IndexError("ConformerEnsemble: atom index out of bounds");
+
+		return ensemble.getCoordinates(conf_idx)[atom_idx];
+	}
+
+	void setCoordinates(CDPL::Chem::ConformerEnsemble& ensemble, std::size_t conf_idx, std::size_t atom_idx, const CDPL::Math::Vector3D& coords)
+	{
+		if (atom_idx >= ensemble.getNumAtoms())
+			throw CDPL::Base::IndexError("ConformerEnsemble: atom index out of bounds");
+
+		ensemble.getCoordinates(conf_idx)[atom_idx] = coords;
+	}
+}
+
+
+void CDPLPythonChem::exportConformerEnsemble()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	void (Chem::ConformerEnsemble::*addConformerFunc)(const Math::Vector3DArray&, double) = &Chem::ConformerEnsemble::addConformer;
+
+	python::class_<Chem::ConformerEnsemble, Chem::ConformerEnsemble::SharedPointer>("ConformerEnsemble", python::no_init)
+		.def(python::init<const Chem::ConformerEnsemble&>((python::arg("self"), python::arg("ensemble"))))
+		.def(python::init<std::size_t>((python::arg("self"), python::arg("num_atoms") = 0)))
+		.def(python::init<const Chem::MolecularGraph&>((python::arg("self"), python::arg("molgraph"))))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::ConformerEnsemble>())	
+		.def("assign", &Chem::ConformerEnsemble::assign, (python::arg("self"), python::arg("molgraph")))
+		.def("clear", &Chem::ConformerEnsemble::clear, python::arg("self"))
+		.def("setNumAtoms", &Chem::ConformerEnsemble::setNumAtoms, (python::arg("self"), python::arg("num_atoms")))
+		.def("getNumAtoms", &Chem::ConformerEnsemble::getNumAtoms, python::arg("self"))
+		.def("getNumConformers", &Chem::ConformerEnsemble::getNumConformers, python::arg("self"))
+		.def("reserve", &Chem::ConformerEnsemble::reserve, (python::arg("self"), python::arg("num_confs")))
+		.def("addConformer", addConformerFunc, (python::arg("self"), python::arg("coords"), python::arg("energy") = 0.0))
+		.def("removeConformer", &Chem::ConformerEnsemble::removeConformer, (python::arg("self"), python::arg("conf_idx")))
+		.def("getCoordinates", &getCoordinates, (python::arg("self"), python::arg("conf_idx"), python::arg("atom_idx")))
+		.def("setCoordinates", &setCoordinates, (python::arg("self"), python::arg("conf_idx"), python::arg("atom_idx"), python::arg("coords")))
+		.def("getEnergy", &Chem::ConformerEnsemble::getEnergy, (python::arg("self"), python::arg("conf_idx")))
+		.def("setEnergy", &Chem::ConformerEnsemble::setEnergy, (python::arg("self"), python::arg("conf_idx"), python::arg("energy")))
+		.def("getConformer", &Chem::ConformerEnsemble::getConformer, 
+			 (python::arg("self"), python::arg("conf_idx"), python::arg("coords"), python::arg("append") = false))
+		.def("applyConformer", &Chem::ConformerEnsemble::applyConformer, (python::arg("self"), python::arg("conf_idx"), python::arg("cntnr")))
+		.add_property("numAtoms", &Chem::ConformerEnsemble::getNumAtoms, &Chem::ConformerEnsemble::setNumAtoms)
+		.add_property("numConformers", &Chem::ConformerEnsemble::getNumConformers);
+}
@@ -84,6 +84,10 @@ namespace CDPLPythonChem
 					 (python::arg("self"), python::arg("min_size")))
 				.def("getMinTopologicalMappingSize", &AlignmentType::getMinTopologicalMappingSize,
 					 python::arg("self"))
+				.def("orderTopologicalMappingsBySize", &AlignmentType::orderTopologicalMappingsBySize,
+					 (python::arg("self"), python::arg("order")))
+				.def("topologicalMappingsOrderedBySize", &AlignmentType::topologicalMappingsOrderedBySize,
+					 python::arg("self"))
 				.def("init", &AlignmentType::init, python::arg("self"))
 				.def("nextAlignment", &AlignmentType::nextAlignment, 
 					 python::arg("self"))
@@ -93,6 +97,8 @@ namespace CDPLPythonChem
 					 (python::arg("self"), python::arg("alignment")), python::return_self<python::with_custodian_and_ward<1, 2> >())
 				.add_property("minTopologicalMappingSize", &AlignmentType::getMinTopologicalMappingSize,
 					  &AlignmentType::setMinTopologicalMappingSize)
+				.add_property("orderedTopologicalMappings", &AlignmentType::topologicalMappingsOrderedBySize,
+					  &AlignmentType::orderTopologicalMappingsBySize)
 				.add_property("entityMatchFunction", 
 							  python::make_function(&AlignmentType::getEntityMatchFunction, python::return_internal_reference<>()),
 							  &AlignmentType::setEntityMatchFunction)
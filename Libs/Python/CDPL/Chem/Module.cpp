@@ -56,6 +56,7 @@ BOOST_PYTHON_MODULE(_chem)
 	exportAtomBondMapping();
 	exportFragmentList();
 	exportStringDataBlock();
+	exportConformerEnsemble();
 	exportMassComposition();
 	exportElementHistogram();
 	exportStereoDescriptor();
@@ -66,6 +67,7 @@ BOOST_PYTHON_MODULE(_chem)
 	exportAtom3DCoordinatesFunctor();
 	exportAtomConformer3DCoordinatesFunctor();
 	exportAtomArray3DCoordinatesFunctor();
+	exportAtomConformerEnsemble3DCoordinatesFunctor();
 
 	exportMatchConstraintList();
 	exportMatchExpressions();
@@ -85,6 +87,10 @@ BOOST_PYTHON_MODULE(_chem)
 	exportReactionComponentGroupingMatchExpression();
 
 	exportSubstructureSearch();
+	exportSubstructureFilterSet();
+	exportPerceptionContext();
+	exportSubstructureSearchDatabase();
+	exportSubstructureScreeningFingerprintGenerator();
 	exportReactionSubstructureSearch();
 	exportCommonConnectedSubstructureSearch();
 	exportMaxCommonAtomSubstructureSearch();
@@ -172,6 +178,7 @@ BOOST_PYTHON_MODULE(_chem)
 	exportSMILESReactionReader();
 	exportSMILESMolecularGraphWriter();
 	exportSMILESReactionWriter();
+	exportSMILESBulkProcessor();
 	exportSMARTSMoleculeReader();
 	exportSMARTSReactionReader();
 	exportSMARTSMolecularGraphWriter();
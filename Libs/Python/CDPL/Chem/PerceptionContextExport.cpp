@@ -0,0 +1,68 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PerceptionContextExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/PerceptionContext.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonChem::exportPerceptionContext()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	python::class_<Chem::PerceptionContext, Chem::PerceptionContext::SharedPointer, boost::noncopyable>("PerceptionContext", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(python::init<Chem::MolecularGraph&>((python::arg("self"), python::arg("molgraph")))
+			 [python::with_custodian_and_ward<1, 2>()])
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::PerceptionContext>())	
+		.def("setMolecularGraph", &Chem::PerceptionContext::setMolecularGraph, (python::arg("self"), python::arg("molgraph")),
+			 python::with_custodian_and_ward<1, 2>())
+		.def("getMolecularGraph", &Chem::PerceptionContext::getMolecularGraph, python::arg("self"),
+			 python::return_value_policy<python::reference_existing_object>())
+		.def("update", &Chem::PerceptionContext::update, python::arg("self"))
+		.def("clear", &Chem::PerceptionContext::clear, python::arg("self"))
+		.def("perceiveComponents", &Chem::PerceptionContext::perceiveComponents, python::arg("self"),
+			 python::return_value_policy<python::copy_const_reference>())
+		.def("perceiveSSSR", &Chem::PerceptionContext::perceiveSSSR, python::arg("self"),
+			 python::return_value_policy<python::copy_const_reference>())
+		.def("setRingFlags", &Chem::PerceptionContext::setRingFlags, python::arg("self"))
+		.def("perceiveHybridizationStates", &Chem::PerceptionContext::perceiveHybridizationStates, python::arg("self"))
+		.def("setAromaticityFlags", &Chem::PerceptionContext::setAromaticityFlags, python::arg("self"))
+		.def("calcCIPPriorities", &Chem::PerceptionContext::calcCIPPriorities, python::arg("self"))
+		.def("generateMorganNumbering", &Chem::PerceptionContext::generateMorganNumbering, python::arg("self"))
+		.def("generateCanonicalNumbering", &Chem::PerceptionContext::generateCanonicalNumbering, 
+			 (python::arg("self"), python::arg("atom_flags") = Chem::AtomPropertyFlag::DEFAULT, 
+			  python::arg("bond_flags") = Chem::BondPropertyFlag::DEFAULT))
+		.def("perceiveAll", &Chem::PerceptionContext::perceiveAll, python::arg("self"))
+		.add_property("molGraph", python::make_function(&Chem::PerceptionContext::getMolecularGraph,
+														python::return_value_policy<python::reference_existing_object>()));
+}
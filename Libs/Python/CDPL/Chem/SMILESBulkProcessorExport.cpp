@@ -0,0 +1,107 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SMILESBulkProcessorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/SMILESBulkProcessor.hpp"
+#include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/GILStateGuards.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+	bool parseMolecule(CDPL::Chem::SMILESBulkProcessor& proc, const std::string& rec, CDPL::Chem::Molecule& mol)
+	{
+		return proc.parseMolecule(rec, mol);
+	}
+
+	std::string generateSMILES(CDPL::Chem::SMILESBulkProcessor& proc, CDPL::Chem::MolecularGraph& molgraph)
+	{
+		std::string smiles;
+
+		proc.generateSMILES(molgraph, smiles);
+
+		return smiles;
+	}
+
+	std::string process(CDPL::Chem::SMILESBulkProcessor& proc, const std::string& input)
+	{
+		std::string output;
+		CDPLPythonBase::GILStateRelease gil_release;
+
+		proc.process(input, output);
+
+		return output;
+	}
+}
+
+
+void CDPLPythonChem::exportSMILESBulkProcessor()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	python::class_<Chem::SMILESBulkProcessor, Chem::SMILESBulkProcessor::SharedPointer, 
+				   python::bases<Base::DataIOBase>, boost::noncopyable>("SMILESBulkProcessor", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::SMILESBulkProcessor>())	
+		.def("setNumThreads", &Chem::SMILESBulkProcessor::setNumThreads, (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &Chem::SMILESBulkProcessor::getNumThreads, python::arg("self"))
+		.def("setChunkSize", &Chem::SMILESBulkProcessor::setChunkSize, (python::arg("self"), python::arg("num_records")))
+		.def("getChunkSize", &Chem::SMILESBulkProcessor::getChunkSize, python::arg("self"))
+		.def("setBlockSize", &Chem::SMILESBulkProcessor::setBlockSize, (python::arg("self"), python::arg("num_bytes")))
+		.def("getBlockSize", &Chem::SMILESBulkProcessor::getBlockSize, python::arg("self"))
+		.def("prepareMolecules", &Chem::SMILESBulkProcessor::prepareMolecules, (python::arg("self"), python::arg("prepare")))
+		.def("moleculesPrepared", &Chem::SMILESBulkProcessor::moleculesPrepared, python::arg("self"))
+		.def("setProcessingFunction", &Chem::SMILESBulkProcessor::setProcessingFunction, (python::arg("self"), python::arg("func")))
+		.def("getProcessingFunction", &Chem::SMILESBulkProcessor::getProcessingFunction, python::arg("self"),
+			 python::return_internal_reference<>())
+		.def("setErrorFunction", &Chem::SMILESBulkProcessor::setErrorFunction, (python::arg("self"), python::arg("func")))
+		.def("getErrorFunction", &Chem::SMILESBulkProcessor::getErrorFunction, python::arg("self"),
+			 python::return_internal_reference<>())
+		.def("getNumFailedRecords", &Chem::SMILESBulkProcessor::getNumFailedRecords, python::arg("self"))
+		.def("parseMolecule", &parseMolecule, (python::arg("self"), python::arg("rec"), python::arg("mol")))
+		.def("generateSMILES", &generateSMILES, (python::arg("self"), python::arg("molgraph")))
+		.def("process", &process, (python::arg("self"), python::arg("input")))
+		.add_property("numThreads", &Chem::SMILESBulkProcessor::getNumThreads, &Chem::SMILESBulkProcessor::setNumThreads)
+		.add_property("chunkSize", &Chem::SMILESBulkProcessor::getChunkSize, &Chem::SMILESBulkProcessor::setChunkSize)
+		.add_property("blockSize", &Chem::SMILESBulkProcessor::getBlockSize, &Chem::SMILESBulkProcessor::setBlockSize)
+		.add_property("prepMolecules", &Chem::SMILESBulkProcessor::moleculesPrepared, &Chem::SMILESBulkProcessor::prepareMolecules)
+		.add_property("processingFunction", python::make_function(&Chem::SMILESBulkProcessor::getProcessingFunction,
+																  python::return_internal_reference<>()),
+					  &Chem::SMILESBulkProcessor::setProcessingFunction)
+		.add_property("errorFunction", python::make_function(&Chem::SMILESBulkProcessor::getErrorFunction,
+															 python::return_internal_reference<>()),
+					  &Chem::SMILESBulkProcessor::setErrorFunction)
+		.add_property("numFailedRecords", &Chem::SMILESBulkProcessor::getNumFailedRecords);
+}
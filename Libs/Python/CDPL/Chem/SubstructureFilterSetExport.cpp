@@ -0,0 +1,62 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureFilterSetExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/SubstructureFilterSet.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonChem::exportSubstructureFilterSet()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	bool (Chem::SubstructureFilterSet::*targetsInitializedFunc)() const = &Chem::SubstructureFilterSet::targetsInitialized;
+	std::size_t (Chem::SubstructureFilterSet::*filterFunc)(Chem::MolecularGraph&, Util::BitSet&) = &Chem::SubstructureFilterSet::filter;
+
+	python::class_<Chem::SubstructureFilterSet, Chem::SubstructureFilterSet::SharedPointer, boost::noncopyable>("SubstructureFilterSet", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::SubstructureFilterSet>())	
+		.def("addPattern", &Chem::SubstructureFilterSet::addPattern, (python::arg("self"), python::arg("pattern")))
+		.def("getPattern", &Chem::SubstructureFilterSet::getPattern, (python::arg("self"), python::arg("idx")),
+			 python::return_value_policy<python::copy_const_reference>())
+		.def("removePattern", &Chem::SubstructureFilterSet::removePattern, (python::arg("self"), python::arg("idx")))
+		.def("clear", &Chem::SubstructureFilterSet::clear, python::arg("self"))
+		.def("getNumPatterns", &Chem::SubstructureFilterSet::getNumPatterns, python::arg("self"))
+		.def("initializeTargets", &Chem::SubstructureFilterSet::initializeTargets, (python::arg("self"), python::arg("init")))
+		.def("targetsInitialized", targetsInitializedFunc, python::arg("self"))
+		.def("setNumThreads", &Chem::SubstructureFilterSet::setNumThreads, (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &Chem::SubstructureFilterSet::getNumThreads, python::arg("self"))
+		.def("filter", filterFunc, (python::arg("self"), python::arg("molgraph"), python::arg("hit_mask")))
+		.add_property("numPatterns", &Chem::SubstructureFilterSet::getNumPatterns)
+		.add_property("initTargets", targetsInitializedFunc, &Chem::SubstructureFilterSet::initializeTargets)
+		.add_property("numThreads", &Chem::SubstructureFilterSet::getNumThreads, &Chem::SubstructureFilterSet::setNumThreads);
+}
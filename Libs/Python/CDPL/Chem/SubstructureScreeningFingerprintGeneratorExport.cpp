@@ -0,0 +1,61 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureScreeningFingerprintGeneratorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/SubstructureScreeningFingerprintGenerator.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/CopyAssOp.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonChem::exportSubstructureScreeningFingerprintGenerator()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	python::class_<Chem::SubstructureScreeningFingerprintGenerator>("SubstructureScreeningFingerprintGenerator", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(python::init<const Chem::SubstructureScreeningFingerprintGenerator&>((python::arg("self"), python::arg("gen"))))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::SubstructureScreeningFingerprintGenerator>())	
+		.def("assign", CDPLPythonBase::copyAssOp(&Chem::SubstructureScreeningFingerprintGenerator::operator=), 
+			 (python::arg("self"), python::arg("gen")), python::return_self<>())
+		.def("setMaxPathLength", &Chem::SubstructureScreeningFingerprintGenerator::setMaxPathLength, 
+			 (python::arg("self"), python::arg("max_length")))
+		.def("setNumBits", &Chem::SubstructureScreeningFingerprintGenerator::setNumBits, 
+			 (python::arg("self"), python::arg("num_bits")))
+		.def("getMaxPathLength", &Chem::SubstructureScreeningFingerprintGenerator::getMaxPathLength, python::arg("self"))
+		.def("getNumBits", &Chem::SubstructureScreeningFingerprintGenerator::getNumBits, python::arg("self"))
+		.def("generateTargetFingerprint", &Chem::SubstructureScreeningFingerprintGenerator::generateTargetFingerprint,
+			 (python::arg("self"), python::arg("molgraph"), python::arg("fp")))
+		.def("generateQueryFingerprint", &Chem::SubstructureScreeningFingerprintGenerator::generateQueryFingerprint,
+			 (python::arg("self"), python::arg("query"), python::arg("fp")))
+		.add_property("maxPathLength", &Chem::SubstructureScreeningFingerprintGenerator::getMaxPathLength,
+					  &Chem::SubstructureScreeningFingerprintGenerator::setMaxPathLength)
+		.add_property("numBits", &Chem::SubstructureScreeningFingerprintGenerator::getNumBits,
+					  &Chem::SubstructureScreeningFingerprintGenerator::setNumBits);
+}
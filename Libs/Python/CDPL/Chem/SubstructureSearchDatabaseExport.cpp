@@ -0,0 +1,96 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * SubstructureSearchDatabaseExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/SubstructureSearchDatabase.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Molecule.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+	boost::python::list toList(const CDPL::Chem::SubstructureSearchDatabase::MoleculeIndexList& indices)
+	{
+		boost::python::list list;
+
+		for (CDPL::Chem::SubstructureSearchDatabase::MoleculeIndexList::const_iterator it = indices.begin(), end = indices.end(); it != end; ++it)
+			list.append(*it);
+
+		return list;
+	}
+
+	boost::python::list screen(const CDPL::Chem::SubstructureSearchDatabase& db, CDPL::Chem::MolecularGraph& query)
+	{
+		CDPL::Chem::SubstructureSearchDatabase::MoleculeIndexList cands;
+
+		db.screen(query, cands);
+
+		return toList(cands);
+	}
+
+	boost::python::list findMatches(const CDPL::Chem::SubstructureSearchDatabase& db, CDPL::Chem::MolecularGraph& query, std::size_t max_num_hits)
+	{
+		CDPL::Chem::SubstructureSearchDatabase::MoleculeIndexList hits;
+
+		db.findMatches(query, hits, max_num_hits);
+
+		return toList(hits);
+	}
+}
+
+
+void CDPLPythonChem::exportSubstructureSearchDatabase()
+{
+	using namespace boost;
+	using namespace CDPL;
+
+	python::class_<Chem::SubstructureSearchDatabase, Chem::SubstructureSearchDatabase::SharedPointer, boost::noncopyable>("SubstructureSearchDatabase", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::SubstructureSearchDatabase>())	
+		.def("setNumThreads", &Chem::SubstructureSearchDatabase::setNumThreads, (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &Chem::SubstructureSearchDatabase::getNumThreads, python::arg("self"))
+		.def("getNumFingerprintBits", &Chem::SubstructureSearchDatabase::getNumFingerprintBits, python::arg("self"))
+		.def("getNumMolecules", &Chem::SubstructureSearchDatabase::getNumMolecules, python::arg("self"))
+		.def("addMolecule", &Chem::SubstructureSearchDatabase::addMolecule, (python::arg("self"), python::arg("molgraph")))
+		.def("getMolecule", &Chem::SubstructureSearchDatabase::getMolecule, (python::arg("self"), python::arg("idx"), python::arg("mol")))
+		.def("getFingerprint", &Chem::SubstructureSearchDatabase::getFingerprint, (python::arg("self"), python::arg("idx"), python::arg("fp")))
+		.def("screen", &screen, (python::arg("self"), python::arg("query")))
+		.def("findMatches", &findMatches, (python::arg("self"), python::arg("query"), python::arg("max_num_hits") = 0))
+		.def("clear", &Chem::SubstructureSearchDatabase::clear, python::arg("self"))
+		.def("save", &Chem::SubstructureSearchDatabase::save, (python::arg("self"), python::arg("file_name")))
+		.def("open", &Chem::SubstructureSearchDatabase::open, (python::arg("self"), python::arg("file_name")))
+		.def("getFileName", &Chem::SubstructureSearchDatabase::getFileName, python::arg("self"),
+			 python::return_value_policy<python::copy_const_reference>())
+		.add_property("numThreads", &Chem::SubstructureSearchDatabase::getNumThreads, &Chem::SubstructureSearchDatabase::setNumThreads)
+		.add_property("numFingerprintBits", &Chem::SubstructureSearchDatabase::getNumFingerprintBits)
+		.add_property("numMolecules", &Chem::SubstructureSearchDatabase::getNumMolecules)
+		.add_property("fileName", python::make_function(&Chem::SubstructureSearchDatabase::getFileName,
+														python::return_value_policy<python::copy_const_reference>()));
+}
@@ -30,10 +30,22 @@
 #include "CDPL/Chem/MolecularGraph.hpp"
 
 #include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/GILStateGuards.hpp"
 
 #include "ClassExports.hpp"
 
 
+namespace
+{
+
+    void generate(CDPL::Chem::TautomerGenerator& gen, const CDPL::Chem::MolecularGraph& molgraph)
+    {
+		CDPLPythonBase::GILStateRelease gil_release;
+
+		gen.generate(molgraph);
+    }
+}
+
 void CDPLPythonChem::exportTautomerGenerator()
 {
     using namespace boost;
@@ -73,7 +85,18 @@ void CDPLPythonChem::exportTautomerGenerator()
 	.def("regardIsotopes", &Chem::TautomerGenerator::regardIsotopes, (python::arg("self"), python::arg("regard")))
 	.def("isotopesRegarded", &Chem::TautomerGenerator::isotopesRegarded, python::arg("self"))
 	.def("setCustomSetupFunction", &Chem::TautomerGenerator::setCustomSetupFunction, (python::arg("self"), python::arg("func")))
-	.def("generate", &Chem::TautomerGenerator::generate, 
+	.def("setNumThreads", &Chem::TautomerGenerator::setNumThreads, (python::arg("self"), python::arg("num_threads")))
+	.def("getNumThreads", &Chem::TautomerGenerator::getNumThreads, python::arg("self"))
+	.def("setMaxNumTautomers", &Chem::TautomerGenerator::setMaxNumTautomers, (python::arg("self"), python::arg("max_num")))
+	.def("getMaxNumTautomers", &Chem::TautomerGenerator::getMaxNumTautomers, python::arg("self"))
+	.def("setMaxFrontierSize", &Chem::TautomerGenerator::setMaxFrontierSize, (python::arg("self"), python::arg("max_size")))
+	.def("getMaxFrontierSize", &Chem::TautomerGenerator::getMaxFrontierSize, python::arg("self"))
+	.def("setMaxMemoryUsage", &Chem::TautomerGenerator::setMaxMemoryUsage, (python::arg("self"), python::arg("max_bytes")))
+	.def("getMaxMemoryUsage", &Chem::TautomerGenerator::getMaxMemoryUsage, python::arg("self"))
+	.def("setScoringFunction", &Chem::TautomerGenerator::setScoringFunction, (python::arg("self"), python::arg("func")))
+	.def("getScoringFunction", &Chem::TautomerGenerator::getScoringFunction, 
+	     python::arg("self"), python::return_internal_reference<>())
+	.def("generate", &generate, 
 	     (python::arg("self"), python::arg("molgraph")))
 	.def("assign", &Chem::TautomerGenerator::operator=, 
 	     (python::arg("self"), python::arg("gen")), python::return_self<>())
@@ -83,5 +106,12 @@ void CDPLPythonChem::exportTautomerGenerator()
 	.add_property("mode", &Chem::TautomerGenerator::getMode, &Chem::TautomerGenerator::setMode)
 	.add_property("regStereo", &Chem::TautomerGenerator::stereochemistryRegarded, &Chem::TautomerGenerator::regardStereochemistry)
 	.add_property("regIsotopes", &Chem::TautomerGenerator::isotopesRegarded, &Chem::TautomerGenerator::regardIsotopes)
+	.add_property("scoringFunction", python::make_function(&Chem::TautomerGenerator::getScoringFunction,
+							       python::return_internal_reference<>()),
+		      &Chem::TautomerGenerator::setScoringFunction)
+	.add_property("numThreads", &Chem::TautomerGenerator::getNumThreads, &Chem::TautomerGenerator::setNumThreads)
+	.add_property("maxNumTautomers", &Chem::TautomerGenerator::getMaxNumTautomers, &Chem::TautomerGenerator::setMaxNumTautomers)
+	.add_property("maxFrontierSize", &Chem::TautomerGenerator::getMaxFrontierSize, &Chem::TautomerGenerator::setMaxFrontierSize)
+	.add_property("maxMemoryUsage", &Chem::TautomerGenerator::getMaxMemoryUsage, &Chem::TautomerGenerator::setMaxMemoryUsage)
 	.add_property("numTautomerizationRules", &Chem::TautomerGenerator::getNumTautomerizationRules);
 }
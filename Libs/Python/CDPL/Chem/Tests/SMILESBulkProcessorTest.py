@@ -0,0 +1,82 @@
+# -*- mode: python; tab-width: 4 -*-
+
+## 
+# SMILESBulkProcessorTest.py 
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+##
+
+
+import unittest
+import threading
+
+from CDPL.Chem import SMILESBulkProcessor
+
+
+class TestCase(unittest.TestCase):
+
+    def runTest(self):
+        """Testing SMILESBulkProcessor with Python callbacks and multiple threads"""
+
+        input = 'CCO\nc1ccccc1\nCC[Cl\nCC(=O)O\nCCN\nC1CCCCC1\nCCCl\nCOC\n' * 8
+        num_records = input.count('\n')
+        num_failed = input.count('CC[Cl')
+
+        lock = threading.Lock()
+        proc_rec_indices = []
+        failed_rec_indices = []
+
+        def processMolecule(mol, rec_idx):
+            with lock:
+                proc_rec_indices.append(rec_idx)
+
+            return (rec_idx % 2 == 0)
+
+        def recordError(rec_idx, msg):
+            failed_rec_indices.append(rec_idx)
+
+        proc = SMILESBulkProcessor()
+
+        proc.setProcessingFunction(processMolecule)
+        proc.setErrorFunction(recordError)
+        proc.setChunkSize(4)
+
+        proc.setNumThreads(1)
+
+        st_output = proc.process(input)
+
+        self.assert_(sorted(proc_rec_indices) == [i for i in range(num_records) if i % 8 != 2])
+        self.assert_(failed_rec_indices == [i for i in range(num_records) if i % 8 == 2])
+        self.assert_(proc.getNumFailedRecords() == num_failed)
+
+        # the processing function gets called from the worker threads
+
+        for num_threads in [2, 4]:
+            del proc_rec_indices[:]
+            del failed_rec_indices[:]
+
+            proc.setNumThreads(num_threads)
+
+            mt_output = proc.process(input)
+
+            self.assert_(mt_output == st_output)
+            self.assert_(sorted(proc_rec_indices) == [i for i in range(num_records) if i % 8 != 2])
+            self.assert_(failed_rec_indices == [i for i in range(num_records) if i % 8 == 2])
+            self.assert_(proc.getNumFailedRecords() == num_failed)
@@ -29,6 +29,6 @@ import unittest
 
 test_suite = unittest.TestSuite()
 
-#test_suite.addTests(unittest.defaultTestLoader.loadTestsFromName(""))
+test_suite.addTests(unittest.defaultTestLoader.loadTestsFromName("SMILESBulkProcessorTest"))
 
 unittest.TextTestRunner(verbosity=2).run(test_suite)
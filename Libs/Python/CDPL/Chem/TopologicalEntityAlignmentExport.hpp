@@ -67,6 +67,10 @@ namespace CDPLPythonChem
 				.def("getNumEntities", &AlignmentType::getNumEntities, 
 					 (python::arg("self"), python::arg("first_set")))
 				.def("getEntities", &getEntitiesFunc, (python::arg("self"), python::arg("first_set")))
+				.def("orderCliquesBySize", &AlignmentType::orderCliquesBySize, 
+					 (python::arg("self"), python::arg("order")))
+				.def("cliquesOrderedBySize", &AlignmentType::cliquesOrderedBySize, 
+					 python::arg("self"))
 				.def("init", &AlignmentType::init, python::arg("self"))
 				.def("nextAlignment", &AlignmentType::nextAlignment, 
 					 (python::arg("self"), python::arg("mapping")))
@@ -77,7 +81,8 @@ namespace CDPLPythonChem
 							  &AlignmentType::setEntityMatchFunction)
 				.add_property("entityPairMatchFunction", 
 							  python::make_function(&AlignmentType::getEntityPairMatchFunction, python::return_internal_reference<>()),
-							  &AlignmentType::setEntityPairMatchFunction);
+							  &AlignmentType::setEntityPairMatchFunction)
+				.add_property("orderedCliques", &AlignmentType::cliquesOrderedBySize, &AlignmentType::orderCliquesBySize);
 
 		}
 
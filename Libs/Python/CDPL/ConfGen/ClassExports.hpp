@@ -39,6 +39,8 @@ namespace CDPLPythonConfGen
 	void exportDGStructureGeneratorSettings();
 	void exportFragmentLibraryEntry();
 	void exportFragmentLibrary();
+	void exportFragmentLibraryMerger();
+	void exportProcessingStatistics();
 	void exportConformerData();
 	void exportTorsionRule();
 	void exportTorsionCategory();
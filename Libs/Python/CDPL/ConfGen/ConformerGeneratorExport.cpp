@@ -30,11 +30,23 @@
 #include "CDPL/Chem/MolecularGraph.hpp"
 
 #include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/GILStateGuards.hpp"
 //#include "Base/CopyAssOp.hpp"
 
 #include "ClassExports.hpp"
 
 
+namespace
+{
+
+	unsigned int generate(CDPL::ConfGen::ConformerGenerator& gen, const CDPL::Chem::MolecularGraph& molgraph)
+	{
+		CDPLPythonBase::GILStateRelease gil_release;
+
+		return gen.generate(molgraph);
+	}
+}
+
 void CDPLPythonConfGen::exportConformerGenerator()
 {
     using namespace boost;
@@ -46,7 +58,7 @@ void CDPLPythonConfGen::exportConformerGenerator()
 		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<ConfGen::ConformerGenerator>())
 //		.def("assign", CDPLPythonBase::copyAssOp(&ConfGen::ConformerGenerator::operator=), 
 //			 (python::arg("self"), python::arg("gen")), python::return_self<>())
-		.def("generate", &ConfGen::ConformerGenerator::generate, 
+		.def("generate", &generate, 
 			 (python::arg("self"), python::arg("molgraph")))
 		.def("getSettings", 
 			 static_cast<ConfGen::ConformerGeneratorSettings& (ConfGen::ConformerGenerator::*)()>
@@ -72,7 +84,7 @@ void CDPLPythonConfGen::exportConformerGenerator()
 			 (python::arg("self"), python::arg("func")))
 		.def("getLogMessageCallback", &ConfGen::ConformerGenerator::getLogMessageCallback, 
 			 python::arg("self"), python::return_internal_reference<>())
-		.def("generate", &ConfGen::ConformerGenerator::generate, (python::arg("self"), python::arg("molgraph")))
+		.def("generate", &generate, (python::arg("self"), python::arg("molgraph")))
 		.def("setConformers", &ConfGen::ConformerGenerator::setConformers,
 			 (python::arg("self"), python::arg("molgraph")))
 		.def("getNumConformers", &ConfGen::ConformerGenerator::getNumConformers, python::arg("self"))
@@ -82,7 +94,15 @@ void CDPLPythonConfGen::exportConformerGenerator()
 		.def("__getitem__", 
 			 static_cast<ConfGen::ConformerData& (ConfGen::ConformerGenerator::*)(std::size_t)>(&ConfGen::ConformerGenerator::getConformer),
 			 (python::arg("self"), python::arg("conf_idx")), python::return_internal_reference<>())
+		.def("enableStatistics", &ConfGen::ConformerGenerator::enableStatistics, 
+			 (python::arg("self"), python::arg("enable")))
+		.def("statisticsEnabled", &ConfGen::ConformerGenerator::statisticsEnabled, python::arg("self"))
+		.def("getStatistics", &ConfGen::ConformerGenerator::getStatistics, 
+			 python::arg("self"), python::return_internal_reference<>())
+		.def("clearStatistics", &ConfGen::ConformerGenerator::clearStatistics, python::arg("self"))
 		.add_property("numConformers", &ConfGen::ConformerGenerator::getNumConformers)
+		.add_property("statistics", python::make_function(&ConfGen::ConformerGenerator::getStatistics,
+														  python::return_internal_reference<>()))
 		.add_property("settings", 
 					  python::make_function(static_cast<ConfGen::ConformerGeneratorSettings& (ConfGen::ConformerGenerator::*)()>
 											(&ConfGen::ConformerGenerator::getSettings),
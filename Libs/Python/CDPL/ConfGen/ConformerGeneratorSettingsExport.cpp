@@ -84,6 +84,10 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
 			 (python::arg("self"), python::arg("max_size")))
 		.def("getMaxPoolSize", &ConfGen::ConformerGeneratorSettings::getMaxPoolSize, 
 			 python::arg("self"))
+		.def("setNumThreads", &ConfGen::ConformerGeneratorSettings::setNumThreads, 
+			 (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &ConfGen::ConformerGeneratorSettings::getNumThreads, 
+			 python::arg("self"))
 		.def("setTimeout", &ConfGen::ConformerGeneratorSettings::setTimeout, 
 			 (python::arg("self"), python::arg("mil_secs")))
 		.def("getTimeout", &ConfGen::ConformerGeneratorSettings::getTimeout, 
@@ -100,6 +104,10 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
 			 (python::arg("self"), python::arg("strict")))
 		.def("strictForceFieldParameterization", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization), 
 			 python::arg("self"))
+		.def("cacheForceFieldParameterization", SetBoolFunc(&ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization), 
+			 (python::arg("self"), python::arg("cache")))
+		.def("cacheForceFieldParameterization", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization), 
+			 python::arg("self"))
 		.def("setDielectricConstant", &ConfGen::ConformerGeneratorSettings::setDielectricConstant, 
 			 (python::arg("self"), python::arg("de_const")))
 		.def("getDielectricConstant", &ConfGen::ConformerGeneratorSettings::getDielectricConstant, 
@@ -165,6 +173,8 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
 					  &ConfGen::ConformerGeneratorSettings::setEnergyWindow)
 		.add_property("maxPoolSize", &ConfGen::ConformerGeneratorSettings::getMaxPoolSize,
 					  &ConfGen::ConformerGeneratorSettings::setMaxPoolSize)
+		.add_property("numThreads", &ConfGen::ConformerGeneratorSettings::getNumThreads,
+					  &ConfGen::ConformerGeneratorSettings::setNumThreads)
 		.add_property("timeout", &ConfGen::ConformerGeneratorSettings::getTimeout,
 					  &ConfGen::ConformerGeneratorSettings::setTimeout)
 		.add_property("forceFieldTypeSystematic", &ConfGen::ConformerGeneratorSettings::getForceFieldTypeSystematic, 
@@ -173,6 +183,8 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
 					  &ConfGen::ConformerGeneratorSettings::setForceFieldTypeStochastic)
 		.add_property("strictForceFieldParam", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization), 
 					  SetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization))
+		.add_property("cacheForceFieldParam", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization), 
+					  SetBoolFunc(&ConfGen::ConformerGeneratorSettings::cacheForceFieldParameterization))
 		.add_property("dielectricConstant", &ConfGen::ConformerGeneratorSettings::getDielectricConstant, 
 					  &ConfGen::ConformerGeneratorSettings::setDielectricConstant)
 		.add_property("distanceExponent", &ConfGen::ConformerGeneratorSettings::getDistanceExponent, 
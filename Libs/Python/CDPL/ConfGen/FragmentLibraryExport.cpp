@@ -78,14 +78,20 @@ void CDPLPythonConfGen::exportFragmentLibrary()
 		.def("load", &ConfGen::FragmentLibrary::load, (python::arg("self"), python::arg("is"))) 
 		.def("loadDefaults", &ConfGen::FragmentLibrary::loadDefaults, python::arg("self")) 
 		.def("save", &ConfGen::FragmentLibrary::save, (python::arg("self"), python::arg("os"))) 
+		.def("loadIndexed", &ConfGen::FragmentLibrary::loadIndexed, (python::arg("self"), python::arg("file_name"))) 
+		.def("saveIndexed", &ConfGen::FragmentLibrary::saveIndexed, (python::arg("self"), python::arg("os"))) 
+		.def("isIndexed", &ConfGen::FragmentLibrary::isIndexed, python::arg("self")) 
 		.def("assign", CDPLPythonBase::copyAssOp(&ConfGen::FragmentLibrary::operator=), 
 			 (python::arg("self"), python::arg("lib")), python::return_self<>())
 		.add_property("numEntries", &ConfGen::FragmentLibrary::getNumEntries)
 		.add_property("entries", python::make_function(&getEntries))
+		.add_property("indexed", &ConfGen::FragmentLibrary::isIndexed)
 		.def("set", &ConfGen::FragmentLibrary::set, python::arg("lib"))
 		.staticmethod("set")
 		.def("get", &ConfGen::FragmentLibrary::get, python::return_value_policy<python::copy_const_reference>())
-		.staticmethod("get");
+		.staticmethod("get")
+		.def("isIndexedFile", &ConfGen::FragmentLibrary::isIndexedFile, python::arg("file_name"))
+		.staticmethod("isIndexedFile");
 
     python::class_<ConfGen::FragmentLibrary::Entry>("Entry", python::no_init)
 		.def(python::init<>(python::arg("self")))
@@ -0,0 +1,76 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * FragmentLibraryMergerExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/ConfGen/FragmentLibraryMerger.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonConfGen::exportFragmentLibraryMerger()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+	python::class_<ConfGen::FragmentLibraryMerger, boost::noncopyable>("FragmentLibraryMerger", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<ConfGen::FragmentLibraryMerger>())
+		.def("addInputLibrary", &ConfGen::FragmentLibraryMerger::addInputLibrary, 
+			 (python::arg("self"), python::arg("file_name")))
+		.def("getInputLibrary", &ConfGen::FragmentLibraryMerger::getInputLibrary, 
+			 (python::arg("self"), python::arg("idx")), python::return_value_policy<python::copy_const_reference>())
+		.def("getNumInputLibraries", &ConfGen::FragmentLibraryMerger::getNumInputLibraries, python::arg("self"))
+		.def("clearInputLibraries", &ConfGen::FragmentLibraryMerger::clearInputLibraries, python::arg("self"))
+		.def("setNumThreads", &ConfGen::FragmentLibraryMerger::setNumThreads, 
+			 (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &ConfGen::FragmentLibraryMerger::getNumThreads, python::arg("self"))
+		.def("setIndexedOutput", &ConfGen::FragmentLibraryMerger::setIndexedOutput, 
+			 (python::arg("self"), python::arg("indexed")))
+		.def("getIndexedOutput", &ConfGen::FragmentLibraryMerger::getIndexedOutput, python::arg("self"))
+		.def("setAbortCallback", &ConfGen::FragmentLibraryMerger::setAbortCallback, 
+			 (python::arg("self"), python::arg("func")))
+		.def("getAbortCallback", &ConfGen::FragmentLibraryMerger::getAbortCallback, 
+			 python::arg("self"), python::return_internal_reference<>())
+		.def("merge", &ConfGen::FragmentLibraryMerger::merge, (python::arg("self"), python::arg("os")))
+		.def("getNumInputEntries", &ConfGen::FragmentLibraryMerger::getNumInputEntries, python::arg("self"))
+		.def("getNumOutputEntries", &ConfGen::FragmentLibraryMerger::getNumOutputEntries, python::arg("self"))
+		.def("getNumConflicts", &ConfGen::FragmentLibraryMerger::getNumConflicts, python::arg("self"))
+		.add_property("numThreads", &ConfGen::FragmentLibraryMerger::getNumThreads, 
+					  &ConfGen::FragmentLibraryMerger::setNumThreads)
+		.add_property("indexedOutput", &ConfGen::FragmentLibraryMerger::getIndexedOutput, 
+					  &ConfGen::FragmentLibraryMerger::setIndexedOutput)
+		.add_property("abortCallback", 
+					  python::make_function(&ConfGen::FragmentLibraryMerger::getAbortCallback,
+											python::return_internal_reference<>()),
+					  &ConfGen::FragmentLibraryMerger::setAbortCallback)
+		.add_property("numInputLibraries", &ConfGen::FragmentLibraryMerger::getNumInputLibraries)
+		.add_property("numInputEntries", &ConfGen::FragmentLibraryMerger::getNumInputEntries)
+		.add_property("numOutputEntries", &ConfGen::FragmentLibraryMerger::getNumOutputEntries)
+		.add_property("numConflicts", &ConfGen::FragmentLibraryMerger::getNumConflicts);
+}
@@ -42,6 +42,8 @@ BOOST_PYTHON_MODULE(_confgen)
 	exportDGStructureGenerator();
 	exportFragmentLibraryEntry();
 	exportFragmentLibrary();
+	exportFragmentLibraryMerger();
+	exportProcessingStatistics();
 	exportConformerData();
 	exportTorsionRule();
 	exportTorsionCategory();
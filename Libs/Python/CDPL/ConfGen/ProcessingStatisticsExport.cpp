@@ -0,0 +1,88 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ProcessingStatisticsExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/ConfGen/ProcessingStatistics.hpp"
+
+#include "Base/CopyAssOp.hpp"
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonConfGen::exportProcessingStatistics()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<ConfGen::ProcessingStatistics> cl("ProcessingStatistics", python::no_init);
+    python::scope scope = cl;
+    
+    python::enum_<ConfGen::ProcessingStatistics::Phase>("Phase")
+		.value("FORCE_FIELD_SETUP", ConfGen::ProcessingStatistics::FORCE_FIELD_SETUP)
+		.value("FRAGMENT_SPLITTING", ConfGen::ProcessingStatistics::FRAGMENT_SPLITTING)
+		.value("FRAGMENT_LIBRARY_LOOKUP", ConfGen::ProcessingStatistics::FRAGMENT_LIBRARY_LOOKUP)
+		.value("FRAGMENT_CONFORMER_GENERATION", ConfGen::ProcessingStatistics::FRAGMENT_CONFORMER_GENERATION)
+		.value("TORSION_DRIVING", ConfGen::ProcessingStatistics::TORSION_DRIVING)
+		.value("STRUCTURE_GENERATION", ConfGen::ProcessingStatistics::STRUCTURE_GENERATION)
+		.value("ENERGY_MINIMIZATION", ConfGen::ProcessingStatistics::ENERGY_MINIMIZATION)
+		.value("CONFORMER_COMBINATION", ConfGen::ProcessingStatistics::CONFORMER_COMBINATION)
+		.value("CONFORMER_SELECTION", ConfGen::ProcessingStatistics::CONFORMER_SELECTION)
+		.value("NUM_PHASES", ConfGen::ProcessingStatistics::NUM_PHASES)
+		.export_values();
+
+    python::enum_<ConfGen::ProcessingStatistics::Counter>("Counter")
+		.value("MOLECULES", ConfGen::ProcessingStatistics::MOLECULES)
+		.value("OUTPUT_CONFORMERS", ConfGen::ProcessingStatistics::OUTPUT_CONFORMERS)
+		.value("TORSION_FRAGMENTS", ConfGen::ProcessingStatistics::TORSION_FRAGMENTS)
+		.value("FRAGMENT_LIBRARY_HITS", ConfGen::ProcessingStatistics::FRAGMENT_LIBRARY_HITS)
+		.value("FRAGMENT_CACHE_HITS", ConfGen::ProcessingStatistics::FRAGMENT_CACHE_HITS)
+		.value("GENERATED_FRAGMENTS", ConfGen::ProcessingStatistics::GENERATED_FRAGMENTS)
+		.value("ENERGY_MINIMIZATIONS", ConfGen::ProcessingStatistics::ENERGY_MINIMIZATIONS)
+		.value("MINIMIZATION_ITERATIONS", ConfGen::ProcessingStatistics::MINIMIZATION_ITERATIONS)
+		.value("NUM_COUNTERS", ConfGen::ProcessingStatistics::NUM_COUNTERS)
+		.export_values();
+
+    cl
+		.def(python::init<>(python::arg("self")))
+		.def(python::init<const ConfGen::ProcessingStatistics&>((python::arg("self"), python::arg("stats"))))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<ConfGen::ProcessingStatistics>())	
+		.def("assign", CDPLPythonBase::copyAssOp(&ConfGen::ProcessingStatistics::operator=), 
+			 (python::arg("self"), python::arg("stats")), python::return_self<>())
+		.def("getTime", &ConfGen::ProcessingStatistics::getTime, (python::arg("self"), python::arg("phase")))
+		.def("addTime", &ConfGen::ProcessingStatistics::addTime, (python::arg("self"), python::arg("phase"), python::arg("secs")))
+		.def("getCount", &ConfGen::ProcessingStatistics::getCount, (python::arg("self"), python::arg("counter")))
+		.def("increment", &ConfGen::ProcessingStatistics::increment, 
+			 (python::arg("self"), python::arg("counter"), python::arg("num") = 1))
+		.def("clear", &ConfGen::ProcessingStatistics::clear, python::arg("self"))
+		.def("__iadd__", &ConfGen::ProcessingStatistics::operator+=, (python::arg("self"), python::arg("stats")), 
+			 python::return_self<>())
+		.def("getPhaseName", &ConfGen::ProcessingStatistics::getPhaseName, python::arg("phase"))
+		.staticmethod("getPhaseName")
+		.def("getCounterName", &ConfGen::ProcessingStatistics::getCounterName, python::arg("counter"))
+		.staticmethod("getCounterName");
+}
@@ -29,10 +29,22 @@
 #include "CDPL/ConfGen/TorsionDriver.hpp"
 
 #include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/GILStateGuards.hpp"
 
 #include "ClassExports.hpp"
 
 
+namespace
+{
+
+	unsigned int generateConformers(CDPL::ConfGen::TorsionDriver& driver)
+	{
+		CDPLPythonBase::GILStateRelease gil_release;
+
+		return driver.generateConformers();
+	}
+}
+
 void CDPLPythonConfGen::exportTorsionDriver()
 {
     using namespace boost;
@@ -89,7 +101,7 @@ void CDPLPythonConfGen::exportTorsionDriver()
 			 (python::arg("self"), python::arg("func")))
 		.def("getLogMessageCallback", &ConfGen::TorsionDriver::getLogMessageCallback, 
 			 python::arg("self"), python::return_internal_reference<>())
-		.def("generateConformers", &ConfGen::TorsionDriver::generateConformers, python::arg("self"))
+		.def("generateConformers", &generateConformers, python::arg("self"))
 		.def("getNumConformers", &ConfGen::TorsionDriver::getNumConformers, python::arg("self"))
 		.def("getConformer", 
 			 static_cast<ConfGen::ConformerData& (ConfGen::TorsionDriver::*)(std::size_t)>(&ConfGen::TorsionDriver::getConformer),
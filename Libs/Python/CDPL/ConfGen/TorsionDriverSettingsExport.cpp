@@ -68,6 +68,10 @@ void CDPLPythonConfGen::exportTorsionDriverSettings()
 			 (python::arg("self"), python::arg("max_size")))
 		.def("getMaxPoolSize", &ConfGen::TorsionDriverSettings::getMaxPoolSize, 
 			 python::arg("self"))
+		.def("setNumThreads", &ConfGen::TorsionDriverSettings::setNumThreads, 
+			 (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &ConfGen::TorsionDriverSettings::getNumThreads, 
+			 python::arg("self"))
 		.def("setForceFieldType", &ConfGen::TorsionDriverSettings::setForceFieldType, 
 			 (python::arg("self"), python::arg("type")))
 		.def("getForceFieldType", &ConfGen::TorsionDriverSettings::getForceFieldType, 
@@ -102,5 +106,7 @@ void CDPLPythonConfGen::exportTorsionDriverSettings()
 		.add_property("energyWindow", &ConfGen::TorsionDriverSettings::getEnergyWindow,
 					  &ConfGen::TorsionDriverSettings::setEnergyWindow)
 		.add_property("maxPoolSize", &ConfGen::TorsionDriverSettings::getMaxPoolSize,
-					  &ConfGen::TorsionDriverSettings::setMaxPoolSize);
+					  &ConfGen::TorsionDriverSettings::setMaxPoolSize)
+		.add_property("numThreads", &ConfGen::TorsionDriverSettings::getNumThreads,
+					  &ConfGen::TorsionDriverSettings::setNumThreads);
 }
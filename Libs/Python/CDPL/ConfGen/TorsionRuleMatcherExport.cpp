@@ -73,6 +73,10 @@ void CDPLPythonConfGen::exportTorsionRuleMatcher()
 			 (python::arg("self"), python::arg("lib")))
 		.def("getTorsionLibrary", &ConfGen::TorsionRuleMatcher::getTorsionLibrary, 
 			 python::arg("self"), python::return_value_policy<python::copy_const_reference>())
+		.def("setResultCacheSize", &ConfGen::TorsionRuleMatcher::setResultCacheSize, 
+			 (python::arg("self"), python::arg("max_size")))
+		.def("getResultCacheSize", &ConfGen::TorsionRuleMatcher::getResultCacheSize, python::arg("self"))
+		.def("clearCache", &ConfGen::TorsionRuleMatcher::clearCache, python::arg("self"))
 		.def("getNumMatches", &ConfGen::TorsionRuleMatcher::getNumMatches, python::arg("self"))
 		.def("getMatch", &ConfGen::TorsionRuleMatcher::getMatch, (python::arg("self"), python::arg("idx")),
 			 python::return_internal_reference<1>())
@@ -91,6 +95,9 @@ void CDPLPythonConfGen::exportTorsionRuleMatcher()
 					  SetBoolFunc(&ConfGen::TorsionRuleMatcher::findAllRuleMappings))
 		.add_property("onlyFirstMatchingRule", GetBoolFunc(&ConfGen::TorsionRuleMatcher::stopAtFirstMatchingRule), 
 					  SetBoolFunc(&ConfGen::TorsionRuleMatcher::stopAtFirstMatchingRule))
+		.add_property("resultCacheSize", &ConfGen::TorsionRuleMatcher::getResultCacheSize,
+					  &ConfGen::TorsionRuleMatcher::setResultCacheSize)
+		.def_readonly("DEF_RESULT_CACHE_SIZE", ConfGen::TorsionRuleMatcher::DEF_RESULT_CACHE_SIZE)
 		.add_property("torsionLibrary", 
 					  python::make_function(&ConfGen::TorsionRuleMatcher::getTorsionLibrary,
 											python::return_value_policy<python::copy_const_reference>()),
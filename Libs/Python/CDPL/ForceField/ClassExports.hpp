@@ -64,6 +64,7 @@ namespace CDPLPythonForceField
 	void exportMMFF94VanDerWaalsInteractionParameterizer();
 	void exportMMFF94ElectrostaticInteractionParameterizer();
 	void exportMMFF94InteractionParameterizer();
+	void exportMMFF94ParameterizationCache();
 
 	void exportMMFF94SymbolicAtomTypePatternTable();
 	void exportMMFF94HeavyToHydrogenAtomTypeMap();
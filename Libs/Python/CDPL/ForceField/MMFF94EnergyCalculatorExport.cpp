@@ -71,6 +71,10 @@ void CDPLPythonForceField::exportMMFF94EnergyCalculator()
 			 python::return_value_policy<python::copy_const_reference>())
 		.def("getVanDerWaalsEnergy", &CalculatorType::getVanDerWaalsEnergy, python::arg("self"),
 			 python::return_value_policy<python::copy_const_reference>())
+		.def("setMovableAtomMask", &CalculatorType::setMovableAtomMask, (python::arg("self"), python::arg("mask")))
+		.def("resetMovableAtomMask", &CalculatorType::resetMovableAtomMask, python::arg("self"))
+		.def("getMovableAtomMask", &CalculatorType::getMovableAtomMask, python::arg("self"),
+			 python::return_internal_reference<>())
 		.add_property("enabledInteractionTypes", &CalculatorType::getEnabledInteractionTypes, 
 					  &CalculatorType::setEnabledInteractionTypes)
 		.add_property("totalEnergy", python::make_function(&CalculatorType::getTotalEnergy,
@@ -88,5 +92,7 @@ void CDPLPythonForceField::exportMMFF94EnergyCalculator()
 		.add_property("electrostaticEnergy", python::make_function(&CalculatorType::getElectrostaticEnergy,
 																   python::return_value_policy<python::copy_const_reference>()))
 		.add_property("vanDerWaalsEnergy", python::make_function(&CalculatorType::getVanDerWaalsEnergy,
-																 python::return_value_policy<python::copy_const_reference>()));
+																 python::return_value_policy<python::copy_const_reference>()))
+		.add_property("movableAtomMask", python::make_function(&CalculatorType::getMovableAtomMask,
+															   python::return_internal_reference<>()));
 }
@@ -80,6 +80,10 @@ void CDPLPythonForceField::exportMMFF94GradientCalculator()
 		.def("resetFixedAtomMask", &CalculatorType::resetFixedAtomMask, python::arg("self"))
 		.def("getFixedAtomMask", &CalculatorType::getFixedAtomMask, python::arg("self"),
 			 python::return_internal_reference<>())
+		.def("setMovableAtomMask", &CalculatorType::setMovableAtomMask, (python::arg("self"), python::arg("mask")))
+		.def("resetMovableAtomMask", &CalculatorType::resetMovableAtomMask, python::arg("self"))
+		.def("getMovableAtomMask", &CalculatorType::getMovableAtomMask, python::arg("self"),
+			 python::return_internal_reference<>())
 		.add_property("enabledInteractionTypes", &CalculatorType::getEnabledInteractionTypes, 
 					  &CalculatorType::setEnabledInteractionTypes)
 		.add_property("totalEnergy", python::make_function(&CalculatorType::getTotalEnergy,
@@ -99,5 +103,7 @@ void CDPLPythonForceField::exportMMFF94GradientCalculator()
 		.add_property("vanDerWaalsEnergy", python::make_function(&CalculatorType::getVanDerWaalsEnergy,
 																 python::return_value_policy<python::copy_const_reference>()))
 		.add_property("fixedAtomMask", python::make_function(&CalculatorType::getFixedAtomMask,
-															 python::return_internal_reference<>()));
+															 python::return_internal_reference<>()))
+		.add_property("movableAtomMask", python::make_function(&CalculatorType::getMovableAtomMask,
+															   python::return_internal_reference<>()));
 }
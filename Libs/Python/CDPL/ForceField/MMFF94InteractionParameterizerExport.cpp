@@ -100,9 +100,16 @@ void CDPLPythonForceField::exportMMFF94InteractionParameterizer()
 			 (python::arg("self"), python::arg("dist_expo")))
 		.def("setParameterSet", &ForceField::MMFF94InteractionParameterizer::setParameterSet, 
 			 (python::arg("self"), python::arg("param_set")))
+		.def("setCache", &ForceField::MMFF94InteractionParameterizer::setCache, 
+			 (python::arg("self"), python::arg("cache")))
+		.def("getCache", &ForceField::MMFF94InteractionParameterizer::getCache, 
+			 python::arg("self"), python::return_value_policy<python::copy_const_reference>())
 		.def("assign", CDPLPythonBase::copyAssOp(&ForceField::MMFF94InteractionParameterizer::operator=),
 			 (python::arg("self"), python::arg("parameterizer")), python::return_self<>())
 		.def("parameterize", &ForceField::MMFF94InteractionParameterizer::parameterize, 
 			 (python::arg("self"), python::arg("molgraph"), python::arg("ia_data"), 
-			  python::arg("ia_types") = ForceField::InteractionType::ALL, python::arg("strict") = true));
+			  python::arg("ia_types") = ForceField::InteractionType::ALL, python::arg("strict") = true))
+		.add_property("cache", python::make_function(&ForceField::MMFF94InteractionParameterizer::getCache, 
+													  python::return_value_policy<python::copy_const_reference>()),
+					  &ForceField::MMFF94InteractionParameterizer::setCache);
 }
@@ -0,0 +1,58 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * MMFF94ParameterizationCacheExport.cpp 
+ *
+ * This file is part of the Chemical Parameterizer Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <boost/python.hpp>
+
+#include "CDPL/ForceField/MMFF94ParameterizationCache.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonForceField::exportMMFF94ParameterizationCache()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::scope scope = python::class_<ForceField::MMFF94ParameterizationCache, ForceField::MMFF94ParameterizationCache::SharedPointer,
+										 boost::noncopyable>("MMFF94ParameterizationCache", python::no_init)
+		.def(python::init<std::size_t>((python::arg("self"), python::arg("max_size") = ForceField::MMFF94ParameterizationCache::DEFAULT_MAX_SIZE)))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<ForceField::MMFF94ParameterizationCache>())	
+		.def("setMaxSize", &ForceField::MMFF94ParameterizationCache::setMaxSize, (python::arg("self"), python::arg("max_size")))
+		.def("getMaxSize", &ForceField::MMFF94ParameterizationCache::getMaxSize, python::arg("self"))
+		.def("getSize", &ForceField::MMFF94ParameterizationCache::getSize, python::arg("self"))
+		.def("getNumHits", &ForceField::MMFF94ParameterizationCache::getNumHits, python::arg("self"))
+		.def("getNumMisses", &ForceField::MMFF94ParameterizationCache::getNumMisses, python::arg("self"))
+		.def("clear", &ForceField::MMFF94ParameterizationCache::clear, python::arg("self"))
+		.def("get", &ForceField::MMFF94ParameterizationCache::get, python::return_value_policy<python::copy_const_reference>())
+		.staticmethod("get")
+		.add_property("maxSize", &ForceField::MMFF94ParameterizationCache::getMaxSize, &ForceField::MMFF94ParameterizationCache::setMaxSize)
+		.add_property("size", &ForceField::MMFF94ParameterizationCache::getSize)
+		.add_property("numHits", &ForceField::MMFF94ParameterizationCache::getNumHits)
+		.add_property("numMisses", &ForceField::MMFF94ParameterizationCache::getNumMisses);
+
+	scope.attr("DEFAULT_MAX_SIZE") = ForceField::MMFF94ParameterizationCache::DEFAULT_MAX_SIZE;
+}
@@ -77,6 +77,7 @@ BOOST_PYTHON_MODULE(_forcefield)
 	exportMMFF94VanDerWaalsInteractionParameterizer();
 	exportMMFF94ElectrostaticInteractionParameterizer();
 	exportMMFF94InteractionParameterizer();
+	exportMMFF94ParameterizationCache();
 
 	exportMMFF94SymbolicAtomTypePatternTable();
 	exportMMFF94HeavyToHydrogenAtomTypeMap();
@@ -65,6 +65,8 @@ void CDPLPythonForceField::exportUtilityFunctions()
 
 	python::def("filterInteractions", &ForceField::filterInteractions,
 				(python::arg("ia_data"), python::arg("filtered_ia_data"),  python::arg("inc_atom_mask")));
+	python::def("splitInteractions", &ForceField::splitInteractions,
+				(python::arg("ia_data"), python::arg("dep_ia_data"), python::arg("indep_ia_data"), python::arg("atom_mask")));
 	python::def("calcSquaredDistance", &ForceField::calcSquaredDistance<double, Math::Vector3D>, 
 				(python::arg("atom1_pos"), python::arg("atom2_pos")));
 	python::def("calcDistance", &ForceField::calcDistance<double, Math::Vector3D>, 
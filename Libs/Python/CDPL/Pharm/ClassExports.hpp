@@ -46,6 +46,8 @@ namespace CDPLPythonPharm
 	void exportPharmacophoreRDFDescriptorCalculator();
 	void exportFeatureAutoCorrelation3DVectorCalculator();
     void exportPharmacophoreAutoCorr3DDescriptorCalculator();
+	void exportPharmacophoreFingerprintGenerator();
+	void exportPharmacophoreFingerprintStore();
 
 	void exportBoostFunctionWrappers();
 
@@ -70,7 +72,9 @@ namespace CDPLPythonPharm
 
 	void exportScreeningDBCreator();
 	void exportScreeningDBAccessor();
+	void exportScreeningDBShardManifest();
 	void exportScreeningProcessor();
+	void exportScreeningStatistics();
 	void exportPharmacophoreFitScreeningScore();
 
 #if defined(HAVE_BOOST_FILESYSTEM)
@@ -94,6 +98,12 @@ namespace CDPLPythonPharm
 	void exportPSDScreeningDBCreator();
 	void exportPSDScreeningDBAccessor();
 
+# if defined(HAVE_BOOST_FILESYSTEM)
+
+	void exportShardedScreeningDBAccessor();
+
+# endif // defined(HAVE_BOOST_FILESYSTEM)
+
 #endif // HAVE_SQLITE3
 
 	void exportFeatureGenerator();
@@ -71,6 +71,9 @@ void CDPLPythonPharm::exportFeatureGenerator()
 			 python::arg("self"), python::return_internal_reference<>())
 		.def("generate", python::pure_virtual(&Pharm::FeatureGenerator::generate),
 			 (python::arg("self"), python::arg("molgraph"), python::arg("pharm")))
+		.def("prepare", &Pharm::FeatureGenerator::prepare, (python::arg("self"), python::arg("molgraph")),
+			 python::with_custodian_and_ward<1, 2>())
+		.def("instantiate", &Pharm::FeatureGenerator::instantiate, (python::arg("self"), python::arg("pharm")))
 		.def("clone", python::pure_virtual(&Pharm::FeatureGenerator::clone),
 			 python::arg("self"))
 		.add_property("atom3DCoordsFunc", python::make_function(&Pharm::FeatureGenerator::getAtom3DCoordinatesFunction, 
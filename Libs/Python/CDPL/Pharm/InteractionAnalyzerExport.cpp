@@ -46,15 +46,23 @@ void CDPLPythonPharm::exportInteractionAnalyzer()
 				 (python::arg("self"), python::arg("analyzer"))))
 		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::InteractionAnalyzer>())	
 		.def("setConstraintFunction", &Pharm::InteractionAnalyzer::setConstraintFunction, 
-			 (python::arg("self"), python::arg("type1"), python::arg("type2"), python::arg("func")))
+			 (python::arg("self"), python::arg("type1"), python::arg("type2"), python::arg("func"), python::arg("max_dist") = -1.0))
 		.def("removeConstraintFunction", &Pharm::InteractionAnalyzer::removeConstraintFunction, 
 			 (python::arg("self"), python::arg("type1"), python::arg("type2")))
 		.def("getConstraintFunction", &Pharm::InteractionAnalyzer::getConstraintFunction, 
 			 (python::arg("self"), python::arg("type1"), python::arg("type2")),
 			 python::return_value_policy<python::copy_const_reference>())
+		.def("getMaximumDistance", &Pharm::InteractionAnalyzer::getMaximumDistance, 
+			 (python::arg("self"), python::arg("type1"), python::arg("type2")))
 		.def("assign", &Pharm::InteractionAnalyzer::operator=, 
 			 (python::arg("self"), python::arg("analyzer")), python::return_self<>())
-		.def("analyze", &Pharm::InteractionAnalyzer::analyze,
+		.def("analyze", static_cast<void (Pharm::InteractionAnalyzer::*)(const Pharm::FeatureContainer&, const Pharm::FeatureContainer&,
+																		  Pharm::FeatureMapping&, bool) const>(&Pharm::InteractionAnalyzer::analyze),
 			 (python::arg("self"), python::arg("cntnr1"), python::arg("cntnr2"), 
-			  python::arg("iactions"), python::arg("append") = false));
+			  python::arg("iactions"), python::arg("append") = false))
+		.def("prepare", &Pharm::InteractionAnalyzer::prepare, (python::arg("self"), python::arg("cntnr2")),
+			 python::with_custodian_and_ward<1, 2>())
+		.def("analyze", static_cast<void (Pharm::InteractionAnalyzer::*)(const Pharm::FeatureContainer&, Pharm::FeatureMapping&, 
+																		  bool) const>(&Pharm::InteractionAnalyzer::analyze),
+			 (python::arg("self"), python::arg("cntnr1"), python::arg("iactions"), python::arg("append") = false));
 }
@@ -76,6 +76,16 @@ void CDPLPythonPharm::exportInteractionScoreGridCalculator()
 																		 const Pharm::InteractionScoreGridCalculator::FeaturePredicate&)>
 			 (&Pharm::InteractionScoreGridCalculator::calculate),
 			 (python::arg("self"), python::arg("features"), python::arg("grid"), python::arg("tgt_ftr_pred")))
+		.def("calculate", 
+			 static_cast<void (Pharm::InteractionScoreGridCalculator::*)(const Pharm::FeatureContainer&, 
+																		 Grid::DSpatialGrid& grid, 
+																		 const Pharm::InteractionScoreGridCalculator::FeaturePredicate&,
+																		 Math::DVector&)>
+			 (&Pharm::InteractionScoreGridCalculator::calculate),
+			 (python::arg("self"), python::arg("features"), python::arg("grid"), python::arg("tgt_ftr_pred"), python::arg("raw_scores")))
+		.def("recalculate", &Pharm::InteractionScoreGridCalculator::recalculate,
+			 (python::arg("self"), python::arg("features"), python::arg("grid"), python::arg("tgt_ftr_pred"), 
+			  python::arg("changed_pos"), python::arg("raw_scores")))
 		.add_property("normalizedScores", &Pharm::InteractionScoreGridCalculator::scoresNormalized,
 					  &Pharm::InteractionScoreGridCalculator::normalizeScores)
 		.add_property("distanceCutoff", &Pharm::InteractionScoreGridCalculator::getDistanceCutoff, &Pharm::InteractionScoreGridCalculator::setDistanceCutoff)
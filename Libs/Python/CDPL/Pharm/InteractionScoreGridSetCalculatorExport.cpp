@@ -62,8 +62,13 @@ void CDPLPythonPharm::exportInteractionScoreGridSetCalculator()
 			 python::arg("self"), python::return_internal_reference<>())
 		.def("normalizeScores", &Pharm::InteractionScoreGridSetCalculator::normalizeScores, (python::arg("self"), python::arg("normalize")))
 		.def("scoresNormalized", &Pharm::InteractionScoreGridSetCalculator::scoresNormalized, python::arg("self"))
+		.def("enableIncrementalCalculation", &Pharm::InteractionScoreGridSetCalculator::enableIncrementalCalculation, 
+			 (python::arg("self"), python::arg("enable")))
+		.def("isIncrementalCalculationEnabled", &Pharm::InteractionScoreGridSetCalculator::isIncrementalCalculationEnabled, python::arg("self"))
 		.add_property("normalizedScores", &Pharm::InteractionScoreGridSetCalculator::scoresNormalized,
 					  &Pharm::InteractionScoreGridSetCalculator::normalizeScores)
+		.add_property("incrementalCalculation", &Pharm::InteractionScoreGridSetCalculator::isIncrementalCalculationEnabled,
+					  &Pharm::InteractionScoreGridSetCalculator::enableIncrementalCalculation)
 		.add_property("scoreCombinationFunction", python::make_function(&Pharm::InteractionScoreGridCalculator::getScoreCombinationFunction, python::return_internal_reference<>()),
 					  &Pharm::InteractionScoreGridCalculator::setScoreCombinationFunction);
 }
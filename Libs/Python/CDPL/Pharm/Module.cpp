@@ -49,6 +49,8 @@ BOOST_PYTHON_MODULE(_pharm)
 	exportPharmacophoreRDFDescriptorCalculator();
 	exportFeatureAutoCorrelation3DVectorCalculator();
     exportPharmacophoreAutoCorr3DDescriptorCalculator();
+	exportPharmacophoreFingerprintGenerator();
+	exportPharmacophoreFingerprintStore();
 
 	exportPharmacophoreReader();
 	exportFeatureContainerWriter();
@@ -71,7 +73,9 @@ BOOST_PYTHON_MODULE(_pharm)
 
 	exportScreeningDBCreator();
 	exportScreeningDBAccessor();
+	exportScreeningDBShardManifest();
 	exportScreeningProcessor();
+	exportScreeningStatistics();
 	exportPharmacophoreFitScreeningScore();
 
 #if defined(HAVE_BOOST_FILESYSTEM)
@@ -95,6 +99,12 @@ BOOST_PYTHON_MODULE(_pharm)
 	exportPSDScreeningDBCreator();
 	exportPSDScreeningDBAccessor();
 
+# if defined(HAVE_BOOST_FILESYSTEM)
+
+	exportShardedScreeningDBAccessor();
+
+# endif // defined(HAVE_BOOST_FILESYSTEM)
+
 #endif // HAVE_SQLITE3
 
 	exportFeatureGenerator();
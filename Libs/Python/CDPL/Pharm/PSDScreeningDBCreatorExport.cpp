@@ -42,5 +42,9 @@ void CDPLPythonPharm::exportPSDScreeningDBCreator()
 		.def(python::init<>(python::arg("self")))
 		.def(python::init<const std::string&, Pharm::ScreeningDBCreator::Mode, bool>
 			 ((python::arg("self"), python::arg("name"), python::arg("mode") = Pharm::ScreeningDBCreator::CREATE, 
-			   python::arg("allow_dup_entries") = true)));
+			   python::arg("allow_dup_entries") = true)))
+		.def("setUseWriterThread", &Pharm::PSDScreeningDBCreator::setUseWriterThread, (python::arg("self"), python::arg("use")))
+		.def("getUseWriterThread", &Pharm::PSDScreeningDBCreator::getUseWriterThread, python::arg("self"))
+		.def("flush", &Pharm::PSDScreeningDBCreator::flush, python::arg("self"))
+		.add_property("useWriterThread", &Pharm::PSDScreeningDBCreator::getUseWriterThread, &Pharm::PSDScreeningDBCreator::setUseWriterThread);
 }
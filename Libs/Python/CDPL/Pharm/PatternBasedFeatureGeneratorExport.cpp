@@ -58,6 +58,10 @@ void CDPLPythonPharm::exportPatternBasedFeatureGenerator()
 	     (python::arg("self"), python::arg("gen")), python::return_self<>())
 	.def("generate", &Pharm::PatternBasedFeatureGenerator::generate,
 	     (python::arg("self"), python::arg("molgraph"), python::arg("pharm")))
+	.def("prepare", &Pharm::PatternBasedFeatureGenerator::prepare,
+	     (python::arg("self"), python::arg("molgraph")), python::with_custodian_and_ward<1, 2>())
+	.def("instantiate", &Pharm::PatternBasedFeatureGenerator::instantiate,
+	     (python::arg("self"), python::arg("pharm")))
 	.def("__call__", &Pharm::PatternBasedFeatureGenerator::generate,
 	     (python::arg("self"), python::arg("molgraph"), python::arg("pharm")));
 
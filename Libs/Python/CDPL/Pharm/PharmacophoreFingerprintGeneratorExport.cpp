@@ -0,0 +1,77 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintGeneratorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/PharmacophoreFingerprintGenerator.hpp"
+#include "CDPL/Pharm/FeatureContainer.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonPharm::exportPharmacophoreFingerprintGenerator()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::PharmacophoreFingerprintGenerator, boost::noncopyable>("PharmacophoreFingerprintGenerator", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::PharmacophoreFingerprintGenerator>())	
+		.def("setNumBits", &Pharm::PharmacophoreFingerprintGenerator::setNumBits, 
+			 (python::arg("self"), python::arg("num_bits")))
+		.def("getNumBits", &Pharm::PharmacophoreFingerprintGenerator::getNumBits, python::arg("self"))
+		.def("setDistanceBinSize", &Pharm::PharmacophoreFingerprintGenerator::setDistanceBinSize, 
+			 (python::arg("self"), python::arg("bin_size")))
+		.def("getDistanceBinSize", &Pharm::PharmacophoreFingerprintGenerator::getDistanceBinSize, python::arg("self"))
+		.def("setMaxDistance", &Pharm::PharmacophoreFingerprintGenerator::setMaxDistance, 
+			 (python::arg("self"), python::arg("max_dist")))
+		.def("getMaxDistance", &Pharm::PharmacophoreFingerprintGenerator::getMaxDistance, python::arg("self"))
+		.def("include2PointPharmacophores", static_cast<void (Pharm::PharmacophoreFingerprintGenerator::*)(bool)>(
+				 &Pharm::PharmacophoreFingerprintGenerator::include2PointPharmacophores), 
+			 (python::arg("self"), python::arg("include")))
+		.def("include2PointPharmacophores", static_cast<bool (Pharm::PharmacophoreFingerprintGenerator::*)() const>(
+				 &Pharm::PharmacophoreFingerprintGenerator::include2PointPharmacophores), python::arg("self"))
+		.def("include3PointPharmacophores", static_cast<void (Pharm::PharmacophoreFingerprintGenerator::*)(bool)>(
+				 &Pharm::PharmacophoreFingerprintGenerator::include3PointPharmacophores), 
+			 (python::arg("self"), python::arg("include")))
+		.def("include3PointPharmacophores", static_cast<bool (Pharm::PharmacophoreFingerprintGenerator::*)() const>(
+				 &Pharm::PharmacophoreFingerprintGenerator::include3PointPharmacophores), python::arg("self"))
+		.def("generate", static_cast<void (Pharm::PharmacophoreFingerprintGenerator::*)(const Pharm::FeatureContainer&, Util::BitSet&, bool)>(
+				 &Pharm::PharmacophoreFingerprintGenerator::generate), 
+			 (python::arg("self"), python::arg("cntnr"), python::arg("fp"), python::arg("merge") = false))
+		.def("generate", static_cast<void (Pharm::PharmacophoreFingerprintGenerator::*)(const Chem::MolecularGraph&, Util::BitSet&)>(
+				 &Pharm::PharmacophoreFingerprintGenerator::generate), 
+			 (python::arg("self"), python::arg("molgraph"), python::arg("fp")))
+		.add_property("numBits", &Pharm::PharmacophoreFingerprintGenerator::getNumBits,
+					  &Pharm::PharmacophoreFingerprintGenerator::setNumBits)
+		.add_property("distanceBinSize", &Pharm::PharmacophoreFingerprintGenerator::getDistanceBinSize,
+					  &Pharm::PharmacophoreFingerprintGenerator::setDistanceBinSize)
+		.add_property("maxDistance", &Pharm::PharmacophoreFingerprintGenerator::getMaxDistance,
+					  &Pharm::PharmacophoreFingerprintGenerator::setMaxDistance);
+}
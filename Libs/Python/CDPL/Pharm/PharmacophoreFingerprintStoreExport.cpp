@@ -0,0 +1,88 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * PharmacophoreFingerprintStoreExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/PharmacophoreFingerprintStore.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+    boost::python::list findSimilar(const CDPL::Pharm::PharmacophoreFingerprintStore& store, const CDPL::Util::BitSet& query, 
+									double min_sim, std::size_t max_num_hits)
+    {
+		using namespace boost;
+
+		CDPL::Pharm::PharmacophoreFingerprintStore::SearchHitList hits;
+		python::list hit_list;
+
+		store.findSimilar(query, hits, min_sim, max_num_hits);
+
+		for (CDPL::Pharm::PharmacophoreFingerprintStore::SearchHitList::const_iterator it = hits.begin(), end = hits.end(); it != end; ++it)
+			hit_list.append(python::make_tuple(it->first, it->second));
+
+		return hit_list;
+    }
+}
+
+
+void CDPLPythonPharm::exportPharmacophoreFingerprintStore()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::PharmacophoreFingerprintStore, Pharm::PharmacophoreFingerprintStore::SharedPointer, 
+				   boost::noncopyable>("PharmacophoreFingerprintStore", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::PharmacophoreFingerprintStore>())	
+		.def("setNumThreads", &Pharm::PharmacophoreFingerprintStore::setNumThreads, 
+			 (python::arg("self"), python::arg("num_threads")))
+		.def("getNumThreads", &Pharm::PharmacophoreFingerprintStore::getNumThreads, python::arg("self"))
+		.def("getNumFingerprintBits", &Pharm::PharmacophoreFingerprintStore::getNumFingerprintBits, python::arg("self"))
+		.def("getNumFingerprints", &Pharm::PharmacophoreFingerprintStore::getNumFingerprints, python::arg("self"))
+		.def("addFingerprint", &Pharm::PharmacophoreFingerprintStore::addFingerprint, 
+			 (python::arg("self"), python::arg("fp")))
+		.def("getFingerprint", &Pharm::PharmacophoreFingerprintStore::getFingerprint, 
+			 (python::arg("self"), python::arg("idx"), python::arg("fp")))
+		.def("findSimilar", &findSimilar, 
+			 (python::arg("self"), python::arg("query"), python::arg("min_sim"), python::arg("max_num_hits") = 0))
+		.def("clear", &Pharm::PharmacophoreFingerprintStore::clear, python::arg("self"))
+		.def("save", &Pharm::PharmacophoreFingerprintStore::save, (python::arg("self"), python::arg("file_name")))
+		.def("open", &Pharm::PharmacophoreFingerprintStore::open, (python::arg("self"), python::arg("file_name")))
+		.def("getFileName", &Pharm::PharmacophoreFingerprintStore::getFileName, python::arg("self"),
+			 python::return_value_policy<python::copy_const_reference>())
+		.add_property("numThreads", &Pharm::PharmacophoreFingerprintStore::getNumThreads,
+					  &Pharm::PharmacophoreFingerprintStore::setNumThreads)
+		.add_property("numFingerprintBits", &Pharm::PharmacophoreFingerprintStore::getNumFingerprintBits)
+		.add_property("numFingerprints", &Pharm::PharmacophoreFingerprintStore::getNumFingerprints)
+		.add_property("fileName", python::make_function(&Pharm::PharmacophoreFingerprintStore::getFileName,
+														python::return_value_policy<python::copy_const_reference>()));
+}
@@ -47,6 +47,10 @@ void CDPLPythonPharm::exportPharmacophoreGenerator()
 		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::PharmacophoreGenerator>())	
 		.def("generate", &Pharm::PharmacophoreGenerator::generate,
 			 (python::arg("self"), python::arg("molgraph"), python::arg("pharm"), python::arg("append") = false))
+		.def("prepare", &Pharm::PharmacophoreGenerator::prepare,
+			 (python::arg("self"), python::arg("molgraph")), python::with_custodian_and_ward<1, 2>())
+		.def("instantiate", &Pharm::PharmacophoreGenerator::instantiate,
+			 (python::arg("self"), python::arg("pharm"), python::arg("append") = false))
 		.def("clone", &Pharm::PharmacophoreGenerator::clone, python::arg("self"))
 		.def("setAtom3DCoordinatesFunction", &Pharm::PharmacophoreGenerator::setAtom3DCoordinatesFunction, 
 			 (python::arg("self"), python::arg("func")))
@@ -95,6 +95,17 @@ namespace
 		const CDPL::Pharm::FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const {
 			return this->get_override("getFeatureCounts")(mol_idx, mol_conf_idx);
 		}
+
+		bool getAtomCoordinates(std::size_t pharm_idx, CDPL::Math::Vector3DArray& coords, CDPL::Util::DArray& vdw_radii) const {
+			if (boost::python::override f = this->get_override("getAtomCoordinates"))
+				return f(pharm_idx, boost::ref(coords), boost::ref(vdw_radii));
+
+			return CDPL::Pharm::ScreeningDBAccessor::getAtomCoordinates(pharm_idx, coords, vdw_radii);
+		}
+
+		bool getAtomCoordinatesDef(std::size_t pharm_idx, CDPL::Math::Vector3DArray& coords, CDPL::Util::DArray& vdw_radii) const {
+			return CDPL::Pharm::ScreeningDBAccessor::getAtomCoordinates(pharm_idx, coords, vdw_radii);
+		}
 	};
 }
 
@@ -144,6 +155,8 @@ void CDPLPythonPharm::exportScreeningDBAccessor()
 		.def("getFeatureCounts", python::pure_virtual(
 				 static_cast<const Pharm::FeatureTypeHistogram& (Pharm::ScreeningDBAccessor::*)(std::size_t, std::size_t) const>(&Pharm::ScreeningDBAccessor::getFeatureCounts)),
 			 (python::arg("self"), python::arg("mol_idx"), python::arg("mol_conf_idx")), python::return_internal_reference<>())
+		.def("getAtomCoordinates", &Pharm::ScreeningDBAccessor::getAtomCoordinates, &ScreeningDBAccessorWrapper::getAtomCoordinatesDef,
+			 (python::arg("self"), python::arg("pharm_idx"), python::arg("coords"), python::arg("vdw_radii")))
 		.add_property("databaseName", python::make_function(&Pharm::ScreeningDBAccessor::getDatabaseName,											
 															python::return_value_policy<python::copy_const_reference>()))
 		.add_property("numMolecules", &Pharm::ScreeningDBAccessor::getNumMolecules)
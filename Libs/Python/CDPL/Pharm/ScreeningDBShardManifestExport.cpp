@@ -0,0 +1,62 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningDBShardManifestExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/ScreeningDBShardManifest.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/CopyAssOp.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonPharm::exportScreeningDBShardManifest()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::ScreeningDBShardManifest, Pharm::ScreeningDBShardManifest::SharedPointer>("ScreeningDBShardManifest", python::no_init)
+		.def(python::init<>(python::arg("self")))
+		.def(python::init<const Pharm::ScreeningDBShardManifest&>((python::arg("self"), python::arg("manifest"))))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::ScreeningDBShardManifest>())	
+		.def("assign", CDPLPythonBase::copyAssOp(&Pharm::ScreeningDBShardManifest::operator=), 
+			 (python::arg("self"), python::arg("manifest")), python::return_self<>())
+		.def("addShard", &Pharm::ScreeningDBShardManifest::addShard, 
+			 (python::arg("self"), python::arg("file_name"), python::arg("num_mols")))
+		.def("getNumShards", &Pharm::ScreeningDBShardManifest::getNumShards, python::arg("self"))
+		.def("getShardFileName", &Pharm::ScreeningDBShardManifest::getShardFileName, (python::arg("self"), python::arg("idx")),
+			 python::return_value_policy<python::copy_const_reference>())
+		.def("getShardMoleculeOffset", &Pharm::ScreeningDBShardManifest::getShardMoleculeOffset, (python::arg("self"), python::arg("idx")))
+		.def("getShardNumMolecules", &Pharm::ScreeningDBShardManifest::getShardNumMolecules, (python::arg("self"), python::arg("idx")))
+		.def("findShard", &Pharm::ScreeningDBShardManifest::findShard, (python::arg("self"), python::arg("mol_idx")))
+		.def("getNumMolecules", &Pharm::ScreeningDBShardManifest::getNumMolecules, python::arg("self"))
+		.def("clear", &Pharm::ScreeningDBShardManifest::clear, python::arg("self"))
+		.def("read", &Pharm::ScreeningDBShardManifest::read, (python::arg("self"), python::arg("is")))
+		.def("write", &Pharm::ScreeningDBShardManifest::write, (python::arg("self"), python::arg("os")))
+		.add_property("numShards", &Pharm::ScreeningDBShardManifest::getNumShards)
+		.add_property("numMolecules", &Pharm::ScreeningDBShardManifest::getNumMolecules);
+}
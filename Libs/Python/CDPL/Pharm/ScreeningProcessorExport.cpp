@@ -37,6 +37,24 @@
 #include "ClassExports.hpp"
 
 
+namespace
+{
+
+	std::size_t searchDBWrapper(CDPL::Pharm::ScreeningProcessor& proc, boost::python::list& queries, 
+								std::size_t mol_start_idx, std::size_t mol_end_idx)
+	{
+		using namespace CDPL;
+
+		Pharm::ScreeningProcessor::FeatureContainerList query_list;
+
+		for (std::size_t i = 0, num_queries = boost::python::len(queries); i < num_queries; i++)
+			query_list.push_back(&static_cast<const Pharm::FeatureContainer&>(boost::python::extract<const Pharm::FeatureContainer&>(queries[i])));
+
+		return proc.searchDB(query_list, mol_start_idx, mol_end_idx);
+	}
+}
+
+
 void CDPLPythonPharm::exportScreeningProcessor()
 {
     using namespace boost;
@@ -55,9 +73,9 @@ void CDPLPythonPharm::exportScreeningProcessor()
 
 	python::class_<Pharm::ScreeningProcessor::SearchHit/*, boost::noncopyable*/>("SearchHit", python::no_init)
 		.def(python::init<const Pharm::ScreeningProcessor&, const Pharm::FeatureContainer&, const Pharm::FeatureContainer&, const Chem::Molecule&, 
-			 const Math::Matrix4D&, std::size_t, std::size_t, std::size_t>(
+			 const Math::Matrix4D&, std::size_t, std::size_t, std::size_t, python::optional<std::size_t> >(
 				 (python::arg("self"), python::arg("hit_prov"), python::arg("qry_pharm"), python::arg("hit_pharm"), python::arg("mol"), 
-				  python::arg("xform"), python::arg("pharm_idx"), python::arg("mol_idx"), python::arg("conf_idx")))
+				  python::arg("xform"), python::arg("pharm_idx"), python::arg("mol_idx"), python::arg("conf_idx"), python::arg("qry_idx") = 0))
 			 [python::with_custodian_and_ward<1, 2, python::with_custodian_and_ward<1, 3, python::with_custodian_and_ward<1, 4, 
 			  python::with_custodian_and_ward<1, 5, python::with_custodian_and_ward<1, 5> > > > >()])
 		.def(python::init<const Pharm::ScreeningProcessor::SearchHit&>((python::arg("self"), python::arg("hit")))
@@ -79,6 +97,7 @@ void CDPLPythonPharm::exportScreeningProcessor()
 		.def("getHitPharmacophoreIndex", &Pharm::ScreeningProcessor::SearchHit::getHitPharmacophoreIndex, python::arg("self"))
 		.def("getHitMoleculeIndex", &Pharm::ScreeningProcessor::SearchHit::getHitMoleculeIndex, python::arg("self"))
 		.def("getHitConformationIndex", &Pharm::ScreeningProcessor::SearchHit::getHitConformationIndex, python::arg("self"))
+		.def("getQueryPharmacophoreIndex", &Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophoreIndex, python::arg("self"))
 		.add_property("hitProvider", 
 					  python::make_function(&Pharm::ScreeningProcessor::SearchHit::getHitProvider,
 											python::return_internal_reference<>()))
@@ -96,7 +115,8 @@ void CDPLPythonPharm::exportScreeningProcessor()
 											python::return_internal_reference<>()))
 		.add_property("hitPharmacophoreIndex", &Pharm::ScreeningProcessor::SearchHit::getHitPharmacophoreIndex)
 		.add_property("hitMoleculeIndex", &Pharm::ScreeningProcessor::SearchHit::getHitMoleculeIndex)
-		.add_property("hitConformationIndex", &Pharm::ScreeningProcessor::SearchHit::getHitConformationIndex);
+		.add_property("hitConformationIndex", &Pharm::ScreeningProcessor::SearchHit::getHitConformationIndex)
+		.add_property("queryPharmacophoreIndex", &Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophoreIndex);
 
 	cl
 		.def(python::init<Pharm::ScreeningDBAccessor&>((python::arg("self"), python::arg("db_acc")))
@@ -120,6 +140,10 @@ void CDPLPythonPharm::exportScreeningProcessor()
 			 (python::arg("self"), python::arg("seek_best")))
 		.def("bestAlignmentsSeeked", &Pharm::ScreeningProcessor::bestAlignmentsSeeked, 
 			 python::arg("self"))
+		.def("pruneAlignmentSearch", &Pharm::ScreeningProcessor::pruneAlignmentSearch, 
+			 (python::arg("self"), python::arg("prune")))
+		.def("alignmentSearchPruned", &Pharm::ScreeningProcessor::alignmentSearchPruned, 
+			 python::arg("self"))
 		.def("setHitCallback", &Pharm::ScreeningProcessor::setHitCallback, 
 			 (python::arg("self"), python::arg("func")))
 		.def("getHitCallback", &Pharm::ScreeningProcessor::getHitCallback, 
@@ -132,7 +156,15 @@ void CDPLPythonPharm::exportScreeningProcessor()
 			 (python::arg("self"), python::arg("func")))
 		.def("getScoringFunction", &Pharm::ScreeningProcessor::getScoringFunction, 
 			 python::arg("self"), python::return_internal_reference<>())
-		.def("searchDB", &Pharm::ScreeningProcessor::searchDB, 
+		.def("enableStatistics", &Pharm::ScreeningProcessor::enableStatistics, (python::arg("self"), python::arg("enable")))
+		.def("statisticsEnabled", &Pharm::ScreeningProcessor::statisticsEnabled, python::arg("self"))
+		.def("getStatistics", &Pharm::ScreeningProcessor::getStatistics, 
+			 python::arg("self"), python::return_internal_reference<>())
+		.def("clearStatistics", &Pharm::ScreeningProcessor::clearStatistics, python::arg("self"))
+		.def("searchDB", &searchDBWrapper, 
+			 (python::arg("self"), python::arg("queries"), python::arg("mol_start_idx") = 0, python::arg("mol_end_idx") = 0))
+		.def("searchDB", static_cast<std::size_t (Pharm::ScreeningProcessor::*)(const Pharm::FeatureContainer&, std::size_t, std::size_t)>
+			 (&Pharm::ScreeningProcessor::searchDB), 
 			 (python::arg("self"), python::arg("query"), python::arg("mol_start_idx") = 0, python::arg("mol_end_idx") = 0))
 		.add_property("dbAcccessor", python::make_function(&Pharm::ScreeningProcessor::getDBAccessor,
 														   python::return_internal_reference<>()),
@@ -154,5 +186,9 @@ void CDPLPythonPharm::exportScreeningProcessor()
 		.add_property("checkXVolumes", &Pharm::ScreeningProcessor::xVolumeClashesChecked,
 					  &Pharm::ScreeningProcessor::checkXVolumeClashes)
 		.add_property("bestAlignments", &Pharm::ScreeningProcessor::bestAlignmentsSeeked,
-					  &Pharm::ScreeningProcessor::seekBestAlignments);
+					  &Pharm::ScreeningProcessor::seekBestAlignments)
+		.add_property("pruneAlignments", &Pharm::ScreeningProcessor::alignmentSearchPruned,
+					  &Pharm::ScreeningProcessor::pruneAlignmentSearch)
+		.add_property("statistics", python::make_function(&Pharm::ScreeningProcessor::getStatistics,
+														  python::return_internal_reference<>()));
 }
@@ -0,0 +1,82 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ScreeningStatisticsExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/ScreeningStatistics.hpp"
+
+#include "Base/CopyAssOp.hpp"
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonPharm::exportScreeningStatistics()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::ScreeningStatistics> cl("ScreeningStatistics", python::no_init);
+    python::scope scope = cl;
+    
+    python::enum_<Pharm::ScreeningStatistics::Stage>("Stage")
+		.value("PHARMACOPHORE_LOADING", Pharm::ScreeningStatistics::PHARMACOPHORE_LOADING)
+		.value("MOLECULE_LOADING", Pharm::ScreeningStatistics::MOLECULE_LOADING)
+		.value("ATOM_COORDINATES_LOADING", Pharm::ScreeningStatistics::ATOM_COORDINATES_LOADING)
+		.value("FEATURE_COUNT_CHECK", Pharm::ScreeningStatistics::FEATURE_COUNT_CHECK)
+		.value("TWO_POINT_PHARMACOPHORE_CHECK", Pharm::ScreeningStatistics::TWO_POINT_PHARMACOPHORE_CHECK)
+		.value("ALIGNMENT", Pharm::ScreeningStatistics::ALIGNMENT)
+		.value("GEOMETRY_CHECK", Pharm::ScreeningStatistics::GEOMETRY_CHECK)
+		.value("XVOLUME_CLASH_CHECK", Pharm::ScreeningStatistics::XVOLUME_CLASH_CHECK)
+		.value("SCORING", Pharm::ScreeningStatistics::SCORING)
+		.value("HIT_REPORTING", Pharm::ScreeningStatistics::HIT_REPORTING)
+		.value("NUM_STAGES", Pharm::ScreeningStatistics::NUM_STAGES)
+		.export_values();
+
+    cl
+		.def(python::init<>(python::arg("self")))
+		.def(python::init<const Pharm::ScreeningStatistics&>((python::arg("self"), python::arg("stats"))))
+		.def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::ScreeningStatistics>())	
+		.def("assign", CDPLPythonBase::copyAssOp(&Pharm::ScreeningStatistics::operator=), 
+			 (python::arg("self"), python::arg("stats")), python::return_self<>())
+		.def("getNumPassed", &Pharm::ScreeningStatistics::getNumPassed, (python::arg("self"), python::arg("stage")))
+		.def("getNumRejected", &Pharm::ScreeningStatistics::getNumRejected, (python::arg("self"), python::arg("stage")))
+		.def("getWallTime", &Pharm::ScreeningStatistics::getWallTime, (python::arg("self"), python::arg("stage")))
+		.def("getCPUTime", &Pharm::ScreeningStatistics::getCPUTime, (python::arg("self"), python::arg("stage")))
+		.def("getTotalWallTime", &Pharm::ScreeningStatistics::getTotalWallTime, python::arg("self"))
+		.def("getTotalCPUTime", &Pharm::ScreeningStatistics::getTotalCPUTime, python::arg("self"))
+		.def("addResult", &Pharm::ScreeningStatistics::addResult, 
+			 (python::arg("self"), python::arg("stage"), python::arg("passed"), python::arg("num") = 1))
+		.def("addTime", &Pharm::ScreeningStatistics::addTime, 
+			 (python::arg("self"), python::arg("stage"), python::arg("wall_secs"), python::arg("cpu_secs")))
+		.def("clear", &Pharm::ScreeningStatistics::clear, python::arg("self"))
+		.def("__iadd__", &Pharm::ScreeningStatistics::operator+=, (python::arg("self"), python::arg("stats")), 
+			 python::return_self<>())
+		.def("getStageName", &Pharm::ScreeningStatistics::getStageName, python::arg("stage"))
+		.staticmethod("getStageName")
+		.add_property("totalWallTime", &Pharm::ScreeningStatistics::getTotalWallTime)
+		.add_property("totalCPUTime", &Pharm::ScreeningStatistics::getTotalCPUTime);
+}
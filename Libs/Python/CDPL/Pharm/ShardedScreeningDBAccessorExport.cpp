@@ -0,0 +1,54 @@
+/* -*- mode: c++; c-basic-offset: 4; tab-width: 4; indent-tabs-mode: t -*- */
+
+/* 
+ * ShardedScreeningDBAccessorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003-2020 Thomas A. Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/ShardedScreeningDBAccessor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonPharm::exportShardedScreeningDBAccessor()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::ShardedScreeningDBAccessor, Pharm::ShardedScreeningDBAccessor::SharedPointer,
+		   python::bases<Pharm::ScreeningDBAccessor>,
+		   boost::noncopyable>("ShardedScreeningDBAccessor", python::no_init)
+	.def(python::init<>(python::arg("self")))
+	.def(python::init<const std::string&>((python::arg("self"), python::arg("name"))))
+	.def("getManifest", &Pharm::ShardedScreeningDBAccessor::getManifest, python::arg("self"),
+		 python::return_internal_reference<>())
+	.def("selectShards", &Pharm::ShardedScreeningDBAccessor::selectShards, 
+		 (python::arg("self"), python::arg("first_idx"), python::arg("num_shards")))
+	.def("getFirstSelectedShard", &Pharm::ShardedScreeningDBAccessor::getFirstSelectedShard, python::arg("self"))
+	.def("getNumSelectedShards", &Pharm::ShardedScreeningDBAccessor::getNumSelectedShards, python::arg("self"))
+	.add_property("manifest", python::make_function(&Pharm::ShardedScreeningDBAccessor::getManifest,
+													python::return_internal_reference<>()))
+	.add_property("firstSelectedShard", &Pharm::ShardedScreeningDBAccessor::getFirstSelectedShard)
+	.add_property("numSelectedShards", &Pharm::ShardedScreeningDBAccessor::getNumSelectedShards);
+}